@@ -0,0 +1,170 @@
+/**
+ * @file benchmark_harness.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the mlpack benchmark harness, and its main program.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_harness.hpp"
+
+#include <mlpack/core/util/version.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+#endif
+
+namespace mlpack {
+namespace bench {
+
+std::vector<Benchmark>& Registry()
+{
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const std::string& name,
+                                       const std::string& category,
+                                       const size_t iterations,
+                                       std::function<void()> function)
+{
+  Registry().push_back(Benchmark{ name, category, iterations, function });
+}
+
+size_t PeakRSSKilobytes()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+  #ifdef __APPLE__
+    return (size_t) (usage.ru_maxrss / 1024); // ru_maxrss is in bytes here.
+  #else
+    return (size_t) usage.ru_maxrss; // ru_maxrss is in kilobytes.
+  #endif
+  }
+#endif
+  return 0;
+}
+
+size_t RunBenchmarks(std::ostream& output, const std::string& filter)
+{
+  // Sort benchmarks by name so the output order is stable across builds
+  // (static initialization order is not).
+  std::vector<Benchmark> benchmarks = Registry();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+      [](const Benchmark& a, const Benchmark& b) { return a.name < b.name; });
+
+  arma::wall_clock clock;
+  size_t numRun = 0;
+
+  output << "{\n";
+  output << "  \"mlpack_version\": \"" << util::GetVersion() << "\",\n";
+  output << "  \"benchmarks\": [";
+
+  for (size_t b = 0; b < benchmarks.size(); ++b)
+  {
+    const Benchmark& benchmark = benchmarks[b];
+    if (benchmark.name.find(filter) == std::string::npos)
+      continue;
+
+    std::cerr << "Running " << benchmark.name << " ("
+        << benchmark.iterations << " iterations)..." << std::endl;
+
+    // One untimed warm-up iteration, so that lazily allocated caches and
+    // lazily loaded data do not pollute the first timing.
+    benchmark.function();
+
+    std::vector<double> timings(benchmark.iterations);
+    for (size_t i = 0; i < benchmark.iterations; ++i)
+    {
+      clock.tic();
+      benchmark.function();
+      timings[i] = clock.toc();
+    }
+
+    double total = 0.0;
+    double minimum = timings[0];
+    for (size_t i = 0; i < timings.size(); ++i)
+    {
+      total += timings[i];
+      minimum = std::min(minimum, timings[i]);
+    }
+
+    output << (numRun == 0 ? "\n" : ",\n");
+    output << "    {\n";
+    output << "      \"name\": \"" << benchmark.name << "\",\n";
+    output << "      \"category\": \"" << benchmark.category << "\",\n";
+    output << "      \"iterations\": " << benchmark.iterations << ",\n";
+    output << "      \"timings_s\": [";
+    for (size_t i = 0; i < timings.size(); ++i)
+      output << (i == 0 ? "" : ", ") << timings[i];
+    output << "],\n";
+    output << "      \"mean_s\": " << (total / timings.size()) << ",\n";
+    output << "      \"min_s\": " << minimum << ",\n";
+    output << "      \"peak_rss_kb\": " << PeakRSSKilobytes() << "\n";
+    output << "    }";
+
+    ++numRun;
+  }
+
+  output << "\n  ]\n";
+  output << "}\n";
+
+  return numRun;
+}
+
+} // namespace bench
+} // namespace mlpack
+
+int main(int argc, char** argv)
+{
+  std::string filter = "";
+  std::string outputFile = "";
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if (arg == "--filter" && i + 1 < argc)
+    {
+      filter = argv[++i];
+    }
+    else if (arg == "--output" && i + 1 < argc)
+    {
+      outputFile = argv[++i];
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0]
+          << " [--filter substring] [--output results.json]" << std::endl;
+      return 1;
+    }
+  }
+
+  size_t numRun;
+  if (!outputFile.empty())
+  {
+    std::ofstream output(outputFile);
+    if (!output.is_open())
+    {
+      std::cerr << "Cannot open output file '" << outputFile << "'!"
+          << std::endl;
+      return 1;
+    }
+    numRun = mlpack::bench::RunBenchmarks(output, filter);
+  }
+  else
+  {
+    numRun = mlpack::bench::RunBenchmarks(std::cout, filter);
+  }
+
+  std::cerr << numRun << " benchmarks run." << std::endl;
+  return (numRun == 0) ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file benchmark_harness.hpp
+ * @author Ryan Curtin
+ *
+ * A small harness for mlpack performance benchmarks.  Benchmarks register
+ * themselves with the MLPACK_BENCHMARK() macro; the harness runs them,
+ * collects per-iteration wall-clock timings and the process peak RSS, and
+ * emits the results as machine-readable JSON so that timings can be tracked
+ * across releases.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HARNESS_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HARNESS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * A single registered benchmark: a name, a category ("micro" or "macro"), the
+ * number of timed iterations, and the function to time.
+ */
+struct Benchmark
+{
+  //! Name of the benchmark (used in the JSON output and for filtering).
+  std::string name;
+  //! Category of the benchmark: "micro" or "macro".
+  std::string category;
+  //! Number of timed iterations.
+  size_t iterations;
+  //! The function to time.  One call is one iteration.
+  std::function<void()> function;
+};
+
+/**
+ * The global benchmark registry.  Benchmarks append themselves here at static
+ * initialization time via BenchmarkRegistrar.
+ */
+std::vector<Benchmark>& Registry();
+
+/**
+ * Helper whose constructor registers a benchmark; used by the
+ * MLPACK_BENCHMARK() macro.
+ */
+struct BenchmarkRegistrar
+{
+  BenchmarkRegistrar(const std::string& name,
+                     const std::string& category,
+                     const size_t iterations,
+                     std::function<void()> function);
+};
+
+/**
+ * Return the peak resident set size of the process, in kilobytes, or 0 if it
+ * cannot be determined on this platform.
+ */
+size_t PeakRSSKilobytes();
+
+/**
+ * Run all registered benchmarks whose name contains the given filter (an
+ * empty filter matches everything), and write the results as JSON to the
+ * given stream.  Each benchmark gets one untimed warm-up call followed by its
+ * registered number of timed iterations.
+ *
+ * @param output Stream to write the JSON document to.
+ * @param filter Substring filter on benchmark names.
+ * @return Number of benchmarks run.
+ */
+size_t RunBenchmarks(std::ostream& output, const std::string& filter = "");
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Define and register a benchmark.  Usage:
+ *
+ * @code
+ * MLPACK_BENCHMARK(MyBenchmark, "micro", 100)
+ * {
+ *   // ... one iteration of the workload ...
+ * }
+ * @endcode
+ */
+#define MLPACK_BENCHMARK(name, category, iterations) \
+    static void BenchmarkBody##name(); \
+    static mlpack::bench::BenchmarkRegistrar benchmarkRegistrar##name( \
+        #name, category, iterations, &BenchmarkBody##name); \
+    static void BenchmarkBody##name()
+
+#endif
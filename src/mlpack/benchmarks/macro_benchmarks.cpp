@@ -0,0 +1,53 @@
+/**
+ * @file macro_benchmarks.cpp
+ * @author Ryan Curtin
+ *
+ * Macrobenchmarks for end-to-end mlpack methods: dual-tree k-nearest-neighbor
+ * search, NMF factorization, and logistic regression training.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_harness.hpp"
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/amf/amf.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+using namespace mlpack;
+
+// End-to-end dual-tree k-nearest-neighbor search, including tree building.
+MLPACK_BENCHMARK(KNNEndToEnd, "macro", 5)
+{
+  static const arma::mat data = arma::randu<arma::mat>(10, 10000);
+
+  neighbor::KNN knn(data);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(5, neighbors, distances);
+}
+
+// End-to-end NMF factorization with alternating least squares updates.
+MLPACK_BENCHMARK(NMFEndToEnd, "macro", 5)
+{
+  static const arma::mat data = arma::randu<arma::mat>(100, 100);
+
+  amf::AMF<amf::SimpleResidueTermination,
+           amf::RandomAcolInitialization<>,
+           amf::NMFALSUpdate> nmf(amf::SimpleResidueTermination(1e-5, 50));
+  arma::mat w, h;
+  nmf.Apply(data, 8, w, h);
+}
+
+// End-to-end logistic regression training with the default optimizer.
+MLPACK_BENCHMARK(LogisticRegressionEndToEnd, "macro", 5)
+{
+  static const arma::mat data = arma::randu<arma::mat>(10, 5000);
+  static const arma::Row<size_t> responses =
+      arma::randi<arma::Row<size_t> >(5000, arma::distr_param(0, 1));
+
+  regression::LogisticRegression<> lr(data, responses, 0.001);
+}
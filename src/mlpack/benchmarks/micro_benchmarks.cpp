@@ -0,0 +1,100 @@
+/**
+ * @file micro_benchmarks.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for hot mlpack kernels: bound distance computations,
+ * k-means iterations, neighbor search base cases, naive convolution, and CSV
+ * loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_harness.hpp"
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+using namespace mlpack;
+
+// Benchmark HRectBound::MinDistance()/MaxDistance() against many points.
+MLPACK_BENCHMARK(HRectBoundDistance, "micro", 50)
+{
+  static const arma::mat data = arma::randu<arma::mat>(10, 1000);
+  static const arma::mat queries = arma::randu<arma::mat>(10, 100000);
+
+  static bound::HRectBound<> bound(10);
+  static bool built = false;
+  if (!built)
+  {
+    bound |= data;
+    built = true;
+  }
+
+  // Accumulate so the distance computations cannot be optimized away.
+  volatile double sink = 0.0;
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    sink = sink + bound.MinDistance(queries.unsafe_col(i)) +
+        bound.MaxDistance(queries.unsafe_col(i));
+  }
+}
+
+// Benchmark one Lloyd iteration of naive k-means.
+MLPACK_BENCHMARK(NaiveKMeansIterate, "micro", 20)
+{
+  static const arma::mat data = arma::randu<arma::mat>(10, 10000);
+  static metric::EuclideanDistance metric;
+  static kmeans::NaiveKMeans<metric::EuclideanDistance, arma::mat>
+      lloyd(data, metric);
+  static const arma::mat centroids = arma::randu<arma::mat>(10, 20);
+
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  lloyd.Iterate(centroids, newCentroids, counts);
+}
+
+// Benchmark the neighbor search base case by running an exhaustive (naive)
+// k-nearest-neighbor search, which is a pure stream of BaseCase() calls.
+MLPACK_BENCHMARK(NeighborSearchBaseCase, "micro", 10)
+{
+  static const arma::mat data = arma::randu<arma::mat>(10, 2000);
+  static neighbor::KNN knn(data, neighbor::NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(5, neighbors, distances);
+}
+
+// Benchmark a valid-mode naive convolution of a 5x5 filter over a 128x128
+// input.
+MLPACK_BENCHMARK(NaiveConvolutionValid, "micro", 100)
+{
+  static const arma::mat input = arma::randu<arma::mat>(128, 128);
+  static const arma::mat filter = arma::randu<arma::mat>(5, 5);
+
+  arma::mat output;
+  ann::NaiveConvolution<ann::ValidConvolution>::Convolution(input, filter,
+      output);
+}
+
+// Benchmark loading a moderately sized CSV file.
+MLPACK_BENCHMARK(LoadCSV, "micro", 10)
+{
+  static const std::string file = "mlpack_benchmark_load_csv.csv";
+  static bool written = false;
+  if (!written)
+  {
+    const arma::mat data = arma::randu<arma::mat>(20, 20000);
+    data::Save(file, data);
+    written = true;
+  }
+
+  arma::mat loaded;
+  data::Load(file, loaded);
+}
@@ -74,6 +74,12 @@ class CLIOption
             const bool noTranspose = false,
             const std::string& /*testName*/ = "")
   {
+    // These static objects are constructed before main() in every binding
+    // binary, so the constructor only enqueues the registration work; the
+    // map insertions, duplicate checks and function table setup below run
+    // lazily the first time the CLI singleton is actually used.
+    CLI::AddRegistrar([=]()
+    {
     // Create the ParamData object to give to CLI.
     util::ParamData data;
 
@@ -160,6 +166,7 @@ class CLIOption
         &GetAllocatedMemory<N>;
     CLI::GetSingleton().functionMap[tname]["DeleteAllocatedMemory"] =
         &DeleteAllocatedMemory<N>;
+    });
   }
 };
 
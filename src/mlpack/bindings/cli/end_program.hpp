@@ -13,6 +13,7 @@
 #ifndef MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
+#include <mlpack/core/util/alloc_tracker.hpp>
 #include <mlpack/core/util/cli.hpp>
 
 namespace mlpack {
@@ -71,6 +72,10 @@ inline void EndProgram()
       Log::Info << "  " << it2.first << ": ";
       CLI::GetSingleton().timer.PrintTimer(it2.first);
     }
+
+    // If allocation tracking collected anything, print the top allocating
+    // zones too (this prints nothing otherwise).
+    AllocTracker::Report();
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
@@ -27,6 +27,11 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+#ifndef _WIN32
+PARAM_STRING_IN("serve", "If specified, instead of running once and exiting, "
+    "the program will load its model once and then answer framed matrix "
+    "requests over a Unix domain socket at the given path.", "", "");
+#endif
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -0,0 +1,316 @@
+/**
+ * @file serve_binding.hpp
+ *
+ * Model server mode for command-line bindings.  Instead of paying process
+ * startup, parameter parsing, and model deserialization on every invocation,
+ * a binding run with --serve loads its model once and then answers framed
+ * matrix requests over a Unix domain socket from the resident process.
+ *
+ * The wire protocol is a sequence of frames, each of which is:
+ *
+ *   uint64_t nameLength
+ *   char     name[nameLength]
+ *   uint64_t rows
+ *   uint64_t cols
+ *   double   elements[rows * cols]   (column-major)
+ *
+ * A request is a sequence of frames naming input matrix parameters of the
+ * binding (e.g. "query"), terminated by a frame header with nameLength 0.
+ * The server then runs the binding once and replies with one frame per
+ * matrix-typed output parameter, terminated the same way.  A header with
+ * nameLength 2^64 - 1 shuts the server down.  Any parameters that are not
+ * matrices---including the model to serve---must be given on the command line
+ * when the server is started.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_BINDING_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_BINDING_HPP
+
+#ifndef _WIN32
+
+#include <mlpack/core.hpp>
+#include "parameter_type.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Read exactly the given number of bytes from the descriptor.  Returns false
+ * if the connection was closed or an error occurred first.
+ */
+inline bool ReadExact(const int fd, void* buffer, size_t count)
+{
+  char* ptr = (char*) buffer;
+  while (count > 0)
+  {
+    const ssize_t got = ::read(fd, ptr, count);
+    if (got <= 0)
+      return false;
+    ptr += got;
+    count -= (size_t) got;
+  }
+  return true;
+}
+
+/**
+ * Write exactly the given number of bytes to the descriptor.  Returns false
+ * if the connection was closed or an error occurred first.
+ */
+inline bool WriteExact(const int fd, const void* buffer, size_t count)
+{
+  const char* ptr = (const char*) buffer;
+  while (count > 0)
+  {
+    const ssize_t sent = ::write(fd, ptr, count);
+    if (sent <= 0)
+      return false;
+    ptr += sent;
+    count -= (size_t) sent;
+  }
+  return true;
+}
+
+/**
+ * Read a frame header (the parameter name).  An empty name terminates a
+ * request; a name length of 2^64 - 1 requests server shutdown (reported via
+ * 'shutdown').  Returns false if the connection was closed first.
+ */
+inline bool ReadFrameName(const int fd, std::string& name, bool& shutdown)
+{
+  uint64_t length;
+  if (!ReadExact(fd, &length, sizeof(length)))
+    return false;
+
+  shutdown = (length == std::numeric_limits<uint64_t>::max());
+  if (shutdown || length == 0)
+  {
+    name.clear();
+    return true;
+  }
+
+  name.resize((size_t) length);
+  return ReadExact(fd, &name[0], (size_t) length);
+}
+
+/**
+ * Read the dimensions and column-major elements of a matrix frame.
+ */
+inline bool ReadMatrixBody(const int fd, arma::mat& matrix)
+{
+  uint64_t rows, cols;
+  if (!ReadExact(fd, &rows, sizeof(rows)) ||
+      !ReadExact(fd, &cols, sizeof(cols)))
+    return false;
+
+  matrix.set_size((size_t) rows, (size_t) cols);
+  return ReadExact(fd, matrix.memptr(), matrix.n_elem * sizeof(double));
+}
+
+/**
+ * Write a complete matrix frame (name, dimensions, column-major elements).
+ */
+inline bool WriteMatrixFrame(const int fd,
+                             const std::string& name,
+                             const arma::mat& matrix)
+{
+  const uint64_t length = (uint64_t) name.size();
+  const uint64_t rows = (uint64_t) matrix.n_rows;
+  const uint64_t cols = (uint64_t) matrix.n_cols;
+
+  return WriteExact(fd, &length, sizeof(length)) &&
+      WriteExact(fd, name.data(), (size_t) length) &&
+      WriteExact(fd, &rows, sizeof(rows)) &&
+      WriteExact(fd, &cols, sizeof(cols)) &&
+      WriteExact(fd, matrix.memptr(), matrix.n_elem * sizeof(double));
+}
+
+/**
+ * Write a request/response terminator (a frame header with an empty name).
+ */
+inline bool WriteTerminator(const int fd)
+{
+  const uint64_t length = 0;
+  return WriteExact(fd, &length, sizeof(length));
+}
+
+/**
+ * Set the named input matrix parameter to the given matrix, marking it as
+ * passed so the binding sees it.  Frames naming unknown or non-matrix
+ * parameters are ignored with a warning, since the payload has already been
+ * consumed from the socket.
+ */
+inline void SetServedInputMatrix(const std::string& name, arma::mat&& matrix)
+{
+  std::map<std::string, util::ParamData>& parameters = CLI::Parameters();
+  if (parameters.count(name) == 0)
+  {
+    Log::Warn << "--serve: ignoring frame for unknown parameter '" << name
+        << "'." << std::endl;
+    return;
+  }
+
+  util::ParamData& d = parameters[name];
+  if (!d.input || d.cppType != "arma::mat")
+  {
+    Log::Warn << "--serve: ignoring frame for parameter '" << name << "'; "
+        << "only input parameters of type arma::mat may be sent." << std::endl;
+    return;
+  }
+
+  typedef std::tuple<arma::mat, typename ParameterType<arma::mat>::type>
+      TupleType;
+  TupleType& tuple = *boost::any_cast<TupleType>(&d.value);
+  std::get<0>(tuple) = std::move(matrix);
+  d.loaded = true; // Never try to load this parameter from a file.
+  d.wasPassed = true;
+  CLI::SetPassed(name);
+}
+
+/**
+ * Write every matrix-typed output parameter of the binding as a frame,
+ * followed by a terminator.  Integer-element matrices are converted to
+ * doubles, since the protocol only carries doubles.
+ */
+inline bool WriteServedOutputs(const int fd)
+{
+  const std::map<std::string, util::ParamData>& parameters = CLI::Parameters();
+  for (std::map<std::string, util::ParamData>::const_iterator it =
+      parameters.begin(); it != parameters.end(); ++it)
+  {
+    const util::ParamData& d = it->second;
+    if (d.input)
+      continue;
+
+    bool ok = true;
+    if (d.cppType == "arma::mat")
+      ok = WriteMatrixFrame(fd, d.name, CLI::GetParam<arma::mat>(d.name));
+    else if (d.cppType == "arma::Mat<size_t>")
+      ok = WriteMatrixFrame(fd, d.name, arma::conv_to<arma::mat>::from(
+          CLI::GetParam<arma::Mat<size_t>>(d.name)));
+    else if (d.cppType == "arma::vec")
+      ok = WriteMatrixFrame(fd, d.name, arma::conv_to<arma::mat>::from(
+          CLI::GetParam<arma::vec>(d.name)));
+    else if (d.cppType == "arma::rowvec")
+      ok = WriteMatrixFrame(fd, d.name, arma::conv_to<arma::mat>::from(
+          CLI::GetParam<arma::rowvec>(d.name)));
+    else if (d.cppType == "arma::Row<size_t>")
+      ok = WriteMatrixFrame(fd, d.name, arma::conv_to<arma::mat>::from(
+          CLI::GetParam<arma::Row<size_t>>(d.name)));
+    else if (d.cppType == "arma::Col<size_t>")
+      ok = WriteMatrixFrame(fd, d.name, arma::conv_to<arma::mat>::from(
+          CLI::GetParam<arma::Col<size_t>>(d.name)));
+
+    if (!ok)
+      return false;
+  }
+
+  return WriteTerminator(fd);
+}
+
+/**
+ * Handle one request on the given connection: read input matrix frames up to
+ * the terminator, run the binding, and write the output frames.  Returns 1 if
+ * a request was handled, 0 if the connection was closed, and 2 if shutdown
+ * was requested.
+ */
+inline int HandleServeRequest(const int fd, void (*bindingFunction)())
+{
+  // Read input frames.
+  while (true)
+  {
+    std::string name;
+    bool shutdown;
+    if (!ReadFrameName(fd, name, shutdown))
+      return 0;
+    if (shutdown)
+      return 2;
+    if (name.empty())
+      break;
+
+    arma::mat matrix;
+    if (!ReadMatrixBody(fd, matrix))
+      return 0;
+    SetServedInputMatrix(name, std::move(matrix));
+  }
+
+  // Run the binding against the resident model; any input model parameter was
+  // deserialized on the first run and stays cached in the CLI singleton.
+  bindingFunction();
+
+  return WriteServedOutputs(fd) ? 1 : 0;
+}
+
+/**
+ * Serve the binding on a Unix domain socket at the given path.  Each accepted
+ * connection may issue any number of requests; the function returns when a
+ * client requests shutdown.
+ *
+ * @param bindingFunction The binding's mlpackMain() function.
+ * @param socketPath Filesystem path to bind the Unix domain socket to.
+ */
+inline void ServeBinding(void (*bindingFunction)(),
+                         const std::string& socketPath)
+{
+  sockaddr_un address;
+  if (socketPath.length() >= sizeof(address.sun_path))
+    Log::Fatal << "--serve: socket path '" << socketPath << "' is too long!"
+        << std::endl;
+
+  const int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0)
+    Log::Fatal << "--serve: cannot create socket!" << std::endl;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+  // Remove any stale socket left by a previous server.
+  ::unlink(socketPath.c_str());
+
+  if (::bind(server, (const sockaddr*) &address, sizeof(address)) < 0 ||
+      ::listen(server, 8) < 0)
+  {
+    ::close(server);
+    Log::Fatal << "--serve: cannot bind to socket path '" << socketPath
+        << "'!" << std::endl;
+  }
+
+  Log::Info << "Serving on Unix socket '" << socketPath << "'." << std::endl;
+
+  bool shutdown = false;
+  while (!shutdown)
+  {
+    const int client = ::accept(server, NULL, NULL);
+    if (client < 0)
+      continue;
+
+    int status;
+    do
+    {
+      status = HandleServeRequest(client, bindingFunction);
+    } while (status == 1);
+    shutdown = (status == 2);
+
+    ::close(client);
+  }
+
+  ::close(server);
+  ::unlink(socketPath.c_str());
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif // _WIN32
+
+#endif
@@ -19,6 +19,43 @@
 namespace mlpack {
 namespace util {
 
+/**
+ * Reconstruct the given matrix as an alias of the given memory, without
+ * copying any elements.  This uses the same in-place trickery as SetMemState()
+ * in arma_util.hpp: the old object is destroyed and an Armadillo "advanced
+ * constructor" object (copy_aux_mem = false) is built in its place, so the
+ * result has mem_state 1 and will never free the aliased memory.
+ */
+template<typename eT>
+inline void AliasMatrix(arma::Mat<eT>& m,
+                        eT* mem,
+                        const size_t rows,
+                        const size_t cols)
+{
+  m.~Mat<eT>();
+  new (&m) arma::Mat<eT>(mem, rows, cols, false, false);
+}
+
+template<typename eT>
+inline void AliasMatrix(arma::Row<eT>& m,
+                        eT* mem,
+                        const size_t /* rows */,
+                        const size_t cols)
+{
+  m.~Row<eT>();
+  new (&m) arma::Row<eT>(mem, cols, false, false);
+}
+
+template<typename eT>
+inline void AliasMatrix(arma::Col<eT>& m,
+                        eT* mem,
+                        const size_t rows,
+                        const size_t /* cols */)
+{
+  m.~Col<eT>();
+  new (&m) arma::Col<eT>(mem, rows, false, false);
+}
+
 /**
  * Set the parameter to the given value.
  *
@@ -29,11 +66,45 @@ namespace util {
  * @param value Value to set parameter to.
  */
 template<typename T>
-inline void SetParam(const std::string& identifier, T& value)
+inline void SetParam(
+    const std::string& identifier,
+    T& value,
+    const typename std::enable_if<!arma::is_arma_type<T>::value>::type* = 0)
 {
   CLI::GetParam<T>(identifier) = std::move(value);
 }
 
+/**
+ * Set an Armadillo parameter to the given value, without copying the elements
+ * if the value is an alias of memory owned elsewhere.
+ *
+ * When a numpy buffer is adopted without a copy (mem_state 1), a move
+ * assignment would silently degrade to an element-by-element copy, since
+ * Armadillo cannot steal memory it does not own.  Instead we make the stored
+ * parameter an alias of the same buffer; the generated binding code keeps the
+ * numpy array alive for the duration of the binding call, and input parameters
+ * are not accessed after the call returns.
+ *
+ * @param identifier Name of parameter.
+ * @param value Value to set parameter to.
+ */
+template<typename T>
+inline void SetParam(
+    const std::string& identifier,
+    T& value,
+    const typename std::enable_if<arma::is_arma_type<T>::value>::type* = 0)
+{
+  if (value.mem_state == 1 && value.n_elem > arma::arma_config::mat_prealloc)
+  {
+    AliasMatrix(CLI::GetParam<T>(identifier), value.memptr(), value.n_rows,
+        value.n_cols);
+  }
+  else
+  {
+    CLI::GetParam<T>(identifier) = std::move(value);
+  }
+}
+
 /**
  * Set the parameter to the given value, given that the type is a pointer.
  *
@@ -65,7 +136,16 @@ inline void SetParamWithInfo(const std::string& identifier,
 
   // The true type of the parameter is std::tuple<T, DatasetInfo>.
   const size_t dimensions = matrix.n_rows;
-  std::get<1>(CLI::GetParam<TupleType>(identifier)) = std::move(matrix);
+  // As in SetParam(), avoid copying an aliased numpy buffer.
+  if (matrix.mem_state == 1 && matrix.n_elem > arma::arma_config::mat_prealloc)
+  {
+    AliasMatrix(std::get<1>(CLI::GetParam<TupleType>(identifier)),
+        matrix.memptr(), matrix.n_rows, matrix.n_cols);
+  }
+  else
+  {
+    std::get<1>(CLI::GetParam<TupleType>(identifier)) = std::move(matrix);
+  }
   data::DatasetInfo& di = std::get<0>(CLI::GetParam<TupleType>(identifier));
   di = data::DatasetInfo(dimensions);
 
@@ -53,20 +53,25 @@ def to_matrix(x, dtype=np.double, copy=False):
     else:
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
-    if copy: # Copy the matrix if required.
-      return np.ndarray(x.shape, buffer=x.flatten(), dtype=dtype, order='C').copy("C"), True
-    else:
-      return np.ndarray(x.shape, buffer=x.flatten(), dtype=dtype, order='C'), False
+    # A column-major matrix must be rewritten in row-major order, but a single
+    # copy is enough for that, and we own the result either way.
+    return np.ascontiguousarray(x), True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
       y = x.values
-      if copy: # Copy the matrix if required.
-        return np.ndarray(y.shape, buffer=y.flatten(), dtype=dtype, order='C').copy("C"), True
+      z = np.ascontiguousarray(y, dtype=dtype)
+      if z is y:
+        # The dataframe's buffer is directly usable, so we can avoid a copy
+        # unless one was asked for.  The memory remains owned by the dataframe.
+        if copy:
+          return z.copy("C"), True
+        else:
+          return z, False
       else:
-        return np.ndarray(y.shape, buffer=y.flatten(), dtype=dtype, order='C'), False
+        return z, True
     else:
       return np.array(x, copy=True, dtype=dtype, order='C'), True
-    
+
 
 def to_matrix_with_info(x, dtype, copy=False):
   """
@@ -188,6 +188,10 @@ void PrintOutputProcessing(
      * (<ModelType?> result).modelptr = GetParamPtr[Model]('name')
      */
     std::cout << prefix << "result = " << strippedType << "Type()" << std::endl;
+    // Free the placeholder model allocated by __cinit__() before pointing the
+    // handle at the model held by CLI, so that it is not leaked on each call.
+    std::cout << prefix << "del (<" << strippedType
+        << "Type?> result).modelptr" << std::endl;
     std::cout << prefix << "(<" << strippedType << "Type?> result).modelptr = "
         << "GetParamPtr[" << strippedType << "]('" << d.name << "')"
         << std::endl;
@@ -206,7 +210,7 @@ void PrintOutputProcessing(
       if (data.input && data.cppType == d.cppType && data.required)
       {
         std::cout << prefix << "if (<" << strippedType
-            << "Type> result).modelptr" << d.name << " == (<" << strippedType
+            << "Type> result).modelptr == (<" << strippedType
             << "Type> " << data.name << ").modelptr:" << std::endl;
         std::cout << prefix << "  (<" << strippedType
             << "Type> result).modelptr = <" << strippedType << "*> 0"
@@ -218,7 +222,7 @@ void PrintOutputProcessing(
         std::cout << prefix << "if " << data.name << " is not None:"
             << std::endl;
         std::cout << prefix << "  if (<" << strippedType
-            << "Type> result).modelptr" << d.name << " == (<" << strippedType
+            << "Type> result).modelptr == (<" << strippedType
             << "Type> " << data.name << ").modelptr:" << std::endl;
         std::cout << prefix << "    (<" << strippedType
             << "Type> result).modelptr = <" << strippedType << "*> 0"
@@ -237,6 +241,10 @@ void PrintOutputProcessing(
      */
     std::cout << prefix << "result['" << d.name << "'] = " << strippedType
         << "Type()" << std::endl;
+    // Free the placeholder model allocated by __cinit__() before pointing the
+    // handle at the model held by CLI, so that it is not leaked on each call.
+    std::cout << prefix << "del (<" << strippedType << "Type?> result['"
+        << d.name << "']).modelptr" << std::endl;
     std::cout << prefix << "(<" << strippedType << "Type?> result['" << d.name
         << "']).modelptr = GetParamPtr[" << strippedType << "]('" << d.name
         << "')" << std::endl;
@@ -105,6 +105,7 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/triangular_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/gram_matrix.hpp>
 
 // Use OpenMP if compiled with -DHAS_OPENMP.
 #ifdef HAS_OPENMP
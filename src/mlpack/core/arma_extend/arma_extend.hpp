@@ -44,6 +44,26 @@
   #define ARMA_USE_U64S64
 #endif
 
+// If allocation tracking was requested, route Armadillo's memory path through
+// the allocation tracker (see mlpack/core/util/alloc_tracker.hpp).  Armadillo
+// only honors these hooks in version 9.900 and newer; with an older Armadillo
+// the definitions below are simply ignored and no tracking happens.
+#ifdef MLPACK_TRACK_ALLOCATIONS
+  #include <cstddef>
+
+  namespace mlpack {
+  namespace util {
+
+  void* TrackedMemoryAlloc(const std::size_t nBytes);
+  void TrackedMemoryFree(void* mem);
+
+  } // namespace util
+  } // namespace mlpack
+
+  #define ARMA_ALIEN_MEM_ALLOC_FUNCTION mlpack::util::TrackedMemoryAlloc
+  #define ARMA_ALIEN_MEM_FREE_FUNCTION mlpack::util::TrackedMemoryFree
+#endif
+
 // Include everything we'll need for serialize().
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/nvp.hpp>
@@ -44,6 +44,10 @@ namespace cv {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * A single copy of the data is stored, and the folds are expressed as views
+ * into it: a fold's training set is only materialized when it wraps around the
+ * end of the dataset, so no doubled dataset is built.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -209,14 +213,14 @@ class KFoldCV
   //! The number of bins in the dataset.
   const size_t k;
 
-  //! The extended (by repeating the first k - 2 bins) data points.
+  //! The data points.  The folds are views into this matrix.
   MatType xs;
-  //! The extended (by repeating the first k - 2 bins) predictions.
+  //! The predictions.  The folds are views into this vector.
   PredictionsType ys;
-  //! The extended (by repeating the first k - 2 bins) weights.
+  //! The weights.  The folds are views into this vector.
   WeightsType weights;
 
-  //! The original size of the dataset.
+  //! The size of the last bin in terms of data points.
   size_t lastBinSize;
 
   //! The size of each bin in terms of data points.
@@ -247,8 +251,8 @@ class KFoldCV
           const bool shuffle);
 
   /**
-   * Initialize the given destination matrix with the given source joined with
-   * its first k - 2 bins.
+   * Calculate the bin sizes and initialize the given destination matrix with a
+   * copy of the given source (without doubling it).
    */
   template<typename DataType>
   void InitKFoldCVMat(const DataType& source, DataType& destination);
@@ -279,7 +283,10 @@ class KFoldCV
   inline size_t ValidationSubsetFirstCol(const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a matrix type.
+   * Get the ith training subset from a variable of a matrix type.  For the
+   * first two folds the training set is contiguous and a no-copy alias is
+   * returned; for later folds the training set wraps around the end of the
+   * dataset and its two contiguous pieces are joined into a new matrix.
    */
   template<typename ElementType>
   inline arma::Mat<ElementType> GetTrainingSubset(arma::Mat<ElementType>& m,
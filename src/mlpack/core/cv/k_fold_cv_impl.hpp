@@ -228,8 +228,10 @@ void KFoldCV<MLAlgorithm,
   binSize = source.n_cols / k;
   lastBinSize = source.n_cols - ((k - 1) * binSize);
 
-  destination = (k == 2) ? source : arma::join_rows(source,
-      source.cols(0, source.n_cols - lastBinSize - 1));
+  // Store a single copy of the data; every fold is expressed as a view into
+  // it, so no doubled dataset is needed.  (We cannot simply alias the source,
+  // since the source is allowed to go out of scope before this object does.)
+  destination = source;
 }
 
 template<typename MLAlgorithm,
@@ -246,13 +248,17 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // The folds are independent, so they can be trained and evaluated in
+  // parallel, each with its own model instance.  Each fold writes only its own
+  // entry of the evaluations vector, and only the last fold stores its model.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
@@ -273,7 +279,11 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // The folds are independent, so they can be trained and evaluated in
+  // parallel, each with its own model instance.  Each fold writes only its own
+  // entry of the evaluations vector, and only the last fold stores its model.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -282,7 +292,7 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
@@ -301,14 +311,8 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
-
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  // The folds are views into the stored data, so it can be shuffled in place.
+  math::ShuffleData(xs, ys, xs, ys);
 }
 
 template<typename MLAlgorithm,
@@ -323,22 +327,11 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
-  if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
+  // The folds are views into the stored data, so it can be shuffled in place.
   if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
+    math::ShuffleData(xs, ys, weights, xs, ys, weights);
   else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
-
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
-  if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+    math::ShuffleData(xs, ys, xs, ys);
 }
 
 template<typename MLAlgorithm,
@@ -370,14 +363,26 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
     arma::Mat<ElementType>& m,
     const size_t i)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  // The training set of the first fold is the block before the last bin, and
+  // the training set of the second fold is the block after the first bin; both
+  // are contiguous, so we can return a no-copy alias.  Note that the subset
+  // sizes differ, because the last bin may contain slightly more than
+  // 'binSize' points.
+  if (i == 0)
+  {
+    return arma::Mat<ElementType>(m.colptr(0), m.n_rows, (k - 1) * binSize,
+        false, true);
+  }
+  else if (i == 1)
+  {
+    return arma::Mat<ElementType>(m.colptr(binSize), m.n_rows,
+        lastBinSize + (k - 2) * binSize, false, true);
+  }
+
+  // For every later fold the training set wraps around the end of the dataset,
+  // so we have to join its two contiguous pieces.
+  return arma::join_rows(m.cols(binSize * i, m.n_cols - 1),
+      m.cols(0, binSize * (i - 1) - 1));
 }
 
 template<typename MLAlgorithm,
@@ -394,13 +399,20 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
     arma::Row<ElementType>& r,
     const size_t i)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
+  // See the matrix overload of GetTrainingSubset() for details of the three
+  // cases.
+  if (i == 0)
+  {
+    return arma::Row<ElementType>(r.colptr(0), (k - 1) * binSize, false, true);
+  }
+  else if (i == 1)
+  {
+    return arma::Row<ElementType>(r.colptr(binSize),
+        lastBinSize + (k - 2) * binSize, false, true);
+  }
 
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  return arma::join_rows(r.cols(binSize * i, r.n_cols - 1),
+      r.cols(0, binSize * (i - 1) - 1));
 }
 
 template<typename MLAlgorithm,
@@ -0,0 +1,122 @@
+/**
+ * @file classification_report.hpp
+ *
+ * Fused computation of classification metrics from a single confusion matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_REPORT_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_REPORT_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * The ClassificationReport computes accuracy, precision, recall and F1 from a
+ * single classification pass. Whereas evaluating the Accuracy, Precision,
+ * Recall and F1 metrics separately classifies the test items once per metric,
+ * this class classifies once, accumulates the confusion matrix in one
+ * parallel pass, and derives every metric from the confusion matrix counts.
+ *
+ * Microaveraged precision, recall and F1 are all equal to accuracy, so no
+ * separate accessors are provided for them.
+ *
+ * @code
+ * ClassificationReport report(model, data, labels);
+ * const double accuracy = report.Accuracy();
+ * const double f1 = report.MacroF1();
+ * @endcode
+ */
+class ClassificationReport
+{
+ public:
+  /**
+   * Run classification once and accumulate the confusion matrix.
+   *
+   * @param model A classification model.
+   * @param data Column-major data containing test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  ClassificationReport(MLAlgorithm& model,
+                       const DataType& data,
+                       const arma::Row<size_t>& labels);
+
+  /**
+   * Accumulate the confusion matrix from already computed predictions. This
+   * allows a caller that owns the prediction buffer to reuse it across
+   * evaluations.
+   *
+   * @param predictedLabels Predicted labels for the test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  ClassificationReport(const arma::Row<size_t>& predictedLabels,
+                       const arma::Row<size_t>& labels);
+
+  //! Get the proportion of correctly classified test items.
+  double Accuracy() const;
+
+  //! Get the precision of the given class; 0 if the class is never predicted.
+  double Precision(const size_t c) const;
+
+  //! Get the recall of the given class; 0 if the class has no instances.
+  double Recall(const size_t c) const;
+
+  //! Get the F1 score of the given class.
+  double F1(const size_t c) const;
+
+  //! Get the macroaveraged precision.
+  double MacroPrecision() const;
+
+  //! Get the macroaveraged recall.
+  double MacroRecall() const;
+
+  //! Get the macroaveraged F1 score.
+  double MacroF1() const;
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return confusion.n_rows; }
+
+  //! Get the confusion matrix; element (i, j) holds the number of test items
+  //! of class j that were predicted as class i.
+  const arma::Mat<size_t>& ConfusionMatrix() const { return confusion; }
+
+ private:
+  /**
+   * Accumulate the confusion matrix and the per-class counts.
+   *
+   * @param predictedLabels Predicted labels for the test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  void Accumulate(const arma::Row<size_t>& predictedLabels,
+                  const arma::Row<size_t>& labels);
+
+  //! The confusion matrix (predicted classes as rows, true classes as
+  //! columns).
+  arma::Mat<size_t> confusion;
+
+  //! The number of predictions of each class (row sums).
+  arma::Col<size_t> predictedCounts;
+
+  //! The number of instances of each class (column sums).
+  arma::Col<size_t> actualCounts;
+
+  //! The number of correctly classified test items.
+  size_t correct;
+
+  //! The total number of test items.
+  size_t total;
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "classification_report_impl.hpp"
+
+#endif
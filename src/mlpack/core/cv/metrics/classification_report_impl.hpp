@@ -0,0 +1,132 @@
+/**
+ * @file classification_report_impl.hpp
+ *
+ * Implementation of the class ClassificationReport.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CLASSIFICATION_REPORT_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_CLASSIFICATION_REPORT_IMPL_HPP
+
+#include <mlpack/core/cv/metrics/facilities.hpp>
+
+namespace mlpack {
+namespace cv {
+
+template<typename MLAlgorithm, typename DataType>
+ClassificationReport::ClassificationReport(MLAlgorithm& model,
+                                           const DataType& data,
+                                           const arma::Row<size_t>& labels)
+{
+  AssertSizes(data, labels, "ClassificationReport()");
+
+  arma::Row<size_t> predictedLabels;
+  model.Classify(data, predictedLabels);
+
+  Accumulate(predictedLabels, labels);
+}
+
+inline ClassificationReport::ClassificationReport(
+    const arma::Row<size_t>& predictedLabels,
+    const arma::Row<size_t>& labels)
+{
+  if (predictedLabels.n_elem != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "ClassificationReport(): number of predictions ("
+        << predictedLabels.n_elem << ") does not match number of labels ("
+        << labels.n_elem << ")!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  Accumulate(predictedLabels, labels);
+}
+
+inline void ClassificationReport::Accumulate(
+    const arma::Row<size_t>& predictedLabels,
+    const arma::Row<size_t>& labels)
+{
+  const size_t numClasses =
+      std::max(labels.max(), predictedLabels.max()) + 1;
+
+  confusion.zeros(numClasses, numClasses);
+  total = labels.n_elem;
+
+  #pragma omp parallel
+  {
+    arma::Mat<size_t> localConfusion(numClasses, numClasses,
+        arma::fill::zeros);
+
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < (omp_size_t) labels.n_elem; ++i)
+      ++localConfusion(predictedLabels[i], labels[i]);
+
+    #pragma omp critical (ClassificationReportAccumulate)
+    confusion += localConfusion;
+  }
+
+  predictedCounts = arma::sum(confusion, 1);
+  actualCounts = arma::sum(confusion, 0).t();
+  correct = arma::accu(confusion.diag());
+}
+
+inline double ClassificationReport::Accuracy() const
+{
+  return double(correct) / total;
+}
+
+inline double ClassificationReport::Precision(const size_t c) const
+{
+  return (predictedCounts(c) == 0) ? 0.0 :
+      double(confusion(c, c)) / predictedCounts(c);
+}
+
+inline double ClassificationReport::Recall(const size_t c) const
+{
+  return (actualCounts(c) == 0) ? 0.0 :
+      double(confusion(c, c)) / actualCounts(c);
+}
+
+inline double ClassificationReport::F1(const size_t c) const
+{
+  const double precision = Precision(c);
+  const double recall = Recall(c);
+
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+inline double ClassificationReport::MacroPrecision() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += Precision(c);
+
+  return sum / NumClasses();
+}
+
+inline double ClassificationReport::MacroRecall() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += Recall(c);
+
+  return sum / NumClasses();
+}
+
+inline double ClassificationReport::MacroF1() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += F1(c);
+
+  return sum / NumClasses();
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
@@ -208,6 +208,22 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on the given fraction of the training set (a prefix view of the
+   * training split; no data is copied) and assess performance on the full
+   * validation set by using the class Metric.  This is the partial-budget
+   * evaluation used by successive-halving hyper-parameter tuning: cheap,
+   * noisy estimates at small fractions, converging to Evaluate() at
+   * fraction 1.
+   *
+   * @param fraction Fraction of the training set to train on (in (0, 1]).
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateFraction(const double fraction,
+                          const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -301,6 +317,27 @@ class SimpleCV
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+
+  /**
+   * Train on the first numPoints training points and run evaluation, in the
+   * case of non-weighted learning.
+   */
+  template<typename... MLAlgorithmArgs,
+           bool Enabled = !Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type>
+  double TrainAndEvaluateFraction(const size_t numPoints,
+                                  const MLAlgorithmArgs&... args);
+
+  /**
+   * Train on the first numPoints training points and run evaluation, in the
+   * case of supporting weighted learning.
+   */
+  template<typename... MLAlgorithmArgs,
+           bool Enabled = Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  double TrainAndEvaluateFraction(const size_t numPoints,
+                                  const MLAlgorithmArgs&... args);
 };
 
 } // namespace cv
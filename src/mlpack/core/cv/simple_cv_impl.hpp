@@ -197,6 +197,33 @@ double SimpleCV<MLAlgorithm,
   return TrainAndEvaluate(args...);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateFraction(
+    const double fraction,
+    const MLAlgorithmArgs&... args)
+{
+  if (fraction <= 0.0 || fraction > 1.0)
+    throw std::invalid_argument("SimpleCV::EvaluateFraction(): the fraction "
+        "parameter should be more than 0 and at most 1");
+
+  const size_t numPoints = std::max(size_t(1),
+      size_t(round(trainingXs.n_cols * fraction)));
+
+  if (numPoints == trainingXs.n_cols)
+    return TrainAndEvaluate(args...);
+
+  return TrainAndEvaluateFraction(numPoints, args...);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -320,6 +347,59 @@ double SimpleCV<MLAlgorithm,
   return Metric::Evaluate(*modelPtr, validationXs, validationYs);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs, bool Enabled, typename>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::TrainAndEvaluateFraction(
+    const size_t numPoints,
+    const MLAlgorithmArgs&... args)
+{
+  MatType subsetXs = GetSubset(trainingXs, 0, numPoints - 1);
+  PredictionsType subsetYs = GetSubset(trainingYs, 0, numPoints - 1);
+
+  modelPtr.reset(new MLAlgorithm(base.Train(subsetXs, subsetYs, args...)));
+
+  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs, bool Enabled, typename, typename>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::TrainAndEvaluateFraction(
+    const size_t numPoints,
+    const MLAlgorithmArgs&... args)
+{
+  MatType subsetXs = GetSubset(trainingXs, 0, numPoints - 1);
+  PredictionsType subsetYs = GetSubset(trainingYs, 0, numPoints - 1);
+
+  if (trainingWeights.n_elem > 0)
+  {
+    WeightsType subsetWeights = GetSubset(trainingWeights, 0, numPoints - 1);
+    modelPtr.reset(new MLAlgorithm(
+        base.Train(subsetXs, subsetYs, subsetWeights, args...)));
+  }
+  else
+  {
+    modelPtr.reset(new MLAlgorithm(base.Train(subsetXs, subsetYs, args...)));
+  }
+
+  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+}
+
 } // namespace cv
 } // namespace mlpack
 
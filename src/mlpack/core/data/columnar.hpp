@@ -0,0 +1,80 @@
+/**
+ * @file columnar.hpp
+ * @author Ryan Curtin
+ *
+ * A native mlpack columnar container format.  Unlike the row/column-complete
+ * formats supported by Load() and Save(), this format stores each dimension
+ * (each row of the column-major mlpack matrix) as its own block, so a subset
+ * of dimensions can be read from a wide dataset without touching the rest of
+ * the file.  Blocks can optionally be compressed with a simple zero-run-length
+ * codec.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Save a matrix in the mlpack columnar format.  Each dimension of the data
+ * (each row of the matrix) is written as a separate block with its own entry
+ * in the file's offset table, so it can later be loaded independently.  The
+ * conventional extension is .mlc.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param compress If true, compress each block with zero-run-length encoding.
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const bool fatal = false,
+                  const bool compress = false);
+
+/**
+ * Load a matrix saved in the mlpack columnar format, reading all dimensions.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load contents of file into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const bool fatal = false);
+
+/**
+ * Load only the given dimensions of a matrix saved in the mlpack columnar
+ * format.  Row i of the output matrix holds dimension dimensions[i] of the
+ * stored dataset; blocks for other dimensions are never read from disk.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load the selected dimensions into.
+ * @param dimensions Indices of the dimensions to load.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const arma::uvec& dimensions,
+                  const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+#include "columnar_impl.hpp"
+
+#endif
@@ -0,0 +1,407 @@
+/**
+ * @file columnar_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the mlpack columnar format reader and writer defined in
+ * columnar.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_IMPL_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_IMPL_HPP
+
+#include <mlpack/core/util/timers.hpp>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "columnar.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic string at the start of every columnar file.
+const char* const COLUMNAR_MAGIC = "MLPACK_COL_BIN\n";
+
+//! Per-dimension block flags.
+enum ColumnarBlockFlags : uint64_t
+{
+  COLUMNAR_BLOCK_RAW = 0,
+  COLUMNAR_BLOCK_RLE = 1
+};
+
+//! An entry of the offset table: where a dimension's block lives on disk.
+struct ColumnarBlockEntry
+{
+  uint64_t offset;
+  uint64_t storedBytes;
+  uint64_t flags;
+};
+
+/**
+ * Compress a buffer with zero-run-length encoding.  The output is a sequence
+ * of [u32 literalLength][literal bytes][u32 zeroRunLength] records; numeric
+ * data full of exact zeros (sparse-ish dense columns) shrinks considerably,
+ * and incompressible blocks only grow by the record headers.
+ */
+inline void ZeroRLECompress(const char* input,
+                            const size_t length,
+                            std::vector<char>& output)
+{
+  output.clear();
+  size_t pos = 0;
+  while (pos < length)
+  {
+    // Find the extent of the next literal run (until a run of >= 8 zeros).
+    size_t literalEnd = pos;
+    size_t zeroStart = length;
+    while (literalEnd < length)
+    {
+      size_t z = literalEnd;
+      while (z < length && input[z] == 0)
+        ++z;
+      if (z - literalEnd >= 8 || z == length)
+      {
+        zeroStart = literalEnd;
+        break;
+      }
+      literalEnd = z + 1;
+    }
+    if (zeroStart == length)
+      zeroStart = literalEnd = length;
+
+    // Zero run follows the literal run.
+    size_t zeroEnd = zeroStart;
+    while (zeroEnd < length && input[zeroEnd] == 0)
+      ++zeroEnd;
+
+    const uint32_t literalLen = (uint32_t) (zeroStart - pos);
+    const uint32_t zeroLen = (uint32_t) (zeroEnd - zeroStart);
+
+    const size_t outPos = output.size();
+    output.resize(outPos + 2 * sizeof(uint32_t) + literalLen);
+    std::memcpy(&output[outPos], &literalLen, sizeof(uint32_t));
+    std::memcpy(&output[outPos + sizeof(uint32_t)], input + pos, literalLen);
+    std::memcpy(&output[outPos + sizeof(uint32_t) + literalLen], &zeroLen,
+        sizeof(uint32_t));
+
+    pos = zeroEnd;
+  }
+}
+
+/**
+ * Invert ZeroRLECompress().  Returns false if the stored stream is truncated
+ * or does not decompress to exactly expectedLength bytes.
+ */
+inline bool ZeroRLEDecompress(const std::vector<char>& input,
+                              char* output,
+                              const size_t expectedLength)
+{
+  size_t inPos = 0, outPos = 0;
+  while (inPos < input.size())
+  {
+    if (inPos + sizeof(uint32_t) > input.size())
+      return false;
+    uint32_t literalLen;
+    std::memcpy(&literalLen, &input[inPos], sizeof(uint32_t));
+    inPos += sizeof(uint32_t);
+
+    if (inPos + literalLen + sizeof(uint32_t) > input.size() ||
+        outPos + literalLen > expectedLength)
+      return false;
+    std::memcpy(output + outPos, &input[inPos], literalLen);
+    inPos += literalLen;
+    outPos += literalLen;
+
+    uint32_t zeroLen;
+    std::memcpy(&zeroLen, &input[inPos], sizeof(uint32_t));
+    inPos += sizeof(uint32_t);
+
+    if (outPos + zeroLen > expectedLength)
+      return false;
+    std::memset(output + outPos, 0, zeroLen);
+    outPos += zeroLen;
+  }
+
+  return (outPos == expectedLength);
+}
+
+/**
+ * Read the header and offset table of a columnar file.  Returns false (after
+ * printing) on any format problem.
+ */
+inline bool ReadColumnarHeader(std::ifstream& stream,
+                               const std::string& filename,
+                               const bool fatal,
+                               const size_t elemSize,
+                               size_t& rows,
+                               size_t& cols,
+                               std::vector<ColumnarBlockEntry>& table)
+{
+  const size_t magicLen = std::strlen(COLUMNAR_MAGIC);
+  std::string magic(magicLen, '\0');
+  stream.read(&magic[0], magicLen);
+
+  uint64_t storedElemSize = 0, storedRows = 0, storedCols = 0;
+  stream.read((char*) &storedElemSize, sizeof(uint64_t));
+  stream.read((char*) &storedRows, sizeof(uint64_t));
+  stream.read((char*) &storedCols, sizeof(uint64_t));
+
+  if (!stream || magic != COLUMNAR_MAGIC)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is not an mlpack columnar file."
+          << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is not an mlpack columnar file; "
+          << "load failed." << std::endl;
+
+    return false;
+  }
+
+  if (storedElemSize != elemSize)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' holds elements of size "
+          << storedElemSize << ", but elements of size " << elemSize
+          << " were requested." << std::endl;
+    else
+      Log::Warn << "'" << filename << "' holds elements of size "
+          << storedElemSize << ", but elements of size " << elemSize
+          << " were requested; load failed." << std::endl;
+
+    return false;
+  }
+
+  rows = (size_t) storedRows;
+  cols = (size_t) storedCols;
+  table.resize(rows);
+  stream.read((char*) table.data(), rows * sizeof(ColumnarBlockEntry));
+  if (!stream)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' has a truncated offset table."
+          << std::endl;
+    else
+      Log::Warn << "'" << filename << "' has a truncated offset table; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Read one dimension's block into the given row of the output matrix.
+ */
+template<typename eT>
+bool ReadColumnarBlock(std::ifstream& stream,
+                       const ColumnarBlockEntry& entry,
+                       arma::Mat<eT>& matrix,
+                       const size_t row)
+{
+  const size_t rawBytes = matrix.n_cols * sizeof(eT);
+  arma::Row<eT> values(matrix.n_cols);
+
+  stream.seekg(entry.offset);
+  if (entry.flags == COLUMNAR_BLOCK_RLE)
+  {
+    std::vector<char> stored(entry.storedBytes);
+    stream.read(stored.data(), entry.storedBytes);
+    if (!stream ||
+        !ZeroRLEDecompress(stored, (char*) values.memptr(), rawBytes))
+      return false;
+  }
+  else
+  {
+    stream.read((char*) values.memptr(), rawBytes);
+    if (!stream)
+      return false;
+  }
+
+  matrix.row(row) = values;
+  return true;
+}
+
+} // namespace details
+
+template<typename eT>
+bool SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const bool fatal,
+                  const bool compress)
+{
+  Timer::Start("saving_data");
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing; save "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Saving mlpack columnar data to '" << filename << "'."
+      << std::endl;
+
+  // Header: magic, element size, dimensionality, number of points.
+  const uint64_t elemSize = sizeof(eT);
+  const uint64_t rows = matrix.n_rows;
+  const uint64_t cols = matrix.n_cols;
+  stream.write(details::COLUMNAR_MAGIC,
+      std::strlen(details::COLUMNAR_MAGIC));
+  stream.write((const char*) &elemSize, sizeof(uint64_t));
+  stream.write((const char*) &rows, sizeof(uint64_t));
+  stream.write((const char*) &cols, sizeof(uint64_t));
+
+  // Reserve space for the offset table; we fill it in after writing blocks.
+  std::vector<details::ColumnarBlockEntry> table(matrix.n_rows);
+  const std::streampos tablePos = stream.tellp();
+  stream.write((const char*) table.data(),
+      table.size() * sizeof(details::ColumnarBlockEntry));
+
+  // Write one block per dimension.
+  std::vector<char> compressed;
+  for (size_t row = 0; row < matrix.n_rows; ++row)
+  {
+    // Gather the dimension into contiguous storage.
+    const arma::Row<eT> values = matrix.row(row);
+    const size_t rawBytes = values.n_elem * sizeof(eT);
+
+    table[row].offset = (uint64_t) stream.tellp();
+    if (compress)
+    {
+      details::ZeroRLECompress((const char*) values.memptr(), rawBytes,
+          compressed);
+      // Only keep the compressed form if it is actually smaller.
+      if (compressed.size() < rawBytes)
+      {
+        table[row].storedBytes = compressed.size();
+        table[row].flags = details::COLUMNAR_BLOCK_RLE;
+        stream.write(compressed.data(), compressed.size());
+        continue;
+      }
+    }
+
+    table[row].storedBytes = rawBytes;
+    table[row].flags = details::COLUMNAR_BLOCK_RAW;
+    stream.write((const char*) values.memptr(), rawBytes);
+  }
+
+  // Now go back and fill in the offset table.
+  stream.seekp(tablePos);
+  stream.write((const char*) table.data(),
+      table.size() * sizeof(details::ColumnarBlockEntry));
+
+  const bool success = (bool) stream;
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+  }
+
+  Timer::Stop("saving_data");
+  return success;
+}
+
+template<typename eT>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const bool fatal)
+{
+  // Load every dimension.
+  return LoadColumnar(filename, matrix, arma::uvec(), fatal);
+}
+
+template<typename eT>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const arma::uvec& dimensions,
+                  const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  size_t rows, cols;
+  std::vector<details::ColumnarBlockEntry> table;
+  if (!details::ReadColumnarHeader(stream, filename, fatal, sizeof(eT), rows,
+      cols, table))
+  {
+    Timer::Stop("loading_data");
+    return false;
+  }
+
+  // An empty dimension list means "load everything".
+  const size_t outRows = (dimensions.n_elem == 0) ? rows : dimensions.n_elem;
+  matrix.set_size(outRows, cols);
+
+  bool success = true;
+  for (size_t i = 0; i < outRows; ++i)
+  {
+    const size_t dim = (dimensions.n_elem == 0) ? i : (size_t) dimensions[i];
+    if (dim >= rows)
+    {
+      if (fatal)
+        Log::Fatal << "Requested dimension " << dim << ", but '" << filename
+            << "' only has " << rows << " dimensions." << std::endl;
+      else
+        Log::Warn << "Requested dimension " << dim << ", but '" << filename
+            << "' only has " << rows << " dimensions; load failed."
+            << std::endl;
+
+      success = false;
+      break;
+    }
+
+    if (!details::ReadColumnarBlock(stream, table[dim], matrix, i))
+    {
+      if (fatal)
+        Log::Fatal << "Block for dimension " << dim << " of '" << filename
+            << "' is corrupt." << std::endl;
+      else
+        Log::Warn << "Block for dimension " << dim << " of '" << filename
+            << "' is corrupt; load failed." << std::endl;
+
+      success = false;
+      break;
+    }
+  }
+
+  if (success)
+    Log::Info << "Loaded " << matrix.n_rows << " of " << rows << " dimensions"
+        << " (" << cols << " points) from '" << filename << "'." << std::endl;
+
+  Timer::Stop("loading_data");
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
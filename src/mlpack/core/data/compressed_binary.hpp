@@ -0,0 +1,64 @@
+/**
+ * @file compressed_binary.hpp
+ * @author Ryan Curtin
+ *
+ * A frame-compressed binary matrix format for large checkpoint files.  The
+ * matrix is split into column-block frames; each frame is byte-shuffled,
+ * delta-coded and run-length compressed, and the frames are compressed and
+ * decompressed in parallel with OpenMP while the file itself is read and
+ * written sequentially in frame order.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_BINARY_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_BINARY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Save a matrix in the mlpack frame-compressed binary format.  The matrix is
+ * written as a sequence of column-block frames of roughly a megabyte each;
+ * frames are compressed in parallel, and any frame that does not shrink is
+ * stored raw, so the file is never much larger than the plain binary form.
+ * The conventional extension is .cbin, and Save() dispatches to this writer
+ * for that extension.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool SaveCompressedBinary(const std::string& filename,
+                          const arma::Mat<eT>& matrix,
+                          const bool fatal = false);
+
+/**
+ * Load a matrix saved in the mlpack frame-compressed binary format.  The
+ * output matrix is allocated up front and frames are decompressed in parallel
+ * directly into their column blocks.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load contents of file into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadCompressedBinary(const std::string& filename,
+                          arma::Mat<eT>& matrix,
+                          const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+#include "compressed_binary_impl.hpp"
+
+#endif
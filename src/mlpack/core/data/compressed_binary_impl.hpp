@@ -0,0 +1,392 @@
+/**
+ * @file compressed_binary_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the frame-compressed binary matrix format defined in
+ * compressed_binary.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_BINARY_IMPL_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_BINARY_IMPL_HPP
+
+#include <mlpack/core/util/timers.hpp>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "compressed_binary.hpp"
+// The zero-run-length codec is shared with the columnar format.
+#include "columnar.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic string at the start of every frame-compressed binary file.
+const char* const COMPRESSED_BINARY_MAGIC = "MLPACK_CBIN\n";
+
+//! Per-frame storage flags.
+enum CompressedFrameFlags : uint64_t
+{
+  COMPRESSED_FRAME_RAW = 0,
+  COMPRESSED_FRAME_SHUFFLE_RLE = 1
+};
+
+/**
+ * Byte-shuffle and delta-code a frame: byte k of every element is gathered
+ * into its own contiguous lane, and each lane is XOR-coded against its
+ * previous byte.  Elements of similar magnitude then turn their sign and
+ * exponent lanes into long zero runs, which ZeroRLECompress() can exploit;
+ * the transform is cheap and exactly invertible.
+ */
+inline void ShuffleBytes(const char* input,
+                         const size_t count,
+                         const size_t elemSize,
+                         std::vector<char>& output)
+{
+  output.resize(count * elemSize);
+  for (size_t b = 0; b < elemSize; ++b)
+  {
+    char prev = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const char cur = input[i * elemSize + b];
+      output[b * count + i] = cur ^ prev;
+      prev = cur;
+    }
+  }
+}
+
+/**
+ * Invert ShuffleBytes(); output must hold count * elemSize bytes.
+ */
+inline void UnshuffleBytes(const char* input,
+                           const size_t count,
+                           const size_t elemSize,
+                           char* output)
+{
+  for (size_t b = 0; b < elemSize; ++b)
+  {
+    char prev = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      prev ^= input[b * count + i];
+      output[i * elemSize + b] = prev;
+    }
+  }
+}
+
+/**
+ * Read and validate the header of a frame-compressed binary file.  Returns
+ * false (after printing) on any format problem.
+ */
+inline bool ReadCompressedBinaryHeader(std::ifstream& stream,
+                                       const std::string& filename,
+                                       const bool fatal,
+                                       const size_t elemSize,
+                                       size_t& rows,
+                                       size_t& cols,
+                                       size_t& blockCols)
+{
+  const size_t magicLen = std::strlen(COMPRESSED_BINARY_MAGIC);
+  std::string magic(magicLen, '\0');
+  stream.read(&magic[0], magicLen);
+
+  uint64_t storedElemSize = 0, storedRows = 0, storedCols = 0,
+      storedBlockCols = 0;
+  stream.read((char*) &storedElemSize, sizeof(uint64_t));
+  stream.read((char*) &storedRows, sizeof(uint64_t));
+  stream.read((char*) &storedCols, sizeof(uint64_t));
+  stream.read((char*) &storedBlockCols, sizeof(uint64_t));
+
+  if (!stream || magic != COMPRESSED_BINARY_MAGIC || storedBlockCols == 0)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is not an mlpack compressed binary "
+          << "file." << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is not an mlpack compressed binary "
+          << "file; load failed." << std::endl;
+
+    return false;
+  }
+
+  if (storedElemSize != elemSize)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' holds elements of size "
+          << storedElemSize << ", but elements of size " << elemSize
+          << " were requested." << std::endl;
+    else
+      Log::Warn << "'" << filename << "' holds elements of size "
+          << storedElemSize << ", but elements of size " << elemSize
+          << " were requested; load failed." << std::endl;
+
+    return false;
+  }
+
+  rows = (size_t) storedRows;
+  cols = (size_t) storedCols;
+  blockCols = (size_t) storedBlockCols;
+  return true;
+}
+
+} // namespace details
+
+template<typename eT>
+bool SaveCompressedBinary(const std::string& filename,
+                          const arma::Mat<eT>& matrix,
+                          const bool fatal)
+{
+  Timer::Start("saving_data");
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing; save "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Saving mlpack compressed binary data to '" << filename << "'."
+      << std::endl;
+
+  // Aim for frames of roughly a megabyte, so that compression parallelizes
+  // over many frames without large per-frame scratch buffers.
+  const uint64_t elemSize = sizeof(eT);
+  const uint64_t rows = matrix.n_rows;
+  const uint64_t cols = matrix.n_cols;
+  const uint64_t bytesPerCol = std::max<uint64_t>(1, rows * sizeof(eT));
+  const uint64_t blockCols = std::max<uint64_t>(1, (1 << 20) / bytesPerCol);
+
+  stream.write(details::COMPRESSED_BINARY_MAGIC,
+      std::strlen(details::COMPRESSED_BINARY_MAGIC));
+  stream.write((const char*) &elemSize, sizeof(uint64_t));
+  stream.write((const char*) &rows, sizeof(uint64_t));
+  stream.write((const char*) &cols, sizeof(uint64_t));
+  stream.write((const char*) &blockCols, sizeof(uint64_t));
+
+  const size_t numFrames = (size_t) ((cols + blockCols - 1) / blockCols);
+
+  // Frames are compressed a group at a time, so that the buffers held in
+  // memory stay bounded regardless of the matrix size.
+#ifdef HAS_OPENMP
+  const size_t groupSize = 4 * (size_t) omp_get_max_threads();
+#else
+  const size_t groupSize = 4;
+#endif
+
+  std::vector<std::vector<char>> shuffled(groupSize);
+  std::vector<std::vector<char>> compressed(groupSize);
+
+  for (size_t begin = 0; begin < numFrames; begin += groupSize)
+  {
+    const size_t end = std::min(numFrames, begin + groupSize);
+
+    // Compress the frames of this group in parallel...
+    #pragma omp parallel for
+    for (omp_size_t f = (omp_size_t) begin; f < (omp_size_t) end; ++f)
+    {
+      const size_t firstCol = (size_t) f * (size_t) blockCols;
+      const size_t lastCol = std::min((size_t) cols,
+          firstCol + (size_t) blockCols);
+      const size_t count = (lastCol - firstCol) * (size_t) rows;
+
+      details::ShuffleBytes((const char*) matrix.colptr(firstCol), count,
+          sizeof(eT), shuffled[f - begin]);
+      details::ZeroRLECompress(shuffled[f - begin].data(), count * sizeof(eT),
+          compressed[f - begin]);
+    }
+
+    // ...then write them out in frame order.
+    for (size_t f = begin; f < end; ++f)
+    {
+      const size_t firstCol = f * (size_t) blockCols;
+      const size_t lastCol = std::min((size_t) cols,
+          firstCol + (size_t) blockCols);
+      const size_t rawBytes = (lastCol - firstCol) * (size_t) rows *
+          sizeof(eT);
+      const std::vector<char>& buf = compressed[f - begin];
+
+      // Only keep the compressed form if it is actually smaller.
+      if (buf.size() < rawBytes)
+      {
+        const uint64_t flags = details::COMPRESSED_FRAME_SHUFFLE_RLE;
+        const uint64_t storedBytes = buf.size();
+        stream.write((const char*) &flags, sizeof(uint64_t));
+        stream.write((const char*) &storedBytes, sizeof(uint64_t));
+        stream.write(buf.data(), buf.size());
+      }
+      else
+      {
+        const uint64_t flags = details::COMPRESSED_FRAME_RAW;
+        const uint64_t storedBytes = rawBytes;
+        stream.write((const char*) &flags, sizeof(uint64_t));
+        stream.write((const char*) &storedBytes, sizeof(uint64_t));
+        stream.write((const char*) matrix.colptr(firstCol), rawBytes);
+      }
+    }
+  }
+
+  const bool success = (bool) stream;
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+  }
+
+  Timer::Stop("saving_data");
+  return success;
+}
+
+template<typename eT>
+bool LoadCompressedBinary(const std::string& filename,
+                          arma::Mat<eT>& matrix,
+                          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  size_t rows, cols, blockCols;
+  if (!details::ReadCompressedBinaryHeader(stream, filename, fatal,
+      sizeof(eT), rows, cols, blockCols))
+  {
+    Timer::Stop("loading_data");
+    return false;
+  }
+
+  matrix.set_size(rows, cols);
+
+  const size_t numFrames = (cols + blockCols - 1) / blockCols;
+
+#ifdef HAS_OPENMP
+  const size_t groupSize = 4 * (size_t) omp_get_max_threads();
+#else
+  const size_t groupSize = 4;
+#endif
+
+  std::vector<std::vector<char>> stored(groupSize);
+  std::vector<uint64_t> flags(groupSize);
+
+  bool success = true;
+  for (size_t begin = 0; begin < numFrames && success; begin += groupSize)
+  {
+    const size_t end = std::min(numFrames, begin + groupSize);
+
+    // Read this group's frames sequentially; raw frames go straight into
+    // their column block, compressed frames into per-frame buffers.
+    for (size_t f = begin; f < end; ++f)
+    {
+      const size_t firstCol = f * blockCols;
+      const size_t lastCol = std::min(cols, firstCol + blockCols);
+      const size_t rawBytes = (lastCol - firstCol) * rows * sizeof(eT);
+
+      uint64_t frameFlags = 0, storedBytes = 0;
+      stream.read((char*) &frameFlags, sizeof(uint64_t));
+      stream.read((char*) &storedBytes, sizeof(uint64_t));
+      flags[f - begin] = frameFlags;
+
+      if (frameFlags == details::COMPRESSED_FRAME_RAW)
+      {
+        if (storedBytes != rawBytes)
+        {
+          success = false;
+          break;
+        }
+        stream.read((char*) matrix.colptr(firstCol), rawBytes);
+      }
+      else
+      {
+        stored[f - begin].resize((size_t) storedBytes);
+        stream.read(stored[f - begin].data(), storedBytes);
+      }
+
+      if (!stream)
+      {
+        success = false;
+        break;
+      }
+    }
+
+    if (!success)
+      break;
+
+    // Decompress the group's compressed frames in parallel; each frame
+    // writes only to its own disjoint column block.
+    bool framesOk = true;
+    #pragma omp parallel for reduction(&&:framesOk)
+    for (omp_size_t f = (omp_size_t) begin; f < (omp_size_t) end; ++f)
+    {
+      if (flags[f - begin] != details::COMPRESSED_FRAME_SHUFFLE_RLE)
+        continue;
+
+      const size_t firstCol = (size_t) f * blockCols;
+      const size_t lastCol = std::min(cols, firstCol + blockCols);
+      const size_t count = (lastCol - firstCol) * rows;
+
+      std::vector<char> shuffled(count * sizeof(eT));
+      if (!details::ZeroRLEDecompress(stored[f - begin], shuffled.data(),
+          count * sizeof(eT)))
+      {
+        framesOk = false;
+        continue;
+      }
+      details::UnshuffleBytes(shuffled.data(), count, sizeof(eT),
+          (char*) matrix.colptr(firstCol));
+    }
+
+    success = framesOk;
+  }
+
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' has a truncated or corrupt frame."
+          << std::endl;
+    else
+      Log::Warn << "'" << filename << "' has a truncated or corrupt frame; "
+          << "load failed." << std::endl;
+  }
+  else
+  {
+    Log::Info << "Loaded " << rows << " x " << cols << " matrix from '"
+        << filename << "'." << std::endl;
+  }
+
+  Timer::Stop("loading_data");
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
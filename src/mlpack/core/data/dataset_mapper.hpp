@@ -128,6 +128,22 @@ class DatasetMapper
   typename PolicyType::MappedType UnmapValue(const InputType& input,
                                              const size_t dimension);
 
+  /**
+   * Freeze the mapper for concurrent read-only use.  This compiles the
+   * forward maps of every categorical dimension into flat open-addressing
+   * tables, which UnmapValue() then queries without touching (or possibly
+   * modifying) the underlying std::unordered_map---so any number of threads
+   * may call UnmapValue() concurrently on a frozen mapper, e.g. during
+   * parallel parsing or parallel prediction over categorical data.
+   *
+   * Any subsequent mutation (MapString() or SetDimensionality()) discards
+   * the frozen state; call Freeze() again after further ingestion.
+   */
+  void Freeze();
+
+  //! Return whether the mapper is currently frozen for concurrent reads.
+  bool Frozen() const { return frozen; }
+
   //! Return the type of a given dimension (numeric or categorical).
   Datatype Type(const size_t dimension) const;
   //! Modify the type of a given dimension (be careful!).
@@ -155,6 +171,13 @@ class DatasetMapper
   {
     ar & BOOST_SERIALIZATION_NVP(types);
     ar & BOOST_SERIALIZATION_NVP(maps);
+
+    // The compiled tables are rebuilt on demand, not serialized.
+    if (Archive::is_loading::value)
+    {
+      frozen = false;
+      frozenMaps.clear();
+    }
   }
 
   //! Return the policy of the mapper.
@@ -187,6 +210,28 @@ class DatasetMapper
   //! maps object stores string and numerical pairs.
   MapType maps;
 
+  /**
+   * A forward map compiled into a flat open-addressing table with linear
+   * probing.  Buckets hold 1-based indices into the entry array (0 marks an
+   * empty bucket); the table is sized to a power of two at least twice the
+   * number of entries, so probe chains stay short.
+   */
+  struct FrozenTable
+  {
+    //! 1-based indices into entries; 0 means the bucket is empty.
+    std::vector<size_t> buckets;
+    //! The (input, mapped value) pairs of the dimension.
+    std::vector<std::pair<InputType, typename PolicyType::MappedType>> entries;
+    //! Bucket index mask (buckets.size() - 1).
+    size_t mask;
+  };
+
+  //! The compiled per-dimension tables; only valid while frozen is true.
+  std::vector<FrozenTable> frozenMaps;
+
+  //! Whether the compiled tables are in sync with maps.
+  bool frozen = false;
+
   //! policy object tells dataset mapper how the categorical values should be
   //  mapped to the maps object. It is used in MapString() and MapTokens().
   PolicyType policy;
@@ -43,6 +43,8 @@ inline void DatasetMapper<PolicyType, InputType>::SetDimensionality(
 {
   types = std::vector<Datatype>(dimensionality, Datatype::numeric);
   maps.clear();
+  frozenMaps.clear();
+  frozen = false;
 }
 
 // Utility helper function to call MapFirstPass.
@@ -86,6 +88,8 @@ inline T DatasetMapper<PolicyType, InputType>::MapString(
     const InputType& input,
     const size_t dimension)
 {
+  // A new mapping may be created, so any compiled tables go stale.
+  frozen = false;
   return policy.template MapString<MapType, T>(input, dimension, maps, types);
 }
 
@@ -179,6 +183,29 @@ DatasetMapper<PolicyType, InputType>::UnmapValue(
     const InputType& input,
     const size_t dimension)
 {
+  // If the mapper is frozen, query the compiled table; this path reads only
+  // immutable state, so concurrent calls need no synchronization.
+  if (frozen && dimension < frozenMaps.size())
+  {
+    const FrozenTable& table = frozenMaps[dimension];
+    if (!table.buckets.empty())
+    {
+      size_t slot = std::hash<InputType>()(input) & table.mask;
+      while (table.buckets[slot] != 0)
+      {
+        const auto& entry = table.entries[table.buckets[slot] - 1];
+        if (entry.first == input)
+          return entry.second;
+        slot = (slot + 1) & table.mask;
+      }
+    }
+
+    std::ostringstream oss;
+    oss << "DatasetMapper<PolicyType, InputType>::UnmapValue(): input '"
+        << input << "' unknown for dimension " << dimension;
+    throw std::invalid_argument(oss.str());
+  }
+
   // Throw an exception if the value doesn't exist.
   if (maps[dimension].first.count(input) == 0)
   {
@@ -191,6 +218,49 @@ DatasetMapper<PolicyType, InputType>::UnmapValue(
   return maps[dimension].first.at(input);
 }
 
+// Compile the forward maps into open-addressing tables.
+template<typename PolicyType, typename InputType>
+inline void DatasetMapper<PolicyType, InputType>::Freeze()
+{
+  frozenMaps.clear();
+  frozenMaps.resize(types.size());
+
+  for (typename MapType::const_iterator it = maps.begin(); it != maps.end();
+       ++it)
+  {
+    const size_t dimension = it->first;
+    if (dimension >= frozenMaps.size())
+      frozenMaps.resize(dimension + 1);
+
+    const ForwardMapType& forward = it->second.first;
+    FrozenTable& table = frozenMaps[dimension];
+
+    table.entries.assign(forward.begin(), forward.end());
+    if (table.entries.empty())
+      continue;
+
+    // Size the bucket array to a power of two at least twice the number of
+    // entries, so the load factor stays below 0.5.
+    size_t capacity = 2;
+    while (capacity < 2 * table.entries.size())
+      capacity *= 2;
+
+    table.buckets.assign(capacity, 0);
+    table.mask = capacity - 1;
+
+    for (size_t i = 0; i < table.entries.size(); ++i)
+    {
+      size_t slot = std::hash<InputType>()(table.entries[i].first) &
+          table.mask;
+      while (table.buckets[slot] != 0)
+        slot = (slot + 1) & table.mask;
+      table.buckets[slot] = i + 1;
+    }
+  }
+
+  frozen = true;
+}
+
 // Get the type of a particular dimension.
 template<typename PolicyType, typename InputType>
 inline Datatype DatasetMapper<PolicyType, InputType>::Type(
@@ -22,7 +22,8 @@ enum format
   autodetect,
   text,
   xml,
-  binary
+  binary,
+  raw // mlpack's native compact binary format; see raw_model_archive.hpp.
 };
 
 } // namespace data
@@ -71,6 +71,41 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute all of the given dimensions in a single parallel pass over the
+   * matrix, replacing every dimension's mapped value with the custom value.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t d = 0; d < dimensions.size(); ++d)
+      {
+        const T value = columnMajor ? input(dimensions[d], i)
+                                    : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+        {
+          if (columnMajor)
+            input(dimensions[d], i) = customValue;
+          else
+            input(i, dimensions[d]) = customValue;
+        }
+      }
+    }
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
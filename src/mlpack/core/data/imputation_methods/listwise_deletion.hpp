@@ -66,6 +66,56 @@ class ListwiseDeletion
       input = input.rows(arma::uvec(colsToKeep));
     }
   }
+
+  /**
+   * Remove every point that has a mapped value in any of the given
+   * dimensions, with a single parallel pass to find the points to drop and a
+   * single shed, instead of one scan and one copy per dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to remove, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to check.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    // char, not bool: the flags are written concurrently and
+    // std::vector<bool> packs its elements into shared words.
+    std::vector<char> keep(numPoints, 1);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t d = 0; d < dimensions.size(); ++d)
+      {
+        const T value = columnMajor ? input(dimensions[d], i)
+                                    : input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+        {
+          keep[i] = 0;
+          break;
+        }
+      }
+    }
+
+    std::vector<arma::uword> toKeep;
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      if (keep[i])
+        toKeep.push_back(i);
+    }
+
+    if (columnMajor)
+      input = input.cols(arma::uvec(toKeep));
+    else
+      input = input.rows(arma::uvec(toKeep));
+  }
 }; // class ListwiseDeletion
 
 } // namespace data
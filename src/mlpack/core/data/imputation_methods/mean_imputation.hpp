@@ -96,6 +96,92 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute all of the given dimensions at once, in two passes over the
+   * matrix: one parallel pass gathers every dimension's sum, element count
+   * and missing-value positions, and one parallel scatter pass writes the
+   * means back.  Use this overload when many dimensions must be imputed; the
+   * single-dimension overload makes a full scan of the matrix per dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    arma::vec sums(numDims, arma::fill::zeros);
+    arma::Col<size_t> counts(numDims, arma::fill::zeros);
+
+    using PairType = std::pair<size_t, size_t>;
+    // Missing positions, as (index into dimensions, point index) pairs.
+    std::vector<PairType> targets;
+
+    // Collection pass: every dimension's statistics and missing positions in
+    // one parallel sweep over the points.
+    #pragma omp parallel
+    {
+      arma::vec threadSums(numDims, arma::fill::zeros);
+      arma::Col<size_t> threadCounts(numDims, arma::fill::zeros);
+      std::vector<PairType> threadTargets;
+
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+      {
+        for (size_t d = 0; d < numDims; ++d)
+        {
+          const T value = columnMajor ? input(dimensions[d], i)
+                                      : input(i, dimensions[d]);
+          if (value == mappedValues[d] || std::isnan(value))
+          {
+            threadTargets.emplace_back(d, i);
+          }
+          else
+          {
+            threadCounts[d]++;
+            threadSums[d] += value;
+          }
+        }
+      }
+
+      #pragma omp critical (MeanImputationMerge)
+      {
+        sums += threadSums;
+        counts += threadCounts;
+        targets.insert(targets.end(), threadTargets.begin(),
+            threadTargets.end());
+      }
+    }
+
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      if (counts[d] == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << dimensions[d] << std::endl;
+    }
+
+    // Scatter pass: every target position is distinct, so the writes can
+    // proceed in parallel.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t t = 0; t < (omp_size_t) targets.size(); ++t)
+    {
+      const size_t d = targets[t].first;
+      const size_t i = targets[t].second;
+      const double mean = sums[d] / counts[d];
+      if (columnMajor)
+        input(dimensions[d], i) = mean;
+      else
+        input(i, dimensions[d]) = mean;
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
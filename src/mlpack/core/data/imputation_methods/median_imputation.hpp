@@ -85,6 +85,82 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute all of the given dimensions at once: one parallel pass gathers
+   * every dimension's kept values and missing-value positions, the medians
+   * are computed per dimension in parallel, and one scatter pass writes them
+   * back.  Use this overload when many dimensions must be imputed; the
+   * single-dimension overload makes a full scan of the matrix per dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to replace, one per entry of dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    using PairType = std::pair<size_t, size_t>;
+    // Missing positions, as (index into dimensions, point index) pairs.
+    std::vector<PairType> targets;
+    // Kept values per dimension; the order does not matter for the median.
+    std::vector<std::vector<double>> elemsToKeep(numDims);
+
+    #pragma omp parallel
+    {
+      std::vector<PairType> threadTargets;
+      std::vector<std::vector<double>> threadKeep(numDims);
+
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+      {
+        for (size_t d = 0; d < numDims; ++d)
+        {
+          const T value = columnMajor ? input(dimensions[d], i)
+                                      : input(i, dimensions[d]);
+          if (value == mappedValues[d] || std::isnan(value))
+            threadTargets.emplace_back(d, i);
+          else
+            threadKeep[d].push_back(value);
+        }
+      }
+
+      #pragma omp critical (MedianImputationMerge)
+      {
+        targets.insert(targets.end(), threadTargets.begin(),
+            threadTargets.end());
+        for (size_t d = 0; d < numDims; ++d)
+        {
+          elemsToKeep[d].insert(elemsToKeep[d].end(), threadKeep[d].begin(),
+              threadKeep[d].end());
+        }
+      }
+    }
+
+    // The per-dimension medians are independent.
+    arma::vec medians(numDims);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t d = 0; d < (omp_size_t) numDims; ++d)
+      medians[d] = arma::median(arma::vec(elemsToKeep[d]));
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t t = 0; t < (omp_size_t) targets.size(); ++t)
+    {
+      const size_t d = targets[t].first;
+      const size_t i = targets[t].second;
+      if (columnMajor)
+        input(dimensions[d], i) = medians[d];
+      else
+        input(i, dimensions[d]) = medians[d];
+    }
+  }
 }; // class MedianImputation
 
 } // namespace data
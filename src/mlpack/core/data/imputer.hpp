@@ -65,6 +65,32 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Impute missing values of many dimensions at once.  The missing value is
+  * unmapped per dimension (the DatasetMapper may have mapped it to a
+  * different value in each), and the whole batch is handed to the strategy,
+  * which collects every dimension's statistics and missing positions in one
+  * parallel pass over the matrix and applies them in a second — instead of a
+  * full matrix scan per dimension.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      mappedValues[d] =
+          static_cast<T>(mapper.UnmapValue(missingValue, dimensions[d]));
+    }
+
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
   //! Get the strategy
   const StrategyType& Strategy() const { return strategy; }
 
@@ -0,0 +1,98 @@
+/**
+ * @file label_mapper.hpp
+ *
+ * Defines the LabelMapper class, a reusable hash-based mapping from arbitrary
+ * labels to contiguous unsigned labels in the range [0, n).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LABEL_MAPPER_HPP
+#define MLPACK_CORE_DATA_LABEL_MAPPER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <unordered_map>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A reusable mapping from arbitrary labels to contiguous unsigned labels in
+ * the range [0, n), built with a hash table in a single pass over the input.
+ * Unlike the free function NormalizeLabels(), which rebuilds its mapping from
+ * scratch on every call, a LabelMapper keeps its mapping between calls, so
+ * successive label vectors (training, validation and test splits, or daily
+ * increments of a dataset) can be normalized consistently without recomputing
+ * anything; labels not seen before are appended to the mapping in order of
+ * first appearance.
+ *
+ * This matters for extreme-classification datasets: with hundreds of
+ * thousands of classes, the linear-scan mapping construction is quadratic in
+ * the number of classes, while this class stays linear in the number of
+ * points.
+ *
+ * @tparam eT Type of the labels to map from.
+ */
+template<typename eT>
+class LabelMapper
+{
+ public:
+  /**
+   * Map the given labels to unsigned labels in the range [0, n), extending
+   * the stored mapping with any labels that have not been seen before.  New
+   * labels are added in a serial insertion pass; the output labels are then
+   * filled in a parallel read-only pass over the hash table.
+   *
+   * @param labelsIn Input labels of arbitrary datatype.
+   * @param labels Vector that unsigned labels will be stored in.
+   */
+  template<typename RowType>
+  void Normalize(const RowType& labelsIn, arma::Row<size_t>& labels);
+
+  /**
+   * Map a set of normalized labels back to the original labels.
+   *
+   * @param labels Set of normalized labels to convert.
+   * @param labelsOut Vector to store the original labels in.
+   */
+  void Revert(const arma::Row<size_t>& labels, arma::Row<eT>& labelsOut) const;
+
+  //! Get the reverse mapping (the original label for each unsigned label).
+  arma::Col<eT> Mapping() const { return arma::Col<eT>(mapping); }
+
+  //! Get the number of distinct labels seen so far.
+  size_t NumClasses() const { return mapping.size(); }
+
+  //! Serialize the mapper.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(mapping);
+
+    // The hash table is rebuilt from the reverse mapping on load.
+    if (Archive::is_loading::value)
+    {
+      labelMap.clear();
+      labelMap.reserve(mapping.size());
+      for (size_t i = 0; i < mapping.size(); ++i)
+        labelMap.emplace(mapping[i], i);
+    }
+  }
+
+ private:
+  //! The mapping from original labels to unsigned labels.
+  std::unordered_map<eT, size_t> labelMap;
+
+  //! The original label for each unsigned label.
+  std::vector<eT> mapping;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "label_mapper_impl.hpp"
+
+#endif
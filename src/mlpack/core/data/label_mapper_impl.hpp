@@ -0,0 +1,58 @@
+/**
+ * @file label_mapper_impl.hpp
+ *
+ * Implementation of the LabelMapper class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LABEL_MAPPER_IMPL_HPP
+#define MLPACK_CORE_DATA_LABEL_MAPPER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "label_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+template<typename RowType>
+void LabelMapper<eT>::Normalize(const RowType& labelsIn,
+                                arma::Row<size_t>& labels)
+{
+  labels.set_size(labelsIn.n_elem);
+
+  // First an insertion-only pass: labels that have not been seen before get
+  // the next contiguous value, in order of first appearance.  This pass has
+  // to be serial for the numbering to be deterministic.
+  for (size_t i = 0; i < labelsIn.n_elem; ++i)
+  {
+    if (labelMap.emplace(labelsIn[i], mapping.size()).second)
+      mapping.push_back(labelsIn[i]);
+  }
+
+  // Now the hash table is read-only, so the output labels can be filled in
+  // parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) labelsIn.n_elem; ++i)
+    labels[i] = labelMap.find(labelsIn[i])->second;
+}
+
+template<typename eT>
+void LabelMapper<eT>::Revert(const arma::Row<size_t>& labels,
+                             arma::Row<eT>& labelsOut) const
+{
+  // We already have the mapping, so we just need to loop over each element.
+  labelsOut.set_size(labels.n_elem);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) labels.n_elem; ++i)
+    labelsOut[i] = mapping[labels[i]];
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -294,5 +294,13 @@ bool Load(const std::string& filename,
 #include "load_model_impl.hpp"
 // Include implementation of Load() for vectors.
 #include "load_vec_impl.hpp"
+// Include the memory-mapping Load() overload.
+#include "mmap_load.hpp"
+// Include the columnar format reader and writer.
+#include "columnar.hpp"
+// Include the frame-compressed binary format reader and writer.
+#include "compressed_binary.hpp"
+// Include the range-based HDF5 Load() overload.
+#include "load_hdf5.hpp"
 
 #endif
@@ -30,7 +30,8 @@ void LoadARFF(const std::string& filename, arma::Mat<eT>& matrix);
 /**
  * A utility function to load an ARFF dataset as numeric and categorical
  * features, using the DatasetInfo structure for mapping.  An exception will be
- * thrown upon failure.
+ * thrown upon failure.  Both dense (CSV) and sparse ("{index value, ...}")
+ * data rows are supported; in a sparse row, every value not listed is zero.
  *
  * A pre-existing DatasetInfo object can be passed in, but if the dimensionality
  * of the given DatasetInfo object (info.Dimensionality()) does not match the
@@ -18,9 +18,132 @@
 #include <boost/algorithm/string/trim.hpp>
 #include "is_naninf.hpp"
 
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
 namespace mlpack {
 namespace data {
 
+/**
+ * Scan the next comma-separated token of an ARFF data line.  This handles
+ * double quoting, backslash escapes, and inline '%' comments (which terminate
+ * the line).  The token is returned as the range [tokBegin, tokEnd), with
+ * whitespace stripped from either side; if the token contained escape
+ * sequences, they are resolved into the scratch buffer and the returned range
+ * points there instead.  pos is advanced past the token and its trailing
+ * delimiter.  Returns false when the line is exhausted.
+ */
+inline bool ExtractARFFToken(const char*& pos,
+                             const char* const end,
+                             const char*& tokBegin,
+                             const char*& tokEnd,
+                             std::string& scratch)
+{
+  // Skip leading whitespace.
+  while (pos < end && isspace((unsigned char) *pos))
+    ++pos;
+
+  if (pos >= end || *pos == '%')
+  {
+    pos = end;
+    return false;
+  }
+
+  bool escaped = false;
+  if (*pos == '"')
+  {
+    // Quoted token: it runs to the matching quote, and a backslash escapes
+    // the character after it.
+    ++pos;
+    tokBegin = pos;
+    while (pos < end && *pos != '"')
+    {
+      if (*pos == '\\' && pos + 1 < end)
+      {
+        escaped = true;
+        ++pos;
+      }
+      ++pos;
+    }
+    tokEnd = pos;
+    if (pos < end)
+      ++pos; // Skip the closing quote.
+
+    // Move past the trailing delimiter, if there is one.
+    while (pos < end && *pos != ',' && *pos != '%')
+      ++pos;
+    if (pos < end && *pos == ',')
+      ++pos;
+    else
+      pos = end;
+  }
+  else
+  {
+    // Unquoted token: it runs to the next unescaped comma or comment marker.
+    tokBegin = pos;
+    while (pos < end && *pos != ',' && *pos != '%')
+    {
+      if (*pos == '\\' && pos + 1 < end)
+      {
+        escaped = true;
+        ++pos;
+      }
+      ++pos;
+    }
+    tokEnd = pos;
+    if (pos < end && *pos == ',')
+      ++pos;
+    else
+      pos = end;
+  }
+
+  if (escaped)
+  {
+    // Resolve the backslash escapes into the scratch buffer.
+    scratch.clear();
+    for (const char* c = tokBegin; c != tokEnd; ++c)
+    {
+      if (*c == '\\' && c + 1 != tokEnd)
+        ++c;
+      scratch += *c;
+    }
+    tokBegin = scratch.data();
+    tokEnd = scratch.data() + scratch.size();
+  }
+
+  // Strip whitespace from either side of the token.
+  while (tokBegin < tokEnd && isspace((unsigned char) *tokBegin))
+    ++tokBegin;
+  while (tokEnd > tokBegin && isspace((unsigned char) *(tokEnd - 1)))
+    --tokEnd;
+
+  return true;
+}
+
+/**
+ * Parse a single numeric ARFF value (including the nan/inf spellings),
+ * returning true on success.  The range must be followed by at least one more
+ * readable byte (here, always the case: tokens point into a NUL-terminated
+ * buffer).
+ */
+template<typename eT>
+inline bool ExtractARFFNumber(const char* begin, const char* end, eT& val)
+{
+  if (begin == end)
+    return false;
+
+  char* numEnd;
+  const double parsed = std::strtod(begin, &numEnd);
+  if (numEnd != end)
+    return false;
+
+  val = (eT) parsed;
+  return true;
+}
+
 template<typename eT, typename PolicyType>
 void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
@@ -131,104 +254,228 @@ void LoadARFF(const std::string& filename,
       info.Type(i) = Datatype::numeric;
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
-  while (ifs.good())
+  // Read the rest of the file---the @data section---into memory in one shot.
+  // Streaming getline() calls and a stringstream per token dominate load time
+  // on multi-gigabyte exports; a single buffered read and a hand-rolled
+  // tokenizer over it are far cheaper.
+  const std::streampos dataPos = ifs.tellg();
+  ifs.seekg(0, std::ios::end);
+  std::string buffer((size_t) (ifs.tellg() - dataPos), '\0');
+  ifs.seekg(dataPos);
+  if (!buffer.empty())
   {
-    std::getline(ifs, line, '\n');
-    ++row;
+    ifs.read(&buffer[0], buffer.size());
+    buffer.resize((size_t) ifs.gcount());
   }
-  // Uncount the EOF row.
-  --row;
 
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+  // Index the extent of every data line up front, so that the parse below can
+  // run in parallel over disjoint blocks of lines.  Empty lines and comment
+  // lines hold no data and are skipped.
+  std::vector<std::pair<const char*, const char*>> lines;
+  std::vector<size_t> lineNumbers; // File lines, for error messages.
+  const char* cur = buffer.data();
+  const char* const bufferEnd = buffer.data() + buffer.size();
+  size_t fileLine = headerLines;
+  while (cur < bufferEnd)
+  {
+    const char* lineEnd = (const char*) memchr(cur, '\n', bufferEnd - cur);
+    if (lineEnd == NULL)
+      lineEnd = bufferEnd;
+
+    // Strip whitespace from either side of the line.
+    const char* begin = cur;
+    const char* end = lineEnd;
+    while (begin < end && isspace((unsigned char) *begin))
+      ++begin;
+    while (end > begin && isspace((unsigned char) *(end - 1)))
+      --end;
+
+    if (begin < end && *begin != '%')
+    {
+      lines.push_back(std::make_pair(begin, end));
+      lineNumbers.push_back(fileLine);
+    }
+
+    ++fileLine;
+    cur = lineEnd + 1;
+  }
 
   // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
+  matrix.set_size(dimensionality, lines.size());
 
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  // Each line of the @data section must be a CSV, or a sparse row of the form
+  // "{index value, index value, ...}" where every index not listed is zero.
+  // The '?' representing a missing value is not allowed, so if that occurs we
+  // report an error.  We also report an error if any piece of data does not
+  // match its type (categorical or numeric).  Each line is one column of the
+  // transposed output, so the threads of the team below parse disjoint blocks
+  // of lines and write to disjoint columns of the matrix.  We keep only the
+  // earliest error and throw it after the parallel region, since we cannot
+  // throw across an OpenMP boundary.
+  size_t badLine = std::numeric_limits<size_t>::max();
+  std::string badLineError;
+
+  #pragma omp parallel
   {
-    std::getline(ifs, line, '\n');
-    boost::trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
-    boost::escaped_list_separator<char> sep("\\", ",", "\"");
-    Tokenizer tok(line, sep);
-
-    size_t col = 0;
-    std::stringstream token;
-    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+    // Per-thread cache of categorical tokens this thread has already mapped,
+    // one map per dimension (the same token may map differently in different
+    // dimensions).  Only a cache miss has to serialize on the shared
+    // DatasetMapper; after warmup, categorical tokens are interned with a
+    // single local hash lookup and no synchronization at all.
+    std::vector<std::unordered_map<std::string, eT>> interned(dimensionality);
+
+    #pragma omp for schedule(dynamic, 1024)
+    for (omp_size_t row = 0; row < (omp_size_t) lines.size(); ++row)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
+      const char* pos = lines[row].first;
+      const char* end = lines[row].second;
+
+      // Report a parse error on this line, keeping only the earliest one.
+      auto fail = [&](const std::string& msg)
       {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
+        #pragma omp critical (LoadARFFBadLine)
+        if (lineNumbers[row] < badLine)
+        {
+          badLine = lineNumbers[row];
+          badLineError = msg;
+        }
+      };
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
+      // Map a categorical token through the per-thread intern cache.
+      auto mapCategorical = [&](const char* tokBegin,
+                                const char* tokEnd,
+                                const size_t col) -> eT
       {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        boost::trim(token);
-        // We load transposed.
-        matrix(col, row) = info.template MapString<eT>(token, col);
-      }
-      else if (info.Type(col) == Datatype::numeric)
+        std::string token(tokBegin, tokEnd);
+        typename std::unordered_map<std::string, eT>::const_iterator it =
+            interned[col].find(token);
+        if (it != interned[col].end())
+          return it->second;
+
+        // The DatasetMapper mutates shared mapping state, so serialize these
+        // calls.
+        eT val;
+        #pragma omp critical (LoadARFFMapString)
+        val = info.template MapString<eT>(token, col);
+        interned[col].emplace(std::move(token), val);
+        return val;
+      };
+
+      // Parse a value token into matrix(col, row), reporting an error on
+      // failure.
+      const char* tokBegin;
+      const char* tokEnd;
+      std::string scratch;
+      auto setValue = [&](const size_t col) -> bool
       {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
+        if (info.Type(col) == Datatype::categorical)
+        {
+          matrix(col, row) = mapCategorical(tokBegin, tokEnd, col);
+          return true;
+        }
 
+        // Attempt to read as numeric.
         eT val = eT(0);
-        token >> val;
+        if (!ExtractARFFNumber(tokBegin, tokEnd, val))
+        {
+          // If it's '?', we issue a specific error, otherwise we issue a
+          // general error.
+          std::ostringstream error;
+          const std::string token(tokBegin, tokEnd);
+          if (token == "?")
+            error << "Missing values ('?') not supported, ";
+          else
+            error << "Parse error ";
+          error << "at line " << lineNumbers[row] << " token " << col
+              << ": \"" << token << "\".";
+          fail(error.str());
+          return false;
+        }
+
+        matrix(col, row) = val; // We load transposed.
+        return true;
+      };
+
+      if (*pos == '{')
+      {
+        // Sparse row.  Every value not listed is zero---note that for
+        // categorical dimensions this is the raw value 0, not a mapping.
+        matrix.col(row).zeros();
+        ++pos;
+
+        // Drop the closing brace and anything after it.
+        const char* close = (const char*) memchr(pos, '}', end - pos);
+        if (close == NULL)
+        {
+          std::ostringstream error;
+          error << "Sparse data with no closing '}' in line "
+              << lineNumbers[row] << ".";
+          fail(error.str());
+          continue;
+        }
+        end = close;
 
-        if (token.fail())
+        while (true)
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          // Skip whitespace before the index.
+          while (pos < end && isspace((unsigned char) *pos))
+            ++pos;
+          if (pos >= end)
+            break;
+
+          // Parse the index of this value.
+          char* idxEnd;
+          const unsigned long idx = std::strtoul(pos, &idxEnd, 10);
+          if (idxEnd == pos || idx >= dimensionality)
           {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            boost::trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            std::ostringstream error;
+            error << "Invalid sparse index in line " << lineNumbers[row]
+                << ".";
+            fail(error.str());
+            break;
           }
-        }
+          pos = idxEnd;
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
+          // The value runs to the next comma (or the closing brace).
+          if (!ExtractARFFToken(pos, end, tokBegin, tokEnd, scratch))
+          {
+            std::ostringstream error;
+            error << "Sparse index with no value in line " << lineNumbers[row]
+                << ".";
+            fail(error.str());
+            break;
+          }
+
+          if (!setValue(idx))
+            break;
+        }
       }
+      else
+      {
+        // Dense row: a plain CSV line.
+        size_t col = 0;
+        while (ExtractARFFToken(pos, end, tokBegin, tokEnd, scratch))
+        {
+          // Check that we are not too many columns in.
+          if (col >= matrix.n_rows)
+          {
+            std::ostringstream error;
+            error << "Too many columns in line " << lineNumbers[row] << ".";
+            fail(error.str());
+            break;
+          }
+
+          if (!setValue(col))
+            break;
 
-      ++col;
+          ++col;
+        }
+      }
     }
-    ++row;
   }
+
+  if (badLine != std::numeric_limits<size_t>::max())
+    throw std::runtime_error(badLineError);
 }
 
 } // namespace data
@@ -18,8 +18,13 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/util/log.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "extension.hpp"
 #include "format.hpp"
@@ -58,6 +63,17 @@ class LoadCSV
   {
     CheckOpen();
 
+    // For large files the chunked parser splits the work across an OpenMP
+    // team; each line is an independent column of the transposed output, so
+    // threads write to disjoint parts of the matrix.
+#ifdef HAS_OPENMP
+    if (transpose && omp_get_max_threads() > 1)
+    {
+      TransposeParseParallel(inout, infoSet);
+      return;
+    }
+#endif
+
     if (transpose)
       TransposeParse(inout, infoSet);
     else
@@ -357,6 +373,161 @@ class LoadCSV
     }
   }
 
+#ifdef HAS_OPENMP
+  /**
+   * Parse a transposed matrix with an OpenMP team.  The file is read once and
+   * split into lines; each line becomes one column of the output, so the
+   * threads of the team parse disjoint blocks of lines and write to disjoint
+   * columns of the matrix with no synchronization.  Tokens in dimensions the
+   * policy's first pass has proven numeric are converted in place; all other
+   * tokens are collected and passed to the DatasetMapper serially, in file
+   * order, after the parallel region, so mappings and category ids come out
+   * identical to the serial parser's.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper to load with.
+   */
+  template<typename T, typename PolicyType>
+  void TransposeParseParallel(arma::Mat<T>& inout,
+                              DatasetMapper<PolicyType>& infoSet)
+  {
+    // Get matrix size.  This also initializes infoSet correctly.
+    size_t rows, cols;
+    GetTransposeMatrixSize<T>(rows, cols, infoSet);
+
+    // Set the matrix size.
+    inout.set_size(rows, cols);
+
+    // Read the whole file once, recording each line; parsing (not I/O) is the
+    // bottleneck we are parallelizing.
+    std::vector<std::string> lines;
+    lines.reserve(cols);
+    std::string line;
+    inFile.clear();
+    inFile.seekg(0, std::ios::beg);
+    while (std::getline(inFile, line))
+    {
+      boost::trim(line);
+      lines.push_back(std::move(line));
+    }
+
+    // The delimiter is a single character for all formats we accept here.
+    const char delim = (extension == "csv") ? ',' : '\t';
+
+    // The numeric fast path is only valid for dimensions where MapString()
+    // is guaranteed to return the parsed value.  Policies with a first pass
+    // have fixed the type of every dimension already, and only map in
+    // non-numeric dimensions; policies without one (like MissingPolicy,
+    // which maps numeric-looking missing sentinels to NaN) may map any
+    // token, so they get no fast path at all.  With forceAllMappings the
+    // first pass marks every dimension categorical, so no fast path is
+    // taken there either.
+    std::vector<bool> numericDimension(rows, false);
+    if (PolicyType::NeedsFirstPass)
+      for (size_t row = 0; row < rows; ++row)
+        numericDimension[row] = (infoSet.Type(row) == Datatype::numeric);
+
+    // Tokens that need the DatasetMapper, as (column, row, token) triplets.
+    // They are mapped after the parallel region, sorted into file order, so
+    // new mappings get their ids in the same order as the serial parser
+    // would assign them.
+    std::vector<std::tuple<size_t, size_t, std::string>> mappedTokens;
+
+    // Collect any per-column dimension count error and report it after the
+    // parallel region (we cannot throw across an OpenMP boundary).
+    size_t badCol = std::numeric_limits<size_t>::max();
+    size_t badColDims = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (omp_size_t col = 0; col < (omp_size_t) lines.size(); ++col)
+    {
+      const std::string& curLine = lines[col];
+      size_t row = 0;
+      size_t pos = 0;
+
+      while (pos <= curLine.size() && row < rows)
+      {
+        // Extract the next token.
+        size_t next = curLine.find(delim, pos);
+        if (next == std::string::npos)
+          next = curLine.size();
+
+        std::string str = curLine.substr(pos, next - pos);
+        boost::trim(str);
+
+        // Numeric fast path, for dimensions where mapping can never happen.
+        T val;
+        if (numericDimension[row] && ExtractNumber(str, val))
+        {
+          inout(row, col) = val;
+        }
+        else
+        {
+          // This token must go through the DatasetMapper; collect it for the
+          // serial mapping pass below.
+          #pragma omp critical (LoadCSVMapString)
+          mappedTokens.emplace_back((size_t) col, row, std::move(str));
+        }
+
+        ++row;
+        pos = next + 1;
+      }
+
+      // Make sure we got the right number of rows.  Leftover characters after
+      // the last expected token also mean the dimension count is wrong.
+      if (row != rows || pos <= curLine.size())
+      {
+        #pragma omp critical (LoadCSVBadLine)
+        if ((size_t) col < badCol)
+        {
+          badCol = (size_t) col;
+          badColDims = row;
+        }
+      }
+    }
+
+    if (badCol != std::numeric_limits<size_t>::max())
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::TransposeParseParallel(): wrong number of dimensions ("
+          << badColDims << ") on line " << badCol << "; should be " << rows
+          << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+
+    // Map the collected tokens in file order (line first, then position in
+    // the line), so that any new mappings are created exactly as the serial
+    // parser would create them.
+    std::sort(mappedTokens.begin(), mappedTokens.end());
+    for (size_t i = 0; i < mappedTokens.size(); ++i)
+    {
+      const size_t tokenCol = std::get<0>(mappedTokens[i]);
+      const size_t tokenRow = std::get<1>(mappedTokens[i]);
+      inout(tokenRow, tokenCol) = infoSet.template MapString<T>(
+          std::move(std::get<2>(mappedTokens[i])), tokenRow);
+    }
+  }
+
+  /**
+   * Parse a single numeric token, returning true on success.  Only used for
+   * dimensions the mapping policy has already proven numeric.
+   */
+  template<typename T>
+  static bool ExtractNumber(const std::string& str, T& val)
+  {
+    if (str.empty())
+      return false;
+
+    char* end;
+    const double parsed = std::strtod(str.c_str(), &end);
+    if (end != str.c_str() + str.size())
+      return false;
+
+    val = (T) parsed;
+    return true;
+  }
+#endif
+
   //! Spirit rule for parsing.
   boost::spirit::qi::rule<std::string::iterator, iter_type()> stringRule;
   //! Spirit rule for delimiters (i.e. ',' for CSVs).
@@ -0,0 +1,59 @@
+/**
+ * @file load_hdf5.hpp
+ * @author Ryan Curtin
+ *
+ * Range-based loading of HDF5 datasets.  Unlike the all-or-nothing loader
+ * that Armadillo provides, this overload of Load() maps a row/column range
+ * onto an HDF5 hyperslab selection, so a sub-block of a large chunked dataset
+ * can be read without ever materializing the rest of the file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_HDF5_HPP
+#define MLPACK_CORE_DATA_LOAD_HDF5_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load only the given row and column range of an HDF5 dataset.  The ranges
+ * refer to the matrix as this function returns it---so with the default
+ * transpose = true, rowRange selects dimensions and colRange selects points,
+ * exactly as they would be indexed in the result of a full Load().  Passing
+ * arma::span() (or arma::span::all) for a range selects all of it.
+ *
+ * The selection is performed with an HDF5 hyperslab, and the dataset's chunk
+ * cache is sized so that each chunk intersecting the selection is read and
+ * decompressed only once.  Only HDF5 files are supported; any other extension
+ * is an error, and if Armadillo was built without HDF5 support this always
+ * fails.
+ *
+ * @param filename Name of the HDF5 file to load.
+ * @param matrix Matrix to load the selected block into.
+ * @param rowRange Range of rows of the (transposed) result to load.
+ * @param colRange Range of columns of the (transposed) result to load.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix after loading (default).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const arma::span& rowRange,
+          const arma::span& colRange,
+          const bool fatal = false,
+          const bool transpose = true);
+
+} // namespace data
+} // namespace mlpack
+
+#include "load_hdf5_impl.hpp"
+
+#endif
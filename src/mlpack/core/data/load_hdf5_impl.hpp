@@ -0,0 +1,323 @@
+/**
+ * @file load_hdf5_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the range-based HDF5 Load() overload defined in
+ * load_hdf5.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_HDF5_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_HDF5_IMPL_HPP
+
+#include <mlpack/core/util/timers.hpp>
+
+#include "load_hdf5.hpp"
+#include "extension.hpp"
+
+#ifdef ARMA_USE_HDF5
+  #include <hdf5.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+#ifdef ARMA_USE_HDF5
+
+namespace details {
+
+/**
+ * Return the native HDF5 datatype corresponding to eT, or a negative id if
+ * the element type has no HDF5 equivalent.
+ */
+template<typename eT>
+inline hid_t HDF5NativeType()
+{
+  if (std::is_same<eT, float>::value)
+    return H5T_NATIVE_FLOAT;
+  if (std::is_same<eT, double>::value)
+    return H5T_NATIVE_DOUBLE;
+  if (std::is_same<eT, int>::value)
+    return H5T_NATIVE_INT;
+  if (std::is_same<eT, unsigned int>::value)
+    return H5T_NATIVE_UINT;
+  if (std::is_same<eT, long>::value)
+    return H5T_NATIVE_LONG;
+  if (std::is_same<eT, unsigned long>::value)
+    return H5T_NATIVE_ULONG;
+  if (std::is_same<eT, long long>::value)
+    return H5T_NATIVE_LLONG;
+  if (std::is_same<eT, unsigned long long>::value)
+    return H5T_NATIVE_ULLONG;
+  if (std::is_same<eT, short>::value)
+    return H5T_NATIVE_SHORT;
+  if (std::is_same<eT, unsigned short>::value)
+    return H5T_NATIVE_USHORT;
+  if (std::is_same<eT, signed char>::value)
+    return H5T_NATIVE_SCHAR;
+  if (std::is_same<eT, unsigned char>::value)
+    return H5T_NATIVE_UCHAR;
+
+  return -1;
+}
+
+/**
+ * Find the name of the dataset to read from the root group of an HDF5 file.
+ * A dataset named "dataset" (Armadillo's default) is preferred; otherwise the
+ * first dataset in the root group is used.  Returns an empty string if the
+ * file holds no dataset at all.
+ */
+inline std::string FindHDF5Dataset(const hid_t fileId)
+{
+  // Prefer Armadillo's default dataset name.
+  if (H5Lexists(fileId, "dataset", H5P_DEFAULT) > 0)
+    return "dataset";
+
+  hsize_t numObjs = 0;
+  if (H5Gget_num_objs(fileId, &numObjs) < 0)
+    return "";
+
+  for (hsize_t i = 0; i < numObjs; ++i)
+  {
+    if (H5Gget_objtype_by_idx(fileId, i) != H5G_DATASET)
+      continue;
+
+    const ssize_t nameLen = H5Gget_objname_by_idx(fileId, i, NULL, 0);
+    if (nameLen <= 0)
+      continue;
+
+    std::string name((size_t) nameLen, '\0');
+    H5Gget_objname_by_idx(fileId, i, &name[0], (size_t) nameLen + 1);
+    return name;
+  }
+
+  return "";
+}
+
+} // namespace details
+
+#endif // ARMA_USE_HDF5
+
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const arma::span& rowRange,
+          const arma::span& colRange,
+          const bool fatal,
+          const bool transpose)
+{
+  Timer::Start("loading_data");
+
+  const std::string extension = Extension(filename);
+  if (extension != "h5" && extension != "hdf5" && extension != "hdf" &&
+      extension != "he5")
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Range-based loading of '" << filename << "' is only "
+          << "supported for HDF5 data.  Load failed." << std::endl;
+    else
+      Log::Warn << "Range-based loading of '" << filename << "' is only "
+          << "supported for HDF5 data; load failed." << std::endl;
+
+    return false;
+  }
+
+#ifndef ARMA_USE_HDF5
+  Timer::Stop("loading_data");
+  if (fatal)
+    Log::Fatal << "Attempted to load '" << filename << "' as HDF5 data, but "
+        << "Armadillo was compiled without HDF5 support.  Load failed."
+        << std::endl;
+  else
+    Log::Warn << "Attempted to load '" << filename << "' as HDF5 data, but "
+        << "Armadillo was compiled without HDF5 support.  Load failed."
+        << std::endl;
+
+  return false;
+#else
+  // The ranges refer to the transposed result; in file coordinates the roles
+  // of rows and columns are swapped.
+  const arma::span& fileRowRange = transpose ? colRange : rowRange;
+  const arma::span& fileColRange = transpose ? rowRange : colRange;
+
+  const hid_t datatype = details::HDF5NativeType<eT>();
+  if (datatype < 0)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "No HDF5 datatype exists for the requested element type; "
+          << "load of '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "No HDF5 datatype exists for the requested element type; "
+          << "load of '" << filename << "' failed." << std::endl;
+
+    return false;
+  }
+
+  const hid_t fileId = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (fileId < 0)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  const std::string datasetName = details::FindHDF5Dataset(fileId);
+  if (datasetName.empty())
+  {
+    H5Fclose(fileId);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "'" << filename << "' does not contain any dataset."
+          << std::endl;
+    else
+      Log::Warn << "'" << filename << "' does not contain any dataset; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  // Open once with the default access list to discover the extents and chunk
+  // layout of the dataset.
+  hid_t dataset = H5Dopen(fileId, datasetName.c_str(), H5P_DEFAULT);
+  hid_t filespace = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(filespace);
+
+  // Armadillo writes two-dimensional datasets with the column index as the
+  // slowest-varying dimension, so dims[0] holds the number of columns and
+  // dims[1] the number of rows; rank-1 datasets are treated as one column.
+  hsize_t dims[2] = { 1, 1 };
+  if (rank == 1 || rank == 2)
+    H5Sget_simple_extent_dims(filespace, dims, NULL);
+  const size_t fileRows = (rank == 2) ? (size_t) dims[1] : (size_t) dims[0];
+  const size_t fileCols = (rank == 2) ? (size_t) dims[0] : 1;
+
+  const size_t firstRow = fileRowRange.whole ? 0 : fileRowRange.a;
+  const size_t lastRow = fileRowRange.whole ? (fileRows - 1) : fileRowRange.b;
+  const size_t firstCol = fileColRange.whole ? 0 : fileColRange.a;
+  const size_t lastCol = fileColRange.whole ? (fileCols - 1) : fileColRange.b;
+
+  if ((rank != 1 && rank != 2) || fileRows == 0 || fileCols == 0 ||
+      firstRow > lastRow || lastRow >= fileRows ||
+      firstCol > lastCol || lastCol >= fileCols)
+  {
+    H5Sclose(filespace);
+    H5Dclose(dataset);
+    H5Fclose(fileId);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Requested range is invalid for the " << fileRows << " x "
+          << fileCols << " dataset in '" << filename << "'." << std::endl;
+    else
+      Log::Warn << "Requested range is invalid for the " << fileRows << " x "
+          << fileCols << " dataset in '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  const size_t numRows = lastRow - firstRow + 1;
+  const size_t numCols = lastCol - firstCol + 1;
+
+  // If the dataset is chunked, size the chunk cache so that every chunk of a
+  // stripe across the fast (row) dimension stays resident while the selection
+  // walks the slow (column) dimension; each compressed chunk is then read and
+  // decompressed exactly once.
+  const hid_t dcpl = H5Dget_create_plist(dataset);
+  hsize_t chunkDims[2] = { 1, 1 };
+  hid_t dapl = H5P_DEFAULT;
+  bool tuned = false;
+  if (H5Pget_layout(dcpl) == H5D_CHUNKED &&
+      H5Pget_chunk(dcpl, rank, chunkDims) == rank)
+  {
+    const size_t chunkBytes = (size_t) chunkDims[0] *
+        ((rank == 2) ? (size_t) chunkDims[1] : 1) * sizeof(eT);
+    const size_t rowChunkDim = (rank == 2) ? (size_t) chunkDims[1] :
+        (size_t) chunkDims[0];
+    const size_t stripeChunks = (numRows + rowChunkDim - 1) / rowChunkDim + 1;
+    size_t cacheBytes = chunkBytes * stripeChunks;
+    cacheBytes = std::max<size_t>(cacheBytes, 1048576);
+    cacheBytes = std::min<size_t>(cacheBytes, 268435456);
+
+    dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    // Evict fully-read chunks first (w0 = 1.0); 10007 hash slots is the
+    // usual prime well above the number of resident chunks.
+    H5Pset_chunk_cache(dapl, 10007, cacheBytes, 1.0);
+    tuned = true;
+  }
+  H5Pclose(dcpl);
+  H5Sclose(filespace);
+  H5Dclose(dataset);
+
+  // Reopen with the tuned access list and select the hyperslab.
+  dataset = H5Dopen(fileId, datasetName.c_str(), dapl);
+  filespace = H5Dget_space(dataset);
+
+  hsize_t offset[2], count[2];
+  if (rank == 2)
+  {
+    offset[0] = firstCol;
+    offset[1] = firstRow;
+    count[0] = numCols;
+    count[1] = numRows;
+  }
+  else
+  {
+    offset[0] = firstRow;
+    count[0] = numRows;
+  }
+  H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL, count, NULL);
+
+  // The contiguous memory selection matches Armadillo's column-major layout
+  // of the numRows x numCols result exactly, so we read straight into the
+  // matrix.
+  matrix.set_size(numRows, numCols);
+  const hid_t memspace = H5Screate_simple(rank, count, NULL);
+  const herr_t status = H5Dread(dataset, datatype, memspace, filespace,
+      H5P_DEFAULT, matrix.memptr());
+
+  H5Sclose(memspace);
+  H5Sclose(filespace);
+  H5Dclose(dataset);
+  if (tuned)
+    H5Pclose(dapl);
+  H5Fclose(fileId);
+
+  if (status < 0)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Reading the selected range of '" << filename
+          << "' failed." << std::endl;
+    else
+      Log::Warn << "Reading the selected range of '" << filename
+          << "' failed; load failed." << std::endl;
+
+    return false;
+  }
+
+  // Now transpose the matrix, if necessary.
+  if (transpose)
+    matrix = arma::trans(matrix);
+
+  Log::Info << "Loaded a " << matrix.n_rows << " x " << matrix.n_cols
+      << " block of '" << filename << "'." << std::endl;
+
+  Timer::Stop("loading_data");
+  return true;
+#endif // ARMA_USE_HDF5
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
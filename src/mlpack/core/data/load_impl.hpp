@@ -21,6 +21,7 @@
 #include "load_csv.hpp"
 #include "load.hpp"
 #include "extension.hpp"
+#include "compressed_binary.hpp"
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/tokenizer.hpp>
@@ -88,6 +89,17 @@ bool Load(const std::string& filename,
   // Get the extension.
   std::string extension = Extension(filename);
 
+  // The frame-compressed binary format has its own reader.
+  if (extension == "cbin")
+  {
+    Timer::Stop("loading_data");
+    const bool success = LoadCompressedBinary(filename, matrix, fatal);
+    if (success && transpose)
+      inplace_transpose(matrix);
+
+    return success;
+  }
+
   // Catch nonexistent files by opening the stream ourselves.
   std::fstream stream;
 #ifdef  _WIN32 // Always open in binary mode on Windows.
@@ -28,6 +28,8 @@
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include "raw_model_archive.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -65,7 +67,7 @@ bool Load(const std::string& filename,
   // Now load the given format.
   std::ifstream ifs;
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
-  if (f == format::binary)
+  if (f == format::binary || f == format::raw)
     ifs.open(filename, std::ifstream::in | std::ifstream::binary);
   else
     ifs.open(filename, std::ifstream::in);
@@ -85,6 +87,23 @@ bool Load(const std::string& filename,
     return false;
   }
 
+  // Both the compact native format and the boost binary format use the '.bin'
+  // extension, so look at the first bytes of the file to tell them apart; old
+  // boost-binary files keep loading transparently.
+  if (f == format::binary || f == format::raw)
+  {
+    char magic[rawArchiveMagicSize];
+    ifs.read(magic, rawArchiveMagicSize);
+    if ((size_t) ifs.gcount() == rawArchiveMagicSize &&
+        std::memcmp(magic, RawArchiveMagic(), rawArchiveMagicSize) == 0)
+      f = format::raw;
+    else
+      f = format::binary;
+
+    ifs.clear();
+    ifs.seekg(0);
+  }
+
   try
   {
     if (f == format::xml)
@@ -102,6 +121,11 @@ bool Load(const std::string& filename,
       boost::archive::binary_iarchive ar(ifs);
       ar >> boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::raw)
+    {
+      RawIArchive ar(ifs);
+      ar >> boost::serialization::make_nvp(name.c_str(), t);
+    }
 
     return true;
   }
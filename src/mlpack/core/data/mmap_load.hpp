@@ -0,0 +1,94 @@
+/**
+ * @file mmap_load.hpp
+ * @author Ryan Curtin
+ *
+ * Load an Armadillo matrix by memory-mapping the file instead of reading it.
+ * This avoids the heap copy that a regular Load() performs, so very large
+ * binary datasets can be "loaded" in constant time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The policy to use when memory-mapping a dataset with Load().
+ *
+ * With READ_ONLY, the pages of the file are mapped directly into the matrix;
+ * any attempt to modify a matrix element is undefined behavior (usually a
+ * segfault).  With COPY_ON_WRITE, the mapping is private: reads are
+ * zero-copy, and the kernel copies individual pages lazily when (and only
+ * when) they are written.
+ */
+enum struct MmapPolicy
+{
+  READ_ONLY,
+  COPY_ON_WRITE
+};
+
+/**
+ * Load a matrix by memory-mapping a binary file, with no copy of the data.
+ * The file may be either Armadillo binary format (arma_binary; the dimensions
+ * are taken from the header) or a headerless raw column-major binary dump of
+ * element type eT, in which case the number of rows and columns must be given
+ * explicitly.
+ *
+ * The returned matrix is an alias of the mapped pages, so unlike the regular
+ * Load() overloads no transposition is performed: the file must already hold
+ * the data in mlpack's column-major (one column per point) layout.  The
+ * mapping remains valid for the lifetime of the process, or until
+ * UnmapMatrix() is called with the same matrix.
+ *
+ * Aliasing is only possible when the payload starts on an element boundary.
+ * The arma_binary header is variable-length ASCII, so its payload usually
+ * does not; in that case the data is copied into an owned matrix instead
+ * (and UnmapMatrix() will return false).  Headerless raw binary files start
+ * at offset zero and are always aliased.
+ *
+ * This is only available on POSIX systems; on other platforms the call fails
+ * (fatally, if fatal is set).
+ *
+ * @param filename Name of file to map.
+ * @param matrix Matrix to alias the mapped contents of the file.
+ * @param policy Mapping policy (read-only or copy-on-write).
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param rows Number of rows (only for headerless raw binary files).
+ * @param cols Number of columns (only for headerless raw binary files).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const MmapPolicy policy,
+          const bool fatal = false,
+          const size_t rows = 0,
+          const size_t cols = 0);
+
+/**
+ * Release the memory mapping backing a matrix previously loaded with the
+ * MmapPolicy overload of Load().  After this call the matrix must not be
+ * accessed; it is reset to an empty matrix.  Matrices that were not
+ * memory-mapped are left untouched and false is returned.
+ *
+ * @param matrix Matrix whose mapping should be released.
+ * @return true if a mapping was found and released.
+ */
+template<typename eT>
+bool UnmapMatrix(arma::Mat<eT>& matrix);
+
+} // namespace data
+} // namespace mlpack
+
+#include "mmap_load_impl.hpp"
+
+#endif
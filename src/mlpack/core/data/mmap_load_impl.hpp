@@ -0,0 +1,309 @@
+/**
+ * @file mmap_load_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the memory-mapping Load() overload defined in
+ * mmap_load.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+
+#include <mlpack/core/util/timers.hpp>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+
+#include "mmap_load.hpp"
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+#ifndef _WIN32
+
+/**
+ * Bookkeeping for live mappings, so that UnmapMatrix() can find the base
+ * address and length of the mapping that a matrix aliases.  Keyed by the
+ * address of the first matrix element (which may sit past the arma_binary
+ * header inside the mapping).
+ */
+struct MmapRegistry
+{
+  struct Mapping
+  {
+    void* base;
+    size_t length;
+  };
+
+  static MmapRegistry& Instance()
+  {
+    static MmapRegistry instance;
+    return instance;
+  }
+
+  void Register(const void* dataPtr, void* base, const size_t length)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    mappings[dataPtr] = Mapping{ base, length };
+  }
+
+  bool Release(const void* dataPtr)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<const void*, Mapping>::iterator it = mappings.find(dataPtr);
+    if (it == mappings.end())
+      return false;
+
+    munmap(it->second.base, it->second.length);
+    mappings.erase(it);
+    return true;
+  }
+
+  std::map<const void*, Mapping> mappings;
+  std::mutex mutex;
+};
+
+/**
+ * Parse an arma_binary header ("ARMA_MAT_BIN\n<type>\n<rows> <cols>\n") from
+ * the start of a mapped file.  On success, set rows, cols and the byte offset
+ * of the first element and return true.
+ */
+inline bool ParseArmaBinaryHeader(const char* map,
+                                  const size_t length,
+                                  size_t& rows,
+                                  size_t& cols,
+                                  size_t& dataOffset)
+{
+  const std::string ARMA_MAT_BIN = "ARMA_MAT_BIN";
+  if (length < ARMA_MAT_BIN.length() ||
+      std::string(map, ARMA_MAT_BIN.length()) != ARMA_MAT_BIN)
+    return false;
+
+  // The header is three '\n'-terminated lines.
+  size_t pos = 0;
+  size_t newlines = 0;
+  while (pos < length && newlines < 3)
+  {
+    if (map[pos] == '\n')
+      ++newlines;
+    ++pos;
+  }
+
+  if (newlines != 3)
+    return false;
+
+  std::istringstream header(std::string(map, pos));
+  std::string signature, elemType;
+  header >> signature >> elemType >> rows >> cols;
+  if (header.fail())
+    return false;
+
+  dataOffset = pos;
+  return true;
+}
+
+#endif
+
+} // namespace details
+
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const MmapPolicy policy,
+          const bool fatal,
+          const size_t rows,
+          const size_t cols)
+{
+#ifdef _WIN32
+  // We only implement POSIX mmap().
+  (void) filename;
+  (void) matrix;
+  (void) policy;
+  (void) rows;
+  (void) cols;
+  if (fatal)
+    Log::Fatal << "Memory-mapped Load() is not available on this platform."
+        << std::endl;
+  else
+    Log::Warn << "Memory-mapped Load() is not available on this platform; "
+        << "load failed." << std::endl;
+
+  return false;
+#else
+  Timer::Start("loading_data");
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1 || fileStat.st_size == 0)
+  {
+    close(fd);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot stat file '" << filename << "' (or it is empty)."
+          << std::endl;
+    else
+      Log::Warn << "Cannot stat file '" << filename << "' (or it is empty); "
+          << "load failed." << std::endl;
+
+    return false;
+  }
+
+  const size_t length = (size_t) fileStat.st_size;
+  const int flags = (policy == MmapPolicy::READ_ONLY) ? MAP_SHARED
+      : MAP_PRIVATE;
+  const int prot = (policy == MmapPolicy::READ_ONLY) ? PROT_READ
+      : (PROT_READ | PROT_WRITE);
+
+  void* map = mmap(NULL, length, prot, flags, fd, 0);
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "mmap() of '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "mmap() of '" << filename << "' failed; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // Work out the dimensions: either from an arma_binary header, or from the
+  // user-specified rows and cols for a headerless raw binary file.
+  size_t fileRows = rows, fileCols = cols, dataOffset = 0;
+  const bool armaBinary = details::ParseArmaBinaryHeader((const char*) map,
+      length, fileRows, fileCols, dataOffset);
+
+  std::string stringType;
+  if (armaBinary)
+  {
+    stringType = "Armadillo binary formatted data";
+  }
+  else if (rows > 0 && cols > 0)
+  {
+    stringType = "raw binary formatted data";
+  }
+  else
+  {
+    munmap(map, length);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is not Armadillo binary format, and "
+          << "no dimensions were given for a raw binary load." << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is not Armadillo binary format, and "
+          << "no dimensions were given for a raw binary load; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  if (dataOffset + fileRows * fileCols * sizeof(eT) > length)
+  {
+    munmap(map, length);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is too short to hold a " << fileRows
+          << " x " << fileCols << " matrix of the requested element type."
+          << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is too short to hold a " << fileRows
+          << " x " << fileCols << " matrix of the requested element type; "
+          << "load failed." << std::endl;
+
+    return false;
+  }
+
+  // The arma_binary header is variable-length ASCII, so the payload almost
+  // never starts on an element boundary; an alias into it would make every
+  // element access misaligned, which is undefined behavior (and faults on
+  // strict-alignment targets).  Copy the payload into an owned matrix in
+  // that case; the headerless raw case starts at offset zero and keeps
+  // zero-copy adoption.
+  if (dataOffset % alignof(eT) != 0)
+  {
+    Log::Info << "Payload of '" << filename << "' (" << stringType << ") is "
+        << "not aligned for the element type; copying instead of aliasing "
+        << "the mapping.  " << std::flush;
+
+    matrix.set_size(fileRows, fileCols);
+    std::memcpy(matrix.memptr(), (const char*) map + dataOffset,
+        fileRows * fileCols * sizeof(eT));
+    munmap(map, length);
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+
+    Timer::Stop("loading_data");
+    return true;
+  }
+
+  Log::Info << "Mapping '" << filename << "' as " << stringType << ".  "
+      << std::flush;
+
+  // Adopt the mapped pages without copying.  copy_aux_mem = false makes the
+  // matrix an alias; strict = true keeps Armadillo from ever reallocating it.
+  // The advanced constructor is the only way to set those flags, so the output
+  // matrix is rebuilt in place.
+  eT* data = (eT*)((char*) map + dataOffset);
+  matrix.~Mat();
+  new (&matrix) arma::Mat<eT>(data, fileRows, fileCols, false, true);
+
+  details::MmapRegistry::Instance().Register(data, map, length);
+
+  Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols << ".\n";
+
+  Timer::Stop("loading_data");
+  return true;
+#endif
+}
+
+template<typename eT>
+bool UnmapMatrix(arma::Mat<eT>& matrix)
+{
+#ifdef _WIN32
+  (void) matrix;
+  return false;
+#else
+  if (!details::MmapRegistry::Instance().Release(matrix.memptr()))
+    return false;
+
+  // The alias is now dangling; replace it with an empty matrix.
+  matrix.~Mat();
+  new (&matrix) arma::Mat<eT>();
+  return true;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 
 // In case it hasn't been included yet.
 #include "normalize_labels.hpp"
+#include "label_mapper.hpp"
 
 namespace mlpack {
 namespace data {
@@ -34,37 +35,13 @@ void NormalizeLabels(const RowType& labelsIn,
                      arma::Row<size_t>& labels,
                      arma::Col<eT>& mapping)
 {
-  // Loop over the input labels, and develop the mapping.  We'll first naively
-  // resize the mapping to the maximum possible size, and then when we fill it,
-  // we'll resize it back down to its actual size.
-  mapping.set_size(labelsIn.n_elem);
-  labels.set_size(labelsIn.n_elem);
-  size_t curLabel = 0;
-  for (size_t i = 0; i < labelsIn.n_elem; ++i)
-  {
-    bool found = false;
-    for (size_t j = 0; j < curLabel; ++j)
-    {
-      // Is the label already in the list of labels we have seen?
-      if (labelsIn[i] == mapping[j])
-      {
-        labels[i] = j;
-        found = true;
-        break;
-      }
-    }
-
-    // Do we need to add this new label?
-    if (!found)
-    {
-      mapping[curLabel] = labelsIn[i];
-      labels[i] = curLabel;
-      ++curLabel;
-    }
-  }
-
-  // Resize mapping back down to necessary size.
-  mapping.resize(curLabel);
+  // A LabelMapper builds the mapping with a hash table in a single pass; the
+  // old linear scan through the mapping for each point was quadratic in the
+  // number of distinct labels.  (To normalize several label vectors with one
+  // consistent mapping, use LabelMapper directly.)
+  LabelMapper<eT> mapper;
+  mapper.Normalize(labelsIn, labels);
+  mapping = mapper.Mapping();
 }
 
 /**
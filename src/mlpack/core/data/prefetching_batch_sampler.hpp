@@ -0,0 +1,206 @@
+/**
+ * @file prefetching_batch_sampler.hpp
+ *
+ * An epoch iterator over an in-memory dataset that shuffles only an index
+ * array and gathers each mini-batch into a reused staging buffer on a
+ * background thread, for mini-batch training loops.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PREFETCHING_BATCH_SAMPLER_HPP
+#define MLPACK_CORE_DATA_PREFETCHING_BATCH_SAMPLER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <future>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * PrefetchingBatchSampler yields shuffled mini-batches of an in-memory
+ * dataset without ever materializing a shuffled copy of it.  Each epoch only
+ * an index array is shuffled (math::ShuffleData() instead copies the whole
+ * dataset, doubling memory), and each mini-batch is gathered into one of two
+ * small staging buffers by a background thread, so batch b+1 is being
+ * gathered while the caller trains on batch b.
+ *
+ * The sampler holds references to the dataset; the predictors and responses
+ * must outlive it.  A typical training loop looks like:
+ *
+ * @code
+ * data::PrefetchingBatchSampler<> sampler(trainData, trainResponses, 128);
+ * arma::mat batch, batchResponses;
+ * for (size_t epoch = 0; epoch < epochs; ++epoch)
+ * {
+ *   while (sampler.GetNextBatch(batch, batchResponses))
+ *     model.Train(batch, batchResponses, optimizer);
+ *   sampler.Reset(); // Reshuffle and start the next epoch.
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of the predictors matrix.
+ * @tparam ResponsesType Type of the responses (arma::mat, arma::Row<size_t>,
+ *     ...); points are columns of both.
+ */
+template<typename MatType = arma::mat, typename ResponsesType = arma::mat>
+class PrefetchingBatchSampler
+{
+ public:
+  /**
+   * Create the sampler and start gathering the first batch.  Throws
+   * std::invalid_argument if the predictors and responses disagree on the
+   * number of points or if batchSize is zero.
+   *
+   * @param predictors Dataset to sample from, one point per column.
+   * @param responses Responses for each point.
+   * @param batchSize Number of points per yielded batch.
+   * @param shuffle If true (the default), a new random ordering of the
+   *     points is drawn at the start of every epoch.
+   */
+  PrefetchingBatchSampler(const MatType& predictors,
+                          const ResponsesType& responses,
+                          const size_t batchSize,
+                          const bool shuffle = true) :
+      predictors(predictors),
+      responses(responses),
+      batchSize(batchSize),
+      shuffle(shuffle),
+      cursor(0)
+  {
+    if (responses.n_cols != predictors.n_cols)
+    {
+      throw std::invalid_argument("PrefetchingBatchSampler: the predictors "
+          "and responses must have the same number of points!");
+    }
+    if (batchSize == 0)
+    {
+      throw std::invalid_argument("PrefetchingBatchSampler: the batch size "
+          "must be positive!");
+    }
+
+    Reset();
+  }
+
+  //! The sampler holds a pending gather into its buffers; no copies.
+  PrefetchingBatchSampler(const PrefetchingBatchSampler&) = delete;
+  PrefetchingBatchSampler& operator=(const PrefetchingBatchSampler&) = delete;
+
+  ~PrefetchingBatchSampler()
+  {
+    // Make sure no background gather outlives the buffers.
+    if (pending.valid())
+      pending.wait();
+  }
+
+  /**
+   * Get the next mini-batch, blocking only if the prefetched batch is not
+   * ready yet.  The last batch of an epoch may hold fewer than batchSize
+   * points.  Returns false (and leaves the outputs untouched) at the end of
+   * the epoch; call Reset() to start another pass.
+   *
+   * The batch is handed over by swapping with the staging buffer, so no copy
+   * is made; the caller's old matrix becomes the staging buffer for the next
+   * gather.
+   *
+   * @param batch Matrix to fill with the next batch of predictors.
+   * @param batchResponses Object to fill with the corresponding responses.
+   * @return true if a batch was produced.
+   */
+  bool GetNextBatch(MatType& batch, ResponsesType& batchResponses)
+  {
+    if (!pending.valid())
+      return false;
+
+    if (pending.get() == 0)
+      return false;
+
+    batch.swap(stagedPredictors);
+    batchResponses.swap(stagedResponses);
+
+    Prefetch();
+    return true;
+  }
+
+  /**
+   * Start a new epoch: reshuffle the ordering (if shuffling is enabled) and
+   * begin gathering the first batch.
+   */
+  void Reset()
+  {
+    if (pending.valid())
+      pending.wait();
+
+    cursor = 0;
+    if (shuffle)
+    {
+      ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+          predictors.n_cols - 1, predictors.n_cols));
+    }
+    else if (ordering.n_elem != predictors.n_cols)
+    {
+      ordering = arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+          predictors.n_cols);
+    }
+
+    Prefetch();
+  }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Get the total number of points in the dataset.
+  size_t NumPoints() const { return predictors.n_cols; }
+
+ private:
+  /**
+   * Start an asynchronous gather of the next batch into the staging buffers.
+   */
+  void Prefetch()
+  {
+    const size_t points = std::min(batchSize, predictors.n_cols - cursor);
+    const size_t begin = cursor;
+    cursor += points;
+
+    pending = std::async(std::launch::async, [this, begin, points]()
+    {
+      if (points == 0)
+        return (size_t) 0;
+
+      const arma::uvec batchIndices = ordering.subvec(begin,
+          begin + points - 1);
+      stagedPredictors = predictors.cols(batchIndices);
+      stagedResponses = responses.cols(batchIndices);
+
+      return points;
+    });
+  }
+
+  //! The dataset to sample from.
+  const MatType& predictors;
+  //! The responses for each point.
+  const ResponsesType& responses;
+  //! Number of points per batch.
+  size_t batchSize;
+  //! Whether to draw a new ordering every epoch.
+  bool shuffle;
+  //! Number of points dispatched to gathers so far this epoch.
+  size_t cursor;
+  //! The shuffled ordering of the points for this epoch.
+  arma::uvec ordering;
+
+  //! Staging buffers the background thread gathers into; GetNextBatch()
+  //! swaps them with the caller's matrices.
+  MatType stagedPredictors;
+  ResponsesType stagedResponses;
+
+  //! The in-flight gather; yields the number of points staged.
+  std::future<size_t> pending;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
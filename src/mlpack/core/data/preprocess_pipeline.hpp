@@ -0,0 +1,185 @@
+/**
+ * @file preprocess_pipeline.hpp
+ *
+ * A composable in-process preprocessing pipeline.  A chain of per-dimension
+ * transforms (imputation, scaling, binarization) is declared up front and then
+ * executed as a single fused parallel pass over column blocks, instead of one
+ * full-matrix pass (and one load/save round trip) per transform.  The pipeline
+ * can also be applied to a StreamingDataset, so datasets that do not fit in
+ * RAM are read at most twice: once to gather the per-dimension statistics the
+ * declared transforms need, and once to transform and write.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PREPROCESS_PIPELINE_HPP
+#define MLPACK_CORE_DATA_PREPROCESS_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "streaming_dataset.hpp"
+#include "split_data.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * PreprocessPipeline holds an ordered chain of preprocessing steps and applies
+ * all of them in one parallel pass.  Steps are declared with the chaining
+ * methods below and executed by Process():
+ *
+ * @code
+ * data::PreprocessPipeline<> pipeline;
+ * pipeline.ImputeMean().MinMaxScale(0.0, 1.0).Binarize(0.5);
+ * pipeline.Process(dataset); // One fused parallel pass, in place.
+ * @endcode
+ *
+ * Transforms that need per-dimension statistics (means for imputation and
+ * standardization, extrema for min-max scaling) gather them in a single
+ * statistics pass that ignores NaN entries, so imputation can be chained
+ * before scaling without a pass in between.
+ *
+ * @tparam eT Element type of the data to process.
+ */
+template<typename eT = double>
+class PreprocessPipeline
+{
+ public:
+  //! Create an empty pipeline.
+  PreprocessPipeline() { }
+
+  /**
+   * Append a step that replaces NaN entries with the mean of the non-NaN
+   * entries in their dimension.
+   */
+  PreprocessPipeline& ImputeMean();
+
+  /**
+   * Append a step that linearly rescales each dimension to the range
+   * [minValue, maxValue].  Dimensions with no spread are set to minValue.
+   *
+   * @param minValue Lower bound of the output range.
+   * @param maxValue Upper bound of the output range.
+   */
+  PreprocessPipeline& MinMaxScale(const double minValue = 0.0,
+                                  const double maxValue = 1.0);
+
+  /**
+   * Append a step that transforms each dimension to zero mean and unit
+   * variance.  Dimensions with zero variance are only centered.
+   */
+  PreprocessPipeline& StandardScale();
+
+  /**
+   * Append a step that sets values greater than the threshold to 1 and all
+   * other values to 0.
+   *
+   * @param threshold Binarization threshold.
+   */
+  PreprocessPipeline& Binarize(const double threshold = 0.0);
+
+  /**
+   * Apply the declared chain to the given matrix in place: one statistics
+   * pass (if any step needs statistics) and one fused transform pass, both
+   * parallelized over column blocks.
+   *
+   * @param data Matrix to process.
+   */
+  void Process(arma::Mat<eT>& data) const;
+
+  /**
+   * Apply the declared chain and then split the result into a training and a
+   * test set, so the whole impute/scale/binarize/split chain is one call.
+   *
+   * @param data Matrix to process (modified in place before the split).
+   * @param trainData Matrix to store the training points into.
+   * @param testData Matrix to store the test points into.
+   * @param testRatio Fraction of points to place in the test set.
+   */
+  void Process(arma::Mat<eT>& data,
+               arma::Mat<eT>& trainData,
+               arma::Mat<eT>& testData,
+               const double testRatio) const;
+
+  /**
+   * Apply the declared chain to a streaming dataset, writing the transformed
+   * points to the given file in the same headerless raw binary column-major
+   * layout the StreamingDataset reads.  The input is read once to gather
+   * statistics (only if a declared step needs them) and once to transform, so
+   * an arbitrarily long chain costs at most two passes over the data.
+   *
+   * @param input Streaming dataset to read points from.
+   * @param outputFile File to write the transformed points to.
+   */
+  void Process(StreamingDataset<eT>& input,
+               const std::string& outputFile) const;
+
+  //! Get the number of declared steps.
+  size_t NumSteps() const { return steps.size(); }
+
+ private:
+  //! The kinds of steps a pipeline can hold.
+  enum StepType
+  {
+    IMPUTE_MEAN,
+    MIN_MAX_SCALE,
+    STANDARD_SCALE,
+    BINARIZE
+  };
+
+  //! One declared step; a and b hold the step's parameters (the output range
+  //! for MIN_MAX_SCALE, the threshold in a for BINARIZE).
+  struct Step
+  {
+    StepType type;
+    double a;
+    double b;
+  };
+
+  //! Return true if any declared step needs per-dimension statistics.
+  bool NeedsStatistics() const;
+
+  /**
+   * Accumulate per-dimension statistics of a column block into the running
+   * totals, ignoring NaN entries.  Each output has one element per dimension.
+   */
+  void AccumulateStatistics(const arma::Mat<eT>& data,
+                            arma::vec& sums,
+                            arma::vec& squaredSums,
+                            arma::vec& counts,
+                            arma::vec& minima,
+                            arma::vec& maxima) const;
+
+  /**
+   * Turn the accumulated totals into the means, standard deviations, and
+   * extrema the transform pass uses.
+   */
+  void FinalizeStatistics(const arma::vec& sums,
+                          const arma::vec& squaredSums,
+                          const arma::vec& counts,
+                          arma::vec& means,
+                          arma::vec& stdDevs) const;
+
+  /**
+   * Apply the fused chain to a column block in place, parallelized over
+   * columns.
+   */
+  void Transform(arma::Mat<eT>& data,
+                 const arma::vec& means,
+                 const arma::vec& stdDevs,
+                 const arma::vec& minima,
+                 const arma::vec& maxima) const;
+
+  //! The declared chain, in execution order.
+  std::vector<Step> steps;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "preprocess_pipeline_impl.hpp"
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ * @file preprocess_pipeline_impl.hpp
+ *
+ * Implementation of the PreprocessPipeline class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PREPROCESS_PIPELINE_IMPL_HPP
+#define MLPACK_CORE_DATA_PREPROCESS_PIPELINE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "preprocess_pipeline.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+PreprocessPipeline<eT>& PreprocessPipeline<eT>::ImputeMean()
+{
+  steps.push_back({ IMPUTE_MEAN, 0.0, 0.0 });
+  return *this;
+}
+
+template<typename eT>
+PreprocessPipeline<eT>& PreprocessPipeline<eT>::MinMaxScale(
+    const double minValue,
+    const double maxValue)
+{
+  steps.push_back({ MIN_MAX_SCALE, minValue, maxValue });
+  return *this;
+}
+
+template<typename eT>
+PreprocessPipeline<eT>& PreprocessPipeline<eT>::StandardScale()
+{
+  steps.push_back({ STANDARD_SCALE, 0.0, 0.0 });
+  return *this;
+}
+
+template<typename eT>
+PreprocessPipeline<eT>& PreprocessPipeline<eT>::Binarize(
+    const double threshold)
+{
+  steps.push_back({ BINARIZE, threshold, 0.0 });
+  return *this;
+}
+
+template<typename eT>
+bool PreprocessPipeline<eT>::NeedsStatistics() const
+{
+  for (size_t i = 0; i < steps.size(); ++i)
+    if (steps[i].type != BINARIZE)
+      return true;
+  return false;
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::AccumulateStatistics(const arma::Mat<eT>& data,
+                                                  arma::vec& sums,
+                                                  arma::vec& squaredSums,
+                                                  arma::vec& counts,
+                                                  arma::vec& minima,
+                                                  arma::vec& maxima) const
+{
+  const size_t dims = data.n_rows;
+
+  #pragma omp parallel
+  {
+    // Thread-local totals, merged once at the end, so the column loop runs
+    // without synchronization.
+    arma::vec localSums(dims, arma::fill::zeros);
+    arma::vec localSquaredSums(dims, arma::fill::zeros);
+    arma::vec localCounts(dims, arma::fill::zeros);
+    arma::vec localMinima(dims);
+    arma::vec localMaxima(dims);
+    localMinima.fill(DBL_MAX);
+    localMaxima.fill(-DBL_MAX);
+
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      const eT* col = data.colptr(i);
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double value = (double) col[d];
+        if (std::isnan(value))
+          continue;
+
+        localSums[d] += value;
+        localSquaredSums[d] += value * value;
+        localCounts[d] += 1.0;
+        if (value < localMinima[d])
+          localMinima[d] = value;
+        if (value > localMaxima[d])
+          localMaxima[d] = value;
+      }
+    }
+
+    #pragma omp critical (PreprocessPipelineStatistics)
+    {
+      sums += localSums;
+      squaredSums += localSquaredSums;
+      counts += localCounts;
+      minima = arma::min(minima, localMinima);
+      maxima = arma::max(maxima, localMaxima);
+    }
+  }
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::FinalizeStatistics(const arma::vec& sums,
+                                                const arma::vec& squaredSums,
+                                                const arma::vec& counts,
+                                                arma::vec& means,
+                                                arma::vec& stdDevs) const
+{
+  means.set_size(sums.n_elem);
+  stdDevs.set_size(sums.n_elem);
+  for (size_t d = 0; d < sums.n_elem; ++d)
+  {
+    if (counts[d] > 0.0)
+    {
+      means[d] = sums[d] / counts[d];
+      // Population variance; clamp tiny negative rounding residue.
+      const double variance = std::max(0.0,
+          squaredSums[d] / counts[d] - means[d] * means[d]);
+      stdDevs[d] = std::sqrt(variance);
+    }
+    else
+    {
+      means[d] = 0.0;
+      stdDevs[d] = 0.0;
+    }
+  }
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::Transform(arma::Mat<eT>& data,
+                                       const arma::vec& means,
+                                       const arma::vec& stdDevs,
+                                       const arma::vec& minima,
+                                       const arma::vec& maxima) const
+{
+  const size_t dims = data.n_rows;
+
+  // One fused pass: each element is loaded once, pushed through every step in
+  // declaration order, and stored once.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    eT* col = data.colptr(i);
+    for (size_t d = 0; d < dims; ++d)
+    {
+      double value = (double) col[d];
+      for (size_t s = 0; s < steps.size(); ++s)
+      {
+        const Step& step = steps[s];
+        switch (step.type)
+        {
+          case IMPUTE_MEAN:
+            if (std::isnan(value))
+              value = means[d];
+            break;
+          case MIN_MAX_SCALE:
+          {
+            const double range = maxima[d] - minima[d];
+            value = (range > 0.0) ?
+                step.a + (value - minima[d]) * (step.b - step.a) / range :
+                step.a;
+            break;
+          }
+          case STANDARD_SCALE:
+            value -= means[d];
+            if (stdDevs[d] > 0.0)
+              value /= stdDevs[d];
+            break;
+          case BINARIZE:
+            value = (value > step.a) ? 1.0 : 0.0;
+            break;
+        }
+      }
+      col[d] = (eT) value;
+    }
+  }
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::Process(arma::Mat<eT>& data) const
+{
+  if (steps.empty() || data.n_elem == 0)
+    return;
+
+  arma::vec means, stdDevs;
+  arma::vec minima(data.n_rows), maxima(data.n_rows);
+  if (NeedsStatistics())
+  {
+    arma::vec sums(data.n_rows, arma::fill::zeros);
+    arma::vec squaredSums(data.n_rows, arma::fill::zeros);
+    arma::vec counts(data.n_rows, arma::fill::zeros);
+    minima.fill(DBL_MAX);
+    maxima.fill(-DBL_MAX);
+
+    AccumulateStatistics(data, sums, squaredSums, counts, minima, maxima);
+    FinalizeStatistics(sums, squaredSums, counts, means, stdDevs);
+  }
+
+  Transform(data, means, stdDevs, minima, maxima);
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::Process(arma::Mat<eT>& data,
+                                     arma::Mat<eT>& trainData,
+                                     arma::Mat<eT>& testData,
+                                     const double testRatio) const
+{
+  Process(data);
+  Split(data, trainData, testData, testRatio);
+}
+
+template<typename eT>
+void PreprocessPipeline<eT>::Process(StreamingDataset<eT>& input,
+                                     const std::string& outputFile) const
+{
+  const size_t dims = input.Dimensionality();
+
+  // First epoch: gather statistics, if any step needs them.
+  arma::vec means, stdDevs;
+  arma::vec minima(dims), maxima(dims);
+  if (NeedsStatistics())
+  {
+    arma::vec sums(dims, arma::fill::zeros);
+    arma::vec squaredSums(dims, arma::fill::zeros);
+    arma::vec counts(dims, arma::fill::zeros);
+    minima.fill(DBL_MAX);
+    maxima.fill(-DBL_MAX);
+
+    arma::Mat<eT> batch;
+    while (input.GetNextBatch(batch))
+      AccumulateStatistics(batch, sums, squaredSums, counts, minima, maxima);
+
+    FinalizeStatistics(sums, squaredSums, counts, means, stdDevs);
+    input.Reset();
+  }
+
+  // Second epoch: transform each batch and write it out.
+  std::ofstream output(outputFile, std::ios::binary);
+  if (!output.is_open())
+    throw std::runtime_error("PreprocessPipeline: cannot open '" + outputFile +
+        "' for writing!");
+
+  arma::Mat<eT> batch;
+  while (input.GetNextBatch(batch))
+  {
+    Transform(batch, means, stdDevs, minima, maxima);
+    output.write((const char*) batch.memptr(),
+        batch.n_elem * sizeof(eT));
+  }
+  input.Reset();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
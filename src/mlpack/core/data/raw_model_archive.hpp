@@ -0,0 +1,310 @@
+/**
+ * @file raw_model_archive.hpp
+ *
+ * A compact native binary archive for model serialization.  RawOArchive and
+ * RawIArchive implement the boost::serialization archive concept, so every
+ * existing serialize() method works unchanged, but all primitive values are
+ * written as raw bytes and arrays (such as the memory of arma objects, via
+ * make_array()) are written as single length-prefixed blobs with no
+ * per-element streaming.  Boost's internal bookkeeping typedefs are written
+ * as fixed-width integers, so the on-disk format does not depend on the
+ * Boost version the file was written with.
+ *
+ * Files start with the eight magic bytes "MLPKRAW" plus a format version, so
+ * Load() can distinguish this format from a boost binary archive with the
+ * same '.bin' extension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_RAW_MODEL_ARCHIVE_HPP
+#define MLPACK_CORE_DATA_RAW_MODEL_ARCHIVE_HPP
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#include <boost/version.hpp>
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/detail/common_iarchive.hpp>
+#include <boost/archive/detail/common_oarchive.hpp>
+#include <boost/archive/detail/register_archive.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/is_bitwise_serializable.hpp>
+
+namespace mlpack {
+namespace data {
+
+//! The magic bytes at the front of every raw-format model file; the last byte
+//! is the format version.
+inline const char* RawArchiveMagic()
+{
+  static const char magic[8] = { 'M', 'L', 'P', 'K', 'R', 'A', 'W', '\1' };
+  return magic;
+}
+
+//! The length of the raw-format magic header.
+const size_t rawArchiveMagicSize = 8;
+
+/**
+ * Output archive for the raw model format.  See the file comment for the
+ * format description.
+ */
+class RawOArchive :
+    public boost::archive::detail::common_oarchive<RawOArchive>
+{
+ public:
+  RawOArchive(std::ostream& os, unsigned int flags = 0) :
+      boost::archive::detail::common_oarchive<RawOArchive>(flags),
+      os(os)
+  {
+    os.write(RawArchiveMagic(), rawArchiveMagicSize);
+    WriteInteger((uint64_t) boost::archive::BOOST_ARCHIVE_VERSION());
+  }
+
+  //! Write raw bytes.
+  void save_binary(const void* address, std::size_t count)
+  {
+    os.write((const char*) address, count);
+  }
+
+  //! Arrays are written as one blob; this is what makes large arma objects
+  //! cheap.
+#if BOOST_VERSION >= 106100
+  template<typename T>
+  void save_array(const boost::serialization::array_wrapper<T>& a,
+                  unsigned int /* version */)
+#else
+  template<typename T>
+  void save_array(const boost::serialization::array<T>& a,
+                  unsigned int /* version */)
+#endif
+  {
+    save_binary(a.address(), a.count() * sizeof(T));
+  }
+
+  //! Allow the blob path for any bitwise-serializable element type.
+  struct use_array_optimization
+  {
+    template<typename T>
+    struct apply : public boost::serialization::is_bitwise_serializable<T> {};
+  };
+
+  //! Strip name-value pairs; names carry no information in this format.
+#if BOOST_VERSION >= 105900
+  template<typename T>
+  void save_override(const boost::serialization::nvp<T>& t)
+  {
+    save_override(t.const_value());
+  }
+
+  template<typename T>
+  void save_override(const T& t)
+  {
+    boost::archive::detail::common_oarchive<RawOArchive>::save_override(t);
+  }
+#else
+  template<typename T>
+  void save_override(const boost::serialization::nvp<T>& t, int)
+  {
+    save_override(t.const_value(), 0);
+  }
+
+  template<typename T>
+  void save_override(const T& t, int)
+  {
+    boost::archive::detail::common_oarchive<RawOArchive>::save_override(t, 0);
+  }
+#endif
+
+  //! Primitive values are written as raw bytes.
+  template<typename T>
+  void save(const T& t)
+  {
+    os.write((const char*) &t, sizeof(T));
+  }
+
+  //! Strings are length-prefixed.
+  void save(const std::string& s)
+  {
+    WriteInteger((uint64_t) s.size());
+    os.write(s.data(), s.size());
+  }
+
+  // Boost bookkeeping types are written as fixed-width integers so that the
+  // format does not depend on their in-memory representation.
+  void save(const boost::archive::version_type& t)
+  { WriteInteger((uint64_t) t); }
+  void save(const boost::archive::library_version_type& t)
+  { WriteInteger((uint64_t) t); }
+  void save(const boost::archive::object_id_type& t)
+  { WriteInteger((uint64_t) t); }
+  void save(const boost::archive::class_id_type& t)
+  { WriteInteger((uint64_t) (int64_t) (int) t); }
+  void save(const boost::archive::class_id_optional_type& /* t */)
+  { /* Carries no information. */ }
+  void save(const boost::archive::class_name_type& t)
+  { save(std::string((const char*) t)); }
+  void save(const boost::archive::tracking_type& t)
+  { const char v = t ? 1 : 0; os.write(&v, 1); }
+  void save(const boost::serialization::collection_size_type& t)
+  { WriteInteger((uint64_t) t); }
+  void save(const boost::serialization::item_version_type& t)
+  { WriteInteger((uint64_t) t); }
+
+ private:
+  void WriteInteger(const uint64_t value)
+  {
+    os.write((const char*) &value, sizeof(uint64_t));
+  }
+
+  std::ostream& os;
+};
+
+/**
+ * Input archive for the raw model format; the exact mirror of RawOArchive.
+ * The constructor throws a boost::archive::archive_exception if the stream
+ * does not start with the raw-format magic bytes.
+ */
+class RawIArchive :
+    public boost::archive::detail::common_iarchive<RawIArchive>
+{
+ public:
+  RawIArchive(std::istream& is, unsigned int flags = 0) :
+      boost::archive::detail::common_iarchive<RawIArchive>(flags),
+      is(is)
+  {
+    char magic[rawArchiveMagicSize];
+    is.read(magic, rawArchiveMagicSize);
+    if ((size_t) is.gcount() != rawArchiveMagicSize ||
+        std::memcmp(magic, RawArchiveMagic(), rawArchiveMagicSize) != 0)
+    {
+      throw boost::archive::archive_exception(
+          boost::archive::archive_exception::invalid_signature);
+    }
+
+    // Behave like the boost library version the file was written with.
+    this->set_library_version(
+        boost::archive::library_version_type((size_t) ReadInteger()));
+  }
+
+  //! Read raw bytes.
+  void load_binary(void* address, std::size_t count)
+  {
+    is.read((char*) address, count);
+  }
+
+  //! Arrays are read back as one blob.
+#if BOOST_VERSION >= 106100
+  template<typename T>
+  void load_array(boost::serialization::array_wrapper<T>& a,
+                  unsigned int /* version */)
+#else
+  template<typename T>
+  void load_array(boost::serialization::array<T>& a,
+                  unsigned int /* version */)
+#endif
+  {
+    load_binary(a.address(), a.count() * sizeof(T));
+  }
+
+  //! Allow the blob path for any bitwise-serializable element type.
+  struct use_array_optimization
+  {
+    template<typename T>
+    struct apply : public boost::serialization::is_bitwise_serializable<T> {};
+  };
+
+  //! Strip name-value pairs; names carry no information in this format.
+#if BOOST_VERSION >= 105900
+  template<typename T>
+  void load_override(const boost::serialization::nvp<T>& t)
+  {
+    load_override(t.value());
+  }
+
+  template<typename T>
+  void load_override(T& t)
+  {
+    boost::archive::detail::common_iarchive<RawIArchive>::load_override(t);
+  }
+#else
+  template<typename T>
+  void load_override(const boost::serialization::nvp<T>& t, int)
+  {
+    load_override(t.value(), 0);
+  }
+
+  template<typename T>
+  void load_override(T& t, int)
+  {
+    boost::archive::detail::common_iarchive<RawIArchive>::load_override(t, 0);
+  }
+#endif
+
+  //! Primitive values are read as raw bytes.
+  template<typename T>
+  void load(T& t)
+  {
+    is.read((char*) &t, sizeof(T));
+  }
+
+  //! Strings are length-prefixed.
+  void load(std::string& s)
+  {
+    s.resize((size_t) ReadInteger());
+    if (!s.empty())
+      is.read(&s[0], s.size());
+  }
+
+  // Boost bookkeeping types, mirroring RawOArchive::save().
+  void load(boost::archive::version_type& t)
+  { t = boost::archive::version_type((unsigned int) ReadInteger()); }
+  void load(boost::archive::library_version_type& t)
+  { t = boost::archive::library_version_type((size_t) ReadInteger()); }
+  void load(boost::archive::object_id_type& t)
+  { t = boost::archive::object_id_type((size_t) ReadInteger()); }
+  void load(boost::archive::class_id_type& t)
+  { t = boost::archive::class_id_type((int) (int64_t) ReadInteger()); }
+  void load(boost::archive::class_id_optional_type& /* t */)
+  { /* Carries no information. */ }
+  void load(boost::archive::class_name_type& t)
+  {
+    std::string s;
+    load(s);
+    const size_t length =
+        std::min(s.size(), (size_t) BOOST_SERIALIZATION_MAX_KEY_SIZE - 1);
+    std::memcpy((char*) t, s.data(), length);
+    ((char*) t)[length] = '\0';
+  }
+  void load(boost::archive::tracking_type& t)
+  { char v; is.read(&v, 1); t = (v != 0); }
+  void load(boost::serialization::collection_size_type& t)
+  { t = boost::serialization::collection_size_type((size_t) ReadInteger()); }
+  void load(boost::serialization::item_version_type& t)
+  { t = boost::serialization::item_version_type((unsigned int) ReadInteger()); }
+
+ private:
+  uint64_t ReadInteger()
+  {
+    uint64_t value = 0;
+    is.read((char*) &value, sizeof(uint64_t));
+    return value;
+  }
+
+  std::istream& is;
+};
+
+} // namespace data
+} // namespace mlpack
+
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(mlpack::data::RawOArchive)
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(mlpack::data::RawIArchive)
+
+#endif
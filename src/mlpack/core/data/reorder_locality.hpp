@@ -0,0 +1,99 @@
+/**
+ * @file reorder_locality.hpp
+ *
+ * Reorder the columns of a dataset along the space filling curve defined by
+ * the UB-tree address mapping, to improve the cache behavior of downstream
+ * tree builds and traversals.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_REORDER_LOCALITY_HPP
+#define MLPACK_CORE_DATA_REORDER_LOCALITY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/address.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Permute the columns of the given column-major dataset into the order of
+ * their UB-tree addresses (a Z-order style space filling curve; see
+ * src/mlpack/core/tree/address.hpp), so that points that are close in space
+ * end up close in memory. Reordered inputs make tree builds and traversals
+ * more cache-friendly without changing any results, as long as the results
+ * are un-permuted afterwards.
+ *
+ * The mapping is filled so that mapping[newIndex] = oldIndex, which is the
+ * same convention the tree constructors use for their oldFromNew mappings;
+ * point indices computed against the reordered dataset can therefore be
+ * translated back with the same machinery (e.g. neighbor::Unmap()).
+ *
+ * @param data Column-major dataset to reorder in place.
+ * @param mapping Output mapping such that mapping[newIndex] = oldIndex.
+ */
+template<typename MatType>
+void ReorderLocality(MatType& data, std::vector<size_t>& mapping)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename std::conditional<sizeof(ElemType) * CHAR_BIT <= 32,
+      uint32_t, uint64_t>::type AddressElemType;
+  typedef std::pair<arma::Col<AddressElemType>, size_t> AddressPair;
+
+  std::vector<AddressPair> addresses(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    addresses[i].first.zeros(data.n_rows);
+    bound::addr::PointToAddress(addresses[i].first, data.col(i));
+    addresses[i].second = i;
+  }
+
+  std::sort(addresses.begin(), addresses.end(),
+      [](const AddressPair& p1, const AddressPair& p2)
+      {
+        return bound::addr::CompareAddresses(p1.first, p2.first) < 0;
+      });
+
+  // Gather the columns into curve order.
+  MatType reordered(data.n_rows, data.n_cols);
+  mapping.resize(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    reordered.col(i) = data.col(addresses[i].second);
+    mapping[i] = addresses[i].second;
+  }
+
+  data = std::move(reordered);
+}
+
+/**
+ * Permute the columns of the given column-major dataset into the order of
+ * their UB-tree addresses, and fill both direction mappings.
+ *
+ * @param data Column-major dataset to reorder in place.
+ * @param oldFromNew Output mapping such that oldFromNew[newIndex] = oldIndex.
+ * @param newFromOld Output mapping such that newFromOld[oldIndex] = newIndex.
+ */
+template<typename MatType>
+void ReorderLocality(MatType& data,
+                     std::vector<size_t>& oldFromNew,
+                     std::vector<size_t>& newFromOld)
+{
+  ReorderLocality(data, oldFromNew);
+
+  newFromOld.resize(oldFromNew.size());
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    newFromOld[oldFromNew[i]] = i;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
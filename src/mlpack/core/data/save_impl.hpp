@@ -21,6 +21,9 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 
+#include "raw_model_archive.hpp"
+#include "compressed_binary.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -64,6 +67,19 @@ bool Save(const std::string& filename,
     return false;
   }
 
+  // The frame-compressed binary format has its own writer.
+  if (extension == "cbin")
+  {
+    Timer::Stop("saving_data");
+    if (transpose)
+    {
+      arma::Mat<eT> tmp = trans(matrix);
+      return SaveCompressedBinary(filename, tmp, fatal);
+    }
+
+    return SaveCompressedBinary(filename, matrix, fatal);
+  }
+
   // Catch errors opening the file.
   std::fstream stream;
 #ifdef  _WIN32 // Always open in binary mode on Windows.
@@ -212,7 +228,7 @@ bool Save(const std::string& filename,
     if (extension == "xml")
       f = format::xml;
     else if (extension == "bin")
-      f = format::binary;
+      f = format::raw; // '.bin' saves the compact native format by default.
     else if (extension == "txt")
       f = format::text;
     else
@@ -232,7 +248,8 @@ bool Save(const std::string& filename,
   // Open the file to save to.
   std::ofstream ofs;
 #ifdef _WIN32
-  if (f == format::binary) // Open non-text types in binary mode on Windows.
+  // Open non-text types in binary mode on Windows.
+  if (f == format::binary || f == format::raw)
     ofs.open(filename, std::ofstream::out | std::ofstream::binary);
   else
     ofs.open(filename, std::ofstream::out);
@@ -269,6 +286,11 @@ bool Save(const std::string& filename,
       boost::archive::binary_oarchive ar(ofs);
       ar << boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::raw)
+    {
+      RawOArchive ar(ofs);
+      ar << boost::serialization::make_nvp(name.c_str(), t);
+    }
 
     return true;
   }
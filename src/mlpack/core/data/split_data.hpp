@@ -14,9 +14,114 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <unordered_map>
 
 namespace mlpack {
 namespace data {
+
+/**
+ * Split the indices 0 ... (count - 1) into a training set and a test set,
+ * without touching the data itself.  The permutation is generated with an
+ * in-place Fisher-Yates shuffle over the index array, so this is O(count)
+ * time and O(count) memory no matter how large the points are.  The indices
+ * can be used directly as lightweight views (e.g. data.cols(trainIndices)) or
+ * passed to the materializing Split() overloads below.
+ *
+ * @param count Number of points to split.
+ * @param testRatio Percentage of points to use for the test set (between 0
+ *     and 1).
+ * @param trainIndices Vector to store the training indices into.
+ * @param testIndices Vector to store the test indices into.
+ */
+inline void SplitIndices(const size_t count,
+                         const double testRatio,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices)
+{
+  arma::uvec order = arma::regspace<arma::uvec>(0, count - 1);
+  for (size_t i = count - 1; i > 0; --i)
+    std::swap(order[i], order[math::RandInt(0, i + 1)]);
+
+  const size_t testSize = static_cast<size_t>(count * testRatio);
+  const size_t trainSize = count - testSize;
+
+  trainIndices.set_size(trainSize);
+  if (trainSize > 0)
+    trainIndices = order.subvec(0, trainSize - 1);
+  testIndices.set_size(testSize);
+  if (testSize > 0)
+    testIndices = order.subvec(trainSize, count - 1);
+}
+
+/**
+ * Split the indices of a labeled dataset into a training set and a test set,
+ * stratified by label: each label contributes the same fraction of its points
+ * to the test set, so rare classes are represented proportionally in both
+ * splits.  Like the unlabeled overload, this is O(n) time and only ever
+ * materializes index arrays, never the data.
+ *
+ * @param inputLabel Labels of the points to split.
+ * @param testRatio Percentage of each label's points to use for the test set
+ *     (between 0 and 1).
+ * @param trainIndices Vector to store the training indices into.
+ * @param testIndices Vector to store the test indices into.
+ */
+template<typename U>
+void SplitIndices(const arma::Row<U>& inputLabel,
+                  const double testRatio,
+                  arma::uvec& trainIndices,
+                  arma::uvec& testIndices)
+{
+  // Collect the indices of each label, preserving encounter order.
+  std::unordered_map<U, std::vector<arma::uword>> strata;
+  for (size_t i = 0; i < inputLabel.n_elem; ++i)
+    strata[inputLabel[i]].push_back(i);
+
+  std::vector<arma::uword> train, test;
+  train.reserve(inputLabel.n_elem);
+  test.reserve(static_cast<size_t>(inputLabel.n_elem * testRatio) + 1);
+
+  for (typename std::unordered_map<U, std::vector<arma::uword>>::iterator it =
+       strata.begin(); it != strata.end(); ++it)
+  {
+    std::vector<arma::uword>& indices = it->second;
+    for (size_t i = indices.size() - 1; i > 0; --i)
+      std::swap(indices[i], indices[math::RandInt(0, i + 1)]);
+
+    const size_t testSize = static_cast<size_t>(indices.size() * testRatio);
+    const size_t trainSize = indices.size() - testSize;
+
+    train.insert(train.end(), indices.begin(), indices.begin() + trainSize);
+    test.insert(test.end(), indices.begin() + trainSize, indices.end());
+  }
+
+  trainIndices = arma::conv_to<arma::uvec>::from(train);
+  testIndices = arma::conv_to<arma::uvec>::from(test);
+}
+
+/**
+ * Gather the given columns of the input into the output, in parallel.  This
+ * materializes the selected points once; use the index vectors directly if a
+ * copy is not needed.
+ *
+ * @param input Dataset to gather from.
+ * @param indices Columns to gather.
+ * @param output Matrix to store the gathered columns into.
+ */
+template<typename T>
+void GatherColumns(const arma::Mat<T>& input,
+                   const arma::uvec& indices,
+                   arma::Mat<T>& output)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) indices.n_elem; ++i)
+    output.col(i) = input.col(indices[i]);
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload places the split dataset into the four
@@ -54,28 +159,48 @@ void Split(const arma::Mat<T>& input,
            arma::Row<U>& testLabel,
            const double testRatio)
 {
-  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
-  const size_t trainSize = input.n_cols - testSize;
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-  trainLabel.set_size(trainSize);
-  testLabel.set_size(testSize);
-
-  const arma::Col<size_t> order =
-      arma::shuffle(arma::linspace<arma::Col<size_t>>(0, input.n_cols - 1,
-                                                      input.n_cols));
-
-  for (size_t i = 0; i != trainSize; ++i)
-  {
-    trainData.col(i) = input.col(order[i]);
-    trainLabel(i) = inputLabel(order[i]);
-  }
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, testRatio, trainIndices, testIndices);
 
-  for (size_t i = 0; i != testSize; ++i)
-  {
-    testData.col(i) = input.col(order[i + trainSize]);
-    testLabel(i) = inputLabel(order[i + trainSize]);
-  }
+  GatherColumns(input, trainIndices, trainData);
+  GatherColumns(input, testIndices, testData);
+
+  trainLabel = inputLabel.cols(trainIndices);
+  testLabel = inputLabel.cols(testIndices);
+}
+
+/**
+ * Given an input dataset and labels, split into a training set and a test set
+ * stratified by label, so each label keeps the same train/test proportions.
+ * The permutation is index-based and the gather is parallelized, so the only
+ * extra memory is the output matrices themselves.
+ *
+ * @param input Input dataset to split.
+ * @param inputLabel Input labels to split.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param trainLabel Vector to store training labels into.
+ * @param testLabel Vector to store test labels into.
+ * @param testRatio Percentage of each label's points to use for the test set
+ *     (between 0 and 1).
+ */
+template<typename T, typename U>
+void StratifiedSplit(const arma::Mat<T>& input,
+                     const arma::Row<U>& inputLabel,
+                     arma::Mat<T>& trainData,
+                     arma::Mat<T>& testData,
+                     arma::Row<U>& trainLabel,
+                     arma::Row<U>& testLabel,
+                     const double testRatio)
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(inputLabel, testRatio, trainIndices, testIndices);
+
+  GatherColumns(input, trainIndices, trainData);
+  GatherColumns(input, testIndices, testData);
+
+  trainLabel = inputLabel.cols(trainIndices);
+  testLabel = inputLabel.cols(testIndices);
 }
 
 /**
@@ -105,23 +230,11 @@ void Split(const arma::Mat<T>& input,
            arma::Mat<T>& testData,
            const double testRatio)
 {
-  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
-  const size_t trainSize = input.n_cols - testSize;
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-
-  const arma::Col<size_t> order =
-      arma::shuffle(arma::linspace<arma::Col<size_t>>(0, input.n_cols -1,
-                                                      input.n_cols));
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, testRatio, trainIndices, testIndices);
 
-  for (size_t i = 0; i != trainSize; ++i)
-  {
-    trainData.col(i) = input.col(order[i]);
-  }
-  for (size_t i = 0; i != testSize; ++i)
-  {
-    testData.col(i) = input.col(order[i + trainSize]);
-  }
+  GatherColumns(input, trainIndices, trainData);
+  GatherColumns(input, testIndices, testData);
 }
 
 /**
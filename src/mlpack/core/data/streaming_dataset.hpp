@@ -0,0 +1,248 @@
+/**
+ * @file streaming_dataset.hpp
+ * @author Ryan Curtin
+ *
+ * A streaming dataset that yields fixed-size column batches from disk, for
+ * training on datasets that do not fit in RAM.  Reads are double-buffered:
+ * while the caller consumes one batch, the next one is read asynchronously,
+ * so a mini-batch training loop can run at disk bandwidth.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+#define MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include <fstream>
+#include <future>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * StreamingDataset reads a headerless raw binary column-major file (the same
+ * layout the memory-mapping Load() overload accepts) in fixed-size batches of
+ * points.  An optional second file supplies the responses for each point, so
+ * mini-batch trainers can consume predictors and responses in lockstep.
+ *
+ * A typical out-of-core training loop looks like:
+ *
+ * @code
+ * data::StreamingDataset<> dataset("x.bin", "y.bin", 784, 10, 1024);
+ * arma::mat batch, responses;
+ * while (dataset.GetNextBatch(batch, responses))
+ *   model.Train(batch, responses, optimizer);
+ * @endcode
+ *
+ * @tparam eT Element type of the stored data.
+ */
+template<typename eT = double>
+class StreamingDataset
+{
+ public:
+  /**
+   * Create the streaming dataset.  The number of points is derived from the
+   * size of the predictors file; if a responses file is given, it must hold
+   * the same number of points.  Throws std::runtime_error if the files cannot
+   * be opened or their sizes disagree.
+   *
+   * @param predictorsFile Raw binary column-major file of predictors.
+   * @param responsesFile Raw binary column-major file of responses (may be
+   *     empty, in which case no responses are yielded).
+   * @param dimensionality Number of rows of the predictors.
+   * @param responseDimensionality Number of rows of the responses.
+   * @param batchSize Number of points per yielded batch.
+   */
+  StreamingDataset(const std::string& predictorsFile,
+                   const std::string& responsesFile,
+                   const size_t dimensionality,
+                   const size_t responseDimensionality,
+                   const size_t batchSize) :
+      dimensionality(dimensionality),
+      responseDimensionality(responseDimensionality),
+      batchSize(batchSize),
+      numPoints(0),
+      cursor(0)
+  {
+    predictorsStream.open(predictorsFile, std::ios::binary);
+    if (!predictorsStream.is_open())
+      throw std::runtime_error("StreamingDataset: cannot open '" +
+          predictorsFile + "'!");
+
+    predictorsStream.seekg(0, std::ios::end);
+    const size_t bytes = (size_t) predictorsStream.tellg();
+    if (bytes % (dimensionality * sizeof(eT)) != 0)
+      throw std::runtime_error("StreamingDataset: size of '" + predictorsFile +
+          "' is not a multiple of the point size!");
+    numPoints = bytes / (dimensionality * sizeof(eT));
+
+    if (!responsesFile.empty())
+    {
+      responsesStream.open(responsesFile, std::ios::binary);
+      if (!responsesStream.is_open())
+        throw std::runtime_error("StreamingDataset: cannot open '" +
+            responsesFile + "'!");
+
+      responsesStream.seekg(0, std::ios::end);
+      const size_t responseBytes = (size_t) responsesStream.tellg();
+      if (responseBytes != numPoints * responseDimensionality * sizeof(eT))
+        throw std::runtime_error("StreamingDataset: '" + responsesFile +
+            "' does not hold the same number of points as '" + predictorsFile +
+            "'!");
+    }
+
+    Reset();
+  }
+
+  //! StreamingDataset holds open streams and a pending read; no copies.
+  StreamingDataset(const StreamingDataset&) = delete;
+  StreamingDataset& operator=(const StreamingDataset&) = delete;
+
+  ~StreamingDataset()
+  {
+    // Make sure no background read outlives the buffers.
+    if (pending.valid())
+      pending.wait();
+  }
+
+  /**
+   * Get the next batch of points, blocking only if the prefetched batch is
+   * not ready yet.  The last batch of an epoch may hold fewer than batchSize
+   * points.  Returns false (and leaves the outputs empty) at the end of the
+   * epoch; call Reset() to start another pass.
+   *
+   * @param predictors Matrix to fill with the next batch of predictors.
+   * @param responses Matrix to fill with the corresponding responses.
+   * @return true if a batch was produced.
+   */
+  bool GetNextBatch(arma::Mat<eT>& predictors, arma::Mat<eT>& responses)
+  {
+    if (!pending.valid())
+    {
+      predictors.clear();
+      responses.clear();
+      return false;
+    }
+
+    // Wait for the in-flight read, hand its buffers to the caller, and
+    // immediately start reading the following batch into the freed buffers.
+    const size_t points = pending.get();
+    if (points == 0)
+    {
+      predictors.clear();
+      responses.clear();
+      return false;
+    }
+
+    predictors = backPredictors;
+    if (responsesStream.is_open())
+      responses = backResponses;
+
+    Prefetch();
+    return true;
+  }
+
+  //! Overload for unlabeled data.
+  bool GetNextBatch(arma::Mat<eT>& predictors)
+  {
+    arma::Mat<eT> unusedResponses;
+    return GetNextBatch(predictors, unusedResponses);
+  }
+
+  /**
+   * Rewind to the beginning of the data and start prefetching the first
+   * batch.
+   */
+  void Reset()
+  {
+    if (pending.valid())
+      pending.wait();
+
+    cursor = 0;
+    predictorsStream.clear();
+    predictorsStream.seekg(0, std::ios::beg);
+    if (responsesStream.is_open())
+    {
+      responsesStream.clear();
+      responsesStream.seekg(0, std::ios::beg);
+    }
+
+    Prefetch();
+  }
+
+  //! Get the dimensionality of the predictors.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the dimensionality of the responses.
+  size_t ResponseDimensionality() const { return responseDimensionality; }
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Get the total number of points in the dataset.
+  size_t NumPoints() const { return numPoints; }
+
+ private:
+  /**
+   * Start an asynchronous read of the next batch into the back buffers.
+   */
+  void Prefetch()
+  {
+    const size_t points = std::min(batchSize, numPoints - cursor);
+    cursor += points;
+
+    pending = std::async(std::launch::async, [this, points]()
+    {
+      if (points == 0)
+        return (size_t) 0;
+
+      backPredictors.set_size(dimensionality, points);
+      predictorsStream.read((char*) backPredictors.memptr(),
+          points * dimensionality * sizeof(eT));
+      if (!predictorsStream)
+        return (size_t) 0;
+
+      if (responsesStream.is_open())
+      {
+        backResponses.set_size(responseDimensionality, points);
+        responsesStream.read((char*) backResponses.memptr(),
+            points * responseDimensionality * sizeof(eT));
+        if (!responsesStream)
+          return (size_t) 0;
+      }
+
+      return points;
+    });
+  }
+
+  //! Number of rows of the predictors.
+  size_t dimensionality;
+  //! Number of rows of the responses.
+  size_t responseDimensionality;
+  //! Number of points per batch.
+  size_t batchSize;
+  //! Total number of points in the file.
+  size_t numPoints;
+  //! Number of points dispatched to reads so far this epoch.
+  size_t cursor;
+
+  //! Stream for the predictors file.
+  std::ifstream predictorsStream;
+  //! Stream for the responses file.
+  std::ifstream responsesStream;
+
+  //! Buffer the background read fills.
+  arma::Mat<eT> backPredictors;
+  //! Buffer the background read fills with responses.
+  arma::Mat<eT> backResponses;
+  //! Handle on the in-flight read; yields the number of points read.
+  std::future<size_t> pending;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
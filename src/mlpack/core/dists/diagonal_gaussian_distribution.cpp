@@ -0,0 +1,128 @@
+/**
+ * @file diagonal_gaussian_distribution.cpp
+ *
+ * Implementation of the Gaussian distribution with a diagonal covariance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "diagonal_gaussian_distribution.hpp"
+
+using namespace mlpack;
+using namespace mlpack::distribution;
+
+DiagonalGaussianDistribution::DiagonalGaussianDistribution(
+    const arma::vec& mean,
+    const arma::vec& covariance)
+  : mean(mean)
+{
+  Covariance(covariance);
+}
+
+void DiagonalGaussianDistribution::Covariance(const arma::vec& covariance)
+{
+  this->covariance = covariance;
+  FactorCovariance();
+}
+
+void DiagonalGaussianDistribution::Covariance(arma::vec&& covariance)
+{
+  this->covariance = std::move(covariance);
+  FactorCovariance();
+}
+
+void DiagonalGaussianDistribution::FactorCovariance()
+{
+  invCov = 1.0 / covariance;
+  logDetCov = arma::accu(arma::log(covariance));
+}
+
+double DiagonalGaussianDistribution::LogProbability(
+    const arma::vec& observation) const
+{
+  const size_t k = observation.n_elem;
+  const arma::vec diff = observation - mean;
+  return -0.5 * k * log2pi - 0.5 * logDetCov -
+      0.5 * arma::dot(diff % diff, invCov);
+}
+
+arma::vec DiagonalGaussianDistribution::Random() const
+{
+  return arma::sqrt(covariance) % arma::randn<arma::vec>(mean.n_elem) + mean;
+}
+
+/**
+ * Estimate the Gaussian distribution directly from the given observations.
+ *
+ * @param observations List of observations.
+ */
+void DiagonalGaussianDistribution::Train(const arma::mat& observations)
+{
+  if (observations.n_cols == 0)
+  {
+    mean.zeros(0);
+    covariance.zeros(0);
+    invCov.zeros(0);
+    logDetCov = 0.0;
+    return;
+  }
+
+  // Calculate the mean, then the per-dimension variances around it, with the
+  // (1 / (n - 1)) so that it is the unbiased estimator.
+  mean = arma::mean(observations, 1);
+
+  arma::mat diffs = observations;
+  diffs.each_col() -= mean;
+  covariance = arma::sum(arma::square(diffs), 1) /
+      std::max((size_t) 1, (size_t) (observations.n_cols - 1));
+
+  // Ensure that the variances stay away from zero.
+  covariance = arma::clamp(covariance, 1e-50, DBL_MAX);
+
+  FactorCovariance();
+}
+
+/**
+ * Estimate the Gaussian distribution from the given observations, taking into
+ * account the probability of each observation actually being from this
+ * distribution.
+ */
+void DiagonalGaussianDistribution::Train(const arma::mat& observations,
+                                         const arma::vec& probabilities)
+{
+  if (observations.n_cols == 0)
+  {
+    mean.zeros(0);
+    covariance.zeros(0);
+    invCov.zeros(0);
+    logDetCov = 0.0;
+    return;
+  }
+
+  const double sumProb = arma::accu(probabilities);
+  if (sumProb == 0)
+  {
+    // Nothing in this Gaussian!  At least set the variances so they are
+    // invertible.
+    mean.zeros(observations.n_rows);
+    covariance.set_size(observations.n_rows);
+    covariance.fill(1e-50);
+    FactorCovariance();
+    return;
+  }
+
+  // The weighted mean and variances are each a single matrix-vector product
+  // over the (squared, centered) observations.
+  mean = (observations * probabilities) / sumProb;
+
+  arma::mat diffs = observations;
+  diffs.each_col() -= mean;
+  covariance = (arma::square(diffs) * probabilities) / sumProb;
+
+  // Ensure that the variances stay away from zero.
+  covariance = arma::clamp(covariance, 1e-50, DBL_MAX);
+
+  FactorCovariance();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file diagonal_gaussian_distribution.hpp
+ *
+ * Implementation of the Gaussian distribution with a diagonal covariance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_DIAGONAL_GAUSSIAN_DISTRIBUTION_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_DIAGONAL_GAUSSIAN_DISTRIBUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace distribution {
+
+/**
+ * A single multivariate Gaussian distribution with a diagonal covariance.
+ * Only the variance of each dimension is stored, so the density can be
+ * computed with elementwise operations---no Cholesky factorization and no
+ * triangular solves are ever needed.
+ */
+class DiagonalGaussianDistribution
+{
+ private:
+  //! Mean of the distribution.
+  arma::vec mean;
+  //! Diagonal of the covariance of the distribution (the per-dimension
+  //! variances).
+  arma::vec covariance;
+  //! Cached inverse of the variances.
+  arma::vec invCov;
+  //! Cached logdet(cov).
+  double logDetCov;
+
+  //! log(2pi)
+  static const constexpr double log2pi = 1.83787706640934533908193770912475883;
+
+ public:
+  /**
+   * Default constructor, which creates a Gaussian with zero dimension.
+   */
+  DiagonalGaussianDistribution() : logDetCov(0.0) { /* nothing to do */ }
+
+  /**
+   * Create a diagonal Gaussian distribution with zero mean and unit variance
+   * in each dimension.
+   */
+  DiagonalGaussianDistribution(const size_t dimension) :
+      mean(arma::zeros<arma::vec>(dimension)),
+      covariance(arma::ones<arma::vec>(dimension)),
+      invCov(arma::ones<arma::vec>(dimension)),
+      logDetCov(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Create a diagonal Gaussian distribution with the given mean and vector of
+   * per-dimension variances.
+   *
+   * Each variance is expected to be positive.
+   */
+  DiagonalGaussianDistribution(const arma::vec& mean,
+                               const arma::vec& covariance);
+
+  //! Return the dimensionality of this distribution.
+  size_t Dimensionality() const { return mean.n_elem; }
+
+  /**
+   * Return the probability of the given observation.
+   */
+  double Probability(const arma::vec& observation) const
+  {
+    return exp(LogProbability(observation));
+  }
+
+  /**
+   * Return the log probability of the given observation.
+   */
+  double LogProbability(const arma::vec& observation) const;
+
+  /**
+   * Calculates the multivariate Gaussian probability density function for each
+   * data point (column) in the given matrix.
+   *
+   * @param x List of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const
+  {
+    arma::vec logProbabilities;
+    LogProbability(x, logProbabilities);
+    probabilities = arma::exp(logProbabilities);
+  }
+
+  /**
+   * Returns the Log probability of the given matrix. These values are stored
+   * in logProbabilities.
+   *
+   * With a diagonal covariance the Mahalanobis part is just a weighted sum of
+   * squared differences, so the whole block of points is handled with one
+   * square-and-accumulate pass against the inverse variances---fused
+   * multiply-adds, no solves.
+   *
+   * @param x List of observations.
+   * @param logProbabilities Output log probabilities for each input
+   *     observation.
+   */
+  void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
+  {
+    arma::mat diffs = x;
+    diffs.each_col() -= mean;
+
+    logProbabilities = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov -
+        0.5 * arma::trans(invCov.t() * arma::square(diffs));
+  }
+
+  /**
+   * Return a randomly generated observation according to the probability
+   * distribution defined by this object.
+   *
+   * @return Random observation from this Gaussian distribution.
+   */
+  arma::vec Random() const;
+
+  /**
+   * Estimate the Gaussian distribution directly from the given observations.
+   *
+   * @param observations List of observations.
+   */
+  void Train(const arma::mat& observations);
+
+  /**
+   * Estimate the Gaussian distribution from the given observations, taking
+   * into account the probability of each observation actually being from this
+   * distribution.
+   */
+  void Train(const arma::mat& observations,
+             const arma::vec& probabilities);
+
+  /**
+   * Return the mean.
+   */
+  const arma::vec& Mean() const { return mean; }
+
+  /**
+   * Return a modifiable copy of the mean.
+   */
+  arma::vec& Mean() { return mean; }
+
+  /**
+   * Return the vector of per-dimension variances.
+   */
+  const arma::vec& Covariance() const { return covariance; }
+
+  /**
+   * Set the vector of per-dimension variances.
+   */
+  void Covariance(const arma::vec& covariance);
+
+  void Covariance(arma::vec&& covariance);
+
+  /**
+   * Serialize the distribution.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    // We just need to serialize each of the members.
+    ar & BOOST_SERIALIZATION_NVP(mean);
+    ar & BOOST_SERIALIZATION_NVP(covariance);
+    ar & BOOST_SERIALIZATION_NVP(invCov);
+    ar & BOOST_SERIALIZATION_NVP(logDetCov);
+  }
+
+ private:
+  /**
+   * Recompute the cached inverse variances and log-determinant after the
+   * covariance has changed.
+   */
+  void FactorCovariance();
+};
+
+} // namespace distribution
+} // namespace mlpack
+
+#endif
@@ -21,35 +21,31 @@ using namespace mlpack::distribution;
  */
 arma::vec DiscreteDistribution::Random() const
 {
-  size_t dimension = probabilities.size();
+  // Rebuild the alias tables if the probabilities have changed since the
+  // last draw.  Each draw is then O(1) in the number of observations.
+  if (!aliasTablesValid)
+    BuildAliasTables();
+
+  const size_t dimension = probabilities.size();
   arma::vec result(dimension);
 
   for (size_t d = 0; d < dimension; d++)
-  {
-    // Generate a random number.
-    double randObs = math::Random();
-
-    double sumProb = 0;
-
-    for (size_t obs = 0; obs < probabilities[d].n_elem; obs++)
-    {
-      if ((sumProb += probabilities[d][obs]) >= randObs)
-      {
-        result[d] = obs;
-        break;
-      }
-    }
-
-    if (sumProb > 1.0)
-    {
-      // This shouldn't happen.
-      result[d] = probabilities[d].n_elem - 1;
-    }
-  }
+    result[d] = (double) aliasTables[d].Random();
 
   return result;
 }
 
+/**
+ * Build the alias tables used by Random(): one table per dimension.
+ */
+void DiscreteDistribution::BuildAliasTables() const
+{
+  aliasTables.resize(probabilities.size());
+  for (size_t d = 0; d < probabilities.size(); d++)
+    aliasTables[d].Build(probabilities[d]);
+  aliasTablesValid = true;
+}
+
 /**
  * Estimate the probability distribution directly from the given observations.
  */
@@ -101,6 +97,10 @@ void DiscreteDistribution::Train(const arma::mat& observations)
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The alias tables no longer match the probabilities; Random() will
+  // rebuild them on the next draw.
+  aliasTablesValid = false;
 }
 
 /**
@@ -157,4 +157,8 @@ void DiscreteDistribution::Train(const arma::mat& observations,
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The alias tables no longer match the probabilities; Random() will
+  // rebuild them on the next draw.
+  aliasTablesValid = false;
 }
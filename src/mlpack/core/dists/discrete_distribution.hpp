@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/math/alias_table.hpp>
 #include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
@@ -51,7 +52,8 @@ class DiscreteDistribution
    * observations.
    */
   DiscreteDistribution() :
-      probabilities(std::vector<arma::vec>(1)){ /* Nothing to do. */ }
+      probabilities(std::vector<arma::vec>(1)),
+      aliasTablesValid(false) { /* Nothing to do. */ }
 
   /**
    * Define the discrete distribution as having numObservations possible
@@ -63,7 +65,8 @@ class DiscreteDistribution
    */
   DiscreteDistribution(const size_t numObservations) :
       probabilities(std::vector<arma::vec>(1,
-          arma::ones<arma::vec>(numObservations) / numObservations))
+          arma::ones<arma::vec>(numObservations) / numObservations)),
+      aliasTablesValid(false)
   { /* Nothing to do. */ }
 
   /**
@@ -74,7 +77,8 @@ class DiscreteDistribution
    * @param numObservations Number of possible observations this distribution
    *    can have.
    */
-  DiscreteDistribution(const arma::Col<size_t>& numObservations)
+  DiscreteDistribution(const arma::Col<size_t>& numObservations) :
+      aliasTablesValid(false)
   {
     for (size_t i = 0; i < numObservations.n_elem; i++)
     {
@@ -96,7 +100,8 @@ class DiscreteDistribution
    *
    * @param probabilities Probabilities of each possible observation.
    */
-  DiscreteDistribution(const std::vector<arma::vec>& probabilities)
+  DiscreteDistribution(const std::vector<arma::vec>& probabilities) :
+      aliasTablesValid(false)
   {
     for (size_t i = 0; i < probabilities.size(); i++)
     {
@@ -202,7 +207,9 @@ class DiscreteDistribution
   /**
    * Return a randomly generated observation (one-dimensional vector; one
    * observation) according to the probability distribution defined by this
-   * object.
+   * object.  Sampling uses alias tables, so each draw takes constant time in
+   * the number of possible observations; the tables are (re)built on the
+   * first draw after the probabilities have changed.
    *
    * @return Random observation.
    */
@@ -229,9 +236,14 @@ class DiscreteDistribution
   void Train(const arma::mat& observations,
              const arma::vec& probabilities);
 
+  //! Modify the vector of probabilities for the given dimension.  The alias
+  //! tables used by Random() are rebuilt on the next draw.
+  arma::vec& Probabilities(const size_t dim = 0)
+  {
+    aliasTablesValid = false;
+    return probabilities[dim];
+  }
   //! Return the vector of probabilities for the given dimension.
-  arma::vec& Probabilities(const size_t dim = 0) { return probabilities[dim]; }
-  //! Modify the vector of probabilities for the given dimension.
   const arma::vec& Probabilities(const size_t dim = 0) const
   { return probabilities[dim]; }
 
@@ -242,12 +254,24 @@ class DiscreteDistribution
   void serialize(Archive& ar, const unsigned int /* version */)
   {
     ar & BOOST_SERIALIZATION_NVP(probabilities);
+
+    // The alias tables are rebuilt on demand instead of being serialized.
+    if (Archive::is_loading::value)
+      aliasTablesValid = false;
   }
 
  private:
+  //! Build the alias tables used by Random(): one table per dimension.
+  void BuildAliasTables() const;
+
   //! The probabilities for each dimension; each arma::vec represents the
   //! probabilities for the observations in each dimension.
   std::vector<arma::vec> probabilities;
+
+  //! Alias tables for constant-time sampling; built on demand by Random().
+  mutable std::vector<math::AliasTable> aliasTables;
+  //! Whether the alias tables match the current probabilities.
+  mutable bool aliasTablesValid;
 };
 
 } // namespace distribution
@@ -90,11 +90,12 @@ class GaussianDistribution
    */
   void Probability(const arma::mat& x, arma::vec& probabilities) const
   {
-    probabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; i++)
-    {
-      probabilities(i) = Probability(x.unsafe_col(i));
-    }
+    // Use the batched log-probability computation, which processes all points
+    // against the covariance with a single matrix product, instead of looping
+    // over the points one by one.
+    arma::vec logProbabilities;
+    LogProbability(x, logProbabilities);
+    probabilities = arma::exp(logProbabilities);
   }
 
   /**
@@ -107,20 +108,29 @@ class GaussianDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    // Column i of 'diffs' is the difference between x.col(i) and the mean.
-    arma::mat diffs = x;
-    diffs.each_col() -= mean;
-    // Now, we only want to calculate the diagonal elements of (diffs' * cov^-1
-    // * diffs).  We just don't need any of the other elements.  We can
-    // calculate the right hand part of the equation (instead of the left side)
-    // so that later we are referencing columns, not rows -- that is faster.
-    const arma::mat rhs = -0.5 * invCov * diffs;
-    arma::vec logExponents(diffs.n_cols); // We will now fill this.
-    for (size_t i = 0; i < diffs.n_cols; i++)
-      logExponents(i) = accu(diffs.unsafe_col(i) % rhs.unsafe_col(i));
-
-    logProbabilities = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov +
-      logExponents;
+    logProbabilities.set_size(x.n_cols);
+
+    // If L z = (x - mean), with L the lower Cholesky factor of the
+    // covariance, then (x - mean)' * cov^-1 * (x - mean) = z' z; so a single
+    // triangular solve against a whole block of points gives the Mahalanobis
+    // part for all of them, and the squared column norms fall out of one
+    // fused square-and-accumulate pass.  The points are processed in tiles so
+    // that the centered temporary stays cache-sized no matter how many points
+    // are given.
+    const size_t blockSize = 4096;
+    for (size_t begin = 0; begin < x.n_cols; begin += blockSize)
+    {
+      const size_t last = std::min(begin + blockSize, (size_t) x.n_cols) - 1;
+
+      // Column i of 'diffs' is the difference between x.col(begin + i) and
+      // the mean; the solve overwrites it with z.
+      arma::mat diffs = x.cols(begin, last);
+      diffs.each_col() -= mean;
+      diffs = arma::solve(arma::trimatl(covLower), diffs);
+
+      logProbabilities.subvec(begin, last) = -0.5 * x.n_rows * log2pi -
+          0.5 * logDetCov - 0.5 * arma::trans(arma::sum(arma::square(diffs)));
+    }
   }
 
   /**
@@ -86,6 +86,17 @@ class CVFunction
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
+  //! Get the fraction of the training data used for evaluations.
+  double DataFraction() const { return dataFraction; }
+  /**
+   * Modify the fraction of the training data used for evaluations.  Values
+   * less than 1 request partial-budget evaluations (the CVType object should
+   * provide an EvaluateFraction method, like SimpleCV does); scores obtained
+   * at reduced budgets do not take part in the best model bookkeeping, since
+   * they are not comparable with full-budget ones.
+   */
+  double& DataFraction() { return dataFraction; }
+
  private:
   //! The type of tuples of BoundArgs.
   using BoundArgsTupleType = std::tuple<BoundArgs...>;
@@ -125,6 +136,9 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! The fraction of the training data to use for evaluations.
+  double dataFraction;
+
   /**
    * Collect all arguments and run cross-validation.
    */
@@ -167,6 +181,27 @@ class CVFunction
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>::type,
            typename = void>
   inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+
+  /**
+   * Run a partial-budget evaluation if the cross-validation strategy supports
+   * it (the int-tag overload is preferred when cv.EvaluateFraction() exists).
+   */
+  template<typename CV, typename... Args>
+  inline static auto EvaluateWithFraction(int,
+                                          CV& cv,
+                                          const double fraction,
+                                          const Args&... args)
+      -> decltype(cv.EvaluateFraction(fraction, args...));
+
+  /**
+   * A fallback for cross-validation strategies without an EvaluateFraction
+   * method; throws std::invalid_argument.
+   */
+  template<typename CV, typename... Args>
+  inline static double EvaluateWithFraction(long,
+                                            CV& cv,
+                                            const double fraction,
+                                            const Args&... args);
 };
 
 
@@ -55,7 +55,8 @@ CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
     boundArgs(args...),
     bestObjective(std::numeric_limits<double>::max()),
     relativeDelta(relativeDelta),
-    minDelta(minDelta)
+    minDelta(minDelta),
+    dataFraction(1.0)
 { /* Nothing left to do. */ }
 
 template<typename CVType,
@@ -117,15 +118,26 @@ double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& /* parameters */,
     const Args&... args)
 {
+  // Reduced-budget evaluations are used by successive halving to screen
+  // candidates cheaply; their scores are not comparable with full-budget ones,
+  // so they bypass the best model bookkeeping below.
+  if (dataFraction < 1.0)
+    return EvaluateWithFraction(0, cv, dataFraction, args...);
+
   double objective = cv.Evaluate(args...);
 
   // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
+  // have not assigned any valid (trained) model yet.  The update is guarded so
+  // that the bookkeeping stays consistent if the optimizer evaluates several
+  // candidates concurrently.
+  #pragma omp critical
   {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
+    if (bestObjective > objective ||
+        bestObjective == std::numeric_limits<double>::max())
+    {
+      bestObjective = objective;
+      bestModel = std::move(cv.Model());
+    }
   }
 
   return objective;
@@ -172,6 +184,37 @@ double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
   }
 }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename CV, typename... Args>
+auto CVFunction<CVType, MLAlgorithm, TotalArgs,
+    BoundArgs...>::EvaluateWithFraction(int,
+                                        CV& cv,
+                                        const double fraction,
+                                        const Args&... args)
+    -> decltype(cv.EvaluateFraction(fraction, args...))
+{
+  return cv.EvaluateFraction(fraction, args...);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename CV, typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs,
+    BoundArgs...>::EvaluateWithFraction(long,
+                                        CV& /* cv */,
+                                        const double /* fraction */,
+                                        const Args&... /* args */)
+{
+  throw std::invalid_argument("CVFunction::Evaluate(): the cross-validation "
+      "strategy does not support partial-budget evaluation (an "
+      "EvaluateFraction method is required; SimpleCV provides one)");
+}
+
 } // namespace hpt
 } // namespace mlpack
 
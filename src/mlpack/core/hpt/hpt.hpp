@@ -177,6 +177,41 @@ class HyperParameterTuner
   template<typename... Args>
   TupleOfHyperParameters<Args...> Optimize(const Args&... args);
 
+  /**
+   * Find the best hyper-parameters with successive halving.  All candidate
+   * configurations (the Cartesian product of the passed collections; arguments
+   * are specified in the same way as for Optimize() with GridSearch) are first
+   * evaluated on a small fraction of the training data (MinBudget()), then the
+   * better-scoring half is kept and the fraction is doubled, and so on until
+   * the surviving candidates are evaluated on all of the training data.  This
+   * discards most configurations after cheap partial evaluations instead of
+   * training every one of them at full cost.
+   *
+   * The cross-validation strategy should support partial-budget evaluation
+   * (SimpleCV does); a std::invalid_argument is thrown otherwise.
+   *
+   * The method returns a tuple of values for hyper-parameters that haven't
+   * been fixed, like Optimize().
+   *
+   * @param args Arguments corresponding to hyper-parameters (collections of
+   *   values to choose from, or values fixed with mlpack::hpt::Fixed).
+   */
+  template<typename... Args>
+  TupleOfHyperParameters<Args...> OptimizeSuccessiveHalving(
+      const Args&... args);
+
+  /**
+   * Get the fraction of the training data used in the first rung of
+   * OptimizeSuccessiveHalving().  The default value is 0.25.
+   */
+  double MinBudget() const { return minBudget; }
+
+  /**
+   * Modify the fraction of the training data used in the first rung of
+   * OptimizeSuccessiveHalving().  The default value is 0.25.
+   */
+  double& MinBudget() { return minBudget; }
+
   //! Get the performance measurement of the best model from the last run.
   double BestObjective() const { return bestObjective; }
 
@@ -230,6 +265,13 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! The data fraction for the first rung of successive halving.
+  double minBudget;
+
+  //! Whether the current run should use successive halving rather than the
+  //! optimizer.
+  bool useSuccessiveHalving;
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
@@ -324,6 +366,19 @@ class HyperParameterTuner
       data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
       FixedArgs... fixedArgs);
 
+  /**
+   * Run successive halving over the grid described by datasetInfo: evaluate
+   * all candidates on the MinBudget() fraction of the training data through
+   * the given CVFunction object, keep the better half, double the fraction,
+   * and repeat until the survivors are evaluated at full budget.  The winning
+   * candidate is written into bestParams.
+   */
+  template<typename CVFunctionType>
+  inline void RunSuccessiveHalving(
+      CVFunctionType& cvFunction,
+      arma::mat& bestParams,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo);
+
   /**
    * Gather all elements of vector in an argument list and use them to create a
    * tuple.
@@ -32,7 +32,8 @@ HyperParameterTuner<MLAlgorithm,
                     MatType,
                     PredictionsType,
                     WeightsType>::HyperParameterTuner(const CVArgs&... args) :
-    cv(args...), relativeDelta(0.01), minDelta(1e-10) {}
+    cv(args...), relativeDelta(0.01), minDelta(1e-10), minBudget(0.25),
+    useSuccessiveHalving(false) {}
 
 template<typename MLAlgorithm,
          typename Metric,
@@ -71,6 +72,45 @@ TupleOfHyperParameters<Args...> HyperParameterTuner<MLAlgorithm,
   return VectorToTuple<TupleOfHyperParameters<Args...>, 0>(bestParameters);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Args>
+TupleOfHyperParameters<Args...>
+HyperParameterTuner<MLAlgorithm,
+                    Metric,
+                    CV,
+                    Optimizer,
+                    MatType,
+                    PredictionsType,
+                    WeightsType>::OptimizeSuccessiveHalving(
+    const Args&... args)
+{
+  if (minBudget <= 0.0 || minBudget > 1.0)
+    throw std::invalid_argument("HyperParameterTuner::"
+        "OptimizeSuccessiveHalving(): the MinBudget() parameter should be "
+        "more than 0 and at most 1");
+
+  // Reuse the whole argument-handling machinery of Optimize(); the terminal
+  // InitAndOptimize() dispatches on this flag.
+  useSuccessiveHalving = true;
+  try
+  {
+    TupleOfHyperParameters<Args...> result = Optimize(args...);
+    useSuccessiveHalving = false;
+    return result;
+  }
+  catch (...)
+  {
+    useSuccessiveHalving = false;
+    throw;
+  }
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          template<typename, typename, typename, typename, typename> class CV,
@@ -104,6 +144,14 @@ void HyperParameterTuner<MLAlgorithm,
 
   CVFunction<CVType, MLAlgorithm, totalArgs, FixedArgs...>
       cvFunction(cv, datasetInfo, relativeDelta, minDelta, fixedArgs...);
+
+  if (useSuccessiveHalving)
+  {
+    RunSuccessiveHalving(cvFunction, bestParams, datasetInfo);
+    bestModel = std::move(cvFunction.BestModel());
+    return;
+  }
+
   bestObjective = Metric::NeedsMinimization ? optimizer.Optimize(cvFunction,
       bestParams, categoricalDimensions, numCategories) :
       -optimizer.Optimize(cvFunction, bestParams, categoricalDimensions,
@@ -204,6 +252,93 @@ void HyperParameterTuner<MLAlgorithm,
   InitAndOptimize<I + 1>(args, bestParams, datasetInfo, fixedArgs...);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CVFunctionType>
+void HyperParameterTuner<MLAlgorithm,
+                         Metric,
+                         CV,
+                         Optimizer,
+                         MatType,
+                         PredictionsType,
+                         WeightsType>::RunSuccessiveHalving(
+    CVFunctionType& cvFunction,
+    arma::mat& bestParams,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo)
+{
+  const size_t dimensionality = datasetInfo.Dimensionality();
+
+  // Successive halving screens a finite candidate grid, so every non-fixed
+  // hyper-parameter should be given as a collection of values (numeric
+  // starting values for gradient-based optimizers don't describe a grid).
+  size_t numCandidates = 1;
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    if (datasetInfo.Type(d) != data::Datatype::categorical)
+      throw std::invalid_argument("HyperParameterTuner::"
+          "OptimizeSuccessiveHalving(): all non-fixed hyper-parameters should "
+          "be passed as collections of values to choose from");
+
+    numCandidates *= datasetInfo.NumMappings(d);
+  }
+
+  // Enumerate the Cartesian product of the per-dimension value sets; each
+  // candidate is a column of mapped (index) values, as the optimizer would
+  // pass them to the CVFunction object.
+  std::vector<arma::mat> candidates(numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    candidates[c].set_size(dimensionality, 1);
+    size_t remainder = c;
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      candidates[c](d, 0) = double(remainder % datasetInfo.NumMappings(d));
+      remainder /= datasetInfo.NumMappings(d);
+    }
+  }
+
+  std::vector<size_t> survivors(numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c)
+    survivors[c] = c;
+
+  double fraction = minBudget;
+  arma::vec objectives;
+  while (true)
+  {
+    cvFunction.DataFraction() = fraction;
+
+    objectives.set_size(survivors.size());
+    for (size_t i = 0; i < survivors.size(); ++i)
+      objectives(i) = cvFunction.Evaluate(candidates[survivors[i]]);
+
+    if (fraction >= 1.0)
+      break;
+
+    // Keep the better-scoring half of the candidates (the cross-validation
+    // objective is to be minimized; maximized metrics are already negated).
+    const size_t numToKeep = std::max(size_t(1), (survivors.size() + 1) / 2);
+    const arma::uvec order = arma::sort_index(objectives);
+    std::vector<size_t> nextSurvivors(numToKeep);
+    for (size_t i = 0; i < numToKeep; ++i)
+      nextSurvivors[i] = survivors[order(i)];
+    survivors = std::move(nextSurvivors);
+
+    fraction = std::min(1.0, 2.0 * fraction);
+  }
+
+  arma::uword bestIndex;
+  const double bestFullBudgetObjective = objectives.min(bestIndex);
+
+  bestParams = candidates[survivors[bestIndex]];
+  bestObjective = Metric::NeedsMinimization ? bestFullBudgetObjective :
+      -bestFullBudgetObjective;
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          template<typename, typename, typename, typename, typename> class CV,
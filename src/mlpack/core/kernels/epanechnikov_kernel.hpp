@@ -89,6 +89,9 @@ class EpanechnikovKernel
    */
   double Normalizer(const size_t dimension);
 
+  //! Get the bandwidth.
+  double Bandwidth() const { return bandwidth; }
+
   /**
    * Serialize the kernel.
    */
@@ -0,0 +1,145 @@
+/**
+ * @file gram_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the GramMatrix class, a blocked builder for dense kernel (Gram)
+ * matrices.  Instead of filling the matrix with nested scalar loops over
+ * Kernel::Evaluate(), the matrix is assembled in cache-sized column blocks, and
+ * dot-product-based kernels (linear, polynomial, Gaussian) are computed from a
+ * single matrix-matrix product.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_GRAM_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_GRAM_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/kernels/polynomial_kernel.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Compute a dense kernel (Gram) matrix for a given kernel type.  For two data
+ * matrices @f$ A @f$ and @f$ B @f$ holding points as columns, the resulting
+ * matrix @f$ K @f$ has @f$ K_{ij} = k(a_i, b_j) @f$.
+ *
+ * The generic implementation evaluates the kernel pairwise, but walks the
+ * output in column blocks so that the block of points being compared stays in
+ * cache, and distributes blocks across OpenMP threads.  For kernels that are a
+ * function of the inner product or the Euclidean distance---LinearKernel,
+ * PolynomialKernel and GaussianKernel---a specialization computes all inner
+ * products with one matrix-matrix product (which dispatches to GEMM) and then
+ * applies the scalar transformation vectorized, which is far faster than any
+ * pairwise evaluation.
+ *
+ * @tparam KernelType The kernel to evaluate.
+ */
+template<typename KernelType>
+class GramMatrix
+{
+ public:
+  /**
+   * Compute the kernel matrix between two sets of points, so that
+   * gram(i, j) = k(a.col(i), b.col(j)).  The output matrix is sized
+   * (a.n_cols x b.n_cols).
+   *
+   * @param a First set of points (one point per column).
+   * @param b Second set of points (one point per column).
+   * @param gram Matrix to store the result in.
+   * @param kernel Instantiated kernel to evaluate.
+   */
+  static void Compute(const arma::mat& a,
+                      const arma::mat& b,
+                      arma::mat& gram,
+                      KernelType kernel = KernelType());
+
+  /**
+   * Compute the symmetric kernel matrix of one set of points, so that
+   * gram(i, j) = k(data.col(i), data.col(j)).  Only the upper triangle is
+   * evaluated; the lower triangle is filled in by symmetry.
+   *
+   * @param data Set of points (one point per column).
+   * @param gram Matrix to store the result in.
+   * @param kernel Instantiated kernel to evaluate.
+   */
+  static void Compute(const arma::mat& data,
+                      arma::mat& gram,
+                      KernelType kernel = KernelType());
+
+ private:
+  //! Number of points per block; a block pair of double-precision points in
+  //! reasonable dimensionality fits comfortably in L2 cache.
+  static const size_t blockSize = 64;
+};
+
+//! GramMatrix specialization for the linear kernel: the whole matrix is one
+//! matrix-matrix product.
+template<>
+class GramMatrix<LinearKernel>
+{
+ public:
+  //! Compute the kernel matrix between two sets of points.
+  static void Compute(const arma::mat& a,
+                      const arma::mat& b,
+                      arma::mat& gram,
+                      LinearKernel kernel = LinearKernel());
+
+  //! Compute the symmetric kernel matrix of one set of points.
+  static void Compute(const arma::mat& data,
+                      arma::mat& gram,
+                      LinearKernel kernel = LinearKernel());
+};
+
+//! GramMatrix specialization for the polynomial kernel: inner products come
+//! from one matrix-matrix product; the offset and power are applied to column
+//! blocks in parallel.
+template<>
+class GramMatrix<PolynomialKernel>
+{
+ public:
+  //! Compute the kernel matrix between two sets of points.
+  static void Compute(const arma::mat& a,
+                      const arma::mat& b,
+                      arma::mat& gram,
+                      PolynomialKernel kernel = PolynomialKernel());
+
+  //! Compute the symmetric kernel matrix of one set of points.
+  static void Compute(const arma::mat& data,
+                      arma::mat& gram,
+                      PolynomialKernel kernel = PolynomialKernel());
+};
+
+//! GramMatrix specialization for the Gaussian kernel: squared distances are
+//! recovered from inner products and squared norms
+//! (||a - b||^2 = ||a||^2 + ||b||^2 - 2 a^T b), so the dominant cost is one
+//! matrix-matrix product; the exponential is applied to column blocks in
+//! parallel.
+template<>
+class GramMatrix<GaussianKernel>
+{
+ public:
+  //! Compute the kernel matrix between two sets of points.
+  static void Compute(const arma::mat& a,
+                      const arma::mat& b,
+                      arma::mat& gram,
+                      GaussianKernel kernel = GaussianKernel());
+
+  //! Compute the symmetric kernel matrix of one set of points.
+  static void Compute(const arma::mat& data,
+                      arma::mat& gram,
+                      GaussianKernel kernel = GaussianKernel());
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "gram_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file gram_matrix_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the GramMatrix class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_GRAM_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_GRAM_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gram_matrix.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+template<typename KernelType>
+void GramMatrix<KernelType>::Compute(const arma::mat& a,
+                                     const arma::mat& b,
+                                     arma::mat& gram,
+                                     KernelType kernel)
+{
+  gram.set_size(a.n_cols, b.n_cols);
+
+  // Walk the output in column blocks: for each pair of blocks, both blocks of
+  // points fit in cache, so the pairwise evaluations inside a block pair do
+  // not thrash.  Block pairs are independent, so they are distributed across
+  // threads.
+  const size_t numBlocksB = (b.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocksB; ++block)
+  {
+    const size_t jBegin = block * blockSize;
+    const size_t jEnd = std::min(jBegin + blockSize, (size_t) b.n_cols);
+    for (size_t iBegin = 0; iBegin < a.n_cols; iBegin += blockSize)
+    {
+      const size_t iEnd = std::min(iBegin + blockSize, (size_t) a.n_cols);
+      for (size_t j = jBegin; j < jEnd; ++j)
+        for (size_t i = iBegin; i < iEnd; ++i)
+          gram(i, j) = kernel.Evaluate(a.unsafe_col(i), b.unsafe_col(j));
+    }
+  }
+}
+
+template<typename KernelType>
+void GramMatrix<KernelType>::Compute(const arma::mat& data,
+                                     arma::mat& gram,
+                                     KernelType kernel)
+{
+  gram.set_size(data.n_cols, data.n_cols);
+
+  // Only block pairs on or above the diagonal are evaluated; the lower
+  // triangle is filled in by symmetry afterwards.
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t jBegin = block * blockSize;
+    const size_t jEnd = std::min(jBegin + blockSize, (size_t) data.n_cols);
+    for (size_t iBegin = 0; iBegin <= jBegin; iBegin += blockSize)
+    {
+      const size_t iEnd = std::min(iBegin + blockSize, (size_t) data.n_cols);
+      for (size_t j = jBegin; j < jEnd; ++j)
+        for (size_t i = iBegin; i < std::min(iEnd, j + 1); ++i)
+          gram(i, j) = kernel.Evaluate(data.unsafe_col(i),
+                                       data.unsafe_col(j));
+    }
+  }
+
+  // Copy to the lower triangular part of the matrix.
+  for (size_t i = 1; i < data.n_cols; ++i)
+    for (size_t j = 0; j < i; ++j)
+      gram(i, j) = gram(j, i);
+}
+
+inline void GramMatrix<LinearKernel>::Compute(const arma::mat& a,
+                                              const arma::mat& b,
+                                              arma::mat& gram,
+                                              LinearKernel /* kernel */)
+{
+  // The entire kernel matrix is one matrix-matrix product.
+  gram = a.t() * b;
+}
+
+inline void GramMatrix<LinearKernel>::Compute(const arma::mat& data,
+                                              arma::mat& gram,
+                                              LinearKernel kernel)
+{
+  Compute(data, data, gram, kernel);
+}
+
+inline void GramMatrix<PolynomialKernel>::Compute(const arma::mat& a,
+                                                  const arma::mat& b,
+                                                  arma::mat& gram,
+                                                  PolynomialKernel kernel)
+{
+  // All inner products come from one matrix-matrix product; then the offset
+  // and power are applied to cache-sized column blocks in parallel.
+  gram = a.t() * b;
+
+  const size_t blockSize = 64;
+  const size_t numBlocks = (gram.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t jBegin = block * blockSize;
+    const size_t jEnd = std::min(jBegin + blockSize, (size_t) gram.n_cols) - 1;
+    gram.cols(jBegin, jEnd) = arma::pow(gram.cols(jBegin, jEnd) +
+        kernel.Offset(), kernel.Degree());
+  }
+}
+
+inline void GramMatrix<PolynomialKernel>::Compute(const arma::mat& data,
+                                                  arma::mat& gram,
+                                                  PolynomialKernel kernel)
+{
+  Compute(data, data, gram, kernel);
+}
+
+inline void GramMatrix<GaussianKernel>::Compute(const arma::mat& a,
+                                                const arma::mat& b,
+                                                arma::mat& gram,
+                                                GaussianKernel kernel)
+{
+  // Recover all squared distances from one matrix-matrix product via
+  // ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y, then exponentiate cache-sized
+  // column blocks in parallel.
+  const arma::vec aNorms = arma::sum(arma::square(a), 0).t();
+  const arma::rowvec bNorms = arma::sum(arma::square(b), 0);
+
+  gram = a.t() * b;
+
+  const size_t blockSize = 64;
+  const size_t numBlocks = (gram.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t jBegin = block * blockSize;
+    const size_t jEnd = std::min(jBegin + blockSize, (size_t) gram.n_cols) - 1;
+    arma::mat distances = -2.0 * gram.cols(jBegin, jEnd);
+    distances.each_col() += aNorms;
+    distances.each_row() += bNorms.subvec(jBegin, jEnd);
+    // Cancellation can produce slightly negative squared distances; clamp
+    // them so that the kernel never exceeds 1.
+    gram.cols(jBegin, jEnd) = arma::exp(kernel.Gamma() *
+        arma::clamp(distances, 0.0, DBL_MAX));
+  }
+}
+
+inline void GramMatrix<GaussianKernel>::Compute(const arma::mat& data,
+                                                arma::mat& gram,
+                                                GaussianKernel kernel)
+{
+  Compute(data, data, gram, kernel);
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
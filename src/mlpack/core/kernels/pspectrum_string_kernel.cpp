@@ -15,6 +15,8 @@
  */
 #include "pspectrum_string_kernel.hpp"
 
+#include <algorithm>
+
 using namespace std;
 using namespace mlpack;
 using namespace mlpack::kernel;
@@ -31,12 +33,14 @@ mlpack::kernel::PSpectrumStringKernel::PSpectrumStringKernel(
     const size_t p) :
     p(p)
 {
-  // We have to assemble the counts of substrings.  This is not a particularly
-  // fast operation, unfortunately, but it only needs to be done once.
+  // We have to assemble the counts of substrings.  Each string is handled
+  // independently, so the work is parallelized over the strings of each
+  // dataset.
   Log::Info << "Assembling counts of substrings of length " << p << "."
       << std::endl;
 
   // Resize for number of datasets.
+  hashes.resize(datasets.size());
   counts.resize(datasets.size());
 
   for (size_t dataset = 0; dataset < datasets.size(); ++dataset)
@@ -44,44 +48,108 @@ mlpack::kernel::PSpectrumStringKernel::PSpectrumStringKernel(
     const std::vector<std::string>& set = datasets[dataset];
 
     // Resize for number of strings in dataset.
+    hashes[dataset].resize(set.size());
     counts[dataset].resize(set.size());
 
     // Inspect each string in the dataset.
-    for (size_t index = 0; index < set.size(); ++index)
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t index = 0; index < (omp_size_t) set.size(); ++index)
     {
-      // Convenience references.
+      // Convenience reference.
       const std::string& str = set[index];
-      std::map<std::string, int>& mapping = counts[dataset][index];
 
-      size_t start = 0;
-      while ((start + p) <= str.length())
+      // Gather the hashes of every valid substring, then sort them once; this
+      // replaces the per-substring logarithmic map insertions of the old
+      // implementation.
+      std::vector<uint64_t> grams;
+      if (str.length() >= p)
+        grams.reserve(str.length() - p + 1);
+
+      for (size_t start = 0; start + p <= str.length(); ++start)
+      {
+        uint64_t hash;
+        if (HashPGram(str, start, p, hash))
+          grams.push_back(hash);
+      }
+
+      std::sort(grams.begin(), grams.end());
+
+      // Run-length encode the sorted hashes into the parallel hash and count
+      // arrays for this string.
+      size_t distinct = 0;
+      for (size_t i = 0; i < grams.size(); ++i)
+        if (i == 0 || grams[i] != grams[i - 1])
+          ++distinct;
+
+      arma::Col<uint64_t>& strHashes = hashes[dataset][index];
+      arma::Col<int>& strCounts = counts[dataset][index];
+      strHashes.set_size(distinct);
+      strCounts.zeros(distinct);
+
+      size_t j = 0;
+      for (size_t i = 0; i < grams.size(); ++i)
       {
-        string sub = str.substr(start, p);
-
-        // Convert all characters to lowercase.
-        bool invalid = false;
-        for (size_t j = 0; j < p; ++j)
-        {
-          if (!isalnum(sub[j]))
-          {
-            invalid = true;
-            break; // Only consider substrings with alphanumerics.
-          }
-
-          sub[j] = tolower(sub[j]);
-        }
-
-        // Increment position in string.
-        ++start;
-
-        if (!invalid)
-        {
-          // Add to the map.
-          ++mapping[sub];
-        }
+        if (i > 0 && grams[i] != grams[i - 1])
+          ++j;
+
+        strHashes[j] = grams[i];
+        ++strCounts[j];
       }
     }
   }
 
   Log::Info << "Substring extraction complete." << std::endl;
 }
+
+/**
+ * Return the number of times the given length-p substring occurs in the given
+ * string.
+ */
+int mlpack::kernel::PSpectrumStringKernel::Count(
+    const size_t dataset,
+    const size_t index,
+    const std::string& pgram) const
+{
+  uint64_t hash;
+  if (pgram.length() != p || !HashPGram(pgram, 0, p, hash))
+    return 0;
+
+  // The hashes are sorted, so we can binary search for the p-gram.
+  const arma::Col<uint64_t>& strHashes = hashes[dataset][index];
+  const uint64_t* begin = strHashes.memptr();
+  const uint64_t* end = begin + strHashes.n_elem;
+  const uint64_t* pos = std::lower_bound(begin, end, hash);
+
+  if (pos != end && *pos == hash)
+    return counts[dataset][index][pos - begin];
+
+  return 0;
+}
+
+/**
+ * Hash the length-p substring of str starting at the given position.
+ */
+bool mlpack::kernel::PSpectrumStringKernel::HashPGram(const std::string& str,
+                                                      const size_t start,
+                                                      const size_t p,
+                                                      uint64_t& hash)
+{
+  hash = 0;
+  for (size_t j = 0; j < p; ++j)
+  {
+    const unsigned char c = (unsigned char) str[start + j];
+    if (!isalnum(c))
+      return false; // Only consider substrings with alphanumerics.
+
+    // Case-insensitive character code in [0, 36).
+    const uint64_t code = isdigit(c) ? (uint64_t) (c - '0') :
+        (uint64_t) (tolower(c) - 'a') + 10;
+
+    if (p <= 10)
+      hash = (hash << 6) + code; // Exact encoding: 6 bits per character.
+    else
+      hash = hash * 0x9E3779B97F4A7C15ULL + code + 1; // Polynomial hash.
+  }
+
+  return true;
+}
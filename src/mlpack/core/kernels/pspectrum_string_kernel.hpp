@@ -16,7 +16,7 @@
 #ifndef MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 #define MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 
-#include <map>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -54,6 +54,16 @@ namespace kernel {
  * columns back to the strings they represent, and then correctly evaluate the
  * kernel.
  *
+ * Internally, the kernel does not store the substrings themselves.  Each
+ * string is represented by a sorted array of 64-bit hashed p-grams with a
+ * parallel array of counts; counting is parallelized over the strings of each
+ * dataset, and Evaluate() is a linear merge of two sorted arrays.  For p up to
+ * 10, the hash is an exact 6-bit-per-character encoding of the (lowercased,
+ * alphanumeric) substring; for longer substrings a 64-bit polynomial hash is
+ * used, and collisions, while theoretically possible, are vanishingly
+ * unlikely.  The assembled index is serialized with the kernel, so repeated
+ * runs on the same corpus can load a saved kernel instead of recounting.
+ *
  * Unfortunately, not every machine learning method will work with this kernel.
  * Only machine learning methods which do not ever operate on the explicit
  * representation of points can use this kernel.  So, for instance, one cannot
@@ -65,6 +75,12 @@ namespace kernel {
 class PSpectrumStringKernel
 {
  public:
+  /**
+   * Construct an empty PSpectrumStringKernel; this is only useful for loading
+   * a saved kernel with its p-gram index.
+   */
+  PSpectrumStringKernel() : p(0) { /* Nothing to do. */ }
+
   /**
    * Initialize the PSpectrumStringKernel with the given string datasets.  For
    * more information on this, see the general class documentation.
@@ -89,11 +105,32 @@ class PSpectrumStringKernel
   template<typename VecType>
   double Evaluate(const VecType& a, const VecType& b) const;
 
-  //! Access the lists of substrings.
-  const std::vector<std::vector<std::map<std::string, int> > >& Counts() const
+  /**
+   * Return the number of times the given length-p substring occurs in the
+   * given string.  The substring is hashed in the same way as during
+   * counting, so it may contain uppercase characters; a substring containing
+   * non-alphanumeric characters (or of the wrong length) has a count of 0.
+   *
+   * @param dataset Index of the dataset holding the string.
+   * @param index Index of the string in the dataset.
+   * @param pgram Substring of length p to look up.
+   */
+  int Count(const size_t dataset,
+            const size_t index,
+            const std::string& pgram) const;
+
+  //! Access the sorted hashed p-grams of each string.
+  const std::vector<std::vector<arma::Col<uint64_t> > >& Hashes() const
+  { return hashes; }
+  //! Modify the sorted hashed p-grams of each string.
+  std::vector<std::vector<arma::Col<uint64_t> > >& Hashes()
+  { return hashes; }
+
+  //! Access the counts of the hashed p-grams of each string.
+  const std::vector<std::vector<arma::Col<int> > >& Counts() const
   { return counts; }
-  //! Modify the lists of substrings.
-  std::vector<std::vector<std::map<std::string, int> > >& Counts()
+  //! Modify the counts of the hashed p-grams of each string.
+  std::vector<std::vector<arma::Col<int> > >& Counts()
   { return counts; }
 
   //! Access the value of p.
@@ -101,10 +138,37 @@ class PSpectrumStringKernel
   //! Modify the value of p.
   size_t& P() { return p; }
 
+  //! Serialize the kernel, including the assembled p-gram index.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(hashes);
+    ar & BOOST_SERIALIZATION_NVP(counts);
+    ar & BOOST_SERIALIZATION_NVP(p);
+  }
+
  private:
-  //! Mappings of the datasets to counts of substrings.  Such a huge structure
-  //! is not wonderful...
-  std::vector<std::vector<std::map<std::string, int> > > counts;
+  /**
+   * Hash the length-p substring of str starting at the given position,
+   * lowercasing each character.  Returns false if the substring contains any
+   * non-alphanumeric character (such substrings are not counted).
+   *
+   * @param str String to extract the substring from.
+   * @param start Starting position of the substring.
+   * @param p Length of the substring.
+   * @param hash Output hash of the substring.
+   */
+  static bool HashPGram(const std::string& str,
+                        const size_t start,
+                        const size_t p,
+                        uint64_t& hash);
+
+  //! Sorted hashed p-grams of each string in each dataset.
+  std::vector<std::vector<arma::Col<uint64_t> > > hashes;
+
+  //! Counts of the hashed p-grams of each string; counts[d][i][j] is the
+  //! number of occurrences of the p-gram with hash hashes[d][i][j].
+  std::vector<std::vector<arma::Col<int> > > counts;
 
   //! The value of p to use in calculation.
   size_t p;
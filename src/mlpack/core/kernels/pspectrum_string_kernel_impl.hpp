@@ -36,39 +36,37 @@ template<typename VecType>
 double PSpectrumStringKernel::Evaluate(const VecType& a,
                                        const VecType& b) const
 {
-  // Get the map of substrings for the two strings we are interested in.
-  const std::map<std::string, int>& aMap = counts[a[0]][a[1]];
-  const std::map<std::string, int>& bMap = counts[b[0]][b[1]];
+  // Get the hashed p-grams for the two strings we are interested in.
+  const arma::Col<uint64_t>& aHashes = hashes[a[0]][a[1]];
+  const arma::Col<uint64_t>& bHashes = hashes[b[0]][b[1]];
+  const arma::Col<int>& aCounts = counts[a[0]][a[1]];
+  const arma::Col<int>& bCounts = counts[b[0]][b[1]];
 
   double eval = 0;
 
-  // Loop through the two maps (which, when iterated through, are sorted
-  // alphabetically).
-  std::map<std::string, int>::const_iterator aIt = aMap.begin();
-  std::map<std::string, int>::const_iterator bIt = bMap.begin();
-
-  while ((aIt != aMap.end()) && (bIt != bMap.end()))
+  // The hashes of each string are sorted, so the kernel is a linear merge of
+  // the two arrays, accumulating the product of counts wherever they match.
+  size_t i = 0;
+  size_t j = 0;
+  while ((i < aHashes.n_elem) && (j < bHashes.n_elem))
   {
-    // Compare alphabetically (this is how std::map is ordered).
-    int result = (*aIt).first.compare((*bIt).first);
-
-    if (result == 0) // The same substring.
+    if (aHashes[i] == bHashes[j]) // The same substring.
     {
-      eval += ((*aIt).second * (*bIt).second);
+      eval += (aCounts[i] * bCounts[j]);
 
       // Now increment both.
-      ++aIt;
-      ++bIt;
+      ++i;
+      ++j;
     }
-    else if (result > 0)
+    else if (aHashes[i] > bHashes[j])
     {
-      // aIt is "ahead" of bIt (alphabetically); so increment bIt to "catch up".
-      ++bIt;
+      // i is "ahead" of j; so increment j to "catch up".
+      ++j;
     }
     else
     {
-      // bIt is "ahead" of aIt (alphabetically); so increment aIt to "catch up".
-      ++aIt;
+      // j is "ahead" of i; so increment i to "catch up".
+      ++i;
     }
   }
 
@@ -0,0 +1,138 @@
+/**
+ * @file alias_table.hpp
+ *
+ * An alias table for constant-time sampling from a discrete distribution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_ALIAS_TABLE_HPP
+#define MLPACK_CORE_MATH_ALIAS_TABLE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * An alias table (Walker's method, built with Vose's O(n) algorithm) for
+ * sampling from a discrete distribution over n outcomes.  Building the table
+ * costs O(n); afterwards every Random() call costs O(1), as opposed to the
+ * O(n) linear scan over the cumulative distribution.  This pays off whenever
+ * many draws are taken from the same distribution, as when generating long
+ * synthetic sequences.
+ */
+class AliasTable
+{
+ public:
+  //! Create an empty table; Build() must be called before sampling.
+  AliasTable() { /* Nothing to do. */ }
+
+  /**
+   * Create an alias table for the given (possibly unnormalized) weights.
+   *
+   * @param weights Nonnegative weight of each outcome.
+   */
+  AliasTable(const arma::vec& weights) { Build(weights); }
+
+  /**
+   * Build the table for the given (possibly unnormalized) weights, replacing
+   * any previously built table.
+   *
+   * @param weights Nonnegative weight of each outcome.
+   */
+  void Build(const arma::vec& weights)
+  {
+    const size_t n = weights.n_elem;
+    threshold.set_size(n);
+    alias.set_size(n);
+
+    const double total = arma::accu(weights);
+    if (total <= 0.0)
+    {
+      // Degenerate weights; fall back to uniform sampling.
+      threshold.ones();
+      for (size_t i = 0; i < n; ++i)
+        alias[i] = i;
+      return;
+    }
+
+    // Scale the weights so that an outcome with average weight gets exactly
+    // one unit of probability mass.
+    arma::vec scaled = weights * ((double) n / total);
+
+    // Split the outcomes into those with less than one unit of mass and
+    // those with at least one unit; each underfull outcome is then topped up
+    // from an overfull one, which becomes its alias.
+    std::vector<size_t> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (scaled[i] < 1.0)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+      const size_t s = small.back();
+      const size_t l = large.back();
+      small.pop_back();
+
+      threshold[s] = scaled[s];
+      alias[s] = l;
+
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      if (scaled[l] < 1.0)
+      {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Any leftovers hold (up to roundoff) exactly one unit of mass.
+    while (!large.empty())
+    {
+      threshold[large.back()] = 1.0;
+      alias[large.back()] = large.back();
+      large.pop_back();
+    }
+    while (!small.empty())
+    {
+      threshold[small.back()] = 1.0;
+      alias[small.back()] = small.back();
+      small.pop_back();
+    }
+  }
+
+  /**
+   * Draw a random outcome in [0, n) according to the distribution the table
+   * was built for.  This is O(1) per draw.
+   *
+   * @return Index of the sampled outcome.
+   */
+  size_t Random() const
+  {
+    const size_t i = RandInt(0, threshold.n_elem);
+    return (math::Random() < threshold[i]) ? i : alias[i];
+  }
+
+  //! Get the number of outcomes the table was built for.
+  size_t NumOutcomes() const { return threshold.n_elem; }
+
+ private:
+  //! Probability of keeping outcome i when column i is drawn.
+  arma::vec threshold;
+  //! Outcome returned instead when the threshold test fails.
+  arma::Col<size_t> alias;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file co_moment_accumulator.cpp
+ *
+ * Implementation of the CoMomentAccumulator class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "co_moment_accumulator.hpp"
+
+using namespace mlpack;
+using namespace mlpack::math;
+
+CoMomentAccumulator::CoMomentAccumulator(const size_t dimensionality) :
+    count(0.0),
+    mean(arma::zeros<arma::vec>(dimensionality)),
+    coMoment(arma::zeros<arma::mat>(dimensionality, dimensionality))
+{
+  // Nothing to do.
+}
+
+void CoMomentAccumulator::Insert(const arma::vec& point)
+{
+  // Take the dimensionality from the first point if it wasn't specified.
+  if (mean.n_elem == 0)
+  {
+    mean = arma::zeros<arma::vec>(point.n_elem);
+    coMoment = arma::zeros<arma::mat>(point.n_elem, point.n_elem);
+  }
+
+  if (point.n_elem != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "CoMomentAccumulator::Insert(): given point has dimensionality "
+        << point.n_elem << ", but the accumulator has dimensionality "
+        << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Welford's update: center with the old mean on one side and the new mean
+  // on the other, which keeps the co-moment matrix numerically stable.
+  count += 1.0;
+  const arma::vec delta = point - mean;
+  mean += delta / count;
+  coMoment += delta * (point - mean).t();
+}
+
+void CoMomentAccumulator::Insert(const arma::mat& points)
+{
+  for (size_t i = 0; i < points.n_cols; ++i)
+    Insert(arma::vec(points.col(i)));
+}
+
+void CoMomentAccumulator::Merge(const CoMomentAccumulator& other)
+{
+  if (other.count == 0.0)
+    return;
+
+  if (count == 0.0)
+  {
+    count = other.count;
+    mean = other.mean;
+    coMoment = other.coMoment;
+    return;
+  }
+
+  if (other.mean.n_elem != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "CoMomentAccumulator::Merge(): given accumulator has "
+        << "dimensionality " << other.mean.n_elem << ", but this accumulator "
+        << "has dimensionality " << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Chan et al.'s pairwise update.
+  const double totalCount = count + other.count;
+  const arma::vec delta = other.mean - mean;
+
+  coMoment += other.coMoment +
+      (delta * delta.t()) * (count * other.count / totalCount);
+  mean += delta * (other.count / totalCount);
+  count = totalCount;
+}
+
+arma::mat CoMomentAccumulator::Covariance(const size_t normType) const
+{
+  if (normType > 1)
+    throw std::invalid_argument("CoMomentAccumulator::Covariance(): normType "
+        "should be 0 or 1");
+
+  const double norm = (normType == 0) ? count - 1.0 : count;
+  if (norm <= 0.0)
+    return arma::zeros<arma::mat>(mean.n_elem, mean.n_elem);
+
+  return coMoment / norm;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file co_moment_accumulator.hpp
+ *
+ * A streaming, mergeable accumulator of the mean and co-moment matrix of a
+ * set of points, for bounded-memory covariance computation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_CO_MOMENT_ACCUMULATOR_HPP
+#define MLPACK_CORE_MATH_CO_MOMENT_ACCUMULATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A streaming accumulator of the mean and centered co-moment matrix of a set
+ * of points, from which the covariance matrix can be obtained at any time.
+ * Points are inserted one at a time (or a batch at a time) and only the
+ * running mean and the d x d co-moment matrix are kept, so the covariance of
+ * an arbitrarily large dataset can be computed without ever materializing (or
+ * centering) the full data matrix.
+ *
+ * Accumulators are mergeable: two accumulators built over disjoint shards of
+ * a dataset can be combined with Merge(), and the result is identical (up to
+ * floating-point error) to accumulating all points in a single object.  This
+ * makes the class directly usable for multi-threaded or distributed
+ * accumulation---build one accumulator per thread or shard, then merge.
+ *
+ * The updates use the numerically stable Welford/Chan formulas rather than
+ * accumulating raw sums of outer products.
+ */
+class CoMomentAccumulator
+{
+ public:
+  /**
+   * Construct an empty accumulator for points of the given dimensionality.
+   * If the dimensionality is zero, it is taken from the first inserted point.
+   *
+   * @param dimensionality Dimensionality of the points to accumulate.
+   */
+  CoMomentAccumulator(const size_t dimensionality = 0);
+
+  /**
+   * Insert a single point into the accumulator.
+   *
+   * @param point Point to insert.
+   */
+  void Insert(const arma::vec& point);
+
+  /**
+   * Insert each column of the given matrix into the accumulator.
+   *
+   * @param points Matrix whose columns are the points to insert.
+   */
+  void Insert(const arma::mat& points);
+
+  /**
+   * Merge another accumulator into this one, as if every point inserted into
+   * the other accumulator had been inserted into this one.
+   *
+   * @param other Accumulator to merge into this one.
+   */
+  void Merge(const CoMomentAccumulator& other);
+
+  /**
+   * Return the covariance matrix of the accumulated points.
+   *
+   * @param normType Normalization type: 0 means normalize with the number of
+   *     points minus one (the default, as with arma::cov()), and 1 means
+   *     normalize with the number of points.
+   */
+  arma::mat Covariance(const size_t normType = 0) const;
+
+  //! Get the mean of the accumulated points.
+  const arma::vec& Mean() const { return mean; }
+
+  //! Get the number of accumulated points.
+  double Count() const { return count; }
+
+  //! Serialize the accumulator.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(count);
+    ar & BOOST_SERIALIZATION_NVP(mean);
+    ar & BOOST_SERIALIZATION_NVP(coMoment);
+  }
+
+ private:
+  //! The number of accumulated points.
+  double count;
+
+  //! The running mean of the accumulated points.
+  arma::vec mean;
+
+  //! The centered co-moment matrix (sum of outer products of deviations).
+  arma::mat coMoment;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_CO_MOMENT_ACCUMULATOR_HPP
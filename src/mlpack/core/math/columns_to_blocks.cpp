@@ -11,6 +11,8 @@
  */
 #include "columns_to_blocks.hpp"
 
+#include <cstring>
+
 namespace mlpack {
 namespace math {
 
@@ -64,23 +66,24 @@ void ColumnsToBlocks::Transform(const arma::mat& maximalInputs,
               bufSize + cols * colOffset);
   output *= bufValue;
 
-  size_t k = 0;
+  // Each block writes a disjoint region of the output, so the assembly
+  // parallelizes over blocks; every block column is a contiguous run in both
+  // the input column and the output, so it is copied as one bulk move
+  // instead of going through a reshape temporary.
   const size_t maxSize = std::min(rows * cols, (size_t) maximalInputs.n_cols);
-  for (size_t i = 0; i != rows; ++i)
+  #pragma omp parallel for
+  for (omp_size_t k = 0; k < (omp_size_t) maxSize; ++k)
   {
-    for (size_t j = 0; j != cols; ++j)
-    {
-      // Now, copy the elements of the row to the output submatrix.
-      const size_t minRow = bufSize + i * rowOffset;
-      const size_t minCol = bufSize + j * colOffset;
-      const size_t maxRow = i * rowOffset + blockHeight;
-      const size_t maxCol = j * colOffset + blockWidth;
+    const size_t i = k / cols;
+    const size_t j = k % cols;
+    const size_t minRow = bufSize + i * rowOffset;
+    const size_t minCol = bufSize + j * colOffset;
 
-      output.submat(minRow, minCol, maxRow, maxCol) =
-          arma::reshape(maximalInputs.col(k++), blockHeight, blockWidth);
-
-      if (k >= maxSize)
-        break;
+    const double* src = maximalInputs.colptr(k);
+    for (size_t c = 0; c < blockWidth; ++c)
+    {
+      std::memcpy(output.colptr(minCol + c) + minRow, src + c * blockHeight,
+          blockHeight * sizeof(double));
     }
   }
 
@@ -13,6 +13,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/random.hpp>
 
+#include <cstring>
+
 using namespace mlpack;
 using namespace math;
 
@@ -48,6 +50,21 @@ void mlpack::math::Center(const arma::mat& x, arma::mat& xCentered)
   xCentered = x - arma::repmat(rowMean, 1, x.n_cols);
 }
 
+/**
+ * Center a matrix in-place, subtracting the mean over the columns from each
+ * column of the matrix.
+ */
+void mlpack::math::Center(arma::mat& x)
+{
+  // Get the mean of the elements in each row.
+  const arma::vec rowMean = arma::sum(x, 1) / x.n_cols;
+
+  // Each column is updated independently, so this parallelizes trivially.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) x.n_cols; ++i)
+    x.col(i) -= rowMean;
+}
+
 /**
  * Whitens a matrix using the singular value decomposition of the covariance
  * matrix. Whitening means the covariance matrix of the result is the identity
@@ -215,6 +232,60 @@ void mlpack::math::RemoveRows(const arma::mat& input,
   }
 }
 
+/**
+ * Remove a certain set of rows from a matrix in-place, sliding the kept rows
+ * of each column upwards in a single pass over the existing memory.
+ */
+void mlpack::math::RemoveRowsInPlace(arma::mat& input,
+                                     const std::vector<size_t>& rowsToRemove)
+{
+  const size_t nRemove = rowsToRemove.size();
+  const size_t nKeep = input.n_rows - nRemove;
+
+  if (nRemove == 0)
+    return; // Nothing to do.
+
+  if (nKeep == 0)
+  {
+    input.set_size(0, input.n_cols);
+    return;
+  }
+
+  // Compact each column independently: every contiguous run of kept rows is
+  // slid upwards with one memmove().  Since the destination of a run is never
+  // past its source, the moves can be done in a single forward pass.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    double* col = input.colptr(i);
+
+    size_t destRow = rowsToRemove[0];
+    size_t removeInd = 0;
+    while (removeInd < nRemove)
+    {
+      // The kept run starts past the current row to remove and ends before
+      // the next one (or at the end of the column).
+      const size_t runBegin = rowsToRemove[removeInd] + 1;
+      const size_t runEnd = (removeInd + 1 < nRemove) ?
+          rowsToRemove[removeInd + 1] : input.n_rows;
+
+      if (runEnd > runBegin)
+      {
+        std::memmove(col + destRow, col + runBegin,
+            (runEnd - runBegin) * sizeof(double));
+        destRow += runEnd - runBegin;
+      }
+
+      removeInd++;
+    }
+  }
+
+  // Armadillo cannot shrink an allocation in-place, so finalize with a single
+  // bulk shrink; resize() keeps the top-left submatrix, which now holds
+  // exactly the compacted rows.
+  input.resize(nKeep, input.n_cols);
+}
+
 void mlpack::math::Svec(const arma::mat& input, arma::vec& output)
 {
   const size_t n = input.n_rows;
@@ -36,6 +36,16 @@ void VectorPower(arma::vec& vec, const double power);
  */
 void Center(const arma::mat& x, arma::mat& xCentered);
 
+/**
+ * Center a matrix in-place, subtracting the mean over the columns (a column
+ * vector) from each column of the matrix.  Unlike the two-argument overload,
+ * this does not allocate a second copy of the matrix; the columns are updated
+ * in a single parallel pass.
+ *
+ * @param x Matrix to center in-place.
+ */
+void Center(arma::mat& x);
+
 /**
  * Whitens a matrix using the singular value decomposition of the covariance
  * matrix. Whitening means the covariance matrix of the result is the identity
@@ -81,6 +91,19 @@ void RemoveRows(const arma::mat& input,
                 const std::vector<size_t>& rowsToRemove,
                 arma::mat& output);
 
+/**
+ * Remove a certain set of rows from a matrix in-place.  The kept rows of each
+ * column are slid upwards in a single parallel pass over the memory the matrix
+ * already owns, so there is never a second full-size copy of the input; only
+ * the final compacted matrix is allocated when the matrix is shrunk.
+ *
+ * @param input Matrix to remove rows from.
+ * @param rowsToRemove Vector containing indices of rows to be removed (should
+ *     be sorted in ascending order).
+ */
+void RemoveRowsInPlace(arma::mat& input,
+                       const std::vector<size_t>& rowsToRemove);
+
 /**
  * Upper triangular representation of a symmetric matrix, scaled such that,
  * dot(Svec(A), Svec(B)) == dot(A, B) for symmetric A, B. Specifically,
@@ -31,6 +31,21 @@ T LogAdd(T x, T y);
 template<typename T>
 typename T::elem_type AccuLog(const T& x);
 
+/**
+ * Compute the log of the sum of exponentials of each column (dim = 0) or
+ * each row (dim = 1) of a matrix of log values.  Each slice is reduced with
+ * a two-pass implementation (maximum first, then the sum of shifted
+ * exponentials) built on vectorized Armadillo expressions, and the
+ * independent slices are processed in parallel; row-wise reductions stream
+ * over blocks of columns so the matrix is read in column order.
+ *
+ * @param x matrix of log values
+ * @param result Vector which will hold the log-sum-exp of each slice.
+ * @param dim Dimension to reduce over; 0 reduces each column, 1 each row.
+ */
+template<typename T, typename VecType>
+void LogSumExp(const T& x, VecType& result, const size_t dim = 0);
+
 } // namespace math
 } // namespace mlpack
 
@@ -47,7 +47,10 @@ T LogAdd(T x, T y)
 }
 
 /**
- * Sum a vector of log values.
+ * Sum a vector of log values.  Instead of chaining scalar LogAdd() calls,
+ * the maximum is found first and the shifted exponentials are then summed
+ * with one vectorized pass, which is both faster and at least as accurate
+ * (every element is shifted by the same maximum).
  *
  * @param x vector of log values
  * @return log(e^x0 + e^x1 + ...)
@@ -55,15 +58,95 @@ T LogAdd(T x, T y)
 template<typename T>
 typename T::elem_type AccuLog(const T& x)
 {
-  typename T::elem_type sum =
-      -std::numeric_limits<typename T::elem_type>::infinity();
+  typedef typename T::elem_type ElemType;
 
-  for (size_t i = 0; i < x.n_elem; ++i)
+  if (x.n_elem == 0)
+    return -std::numeric_limits<ElemType>::infinity();
+
+  const ElemType maxVal = x.max();
+  if (maxVal == -std::numeric_limits<ElemType>::infinity())
+    return maxVal;
+
+  return maxVal + std::log(arma::accu(arma::exp(x - maxVal)));
+}
+
+/**
+ * Compute the log of the sum of exponentials of each column (dim = 0) or
+ * each row (dim = 1) of a matrix of log values.
+ *
+ * @param x matrix of log values
+ * @param result Vector which will hold the log-sum-exp of each slice.
+ * @param dim Dimension to reduce over; 0 reduces each column, 1 each row.
+ */
+template<typename T, typename VecType>
+void LogSumExp(const T& x, VecType& result, const size_t dim)
+{
+  typedef typename T::elem_type ElemType;
+  const ElemType negInf = -std::numeric_limits<ElemType>::infinity();
+
+  if (x.n_elem == 0)
   {
-    sum = LogAdd(sum, x[i]);
+    result.set_size((dim == 0) ? x.n_cols : x.n_rows);
+    result.fill(negInf);
+    return;
   }
 
-  return sum;
+  if (dim == 0)
+  {
+    // Column-wise reduction: every column is an independent two-pass
+    // log-sum-exp over contiguous memory.
+    result.set_size(x.n_cols);
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) x.n_cols; ++c)
+    {
+      const ElemType maxVal = x.col(c).max();
+      if (maxVal == negInf)
+      {
+        result[c] = negInf;
+      }
+      else
+      {
+        result[c] = maxVal +
+            std::log(arma::accu(arma::exp(x.col(c) - maxVal)));
+      }
+    }
+  }
+  else
+  {
+    // Row-wise reduction: the maxima are found in one pass, then the shifted
+    // exponentials are accumulated while streaming over blocks of columns,
+    // so the matrix is read in column order and the per-block temporaries
+    // stay small.
+    const arma::Col<ElemType> maxVals = arma::max(x, 1);
+    arma::Col<ElemType> sums(x.n_rows, arma::fill::zeros);
+
+    const size_t blockSize = 64;
+    const size_t blocks = (x.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel
+    {
+      arma::Col<ElemType> localSums(x.n_rows, arma::fill::zeros);
+
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+      {
+        const size_t begin = (size_t) b * blockSize;
+        const size_t end = std::min(x.n_cols, begin + blockSize) - 1;
+        localSums += arma::sum(
+            arma::exp(x.cols(begin, end).each_col() - maxVals), 1);
+      }
+
+      #pragma omp critical (LogSumExp)
+      sums += localSums;
+    }
+
+    // Rows whose maximum is -inf produced NaN sums (from exp(-inf + inf));
+    // their log-sum-exp is -inf.
+    result.set_size(x.n_rows);
+    for (size_t r = 0; r < x.n_rows; ++r)
+      result[r] = (maxVals[r] == negInf) ? negInf :
+          maxVals[r] + std::log(sums[r]);
+  }
 }
 
 } // namespace math
@@ -0,0 +1,155 @@
+/**
+ * @file patch_extraction.cpp
+ *
+ * Implementation of strided patch extraction and its inverse scatter.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "patch_extraction.hpp"
+
+#include <cstring>
+
+namespace mlpack {
+namespace math {
+
+void ExtractPatches(const arma::mat& images,
+                    const size_t imageHeight,
+                    const size_t imageWidth,
+                    const size_t patchHeight,
+                    const size_t patchWidth,
+                    const size_t strideRow,
+                    const size_t strideCol,
+                    arma::mat& patches)
+{
+  if (images.n_rows != imageHeight * imageWidth)
+  {
+    throw std::invalid_argument("ExtractPatches(): images.n_rows must equal "
+        "imageHeight * imageWidth!");
+  }
+  if (patchHeight > imageHeight || patchWidth > imageWidth)
+  {
+    throw std::invalid_argument("ExtractPatches(): patch size cannot exceed "
+        "the image size!");
+  }
+  if (strideRow == 0 || strideCol == 0)
+  {
+    throw std::invalid_argument("ExtractPatches(): strides must be "
+        "positive!");
+  }
+
+  const size_t patchRows = (imageHeight - patchHeight) / strideRow + 1;
+  const size_t patchCols = (imageWidth - patchWidth) / strideCol + 1;
+  const size_t patchesPerImage = patchRows * patchCols;
+
+  patches.set_size(patchHeight * patchWidth,
+      patchesPerImage * images.n_cols);
+
+  // Every output patch is independent, so the gather parallelizes over all
+  // patches of all images at once.  A patch is patchWidth contiguous runs of
+  // patchHeight elements inside the image column; each run is one memcpy.
+  #pragma omp parallel for
+  for (omp_size_t p = 0; p < (omp_size_t) patches.n_cols; ++p)
+  {
+    const size_t image = p / patchesPerImage;
+    const size_t patch = p % patchesPerImage;
+    const size_t originRow = (patch % patchRows) * strideRow;
+    const size_t originCol = (patch / patchRows) * strideCol;
+
+    const double* imagePtr = images.colptr(image) +
+        originCol * imageHeight + originRow;
+    double* patchPtr = patches.colptr(p);
+
+    for (size_t c = 0; c < patchWidth; ++c)
+    {
+      std::memcpy(patchPtr + c * patchHeight, imagePtr + c * imageHeight,
+          patchHeight * sizeof(double));
+    }
+  }
+}
+
+void ScatterPatches(const arma::mat& patches,
+                    const size_t imageHeight,
+                    const size_t imageWidth,
+                    const size_t patchHeight,
+                    const size_t patchWidth,
+                    const size_t strideRow,
+                    const size_t strideCol,
+                    arma::mat& images)
+{
+  if (patches.n_rows != patchHeight * patchWidth)
+  {
+    throw std::invalid_argument("ScatterPatches(): patches.n_rows must equal "
+        "patchHeight * patchWidth!");
+  }
+  if (patchHeight > imageHeight || patchWidth > imageWidth)
+  {
+    throw std::invalid_argument("ScatterPatches(): patch size cannot exceed "
+        "the image size!");
+  }
+  if (strideRow == 0 || strideCol == 0)
+  {
+    throw std::invalid_argument("ScatterPatches(): strides must be "
+        "positive!");
+  }
+
+  const size_t patchRows = (imageHeight - patchHeight) / strideRow + 1;
+  const size_t patchCols = (imageWidth - patchWidth) / strideCol + 1;
+  const size_t patchesPerImage = patchRows * patchCols;
+
+  if (patches.n_cols % patchesPerImage != 0)
+  {
+    throw std::invalid_argument("ScatterPatches(): number of patches does "
+        "not match the patch grid of the given geometry!");
+  }
+
+  const size_t numImages = patches.n_cols / patchesPerImage;
+  images.zeros(imageHeight * imageWidth, numImages);
+
+  // The per-pixel overlap counts are the same for every image, so compute
+  // them once up front.
+  arma::vec counts(imageHeight * imageWidth, arma::fill::zeros);
+  for (size_t patch = 0; patch < patchesPerImage; ++patch)
+  {
+    const size_t originRow = (patch % patchRows) * strideRow;
+    const size_t originCol = (patch / patchRows) * strideCol;
+    for (size_t c = 0; c < patchWidth; ++c)
+    {
+      counts.subvec((originCol + c) * imageHeight + originRow,
+          (originCol + c) * imageHeight + originRow + patchHeight - 1) += 1.0;
+    }
+  }
+  // Avoid dividing by zero on uncovered pixels; they stay zero.
+  counts.replace(0.0, 1.0);
+
+  // Each image's patches only touch its own column, so the accumulation
+  // parallelizes over images without synchronization.
+  #pragma omp parallel for
+  for (omp_size_t image = 0; image < (omp_size_t) numImages; ++image)
+  {
+    double* imagePtr = images.colptr(image);
+
+    for (size_t patch = 0; patch < patchesPerImage; ++patch)
+    {
+      const size_t originRow = (patch % patchRows) * strideRow;
+      const size_t originCol = (patch / patchRows) * strideCol;
+      const double* patchPtr =
+          patches.colptr(image * patchesPerImage + patch);
+
+      for (size_t c = 0; c < patchWidth; ++c)
+      {
+        double* dest = imagePtr + (originCol + c) * imageHeight + originRow;
+        const double* src = patchPtr + c * patchHeight;
+        for (size_t r = 0; r < patchHeight; ++r)
+          dest[r] += src[r];
+      }
+    }
+
+    images.col(image) /= counts;
+  }
+}
+
+} // namespace math
+} // namespace mlpack
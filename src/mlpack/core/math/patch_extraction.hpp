@@ -0,0 +1,82 @@
+/**
+ * @file patch_extraction.hpp
+ *
+ * Strided extraction of image patches into column-major batches, and the
+ * inverse scatter.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_PATCH_EXTRACTION_HPP
+#define MLPACK_CORE_MATH_PATCH_EXTRACTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Extract all patches of size (patchHeight x patchWidth) from a batch of
+ * column-major images, sliding with the given strides.  Each column of
+ * `images` holds one image of size (imageHeight x imageWidth), stored
+ * column-major, as the rest of the library lays out flattened images.  Each
+ * column of `patches` receives one flattened patch; the patches of an image
+ * are ordered column-major over the patch grid, and images are processed in
+ * order, so patch p of image i lands in column (i * patchesPerImage + p).
+ *
+ * Every patch column is gathered as patchWidth contiguous runs of
+ * patchHeight elements, so the copies are bulk memory moves rather than
+ * per-element loops, and the patches are extracted in parallel.
+ *
+ * @param images Input images, one flattened column-major image per column.
+ * @param imageHeight Height of each input image.
+ * @param imageWidth Width of each input image.
+ * @param patchHeight Height of the patches to extract.
+ * @param patchWidth Width of the patches to extract.
+ * @param strideRow Vertical stride between patch origins.
+ * @param strideCol Horizontal stride between patch origins.
+ * @param patches Matrix to store the extracted patches in.
+ */
+void ExtractPatches(const arma::mat& images,
+                    const size_t imageHeight,
+                    const size_t imageWidth,
+                    const size_t patchHeight,
+                    const size_t patchWidth,
+                    const size_t strideRow,
+                    const size_t strideCol,
+                    arma::mat& patches);
+
+/**
+ * The inverse of ExtractPatches(): scatter a batch of patches back into
+ * images, averaging wherever patches overlap.  The patches must be laid out
+ * exactly as ExtractPatches() produces them for the same geometry.  Pixels
+ * not covered by any patch (possible when the strides do not tile the image)
+ * are set to zero.
+ *
+ * The scatter is parallelized over images, since each image's patches only
+ * write into its own column.
+ *
+ * @param patches Input patches, as produced by ExtractPatches().
+ * @param imageHeight Height of each output image.
+ * @param imageWidth Width of each output image.
+ * @param patchHeight Height of the patches.
+ * @param patchWidth Width of the patches.
+ * @param strideRow Vertical stride between patch origins.
+ * @param strideCol Horizontal stride between patch origins.
+ * @param images Matrix to store the reassembled images in.
+ */
+void ScatterPatches(const arma::mat& patches,
+                    const size_t imageHeight,
+                    const size_t imageWidth,
+                    const size_t patchHeight,
+                    const size_t patchWidth,
+                    const size_t strideRow,
+                    const size_t strideCol,
+                    arma::mat& images);
+
+} // namespace math
+} // namespace mlpack
+
+#endif
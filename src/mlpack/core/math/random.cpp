@@ -8,18 +8,23 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <cstdint>
 #include <random>
 #include <mlpack/mlpack_export.hpp>
 
 namespace mlpack {
 namespace math {
 
-// Global random object.
-MLPACK_EXPORT std::mt19937 randGen;
+// Global random object; each thread has its own stream.
+MLPACK_EXPORT thread_local std::mt19937 randGen;
 // Global uniform distribution.
-MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
+MLPACK_EXPORT thread_local std::uniform_real_distribution<>
+    randUniformDist(0.0, 1.0);
 // Global normal distribution.
-MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+MLPACK_EXPORT thread_local std::normal_distribution<>
+    randNormalDist(0.0, 1.0);
+// Base seed that RandomStream instances are derived from.
+MLPACK_EXPORT uint64_t randBaseSeed = 0;
 
 } // namespace math
 } // namespace mlpack
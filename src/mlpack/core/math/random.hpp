@@ -21,19 +21,30 @@ namespace math /** Miscellaneous math routines. */ {
 /**
  * MLPACK_EXPORT is required for global variables; it exports the symbols
  * correctly on Windows.
+ *
+ * The generators are thread_local, so each thread draws from its own stream;
+ * this makes the random functions below safe to call from inside OpenMP
+ * parallel regions (e.g. when trees of a random forest are built in
+ * parallel).
  */
 
 // Global random object.
-extern MLPACK_EXPORT std::mt19937 randGen;
+extern MLPACK_EXPORT thread_local std::mt19937 randGen;
 // Global uniform distribution.
-extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
+extern MLPACK_EXPORT thread_local std::uniform_real_distribution<>
+    randUniformDist;
 // Global normal distribution.
-extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+extern MLPACK_EXPORT thread_local std::normal_distribution<> randNormalDist;
+// Base seed that RandomStream instances are derived from; set by
+// RandomSeed().
+extern MLPACK_EXPORT uint64_t randBaseSeed;
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
  * number generator, but a size_t is taken as a parameter for API consistency.
+ * Since the generators are thread_local, this seeds the stream of the calling
+ * thread only.
  *
  * @param seed Seed for the random number generator.
  */
@@ -41,6 +52,7 @@ inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
     randGen.seed((uint32_t) seed);
+    randBaseSeed = (uint64_t) seed;
     srand((unsigned int) seed);
     arma::arma_rng::set_seed(seed);
   #else
@@ -129,6 +141,131 @@ inline double RandNormal(const double mean, const double variance)
   return variance * randNormalDist(randGen) + mean;
 }
 
+/**
+ * A cheap counter-based random number generator whose stream is derived only
+ * from the global seed (set by RandomSeed()) and the caller-chosen stream
+ * identifiers.  Because the stream does not depend on which thread draws from
+ * it or on how many threads exist, parallel loops can create one stream per
+ * work item (one per tree, per point, per column, ...) and produce results
+ * that are reproducible regardless of the thread count:
+ *
+ * @code
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < n; ++i)
+ * {
+ *   math::RandomStream stream(i);
+ *   assignments[i] = stream.RandInt(clusters);
+ * }
+ * @endcode
+ *
+ * The generator is SplitMix64: construction and each draw are a handful of
+ * arithmetic instructions and the state is a single 64-bit counter, so
+ * creating a stream per work item is essentially free.
+ */
+class RandomStream
+{
+ public:
+  /**
+   * Create a stream derived from the global seed and the given identifiers.
+   * Streams with different identifiers are statistically independent; the
+   * optional second identifier lets a call site that already used one
+   * identifier (say, an invocation counter) derive sub-streams (say, one per
+   * column) without collisions.
+   *
+   * @param streamId Identifier of this stream.
+   * @param subStreamId Optional sub-stream identifier.
+   */
+  explicit RandomStream(const uint64_t streamId,
+                        const uint64_t subStreamId = 0) :
+      haveSpare(false),
+      spare(0.0)
+  {
+    // Decorrelate the seed and the identifiers before mixing, so consecutive
+    // stream ids do not give correlated initial states.
+    state = Mix(randBaseSeed + 0x9e3779b97f4a7c15ULL * (streamId + 1));
+    state = Mix(state + 0x9e3779b97f4a7c15ULL * (subStreamId + 1));
+  }
+
+  //! Generate a uniform random number in [0, 1).
+  double Random()
+  {
+    // 53 random bits into the mantissa.
+    return (double) (Next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  //! Generate a uniform random number in [lo, hi).
+  double Random(const double lo, const double hi)
+  {
+    return lo + (hi - lo) * Random();
+  }
+
+  //! Generate a uniform random integer in [0, hiExclusive).
+  int RandInt(const int hiExclusive)
+  {
+    return (int) std::floor((double) hiExclusive * Random());
+  }
+
+  //! Generate a uniform random integer in [lo, hiExclusive).
+  int RandInt(const int lo, const int hiExclusive)
+  {
+    return lo + (int) std::floor((double) (hiExclusive - lo) * Random());
+  }
+
+  //! Generate a normally distributed random number with mean 0 and variance 1.
+  double RandNormal()
+  {
+    // Box-Muller transform; each transform yields two values, so cache the
+    // second one for the next call.
+    if (haveSpare)
+    {
+      haveSpare = false;
+      return spare;
+    }
+
+    double u;
+    do
+    {
+      u = Random();
+    } while (u == 0.0);
+    const double v = Random();
+
+    const double radius = std::sqrt(-2.0 * std::log(u));
+    haveSpare = true;
+    spare = radius * std::sin(2.0 * M_PI * v);
+    return radius * std::cos(2.0 * M_PI * v);
+  }
+
+  //! Generate a normally distributed random number with the given mean and
+  //! variance.
+  double RandNormal(const double mean, const double variance)
+  {
+    return variance * RandNormal() + mean;
+  }
+
+ private:
+  //! The SplitMix64 output function.
+  static uint64_t Mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  //! Advance the counter and produce the next 64 random bits.
+  uint64_t Next()
+  {
+    state += 0x9e3779b97f4a7c15ULL;
+    return Mix(state);
+  }
+
+  //! The stream's counter.
+  uint64_t state;
+  //! Whether spare holds a cached normal deviate.
+  bool haveSpare;
+  //! The cached second output of the Box-Muller transform.
+  double spare;
+};
+
 /**
  * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
  * [loInclusive, hiExclusive).
@@ -0,0 +1,57 @@
+/**
+ * @file sparse_builder.hpp
+ * @author Ryan Curtin
+ *
+ * Parallel construction of a CSC sparse matrix from unsorted coordinate
+ * (COO) triplets.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SPARSE_BUILDER_HPP
+#define MLPACK_CORE_MATH_SPARSE_BUILDER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Build a sparse matrix from unsorted coordinate triplets in parallel.
+ *
+ * Armadillo's batch-insertion constructor sorts the triplets with a single
+ * comparison sort on one thread, which dominates ingestion time for large
+ * triplet logs.  This builder instead assembles the CSC arrays directly: a
+ * parallel counting sort scatters the triplets into their columns, the rows
+ * of each column are then sorted independently in parallel, duplicate
+ * locations are merged by summing their values, and the resulting row
+ * indices, column pointers and values are handed to Armadillo's CSC
+ * constructor without any further sorting.
+ *
+ * The locations matrix follows the batch-insertion convention: row 0 holds
+ * row indices and row 1 holds column indices.  Unlike the batch-insertion
+ * constructor, duplicate locations are always allowed; their values are
+ * summed.
+ *
+ * @param locations 2 x n matrix of (row, column) coordinates.
+ * @param values Vector of n values, one per coordinate.
+ * @param nRows Number of rows of the matrix to build.
+ * @param nCols Number of columns of the matrix to build.
+ * @param output Sparse matrix to build.
+ */
+template<typename eT>
+void BuildSparse(const arma::umat& locations,
+                 const arma::Col<eT>& values,
+                 const size_t nRows,
+                 const size_t nCols,
+                 arma::SpMat<eT>& output);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_builder_impl.hpp"
+
+#endif // MLPACK_CORE_MATH_SPARSE_BUILDER_HPP
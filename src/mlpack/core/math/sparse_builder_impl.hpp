@@ -0,0 +1,196 @@
+/**
+ * @file sparse_builder_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the parallel COO-to-CSC sparse matrix builder.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SPARSE_BUILDER_IMPL_HPP
+#define MLPACK_CORE_MATH_SPARSE_BUILDER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sparse_builder.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace math {
+
+template<typename eT>
+void BuildSparse(const arma::umat& locations,
+                 const arma::Col<eT>& values,
+                 const size_t nRows,
+                 const size_t nCols,
+                 arma::SpMat<eT>& output)
+{
+  if (locations.n_rows != 2)
+  {
+    Log::Fatal << "BuildSparse(): locations matrix must have two rows (row "
+        << "indices and column indices)!" << std::endl;
+  }
+
+  if (locations.n_cols != values.n_elem)
+  {
+    Log::Fatal << "BuildSparse(): number of locations (" << locations.n_cols
+        << ") does not match number of values (" << values.n_elem << ")!"
+        << std::endl;
+  }
+
+  const size_t n = values.n_elem;
+  if (n == 0)
+  {
+    output.zeros(nRows, nCols);
+    return;
+  }
+
+  if (max(locations.row(0)) >= nRows || max(locations.row(1)) >= nCols)
+  {
+    Log::Fatal << "BuildSparse(): a location lies outside of the " << nRows
+        << " x " << nCols << " matrix!" << std::endl;
+  }
+
+#ifdef HAS_OPENMP
+  const size_t threads = (size_t) omp_get_max_threads();
+#else
+  const size_t threads = 1;
+#endif
+  const size_t chunk = (n + threads - 1) / threads;
+
+  // First counting-sort pass: each thread histograms the columns of its own
+  // contiguous chunk of triplets.
+  std::vector<std::vector<size_t>> counts(threads,
+      std::vector<size_t>(nCols, 0));
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    const size_t begin = (size_t) t * chunk;
+    const size_t end = std::min(n, begin + chunk);
+    std::vector<size_t>& localCounts = counts[t];
+    for (size_t i = begin; i < end; ++i)
+      ++localCounts[locations(1, i)];
+  }
+
+  // Turn the histograms into scatter offsets: after this loop, counts[t][c]
+  // is the position where thread t writes its first triplet of column c, and
+  // the ranges of all the threads concatenate into contiguous columns.
+  size_t total = 0;
+  for (size_t c = 0; c < nCols; ++c)
+  {
+    for (size_t t = 0; t < threads; ++t)
+    {
+      const size_t count = counts[t][c];
+      counts[t][c] = total;
+      total += count;
+    }
+  }
+
+  // Thread 0 writes first inside every column, so its offsets are the column
+  // boundaries; they must be saved before the scatter advances them.
+  arma::uvec colPtr(nCols + 1);
+  for (size_t c = 0; c < nCols; ++c)
+    colPtr[c] = counts[0][c];
+  colPtr[nCols] = n;
+
+  // Scatter the triplets into their columns.  Each triplet lands in the range
+  // reserved for its chunk's thread, so no two threads write the same slot.
+  arma::uvec sortedRows(n);
+  arma::Col<eT> sortedValues(n);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    const size_t begin = (size_t) t * chunk;
+    const size_t end = std::min(n, begin + chunk);
+    std::vector<size_t>& offsets = counts[t];
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t dest = offsets[locations(1, i)]++;
+      sortedRows[dest] = locations(0, i);
+      sortedValues[dest] = values[i];
+    }
+  }
+
+  // Sort the rows of each column and merge duplicate locations by summing
+  // their values.  Columns are independent, so this parallelizes over them.
+  arma::uvec mergedCounts(nCols);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) nCols; ++c)
+  {
+    const size_t begin = colPtr[c];
+    const size_t end = colPtr[c + 1];
+    if (begin == end)
+    {
+      mergedCounts[c] = 0;
+      continue;
+    }
+
+    std::vector<std::pair<arma::uword, eT>> entries(end - begin);
+    for (size_t i = begin; i < end; ++i)
+      entries[i - begin] = std::make_pair(sortedRows[i], sortedValues[i]);
+    std::sort(entries.begin(), entries.end(),
+        [](const std::pair<arma::uword, eT>& a,
+           const std::pair<arma::uword, eT>& b)
+        { return a.first < b.first; });
+
+    // Compact the sorted entries back into the column range in place.
+    size_t out = begin;
+    sortedRows[out] = entries[0].first;
+    sortedValues[out] = entries[0].second;
+    for (size_t i = 1; i < entries.size(); ++i)
+    {
+      if (entries[i].first == sortedRows[out])
+      {
+        sortedValues[out] += entries[i].second;
+      }
+      else
+      {
+        ++out;
+        sortedRows[out] = entries[i].first;
+        sortedValues[out] = entries[i].second;
+      }
+    }
+
+    mergedCounts[c] = out + 1 - begin;
+  }
+
+  // Build the final column pointers, then gather each column's merged run
+  // into the dense CSC arrays.
+  arma::uvec finalColPtr(nCols + 1);
+  finalColPtr[0] = 0;
+  for (size_t c = 0; c < nCols; ++c)
+    finalColPtr[c + 1] = finalColPtr[c] + mergedCounts[c];
+
+  const size_t nonzeros = finalColPtr[nCols];
+  arma::uvec rowIndices(nonzeros);
+  arma::Col<eT> finalValues(nonzeros);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) nCols; ++c)
+  {
+    const size_t src = colPtr[c];
+    const size_t dest = finalColPtr[c];
+    for (size_t i = 0; i < mergedCounts[c]; ++i)
+    {
+      rowIndices[dest + i] = sortedRows[src + i];
+      finalValues[dest + i] = sortedValues[src + i];
+    }
+  }
+
+  // The arrays are already valid CSC, so Armadillo does not sort anything
+  // here.
+  output = arma::SpMat<eT>(rowIndices, finalColPtr, finalValues, nRows,
+      nCols);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_SPARSE_BUILDER_IMPL_HPP
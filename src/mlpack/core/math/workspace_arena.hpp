@@ -0,0 +1,106 @@
+/**
+ * @file workspace_arena.hpp
+ *
+ * A reusable slab of memory from which aliased matrices can be drawn, so that
+ * repeated passes over a fixed computation (such as the forward and backward
+ * passes of a neural network) do not re-allocate their temporaries each time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_WORKSPACE_ARENA_HPP
+#define MLPACK_CORE_MATH_WORKSPACE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <new>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A simple arena allocator for matrix workspaces.  Usage is two-phase: first
+ * reserve space for every matrix that should live in the arena with
+ * Reserve(), then call Commit() to size the slab, and finally repoint each
+ * matrix into the slab with Alias().  The aliases are non-strict, so a matrix
+ * that is later resized simply detaches from the arena and falls back to a
+ * normal allocation; this keeps the arena safe when shapes change (e.g. a
+ * smaller final mini-batch).
+ *
+ * Reset() discards the reservations but keeps the slab, so re-arming for new
+ * shapes reuses the existing allocation whenever it is large enough.
+ *
+ * @tparam eT Element type of the matrices drawn from the arena.
+ */
+template<typename eT = double>
+class WorkspaceArena
+{
+ public:
+  //! Construct an empty arena.
+  WorkspaceArena() : total(0) { }
+
+  //! Discard all reservations.  The slab itself is kept for reuse.
+  void Reset() { total = 0; }
+
+  /**
+   * Reserve room for a (rows x cols) matrix, returning the element offset at
+   * which the matrix will live once Commit() has been called.
+   */
+  size_t Reserve(const size_t rows, const size_t cols)
+  {
+    const size_t offset = total;
+    total += rows * cols;
+    return offset;
+  }
+
+  //! Size the slab to cover every reservation.  The slab only ever grows.
+  void Commit()
+  {
+    // Never let the slab use Armadillo's in-object preallocated storage; that
+    // storage moves with the object, which would silently invalidate aliases.
+    const size_t needed = std::max(total,
+        (size_t) (arma::arma_config::mat_prealloc + 1));
+    if (slab.n_elem < needed)
+      slab.set_size(needed);
+  }
+
+  /**
+   * Repoint the given matrix at its reserved region of the slab, as a
+   * non-strict alias.  The previous contents of the matrix are copied into
+   * the slab, so callers that still need them (e.g. activations consumed by
+   * a later gradient pass) are unaffected by the switch.
+   *
+   * @param matrix Matrix to place into the arena.
+   * @param offset Offset returned by the corresponding Reserve() call.
+   * @param rows Number of rows (as passed to Reserve()).
+   * @param cols Number of columns (as passed to Reserve()).
+   */
+  void Alias(arma::Mat<eT>& matrix,
+             const size_t offset,
+             const size_t rows,
+             const size_t cols)
+  {
+    const arma::Mat<eT> contents(std::move(matrix));
+
+    matrix.~Mat();
+    new (&matrix) arma::Mat<eT>(slab.memptr() + offset, rows, cols, false,
+        false);
+    matrix = contents;
+  }
+
+  //! Get the total number of elements reserved so far.
+  size_t Size() const { return total; }
+
+ private:
+  //! The backing storage all aliases point into.
+  arma::Col<eT> slab;
+  //! Number of elements reserved so far.
+  size_t total;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file batch_distance.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the BatchDistance class, which evaluates a metric against many
+ * points at once.  Scalar pairwise calls to MetricType::Evaluate() leave a lot
+ * of performance on the table when the set of opposing points is known up
+ * front; the batched variants here evaluate whole columns (or column blocks)
+ * with vectorized Armadillo expressions, and the Euclidean many-to-many
+ * variant is computed from a single matrix-matrix product.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_BATCH_DISTANCE_HPP
+#define MLPACK_CORE_METRICS_BATCH_DISTANCE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * Evaluate a metric against many points at once.  For the L1, L2 and
+ * Chebyshev metrics a specialization computes all distances with vectorized
+ * expressions (which the compiler and BLAS turn into SIMD code for whatever
+ * instruction set the build targets); for any other metric the generic
+ * implementation falls back to pairwise evaluation, blocked so that the
+ * points being compared stay in cache and blocks are distributed across
+ * OpenMP threads.
+ *
+ * @tparam MetricType The metric to evaluate.
+ */
+template<typename MetricType>
+class BatchDistance
+{
+ public:
+  /**
+   * Compute the distance from one point to each column of the given matrix,
+   * so that distances[j] = metric(point, points.col(j)).  The output vector
+   * is sized to points.n_cols.
+   *
+   * @param point The single point.
+   * @param points Set of points (one point per column).
+   * @param distances Vector to store the distances in.
+   * @param metric Instantiated metric to evaluate.
+   */
+  template<typename VecType>
+  static void OneToMany(const VecType& point,
+                        const arma::mat& points,
+                        arma::vec& distances,
+                        MetricType metric = MetricType());
+
+  /**
+   * Compute the distance between each pair of columns drawn from the two
+   * given matrices, so that distances(i, j) = metric(a.col(i), b.col(j)).
+   * The output matrix is sized to (a.n_cols x b.n_cols).
+   *
+   * @param a First set of points (one point per column).
+   * @param b Second set of points (one point per column).
+   * @param distances Matrix to store the distances in.
+   * @param metric Instantiated metric to evaluate.
+   */
+  static void ManyToMany(const arma::mat& a,
+                         const arma::mat& b,
+                         arma::mat& distances,
+                         MetricType metric = MetricType());
+
+ private:
+  //! Number of points per block in the generic many-to-many implementation.
+  static const size_t blockSize = 64;
+};
+
+/**
+ * BatchDistance specialization for the L2 metric (with or without the root):
+ * the one-to-many variant is a single vectorized pass, and the many-to-many
+ * variant recovers all squared distances from one matrix-matrix product via
+ * ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a^T b.  Note that the many-to-many
+ * expansion can lose a few digits of precision when distances are tiny
+ * compared to the norms of the points; cancellation is clamped so results are
+ * never negative.
+ */
+template<bool TakeRoot>
+class BatchDistance<LMetric<2, TakeRoot>>
+{
+ public:
+  //! Compute the distance from one point to each column of the given matrix.
+  template<typename VecType>
+  static void OneToMany(const VecType& point,
+                        const arma::mat& points,
+                        arma::vec& distances,
+                        LMetric<2, TakeRoot> metric = LMetric<2, TakeRoot>());
+
+  //! Compute the distance between each pair of columns of the two matrices.
+  static void ManyToMany(const arma::mat& a,
+                         const arma::mat& b,
+                         arma::mat& distances,
+                         LMetric<2, TakeRoot> metric = LMetric<2, TakeRoot>());
+};
+
+/**
+ * BatchDistance specialization for the L1 (Manhattan) metric: both variants
+ * are vectorized single passes over the data.
+ */
+template<bool TakeRoot>
+class BatchDistance<LMetric<1, TakeRoot>>
+{
+ public:
+  //! Compute the distance from one point to each column of the given matrix.
+  template<typename VecType>
+  static void OneToMany(const VecType& point,
+                        const arma::mat& points,
+                        arma::vec& distances,
+                        LMetric<1, TakeRoot> metric = LMetric<1, TakeRoot>());
+
+  //! Compute the distance between each pair of columns of the two matrices.
+  static void ManyToMany(const arma::mat& a,
+                         const arma::mat& b,
+                         arma::mat& distances,
+                         LMetric<1, TakeRoot> metric = LMetric<1, TakeRoot>());
+};
+
+/**
+ * BatchDistance specialization for the L-infinity (Chebyshev) metric: both
+ * variants are vectorized single passes over the data.
+ */
+template<bool TakeRoot>
+class BatchDistance<LMetric<INT_MAX, TakeRoot>>
+{
+ public:
+  //! Compute the distance from one point to each column of the given matrix.
+  template<typename VecType>
+  static void OneToMany(const VecType& point,
+                        const arma::mat& points,
+                        arma::vec& distances,
+                        LMetric<INT_MAX, TakeRoot> metric =
+                            LMetric<INT_MAX, TakeRoot>());
+
+  //! Compute the distance between each pair of columns of the two matrices.
+  static void ManyToMany(const arma::mat& a,
+                         const arma::mat& b,
+                         arma::mat& distances,
+                         LMetric<INT_MAX, TakeRoot> metric =
+                             LMetric<INT_MAX, TakeRoot>());
+};
+
+} // namespace metric
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_distance_impl.hpp"
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file batch_distance_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the BatchDistance class and its specializations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_BATCH_DISTANCE_IMPL_HPP
+#define MLPACK_CORE_METRICS_BATCH_DISTANCE_IMPL_HPP
+
+// In case it hasn't been included.
+#include "batch_distance.hpp"
+
+namespace mlpack {
+namespace metric {
+
+// Generic one-to-many implementation: pairwise evaluation.
+template<typename MetricType>
+template<typename VecType>
+void BatchDistance<MetricType>::OneToMany(const VecType& point,
+                                          const arma::mat& points,
+                                          arma::vec& distances,
+                                          MetricType metric)
+{
+  distances.set_size(points.n_cols);
+  for (size_t j = 0; j < points.n_cols; ++j)
+    distances[j] = metric.Evaluate(point, points.unsafe_col(j));
+}
+
+// Generic many-to-many implementation: pairwise evaluation, blocked for cache
+// reuse and parallelized over blocks of columns of b.
+template<typename MetricType>
+void BatchDistance<MetricType>::ManyToMany(const arma::mat& a,
+                                           const arma::mat& b,
+                                           arma::mat& distances,
+                                           MetricType metric)
+{
+  distances.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for schedule(dynamic) firstprivate(metric)
+  for (omp_size_t jStart = 0; jStart < (omp_size_t) b.n_cols;
+      jStart += blockSize)
+  {
+    const size_t jEnd = std::min(b.n_cols, (size_t) jStart + blockSize);
+    for (size_t iStart = 0; iStart < a.n_cols; iStart += blockSize)
+    {
+      const size_t iEnd = std::min(a.n_cols, iStart + blockSize);
+      for (size_t j = (size_t) jStart; j < jEnd; ++j)
+        for (size_t i = iStart; i < iEnd; ++i)
+          distances(i, j) = metric.Evaluate(a.unsafe_col(i), b.unsafe_col(j));
+    }
+  }
+}
+
+// L2 one-to-many: one vectorized pass.
+template<bool TakeRoot>
+template<typename VecType>
+void BatchDistance<LMetric<2, TakeRoot>>::OneToMany(
+    const VecType& point,
+    const arma::mat& points,
+    arma::vec& distances,
+    LMetric<2, TakeRoot> /* metric */)
+{
+  // Materialize the point so that subview arguments work with each_col().
+  const arma::vec pt(point);
+  distances = arma::trans(arma::sum(arma::square(points.each_col() - pt), 0));
+
+  if (TakeRoot)
+    distances = arma::sqrt(distances);
+}
+
+// L2 many-to-many: all inner products come from one matrix-matrix product,
+// and the squared distances are recovered from the norms.
+template<bool TakeRoot>
+void BatchDistance<LMetric<2, TakeRoot>>::ManyToMany(
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& distances,
+    LMetric<2, TakeRoot> /* metric */)
+{
+  const arma::vec aNorms = arma::trans(arma::sum(arma::square(a), 0));
+  const arma::rowvec bNorms = arma::sum(arma::square(b), 0);
+
+  distances = (-2.0) * (a.t() * b);
+  distances.each_col() += aNorms;
+  distances.each_row() += bNorms;
+
+  // Cancellation in the expansion above can produce slightly negative values
+  // for (near-)identical points.
+  distances.transform([](double val) { return (val < 0.0) ? 0.0 : val; });
+
+  if (TakeRoot)
+    distances = arma::sqrt(distances);
+}
+
+// L1 one-to-many: one vectorized pass.
+template<bool TakeRoot>
+template<typename VecType>
+void BatchDistance<LMetric<1, TakeRoot>>::OneToMany(
+    const VecType& point,
+    const arma::mat& points,
+    arma::vec& distances,
+    LMetric<1, TakeRoot> /* metric */)
+{
+  // Materialize the point so that subview arguments work with each_col().
+  const arma::vec pt(point);
+  distances = arma::trans(arma::sum(arma::abs(points.each_col() - pt), 0));
+}
+
+// L1 many-to-many: one vectorized pass per column of b.
+template<bool TakeRoot>
+void BatchDistance<LMetric<1, TakeRoot>>::ManyToMany(
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& distances,
+    LMetric<1, TakeRoot> /* metric */)
+{
+  distances.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+  {
+    distances.col(j) = arma::trans(
+        arma::sum(arma::abs(a.each_col() - b.col(j)), 0));
+  }
+}
+
+// Chebyshev one-to-many: one vectorized pass.
+template<bool TakeRoot>
+template<typename VecType>
+void BatchDistance<LMetric<INT_MAX, TakeRoot>>::OneToMany(
+    const VecType& point,
+    const arma::mat& points,
+    arma::vec& distances,
+    LMetric<INT_MAX, TakeRoot> /* metric */)
+{
+  // Materialize the point so that subview arguments work with each_col().
+  const arma::vec pt(point);
+  distances = arma::trans(arma::max(arma::abs(points.each_col() - pt), 0));
+}
+
+// Chebyshev many-to-many: one vectorized pass per column of b.
+template<bool TakeRoot>
+void BatchDistance<LMetric<INT_MAX, TakeRoot>>::ManyToMany(
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& distances,
+    LMetric<INT_MAX, TakeRoot> /* metric */)
+{
+  distances.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+  {
+    distances.col(j) = arma::trans(
+        arma::max(arma::abs(a.each_col() - b.col(j)), 0));
+  }
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
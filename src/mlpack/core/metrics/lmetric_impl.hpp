@@ -54,13 +54,32 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
   return arma::accu(abs(a - b));
 }
 
-// L2-metric specializations.
+// L2-metric specializations.  Two- and three-dimensional points dominate
+// spatial workloads, and for vectors that small the expression-template
+// machinery costs more than the distance itself, so those cases are computed
+// directly.
 template<>
 template<typename VecTypeA, typename VecTypeB>
 typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typedef typename VecTypeA::elem_type ElemType;
+
+  if (a.n_elem == 2)
+  {
+    const ElemType d0 = a[0] - b[0];
+    const ElemType d1 = a[1] - b[1];
+    return std::sqrt(d0 * d0 + d1 * d1);
+  }
+  else if (a.n_elem == 3)
+  {
+    const ElemType d0 = a[0] - b[0];
+    const ElemType d1 = a[1] - b[1];
+    const ElemType d2 = a[2] - b[2];
+    return std::sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+  }
+
   return sqrt(arma::accu(square(a - b)));
 }
 
@@ -70,6 +89,22 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typedef typename VecTypeA::elem_type ElemType;
+
+  if (a.n_elem == 2)
+  {
+    const ElemType d0 = a[0] - b[0];
+    const ElemType d1 = a[1] - b[1];
+    return d0 * d0 + d1 * d1;
+  }
+  else if (a.n_elem == 3)
+  {
+    const ElemType d0 = a[0] - b[0];
+    const ElemType d1 = a[1] - b[1];
+    const ElemType d2 = a[2] - b[2];
+    return d0 * d0 + d1 * d1 + d2 * d2;
+  }
+
   return accu(arma::square(a - b));
 }
 
@@ -38,9 +38,11 @@ namespace metric {
  * If you wish to use the KNN class or other tree-based algorithms with this
  * distance, it is recommended to instead stretch the dataset first, by
  * decomposing Q = L^T L (perhaps via a Cholesky decomposition), and then
- * multiply the data by L.  If you still wish to use the KNN class with a custom
- * distance anyway, you will need to use a different tree type than the default
- * KDTree, which only works with the LMetric class.
+ * multiply the data by L; Transform() does exactly this with a cached
+ * Cholesky factorization of the covariance.  If you still wish to use the
+ * KNN class with a custom distance anyway, you will need to use a different
+ * tree type than the default KDTree, which only works with the LMetric
+ * class.
  *
  * Similar to the LMetric class, this offers a template parameter TakeRoot
  * which, when set to false, will instead evaluate the distance
@@ -96,6 +98,36 @@ class MahalanobisDistance
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Compute and cache the Cholesky factorization @f$ Q = R^T R @f$ of the
+   * covariance matrix (which must be symmetric positive definite).  Once
+   * factorized, Evaluate() applies the triangular factor to the difference
+   * vector instead of performing a dense quadratic form, which halves the
+   * work per evaluation, and Transform() becomes available for stretching
+   * whole datasets at once.
+   */
+  void Factorize();
+
+  /**
+   * Transform a block of points (one point per column) with the triangular
+   * Cholesky factor of the covariance, so that plain Euclidean distances
+   * between transformed points equal Mahalanobis distances between the
+   * original points.  Transforming the reference and query sets of a
+   * tree-based method (such as NeighborSearch) up front in this way costs
+   * one triangular matrix product per set, after which the search can run
+   * with the LMetric at full Euclidean speed.
+   *
+   * Factorize() is called automatically if it has not been already.
+   *
+   * @param points Block of points to transform, one point per column.
+   * @param transformed Matrix to store the transformed points in.
+   */
+  template<typename MatType>
+  void Transform(const MatType& points, MatType& transformed);
+
+  //! Return whether the covariance has been factorized.
+  bool Factorized() const { return factor.n_rows > 0; }
+
   /**
    * Access the covariance matrix.
    *
@@ -104,11 +136,17 @@ class MahalanobisDistance
   const arma::mat& Covariance() const { return covariance; }
 
   /**
-   * Modify the covariance matrix.
+   * Modify the covariance matrix.  Any cached factorization is invalidated,
+   * so call Factorize() again after the modification if the factored mode is
+   * wanted.
    *
    * @return Reference to the covariance matrix.
    */
-  arma::mat& Covariance() { return covariance; }
+  arma::mat& Covariance()
+  {
+    factor.reset();
+    return covariance;
+  }
 
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
@@ -117,6 +155,10 @@ class MahalanobisDistance
  private:
   //! The covariance matrix associated with this distance.
   arma::mat covariance;
+
+  //! Upper-triangular Cholesky factor R of the covariance (Q = R^T R);
+  //! empty when the covariance has not been factorized.
+  arma::mat factor;
 };
 
 } // namespace metric
@@ -25,6 +25,15 @@ template<typename VecTypeA, typename VecTypeB>
 double MahalanobisDistance<false>::Evaluate(const VecTypeA& a,
                                             const VecTypeB& b)
 {
+  // If the covariance has been factorized, apply the triangular factor to
+  // the difference vector; this is half the work of the dense quadratic
+  // form.
+  if (factor.n_rows > 0)
+  {
+    const arma::vec m = arma::trimatu(factor) * (a - b);
+    return arma::dot(m, m);
+  }
+
   arma::vec m = (a - b);
   arma::mat out = trans(m) * covariance * m; // 1x1
   return out[0];
@@ -42,11 +51,37 @@ double MahalanobisDistance<true>::Evaluate(const VecTypeA& a,
   if (covariance.n_rows == 0)
     covariance = arma::eye<arma::mat>(a.n_elem, a.n_elem);
 
+  if (factor.n_rows > 0)
+  {
+    const arma::vec m = arma::trimatu(factor) * (a - b);
+    return sqrt(arma::dot(m, m));
+  }
+
   arma::vec m = (a - b);
   arma::mat out = trans(m) * covariance * m; // 1x1;
   return sqrt(out[0]);
 }
 
+template<bool TakeRoot>
+void MahalanobisDistance<TakeRoot>::Factorize()
+{
+  factor = arma::chol(covariance);
+}
+
+template<bool TakeRoot>
+template<typename MatType>
+void MahalanobisDistance<TakeRoot>::Transform(const MatType& points,
+                                              MatType& transformed)
+{
+  if (factor.n_rows == 0)
+    Factorize();
+
+  // One triangular matrix product stretches the whole block; Euclidean
+  // distances between the transformed points equal Mahalanobis distances
+  // between the originals, since Q = R^T R.
+  transformed = arma::trimatu(factor) * points;
+}
+
 // Serialize the Mahalanobis distance.
 template<bool TakeRoot>
 template<typename Archive>
@@ -54,6 +89,7 @@ void MahalanobisDistance<TakeRoot>::serialize(Archive& ar,
                                               const unsigned int /* version */)
 {
   ar & BOOST_SERIALIZATION_NVP(covariance);
+  ar & BOOST_SERIALIZATION_NVP(factor);
 }
 
 } // namespace metric
@@ -228,6 +228,13 @@ void AddressToPoint(VecType& point, const AddressType& address)
  * Compare two addresses. The function returns 1 if the first address is greater
  * than the second one, -1 if the first address is less than the second one,
  * otherwise the function returns 0.
+ *
+ * The loop is deliberately branchless: every word is inspected and the
+ * verdict of the most significant differing word is kept.  Addresses that
+ * reach this function are usually nearly equal (they come from the same
+ * region of the tree), so the early exits of a conditional comparison loop
+ * are mispredicted most of the time; the relational expressions below compile
+ * to flag tests and conditional moves instead.
  */
 template<typename AddressType1, typename AddressType2>
 int CompareAddresses(const AddressType1& addr1, const AddressType2& addr2)
@@ -238,15 +245,14 @@ int CompareAddresses(const AddressType1& addr1, const AddressType2& addr2)
 
   assert(addr1.n_elem == addr2.n_elem);
 
+  int result = 0;
   for (size_t i = 0; i < addr1.n_elem; i++)
   {
-    if (addr1[i] < addr2[i])
-      return -1;
-    else if (addr2[i] < addr1[i])
-      return 1;
+    const int cmp = (int) (addr2[i] < addr1[i]) - (int) (addr1[i] < addr2[i]);
+    result += (result == 0) * cmp;
   }
 
-  return 0;
+  return result;
 }
 
 /**
@@ -89,6 +89,17 @@ class BinarySpaceTree
   //! delete it.
   MatType* dataset;
 
+  //! When OpenMP is enabled, subtrees with at least this many points are
+  //! built as concurrent tasks; smaller subtrees are built serially because
+  //! the task scheduling overhead would dominate.
+  static const size_t minParallelSplitSize = 8192;
+
+  //! If Compact() has been called on this (root) node, this is the contiguous
+  //! buffer holding every descendant node; otherwise NULL.
+  void* compactStorage = NULL;
+  //! The number of descendant nodes stored in compactStorage.
+  size_t compactNodeCount = 0;
+
  public:
   //! A single-tree traverser for binary space trees; see
   //! single_tree_traverser.hpp for implementation.
@@ -300,6 +311,43 @@ class BinarySpaceTree
    */
   ~BinarySpaceTree();
 
+  /**
+   * Relocate every descendant node into one contiguous buffer, in traversal
+   * order with sibling pairs adjacent.  The pointer-based API is unchanged
+   * (all existing traversers keep working), but pointer-chasing traversals
+   * stop missing cache on scattered heap allocations, which matters for
+   * memory-latency-bound dual-tree workloads.  This may only be called on the
+   * root of a tree, after construction; pointers or references to descendant
+   * nodes are invalidated.
+   */
+  void Compact();
+
+  /**
+   * Write a flat binary snapshot of this tree (and its dataset) to the given
+   * file.  Unlike Boost serialization, which visits every node through the
+   * archive machinery, the snapshot is a bulk dump of the node records and
+   * bounds, so very large trees can be written and read at disk bandwidth.
+   * Only valid on the root of a tree built on an HRectBound-style bound
+   * (e.g. kd-trees).  Statistics are not stored; they are rebuilt at load
+   * time.
+   *
+   * @param filename File to write the snapshot to.
+   * @return true on success.
+   */
+  bool SaveSnapshot(const std::string& filename) const;
+
+  /**
+   * Load a tree previously written with SaveSnapshot().  The nodes are
+   * reconstructed into one contiguous buffer (as if Compact() had been
+   * called), so loading is a handful of bulk reads rather than a node-by-node
+   * deserialization.  Returns NULL (after printing a warning) on failure; the
+   * caller owns the returned tree.
+   *
+   * @param filename File holding the snapshot.
+   * @return The loaded tree, or NULL on failure.
+   */
+  static BinarySpaceTree* LoadSnapshot(const std::string& filename);
+
   //! Return the bound object for this node.
   const BoundType<MetricType>& Bound() const { return bound; }
   //! Return the bound object for this node.
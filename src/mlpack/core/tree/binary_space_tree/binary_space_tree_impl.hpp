@@ -16,7 +16,12 @@
 
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/util/log.hpp>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <new>
 #include <queue>
+#include <stack>
 
 namespace mlpack {
 namespace tree {
@@ -413,6 +418,12 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
 
+  // If the other tree was compacted, we take over its node buffer.
+  compactStorage = other.compactStorage;
+  compactNodeCount = other.compactNodeCount;
+  other.compactStorage = NULL;
+  other.compactNodeCount = 0;
+
   // Set new parent.
   if (left)
     left->parent = this;
@@ -455,6 +466,23 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
+  if (compactStorage != NULL)
+  {
+    // Every descendant lives in the contiguous buffer, so we destroy the
+    // nodes directly instead of recursively deleting heap allocations.
+    BinarySpaceTree* nodes = (BinarySpaceTree*) compactStorage;
+    for (size_t i = 0; i < compactNodeCount; ++i)
+    {
+      nodes[i].left = NULL;
+      nodes[i].right = NULL;
+      nodes[i].~BinarySpaceTree();
+    }
+    ::operator delete(compactStorage);
+
+    left = NULL;
+    right = NULL;
+  }
+
   delete left;
   delete right;
 
@@ -463,6 +491,299 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     delete dataset;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    Compact()
+{
+  if (parent != NULL)
+  {
+    Log::Warn << "BinarySpaceTree::Compact(): only the root of a tree can be "
+        << "compacted; ignoring." << std::endl;
+    return;
+  }
+
+  if (compactStorage != NULL || (left == NULL && right == NULL))
+    return; // Already compact (or a single leaf).
+
+  // Count the descendant nodes (the root itself stays where it is).
+  size_t numNodes = 0;
+  std::stack<BinarySpaceTree*> countStack;
+  countStack.push(this);
+  while (!countStack.empty())
+  {
+    BinarySpaceTree* node = countStack.top();
+    countStack.pop();
+    if (node->left != NULL)
+    {
+      ++numNodes;
+      countStack.push(node->left);
+    }
+    if (node->right != NULL)
+    {
+      ++numNodes;
+      countStack.push(node->right);
+    }
+  }
+
+  // Relocate each descendant into the buffer with the move constructor, which
+  // hollows out the heap node so it can be deleted without touching its
+  // subtree.  Processing the stack left-child-first lays out each left
+  // subtree before its right sibling's, with sibling pairs adjacent.
+  BinarySpaceTree* nodes =
+      (BinarySpaceTree*) ::operator new(numNodes * sizeof(BinarySpaceTree));
+  size_t used = 0;
+
+  std::stack<BinarySpaceTree*> stack;
+  stack.push(this);
+  while (!stack.empty())
+  {
+    BinarySpaceTree* node = stack.top();
+    stack.pop();
+
+    if (node->left != NULL)
+    {
+      BinarySpaceTree* oldLeft = node->left;
+      node->left = new (nodes + used++) BinarySpaceTree(std::move(*oldLeft));
+      node->left->parent = node;
+      delete oldLeft;
+    }
+    if (node->right != NULL)
+    {
+      BinarySpaceTree* oldRight = node->right;
+      node->right = new (nodes + used++) BinarySpaceTree(std::move(*oldRight));
+      node->right->parent = node;
+      delete oldRight;
+    }
+
+    if (node->right != NULL)
+      stack.push(node->right);
+    if (node->left != NULL)
+      stack.push(node->left);
+  }
+
+  compactStorage = nodes;
+  compactNodeCount = numNodes;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+bool BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    SaveSnapshot(const std::string& filename) const
+{
+  if (parent != NULL)
+  {
+    Log::Warn << "BinarySpaceTree::SaveSnapshot(): only the root of a tree "
+        << "can be written as a snapshot." << std::endl;
+    return false;
+  }
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Log::Warn << "BinarySpaceTree::SaveSnapshot(): cannot open '" << filename
+        << "' for writing." << std::endl;
+    return false;
+  }
+
+  // Collect the nodes in preorder and assign them indices.
+  std::vector<const BinarySpaceTree*> nodes;
+  std::stack<const BinarySpaceTree*> stack;
+  stack.push(this);
+  while (!stack.empty())
+  {
+    const BinarySpaceTree* node = stack.top();
+    stack.pop();
+    nodes.push_back(node);
+    if (node->right != NULL)
+      stack.push(node->right);
+    if (node->left != NULL)
+      stack.push(node->left);
+  }
+
+  std::map<const BinarySpaceTree*, uint64_t> indices;
+  for (size_t i = 0; i < nodes.size(); ++i)
+    indices[nodes[i]] = i;
+
+  // Header: magic, element size, dataset size, node count.
+  const char magic[] = "MLPACK_TREE_SNAPSHOT\n";
+  const uint64_t elemSize = sizeof(ElemType);
+  const uint64_t rows = dataset->n_rows;
+  const uint64_t cols = dataset->n_cols;
+  const uint64_t numNodes = nodes.size();
+  stream.write(magic, sizeof(magic) - 1);
+  stream.write((const char*) &elemSize, sizeof(uint64_t));
+  stream.write((const char*) &rows, sizeof(uint64_t));
+  stream.write((const char*) &cols, sizeof(uint64_t));
+  stream.write((const char*) &numNodes, sizeof(uint64_t));
+
+  // The dataset, as one bulk write.
+  stream.write((const char*) dataset->memptr(),
+      dataset->n_elem * sizeof(ElemType));
+
+  // Node records, field by field as bulk arrays.
+  const uint64_t noChild = std::numeric_limits<uint64_t>::max();
+  std::vector<uint64_t> intFields(4 * numNodes);
+  std::vector<ElemType> realFields(3 * numNodes);
+  std::vector<ElemType> boundData(2 * rows * numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    const BinarySpaceTree* node = nodes[i];
+    intFields[4 * i + 0] = node->begin;
+    intFields[4 * i + 1] = node->count;
+    intFields[4 * i + 2] = (node->left != NULL) ? indices[node->left]
+        : noChild;
+    intFields[4 * i + 3] = (node->right != NULL) ? indices[node->right]
+        : noChild;
+
+    realFields[3 * i + 0] = node->parentDistance;
+    realFields[3 * i + 1] = node->furthestDescendantDistance;
+    realFields[3 * i + 2] = node->minimumBoundDistance;
+
+    for (size_t d = 0; d < rows; ++d)
+    {
+      boundData[2 * rows * i + 2 * d + 0] = node->bound[d].Lo();
+      boundData[2 * rows * i + 2 * d + 1] = node->bound[d].Hi();
+    }
+  }
+
+  stream.write((const char*) intFields.data(),
+      intFields.size() * sizeof(uint64_t));
+  stream.write((const char*) realFields.data(),
+      realFields.size() * sizeof(ElemType));
+  stream.write((const char*) boundData.data(),
+      boundData.size() * sizeof(ElemType));
+
+  if (!stream)
+  {
+    Log::Warn << "BinarySpaceTree::SaveSnapshot(): write to '" << filename
+        << "' failed." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    LoadSnapshot(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Log::Warn << "BinarySpaceTree::LoadSnapshot(): cannot open '" << filename
+        << "'." << std::endl;
+    return NULL;
+  }
+
+  const char magic[] = "MLPACK_TREE_SNAPSHOT\n";
+  std::string header(sizeof(magic) - 1, '\0');
+  uint64_t elemSize = 0, rows = 0, cols = 0, numNodes = 0;
+  stream.read(&header[0], sizeof(magic) - 1);
+  stream.read((char*) &elemSize, sizeof(uint64_t));
+  stream.read((char*) &rows, sizeof(uint64_t));
+  stream.read((char*) &cols, sizeof(uint64_t));
+  stream.read((char*) &numNodes, sizeof(uint64_t));
+  if (!stream || header != magic || elemSize != sizeof(ElemType) ||
+      numNodes == 0)
+  {
+    Log::Warn << "BinarySpaceTree::LoadSnapshot(): '" << filename << "' is "
+        << "not a valid tree snapshot." << std::endl;
+    return NULL;
+  }
+
+  // Bulk-read the dataset and the node record arrays.
+  MatType* dataset = new MatType(rows, cols);
+  std::vector<uint64_t> intFields(4 * numNodes);
+  std::vector<ElemType> realFields(3 * numNodes);
+  std::vector<ElemType> boundData(2 * rows * numNodes);
+  stream.read((char*) dataset->memptr(), dataset->n_elem * sizeof(ElemType));
+  stream.read((char*) intFields.data(), intFields.size() * sizeof(uint64_t));
+  stream.read((char*) realFields.data(), realFields.size() * sizeof(ElemType));
+  stream.read((char*) boundData.data(), boundData.size() * sizeof(ElemType));
+  if (!stream)
+  {
+    Log::Warn << "BinarySpaceTree::LoadSnapshot(): '" << filename << "' is "
+        << "truncated." << std::endl;
+    delete dataset;
+    return NULL;
+  }
+
+  // Node 0 is the root; all descendants go into one contiguous buffer, owned
+  // by the root exactly as if Compact() had been called.
+  BinarySpaceTree* root = new BinarySpaceTree();
+  BinarySpaceTree* buffer = NULL;
+  if (numNodes > 1)
+  {
+    buffer = (BinarySpaceTree*)
+        ::operator new((numNodes - 1) * sizeof(BinarySpaceTree));
+    for (size_t i = 0; i + 1 < numNodes; ++i)
+      new (buffer + i) BinarySpaceTree();
+    root->compactStorage = buffer;
+    root->compactNodeCount = numNodes - 1;
+  }
+
+  const uint64_t noChild = std::numeric_limits<uint64_t>::max();
+  auto nodeAt = [&](const uint64_t i) -> BinarySpaceTree*
+  {
+    return (i == 0) ? root : (buffer + (i - 1));
+  };
+
+  for (uint64_t i = 0; i < numNodes; ++i)
+  {
+    BinarySpaceTree* node = nodeAt(i);
+    node->begin = (size_t) intFields[4 * i + 0];
+    node->count = (size_t) intFields[4 * i + 1];
+    node->parentDistance = realFields[3 * i + 0];
+    node->furthestDescendantDistance = realFields[3 * i + 1];
+    node->minimumBoundDistance = realFields[3 * i + 2];
+    node->dataset = dataset;
+
+    node->bound = BoundType<MetricType>(rows);
+    for (size_t d = 0; d < rows; ++d)
+      node->bound[d] = math::RangeType<ElemType>(
+          boundData[2 * rows * i + 2 * d + 0],
+          boundData[2 * rows * i + 2 * d + 1]);
+
+    const uint64_t leftIndex = intFields[4 * i + 2];
+    const uint64_t rightIndex = intFields[4 * i + 3];
+    if (leftIndex != noChild)
+    {
+      node->left = nodeAt(leftIndex);
+      node->left->parent = node;
+    }
+    if (rightIndex != noChild)
+    {
+      node->right = nodeAt(rightIndex);
+      node->right->parent = node;
+    }
+  }
+
+  // Rebuild the statistics bottom-up (children have higher preorder indices
+  // than their parents).
+  for (uint64_t i = numNodes; i > 0; --i)
+  {
+    BinarySpaceTree* node = nodeAt(i - 1);
+    node->stat = StatisticType(*node);
+  }
+
+  return root;
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -783,10 +1104,41 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  // The children cover disjoint column ranges of the dataset, so they can be
+  // built concurrently: the first large split opens an OpenMP parallel
+  // region, and deeper recursion fans out as tasks.  Small nodes are built
+  // serially to avoid task scheduling overhead.
+#ifdef HAS_OPENMP
+  if (count >= minParallelSplitSize && !omp_in_parallel())
+  {
+    #pragma omp parallel
+    #pragma omp single
+    {
+      #pragma omp task default(shared)
+      left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+          maxLeafSize);
+      right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+          splitter, maxLeafSize);
+      #pragma omp taskwait
+    }
+  }
+  else if (count >= minParallelSplitSize)
+  {
+    #pragma omp task default(shared)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+        maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        splitter, maxLeafSize);
+    #pragma omp taskwait
+  }
+  else
+#endif
+  {
+    left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+        maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        splitter, maxLeafSize);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -851,10 +1203,40 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // As in the unmapped overload, the children touch disjoint column ranges of
+  // the dataset and disjoint ranges of oldFromNew, so large subtrees are
+  // built as concurrent OpenMP tasks.
+#ifdef HAS_OPENMP
+  if (count >= minParallelSplitSize && !omp_in_parallel())
+  {
+    #pragma omp parallel
+    #pragma omp single
+    {
+      #pragma omp task default(shared)
+      left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+          splitter, maxLeafSize);
+      right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+          oldFromNew, splitter, maxLeafSize);
+      #pragma omp taskwait
+    }
+  }
+  else if (count >= minParallelSplitSize)
+  {
+    #pragma omp task default(shared)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+        splitter, maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        oldFromNew, splitter, maxLeafSize);
+    #pragma omp taskwait
+  }
+  else
+#endif
+  {
+    left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+        splitter, maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        oldFromNew, splitter, maxLeafSize);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -102,13 +102,13 @@ class UBTreeSplit
    */
   void InitializeAddresses(const MatType& data);
 
-  //! A comparator for sorting addresses.
-  static bool ComparePair(
-      const std::pair<arma::Col<AddressElemType>, size_t>& p1,
-      const std::pair<arma::Col<AddressElemType>, size_t>& p2)
-  {
-    return bound::addr::CompareAddresses(p1.first, p2.first) < 0;
-  }
+  /**
+   * Sort the addresses lexicographically with a byte-wise LSD radix sort.
+   * The addresses are first packed into a dense matrix of 64-bit words, so
+   * the counting passes stream through contiguous memory instead of calling
+   * a comparison function on two heap-allocated vectors per decision.
+   */
+  void RadixSortAddresses();
 };
 
 } // namespace tree
@@ -34,7 +34,7 @@ bool UBTreeSplit<BoundType, MatType>::SplitNode(BoundType& bound,
 
     // Probably this is not a good idea. Maybe it is better to get
     // a number of distinct samples and find the median.
-    std::sort(addresses.begin(), addresses.end(), ComparePair);
+    RadixSortAddresses();
 
     // Save the vector in order to rearrange the dataset later.
     splitInfo.addresses = &addresses;
@@ -156,6 +156,82 @@ void UBTreeSplit<BoundType, MatType>::InitializeAddresses(const MatType& data)
   }
 }
 
+template<typename BoundType, typename MatType>
+void UBTreeSplit<BoundType, MatType>::RadixSortAddresses()
+{
+  constexpr size_t order = sizeof(AddressElemType) * CHAR_BIT;
+  const size_t numPoints = addresses.size();
+  if (numPoints < 2)
+    return;
+
+  // Pack every address into contiguous 64-bit words, keeping the words in
+  // most-significant-first order so that lexicographic comparison of the
+  // packed words matches CompareAddresses().  32-bit address elements are
+  // merged in pairs; the trailing word of an odd-length address is padded
+  // with zeros, identically for every point.
+  const size_t numElem = addresses[0].first.n_elem;
+  const size_t elemPerWord = 64 / order;
+  const size_t numWords = (numElem + elemPerWord - 1) / elemPerWord;
+  arma::Mat<uint64_t> keys(numWords, numPoints, arma::fill::zeros);
+  for (size_t i = 0; i < numPoints; i++)
+  {
+    const arma::Col<AddressElemType>& address = addresses[i].first;
+    for (size_t j = 0; j < numElem; j++)
+    {
+      keys(j / elemPerWord, i) |= ((uint64_t) address[j]) <<
+          (64 - order - (j % elemPerWord) * order);
+    }
+  }
+
+  // A least-significant-digit radix sort of the permutation: one stable
+  // counting pass per key byte, from the lowest byte of the last word to the
+  // highest byte of the first word.
+  std::vector<size_t> perm(numPoints);
+  std::vector<size_t> buffer(numPoints);
+  for (size_t i = 0; i < numPoints; i++)
+    perm[i] = i;
+
+  size_t counts[257];
+  for (size_t word = numWords; word > 0; word--)
+  {
+    for (size_t shift = 0; shift < 64; shift += 8)
+    {
+      std::fill(counts, counts + 257, 0);
+      for (size_t i = 0; i < numPoints; i++)
+        counts[((keys(word - 1, perm[i]) >> shift) & 0xff) + 1]++;
+
+      // If all points share this byte the pass is a no-op; interleaved
+      // addresses share most of their high bytes, so this skips the bulk of
+      // the scatter passes.
+      bool uniform = false;
+      for (size_t b = 1; b <= 256; b++)
+      {
+        if (counts[b] == numPoints)
+        {
+          uniform = true;
+          break;
+        }
+      }
+      if (uniform)
+        continue;
+
+      for (size_t b = 1; b <= 256; b++)
+        counts[b] += counts[b - 1];
+
+      for (size_t i = 0; i < numPoints; i++)
+        buffer[counts[(keys(word - 1, perm[i]) >> shift) & 0xff]++] = perm[i];
+
+      perm.swap(buffer);
+    }
+  }
+
+  // Apply the final permutation to the address vector.
+  std::vector<std::pair<arma::Col<AddressElemType>, size_t>> sorted(numPoints);
+  for (size_t i = 0; i < numPoints; i++)
+    sorted[i] = std::move(addresses[perm[i]]);
+  addresses.swap(sorted);
+}
+
 template<typename BoundType, typename MatType>
 size_t UBTreeSplit<BoundType, MatType>::PerformSplit(
     MatType& data,
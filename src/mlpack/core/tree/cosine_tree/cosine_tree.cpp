@@ -29,7 +29,8 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; i++)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
   {
     indices[i] = i;
     double l2Norm = arma::norm(dataset.col(i), 2);
@@ -39,6 +40,9 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   // Frobenius norm of columns in the node.
   frobNormSquared = arma::accu(l2NormsSquared);
 
+  // Calculate the cumulative LS distribution for sampling.
+  CalculateLSDistribution();
+
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
@@ -67,6 +71,9 @@ CosineTree::CosineTree(CosineTree& parentNode,
   // Frobenius norm of columns in the node.
   frobNormSquared = arma::accu(l2NormsSquared);
 
+  // Calculate the cumulative LS distribution for sampling.
+  CalculateLSDistribution();
+
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
@@ -205,8 +212,9 @@ double CosineTree::MonteCarloError(CosineTree* node,
   size_t numSamples = log(node->NumColumns()) + 1;
   node->ColumnSamplesLS(sampledIndices, probabilities, numSamples);
 
-  // Get pointer to the original dataset.
-  arma::mat dataset = node->GetDataset();
+  // Get reference to the original dataset; copying it here would be
+  // disastrous for large matrices.
+  const arma::mat& dataset = node->GetDataset();
 
   // Initialize weighted projection magnitudes as zeros.
   arma::vec weightedMagnitudes;
@@ -220,12 +228,13 @@ double CosineTree::MonteCarloError(CosineTree* node,
   else
     projectionSize = treeQueue.size();
 
+  // Reuse one projection buffer for all of the samples.
+  arma::vec projection(projectionSize);
+
   // For each sample, calculate the weighted projection onto the current basis.
   for (size_t i = 0; i < numSamples; i++)
   {
-    // Initialize projection as a vector of zeros.
-    arma::vec projection;
-    projection.zeros(projectionSize);
+    projection.zeros();
 
     CosineTree *currentNode;
     CosineNodeQueue::const_iterator j = treeQueue.begin();
@@ -336,17 +345,6 @@ void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
                                  arma::vec& probabilities,
                                  size_t numSamples)
 {
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; i++)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
-
   // Initialize sizes of the 'sampledIndices' and 'probabilities' vectors.
   sampledIndices.resize(numSamples);
   probabilities.zeros(numSamples);
@@ -372,17 +370,6 @@ size_t CosineTree::ColumnSampleLS()
     return 0;
   }
 
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; i++)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
-
   // Generate a random value for sampling.
   double randValue = arma::randu();
   size_t start = 0, end = numColumns;
@@ -391,7 +378,7 @@ size_t CosineTree::ColumnSampleLS()
   return BinarySearch(cDistribution, randValue, start, end);
 }
 
-size_t CosineTree::BinarySearch(arma::vec& cDistribution,
+size_t CosineTree::BinarySearch(const arma::vec& cDistribution,
                                 double value,
                                 size_t start,
                                 size_t end)
@@ -424,7 +411,10 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; i++)
+  // The cosines are independent of each other, and each involves a pass over
+  // a full column of the dataset, so compute them in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -446,13 +436,34 @@ void CosineTree::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset.n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; i++)
+  // Calculate centroid of columns in the node, accumulating into per-thread
+  // partial sums when OpenMP is enabled.
+  #pragma omp parallel
   {
-    centroid += dataset.col(indices[i]);
+    arma::vec localCentroid(dataset.n_rows, arma::fill::zeros);
+
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < (omp_size_t) numColumns; i++)
+      localCentroid += dataset.col(indices[i]);
+
+    #pragma omp critical
+    centroid += localCentroid;
   }
   centroid /= numColumns;
 }
 
+void CosineTree::CalculateLSDistribution()
+{
+  // Initialize the cumulative distribution vector size.
+  cDistribution.zeros(numColumns + 1);
+
+  // Calculate cumulative length-squared distribution for the node.
+  for (size_t i = 0; i < numColumns; i++)
+  {
+    cDistribution(i + 1) = cDistribution(i) +
+        (l2NormsSquared(i) / frobNormSquared);
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
@@ -120,18 +120,18 @@ class CosineTree
 
   /**
    * Sample 'numSamples' points from the Length-Squared distribution of the
-   * cosine node. The function uses 'l2NormsSquared' to calculate the cumulative
-   * probability distribution of the column vectors. The sampling is based on a
-   * randomly generated values in the range [0, 1].
+   * cosine node. The function uses the cumulative probability distribution of
+   * the column vectors, computed once at construction from 'l2NormsSquared'.
+   * The sampling is based on a randomly generated values in the range [0, 1].
    */
   void ColumnSamplesLS(std::vector<size_t>& sampledIndices,
                        arma::vec& probabilities, size_t numSamples);
 
   /**
-   * Sample a point from the Length-Squared distribution of the cosine node. The
-   * function uses 'l2NormsSquared' to calculate the cumulative probability
-   * distribution of the column vectors. The sampling is based on a randomly
-   * generated value in the range [0, 1].
+   * Sample a point from the Length-Squared distribution of the cosine node.
+   * The function uses the cumulative probability distribution of the column
+   * vectors, computed once at construction from 'l2NormsSquared'. The sampling
+   * is based on a randomly generated value in the range [0, 1].
    */
   size_t ColumnSampleLS();
 
@@ -147,8 +147,8 @@ class CosineTree
    * @param start Starting index of the distribution interval to search in.
    * @param end Ending index of the distribution interval to search in.
    */
-  size_t BinarySearch(arma::vec& cDistribution, double value, size_t start,
-                      size_t end);
+  size_t BinarySearch(const arma::vec& cDistribution, double value,
+                      size_t start, size_t end);
 
   /**
    * Calculate cosines of the columns present in the node, with respect to the
@@ -165,6 +165,14 @@ class CosineTree
    */
   void CalculateCentroid();
 
+  /**
+   * Calculate the cumulative Length-Squared distribution of the columns
+   * present in the node. The distribution is computed once at construction and
+   * reused by every sampling call, so that repeated Monte Carlo error
+   * estimates do not rebuild it.
+   */
+  void CalculateLSDistribution();
+
   //! Returns the basis of the constructed subspace.
   void GetFinalBasis(arma::mat& finalBasis) { finalBasis = basis; }
 
@@ -229,6 +237,8 @@ class CosineTree
   std::vector<size_t> indices;
   //! L2-norm squared of columns in the node.
   arma::vec l2NormsSquared;
+  //! Cumulative Length-Squared distribution of columns in the node.
+  arma::vec cDistribution;
   //! Centroid of columns of input matrix in the node.
   arma::vec centroid;
   //! Orthonormalized basis vector of the node.
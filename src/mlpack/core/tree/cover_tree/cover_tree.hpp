@@ -446,7 +446,90 @@ class CoverTree
   MetricType* metric;
 
   /**
-   * Create the children for this node.
+   * Construct a node whose children will be created later by the worklist
+   * engine in CreateChildren().  This initializes the node's members but does
+   * not build the subtree or the statistic; the engine does both once the
+   * node's point sets are known.
+   *
+   * @param dataset Reference to the dataset to build a tree on.
+   * @param base Base to use during tree building.
+   * @param pointIndex Index of the point this node references.
+   * @param scale Scale of this level in the tree.
+   * @param parent Parent of this node.
+   * @param parentDistance Distance to the parent node.
+   * @param metric Instantiated metric to use during tree building.
+   */
+  CoverTree(const MatType& dataset,
+            const ElemType base,
+            const size_t pointIndex,
+            const int scale,
+            CoverTree* parent,
+            const ElemType parentDistance,
+            MetricType& metric);
+
+  /**
+   * One pending node expansion for the worklist engine in CreateChildren().
+   * Each frame corresponds to a call of the old recursive construction
+   * procedure: it tracks the node being expanded, its point sets, and how far
+   * through the procedure the expansion has progressed, so that construction
+   * needs no call-stack recursion regardless of how deep the tree gets.
+   */
+  struct BuildFrame
+  {
+    //! The steps of a node expansion.  A frame in AFTER_SELF_CHILD or
+    //! AFTER_CHILD state is waiting on the child pushed above it; when that
+    //! child's frame completes it stores its results in childFarSetSize,
+    //! childUsedSetSize, and (for non-self children) childIndices and
+    //! childDistances.
+    enum Phase
+    {
+      START,
+      AFTER_SELF_CHILD,
+      NEXT_NEAR_POINT,
+      AFTER_CHILD
+    };
+
+    //! The node being expanded.
+    CoverTree* node;
+    //! Current step of the expansion.
+    Phase phase;
+
+    //! Index array, ordered [ nearSet | farSet | usedSet ].  Self-children
+    //! share their parent frame's arrays; other children own fresh copies.
+    arma::Col<size_t>* indices;
+    //! Distances from node's point, ordered like indices.
+    arma::vec* distances;
+    //! Whether this frame owns its index and distance arrays.
+    bool ownsArrays;
+
+    //! Size of the near set.
+    size_t nearSetSize;
+    //! Size of the far set.
+    size_t farSetSize;
+    //! Size of the used set.
+    size_t usedSetSize;
+
+    //! Scale of the children being created.
+    int nextScale;
+    //! Near/far boundary for the children being created.
+    ElemType bound;
+
+    //! Index array handed back by the most recently completed child frame
+    //! (NULL if the child shared our arrays or was built inline).
+    arma::Col<size_t>* childIndices;
+    //! Distance array handed back by the most recently completed child frame.
+    arma::vec* childDistances;
+    //! Far set size reported by the most recently completed child.
+    size_t childFarSetSize;
+    //! Used set size reported by the most recently completed child.
+    size_t childUsedSetSize;
+  };
+
+  /**
+   * Create the children for this node, and all descendants below them.  This
+   * is driven by an explicit worklist of BuildFrames rather than recursion,
+   * so adversarial datasets that produce very deep trees cannot overflow the
+   * call stack.
    */
   void CreateChildren(arma::Col<size_t>& indices,
                       arma::vec& distances,
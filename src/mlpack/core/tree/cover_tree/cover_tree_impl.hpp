@@ -440,6 +440,38 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   stat = StatisticType(*this);
 }
 
+// Create a node whose children the worklist engine will fill in later.
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
+    const MatType& dataset,
+    const ElemType base,
+    const size_t pointIndex,
+    const int scale,
+    CoverTree* parent,
+    const ElemType parentDistance,
+    MetricType& metric) :
+    dataset(&dataset),
+    point(pointIndex),
+    scale(scale),
+    base(base),
+    numDescendants(0),
+    parent(parent),
+    parentDistance(parentDistance),
+    furthestDescendantDistance(0),
+    localMetric(false),
+    localDataset(false),
+    metric(&metric),
+    distanceComps(0)
+{
+  // The children and the statistic are built by the worklist engine in
+  // CreateChildren(), once this node's point sets are known.
+}
+
 // Manually create a cover tree node.
 template<
     typename MetricType,
@@ -593,9 +625,21 @@ template<
 >
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::~CoverTree()
 {
-  // Delete each child.
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+  // Delete each subtree with an explicit worklist, so that very deep trees
+  // cannot overflow the call stack during teardown.  Each node's children are
+  // detached before that node is deleted, so the deletes do not recurse.
+  std::vector<CoverTree*> toDelete(children);
+  children.clear();
+  while (!toDelete.empty())
+  {
+    CoverTree* node = toDelete.back();
+    toDelete.pop_back();
+
+    toDelete.insert(toDelete.end(), node->children.begin(),
+        node->children.end());
+    node->children.clear();
+    delete node;
+  }
 
   // Delete the local metric, if necessary.
   if (localMetric)
@@ -989,185 +1033,334 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     size_t& farSetSize,
     size_t& usedSetSize)
 {
-  // Determine the next scale level.  This should be the first level where there
-  // are any points in the far set.  So, if we know the maximum distance in the
-  // distances array, this will be the largest i such that
-  //   maxDistance > pow(base, i)
-  // and using this for the scale factor should guarantee we are not creating an
-  // implicit node.  If the maximum distance is 0, every point in the near set
-  // will be created as a leaf, and a child to this node.  We also do not need
-  // to change the furthestChildDistance or furthestDescendantDistance.
-  const ElemType maxDistance = max(distances.rows(0,
-      nearSetSize + farSetSize - 1));
-  if (maxDistance == 0)
+  // Expansion is driven by an explicit worklist of BuildFrames instead of
+  // recursion, so that very deep trees (adversarial datasets can produce
+  // depth linear in the number of points) cannot overflow the call stack.
+  // Each frame corresponds to one call of the old recursive procedure, and
+  // each visit to a frame runs that procedure up to its next child creation
+  // (pushing a frame for the child) or to completion.
+  std::vector<BuildFrame*> frames;
+
+  // When a frame completes, it hands its results back to its parent frame --
+  // or, for the engine's root frame, back to our caller -- and nodes below
+  // the engine root get their statistic built, now that all of their children
+  // exist.  (The engine root's statistic is built by its constructor, which
+  // may still collapse implicit nodes.)
+  auto completeFrame = [&frames, &farSetSize, &usedSetSize, this]()
   {
-    // Make the self child at the lowest possible level.
-    // This should not modify farSetSize or usedSetSize.
-    size_t tempSize = 0;
-    children.push_back(new CoverTree(*dataset, base, point, INT_MIN, this, 0,
-        indices, distances, 0, tempSize, usedSetSize, *metric));
-    distanceComps += children.back()->DistanceComps();
-
-    // Every point in the near set should be a leaf.
-    for (size_t i = 0; i < nearSetSize; ++i)
+    BuildFrame* done = frames.back();
+    frames.pop_back();
+
+    if (frames.empty())
     {
-      // farSetSize and usedSetSize will not be modified.
-      children.push_back(new CoverTree(*dataset, base, indices[i],
-          INT_MIN, this, distances[i], indices, distances, 0, tempSize,
-          usedSetSize, *metric));
-      distanceComps += children.back()->DistanceComps();
-      usedSetSize++;
+      farSetSize = done->farSetSize;
+      usedSetSize = done->usedSetSize;
+    }
+    else
+    {
+      BuildFrame& parentFrame = *frames.back();
+      parentFrame.childFarSetSize = done->farSetSize;
+      parentFrame.childUsedSetSize = done->usedSetSize;
+      if (done->ownsArrays)
+      {
+        parentFrame.childIndices = done->indices;
+        parentFrame.childDistances = done->distances;
+      }
     }
 
-    // The number of descendants is just the number of children, because each of
-    // them are leaves and contain one point.
-    numDescendants = children.size();
+    if (done->node != this)
+      done->node->stat = StatisticType(*(done->node));
+
+    delete done;
+  };
+
+  BuildFrame* rootFrame = new BuildFrame();
+  rootFrame->node = this;
+  rootFrame->phase = BuildFrame::START;
+  rootFrame->indices = &indices;
+  rootFrame->distances = &distances;
+  rootFrame->ownsArrays = false;
+  rootFrame->nearSetSize = nearSetSize;
+  rootFrame->farSetSize = farSetSize;
+  rootFrame->usedSetSize = usedSetSize;
+  rootFrame->childIndices = NULL;
+  rootFrame->childDistances = NULL;
+  frames.push_back(rootFrame);
+
+  while (!frames.empty())
+  {
+    BuildFrame& f = *frames.back();
+    CoverTree* node = f.node;
+    arma::Col<size_t>& fIndices = *f.indices;
+    arma::vec& fDistances = *f.distances;
 
-    // Re-sort the dataset.  We have
-    // [ used | far | other used ]
-    // and we want
-    // [ far | all used ].
-    SortPointSet(indices, distances, 0, usedSetSize, farSetSize);
+    if (f.phase == BuildFrame::START)
+    {
+      // Determine the next scale level.  This should be the first level where
+      // there are any points in the far set.  So, if we know the maximum
+      // distance in the distances array, this will be the largest i such that
+      //   maxDistance > pow(base, i)
+      // and using this for the scale factor should guarantee we are not
+      // creating an implicit node.  If the maximum distance is 0, every point
+      // in the near set will be created as a leaf, and a child to this node.
+      // We also do not need to change the furthestChildDistance or
+      // furthestDescendantDistance.
+      const ElemType maxDistance = max(fDistances.rows(0,
+          f.nearSetSize + f.farSetSize - 1));
+      if (maxDistance == 0)
+      {
+        // Make the self child at the lowest possible level.
+        // This should not modify farSetSize or usedSetSize.
+        size_t tempSize = 0;
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            node->point, INT_MIN, node, 0, fIndices, fDistances, 0, tempSize,
+            f.usedSetSize, *node->metric));
+        node->distanceComps += node->children.back()->DistanceComps();
+
+        // Every point in the near set should be a leaf.
+        for (size_t i = 0; i < f.nearSetSize; ++i)
+        {
+          // farSetSize and usedSetSize will not be modified.
+          node->children.push_back(new CoverTree(*node->dataset, node->base,
+              fIndices[i], INT_MIN, node, fDistances[i], fIndices, fDistances,
+              0, tempSize, f.usedSetSize, *node->metric));
+          node->distanceComps += node->children.back()->DistanceComps();
+          f.usedSetSize++;
+        }
 
-    return;
-  }
+        // The number of descendants is just the number of children, because
+        // each of them are leaves and contain one point.
+        node->numDescendants = node->children.size();
 
-  const int nextScale = std::min(scale,
-      (int) ceil(log(maxDistance) / log(base))) - 1;
-  const ElemType bound = pow(base, nextScale);
-
-  // First, make the self child.  We must split the given near set into the near
-  // set and far set for the self child.
-  size_t childNearSetSize =
-      SplitNearFar(indices, distances, bound, nearSetSize);
-
-  // Build the self child (recursively).
-  size_t childFarSetSize = nearSetSize - childNearSetSize;
-  size_t childUsedSetSize = 0;
-  children.push_back(new CoverTree(*dataset, base, point, nextScale, this, 0,
-      indices, distances, childNearSetSize, childFarSetSize, childUsedSetSize,
-      *metric));
-  // Don't double-count the self-child (so, subtract one).
-  numDescendants += children[0]->NumDescendants();
-
-  // The self-child can't modify the furthestChildDistance away from 0, but it
-  // can modify the furthestDescendantDistance.
-  furthestDescendantDistance = children[0]->FurthestDescendantDistance();
-
-  // Remove any implicit nodes we may have created.
-  RemoveNewImplicitNodes();
-
-  distanceComps += children[0]->DistanceComps();
-
-  // Now the arrays, in memory, look like this:
-  // [ childFar | childUsed | far | used ]
-  // but we need to move the used points past our far set:
-  // [ childFar | far | childUsed + used ]
-  // and keeping in mind that childFar = our near set,
-  // [ near | far | childUsed + used ]
-  // is what we are trying to make.
-  SortPointSet(indices, distances, childFarSetSize, childUsedSetSize,
-      farSetSize);
-
-  // Update size of near set and used set.
-  nearSetSize -= childUsedSetSize;
-  usedSetSize += childUsedSetSize;
+        // Re-sort the dataset.  We have
+        // [ used | far | other used ]
+        // and we want
+        // [ far | all used ].
+        node->SortPointSet(fIndices, fDistances, 0, f.usedSetSize,
+            f.farSetSize);
 
-  // Now for each point in the near set, we need to make children.  To save
-  // computation later, we'll create an array holding the points in the near
-  // set, and then after each run we'll check which of those (if any) were used
-  // and we will remove them.  ...if that's faster.  I think it is.
-  while (nearSetSize > 0)
-  {
-    size_t newPointIndex = nearSetSize - 1;
+        completeFrame();
+        continue;
+      }
 
-    // Swap to front if necessary.
-    if (newPointIndex != 0)
-    {
-      const size_t tempIndex = indices[newPointIndex];
-      const ElemType tempDist = distances[newPointIndex];
+      f.nextScale = std::min(node->scale,
+          (int) ceil(log(maxDistance) / log(node->base))) - 1;
+      f.bound = pow(node->base, f.nextScale);
 
-      indices[newPointIndex] = indices[0];
-      distances[newPointIndex] = distances[0];
+      // First, make the self child.  We must split the given near set into
+      // the near set and far set for the self child.
+      const size_t childNearSetSize = node->SplitNearFar(fIndices, fDistances,
+          f.bound, f.nearSetSize);
+      const size_t childFarSetSize = f.nearSetSize - childNearSetSize;
 
-      indices[0] = tempIndex;
-      distances[0] = tempDist;
+      f.phase = BuildFrame::AFTER_SELF_CHILD;
+      if (childNearSetSize > 0)
+      {
+        // The self child needs expansion of its own, so give it a frame; it
+        // shares our index and distance arrays.
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            node->point, f.nextScale, node, 0, *node->metric));
+
+        BuildFrame* childFrame = new BuildFrame();
+        childFrame->node = node->children.back();
+        childFrame->phase = BuildFrame::START;
+        childFrame->indices = f.indices;
+        childFrame->distances = f.distances;
+        childFrame->ownsArrays = false;
+        childFrame->nearSetSize = childNearSetSize;
+        childFrame->farSetSize = childFarSetSize;
+        childFrame->usedSetSize = 0;
+        childFrame->childIndices = NULL;
+        childFrame->childDistances = NULL;
+        frames.push_back(childFrame);
+      }
+      else
+      {
+        // The self child is a leaf; build it directly.
+        size_t tempFarSetSize = childFarSetSize;
+        size_t tempUsedSetSize = 0;
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            node->point, f.nextScale, node, 0, fIndices, fDistances, 0,
+            tempFarSetSize, tempUsedSetSize, *node->metric));
+        f.childFarSetSize = tempFarSetSize;
+        f.childUsedSetSize = tempUsedSetSize;
+      }
+      continue;
     }
 
-    // Will this be a new furthest child?
-    if (distances[0] > furthestDescendantDistance)
-      furthestDescendantDistance = distances[0];
+    if (f.phase == BuildFrame::AFTER_SELF_CHILD)
+    {
+      // Don't double-count the self-child (so, subtract one).
+      node->numDescendants += node->children[0]->NumDescendants();
+
+      // The self-child can't modify the furthestChildDistance away from 0,
+      // but it can modify the furthestDescendantDistance.
+      node->furthestDescendantDistance =
+          node->children[0]->FurthestDescendantDistance();
+
+      // Remove any implicit nodes we may have created.
+      node->RemoveNewImplicitNodes();
+
+      node->distanceComps += node->children[0]->DistanceComps();
+
+      // Now the arrays, in memory, look like this:
+      // [ childFar | childUsed | far | used ]
+      // but we need to move the used points past our far set:
+      // [ childFar | far | childUsed + used ]
+      // and keeping in mind that childFar = our near set,
+      // [ near | far | childUsed + used ]
+      // is what we are trying to make.
+      node->SortPointSet(fIndices, fDistances, f.childFarSetSize,
+          f.childUsedSetSize, f.farSetSize);
+
+      // Update size of near set and used set.
+      f.nearSetSize -= f.childUsedSetSize;
+      f.usedSetSize += f.childUsedSetSize;
+
+      // Now for each point in the near set, we need to make children.
+      f.phase = BuildFrame::NEXT_NEAR_POINT;
+      continue;
+    }
 
-    // If there's only one point left, we don't need this crap.
-    if ((nearSetSize == 1) && (farSetSize == 0))
+    if (f.phase == BuildFrame::NEXT_NEAR_POINT)
     {
-      size_t childNearSetSize = 0;
-      children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-          this, distances[0], indices, distances, childNearSetSize, farSetSize,
-          usedSetSize, *metric));
-      distanceComps += children.back()->DistanceComps();
-      numDescendants += children.back()->NumDescendants();
-
-      // Because the far set size is 0, we don't have to do any swapping to
-      // move the point into the used set.
-      ++usedSetSize;
-      --nearSetSize;
-
-      // And we're done.
-      break;
+      if (f.nearSetSize == 0)
+      {
+        // All children are built; calculate furthest descendant.
+        for (size_t i = (f.nearSetSize + f.farSetSize);
+            i < (f.nearSetSize + f.farSetSize + f.usedSetSize); ++i)
+          if (fDistances[i] > node->furthestDescendantDistance)
+            node->furthestDescendantDistance = fDistances[i];
+
+        completeFrame();
+        continue;
+      }
+
+      const size_t newPointIndex = f.nearSetSize - 1;
+
+      // Swap to front if necessary.
+      if (newPointIndex != 0)
+      {
+        const size_t tempIndex = fIndices[newPointIndex];
+        const ElemType tempDist = fDistances[newPointIndex];
+
+        fIndices[newPointIndex] = fIndices[0];
+        fDistances[newPointIndex] = fDistances[0];
+
+        fIndices[0] = tempIndex;
+        fDistances[0] = tempDist;
+      }
+
+      // Will this be a new furthest child?
+      if (fDistances[0] > node->furthestDescendantDistance)
+        node->furthestDescendantDistance = fDistances[0];
+
+      // If there's only one point left, we don't need this crap.
+      if ((f.nearSetSize == 1) && (f.farSetSize == 0))
+      {
+        size_t childNearSetSize = 0;
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            fIndices[0], f.nextScale, node, fDistances[0], fIndices,
+            fDistances, childNearSetSize, f.farSetSize, f.usedSetSize,
+            *node->metric));
+        node->distanceComps += node->children.back()->DistanceComps();
+        node->numDescendants += node->children.back()->NumDescendants();
+
+        // Because the far set size is 0, we don't have to do any swapping to
+        // move the point into the used set.
+        ++f.usedSetSize;
+        --f.nearSetSize;
+
+        // And we're done; the next visit to this frame finalizes it.
+        continue;
+      }
+
+      // Create the near and far set indices and distance vectors.  We don't
+      // fill in the self-point, yet.
+      arma::Col<size_t>* childIndices =
+          new arma::Col<size_t>(f.nearSetSize + f.farSetSize);
+      childIndices->rows(0, (f.nearSetSize + f.farSetSize - 2)) =
+          fIndices.rows(1, f.nearSetSize + f.farSetSize - 1);
+      arma::vec* childDistances = new arma::vec(f.nearSetSize + f.farSetSize);
+
+      // Build distances for the child.
+      node->ComputeDistances(fIndices[0], *childIndices, *childDistances,
+          f.nearSetSize + f.farSetSize - 1);
+
+      // Split into near and far sets for this point.
+      const size_t childNearSetSize = node->SplitNearFar(*childIndices,
+          *childDistances, f.bound, f.nearSetSize + f.farSetSize - 1);
+      const size_t childFarSetSize = node->PruneFarSet(*childIndices,
+          *childDistances, node->base * f.bound, childNearSetSize,
+          (f.nearSetSize + f.farSetSize - 1));
+
+      // Now that we know the near and far set sizes, we can put the used
+      // point (the self point) in the correct place; now, when we call
+      // MoveToUsedSet(), it will move the self-point correctly.  The distance
+      // does not matter.
+      (*childIndices)(childNearSetSize + childFarSetSize) = fIndices[0];
+      (*childDistances)(childNearSetSize + childFarSetSize) = 0;
+
+      f.phase = BuildFrame::AFTER_CHILD;
+      if (childNearSetSize > 0)
+      {
+        // The child needs expansion of its own; it takes ownership of the
+        // arrays we just built, and hands them back when its frame completes.
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            fIndices[0], f.nextScale, node, fDistances[0], *node->metric));
+
+        BuildFrame* childFrame = new BuildFrame();
+        childFrame->node = node->children.back();
+        childFrame->phase = BuildFrame::START;
+        childFrame->indices = childIndices;
+        childFrame->distances = childDistances;
+        childFrame->ownsArrays = true;
+        childFrame->nearSetSize = childNearSetSize;
+        childFrame->farSetSize = childFarSetSize;
+        childFrame->usedSetSize = 1; // Mark self point as used.
+        childFrame->childIndices = NULL;
+        childFrame->childDistances = NULL;
+        frames.push_back(childFrame);
+      }
+      else
+      {
+        // The child is a leaf; build it directly.
+        size_t tempFarSetSize = childFarSetSize;
+        size_t tempUsedSetSize = 1; // Mark self point as used.
+        node->children.push_back(new CoverTree(*node->dataset, node->base,
+            fIndices[0], f.nextScale, node, fDistances[0], *childIndices,
+            *childDistances, 0, tempFarSetSize, tempUsedSetSize,
+            *node->metric));
+        f.childIndices = childIndices;
+        f.childDistances = childDistances;
+        f.childFarSetSize = tempFarSetSize;
+        f.childUsedSetSize = tempUsedSetSize;
+      }
+      continue;
     }
 
-    // Create the near and far set indices and distance vectors.  We don't fill
-    // in the self-point, yet.
-    arma::Col<size_t> childIndices(nearSetSize + farSetSize);
-    childIndices.rows(0, (nearSetSize + farSetSize - 2)) = indices.rows(1,
-        nearSetSize + farSetSize - 1);
-    arma::vec childDistances(nearSetSize + farSetSize);
-
-    // Build distances for the child.
-    ComputeDistances(indices[0], childIndices, childDistances, nearSetSize
-        + farSetSize - 1);
-
-    // Split into near and far sets for this point.
-    childNearSetSize = SplitNearFar(childIndices, childDistances, bound,
-        nearSetSize + farSetSize - 1);
-    childFarSetSize = PruneFarSet(childIndices, childDistances,
-        base * bound, childNearSetSize,
-        (nearSetSize + farSetSize - 1));
-
-    // Now that we know the near and far set sizes, we can put the used point
-    // (the self point) in the correct place; now, when we call
-    // MoveToUsedSet(), it will move the self-point correctly.  The distance
-    // does not matter.
-    childIndices(childNearSetSize + childFarSetSize) = indices[0];
-    childDistances(childNearSetSize + childFarSetSize) = 0;
-
-    // Build this child (recursively).
-    childUsedSetSize = 1; // Mark self point as used.
-    children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-        this, distances[0], childIndices, childDistances, childNearSetSize,
-        childFarSetSize, childUsedSetSize, *metric));
-    numDescendants += children.back()->NumDescendants();
+    // f.phase == BuildFrame::AFTER_CHILD.
+    node->numDescendants += node->children.back()->NumDescendants();
 
     // Remove any implicit nodes.
-    RemoveNewImplicitNodes();
+    node->RemoveNewImplicitNodes();
 
-    distanceComps += children.back()->DistanceComps();
+    node->distanceComps += node->children.back()->DistanceComps();
 
-    // Now with the child created, it returns the childIndices and
-    // childDistances vectors in this form:
+    // Now with the child created, its arrays are in this form:
     // [ childFar | childUsed ]
-    // For each point in the childUsed set, we must move that point to the used
-    // set in our own vector.
-    MoveToUsedSet(indices, distances, nearSetSize, farSetSize, usedSetSize,
-        childIndices, childFarSetSize, childUsedSetSize);
-  }
+    // For each point in the childUsed set, we must move that point to the
+    // used set in our own vector.
+    node->MoveToUsedSet(fIndices, fDistances, f.nearSetSize, f.farSetSize,
+        f.usedSetSize, *f.childIndices, f.childFarSetSize, f.childUsedSetSize);
 
-  // Calculate furthest descendant.
-  for (size_t i = (nearSetSize + farSetSize); i < (nearSetSize + farSetSize +
-      usedSetSize); ++i)
-    if (distances[i] > furthestDescendantDistance)
-      furthestDescendantDistance = distances[i];
+    delete f.childIndices;
+    delete f.childDistances;
+    f.childIndices = NULL;
+    f.childDistances = NULL;
+
+    f.phase = BuildFrame::NEXT_NEAR_POINT;
+  }
 }
 
 template<
@@ -52,11 +52,64 @@ class CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   size_t& NumPrunes() { return numPrunes; }
 
  private:
+  //! Struct used for traversal.  Holds a node and its score, parent and base
+  //! case evaluation.
+  struct MapEntry
+  {
+    //! The node this entry refers to.
+    CoverTree* node;
+    //! The score of the node.
+    double score;
+    //! The index of the parent node.
+    size_t parent;
+    //! The base case evaluation.
+    double baseCase;
+
+    //! Comparison operator, for sorting within a scale by score.
+    bool operator<(const MapEntry& other) const
+    {
+      return (score < other.score);
+    }
+  };
+
+  //! Append an entry to the given frontier bucket, reusing the bucket's
+  //! storage from earlier queries instead of reallocating it.
+  static void PushEntry(std::vector<MapEntry>& bucket,
+                        size_t& bucketSize,
+                        const MapEntry& entry)
+  {
+    if (bucketSize < bucket.size())
+      bucket[bucketSize] = entry;
+    else
+      bucket.push_back(entry);
+    ++bucketSize;
+  }
+
+  //! Place an entry into the frontier bucket matching its node's scale,
+  //! growing the frontier if the bucket does not exist yet.
+  void Enqueue(const MapEntry& entry, const int rootScale);
+
   //! Reference to the rules with which the tree will be traversed.
   RuleType& rule;
 
   //! The number of nodes which have been pruned during traversal.
   size_t numPrunes;
+
+  //! Reusable traversal frontier: bucket b holds the pending entries with
+  //! scale (root scale - b), and leaf entries (scale INT_MIN) get their own
+  //! bucket.  The buckets grow to the size the tree needs during the first
+  //! queries and are then reset by the size counters below between queries,
+  //! so repeated traversals do not touch the heap.
+  std::vector<std::vector<MapEntry> > frontier;
+
+  //! Number of valid entries in each frontier bucket.
+  std::vector<size_t> frontierSizes;
+
+  //! Reusable bucket for the leaf entries.
+  std::vector<MapEntry> leafFrontier;
+
+  //! Number of valid entries in the leaf bucket.
+  size_t leafFrontierSize;
 };
 
 } // namespace tree
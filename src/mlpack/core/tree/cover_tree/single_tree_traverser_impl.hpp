@@ -16,36 +16,9 @@
 // In case it hasn't been included yet.
 #include "single_tree_traverser.hpp"
 
-#include <queue>
-
 namespace mlpack {
 namespace tree {
 
-//! This is the structure the cover tree map will use for traversal.
-template<
-    typename MetricType,
-    typename StatisticType,
-    typename MatType,
-    typename RootPointPolicy
->
-struct CoverTreeMapEntry
-{
-  //! The node this entry refers to.
-  CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>* node;
-  //! The score of the node.
-  double score;
-  //! The index of the parent node.
-  size_t parent;
-  //! The base case evaluation.
-  double baseCase;
-
-  //! Comparison operator.
-  bool operator<(const CoverTreeMapEntry& other) const
-  {
-    return (score < other.score);
-  }
-};
-
 template<
     typename MetricType,
     typename StatisticType,
@@ -56,7 +29,8 @@ template<typename RuleType>
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
 SingleTreeTraverser<RuleType>::SingleTreeTraverser(RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    leafFrontierSize(0)
 { /* Nothing to do. */ }
 
 template<
@@ -73,16 +47,17 @@ SingleTreeTraverser<RuleType>::Traverse(
 {
   // This is a non-recursive implementation (which should be faster than a
   // recursive implementation).
-  typedef CoverTreeMapEntry<MetricType, StatisticType, MatType, RootPointPolicy>
-      MapEntryType;
-
-  // We will use this map as a priority queue.  Each key represents the scale,
-  // and then the vector is all the nodes in that scale which need to be
-  // investigated.  Because no point in a scale can add a point in its own
-  // scale, we know that the vector for each scale is final when we get to it.
-  // In addition, map is organized in such a way that rbegin() will return the
-  // largest scale.
-  std::map<int, std::vector<MapEntryType> > mapQueue;
+  //
+  // The frontier acts as a priority queue: bucket b holds all the pending
+  // nodes of scale (root scale - b), and the leaves (scale INT_MIN) have
+  // their own bucket.  Because no point in a scale can add a point in its own
+  // scale, each bucket is final when we get to it.  The buckets are part of
+  // the traverser and reused across queries; resetting the size counters is
+  // all that is needed between queries, so no per-query containers are
+  // allocated.
+  const int rootScale = referenceNode.Scale();
+  std::fill(frontierSizes.begin(), frontierSizes.end(), 0);
+  leafFrontierSize = 0;
 
   // Create the score for the children.
   double rootChildScore = rule.Score(queryIndex, referenceNode);
@@ -90,56 +65,52 @@ SingleTreeTraverser<RuleType>::Traverse(
   if (rootChildScore == DBL_MAX)
   {
     numPrunes += referenceNode.NumChildren();
+    return;
   }
-  else
-  {
-    // Manually add the children of the first node.
-    // Often, a ruleset will return without doing any computation on cover trees
-    // using TreeTraits::FirstPointIsCentroid; this is an optimization that
-    // (theoretically) the compiler should get right.
-    double rootBaseCase = rule.BaseCase(queryIndex, referenceNode.Point());
-
-    // Don't add the self-leaf.
-    size_t i = 0;
-    if (referenceNode.Child(0).NumChildren() == 0)
-    {
-      ++numPrunes;
-      i = 1;
-    }
 
-    for (/* i was set above. */; i < referenceNode.NumChildren(); ++i)
-    {
-      MapEntryType newFrame;
-      newFrame.node = &referenceNode.Child(i);
-      newFrame.score = rootChildScore;
-      newFrame.baseCase = rootBaseCase;
-      newFrame.parent = referenceNode.Point();
-
-      // Put it into the map.
-      mapQueue[newFrame.node->Scale()].push_back(newFrame);
-    }
+  // Manually add the children of the first node.
+  // Often, a ruleset will return without doing any computation on cover trees
+  // using TreeTraits::FirstPointIsCentroid; this is an optimization that
+  // (theoretically) the compiler should get right.
+  double rootBaseCase = rule.BaseCase(queryIndex, referenceNode.Point());
+
+  // Don't add the self-leaf.
+  size_t i = 0;
+  if (referenceNode.Child(0).NumChildren() == 0)
+  {
+    ++numPrunes;
+    i = 1;
   }
 
-  // Now begin the iteration through the map, but only if it has anything in it.
-  if (mapQueue.empty())
-    return;
-  typename std::map<int, std::vector<MapEntryType> >::reverse_iterator rit =
-      mapQueue.rbegin();
+  for (/* i was set above. */; i < referenceNode.NumChildren(); ++i)
+  {
+    MapEntry newFrame;
+    newFrame.node = &referenceNode.Child(i);
+    newFrame.score = rootChildScore;
+    newFrame.baseCase = rootBaseCase;
+    newFrame.parent = referenceNode.Point();
 
-  // We will treat the leaves differently (below).
-  while ((*rit).first != INT_MIN)
+    Enqueue(newFrame, rootScale);
+  }
+
+  // Now begin the iteration through the frontier, from the largest scale
+  // down.  Buckets that were not filled are simply skipped.
+  for (size_t b = 0; b < frontier.size(); ++b)
   {
-    // Get a reference to the current scale.
-    std::vector<MapEntryType>& scaleVector = (*rit).second;
+    const size_t scaleSize = frontierSizes[b];
+    if (scaleSize == 0)
+      continue;
 
-    // Before traversing all the points in this scale, sort by score.
-    std::sort(scaleVector.begin(), scaleVector.end());
+    // Before traversing all the points in this scale, sort by score.  Only
+    // the valid entries are sorted; anything past the size counter is stale
+    // storage from an earlier query.
+    std::sort(frontier[b].begin(), frontier[b].begin() + scaleSize);
 
-    // Now loop over each element.
-    for (size_t i = 0; i < scaleVector.size(); ++i)
+    // Now loop over each element.  The frames are taken by value: pushing
+    // children may grow the frontier and invalidate references into it.
+    for (size_t i = 0; i < scaleSize; ++i)
     {
-      // Get a reference to the current element.
-      const MapEntryType& frame = scaleVector.at(i);
+      const MapEntry frame = frontier[b][i];
 
       CoverTree* node = frame.node;
       const double score = frame.score;
@@ -147,7 +118,8 @@ SingleTreeTraverser<RuleType>::Traverse(
       const size_t point = node->Point();
       double baseCase = frame.baseCase;
 
-      // First we recalculate the score of this node to find if we can prune it.
+      // First we recalculate the score of this node to find if we can prune
+      // it.
       if (rule.Rescore(queryIndex, *node, score) == DBL_MAX)
       {
         ++numPrunes;
@@ -182,24 +154,21 @@ SingleTreeTraverser<RuleType>::Traverse(
 
       for (/* j is already set. */; j < node->NumChildren(); ++j)
       {
-        MapEntryType newFrame;
+        MapEntry newFrame;
         newFrame.node = &node->Child(j);
         newFrame.score = childScore;
         newFrame.baseCase = baseCase;
         newFrame.parent = point;
 
-        mapQueue[newFrame.node->Scale()].push_back(newFrame);
+        Enqueue(newFrame, rootScale);
       }
     }
-
-    // Now clear the memory for this scale; it isn't needed anymore.
-    mapQueue.erase((*rit).first);
   }
 
   // Now deal with the leaves.
-  for (size_t i = 0; i < mapQueue[INT_MIN].size(); ++i)
+  for (size_t i = 0; i < leafFrontierSize; ++i)
   {
-    const MapEntryType& frame = mapQueue[INT_MIN].at(i);
+    const MapEntry& frame = leafFrontier[i];
 
     CoverTree* node = frame.node;
     const double score = frame.score;
@@ -235,6 +204,36 @@ SingleTreeTraverser<RuleType>::Traverse(
   }
 }
 
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+SingleTreeTraverser<RuleType>::Enqueue(const MapEntry& entry,
+                                       const int rootScale)
+{
+  if (entry.node->Scale() == INT_MIN)
+  {
+    PushEntry(leafFrontier, leafFrontierSize, entry);
+  }
+  else
+  {
+    // The first queries grow the frontier to the depth of the tree; after
+    // that the buckets are only reused.
+    const size_t b = (size_t) (rootScale - entry.node->Scale());
+    if (b >= frontier.size())
+    {
+      frontier.resize(b + 1);
+      frontierSizes.resize(b + 1, 0);
+    }
+
+    PushEntry(frontier[b], frontierSizes[b], entry);
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
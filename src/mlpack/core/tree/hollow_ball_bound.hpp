@@ -181,6 +181,26 @@ class HollowBallBound
    */
   math::RangeType<ElemType> RangeDistance(const HollowBallBound& other) const;
 
+  /**
+   * Calculates minimum and maximum distances from a point to each of the
+   * given bounds at once.  The centers and hole centers are gathered into
+   * dense blocks, so that for the Euclidean metric all center distances are
+   * computed by one vectorized kernel instead of two scalar metric calls per
+   * bound; for every bound the minimum and maximum then share a single
+   * center-distance evaluation, with the inner- and outer-radius tests fused
+   * into one pass.
+   *
+   * @param point Point to score.
+   * @param bounds Bounds to score the point against.
+   * @param minDistances Vector the minimum distances will be written to.
+   * @param maxDistances Vector the maximum distances will be written to.
+   */
+  template<typename VecType>
+  static void RangeDistances(const VecType& point,
+                             const std::vector<const HollowBallBound*>& bounds,
+                             arma::Col<ElemType>& minDistances,
+                             arma::Col<ElemType>& maxDistances);
+
   /**
    * Expand the bound to include the given point.  The centroid will not be
    * moved.
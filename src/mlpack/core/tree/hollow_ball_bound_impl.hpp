@@ -344,6 +344,89 @@ math::RangeType<ElemType> HollowBallBound<TMetricType, ElemType>::RangeDistance(
   }
 }
 
+/**
+ * Calculates minimum and maximum distances from a point to many bounds.
+ */
+template<typename TMetricType, typename ElemType>
+template<typename VecType>
+void HollowBallBound<TMetricType, ElemType>::RangeDistances(
+    const VecType& point,
+    const std::vector<const HollowBallBound*>& bounds,
+    arma::Col<ElemType>& minDistances,
+    arma::Col<ElemType>& maxDistances)
+{
+  const size_t numBounds = bounds.size();
+  minDistances.set_size(numBounds);
+  maxDistances.set_size(numBounds);
+  if (numBounds == 0)
+    return;
+
+  // Gather the centers and hole centers into dense blocks so that the center
+  // distances can be computed by vectorized kernels instead of one scalar
+  // metric call per bound.  Empty bounds have no allocated center; their
+  // column is left zeroed and the distance is discarded below.
+  const size_t dimension = point.n_elem;
+  arma::Mat<ElemType> centers(dimension, numBounds, arma::fill::zeros);
+  arma::Mat<ElemType> hollowCenters(dimension, numBounds, arma::fill::zeros);
+  for (size_t i = 0; i < numBounds; ++i)
+  {
+    if (bounds[i]->radii.Hi() >= 0)
+    {
+      centers.col(i) = bounds[i]->center;
+      hollowCenters.col(i) = bounds[i]->hollowCenter;
+    }
+  }
+
+  arma::Col<ElemType> centerDistances(numBounds);
+  arma::Col<ElemType> hollowDistances(numBounds);
+  if (std::is_same<MetricType, metric::LMetric<2, true>>::value)
+  {
+    // Take a dense copy so the expression below also works when the point is
+    // a subview into some other matrix.
+    const arma::Col<ElemType> pointCopy = point;
+    centerDistances = arma::sqrt(arma::sum(arma::square(
+        centers.each_col() - pointCopy), 0)).t();
+    hollowDistances = arma::sqrt(arma::sum(arma::square(
+        hollowCenters.each_col() - pointCopy), 0)).t();
+  }
+  else
+  {
+    // A general metric cannot be expressed as a matrix kernel; fall back to
+    // per-bound evaluations on the gathered blocks.
+    for (size_t i = 0; i < numBounds; ++i)
+    {
+      centerDistances[i] = bounds[i]->metric->Evaluate(point, centers.col(i));
+      hollowDistances[i] = bounds[i]->metric->Evaluate(point,
+          hollowCenters.col(i));
+    }
+  }
+
+  // Fuse the inner- and outer-radius tests into one pass; the minimum and
+  // maximum distances of each bound share a single center-distance
+  // evaluation.
+  for (size_t i = 0; i < numBounds; ++i)
+  {
+    const HollowBallBound& b = *bounds[i];
+    if (b.radii.Hi() < 0)
+    {
+      minDistances[i] = std::numeric_limits<ElemType>::max();
+      maxDistances[i] = std::numeric_limits<ElemType>::max();
+      continue;
+    }
+
+    const ElemType dist = centerDistances[i];
+    if (dist >= b.radii.Hi()) // The outer ball does not contain the point.
+      minDistances[i] = dist - b.radii.Hi();
+    else
+    {
+      // Check if the point is situated in the hole.
+      minDistances[i] = math::ClampNonNegative(b.radii.Lo() -
+          hollowDistances[i]);
+    }
+    maxDistances[i] = dist + b.radii.Hi();
+  }
+}
+
 /**
  * Expand the bound to include the given point. Algorithm adapted from
  * Jack Ritter, "An Efficient Bounding Sphere" in Graphics Gems (1990).
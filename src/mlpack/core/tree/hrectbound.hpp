@@ -130,6 +130,19 @@ class HRectBound
                        typename std::enable_if_t<IsVector<VecType>::value>* = 0)
       const;
 
+  /**
+   * Calculates minimum bound-to-point distances for a whole block of points
+   * at once.  Scoring a batch amortizes loading the bound into cache across
+   * all of the points, which matters when the same bound is scored against
+   * many queries (e.g. batched single-tree search).
+   *
+   * @param points Matrix of points (one point per column).
+   * @param distances Vector to fill with one distance per column of points.
+   */
+  template<typename MatType>
+  void MinDistance(const MatType& points,
+                   arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates minimum bound-to-bound distance.
    *
@@ -226,6 +239,23 @@ class HRectBound
   void serialize(Archive& ar, const unsigned int version);
 
  private:
+  /**
+   * Fixed-trip-count kernels for the distance sums, dispatched to at runtime
+   * for the low-dimensional (d = 2 and d = 3) spatial cases that dominate
+   * many workloads.  With the dimensionality a compile-time constant the
+   * compiler fully unrolls these into straight-line code with no loop or
+   * vector-remainder handling.  Each returns the accumulated Power'th-power
+   * sum; the caller applies the root and scaling epilogue.
+   */
+  template<size_t FixedDim, typename VecType>
+  ElemType MinDistanceSum(const VecType& point) const;
+  template<size_t FixedDim>
+  ElemType MinDistanceSum(const HRectBound& other) const;
+  template<size_t FixedDim, typename VecType>
+  ElemType MaxDistanceSum(const VecType& point) const;
+  template<size_t FixedDim>
+  ElemType MaxDistanceSum(const HRectBound& other) const;
+
   //! The dimensionality of the bound.
   size_t dim;
   //! The bounds for each dimension.
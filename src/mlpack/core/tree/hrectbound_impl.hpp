@@ -159,32 +159,57 @@ inline ElemType HRectBound<MetricType, ElemType>::Volume() const
 }
 
 /**
- * Calculates minimum bound-to-point squared distance.
+ * Fixed-dimensionality kernel for the minimum bound-to-point distance sum.
  */
 template<typename MetricType, typename ElemType>
-template<typename VecType>
-inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
-    const VecType& point,
-    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+template<size_t FixedDim, typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MinDistanceSum(
+    const VecType& point) const
 {
-  Log::Assert(point.n_elem == dim);
-
   ElemType sum = 0;
+  for (size_t d = 0; d < FixedDim; d++)
+  {
+    const ElemType lower = bounds[d].Lo() - point[d];
+    const ElemType higher = point[d] - bounds[d].Hi();
 
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+    if (MetricType::Power == 1)
+      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    else if (MetricType::Power == 2)
+    {
+      const ElemType dist = (lower + std::fabs(lower)) +
+          (higher + std::fabs(higher));
+      sum += dist * dist;
+    }
+    else
+    {
+      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+          (ElemType) MetricType::Power);
+    }
+  }
+
+  return sum;
+}
+
+/**
+ * Fixed-dimensionality kernel for the minimum bound-to-bound distance sum.
+ */
+template<typename MetricType, typename ElemType>
+template<size_t FixedDim>
+inline ElemType HRectBound<MetricType, ElemType>::MinDistanceSum(
+    const HRectBound& other) const
+{
+  ElemType sum = 0;
+  for (size_t d = 0; d < FixedDim; d++)
   {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
+    const ElemType lower = other.bounds[d].Lo() - bounds[d].Hi();
+    const ElemType higher = bounds[d].Lo() - other.bounds[d].Hi();
 
-    // Since only one of 'lower' or 'higher' is negative, if we add each's
-    // absolute value to itself and then sum those two, our result is the
-    // nonnegative half of the equation times two; then we raise to power Power.
     if (MetricType::Power == 1)
       sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
     else if (MetricType::Power == 2)
     {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      const ElemType dist = (lower + std::fabs(lower)) +
+          (higher + std::fabs(higher));
       sum += dist * dist;
     }
     else
@@ -194,6 +219,108 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
     }
   }
 
+  return sum;
+}
+
+/**
+ * Fixed-dimensionality kernel for the maximum bound-to-point distance sum.
+ */
+template<typename MetricType, typename ElemType>
+template<size_t FixedDim, typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MaxDistanceSum(
+    const VecType& point) const
+{
+  ElemType sum = 0;
+  for (size_t d = 0; d < FixedDim; d++)
+  {
+    const ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
+        fabs(bounds[d].Hi() - point[d]));
+
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+/**
+ * Fixed-dimensionality kernel for the maximum bound-to-bound distance sum.
+ */
+template<typename MetricType, typename ElemType>
+template<size_t FixedDim>
+inline ElemType HRectBound<MetricType, ElemType>::MaxDistanceSum(
+    const HRectBound& other) const
+{
+  ElemType sum = 0;
+  for (size_t d = 0; d < FixedDim; d++)
+  {
+    const ElemType v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
+        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+/**
+ * Calculates minimum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType sum = 0;
+
+  if (dim == 2)
+    sum = MinDistanceSum<2>(point);
+  else if (dim == 3)
+    sum = MinDistanceSum<3>(point);
+  else
+  {
+    // The loop body is branchless (the metric checks are resolved at compile
+    // time), so the compiler can vectorize it with whatever SIMD width the
+    // build targets.
+    ElemType lower, higher;
+    #pragma omp simd reduction(+:sum) private(lower, higher)
+    for (size_t d = 0; d < dim; d++)
+    {
+      lower = bounds[d].Lo() - point[d];
+      higher = point[d] - bounds[d].Hi();
+
+      // Since only one of 'lower' or 'higher' is negative, if we add each's
+      // absolute value to itself and then sum those two, our result is the
+      // nonnegative half of the equation times two; then we raise to power
+      // Power.
+      if (MetricType::Power == 1)
+        sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      else if (MetricType::Power == 2)
+      {
+        ElemType dist = (lower + std::fabs(lower)) +
+            (higher + std::fabs(higher));
+        sum += dist * dist;
+      }
+      else
+      {
+        sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+            (ElemType) MetricType::Power);
+      }
+    }
+  }
+
   // Now take the Power'th root (but make sure our result is squared if it needs
   // to be); then cancel out the constant of 2 (which may have been squared now)
   // that was introduced earlier.  The compiler should optimize out the if
@@ -217,6 +344,22 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
   }
 }
 
+/**
+ * Calculates minimum bound-to-point distance for a block of points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline void HRectBound<MetricType, ElemType>::MinDistance(
+    const MatType& points,
+    arma::Col<ElemType>& distances) const
+{
+  Log::Assert(points.n_rows == dim);
+
+  distances.set_size(points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    distances[i] = MinDistance(points.unsafe_col(i));
+}
+
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
@@ -227,35 +370,40 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
   Log::Assert(dim == other.dim);
 
   ElemType sum = 0;
-  const math::RangeType<ElemType>* mbound = bounds;
-  const math::RangeType<ElemType>* obound = other.bounds;
 
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  if (dim == 2)
+    sum = MinDistanceSum<2>(other);
+  else if (dim == 3)
+    sum = MinDistanceSum<3>(other);
+  else
   {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
-    // We invoke the following:
-    //   x + fabs(x) = max(x * 2, 0)
-    //   (x * 2)^2 / 4 = x^2
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (MetricType::Power == 2)
+    // Indexed accesses (rather than walking pointers) and a branchless body
+    // let the compiler vectorize this reduction.
+    ElemType lower, higher;
+    #pragma omp simd reduction(+:sum) private(lower, higher)
+    for (size_t d = 0; d < dim; d++)
     {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
-    {
-      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
-          (ElemType) MetricType::Power);
+      lower = other.bounds[d].Lo() - bounds[d].Hi();
+      higher = bounds[d].Lo() - other.bounds[d].Hi();
+      // We invoke the following:
+      //   x + fabs(x) = max(x * 2, 0)
+      //   (x * 2)^2 / 4 = x^2
+
+      // The compiler should optimize out this if statement entirely.
+      if (MetricType::Power == 1)
+        sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      else if (MetricType::Power == 2)
+      {
+        ElemType dist = (lower + std::fabs(lower)) +
+            (higher + std::fabs(higher));
+        sum += dist * dist;
+      }
+      else
+      {
+        sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+            (ElemType) MetricType::Power);
+      }
     }
-
-    // Move bound pointers.
-    mbound++;
-    obound++;
   }
 
   // The compiler should optimize out this if statement entirely.
@@ -291,18 +439,26 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
 
   Log::Assert(point.n_elem == dim);
 
-  for (size_t d = 0; d < dim; d++)
+  if (dim == 2)
+    sum = MaxDistanceSum<2>(point);
+  else if (dim == 3)
+    sum = MaxDistanceSum<3>(point);
+  else
   {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
+    #pragma omp simd reduction(+:sum)
+    for (size_t d = 0; d < dim; d++)
+    {
+      ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
+          fabs(bounds[d].Hi() - point[d]));
+
+      // The compiler should optimize out this if statement entirely.
+      if (MetricType::Power == 1)
+        sum += v; // v is non-negative.
+      else if (MetricType::Power == 2)
+        sum += v * v;
+      else
+        sum += std::pow(v, (ElemType) MetricType::Power);
+    }
   }
 
   // The compiler should optimize out this if statement entirely.
@@ -331,19 +487,27 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
 
   Log::Assert(dim == other.dim);
 
-  ElemType v;
-  for (size_t d = 0; d < dim; d++)
+  if (dim == 2)
+    sum = MaxDistanceSum<2>(other);
+  else if (dim == 3)
+    sum = MaxDistanceSum<3>(other);
+  else
   {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
+    ElemType v;
+    #pragma omp simd reduction(+:sum) private(v)
+    for (size_t d = 0; d < dim; d++)
+    {
+      v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
+          fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+
+      // The compiler should optimize out this if statement entirely.
+      if (MetricType::Power == 1)
+        sum += v; // v is non-negative.
+      else if (MetricType::Power == 2)
+        sum += v * v;
+      else
+        sum += std::pow(v, (ElemType) MetricType::Power);
+    }
   }
 
   // The compiler should optimize out this if statement entirely.
@@ -373,22 +537,16 @@ HRectBound<MetricType, ElemType>::RangeDistance(
 
   Log::Assert(dim == other.dim);
 
+  // One of v1 or v2 is negative, so the branchless min/max forms below match
+  // the old conditional exactly and keep the loop vectorizable.
   ElemType v1, v2, vLo, vHi;
+  #pragma omp simd reduction(+:loSum, hiSum) private(v1, v2, vLo, vHi)
   for (size_t d = 0; d < dim; d++)
   {
     v1 = other.bounds[d].Lo() - bounds[d].Hi();
     v2 = bounds[d].Lo() - other.bounds[d].Hi();
-    // One of v1 or v2 is negative.
-    if (v1 >= v2)
-    {
-      vHi = -v2; // Make it nonnegative.
-      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
-    }
-    else
-    {
-      vHi = -v1; // Make it nonnegative.
-      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
-    }
+    vHi = -std::min(v1, v2); // Make it nonnegative.
+    vLo = std::max(std::max(v1, v2), (ElemType) 0); // Force 0 if negative.
 
     // The compiler should optimize out this if statement entirely.
     if (MetricType::Power == 1)
@@ -19,6 +19,13 @@
 namespace mlpack {
 namespace tree {
 
+/**
+ * A tag type used to select the Morton-code-based construction of Octree.
+ * Pass an instance of this as the second argument of the constructor to build
+ * the tree from sorted Morton codes instead of recursive splitting.
+ */
+struct MortonBuild { };
+
 template<typename MetricType = metric::EuclideanDistance,
          typename StatisticType = EmptyStatistic,
          typename MatType = arma::mat>
@@ -157,6 +164,48 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * Morton-code-based construction: a 64-bit Morton code is computed for every
+   * point, the points are sorted by code, and the tree levels are emitted
+   * directly from the code prefixes.  This produces the same octree structure
+   * as recursive splitting, but builds it from one sort of the dataset with no
+   * per-node buffers, which is much faster for large low-dimensional datasets
+   * such as 3-d point clouds.  The sorted leaf ordering is also contiguous in
+   * memory, which helps later traversals.
+   *
+   * The code assigns (64 / dimensionality) bits per dimension, so the
+   * dimensionality of the data must be at most 64; nodes are never split
+   * beyond that code resolution, so extremely concentrated duplicate-heavy
+   * data may give leaves larger than maxLeafSize.
+   *
+   * This copies the dataset.  If you don't want to copy the input dataset,
+   * consider using the overload that takes an rvalue reference and use
+   * std::move().
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param * (mortonBuild) Tag selecting Morton-code-based construction.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         const MortonBuild /* mortonBuild */,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * Morton-code-based construction.  This will take ownership of the dataset;
+   * if you don't want this, consider using the overload that takes a const
+   * reference to the dataset.  See the copying Morton overload above for
+   * details of the construction and its restrictions.
+   *
+   * @param data Dataset to create tree from.
+   * @param * (mortonBuild) Tag selecting Morton-code-based construction.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         const MortonBuild /* mortonBuild */,
+         const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -399,6 +448,56 @@ class Octree
   friend class boost::serialization::access;
 
  private:
+  /**
+   * Construct this node as a child of the given parent, holding the given
+   * range of Morton-sorted points.  This is used for recursive tree-building
+   * by the Morton-code-based constructors.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point held by this node.
+   * @param count Number of points held by this node.
+   * @param codes Sorted Morton codes of the points, aligned with the dataset.
+   * @param level Depth of this node in the tree (the root is level 0).
+   * @param bitsPerDim Number of Morton code bits assigned to each dimension.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t bitsPerDim,
+         const size_t maxLeafSize);
+
+  /**
+   * Compute the Morton code of every point in the dataset (in parallel, if
+   * OpenMP is enabled), radix-sort the codes, and reorder the dataset columns
+   * into sorted code order.  The given codes vector is filled with the sorted
+   * codes, and the number of code bits assigned to each dimension is returned.
+   *
+   * @param center Center of the root node.
+   * @param width Width of the root node in each dimension.
+   * @param codes Vector to fill with the sorted Morton codes.
+   */
+  size_t MortonSort(const arma::vec& center,
+                    const double width,
+                    std::vector<uint64_t>& codes);
+
+  /**
+   * Split the node by emitting one child for each distinct Morton code digit
+   * at the given level, recursing until the leaf size or the code resolution
+   * is reached.  The dataset must already be in sorted code order.
+   *
+   * @param codes Sorted Morton codes of the points, aligned with the dataset.
+   * @param level Depth of this node in the tree (the root is level 0).
+   * @param bitsPerDim Number of Morton code bits assigned to each dimension.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void SplitNodeMorton(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t bitsPerDim,
+                       const size_t maxLeafSize);
+
   /**
    * Split the node, using the given center and the given maximum width of this
    * node.
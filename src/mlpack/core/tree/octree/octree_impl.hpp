@@ -271,6 +271,123 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+//! Construct the tree from Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    const MortonBuild /* mortonBuild */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    // Sort the points by Morton code, then emit the tree from code prefixes.
+    std::vector<uint64_t> codes;
+    const size_t bitsPerDim = MortonSort(center, maxWidth, codes);
+    SplitNodeMorton(codes, 0, bitsPerDim, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct the tree from Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    const MortonBuild /* mortonBuild */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    // Sort the points by Morton code, then emit the tree from code prefixes.
+    std::vector<uint64_t> codes;
+    const size_t bitsPerDim = MortonSort(center, maxWidth, codes);
+    SplitNodeMorton(codes, 0, bitsPerDim, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct a child node from a range of Morton-sorted points.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent)
+{
+  // Calculate empirical center of data.
+  bound |= dataset->cols(begin, begin + count - 1);
+
+  // Now split the node.
+  SplitNodeMorton(codes, level, bitsPerDim, maxLeafSize);
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  arma::vec trueCenter, parentCenter;
+  bound.Center(trueCenter);
+  parent->Bound().Center(parentCenter);
+  parentDistance = metric.Evaluate(trueCenter, parentCenter);
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Construct a child node.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(
@@ -867,6 +984,126 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 }
 
+//! Sort the dataset by Morton code.
+template<typename MetricType, typename StatisticType, typename MatType>
+size_t Octree<MetricType, StatisticType, MatType>::MortonSort(
+    const arma::vec& center,
+    const double width,
+    std::vector<uint64_t>& codes)
+{
+  const size_t dims = dataset->n_rows;
+  if (dims > 64)
+  {
+    Log::Fatal << "Octree::MortonSort(): Morton-code-based construction "
+        << "requires dimensionality no greater than 64, but the dataset has "
+        << "dimensionality " << dims << "!" << std::endl;
+  }
+
+  // Assign an equal share of the 64 code bits to each dimension.  32 bits of
+  // resolution per dimension is already far more than any split could use, so
+  // cap there to keep the bit arithmetic safely below 64.
+  const size_t bitsPerDim = std::min((size_t) 64 / dims, (size_t) 32);
+  const uint64_t cells = (uint64_t) 1 << bitsPerDim;
+
+  // Guard against a degenerate dataset where every point is identical.
+  const double scale = (width > 0.0) ? ((double) cells / width) : 0.0;
+
+  // Quantize each coordinate into its cell index on the finest grid, then
+  // interleave the cell bits so that bit j of each dims-bit digit corresponds
+  // to dimension j, matching the child numbering of recursive splitting.
+  codes.resize(count);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    uint64_t code = 0;
+    for (size_t j = 0; j < dims; ++j)
+    {
+      const double offset = (*dataset)(j, i) - (center[j] - width / 2.0);
+      uint64_t cell = (uint64_t) std::max(offset * scale, 0.0);
+      if (cell >= cells)
+        cell = cells - 1;
+
+      for (size_t b = 0; b < bitsPerDim; ++b)
+        code |= ((cell >> b) & 1) << (b * dims + j);
+    }
+    codes[i] = code;
+  }
+
+  // LSD radix sort of the codes, one byte at a time, carrying the original
+  // column index of each point as the payload.
+  std::vector<size_t> order(count), orderTmp(count);
+  std::vector<uint64_t> codesTmp(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = i;
+
+  const size_t passes = (bitsPerDim * dims + 7) / 8;
+  for (size_t pass = 0; pass < passes; ++pass)
+  {
+    const size_t shift = 8 * pass;
+
+    size_t bucketEnds[256] = { 0 };
+    for (size_t i = 0; i < count; ++i)
+      bucketEnds[(codes[i] >> shift) & 0xFF]++;
+    for (size_t b = 1; b < 256; ++b)
+      bucketEnds[b] += bucketEnds[b - 1];
+
+    // Scatter backwards so that the sort is stable.
+    for (size_t i = count; i > 0; --i)
+    {
+      const size_t dest = --bucketEnds[(codes[i - 1] >> shift) & 0xFF];
+      codesTmp[dest] = codes[i - 1];
+      orderTmp[dest] = order[i - 1];
+    }
+
+    codes.swap(codesTmp);
+    order.swap(orderTmp);
+  }
+
+  // Reorder the dataset columns into sorted code order.
+  MatType sorted(dataset->n_rows, dataset->n_cols);
+  for (size_t i = 0; i < count; ++i)
+    sorted.col(i) = dataset->col(order[i]);
+  *dataset = std::move(sorted);
+
+  return bitsPerDim;
+}
+
+//! Split the node using the sorted Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::SplitNodeMorton(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in
+  // this node, and no way to split further once the code resolution is
+  // exhausted.
+  if (count <= maxLeafSize || level >= bitsPerDim)
+    return;
+
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (bitsPerDim - 1 - level) * dims;
+  const uint64_t mask = (dims >= 64) ? (uint64_t) -1 :
+      (((uint64_t) 1 << dims) - 1);
+
+  // The dataset is sorted by code, so each child of this node is a contiguous
+  // run of points sharing the dims-bit code digit of this level.
+  size_t childBegin = begin;
+  while (childBegin < begin + count)
+  {
+    const uint64_t digit = (codes[childBegin] >> shift) & mask;
+    size_t childEnd = childBegin + 1;
+    while (childEnd < begin + count &&
+        ((codes[childEnd] >> shift) & mask) == digit)
+      ++childEnd;
+
+    children.push_back(new Octree(this, childBegin, childEnd - childBegin,
+        codes, level + 1, bitsPerDim, maxLeafSize));
+    childBegin = childEnd;
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -24,6 +24,14 @@
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+/**
+ * A tag type used to select the Sort-Tile-Recursive (STR) bulk-loading
+ * constructors of RectangleTree.  Pass an instance of this as the second
+ * argument of the constructor to pack the dataset into the tree directly
+ * instead of inserting the points one at a time.
+ */
+struct StrBulkLoad { };
+
 /**
  * A rectangle type tree tree, such as an R-tree or X-tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -156,6 +164,59 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, bulk-loading the points with the Sort-Tile-Recursive (STR)
+   * algorithm instead of inserting them one at a time.  The points are tiled
+   * into spatially compact leaves filled to maxLeafSize, and upper levels are
+   * packed the same way on the leaf centers, so the resulting tree has nearly
+   * full occupancy and never performs a node split during construction.  The
+   * tree remains fully dynamic afterwards: points may still be inserted and
+   * deleted as usual.
+   *
+   * Bulk loading is available for split policies that do not maintain
+   * per-point auxiliary information (the R, R*, R+/R++ and X tree variants);
+   * Hilbert R trees define their structure through insertion order and must be
+   * built with the inserting constructors instead.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param * (bulkLoad) Tag selecting STR bulk loading.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(const MatType& data,
+                const StrBulkLoad /* bulkLoad */,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, taking ownership of the dataset and bulk-loading the points with
+   * the Sort-Tile-Recursive (STR) algorithm.  See the copying STR overload
+   * above for details of the packing and its restrictions.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param * (bulkLoad) Tag selecting STR bulk loading.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(MatType&& data,
+                const StrBulkLoad /* bulkLoad */,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -542,6 +603,42 @@ class RectangleTree
    */
   void SplitNode(std::vector<bool>& relevels);
 
+  /**
+   * Build the subtree of this (root) node by packing the entire dataset with
+   * the Sort-Tile-Recursive algorithm.  Called by the bulk-loading
+   * constructors; this node must be empty when it is called.
+   */
+  void BulkLoadSTR();
+
+  /**
+   * Reorder ordering[first:last) with Sort-Tile-Recursive tiling so that each
+   * consecutive run of `capacity` indices forms a spatially compact tile.  The
+   * range is sorted along the given dimension, cut into slabs, and each slab
+   * is tiled recursively along the next dimension.
+   *
+   * @param coordinates Matrix whose columns hold the coordinates of the
+   *      objects being tiled (data points or node centers).
+   * @param capacity Number of objects per tile.
+   * @param ordering Index array being reordered in place.
+   * @param first First position of the range to tile.
+   * @param last One past the last position of the range to tile.
+   * @param dim Dimension to sort along at this level of the recursion.
+   */
+  template<typename CoordMatType>
+  static void SortTileRecursive(const CoordMatType& coordinates,
+                                const size_t capacity,
+                                std::vector<size_t>& ordering,
+                                const size_t first,
+                                const size_t last,
+                                const size_t dim);
+
+  /**
+   * Recompute the statistics of this node and all of its descendants,
+   * children first.  Used after bulk loading, since the nodes are created
+   * before the structure beneath them exists.
+   */
+  void RebuildStatistics();
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
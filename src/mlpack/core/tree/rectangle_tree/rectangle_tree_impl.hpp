@@ -101,6 +101,236 @@ RectangleTree(MatType&& data,
     root->InsertPoint(i);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const StrBulkLoad /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoadSTR();
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const StrBulkLoad /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoadSTR();
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::BulkLoadSTR()
+{
+  const size_t n = dataset->n_cols;
+
+  // If the whole dataset fits into one leaf, the root is that leaf.
+  if (n <= maxLeafSize)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      bound |= dataset->col(i);
+      points[count++] = i;
+    }
+    numDescendants = n;
+    stat = StatisticType(*this);
+    return;
+  }
+
+  // Order the points so that each consecutive run of maxLeafSize indices
+  // forms one spatially compact STR tile.
+  std::vector<size_t> ordering(n);
+  for (size_t i = 0; i < n; ++i)
+    ordering[i] = i;
+  SortTileRecursive(*dataset, maxLeafSize, ordering, 0, n, 0);
+
+  // Build the packed leaves.
+  std::vector<RectangleTree*> level;
+  for (size_t tileFirst = 0; tileFirst < n; tileFirst += maxLeafSize)
+  {
+    const size_t tileLast = std::min(n, tileFirst + maxLeafSize);
+
+    // The parent pointer is corrected when the node is attached to the level
+    // above.
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t i = tileFirst; i < tileLast; ++i)
+    {
+      leaf->bound |= dataset->col(ordering[i]);
+      leaf->points[leaf->count++] = ordering[i];
+    }
+    leaf->numDescendants = leaf->count;
+    level.push_back(leaf);
+  }
+
+  // Pack the nodes upwards, tiling each level on the node bound centers,
+  // until the remaining nodes fit into the root.
+  while (level.size() > maxNumChildren)
+  {
+    arma::Mat<ElemType> centers(dataset->n_rows, level.size());
+    for (size_t i = 0; i < level.size(); ++i)
+    {
+      arma::Col<ElemType> center;
+      level[i]->bound.Center(center);
+      centers.col(i) = center;
+    }
+
+    std::vector<size_t> nodeOrdering(level.size());
+    for (size_t i = 0; i < level.size(); ++i)
+      nodeOrdering[i] = i;
+    SortTileRecursive(centers, maxNumChildren, nodeOrdering, 0, level.size(),
+        0);
+
+    std::vector<RectangleTree*> nextLevel;
+    for (size_t tileFirst = 0; tileFirst < level.size();
+         tileFirst += maxNumChildren)
+    {
+      const size_t tileLast = std::min(level.size(),
+          tileFirst + maxNumChildren);
+
+      RectangleTree* node = new RectangleTree(this);
+      for (size_t i = tileFirst; i < tileLast; ++i)
+      {
+        RectangleTree* child = level[nodeOrdering[i]];
+        node->children[node->numChildren++] = child;
+        child->parent = node;
+        node->bound |= child->bound;
+        node->numDescendants += child->numDescendants;
+      }
+      nextLevel.push_back(node);
+    }
+
+    level = std::move(nextLevel);
+  }
+
+  // Attach the remaining nodes to the root.
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    children[numChildren++] = level[i];
+    level[i]->parent = this;
+    bound |= level[i]->bound;
+    numDescendants += level[i]->numDescendants;
+  }
+
+  // The nodes were created before the structure beneath them existed, so the
+  // statistics must be rebuilt now, children first.
+  RebuildStatistics();
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename CoordMatType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+SortTileRecursive(const CoordMatType& coordinates,
+                  const size_t capacity,
+                  std::vector<size_t>& ordering,
+                  const size_t first,
+                  const size_t last,
+                  const size_t dim)
+{
+  const size_t n = last - first;
+  if (n <= capacity)
+    return;
+
+  // Sort this range of the ordering along the current dimension.
+  std::sort(ordering.begin() + first, ordering.begin() + last,
+      [&coordinates, dim](const size_t a, const size_t b)
+      { return coordinates(dim, a) < coordinates(dim, b); });
+
+  // In the last dimension the sorted order itself defines the tiles.
+  if (dim == coordinates.n_rows - 1)
+    return;
+
+  // The number of tiles this range must produce, and the number of slabs to
+  // cut along this dimension: the (d - dim)-th root of the tile count,
+  // rounded up, as in the STR packing scheme.
+  const size_t tiles = (n + capacity - 1) / capacity;
+  const size_t slabs = (size_t) std::ceil(std::pow((double) tiles,
+      1.0 / (double) (coordinates.n_rows - dim)));
+  const size_t slabSize = ((n + slabs - 1) / slabs + capacity - 1) /
+      capacity * capacity; // Round the slab size up to a whole tile.
+
+  for (size_t slabFirst = first; slabFirst < last; slabFirst += slabSize)
+  {
+    SortTileRecursive(coordinates, capacity, ordering, slabFirst,
+        std::min(last, slabFirst + slabSize), dim + 1);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::RebuildStatistics()
+{
+  for (size_t i = 0; i < numChildren; ++i)
+    children[i]->RebuildStatistics();
+  stat = StatisticType(*this);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -0,0 +1,155 @@
+/**
+ * @file refit_tree.hpp
+ * @author Ivan (Jonan) Georgiev
+ *
+ * Incremental refit of a built tree after a small set of points has changed
+ * value.  Instead of rebuilding, only the root-to-leaf paths touching the
+ * modified points are walked: their bounds are recomputed exactly and their
+ * statistics are refreshed bottom-up.  The caller is told whether the bounds
+ * drifted far enough that a full rebuild is worthwhile.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_REFIT_TREE_HPP
+#define MLPACK_CORE_TREE_REFIT_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+namespace refit {
+
+// Actual implementation of the refit.  The slice changed[first] ...
+// changed[last - 1] holds, in ascending order, exactly those modified point
+// indices that fall into this node's contiguous point range.  Returns the
+// largest relative bound growth seen in the refitted subtree.
+template<typename TreeType>
+double RefitNodeImpl(TreeType* node,
+                     const std::vector<size_t>& changed,
+                     const size_t first,
+                     const size_t last)
+{
+  double drift = 0.0;
+  const double oldDiameter = (double) node->Bound().Diameter();
+
+  if (node->NumChildren() == 0)
+  {
+    // Recompute the leaf bound exactly from its points, so that it can shrink
+    // as well as grow.
+    node->Bound().Clear();
+    if (node->Count() > 0)
+    {
+      node->Bound() |= node->Dataset().cols(node->Begin(),
+          node->Begin() + node->Count() - 1);
+    }
+  }
+  else
+  {
+    // The indices are sorted, so the slice belonging to each child is a
+    // contiguous piece of our own slice.
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      TreeType* child = node->ChildPtr(i);
+      const size_t childBegin = child->Begin();
+      const size_t childEnd = childBegin + child->Count();
+
+      const size_t childFirst = std::lower_bound(changed.begin() + first,
+          changed.begin() + last, childBegin) - changed.begin();
+      const size_t childLast = std::lower_bound(changed.begin() + first,
+          changed.begin() + last, childEnd) - changed.begin();
+
+      if (childFirst < childLast)
+      {
+        drift = std::max(drift,
+            RefitNodeImpl(child, changed, childFirst, childLast));
+      }
+    }
+
+    // The bound of an inner node is exactly the union of its children's
+    // (already refitted) bounds.
+    node->Bound().Clear();
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      node->Bound() |= node->ChildPtr(i)->Bound();
+  }
+
+  // Any growth of the bound is drift relative to the geometry the tree was
+  // originally built for; shrinkage never hurts the partitioning.
+  const double newDiameter = (double) node->Bound().Diameter();
+  if (newDiameter > oldDiameter)
+  {
+    drift = std::max(drift, (oldDiameter > 0.0) ?
+        (newDiameter - oldDiameter) / oldDiameter : 1.0);
+  }
+
+  // Refresh the statistic now that the bounds of this node and all of its
+  // refitted descendants are final.
+  typedef typename std::remove_reference<decltype(node->Stat())>::type
+      StatisticType;
+  node->Stat() = StatisticType(*node);
+
+  return drift;
+}
+
+} // namespace refit
+
+/**
+ * Refit a built tree after the points with the given indices have been
+ * modified in place (through tree.Dataset()).  Only the root-to-leaf paths
+ * containing a modified point are visited: leaf bounds are recomputed from
+ * their points, inner bounds are rebuilt as the union of their children, and
+ * every visited node's StatisticType is reconstructed bottom-up.
+ *
+ * This requires a tree whose nodes hold contiguous point ranges exposed via
+ * Begin() and Count()---the BinarySpaceTree family and the Octree qualify.
+ * The indices refer to columns of tree.Dataset(), i.e. to the reordered
+ * dataset held by the tree, not to the ordering of the original input matrix.
+ *
+ * The return value reports whether the refit degraded the tree enough to
+ * warrant a rebuild: the largest relative diameter growth over all refitted
+ * bounds is compared against rebuildThreshold.  Points that drift within
+ * their old bounds cost nothing; points that push bounds outward make
+ * overlapping regions and looser prunes, which a rebuild would repair.
+ *
+ * @param tree Tree to refit (modified in place).
+ * @param changedPoints Column indices of the modified points.
+ * @param rebuildThreshold Relative bound growth above which a rebuild is
+ *     recommended (default 0.1).
+ * @return True if the accumulated drift exceeds rebuildThreshold and the tree
+ *     should be rebuilt.
+ */
+template<typename TreeType>
+bool RefitTree(TreeType& tree,
+               const std::vector<size_t>& changedPoints,
+               const double rebuildThreshold = 0.1)
+{
+  if (changedPoints.empty())
+    return false;
+
+  // Sort the indices and drop any that are not held by this tree.
+  std::vector<size_t> changed(changedPoints);
+  std::sort(changed.begin(), changed.end());
+
+  const size_t treeBegin = tree.Begin();
+  const size_t treeEnd = treeBegin + tree.Count();
+  const size_t first = std::lower_bound(changed.begin(), changed.end(),
+      treeBegin) - changed.begin();
+  const size_t last = std::lower_bound(changed.begin(), changed.end(),
+      treeEnd) - changed.begin();
+
+  if (first >= last)
+    return false;
+
+  const double drift = refit::RefitNodeImpl(&tree, changed, first, last);
+  return (drift > rebuildThreshold);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_REFIT_TREE_HPP
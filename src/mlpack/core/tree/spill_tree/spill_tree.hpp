@@ -128,6 +128,12 @@ class SpillTree
   template<typename RuleType, bool Defeatist = false>
   class SpillDualTreeTraverser;
 
+  //! A two-phase single-tree traverser for hybrid spill trees: greedy descent
+  //! to a leaf, full leaf scan, then bounded backtracking; see
+  //! spill_two_phase_single_tree_traverser.hpp for implementation.
+  template<typename RuleType>
+  class SpillTwoPhaseSingleTreeTraverser;
+
  public:
   //! A single-tree traverser for hybrid spill trees.
   template<typename RuleType>
@@ -137,6 +143,12 @@ class SpillTree
   template<typename RuleType>
   using DefeatistSingleTreeTraverser = SpillSingleTreeTraverser<RuleType, true>;
 
+  //! A two-phase (greedy descent plus bounded backtracking) single-tree
+  //! traverser for hybrid spill trees.
+  template<typename RuleType>
+  using TwoPhaseSingleTreeTraverser = SpillTwoPhaseSingleTreeTraverser<
+      RuleType>;
+
   //! A dual-tree traverser for hybrid spill trees.
   template<typename RuleType>
   using DualTreeTraverser = SpillDualTreeTraverser<RuleType, false>;
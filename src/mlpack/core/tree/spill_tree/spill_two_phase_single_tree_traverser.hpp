@@ -0,0 +1,82 @@
+/**
+ * @file spill_two_phase_single_tree_traverser.hpp
+ *
+ * A nested class of SpillTree which traverses the tree in two phases: a
+ * greedy descent straight to the most promising leaf, a full scan of that
+ * leaf, and then bounded backtracking over the skipped siblings, which the
+ * tight candidate bound established by the leaf scan usually prunes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPILL_TREE_SPILL_TWO_PHASE_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_SPILL_TREE_SPILL_TWO_PHASE_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "spill_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+    SpillTwoPhaseSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the two-phase single tree traverser with the given rule set.
+   */
+  SpillTwoPhaseSingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given point. The first phase descends greedily
+   * to a leaf, deciding each node with a single best-child test (a hyperplane
+   * test for the overlapping splits of spill trees), and runs the base case
+   * on every point of that leaf. The second phase walks the recorded path
+   * back up and recurses into a skipped sibling only if its score against the
+   * candidate bound demands it.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, SpillTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+ private:
+  /**
+   * Recurse into a sibling skipped by the greedy descent, with the standard
+   * depth-first score/rescore order.
+   *
+   * @param queryIndex The index of the query point.
+   * @param referenceNode The subtree to refine.
+   */
+  void Refine(const size_t queryIndex, SpillTree& referenceNode);
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "spill_two_phase_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file spill_two_phase_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the two-phase (greedy descent plus bounded backtracking)
+ * single tree traverser for spill trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPILL_TREE_SPILL_TWO_PHASE_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_SPILL_TREE_SPILL_TWO_PHASE_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spill_two_phase_single_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillTwoPhaseSingleTreeTraverser<RuleType>::SpillTwoPhaseSingleTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillTwoPhaseSingleTreeTraverser<RuleType>::Traverse(
+    const size_t queryIndex,
+    SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>&
+        referenceNode)
+{
+  // Phase one: greedy descent. Each node costs a single best-child test, and
+  // the path is recorded for the refinement phase.
+  std::vector<std::pair<SpillTree*, size_t>> path;
+
+  SpillTree* current = &referenceNode;
+  while (!current->IsLeaf())
+  {
+    const size_t bestChild = rule.GetBestChild(queryIndex, *current);
+    path.push_back(std::make_pair(current, bestChild));
+    current = &current->Child(bestChild);
+  }
+
+  // Scan the reached leaf; its points are stored contiguously, so this is a
+  // tight loop over the candidate bound updates.
+  for (size_t i = 0; i < current->NumPoints(); ++i)
+    rule.BaseCase(queryIndex, current->Point(i));
+
+  // Phase two: bounded backtracking. The leaf scan usually leaves a tight
+  // candidate bound, so most skipped siblings are pruned by their score
+  // without being visited. Siblings are revisited deepest first, since they
+  // are closest to the query and tighten the bound fastest.
+  for (size_t i = path.size(); i > 0; --i)
+  {
+    SpillTree& sibling = path[i - 1].first->Child(1 - path[i - 1].second);
+
+    const double score = rule.Score(queryIndex, sibling);
+    if (score == DBL_MAX)
+      ++numPrunes;
+    else
+      Refine(queryIndex, sibling);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillTwoPhaseSingleTreeTraverser<RuleType>::Refine(
+    const size_t queryIndex,
+    SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>&
+        referenceNode)
+{
+  // If we are a leaf, run the base case as necessary.
+  if (referenceNode.IsLeaf())
+  {
+    for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+      rule.BaseCase(queryIndex, referenceNode.Point(i));
+  }
+  else
+  {
+    // If either score is DBL_MAX, we do not recurse into that node.
+    double leftScore = rule.Score(queryIndex, *referenceNode.Left());
+    double rightScore = rule.Score(queryIndex, *referenceNode.Right());
+
+    if (leftScore < rightScore)
+    {
+      // Recurse to the left.
+      Refine(queryIndex, *referenceNode.Left());
+
+      // Is it still valid to recurse to the right?
+      rightScore = rule.Rescore(queryIndex, *referenceNode.Right(),
+          rightScore);
+
+      if (rightScore != DBL_MAX)
+        Refine(queryIndex, *referenceNode.Right());
+      else
+        ++numPrunes;
+    }
+    else if (rightScore < leftScore)
+    {
+      // Recurse to the right.
+      Refine(queryIndex, *referenceNode.Right());
+
+      // Is it still valid to recurse to the left?
+      leftScore = rule.Rescore(queryIndex, *referenceNode.Left(), leftScore);
+
+      if (leftScore != DBL_MAX)
+        Refine(queryIndex, *referenceNode.Left());
+      else
+        ++numPrunes;
+    }
+    else // leftScore is equal to rightScore.
+    {
+      if (leftScore == DBL_MAX)
+      {
+        numPrunes += 2; // Pruned both left and right.
+      }
+      else
+      {
+        // Choose the left first.
+        Refine(queryIndex, *referenceNode.Left());
+
+        // Is it still valid to recurse to the right?
+        rightScore = rule.Rescore(queryIndex, *referenceNode.Right(),
+            rightScore);
+
+        if (rightScore != DBL_MAX)
+          Refine(queryIndex, *referenceNode.Right());
+        else
+          ++numPrunes;
+      }
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file alloc_tracker.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the allocation tracker.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "alloc_tracker.hpp"
+#include "profile.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+using namespace mlpack;
+using namespace std;
+
+namespace {
+
+//! Running totals for one zone.
+struct ZoneTotals
+{
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+//! Global tracker state.  The enabled flag is checked on every allocation, so
+//! it is atomic and checked before the mutex is touched; the totals map is
+//! only accessed under the mutex.
+struct TrackerState
+{
+  atomic<bool> enabled{false};
+  mutex stateMutex;
+  unordered_map<size_t, ZoneTotals> zoneTotals;
+};
+
+TrackerState& State()
+{
+  static TrackerState state;
+  return state;
+}
+
+} // namespace
+
+void AllocTracker::Enable()
+{
+  State().enabled = true;
+}
+
+void AllocTracker::Disable()
+{
+  State().enabled = false;
+}
+
+bool AllocTracker::Enabled()
+{
+  return State().enabled;
+}
+
+void AllocTracker::Reset()
+{
+  TrackerState& state = State();
+  lock_guard<mutex> lock(state.stateMutex);
+  state.zoneTotals.clear();
+}
+
+vector<AllocTracker::ZoneStats> AllocTracker::TopZones(const size_t maxZones)
+{
+  vector<ZoneStats> result;
+
+  {
+    TrackerState& state = State();
+    lock_guard<mutex> lock(state.stateMutex);
+    result.reserve(state.zoneTotals.size());
+    for (const auto& it : state.zoneTotals)
+    {
+      result.push_back({ Profile::ZoneName(it.first), it.second.count,
+          it.second.bytes });
+    }
+  }
+
+  sort(result.begin(), result.end(),
+      [](const ZoneStats& a, const ZoneStats& b) { return a.bytes > b.bytes; });
+
+  if (result.size() > maxZones)
+    result.resize(maxZones);
+  return result;
+}
+
+void AllocTracker::Report(const size_t maxZones)
+{
+  const vector<ZoneStats> zones = TopZones(maxZones);
+  if (zones.empty())
+    return;
+
+  Log::Info << "Top allocating zones:" << endl;
+  for (const ZoneStats& zone : zones)
+  {
+    Log::Info << "  " << zone.name << ": " << zone.bytes << " bytes in "
+        << zone.count << " allocations" << endl;
+  }
+}
+
+void* util::TrackedMemoryAlloc(const std::size_t nBytes)
+{
+  TrackerState& state = State();
+  if (state.enabled)
+  {
+    const size_t zone = Profile::ActiveZone();
+    lock_guard<mutex> lock(state.stateMutex);
+    ZoneTotals& totals = state.zoneTotals[zone];
+    ++totals.count;
+    totals.bytes += nBytes;
+  }
+
+  return malloc(nBytes);
+}
+
+void util::TrackedMemoryFree(void* mem)
+{
+  free(mem);
+}
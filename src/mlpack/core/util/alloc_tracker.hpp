@@ -0,0 +1,111 @@
+/**
+ * @file alloc_tracker.hpp
+ * @author Ryan Curtin
+ *
+ * An opt-in tracker for Armadillo heap allocations.  Hidden matrix temporaries
+ * are a recurring performance problem, and timers alone cannot show where they
+ * come from.  When mlpack is built with -DMLPACK_TRACK_ALLOCATIONS, Armadillo's
+ * memory path is routed through TrackedMemoryAlloc()/TrackedMemoryFree() (see
+ * arma_extend.hpp), and each allocation is attributed to the innermost open
+ * profiling zone (see profile.hpp), so that the top allocating zones can be
+ * reported alongside the timer output.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ALLOC_TRACKER_HPP
+#define MLPACK_CORE_UTIL_ALLOC_TRACKER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * Records the number and total size of Armadillo allocations, keyed by the
+ * profiling zone that was active when each allocation happened.  Allocations
+ * made outside any Profile zone are collected under "(no zone)".
+ *
+ * Tracking is off by default; call Enable() around the code to be measured and
+ * then Report() (or TopZones() for programmatic access) afterwards.  Note that
+ * the Armadillo hooks are only in place when mlpack was compiled with
+ * -DMLPACK_TRACK_ALLOCATIONS; without that flag, enabling the tracker records
+ * nothing.
+ *
+ * @code
+ * AllocTracker::Enable();
+ * {
+ *   Profile zone("search");
+ *   knn.Search(5, neighbors, distances);
+ * }
+ * AllocTracker::Report();  // Top allocating zones, via Log::Info.
+ * AllocTracker::Disable();
+ * @endcode
+ */
+class AllocTracker
+{
+ public:
+  //! Allocation totals for one profiling zone.
+  struct ZoneStats
+  {
+    //! Registered name of the zone.
+    std::string name;
+    //! Number of allocations attributed to the zone.
+    size_t count;
+    //! Total bytes allocated in the zone.
+    size_t bytes;
+  };
+
+  //! Start recording allocations.
+  static void Enable();
+
+  //! Stop recording allocations.  Collected statistics are kept.
+  static void Disable();
+
+  //! Get whether or not allocations are currently being recorded.
+  static bool Enabled();
+
+  //! Discard all collected statistics.
+  static void Reset();
+
+  /**
+   * Get the zones with the largest allocated byte totals, in decreasing
+   * order.
+   *
+   * @param maxZones Maximum number of zones to return.
+   */
+  static std::vector<ZoneStats> TopZones(const size_t maxZones = 10);
+
+  /**
+   * Print the top allocating zones via Log::Info.  If no allocations have
+   * been recorded, nothing is printed.
+   *
+   * @param maxZones Maximum number of zones to print.
+   */
+  static void Report(const size_t maxZones = 10);
+};
+
+namespace util {
+
+/**
+ * Allocate nBytes of memory, recording the allocation against the active
+ * profiling zone if tracking is enabled.  Installed as Armadillo's
+ * ARMA_ALIEN_MEM_ALLOC_FUNCTION when mlpack is built with
+ * -DMLPACK_TRACK_ALLOCATIONS.
+ */
+void* TrackedMemoryAlloc(const std::size_t nBytes);
+
+/**
+ * Free memory obtained from TrackedMemoryAlloc().  Installed as Armadillo's
+ * ARMA_ALIEN_MEM_FREE_FUNCTION when mlpack is built with
+ * -DMLPACK_TRACK_ALLOCATIONS.
+ */
+void TrackedMemoryFree(void* mem);
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_ALLOC_TRACKER_HPP
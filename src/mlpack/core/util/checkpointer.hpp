@@ -0,0 +1,190 @@
+/**
+ * @file checkpointer.hpp
+ * @author Ryan Curtin
+ *
+ * Asynchronous double-buffered checkpointing of a parameter matrix during
+ * training.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_CHECKPOINTER_HPP
+#define MLPACK_CORE_UTIL_CHECKPOINTER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/save.hpp>
+
+#include <cstdio>
+#include <thread>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Periodically checkpoint a parameter matrix to disk during a long training
+ * run without stalling the training loop for the write.  Taking a checkpoint
+ * only copies the parameters into a preallocated shadow buffer; the
+ * serialization and the disk write then happen on a background thread while
+ * training continues.  Two shadow buffers alternate, so a new snapshot can be
+ * taken while the previous one is still being written, and the training
+ * thread only ever waits if a write is slower than a whole checkpoint
+ * interval.
+ *
+ * Each checkpoint is written to a temporary file and then renamed over the
+ * target, so a crash in the middle of a write never destroys the previous
+ * checkpoint.  The format follows the extension of the given filename, as
+ * with data::Save(); use '.bin' for the binary format.
+ *
+ * The class is also an ensmallen-compatible callback: passed to an
+ * optimizer, it checkpoints the coordinates at the end of every 'interval'
+ * epochs and once more when optimization ends.  For training loops that do
+ * not go through an ensmallen optimizer (such as AMF::Apply()), call
+ * Checkpoint() directly at the end of each iteration.
+ *
+ * @tparam MatType Type of the parameter matrix to checkpoint.
+ */
+template<typename MatType = arma::mat>
+class Checkpointer
+{
+ public:
+  /**
+   * Construct a checkpointer writing to the given file.
+   *
+   * @param filename Name of the file to write checkpoints to; the extension
+   *                 selects the format (use '.bin' for binary).
+   * @param interval Number of epochs between checkpoints, when used as an
+   *                 ensmallen callback.
+   */
+  Checkpointer(const std::string& filename, const size_t interval = 1) :
+      filename(filename),
+      interval(interval),
+      current(0)
+  { /* Nothing to do here. */ }
+
+  //! Wait for any write still in flight before destruction.
+  ~Checkpointer()
+  {
+    if (writer.joinable())
+      writer.join();
+  }
+
+  //! Checkpointers hold a running thread, so they cannot be copied.
+  Checkpointer(const Checkpointer&) = delete;
+  Checkpointer& operator=(const Checkpointer&) = delete;
+
+  /**
+   * Take a checkpoint of the given parameters.  The parameters are copied
+   * into a shadow buffer on the calling thread (a memcpy, the only pause the
+   * training loop sees), and the write to disk happens on a background
+   * thread.
+   *
+   * @param parameters Parameter matrix to checkpoint.
+   */
+  void Checkpoint(const MatType& parameters)
+  {
+    // The copy into the idle shadow buffer can overlap with a write of the
+    // other buffer that is still in flight.  The buffers keep their
+    // allocations across checkpoints.
+    shadow[current] = parameters;
+
+    // The previous write must have finished before a new one starts, since
+    // both target the same file.
+    if (writer.joinable())
+      writer.join();
+
+    writer = std::thread(&Checkpointer::Write, this, current);
+    current = 1 - current;
+  }
+
+  /**
+   * Ensmallen callback: checkpoint the coordinates at the end of every
+   * 'interval' epochs.
+   */
+  template<typename OptimizerType, typename FunctionType>
+  void EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& coordinates,
+                const size_t epoch,
+                const double /* objective */)
+  {
+    if (interval > 0 && epoch % interval == 0)
+      Checkpoint(coordinates);
+  }
+
+  /**
+   * Ensmallen callback: checkpoint the final coordinates when optimization
+   * ends.
+   */
+  template<typename OptimizerType, typename FunctionType>
+  void EndOptimization(OptimizerType& /* optimizer */,
+                       FunctionType& /* function */,
+                       MatType& coordinates)
+  {
+    Checkpoint(coordinates);
+  }
+
+  /**
+   * Wait until the last requested checkpoint has been written to disk.
+   */
+  void Finish()
+  {
+    if (writer.joinable())
+      writer.join();
+  }
+
+  //! Get the checkpoint filename.
+  const std::string& Filename() const { return filename; }
+
+  //! Get the checkpoint interval (in epochs).
+  size_t Interval() const { return interval; }
+
+  //! Modify the checkpoint interval (in epochs).
+  size_t& Interval() { return interval; }
+
+ private:
+  /**
+   * Write the given shadow buffer to disk.  Runs on the background thread.
+   * The checkpoint is written to a temporary file first and renamed into
+   * place, so an interrupted write leaves the previous checkpoint intact.
+   *
+   * @param buffer Index of the shadow buffer to write.
+   */
+  void Write(const size_t buffer)
+  {
+    const std::string tempName = filename + ".tmp";
+    if (!data::Save(tempName, shadow[buffer], false, false))
+    {
+      Log::Warn << "Checkpointer: could not write checkpoint to '" << tempName
+          << "'!" << std::endl;
+      return;
+    }
+
+    if (std::rename(tempName.c_str(), filename.c_str()) != 0)
+    {
+      Log::Warn << "Checkpointer: could not move checkpoint into place at '"
+          << filename << "'!" << std::endl;
+    }
+  }
+
+  //! Name of the file checkpoints are written to.
+  std::string filename;
+
+  //! Number of epochs between checkpoints (as an ensmallen callback).
+  size_t interval;
+
+  //! The two shadow buffers the parameters are snapshotted into.
+  MatType shadow[2];
+
+  //! Index of the shadow buffer the next snapshot will use.
+  size_t current;
+
+  //! Background thread performing the write of the other shadow buffer.
+  std::thread writer;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
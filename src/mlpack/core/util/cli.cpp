@@ -30,6 +30,18 @@ using namespace mlpack::util;
 static ProgramDoc emptyProgramDoc = ProgramDoc("", "", []() { return ""; },
     {});
 
+/**
+ * Return the queue of registrations that have not been run yet.  A
+ * function-local static is used so that AddRegistrar() can safely be called
+ * from static initializers in any translation unit, regardless of
+ * initialization order.
+ */
+static std::vector<std::function<void()>>& PendingRegistrars()
+{
+  static std::vector<std::function<void()>> pending;
+  return pending;
+}
+
 /* Constructors, Destructors, Copy */
 /* Make the constructor private, to preclude unauthorized instances */
 CLI::CLI() : didParse(false), doc(&emptyProgramDoc)
@@ -119,10 +131,34 @@ bool CLI::HasParam(const std::string& key)
   return (parameters.at(checkKey).wasPassed > 0);
 }
 
+// Enqueue a registration to be run the first time the singleton is used.
+void CLI::AddRegistrar(std::function<void()> func)
+{
+  PendingRegistrars().push_back(std::move(func));
+}
+
+// Run any deferred registrations.
+void CLI::ActivatePending()
+{
+  // The registration callbacks themselves access the singleton (via Add() and
+  // the function map); guard against re-entrant activation while they run.
+  static bool activating = false;
+  if (activating)
+    return;
+
+  activating = true;
+  std::vector<std::function<void()>>& pending = PendingRegistrars();
+  for (size_t i = 0; i < pending.size(); ++i)
+    pending[i]();
+  pending.clear();
+  activating = false;
+}
+
 // Returns the sole instance of this class.
 CLI& CLI::GetSingleton()
 {
   static CLI singleton;
+  ActivatePending();
   return singleton;
 }
 
@@ -14,10 +14,12 @@
 #ifndef MLPACK_CORE_UTIL_CLI_HPP
 #define MLPACK_CORE_UTIL_CLI_HPP
 
+#include <functional>
 #include <list>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <boost/any.hpp>
 
@@ -174,6 +176,18 @@ class CLI
    */
   static void Add(util::ParamData&& d);
 
+  /**
+   * Enqueue a parameter registration to be run lazily, the first time the CLI
+   * singleton is actually used.  The binding option constructors run at static
+   * initialization time in every binding binary; deferring the map insertions,
+   * function-table setup, and duplicate checks to first use keeps the pre-main
+   * cost of each registered parameter to a single enqueued callback.
+   *
+   * @param func Callback performing the full registration (typically calling
+   *     Add() and filling the function map).
+   */
+  static void AddRegistrar(std::function<void()> func);
+
   /**
    * See if the specified flag was found while parsing.
    *
@@ -312,6 +326,13 @@ class CLI
   util::ProgramDoc* doc;
 
  private:
+  /**
+   * Run (and clear) any registrations enqueued with AddRegistrar().  Called
+   * whenever the singleton is accessed; re-entrant calls made by the
+   * registration callbacks themselves are no-ops.
+   */
+  static void ActivatePending();
+
   /**
    * Make the constructor private, to preclude unauthorized instances.
    */
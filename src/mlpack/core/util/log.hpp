@@ -18,6 +18,34 @@
 #include "prefixedoutstream.hpp"
 #include "nulloutstream.hpp"
 
+//! Log nothing but fatal errors.
+#define MLPACK_LOG_LEVEL_FATAL 0
+//! Log warnings and fatal errors.
+#define MLPACK_LOG_LEVEL_WARN 1
+//! Log informational messages, warnings and fatal errors.
+#define MLPACK_LOG_LEVEL_INFO 2
+//! Log everything, including debugging output.
+#define MLPACK_LOG_LEVEL_DEBUG 3
+
+/**
+ * The compile-time log level.  Streams for levels above MLPACK_LOG_LEVEL are
+ * NullOutStream objects, whose operator<<() overloads are empty inline
+ * functions, so logging statements at disabled levels compile to nothing and
+ * cost no string assembly in hot paths.  Log::Fatal cannot be disabled, since
+ * it is used to terminate the program.
+ *
+ * If MLPACK_LOG_LEVEL is not set at compilation time, the level defaults to
+ * MLPACK_LOG_LEVEL_DEBUG in debug mode and MLPACK_LOG_LEVEL_INFO otherwise,
+ * matching the historical behavior of Log::Debug.
+ */
+#ifndef MLPACK_LOG_LEVEL
+  #ifdef DEBUG
+    #define MLPACK_LOG_LEVEL MLPACK_LOG_LEVEL_DEBUG
+  #else
+    #define MLPACK_LOG_LEVEL MLPACK_LOG_LEVEL_INFO
+  #endif
+#endif
+
 namespace mlpack {
 
 /**
@@ -69,9 +97,9 @@ class Log
    * exported by the Windows compiler.
    */
 
-  // We only use PrefixedOutStream if the program is compiled with debug
-  // symbols.
-#ifdef DEBUG
+  // We only use PrefixedOutStream for levels enabled by MLPACK_LOG_LEVEL;
+  // disabled levels get a NullOutStream, which compiles to nothing.
+#if defined(DEBUG) && MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_DEBUG
   //! Prints debug output with the appropriate tag: [DEBUG].
   static MLPACK_EXPORT util::PrefixedOutStream Debug;
 #else
@@ -79,12 +107,22 @@ class Log
   static MLPACK_EXPORT util::NullOutStream Debug;
 #endif
 
+#if MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_INFO
   //! Prints informational messages if --verbose is specified, prefixed with
   //! [INFO ].
   static MLPACK_EXPORT util::PrefixedOutStream Info;
+#else
+  //! Informational messages are compiled out.
+  static MLPACK_EXPORT util::NullOutStream Info;
+#endif
 
+#if MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_WARN
   //! Prints warning messages prefixed with [WARN ].
   static MLPACK_EXPORT util::PrefixedOutStream Warn;
+#else
+  //! Warning messages are compiled out.
+  static MLPACK_EXPORT util::NullOutStream Warn;
+#endif
 
   //! Prints fatal messages prefixed with [FATAL], then terminates the program.
   static MLPACK_EXPORT util::PrefixedOutStream Fatal;
@@ -56,6 +56,7 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/serve_binding.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
@@ -69,6 +70,20 @@ int main(int argc, char** argv)
   // A "total_time" timer is run by default for each mlpack program.
   mlpack::Timer::Start("total_time");
 
+#ifndef _WIN32
+  if (mlpack::CLI::HasParam("serve"))
+  {
+    // Model server mode: answer framed matrix requests over a Unix domain
+    // socket, running the binding once per request.  Models loaded on the
+    // first request stay resident between requests.
+    mlpack::bindings::cli::ServeBinding(&mlpackMain,
+        mlpack::CLI::GetParam<std::string>("serve"));
+
+    mlpack::bindings::cli::EndProgram();
+    return 0;
+  }
+#endif
+
   mlpackMain();
 
   // Print output options, print verbose information, save model parameters,
@@ -30,12 +30,16 @@ class NullOutStream
   /**
    * Does nothing.
    */
-  NullOutStream() { }
+  NullOutStream() : ignoreInput(false) { }
 
   /**
    * Does nothing.
    */
-  NullOutStream(const NullOutStream& /* other */) { }
+  NullOutStream(const NullOutStream& /* other */) : ignoreInput(false) { }
+
+  //! Never read; this only exists so that code toggling the verbosity of a
+  //! stream still compiles when that stream's level is compiled out.
+  bool ignoreInput;
 
   //! Does nothing.
   NullOutStream& operator<<(bool) { return *this; }
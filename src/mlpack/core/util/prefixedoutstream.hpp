@@ -155,6 +155,30 @@ class PrefixedOutStream
    */
   inline void PrefixIfNeeded();
 
+  /**
+   * Output a block of already-converted text, printing the prefix at the start
+   * of each line.  When Buffering() is true, each line is assembled in a
+   * per-thread buffer and handed to the destination stream as a single write,
+   * so that lines written by concurrent threads do not interleave mid-line;
+   * partial lines stay buffered until their newline arrives.
+   *
+   * @param line The converted text to output.
+   * @param newlined Set to true if a newline was output.
+   */
+  inline void OutputLines(const std::string& line, bool& newlined);
+
+  /**
+   * Whether output should go through the per-thread line buffers.  This is
+   * true inside an OpenMP parallel region, except for fatal streams, which
+   * must throw immediately.
+   */
+  inline bool Buffering() const;
+
+  /**
+   * Return the partial-line buffer of the calling thread for this stream.
+   */
+  inline std::string& ThreadBuffer() const;
+
   //! Contains the prefix we must prepend to each line.
   std::string prefix;
 
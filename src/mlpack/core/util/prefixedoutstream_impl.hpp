@@ -20,7 +20,12 @@
   #include "backtrace.hpp"
 #endif
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 #include <iostream>
+#include <map>
 #include <sstream>
 
 namespace mlpack {
@@ -43,8 +48,10 @@ PrefixedOutStream::BaseLogic(const T& val)
   bool newlined = false;
   std::string line;
 
-  // If we need to, output the prefix.
-  PrefixIfNeeded();
+  // If we need to, output the prefix.  When buffering, OutputLines() instead
+  // prepends the prefix to the calling thread's line buffer.
+  if (!Buffering())
+    PrefixIfNeeded();
 
   std::ostringstream convert;
   // Sync flags and precision with destination stream
@@ -78,31 +85,7 @@ PrefixedOutStream::BaseLogic(const T& val)
     }
 
     // Now, we need to check for newlines in the output and print it.
-    size_t nl;
-    size_t pos = 0;
-    while ((nl = line.find('\n', pos)) != std::string::npos)
-    {
-      PrefixIfNeeded();
-
-      // Only output if the user wants it.
-      if (!ignoreInput)
-      {
-        destination << line.substr(pos, nl - pos);
-        destination << std::endl;
-      }
-
-      newlined = true; // Ensure this is set for the fatal exception if needed.
-      carriageReturned = true; // Regardless of whether or not we display it.
-
-      pos = nl + 1;
-    }
-
-    if (pos != line.length()) // We need to display the rest.
-    {
-      PrefixIfNeeded();
-      if (!ignoreInput)
-        destination << line.substr(pos);
-    }
+    OutputLines(line, newlined);
   }
 
   // If we displayed a newline and we need to throw afterwards, do that.
@@ -154,8 +137,10 @@ PrefixedOutStream::BaseLogic(const T& val)
   bool newlined = false;
   std::string line;
 
-  // If we need to, output the prefix.
-  PrefixIfNeeded();
+  // If we need to, output the prefix.  When buffering, OutputLines() instead
+  // prepends the prefix to the calling thread's line buffer.
+  if (!Buffering())
+    PrefixIfNeeded();
 
   std::ostringstream convert;
 
@@ -211,31 +196,7 @@ PrefixedOutStream::BaseLogic(const T& val)
     }
 
     // Now, we need to check for newlines in the output and print it.
-    size_t nl;
-    size_t pos = 0;
-    while ((nl = line.find('\n', pos)) != std::string::npos)
-    {
-      PrefixIfNeeded();
-
-      // Only output if the user wants it.
-      if (!ignoreInput)
-      {
-        destination << line.substr(pos, nl - pos);
-        destination << std::endl;
-      }
-
-      newlined = true; // Ensure this is set for the fatal exception if needed.
-      carriageReturned = true; // Regardless of whether or not we display it.
-
-      pos = nl + 1;
-    }
-
-    if (pos != line.length()) // We need to display the rest.
-    {
-      PrefixIfNeeded();
-      if (!ignoreInput)
-        destination << line.substr(pos);
-    }
+    OutputLines(line, newlined);
   }
 
   // If we displayed a newline and we need to throw afterwards, do that.
@@ -287,6 +248,93 @@ void PrefixedOutStream::PrefixIfNeeded()
   }
 }
 
+// This is an inline function (that is why it is here and not in .cc).
+void PrefixedOutStream::OutputLines(const std::string& line, bool& newlined)
+{
+  size_t nl;
+  size_t pos = 0;
+
+  if (Buffering())
+  {
+    // Assemble each line in the calling thread's buffer, then hand complete
+    // lines to the destination stream as a single write so that concurrent
+    // threads do not interleave output mid-line.  The shared carriageReturned
+    // flag is deliberately left untouched here; each thread's prefix handling
+    // is driven by whether its own buffer is empty.
+    std::string& buffer = ThreadBuffer();
+    while ((nl = line.find('\n', pos)) != std::string::npos)
+    {
+      if (buffer.empty())
+        buffer = prefix;
+      buffer.append(line, pos, nl - pos);
+      buffer += '\n';
+
+      // Only output if the user wants it.
+      if (!ignoreInput)
+        destination << buffer;
+
+      buffer.clear();
+      newlined = true; // Ensure this is set for the fatal exception if needed.
+
+      pos = nl + 1;
+    }
+
+    if (pos != line.length()) // Buffer the rest until its newline arrives.
+    {
+      if (buffer.empty())
+        buffer = prefix;
+      buffer.append(line, pos, std::string::npos);
+    }
+
+    return;
+  }
+
+  while ((nl = line.find('\n', pos)) != std::string::npos)
+  {
+    PrefixIfNeeded();
+
+    // Only output if the user wants it.
+    if (!ignoreInput)
+    {
+      destination << line.substr(pos, nl - pos);
+      destination << std::endl;
+    }
+
+    newlined = true; // Ensure this is set for the fatal exception if needed.
+    carriageReturned = true; // Regardless of whether or not we display it.
+
+    pos = nl + 1;
+  }
+
+  if (pos != line.length()) // We need to display the rest.
+  {
+    PrefixIfNeeded();
+    if (!ignoreInput)
+      destination << line.substr(pos);
+  }
+}
+
+// This is an inline function (that is why it is here and not in .cc).
+bool PrefixedOutStream::Buffering() const
+{
+#ifdef HAS_OPENMP
+  // Fatal streams must throw as soon as their newline arrives, so they are
+  // never buffered.
+  return !fatal && (omp_in_parallel() != 0);
+#else
+  return false;
+#endif
+}
+
+// This is an inline function (that is why it is here and not in .cc).
+std::string& PrefixedOutStream::ThreadBuffer() const
+{
+  // One partial-line buffer per (thread, stream) pair; the function-local
+  // thread_local avoids any locking or static initialization order issues.
+  static thread_local std::map<const PrefixedOutStream*, std::string> buffers;
+  return buffers[this];
+}
+
 } // namespace util
 } // namespace mlpack
 
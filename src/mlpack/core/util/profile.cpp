@@ -0,0 +1,174 @@
+/**
+ * @file profile.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the scoped profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "profile.hpp"
+#include "cli.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+namespace {
+
+//! Totals collected by one thread: inclusive microseconds per zone ID.
+struct ThreadTotals
+{
+  vector<int64_t> micros;
+};
+
+//! Global profiler state: the zone name registry and the list of per-thread
+//! totals buffers.  Only interning, thread registration, and aggregation
+//! touch this (under the mutex); zone recording itself never does.
+struct ProfileState
+{
+  mutex stateMutex;
+  unordered_map<string, size_t> zoneIds;
+  vector<string> zoneNames;
+  vector<ThreadTotals*> threadTotals;
+};
+
+ProfileState& State()
+{
+  static ProfileState state;
+  return state;
+}
+
+//! The calling thread's totals buffer, registered with the global state on
+//! first use.  The buffer deliberately leaks at thread exit: aggregation may
+//! run after worker threads have finished, and the buffers are tiny.
+ThreadTotals& LocalTotals()
+{
+  thread_local ThreadTotals* totals = nullptr;
+  if (totals == nullptr)
+  {
+    totals = new ThreadTotals();
+    lock_guard<mutex> lock(State().stateMutex);
+    State().threadTotals.push_back(totals);
+  }
+  return *totals;
+}
+
+//! The calling thread's cache of name-address-to-zone-ID mappings, so that
+//! repeated Profile(const char*) constructions take no lock and hash no
+//! strings.
+size_t CachedZoneId(const char* name)
+{
+  thread_local unordered_map<const void*, size_t> cache;
+  unordered_map<const void*, size_t>::const_iterator it = cache.find(name);
+  if (it != cache.end())
+    return it->second;
+
+  const size_t zone = Profile::RegisterZone(name);
+  cache[name] = zone;
+  return zone;
+}
+
+//! The innermost zone currently open on the calling thread.
+size_t& ActiveZoneRef()
+{
+  thread_local size_t activeZone = Profile::noZone;
+  return activeZone;
+}
+
+} // namespace
+
+Profile::Profile(const char* name) :
+    zone(CachedZoneId(name)),
+    prevZone(ActiveZoneRef()),
+    start(high_resolution_clock::now())
+{
+  ActiveZoneRef() = zone;
+}
+
+Profile::Profile(const size_t zone) :
+    zone(zone),
+    prevZone(ActiveZoneRef()),
+    start(high_resolution_clock::now())
+{
+  ActiveZoneRef() = zone;
+}
+
+Profile::~Profile()
+{
+  const int64_t elapsed = duration_cast<microseconds>(
+      high_resolution_clock::now() - start).count();
+
+  ActiveZoneRef() = prevZone;
+
+  ThreadTotals& totals = LocalTotals();
+  if (totals.micros.size() <= zone)
+    totals.micros.resize(zone + 1, 0);
+  totals.micros[zone] += elapsed;
+}
+
+size_t Profile::ActiveZone()
+{
+  return ActiveZoneRef();
+}
+
+string Profile::ZoneName(const size_t zone)
+{
+  ProfileState& state = State();
+  lock_guard<mutex> lock(state.stateMutex);
+
+  if (zone >= state.zoneNames.size())
+    return "(no zone)";
+  return state.zoneNames[zone];
+}
+
+size_t Profile::RegisterZone(const string& name)
+{
+  ProfileState& state = State();
+  lock_guard<mutex> lock(state.stateMutex);
+
+  unordered_map<string, size_t>::const_iterator it = state.zoneIds.find(name);
+  if (it != state.zoneIds.end())
+    return it->second;
+
+  const size_t zone = state.zoneNames.size();
+  state.zoneNames.push_back(name);
+  state.zoneIds[name] = zone;
+  return zone;
+}
+
+void Profile::Aggregate()
+{
+  ProfileState& state = State();
+  lock_guard<mutex> lock(state.stateMutex);
+
+  for (size_t t = 0; t < state.threadTotals.size(); ++t)
+  {
+    ThreadTotals& totals = *state.threadTotals[t];
+    for (size_t zone = 0; zone < totals.micros.size(); ++zone)
+    {
+      if (totals.micros[zone] > 0)
+      {
+        CLI::GetSingleton().timer.AccumulateTimer(state.zoneNames[zone],
+            microseconds(totals.micros[zone]));
+      }
+      totals.micros[zone] = 0;
+    }
+  }
+}
+
+void Profile::Reset()
+{
+  ProfileState& state = State();
+  lock_guard<mutex> lock(state.stateMutex);
+
+  for (size_t t = 0; t < state.threadTotals.size(); ++t)
+    state.threadTotals[t]->micros.assign(state.threadTotals[t]->micros.size(),
+        0);
+}
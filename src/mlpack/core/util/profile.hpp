@@ -0,0 +1,132 @@
+/**
+ * @file profile.hpp
+ * @author Ryan Curtin
+ *
+ * A low-overhead scoped profiler.  Unlike Timer::Start()/Timer::Stop(), which
+ * take a global mutex and perform a map lookup by string on every call, a
+ * Profile zone records into a lock-free thread-local buffer indexed by an
+ * interned zone ID, so it is cheap enough to use inside hot loops (e.g.
+ * dual-tree traversals) and from many threads at once.  After the run,
+ * Profile::Aggregate() folds the collected totals into the regular timer
+ * reporting (Timers::GetAllTimers()).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILE_HPP
+#define MLPACK_CORE_UTIL_PROFILE_HPP
+
+#include <chrono>
+#include <string>
+
+namespace mlpack {
+
+/**
+ * A scoped profiling zone.  Construct a Profile object at the top of the
+ * scope to be measured; its destructor adds the elapsed wall-clock time to
+ * the zone's thread-local total.  Zones may be nested: each zone accumulates
+ * its own inclusive time, so a nested zone's time is also contained in its
+ * enclosing zone's total.
+ *
+ * @code
+ * void Traverse()
+ * {
+ *   Profile zone("traversal");
+ *   // ... hot code ...
+ * }
+ * @endcode
+ *
+ * For the very hottest scopes the interning lookup can be hoisted out
+ * entirely:
+ *
+ * @code
+ * static const size_t zoneId = Profile::RegisterZone("base_case");
+ * Profile zone(zoneId);
+ * @endcode
+ *
+ * Recording is lock-free: each thread owns its own totals buffer, and the
+ * name-to-ID interning result is cached per thread by string address, so
+ * after the first construction of a given zone on a given thread no locks
+ * are taken and no strings are hashed.  Call Profile::Aggregate() once the
+ * measured work is done to fold all per-thread totals into the standard
+ * timer reporting, where each zone appears under its registered name.
+ */
+class Profile
+{
+ public:
+  /**
+   * Open a profiling zone with the given name.  The name must be a string
+   * literal (or otherwise outlive all Profile objects using it), since the
+   * per-thread interning cache is keyed by its address.
+   *
+   * @param name Name of the zone.
+   */
+  explicit Profile(const char* name);
+
+  /**
+   * Open a profiling zone with an already registered zone ID.  This is the
+   * cheapest form; the ID should come from RegisterZone().
+   *
+   * @param zone Interned zone ID.
+   */
+  explicit Profile(const size_t zone);
+
+  //! Close the zone, adding the elapsed time to its thread-local total.
+  ~Profile();
+
+  /**
+   * Register (intern) a zone name, returning its ID.  Registering the same
+   * name twice returns the same ID.  This takes a lock, so hoist it out of
+   * hot loops.
+   *
+   * @param name Name of the zone.
+   * @return Interned zone ID.
+   */
+  static size_t RegisterZone(const std::string& name);
+
+  /**
+   * Fold the totals collected by all threads into the standard timer
+   * reporting (so each zone shows up in Timers::GetAllTimers() under its
+   * registered name), and clear the collected totals.  Do not call this
+   * while profiling zones are open on other threads.
+   */
+  static void Aggregate();
+
+  /**
+   * Discard all collected totals without reporting them.  Registered zone
+   * IDs remain valid.
+   */
+  static void Reset();
+
+  /**
+   * Get the ID of the innermost zone currently open on the calling thread, or
+   * noZone if none is open.  This is what the allocation tracker uses to
+   * attribute allocations to zones (see alloc_tracker.hpp).
+   */
+  static size_t ActiveZone();
+
+  /**
+   * Get the registered name of the given zone ID.  For noZone (or any
+   * unregistered ID) this returns "(no zone)".
+   *
+   * @param zone Interned zone ID.
+   */
+  static std::string ZoneName(const size_t zone);
+
+  //! Value returned by ActiveZone() when no zone is open.
+  static const size_t noZone = size_t(-1);
+
+ private:
+  //! Interned ID of this zone.
+  size_t zone;
+  //! Zone that was active when this one was opened; restored on close.
+  size_t prevZone;
+  //! Time at which the zone was opened.
+  std::chrono::high_resolution_clock::time_point start;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_PROFILE_HPP
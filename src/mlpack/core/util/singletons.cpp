@@ -31,16 +31,25 @@ using namespace mlpack::util;
   #define BASH_CLEAR ""
 #endif
 
-#ifdef DEBUG
+#if defined(DEBUG) && MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_DEBUG
 PrefixedOutStream Log::Debug = PrefixedOutStream(std::cout,
     BASH_CYAN "[DEBUG] " BASH_CLEAR);
 #else
 NullOutStream Log::Debug = NullOutStream();
 #endif
 
+#if MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_INFO
 PrefixedOutStream Log::Info = PrefixedOutStream(std::cout,
     BASH_GREEN "[INFO ] " BASH_CLEAR, true /* unless --verbose */, false);
+#else
+NullOutStream Log::Info = NullOutStream();
+#endif
+
+#if MLPACK_LOG_LEVEL >= MLPACK_LOG_LEVEL_WARN
 PrefixedOutStream Log::Warn = PrefixedOutStream(std::cout,
     BASH_YELLOW "[WARN ] " BASH_CLEAR, false, false);
+#else
+NullOutStream Log::Warn = NullOutStream();
+#endif
 PrefixedOutStream Log::Fatal = PrefixedOutStream(std::cerr,
     BASH_RED "[FATAL] " BASH_CLEAR, false, true /* fatal */);
@@ -0,0 +1,198 @@
+/**
+ * @file task_pool.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the process-wide work-stealing task pool.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "task_pool.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+namespace {
+
+//! Index of the pool worker running on this thread, or -1 on threads that
+//! do not belong to the pool.
+thread_local int workerIndex = -1;
+
+//! The shared thread budget: what OpenMP would use for a parallel region,
+//! so the pool and OpenMP regions outside it never exceed the same limit.
+size_t ThreadBudget()
+{
+#ifdef HAS_OPENMP
+  const size_t threads = (size_t) omp_get_max_threads();
+#else
+  const size_t threads = (size_t) std::thread::hardware_concurrency();
+#endif
+  return (threads == 0) ? 1 : threads;
+}
+
+} // namespace
+
+TaskPool& TaskPool::Get()
+{
+  static TaskPool pool;
+  return pool;
+}
+
+TaskPool::TaskPool() :
+    // The submitting thread executes tasks while it waits, so it occupies
+    // the last slot of the budget and one fewer worker is spawned.
+    queues(ThreadBudget() - 1),
+    queueMutexes(ThreadBudget() - 1),
+    queued(0),
+    submitIndex(0),
+    shutdown(false)
+{
+  for (size_t i = 0; i < queues.size(); ++i)
+    workers.emplace_back(&TaskPool::WorkerLoop, this, i);
+}
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    shutdown = true;
+  }
+  sleepCV.notify_all();
+  for (size_t i = 0; i < workers.size(); ++i)
+    workers[i].join();
+}
+
+void TaskPool::Submit(TaskGroup* group, std::function<void()> func)
+{
+  ++group->pending;
+
+  // With a thread budget of one there are no workers, so run inline.
+  if (queues.empty())
+  {
+    Task task { std::move(func), group };
+    Execute(task);
+    return;
+  }
+
+  // Workers push onto their own deque (popped newest-first, which keeps the
+  // working set of a nested computation cache-hot); other threads spread
+  // round-robin over the worker deques.
+  const size_t q = (workerIndex >= 0) ? (size_t) workerIndex :
+      (submitIndex++ % queues.size());
+  {
+    std::lock_guard<std::mutex> lock(queueMutexes[q]);
+    queues[q].push_back(Task { std::move(func), group });
+  }
+  ++queued;
+  sleepCV.notify_one();
+}
+
+bool TaskPool::Help()
+{
+  if (queues.empty())
+    return false;
+
+  const size_t own = (workerIndex >= 0) ? (size_t) workerIndex : 0;
+  for (size_t i = 0; i < queues.size(); ++i)
+  {
+    const size_t q = (own + i) % queues.size();
+    Task task;
+    {
+      std::lock_guard<std::mutex> lock(queueMutexes[q]);
+      if (queues[q].empty())
+        continue;
+
+      if (i == 0 && workerIndex >= 0)
+      {
+        // Newest first from our own deque.
+        task = std::move(queues[q].back());
+        queues[q].pop_back();
+      }
+      else
+      {
+        // Steal oldest first from another deque; old tasks are the roots of
+        // the largest remaining subcomputations, so stealing them moves the
+        // most work at once.
+        task = std::move(queues[q].front());
+        queues[q].pop_front();
+      }
+    }
+
+    --queued;
+    Execute(task);
+    return true;
+  }
+
+  return false;
+}
+
+void TaskPool::WorkerLoop(const size_t index)
+{
+  workerIndex = (int) index;
+
+#ifdef HAS_OPENMP
+  // OpenMP pragmas reached from inside a task serialize on this thread, so
+  // nesting an OpenMP-parallel algorithm inside a task cannot oversubscribe
+  // the shared budget.
+  omp_set_num_threads(1);
+#endif
+
+  std::unique_lock<std::mutex> lock(sleepMutex, std::defer_lock);
+  while (true)
+  {
+    if (Help())
+      continue;
+
+    lock.lock();
+    sleepCV.wait(lock, [this]() { return shutdown || queued.load() > 0; });
+    const bool stop = shutdown;
+    lock.unlock();
+    if (stop)
+      break;
+  }
+}
+
+void TaskPool::Execute(Task& task)
+{
+#ifdef HAS_OPENMP
+  // A non-worker thread (helping while it waits on a group) keeps its full
+  // OpenMP width otherwise, so clamp it for the duration of the task only.
+  const int previousWidth = omp_get_max_threads();
+  if (workerIndex < 0)
+    omp_set_num_threads(1);
+#endif
+
+  task.func();
+
+#ifdef HAS_OPENMP
+  if (workerIndex < 0)
+    omp_set_num_threads(previousWidth);
+#endif
+
+  // This decrement is what releases any thread waiting on the group, so it
+  // must be the last access to the group.
+  --task.group->pending;
+}
+
+void TaskGroup::Run(std::function<void()> func)
+{
+  TaskPool::Get().Submit(this, std::move(func));
+}
+
+void TaskGroup::Wait()
+{
+  TaskPool& pool = TaskPool::Get();
+  while (pending.load() > 0)
+  {
+    // Execute queued tasks instead of blocking; this is what makes nested
+    // groups safe with a fixed number of threads.
+    if (!pool.Help())
+      std::this_thread::yield();
+  }
+}
@@ -0,0 +1,200 @@
+/**
+ * @file task_pool.hpp
+ * @author Ryan Curtin
+ *
+ * A process-wide work-stealing task pool with nestable task groups.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_TASK_POOL_HPP
+#define MLPACK_CORE_UTIL_TASK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+class TaskGroup;
+
+/**
+ * A process-wide work-stealing task pool.  Independent OpenMP regions cannot
+ * compose: a parallel algorithm calling another parallel algorithm
+ * multiplies thread counts instead of sharing them.  The pool holds one set
+ * of worker threads for the whole process, sized to the same budget OpenMP
+ * uses, and arbitrary levels of nested parallelism submit tasks into it
+ * without ever exceeding that budget.
+ *
+ * Work is submitted through TaskGroup; tasks run on the worker threads,
+ * each of which owns a deque that it pops newest-first while idle workers
+ * steal oldest-first from the others.  A thread waiting on a group executes
+ * queued tasks itself instead of blocking, which is what makes nested
+ * groups safe: the waiting task's thread keeps working instead of holding a
+ * worker hostage.
+ *
+ * The pool shares one thread budget with OpenMP: it spawns
+ * omp_get_max_threads() - 1 workers (the submitting thread is the final
+ * slot), each worker pins its own OpenMP width to one thread, and a
+ * non-worker thread has its OpenMP width clamped to one for the duration of
+ * any task it executes while waiting.  OpenMP pragmas inside tasks
+ * therefore serialize instead of oversubscribing, and pragmas outside the
+ * pool keep the full budget.
+ */
+class TaskPool
+{
+ public:
+  //! Get the process-wide task pool, creating it on first use.
+  static TaskPool& Get();
+
+  //! Get the thread budget of the pool (workers plus the submitting
+  //! thread).
+  size_t Threads() const { return queues.size() + 1; }
+
+  //! The pool owns running threads, so it cannot be copied.
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+ private:
+  //! Spawn the workers.  Only Get() constructs a pool.
+  TaskPool();
+
+  //! Stop and join the workers.
+  ~TaskPool();
+
+  //! A queued unit of work and the group accounting for it.
+  struct Task
+  {
+    std::function<void()> func;
+    TaskGroup* group;
+  };
+
+  /**
+   * Queue one task on behalf of the given group.  Called from TaskGroup.
+   * Workers push onto their own deque; other threads distribute round-robin
+   * over the worker deques.  With a thread budget of one there are no
+   * workers and the task runs inline.
+   */
+  void Submit(TaskGroup* group, std::function<void()> func);
+
+  /**
+   * Execute one queued task if any is available: newest first from the
+   * calling worker's own deque, stolen oldest-first from the other deques
+   * otherwise.
+   *
+   * @return True if a task was executed.
+   */
+  bool Help();
+
+  //! Main loop of one worker thread.
+  void WorkerLoop(const size_t index);
+
+  //! Run a task and credit its group, clamping the OpenMP width of
+  //! non-worker threads for the duration.
+  void Execute(Task& task);
+
+  //! One work deque per worker.
+  std::vector<std::deque<Task>> queues;
+
+  //! One lock per work deque.
+  std::deque<std::mutex> queueMutexes;
+
+  //! The worker threads.
+  std::vector<std::thread> workers;
+
+  //! Lock and condition the idle workers sleep on.
+  std::mutex sleepMutex;
+  std::condition_variable sleepCV;
+
+  //! Number of tasks currently queued across all the deques.
+  std::atomic<size_t> queued;
+
+  //! Round-robin cursor for submissions from non-worker threads.
+  std::atomic<size_t> submitIndex;
+
+  //! Set once at destruction to stop the workers.
+  bool shutdown;
+
+  friend class TaskGroup;
+};
+
+/**
+ * A group of tasks submitted to the process-wide TaskPool.  Wait() (also
+ * called by the destructor) returns once every task of the group has
+ * finished; the waiting thread executes queued tasks in the meantime, so
+ * groups nest freely — a task may create its own group and wait on it
+ * without consuming an extra thread.
+ */
+class TaskGroup
+{
+ public:
+  //! Construct an empty task group on the process-wide pool.
+  TaskGroup() : pending(0) { }
+
+  //! Wait for any unfinished tasks of the group.
+  ~TaskGroup() { Wait(); }
+
+  //! The group is an accounting handle for running tasks, so it cannot be
+  //! copied.
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /**
+   * Submit one task to the pool as part of this group.
+   *
+   * @param func The work to run.
+   */
+  void Run(std::function<void()> func);
+
+  /**
+   * Wait until every task of the group has finished, executing queued tasks
+   * while waiting.
+   */
+  void Wait();
+
+ private:
+  //! Number of submitted tasks that have not finished yet.
+  std::atomic<size_t> pending;
+
+  friend class TaskPool;
+};
+
+/**
+ * Apply the given function to fixed-size blocks of the range [begin, end) in
+ * parallel on the process-wide TaskPool.  The range is always split at
+ * multiples of 'grain' from 'begin', independent of the thread budget, so
+ * any per-block computation (and any reduction combined in block order) is
+ * deterministic and reproducible across machines with different core
+ * counts.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param grain Number of indices per block.
+ * @param func Function called as func(blockBegin, blockEnd) for each block.
+ */
+template<typename FuncType>
+inline void ParallelFor(const size_t begin,
+                        const size_t end,
+                        const size_t grain,
+                        FuncType func)
+{
+  TaskGroup group;
+  for (size_t b = begin; b < end; b += grain)
+  {
+    const size_t blockEnd = std::min(end, b + grain);
+    group.Run([b, blockEnd, &func]() { func(b, blockEnd); });
+  }
+  group.Wait();
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
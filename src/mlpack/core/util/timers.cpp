@@ -88,6 +88,13 @@ microseconds Timers::GetTimer(const string& timerName)
   return timers[timerName];
 }
 
+void Timers::AccumulateTimer(const string& timerName,
+                             const microseconds duration)
+{
+  lock_guard<mutex> lock(timersMutex);
+  timers[timerName] += duration;
+}
+
 bool Timers::GetState(const string& timerName,
                       const thread::id& threadId)
 {
@@ -148,6 +148,17 @@ class Timers
   void StopTimer(const std::string& timerName,
                  const std::thread::id& threadId = std::thread::id());
 
+  /**
+   * Add the given duration to the timer with the given name, creating the
+   * timer if it does not exist yet.  This is used for post-run aggregation of
+   * externally collected timings (see Profile::Aggregate()).
+   *
+   * @param timerName The name of the timer in question.
+   * @param duration Duration to add to the timer.
+   */
+  void AccumulateTimer(const std::string& timerName,
+                       const std::chrono::microseconds duration);
+
   /**
    * Returns state of the given timer.
    *
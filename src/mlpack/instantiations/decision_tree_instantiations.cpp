@@ -0,0 +1,20 @@
+/**
+ * @file decision_tree_instantiations.cpp
+ *
+ * Explicit instantiation of the default DecisionTree configuration; see
+ * instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "instantiations.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template class DecisionTree<>;
+
+} // namespace tree
+} // namespace mlpack
@@ -0,0 +1,61 @@
+/**
+ * @file instantiations.hpp
+ *
+ * Extern template declarations for the most commonly used configurations of
+ * mlpack's template classes.  Applications that include this header (in
+ * addition to, or instead of, the individual method headers) and link against
+ * the mlpack_instantiations library will not re-instantiate these
+ * configurations in every translation unit, which significantly reduces
+ * compile time and object size.  Any other configuration keeps working
+ * exactly as before: it is simply instantiated in the including translation
+ * unit, as usual.
+ *
+ * The matching explicit instantiation definitions live in the
+ * *_instantiations.cpp files next to this header, which make up the
+ * mlpack_instantiations library target.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_INSTANTIATIONS_HPP
+#define MLPACK_INSTANTIATIONS_INSTANTIATIONS_HPP
+
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+// The configurations behind the KNN and KFN typedefs.
+extern template class NeighborSearch<NearestNeighborSort,
+                                     metric::EuclideanDistance,
+                                     arma::mat,
+                                     tree::KDTree>;
+extern template class NeighborSearch<FurthestNeighborSort,
+                                     metric::EuclideanDistance,
+                                     arma::mat,
+                                     tree::KDTree>;
+
+} // namespace neighbor
+
+namespace kmeans {
+
+// The default KMeans configuration: Euclidean distance, sample
+// initialization, max-variance empty cluster policy, naive Lloyd steps.
+extern template class KMeans<>;
+
+} // namespace kmeans
+
+namespace tree {
+
+// The default DecisionTree configuration: Gini gain with the best binary
+// numeric split and the all-categorical split.
+extern template class DecisionTree<>;
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @file neighbor_search_instantiations.cpp
+ *
+ * Explicit instantiations of the most common NeighborSearch configurations;
+ * see instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "instantiations.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template class NeighborSearch<NearestNeighborSort,
+                              metric::EuclideanDistance,
+                              arma::mat,
+                              tree::KDTree>;
+template class NeighborSearch<FurthestNeighborSort,
+                              metric::EuclideanDistance,
+                              arma::mat,
+                              tree::KDTree>;
+
+} // namespace neighbor
+} // namespace mlpack
@@ -114,6 +114,14 @@ class AdaBoost
   //! Modify the tolerance for stopping the optimization during training.
   double& Tolerance() { return tolerance; }
 
+  //! Get the fraction of points each weak learner trains on.
+  double SampleRatio() const { return sampleRatio; }
+  //! Modify the fraction of points each weak learner trains on.  When this is
+  //! less than 1, each boosting round draws that fraction of the dataset by
+  //! weight-proportional sampling (with replacement) and trains the weak
+  //! learner on the unweighted sample instead of the fully weighted dataset.
+  double& SampleRatio() { return sampleRatio; }
+
   //! Get the number of classes this model is trained on.
   size_t NumClasses() const { return numClasses; }
 
@@ -165,11 +173,32 @@ class AdaBoost
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Train a weak learner for one boosting round.  If SampleRatio() is less
+   * than 1, the learner is trained on a weight-proportional sample of the
+   * dataset; otherwise it is trained on the full dataset with the given
+   * instance weights.
+   *
+   * @param other Weak learner to copy parameters from.
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param weights Current boosting weight of each point.
+   * @return The trained weak learner.
+   */
+  WeakLearnerType BuildWeakLearner(const WeakLearnerType& other,
+                                   const MatType& data,
+                                   const arma::Row<size_t>& labels,
+                                   const arma::rowvec& weights);
+
   //! The number of classes in the model.
   size_t numClasses;
   // The tolerance for change in rt and when to stop.
   double tolerance;
 
+  //! Fraction of points each weak learner trains on (1.0 trains on the fully
+  //! weighted dataset).
+  double sampleRatio;
+
   //! The vector of weak learners.
   std::vector<WeakLearnerType> wl;
   //! The weights corresponding to each weak learner.
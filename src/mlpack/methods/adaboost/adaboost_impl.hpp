@@ -26,6 +26,10 @@
 #ifndef MLPACK_METHODS_ADABOOST_ADABOOST_IMPL_HPP
 #define MLPACK_METHODS_ADABOOST_ADABOOST_IMPL_HPP
 
+#include <mlpack/core/math/random.hpp>
+
+#include <algorithm>
+
 #include "adaboost.hpp"
 
 namespace mlpack {
@@ -47,7 +51,8 @@ AdaBoost<WeakLearnerType, MatType>::AdaBoost(
     const size_t numClasses,
     const WeakLearnerType& other,
     const size_t iterations,
-    const double tol)
+    const double tol) :
+    sampleRatio(1.0)
 {
   Train(data, labels, numClasses, other, iterations, tol);
 }
@@ -57,6 +62,7 @@ template<typename WeakLearnerType, typename MatType>
 AdaBoost<WeakLearnerType, MatType>::AdaBoost(const double tolerance) :
     numClasses(0),
     tolerance(tolerance),
+    sampleRatio(1.0),
     ztProduct(1.0)
 {
   // Nothing to do.
@@ -121,7 +127,7 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     weights = arma::sum(D);
 
     // Use the existing weak learner to train a new one with new weights.
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    WeakLearnerType w = BuildWeakLearner(other, tempData, labels, weights);
     w.Classify(tempData, predictedLabels);
 
     // Now from predictedLabels, build ht, the weak hypothesis
@@ -203,6 +209,50 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   return ztProduct;
 }
 
+/**
+ * Train a weak learner for one boosting round.
+ */
+template<typename WeakLearnerType, typename MatType>
+WeakLearnerType AdaBoost<WeakLearnerType, MatType>::BuildWeakLearner(
+    const WeakLearnerType& other,
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const arma::rowvec& weights)
+{
+  if (sampleRatio >= 1.0)
+    return WeakLearnerType(other, data, labels, numClasses, weights);
+
+  // Weight-proportional sampling: draw points with replacement according to
+  // the boosting weights, so the weak learner sees each point with the right
+  // expected frequency and only has to train on a fraction of the dataset.
+  const size_t numSamples = std::max((size_t) 1,
+      (size_t) std::ceil(sampleRatio * data.n_cols));
+
+  // Invert the cumulative weight distribution for each draw.
+  const arma::vec cdf = arma::cumsum(arma::trans(weights));
+  const double total = cdf[cdf.n_elem - 1];
+
+  MatType sampledData(data.n_rows, numSamples);
+  arma::Row<size_t> sampledLabels(numSamples);
+  for (size_t j = 0; j < numSamples; ++j)
+  {
+    size_t index = std::lower_bound(cdf.begin(), cdf.end(),
+        math::Random() * total) - cdf.begin();
+    if (index >= data.n_cols)
+      index = data.n_cols - 1;
+
+    sampledData.col(j) = data.col(index);
+    sampledLabels[j] = labels[index];
+  }
+
+  // The sample already reflects the weights, so the learner trains unweighted.
+  arma::rowvec uniformWeights(numSamples);
+  uniformWeights.fill(1.0 / numSamples);
+
+  return WeakLearnerType(other, sampledData, sampledLabels, numClasses,
+      uniformWeights);
+}
+
 /**
  * Classify the given test points.
  */
@@ -23,6 +23,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/svd_batch_learning.hpp>
+#include <mlpack/methods/amf/update_rules/svd_parallel_sgd_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_incomplete_incremental_learning.hpp>
 #include <mlpack/methods/amf/update_rules/svd_complete_incremental_learning.hpp>
 
@@ -157,6 +158,19 @@ using SVDBatchFactorizer = amf::AMF<
     amf::RandomAcolInitialization<>,
     amf::SVDBatchLearning>;
 
+/**
+ * SVDParallelSGDFactorizer factorizes given matrix V into two matrices W and
+ * H by lock-free parallel stochastic gradient descent over the nonzero
+ * entries of V, in the style of Hogwild.
+ *
+ * @see SVDParallelSGDLearning
+ */
+template<typename MatType = arma::mat>
+using SVDParallelSGDFactorizer = amf::AMF<
+    amf::SimpleResidueTermination,
+    amf::RandomAcolInitialization<>,
+    amf::SVDParallelSGDLearning>;
+
 /**
  * SVDIncompleteIncrementalFactorizer factorizes given matrix V into two
  * matrices W and H by incomplete incremental gradient descent. SVD incomplete
@@ -0,0 +1,209 @@
+/**
+ * @file svd_parallel_sgd_learning.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Lock-free parallel SGD factorizer used in AMF (Alternating Matrix
+ * Factorization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_SVD_PARALLEL_SGD_LEARNING_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_SVD_PARALLEL_SGD_LEARNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements lock-free parallel stochastic gradient descent over
+ * the nonzero entries of the input matrix, in the style of the following
+ * paper:
+ *
+ * @code
+ * @inproceedings{niu2011hogwild,
+ *   title={Hogwild!: A Lock-Free Approach to Parallelizing Stochastic
+ *       Gradient Descent},
+ *   author={Niu, Feng and Recht, Benjamin and R{\'e}, Christopher and Wright,
+ *       Stephen J.},
+ *   booktitle={Advances in Neural Information Processing Systems},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * Each sweep visits the columns of V in a freshly shuffled order, partitioned
+ * across OpenMP threads.  During WUpdate() the rows of W touched by a
+ * column's nonzeros are updated without locks---updates to the same row from
+ * two threads may interleave, which the Hogwild analysis shows is harmless
+ * when the input is sparse.  During HUpdate() each thread owns the columns of
+ * H it visits, so those updates are race-free.  The per-entry update itself
+ * is expressed over whole factor rows and columns, so it is vectorized over
+ * the rank.
+ *
+ * This rule is intended for sparse inputs; it also works on dense matrices,
+ * where every entry is treated as an observation.
+ *
+ * @see SVDBatchLearning, SVDIncompleteIncrementalLearning
+ */
+class SVDParallelSGDLearning
+{
+ public:
+  /**
+   * Initialize the parameters of SVDParallelSGDLearning.
+   *
+   * @param u Step size of the stochastic updates.
+   * @param kw Regularization constant for W matrix.
+   * @param kh Regularization constant for H matrix.
+   */
+  SVDParallelSGDLearning(double u = 0.001,
+                         double kw = 0,
+                         double kh = 0)
+      : u(u), kw(kw), kh(kh)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize parameters before factorization.  This function must be called
+   * before a new factorization.  The input matrix and rank are not used.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param rank Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * The update rule for the basis matrix W: one shuffled, lock-free SGD sweep
+   * over the nonzero entries of V.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& V,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        V.n_cols - 1, V.n_cols));
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (omp_size_t k = 0; k < (omp_size_t) order.n_elem; ++k)
+    {
+      const size_t j = order[k];
+      for (size_t i = 0; i < V.n_rows; ++i)
+      {
+        const double val = V(i, j);
+        // Update only if the rating is non-zero.
+        if (val != 0)
+        {
+          const double e = val - arma::dot(W.row(i), H.col(j));
+          // Lock-free update of the row of W; collisions between threads are
+          // rare for sparse inputs and do not harm convergence.
+          W.row(i) += u * (e * H.col(j).t() - kw * W.row(i));
+        }
+      }
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H: one shuffled SGD sweep over
+   * the nonzero entries of V.  Each thread owns the columns of H it updates,
+   * so no synchronization is needed.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        V.n_cols - 1, V.n_cols));
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (omp_size_t k = 0; k < (omp_size_t) order.n_elem; ++k)
+    {
+      const size_t j = order[k];
+      for (size_t i = 0; i < V.n_rows; ++i)
+      {
+        const double val = V(i, j);
+        // Update only if the rating is non-zero.
+        if (val != 0)
+        {
+          const double e = val - arma::dot(W.row(i), H.col(j));
+          H.col(j) += u * (e * W.row(i).t() - kh * H.col(j));
+        }
+      }
+    }
+  }
+
+ private:
+  //! Step size of the stochastic updates.
+  double u;
+  //! Regularization parameter for W matrix.
+  double kw;
+  //! Regularization parameter for H matrix.
+  double kh;
+};
+
+//! Template specialized functions for sparse matrices: iterate only over the
+//! stored nonzeros of each column.
+template<>
+inline void SVDParallelSGDLearning::WUpdate<arma::sp_mat>(
+    const arma::sp_mat& V, arma::mat& W, const arma::mat& H)
+{
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+      V.n_cols - 1, V.n_cols));
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (omp_size_t k = 0; k < (omp_size_t) order.n_elem; ++k)
+  {
+    const size_t j = order[k];
+    for (arma::sp_mat::const_iterator it = V.begin_col(j);
+        it != V.end_col(j); ++it)
+    {
+      const size_t i = it.row();
+      const double e = (*it) - arma::dot(W.row(i), H.col(j));
+      // Lock-free update of the row of W; collisions between threads are
+      // rare for sparse inputs and do not harm convergence.
+      W.row(i) += u * (e * H.col(j).t() - kw * W.row(i));
+    }
+  }
+}
+
+template<>
+inline void SVDParallelSGDLearning::HUpdate<arma::sp_mat>(
+    const arma::sp_mat& V, const arma::mat& W, arma::mat& H)
+{
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+      V.n_cols - 1, V.n_cols));
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (omp_size_t k = 0; k < (omp_size_t) order.n_elem; ++k)
+  {
+    const size_t j = order[k];
+    for (arma::sp_mat::const_iterator it = V.begin_col(j);
+        it != V.end_col(j); ++it)
+    {
+      const size_t i = it.row();
+      const double e = (*it) - arma::dot(W.row(i), H.col(j));
+      H.col(j) += u * (e * W.row(i).t() - kh * H.col(j));
+    }
+  }
+}
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_LOGISTIC_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/vector_math.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -61,6 +62,22 @@ class LogisticFunction
     y = (1.0 / (1 + arma::exp(-x)));
   }
 
+  /**
+   * Computes the logistic function on a whole dense matrix, through the
+   * vectorized kernel layer (no per-element libm calls, parallelized for
+   * large activations).
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename eT>
+  static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
+  {
+    y.set_size(arma::size(x));
+    math::VectorizedApply(x.memptr(), y.memptr(), x.n_elem,
+        [](const double v) { return math::FastLogistic(v); });
+  }
+
   /**
    * Computes the first derivative of the logistic function.
    *
@@ -24,6 +24,7 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_RECTIFIER_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/vector_math.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -65,8 +66,10 @@ class RectifierFunction
   template<typename eT>
   static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
   {
-    y.zeros(x.n_rows, x.n_cols);
-    y = arma::max(y, x);
+    // One branch-free pass instead of materializing a zero matrix first.
+    y.set_size(arma::size(x));
+    math::VectorizedApply(x.memptr(), y.memptr(), x.n_elem,
+        [](const double v) { return v > 0.0 ? v : 0.0; });
   }
 
   /**
@@ -27,6 +27,7 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_SOFTPLUS_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/vector_math.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -71,6 +72,22 @@ class SoftplusFunction
       y(i) = Fn(x(i));
   }
 
+  /**
+   * Computes the softplus function on a whole dense matrix, through the
+   * vectorized kernel layer (no per-element libm calls, parallelized for
+   * large activations).
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename eT>
+  static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
+  {
+    y.set_size(arma::size(x));
+    math::VectorizedApply(x.memptr(), y.memptr(), x.n_elem,
+        [](const double v) { return math::FastSoftplus(v); });
+  }
+
   /**
    * Computes the first derivative of the softplus function.
    *
@@ -371,9 +371,6 @@ class BRNN
   //! The current gradient for the gradient pass for backward RNN.
   arma::mat backwardGradient;
 
-  //! The total gradient from each gradient pass.
-  arma::mat totalGradient;
-
   //! Forward RNN
   RNN<OutputLayerType, InitializationRuleType, CustomLayers...> forwardRNN;
 
@@ -162,19 +162,27 @@ void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   {
     const size_t effectiveBatchSize = std::min(batchSize,
         size_t(predictors.n_cols - begin));
-    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    // Each direction runs independently; join before the merge layer.
+    #pragma omp parallel sections
     {
-      forwardRNN.Forward(std::move(arma::mat(
-          predictors.slice(seqNum).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true)));
-      backwardRNN.Forward(std::move(arma::mat(
-          predictors.slice(rho - seqNum - 1).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true)));
-
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          std::move(results1)), forwardRNN.network.back());
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          std::move(results2)), backwardRNN.network.back());
+      #pragma omp section
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        forwardRNN.Forward(std::move(arma::mat(
+            predictors.slice(seqNum).colptr(begin),
+            predictors.n_rows, effectiveBatchSize, false, true)));
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            std::move(results1)), forwardRNN.network.back());
+      }
+      #pragma omp section
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        backwardRNN.Forward(std::move(arma::mat(
+            predictors.slice(rho - seqNum - 1).colptr(begin),
+            predictors.n_rows, effectiveBatchSize, false, true)));
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            std::move(results2)), backwardRNN.network.back());
+      }
     }
     reverse(results1.begin(), results1.end());
 
@@ -238,20 +246,29 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   double performance = 0;
   size_t responseSeq = 0;
 
+  // The two directions are independent until the merge layer, so step them
+  // on separate threads and join before merging.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #pragma omp parallel sections
   {
-    forwardRNN.Forward(std::move(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-    backwardRNN.Forward(std::move(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-
-    boost::apply_visitor(SaveOutputParameterVisitor(
-        std::move(results1)), forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(
-        std::move(results2)), backwardRNN.network.back());
+    #pragma omp section
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      forwardRNN.Forward(std::move(arma::mat(
+          predictors.slice(seqNum).colptr(begin),
+          predictors.n_rows, batchSize, false, true)));
+      boost::apply_visitor(SaveOutputParameterVisitor(
+          std::move(results1)), forwardRNN.network.back());
+    }
+    #pragma omp section
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      backwardRNN.Forward(std::move(arma::mat(
+          predictors.slice(rho - seqNum - 1).colptr(begin),
+          predictors.n_rows, batchSize, false, true)));
+      boost::apply_visitor(SaveOutputParameterVisitor(
+          std::move(results2)), backwardRNN.network.back());
+    }
   }
   if (outputSize == 0)
   {
@@ -355,28 +372,42 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   backwardRNN.ResetCells();
   size_t networkSize = backwardRNN.network.size();
 
-  // Forward propogation from both directions.
+  // Forward propogation from both directions.  The two directions share no
+  // state until the merge layer, so each runs on its own thread with its own
+  // saved-output workspace; join before merging.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #pragma omp parallel sections
   {
-    forwardRNN.Forward(std::move(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-    backwardRNN.Forward(std::move(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-
-    for (size_t l = 0; l < networkSize; ++l)
+    #pragma omp section
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
     {
+      forwardRNN.Forward(std::move(arma::mat(
+          predictors.slice(seqNum).colptr(begin),
+          predictors.n_rows, batchSize, false, true)));
+
+      for (size_t l = 0; l < networkSize; ++l)
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            std::move(forwardRNNOutputParameter)), forwardRNN.network[l]);
+      }
       boost::apply_visitor(SaveOutputParameterVisitor(
-          std::move(forwardRNNOutputParameter)), forwardRNN.network[l]);
+          std::move(results1)), forwardRNN.network.back());
+    }
+    #pragma omp section
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      backwardRNN.Forward(std::move(arma::mat(
+          predictors.slice(rho - seqNum - 1).colptr(begin),
+          predictors.n_rows, batchSize, false, true)));
+
+      for (size_t l = 0; l < networkSize; ++l)
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            std::move(backwardRNNOutputParameter)), backwardRNN.network[l]);
+      }
       boost::apply_visitor(SaveOutputParameterVisitor(
-          std::move(backwardRNNOutputParameter)), backwardRNN.network[l]);
+          std::move(results2)), backwardRNN.network.back());
     }
-    boost::apply_visitor(SaveOutputParameterVisitor(
-        std::move(results1)), forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(
-        std::move(results2)), backwardRNN.network.back());
   }
   if (outputSize == 0)
   {
@@ -450,86 +481,104 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     allDelta.push_back(arma::mat(delta));
   }
 
-  // BPTT ForwardRNN from t = T to 1.
-  totalGradient = arma::mat(gradient.memptr(),
-      parameter.n_elem/2, 1, false, false);
-
   forwardGradient.zeros();
   forwardRNN.ResetGradients(forwardGradient);
   backwardGradient.zeros();
   backwardRNN.ResetGradients(backwardGradient);
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  // BPTT for both directions at once.  Each direction accumulates into its
+  // own half of the gradient with its own delta workspace, and only touches
+  // its own half of the merge layer, so the two loops can run concurrently;
+  // allDelta is read-only here.
+  #pragma omp parallel sections
   {
-    forwardGradient.zeros();
-    for (size_t l = 0; l < networkSize; ++l)
+    // BPTT ForwardRNN from t = T to 1.
+    #pragma omp section
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          std::move(forwardRNNOutputParameter)),
-          forwardRNN.network[networkSize - 1 - l]);
+      arma::mat forwardTotalGradient = arma::mat(gradient.memptr(),
+          parameter.n_elem / 2, 1, false, false);
+      arma::mat forwardDelta;
+
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        forwardGradient.zeros();
+        for (size_t l = 0; l < networkSize; ++l)
+        {
+          boost::apply_visitor(LoadOutputParameterVisitor(
+              std::move(forwardRNNOutputParameter)),
+              forwardRNN.network[networkSize - 1 - l]);
+        }
+        boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
+            outputParameterVisitor, forwardRNN.network.back())),
+            std::move(allDelta[rho - seqNum - 1]), std::move(forwardDelta), 0),
+            mergeLayer);
+
+        for (size_t i = 2; i < networkSize; ++i)
+        {
+          boost::apply_visitor(BackwardVisitor(
+              std::move(boost::apply_visitor(outputParameterVisitor,
+              forwardRNN.network[networkSize - i])),
+              std::move(boost::apply_visitor(deltaVisitor,
+              forwardRNN.network[networkSize - i + 1])), std::move(
+              boost::apply_visitor(deltaVisitor,
+              forwardRNN.network[networkSize - i]))),
+              forwardRNN.network[networkSize - i]);
+        }
+        forwardRNN.Gradient(std::move(
+            arma::mat(predictors.slice(rho - seqNum - 1).colptr(begin),
+            predictors.n_rows, batchSize, false, true)));
+        boost::apply_visitor(GradientVisitor(
+            std::move(boost::apply_visitor(outputParameterVisitor,
+            forwardRNN.network[networkSize - 2])),
+            std::move(allDelta[rho - seqNum - 1]), 0), mergeLayer);
+        forwardTotalGradient += forwardGradient;
+      }
     }
-    boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-        outputParameterVisitor, forwardRNN.network.back())),
-        std::move(allDelta[rho - seqNum - 1]), std::move(delta), 0),
-        mergeLayer);
-
-    for (size_t i = 2; i < networkSize; ++i)
-    {
-      boost::apply_visitor(BackwardVisitor(
-          std::move(boost::apply_visitor(outputParameterVisitor,
-          forwardRNN.network[networkSize - i])),
-          std::move(boost::apply_visitor(deltaVisitor,
-          forwardRNN.network[networkSize - i + 1])), std::move(
-          boost::apply_visitor(deltaVisitor,
-          forwardRNN.network[networkSize - i]))),
-          forwardRNN.network[networkSize - i]);
-    }
-    forwardRNN.Gradient(std::move(
-        arma::mat(predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-    boost::apply_visitor(GradientVisitor(
-        std::move(boost::apply_visitor(outputParameterVisitor,
-        forwardRNN.network[networkSize - 2])),
-        std::move(allDelta[rho - seqNum - 1]), 0), mergeLayer);
-    totalGradient += forwardGradient;
-  }
 
-  // BPTT BackwardRNN from t = 1 to T.
-  totalGradient = arma::mat(gradient.memptr() + parameter.n_elem/2,
-      parameter.n_elem/2, 1, false, false);
-
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
-  {
-    backwardGradient.zeros();
-    for (size_t l = 0; l < networkSize; ++l)
+    // BPTT BackwardRNN from t = 1 to T.
+    #pragma omp section
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          std::move(backwardRNNOutputParameter)),
-          backwardRNN.network[networkSize - 1 - l]);
+      arma::mat backwardTotalGradient = arma::mat(
+          gradient.memptr() + parameter.n_elem / 2,
+          parameter.n_elem / 2, 1, false, false);
+      arma::mat backwardDelta;
+
+      for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+      {
+        backwardGradient.zeros();
+        for (size_t l = 0; l < networkSize; ++l)
+        {
+          boost::apply_visitor(LoadOutputParameterVisitor(
+              std::move(backwardRNNOutputParameter)),
+              backwardRNN.network[networkSize - 1 - l]);
+        }
+        boost::apply_visitor(BackwardVisitor(std::move(
+            boost::apply_visitor(outputParameterVisitor,
+            backwardRNN.network.back())),
+            std::move(allDelta[seqNum]), std::move(backwardDelta), 1),
+            mergeLayer);
+        for (size_t i = 2; i < networkSize; ++i)
+        {
+          boost::apply_visitor(BackwardVisitor(
+            std::move(boost::apply_visitor(outputParameterVisitor,
+            backwardRNN.network[networkSize - i])), std::move(
+            boost::apply_visitor(
+            deltaVisitor, backwardRNN.network[networkSize - i + 1])),
+            std::move(boost::apply_visitor(deltaVisitor,
+            backwardRNN.network[networkSize - i]))),
+            backwardRNN.network[networkSize - i]);
+        }
+
+        backwardRNN.Gradient(std::move(
+            arma::mat(predictors.slice(seqNum).colptr(begin),
+            predictors.n_rows, batchSize, false, true)));
+        boost::apply_visitor(GradientVisitor(
+            std::move(boost::apply_visitor(outputParameterVisitor,
+            backwardRNN.network[networkSize - 2])),
+            std::move(allDelta[seqNum]), 1), mergeLayer);
+        backwardTotalGradient += backwardGradient;
+      }
     }
-    boost::apply_visitor(BackwardVisitor(std::move(
-        boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network.back())),
-        std::move(allDelta[seqNum]), std::move(delta), 1), mergeLayer);
-    for (size_t i = 2; i < networkSize; ++i)
-    {
-      boost::apply_visitor(BackwardVisitor(
-        std::move(boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network[networkSize - i])), std::move(boost::apply_visitor(
-        deltaVisitor, backwardRNN.network[networkSize - i + 1])), std::move(
-        boost::apply_visitor(deltaVisitor,
-        backwardRNN.network[networkSize - i]))),
-        backwardRNN.network[networkSize - i]);
-    }
-
-    backwardRNN.Gradient(std::move(
-        arma::mat(predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true)));
-    boost::apply_visitor(GradientVisitor(
-        std::move(boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network[networkSize - 2])),
-        std::move(allDelta[seqNum]), 1), mergeLayer);
-    totalGradient += backwardGradient;
   }
   return performance;
 }
@@ -0,0 +1,315 @@
+/**
+ * @file auto_convolution.hpp
+ *
+ * Implementation of a convolution rule that picks the fastest available
+ * convolution algorithm per shape by microbenchmarking on first use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_AUTO_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_AUTO_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+#include "fft_convolution.hpp"
+#include "svd_convolution.hpp"
+#include "im2col_gemm_convolution.hpp"
+#include "winograd_convolution.hpp"
+
+#include <chrono>
+#include <map>
+#include <tuple>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution with whichever of the available
+ * convolution rules is fastest for the given shape.  Which rule wins depends
+ * on the kernel size, the input size, and the stride, and the best choice
+ * routinely differs between the layers of one network; instead of fixing the
+ * rule per layer at compile time, this rule times every applicable algorithm
+ * the first time a shape is seen and caches the winner, so every later
+ * convolution with that shape dispatches straight to the fastest rule.
+ *
+ * The first convolution of each shape therefore pays for one run of every
+ * candidate; since layer shapes repeat on every forward pass, the cost is
+ * amortized away after the first pass.  Candidates that cannot handle the
+ * configuration (the FFT and SVD rules ignore stride and dilation, and the
+ * Winograd rule only differs from the naive rule for 3x3 kernels at unit
+ * stride) are excluded from the benchmark up front.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class AutoConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid or full mode) with the cached fastest rule
+   * for this shape, benchmarking all the applicable rules if the shape has
+   * not been seen before.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Mat<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    const ShapeKey key = std::make_tuple(input.n_rows, input.n_cols,
+        filter.n_rows, filter.n_cols, dW, dH, dilationW, dilationH);
+
+    Algorithm algorithm = NAIVE;
+    bool cached = false;
+    #pragma omp critical (AutoConvolutionCache)
+    {
+      typename std::map<ShapeKey, Algorithm>::const_iterator it =
+          Cache<eT>().find(key);
+      if (it != Cache<eT>().end())
+      {
+        algorithm = it->second;
+        cached = true;
+      }
+    }
+
+    if (cached)
+    {
+      Run(algorithm, input, filter, output, dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    // First time this shape is seen: run every applicable algorithm once on
+    // the real input and keep the output of the fastest.
+    std::vector<Algorithm> candidates;
+    candidates.push_back(NAIVE);
+    candidates.push_back(IM2COL);
+    if (filter.n_rows == 3 && filter.n_cols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1 && input.n_rows >= 3 &&
+        input.n_cols >= 3)
+    {
+      candidates.push_back(WINOGRAD);
+    }
+    if (dW == 1 && dH == 1 && dilationW == 1 && dilationH == 1)
+    {
+      candidates.push_back(FFT);
+      if (filter.n_rows > 1 && filter.n_cols > 1 &&
+          filter.n_rows <= input.n_rows && filter.n_cols <= input.n_cols)
+      {
+        candidates.push_back(SVD);
+      }
+    }
+
+    double bestTime = DBL_MAX;
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      arma::Mat<eT> trial;
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      Run(candidates[i], input, filter, trial, dW, dH, dilationW, dilationH);
+      const double time = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+
+      if (time < bestTime)
+      {
+        bestTime = time;
+        algorithm = candidates[i];
+        output = std::move(trial);
+      }
+    }
+
+    #pragma omp critical (AutoConvolutionCache)
+    Cache<eT>()[key] = algorithm;
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    AutoConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      AutoConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    AutoConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; i++)
+    {
+      AutoConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    AutoConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      AutoConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+ private:
+  //! The available convolution algorithms.
+  enum Algorithm
+  {
+    NAIVE,
+    IM2COL,
+    WINOGRAD,
+    FFT,
+    SVD
+  };
+
+  //! A convolution shape: input rows and columns, filter rows and columns,
+  //! strides and dilations.
+  typedef std::tuple<size_t, size_t, size_t, size_t, size_t, size_t, size_t,
+      size_t> ShapeKey;
+
+  //! Get the process-wide cache of benchmark winners for this border mode
+  //! and element type.
+  template<typename eT>
+  static std::map<ShapeKey, Algorithm>& Cache()
+  {
+    static std::map<ShapeKey, Algorithm> cache;
+    return cache;
+  }
+
+  //! Perform the convolution with the given algorithm.
+  template<typename eT>
+  static void Run(const Algorithm algorithm,
+                  const arma::Mat<eT>& input,
+                  const arma::Mat<eT>& filter,
+                  arma::Mat<eT>& output,
+                  const size_t dW,
+                  const size_t dH,
+                  const size_t dilationW,
+                  const size_t dilationH)
+  {
+    switch (algorithm)
+    {
+      case IM2COL:
+        Im2ColGEMMConvolution<BorderMode>::Convolution(input, filter, output,
+            dW, dH, dilationW, dilationH);
+        break;
+      case WINOGRAD:
+        WinogradConvolution<BorderMode>::Convolution(input, filter, output,
+            dW, dH, dilationW, dilationH);
+        break;
+      case FFT:
+        FFTConvolution<BorderMode>::Convolution(input, filter, output);
+        break;
+      case SVD:
+        SVDConvolution<BorderMode>::Convolution(input, filter, output);
+        break;
+      case NAIVE:
+      default:
+        NaiveConvolution<BorderMode>::Convolution(input, filter, output, dW,
+            dH, dilationW, dilationH);
+        break;
+    }
+  }
+};  // class AutoConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
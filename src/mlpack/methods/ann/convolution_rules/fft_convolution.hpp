@@ -16,6 +16,9 @@
 #include <mlpack/prereqs.hpp>
 #include "border_modes.hpp"
 
+#include <cstring>
+#include <map>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -28,6 +31,12 @@ namespace ann /** Artificial Neural Network. */ {
  * ValidConvolution: returns only those parts of the convolution that are
  * computed without the zero-padded edges.
  *
+ * Padded working buffers and filter spectra are cached between calls (one
+ * cache per thread, keyed by the working shape and the filter), so repeated
+ * convolutions with an unchanged filter - the common case at inference time -
+ * cost one forward transform and a pointwise multiply instead of two forward
+ * transforms plus fresh allocations.
+ *
  * @tparam BorderMode Type of the border mode (FullConvolution or
  * ValidConvolution).
  * @tparam padLastDim Pad the last dimension of the input to to turn it from
@@ -55,17 +64,22 @@ class FFTConvolution
               const arma::Mat<eT>& filter,
               arma::Mat<eT>& output)
   {
-    arma::Mat<eT> inputPadded = input;
-    arma::Mat<eT> filterPadded = filter;
+    const size_t workRows = input.n_rows;
+    size_t workCols = input.n_cols;
 
     if (padLastDim)
-      inputPadded.resize(inputPadded.n_rows, inputPadded.n_cols + 1);
+      workCols++;
+
+    arma::Mat<eT>& inputPadded = PaddedWorkspace<eT>(workRows, workCols, 0, 0);
+    inputPadded.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
 
-    // Pad filter and input to the output shape.
-    filterPadded.resize(inputPadded.n_rows, inputPadded.n_cols);
+    // The filter spectrum is reused as long as the filter values don't
+    // change, so at inference time only the input transform remains.
+    const arma::Mat<std::complex<eT> >& filterSpectrum =
+        FilterSpectrum(filter, workRows, workCols);
 
-    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
-        filterPadded)));
+    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) %
+        filterSpectrum));
 
     // Extract the region of interest. We don't need to handle the padLastDim in
     // a special way we just cut it out from the output matrix.
@@ -99,19 +113,20 @@ class FFTConvolution
     if (padLastDim)
         outputCols++;
 
-    // Pad filter and input to the working output shape.
-    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
-        outputCols);
+    // Pad the input to the working output shape; the border of the cached
+    // buffer is already zero.
+    arma::Mat<eT>& inputPadded = PaddedWorkspace<eT>(outputRows, outputCols,
+        filter.n_rows - 1, filter.n_cols - 1);
     inputPadded.submat(filter.n_rows - 1, filter.n_cols - 1,
           filter.n_rows - 1 + input.n_rows - 1,
           filter.n_cols - 1 + input.n_cols - 1) = input;
 
-    arma::Mat<eT> filterPadded = filter;
-    filterPadded.resize(outputRows, outputCols);
+    const arma::Mat<std::complex<eT> >& filterSpectrum =
+        FilterSpectrum(filter, outputRows, outputCols);
 
     // Perform FFT and IFFT
-    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) % arma::fft2(
-        filterPadded)));
+    arma::Mat<eT> temp = arma::real(ifft2(arma::fft2(inputPadded) %
+        filterSpectrum));
 
     // Extract the region of interest. We don't need to handle the padLastDim
     // parameter in a special way we just cut it out from the output matrix.
@@ -136,15 +151,11 @@ class FFTConvolution
                           const arma::Cube<eT>& filter,
                           arma::Cube<eT>& output)
   {
-    arma::Mat<eT> convOutput;
-    FFTConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
-        convOutput);
+    output = arma::Cube<eT>(OutputRows(input.n_rows, filter.n_rows),
+        OutputCols(input.n_cols, filter.n_cols), input.n_slices);
 
-    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
-        input.n_slices);
-    output.slice(0) = convOutput;
-
-    for (size_t i = 1; i < input.n_slices; i++)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_slices; i++)
     {
       FFTConvolution<BorderMode>::Convolution(input.slice(i), filter.slice(i),
           output.slice(i));
@@ -167,18 +178,41 @@ class FFTConvolution
                           const arma::Cube<eT>& filter,
                           arma::Cube<eT>& output)
   {
-    arma::Mat<eT> convOutput;
-    FFTConvolution<BorderMode>::Convolution(input, filter.slice(0),
-        convOutput);
+    const size_t outputRows = OutputRows(input.n_rows, filter.n_rows);
+    const size_t outputCols = OutputCols(input.n_cols, filter.n_cols);
+
+    // Every output map convolves the same input, so the input is transformed
+    // once and only the per-filter multiply and inverse transform remain
+    // inside the loop.
+    const bool valid = std::is_same<BorderMode, ValidConvolution>::value;
+    const size_t workRows = valid ? input.n_rows :
+        input.n_rows + 2 * (filter.n_rows - 1);
+    const size_t workCols = valid ? input.n_cols :
+        input.n_cols + 2 * (filter.n_cols - 1);
+    const size_t rowOffset = valid ? 0 : filter.n_rows - 1;
+    const size_t colOffset = valid ? 0 : filter.n_cols - 1;
+
+    arma::Mat<eT>& inputPadded = PaddedWorkspace<eT>(workRows, workCols,
+        rowOffset, colOffset);
+    inputPadded.submat(rowOffset, colOffset, rowOffset + input.n_rows - 1,
+        colOffset + input.n_cols - 1) = input;
 
-    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
-        filter.n_slices);
-    output.slice(0) = convOutput;
+    const arma::Mat<std::complex<eT> > inputSpectrum =
+        arma::fft2(inputPadded);
 
-    for (size_t i = 1; i < filter.n_slices; i++)
+    output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) filter.n_slices; i++)
     {
-      FFTConvolution<BorderMode>::Convolution(input, filter.slice(i),
-          output.slice(i));
+      const arma::Mat<std::complex<eT> >& filterSpectrum = FilterSpectrum(
+          filter.slice(i), workRows, workCols);
+
+      arma::Mat<eT> temp = arma::real(ifft2(inputSpectrum % filterSpectrum));
+
+      output.slice(i) = temp.submat(filter.n_rows - 1, filter.n_cols - 1,
+          filter.n_rows - 1 + outputRows - 1, filter.n_cols - 1 +
+          outputCols - 1);
     }
   }
 
@@ -195,20 +229,116 @@ class FFTConvolution
                           const arma::Mat<eT>& filter,
                           arma::Cube<eT>& output)
   {
-    arma::Mat<eT> convOutput;
-    FFTConvolution<BorderMode>::Convolution(input.slice(0), filter,
-        convOutput);
-
-    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
-        input.n_slices);
-    output.slice(0) = convOutput;
+    output = arma::Cube<eT>(OutputRows(input.n_rows, filter.n_rows),
+        OutputCols(input.n_cols, filter.n_cols), input.n_slices);
 
-    for (size_t i = 1; i < input.n_slices; i++)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_slices; i++)
     {
       FFTConvolution<BorderMode>::Convolution(input.slice(i), filter,
           output.slice(i));
     }
   }
+
+ private:
+  //! Cached spectrum of a single filter, valid as long as the filter values
+  //! and the working shape stay the same.
+  template<typename eT>
+  struct FilterPlan
+  {
+    size_t workRows;
+    size_t workCols;
+    arma::Mat<eT> filter;
+    arma::Mat<std::complex<eT> > spectrum;
+
+    FilterPlan() : workRows(0), workCols(0) { /* Nothing to do here. */ }
+  };
+
+  /*
+   * Return the spectrum of the given filter padded to the working shape,
+   * recomputing it only when the filter values or the shape changed since the
+   * last call. The cache is per thread and keyed by the filter's memory
+   * address, which is stable for filters that alias a layer's weight blob.
+   *
+   * @param filter Filter to transform.
+   * @param workRows Number of rows of the working (padded) shape.
+   * @param workCols Number of columns of the working (padded) shape.
+   * @return The cached filter spectrum.
+   */
+  template<typename eT>
+  static const arma::Mat<std::complex<eT> >& FilterSpectrum(
+      const arma::Mat<eT>& filter,
+      const size_t workRows,
+      const size_t workCols)
+  {
+    static thread_local std::map<const eT*, FilterPlan<eT> > cache;
+
+    FilterPlan<eT>& plan = cache[filter.memptr()];
+    if (plan.workRows != workRows || plan.workCols != workCols ||
+        plan.filter.n_rows != filter.n_rows ||
+        plan.filter.n_cols != filter.n_cols ||
+        std::memcmp(plan.filter.memptr(), filter.memptr(),
+            filter.n_elem * sizeof(eT)) != 0)
+    {
+      plan.workRows = workRows;
+      plan.workCols = workCols;
+      plan.filter = filter;
+
+      arma::Mat<eT> filterPadded = filter;
+      filterPadded.resize(workRows, workCols);
+      plan.spectrum = arma::fft2(filterPadded);
+    }
+
+    return plan.spectrum;
+  }
+
+  /*
+   * Return a reusable zero-initialized working buffer of the given shape. The
+   * input offset is part of the cache key, so the zero border of a buffer is
+   * never clobbered by a call that places its input at another offset.
+   *
+   * @param rows Number of rows of the working shape.
+   * @param cols Number of columns of the working shape.
+   * @param rowOffset Row at which the caller places the input.
+   * @param colOffset Column at which the caller places the input.
+   * @return The cached working buffer.
+   */
+  template<typename eT>
+  static arma::Mat<eT>& PaddedWorkspace(const size_t rows,
+                                        const size_t cols,
+                                        const size_t rowOffset,
+                                        const size_t colOffset)
+  {
+    typedef std::pair<std::pair<size_t, size_t>,
+        std::pair<size_t, size_t> > WorkspaceKey;
+    static thread_local std::map<WorkspaceKey, arma::Mat<eT> > cache;
+
+    arma::Mat<eT>& buffer = cache[std::make_pair(
+        std::make_pair(rows, cols), std::make_pair(rowOffset, colOffset))];
+    if (buffer.n_rows != rows || buffer.n_cols != cols)
+      buffer.zeros(rows, cols);
+
+    return buffer;
+  }
+
+  /*
+   * Return the number of output rows for the given input and filter rows.
+   */
+  static size_t OutputRows(const size_t inputRows, const size_t filterRows)
+  {
+    return std::is_same<BorderMode, ValidConvolution>::value ?
+        inputRows - filterRows + 1 : inputRows + filterRows - 1;
+  }
+
+  /*
+   * Return the number of output columns for the given input and filter
+   * columns.
+   */
+  static size_t OutputCols(const size_t inputCols, const size_t filterCols)
+  {
+    return std::is_same<BorderMode, ValidConvolution>::value ?
+        inputCols - filterCols + 1 : inputCols + filterCols - 1;
+  }
 };  // class FFTConvolution
 
 } // namespace ann
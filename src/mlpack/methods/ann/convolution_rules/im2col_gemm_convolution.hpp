@@ -0,0 +1,324 @@
+/**
+ * @file im2col_gemm_convolution.hpp
+ *
+ * Implementation of the convolution through the im2col transformation and
+ * dense matrix multiplication, so that the inner loops of the convolution are
+ * executed by BLAS.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_GEMM_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_GEMM_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by lowering it to a matrix
+ * multiplication: every input patch that a filter application touches is
+ * copied into one column of a patch matrix (im2col), after which the whole
+ * convolution is a single GEMM (or, for a batch of filters over the same
+ * input, one GEMM for all filters at once).  The gather pass is linear in the
+ * output size, and the floating-point work runs at BLAS speed instead of
+ * through a scalar four-deep loop.  Results are identical to
+ * NaiveConvolution for all border modes, strides, and dilations.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColGEMMConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    const size_t outputRows =
+        (input.n_rows - (filter.n_rows - 1) * dilationW - 1) / dW + 1;
+    const size_t outputCols =
+        (input.n_cols - (filter.n_cols - 1) * dilationH - 1) / dH + 1;
+
+    arma::Mat<eT> patches;
+    Im2Col(input, filter.n_rows, filter.n_cols, outputRows, outputCols, dW, dH,
+        dilationW, dilationH, patches);
+
+    // One matrix-vector product computes every output element.
+    output = arma::reshape(patches.t() * arma::vectorise(filter), outputRows,
+        outputCols);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Zero-pad the input exactly as NaiveConvolution does, then run the valid
+    // mode kernel over the padded input.
+    arma::Mat<eT> inputPadded;
+    PadInput(input, filter, dW, dH, dilationW, dilationH, inputPadded);
+
+    Im2ColGEMMConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColGEMMConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      Im2ColGEMMConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.  Because every filter is applied to the same input,
+   * the patch matrix is built once and a single GEMM computes the outputs of
+   * all filters.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    // In full mode, the padding depends only on the (shared) filter shape, so
+    // the padded input can also be reused across the filters.
+    arma::Mat<eT> inputPadded;
+    size_t strideW = dW;
+    size_t strideH = dH;
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      PadInput(input, filter.slice(0), dW, dH, dilationW, dilationH,
+          inputPadded);
+      strideW = 1;
+      strideH = 1;
+    }
+    const arma::Mat<eT>& inputUse =
+        std::is_same<BorderMode, FullConvolution>::value ? inputPadded : input;
+
+    const size_t outputRows =
+        (inputUse.n_rows - (filter.n_rows - 1) * dilationW - 1) / strideW + 1;
+    const size_t outputCols =
+        (inputUse.n_cols - (filter.n_cols - 1) * dilationH - 1) / strideH + 1;
+
+    arma::Mat<eT> patches;
+    Im2Col(inputUse, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        strideW, strideH, dilationW, dilationH, patches);
+
+    // The slices of a cube are contiguous, so the filters can be viewed as
+    // one (filterElements x numFilters) matrix without a copy, and the output
+    // cube filled by one GEMM through a similar alias.
+    const arma::Mat<eT> filterMatrix(const_cast<eT*>(filter.memptr()),
+        filter.n_elem_slice, filter.n_slices, false, true);
+
+    output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices);
+    arma::Mat<eT> outputMatrix(output.memptr(), outputRows * outputCols,
+        filter.n_slices, false, true);
+    outputMatrix = patches.t() * filterMatrix;
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColGEMMConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      Im2ColGEMMConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+ private:
+  /*
+   * Copy every patch the filter touches into one column of the patch matrix.
+   * Within a column, patch elements are laid out in the column-major order of
+   * the filter, so that a dot product with the vectorised filter reproduces
+   * the scalar convolution loop of NaiveConvolution.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Mat<eT>& input,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     arma::Mat<eT>& patches)
+  {
+    patches.set_size(filterRows * filterCols, outputRows * outputCols);
+
+    eT* patchPtr = patches.memptr();
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i)
+      {
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          const eT* inputPtr = input.colptr(kj * dilationW + j * dW) + i * dH;
+          for (size_t ki = 0; ki < filterRows; ++ki, ++patchPtr,
+              inputPtr += dilationH)
+            *patchPtr = *inputPtr;
+        }
+      }
+    }
+  }
+
+  /*
+   * Zero-pad the input for full mode; this reproduces the padded geometry of
+   * NaiveConvolution exactly, including the stride-dependent size adjustment.
+   */
+  template<typename eT>
+  static void PadInput(const arma::Mat<eT>& input,
+                       const arma::Mat<eT>& filter,
+                       const size_t dW,
+                       const size_t dH,
+                       const size_t dilationW,
+                       const size_t dilationH,
+                       arma::Mat<eT>& inputPadded)
+  {
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filter.n_rows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filter.n_cols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; i++)
+    {
+      if (((((i + outputRows - 2 * (filter.n_rows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; i++)
+    {
+      if (((((i + outputCols - 2 * (filter.n_cols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    inputPadded = arma::zeros<arma::Mat<eT> >(outputRows, outputCols);
+    inputPadded.submat((filter.n_rows - 1) * dilationW, (filter.n_cols - 1)
+        * dilationH, (filter.n_rows - 1) * dilationW + input.n_rows - 1,
+        (filter.n_cols - 1) * dilationH + input.n_cols - 1) = input;
+  }
+};  // class Im2ColGEMMConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
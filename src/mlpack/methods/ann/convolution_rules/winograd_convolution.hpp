@@ -0,0 +1,275 @@
+/**
+ * @file winograd_convolution.hpp
+ *
+ * Implementation of the convolution using the Winograd minimal filtering
+ * algorithm F(2x2, 3x3), which cuts the number of multiplications by about
+ * 2.25x for 3x3 kernels at unit stride.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution with the Winograd minimal
+ * filtering algorithm F(2x2, 3x3) (Lavin and Gray, "Fast Algorithms for
+ * Convolutional Neural Networks").  The filter is transformed once per
+ * invocation, the input is processed in 4x4 tiles producing 2x2 output tiles
+ * each, and the tile buffers are reused across tiles.
+ *
+ * The minimal filtering form only exists for 3x3 kernels at unit stride and
+ * dilation; every other configuration automatically falls back to the naive
+ * rule, so the class is a drop-in replacement for NaiveConvolution.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid or full mode) using the Winograd transform
+   * when the filter is 3x3 with unit stride and dilation, and the naive rule
+   * otherwise.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Mat<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1 || input.n_rows < 3 ||
+        input.n_cols < 3)
+    {
+      NaiveConvolution<BorderMode>::Convolution(input, filter, output, dW, dH,
+          dilationW, dilationH);
+    }
+    else if (std::is_same<BorderMode, ValidConvolution>::value)
+    {
+      WinogradValid(input, filter, output);
+    }
+    else
+    {
+      // Full mode: zero-pad the input by the filter radius on every side and
+      // run the valid transform on the padded input.
+      arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(
+          input.n_rows + 4, input.n_cols + 4);
+      inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+      WinogradValid(inputPadded, filter, output);
+    }
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+ private:
+  /*
+   * The Winograd F(2x2, 3x3) transform for the valid convolution of a 3x3
+   * filter at unit stride: the filter is transformed once, and each 4x4
+   * input tile yields a 2x2 output tile through the input and output
+   * transforms.  The tile buffers are allocated once and reused for every
+   * tile.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter The 3x3 filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void WinogradValid(const arma::Mat<eT>& input,
+                            const arma::Mat<eT>& filter,
+                            arma::Mat<eT>& output)
+  {
+    // The transform matrices of F(2x2, 3x3), stored column-major.
+    static const eT gData[] = { 1, 0.5, 0.5, 0,
+                                0, 0.5, -0.5, 0,
+                                0, 0.5, 0.5, 1 };
+    static const eT btData[] = { 1, 0, 0, 0,
+                                 0, 1, -1, 1,
+                                 -1, 1, 1, 0,
+                                 0, 0, 0, -1 };
+    static const eT atData[] = { 1, 0,
+                                 1, 1,
+                                 1, -1,
+                                 0, -1 };
+
+    const arma::Mat<eT> g(const_cast<eT*>(gData), 4, 3, false, true);
+    const arma::Mat<eT> bt(const_cast<eT*>(btData), 4, 4, false, true);
+    const arma::Mat<eT> at(const_cast<eT*>(atData), 2, 4, false, true);
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    output.set_size(outputRows, outputCols);
+
+    // Transform the filter once per invocation.
+    const arma::Mat<eT> transformedFilter = g * filter * g.t();
+
+    arma::Mat<eT> tile(4, 4), transformedTile(4, 4), outputTile(2, 2);
+
+    for (size_t c = 0; c < outputCols; c += 2)
+    {
+      for (size_t r = 0; r < outputRows; r += 2)
+      {
+        // Gather the 4x4 input tile, zero-padded at the bottom/right border.
+        // Every output element written below only depends on input elements
+        // inside the gathered region.
+        const size_t tileRows = std::min<size_t>(4, input.n_rows - r);
+        const size_t tileCols = std::min<size_t>(4, input.n_cols - c);
+        if (tileRows == 4 && tileCols == 4)
+        {
+          tile = input.submat(r, c, r + 3, c + 3);
+        }
+        else
+        {
+          tile.zeros();
+          tile.submat(0, 0, tileRows - 1, tileCols - 1) =
+              input.submat(r, c, r + tileRows - 1, c + tileCols - 1);
+        }
+
+        transformedTile = bt * tile * bt.t();
+        outputTile = at * (transformedFilter % transformedTile) * at.t();
+
+        const size_t rowsToWrite = std::min<size_t>(2, outputRows - r);
+        const size_t colsToWrite = std::min<size_t>(2, outputCols - c);
+        output.submat(r, c, r + rowsToWrite - 1, c + colsToWrite - 1) =
+            outputTile.submat(0, 0, rowsToWrite - 1, colsToWrite - 1);
+      }
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file export_compiled_inference.hpp
+ *
+ * Definition of ExportCompiledInference(), which emits a self-contained,
+ * compile-time-sized C++ inference function from a trained feed forward
+ * network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_EXPORT_COMPILED_INFERENCE_HPP
+#define MLPACK_METHODS_ANN_EXPORT_COMPILED_INFERENCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Write a self-contained C++ translation unit that runs the forward pass of
+ * the given trained network on a single input vector, with no dependency on
+ * mlpack or Armadillo.  For very small networks the interpreted layer walk
+ * of FFN::Predict() costs more than the arithmetic; the emitted function has
+ * the weights embedded as aligned static arrays and one fused GEMV +
+ * activation loop per stage, with every trip count a literal constant, so the
+ * compiler building the generated file can unroll and vectorize each stage
+ * completely.
+ *
+ * The emitted function has the signature
+ *
+ * @code
+ * void functionName(const double* input, double* output);
+ * @endcode
+ *
+ * where input holds one point (the input dimensionality of the first layer)
+ * and output receives the network output.
+ *
+ * Only networks built from Linear layers and elementwise activations
+ * (identity, logistic, tanh, rectifier) plus LogSoftMax are supported, and
+ * the first layer must be Linear (the input dimensionality is taken from
+ * it); a std::invalid_argument exception is thrown for anything else.  A
+ * std::runtime_error is thrown if the output file cannot be opened.
+ *
+ * @code
+ * FFN<NegativeLogLikelihood<> > model;
+ * ... build and train the model ...
+ *
+ * ExportCompiledInference(model, "model_inference.cpp", "model_predict");
+ * @endcode
+ *
+ * @param network The trained network to export.
+ * @param path File to write the generated C++ code to.
+ * @param functionName Name of the emitted inference function.
+ */
+template<typename FFNType>
+void ExportCompiledInference(FFNType& network,
+                             const std::string& path,
+                             const std::string& functionName =
+                                 "mlpack_compiled_predict");
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "export_compiled_inference_impl.hpp"
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ * @file export_compiled_inference_impl.hpp
+ *
+ * Implementation of ExportCompiledInference().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_EXPORT_COMPILED_INFERENCE_IMPL_HPP
+#define MLPACK_METHODS_ANN_EXPORT_COMPILED_INFERENCE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "export_compiled_inference.hpp"
+
+#include <fstream>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename FFNType>
+void ExportCompiledInference(FFNType& network,
+                             const std::string& path,
+                             const std::string& functionName)
+{
+  // The activations that can appear in an emitted stage.  The elementwise
+  // ones are fused into the GEMV loop of a preceding Linear layer;
+  // LogSoftMax needs a reduction over the whole stage output and is emitted
+  // as a standalone stage.
+  enum Activation
+  {
+    IDENTITY,
+    LOGISTIC,
+    TANH,
+    RECTIFIER,
+    LOG_SOFTMAX
+  };
+
+  // One stage of the emitted pipeline: a Linear transform with a fused
+  // elementwise activation, or a standalone activation pass.
+  struct Stage
+  {
+    //! The (outSize x inSize) weight matrix; empty for a pure activation
+    //! stage.
+    arma::mat weight;
+    //! Bias terms.
+    arma::vec bias;
+    //! Input and output widths of the stage.
+    size_t inSize;
+    size_t outSize;
+    //! Activation applied to the stage output.
+    int activation;
+  };
+
+  // If the given layer is a supported activation layer, set activation
+  // accordingly and return true.
+  auto tryActivation = [](LayerTypes<>& layer, int& activation) -> bool
+  {
+    if (boost::get<BaseLayer<LogisticFunction, arma::mat, arma::mat>*>(&layer))
+    {
+      activation = LOGISTIC;
+      return true;
+    }
+    if (boost::get<BaseLayer<IdentityFunction, arma::mat, arma::mat>*>(&layer))
+    {
+      activation = IDENTITY;
+      return true;
+    }
+    if (boost::get<BaseLayer<TanhFunction, arma::mat, arma::mat>*>(&layer))
+    {
+      activation = TANH;
+      return true;
+    }
+    if (boost::get<BaseLayer<RectifierFunction, arma::mat, arma::mat>*>(
+        &layer))
+    {
+      activation = RECTIFIER;
+      return true;
+    }
+    if (boost::get<LogSoftMax<arma::mat, arma::mat>*>(&layer))
+    {
+      activation = LOG_SOFTMAX;
+      return true;
+    }
+
+    return false;
+  };
+
+  // Walk the network and collect the stages to emit, fusing every directly
+  // following elementwise activation into its Linear layer.
+  auto& model = network.Model();
+  if (model.empty())
+  {
+    throw std::invalid_argument("ExportCompiledInference(): cannot export an "
+        "empty network!");
+  }
+
+  std::vector<Stage> stages;
+  size_t inputSize = 0;
+  size_t width = 0;
+  for (size_t i = 0; i < model.size(); ++i)
+  {
+    int activation;
+    if (tryActivation(model[i], activation))
+    {
+      if (stages.empty())
+      {
+        throw std::invalid_argument("ExportCompiledInference(): the first "
+            "layer must be Linear (the input dimensionality is taken from "
+            "it)!");
+      }
+
+      Stage stage;
+      stage.inSize = stage.outSize = width;
+      stage.activation = activation;
+      stages.push_back(std::move(stage));
+      continue;
+    }
+
+    Linear<arma::mat, arma::mat>* const* linear =
+        boost::get<Linear<arma::mat, arma::mat>*>(&model[i]);
+    if (!linear)
+    {
+      throw std::invalid_argument("ExportCompiledInference(): unsupported "
+          "layer type; only Linear layers and elementwise activations (plus "
+          "LogSoftMax) can be exported!");
+    }
+
+    const size_t inSize = (*linear)->InputSize();
+    const size_t outSize = (*linear)->OutputSize();
+    const arma::mat& parameters = (*linear)->Parameters();
+
+    // The Linear parameter blob holds the (outSize x inSize) weight matrix
+    // followed by the bias.
+    Stage stage;
+    stage.weight = parameters.rows(0, outSize * inSize - 1);
+    stage.weight.reshape(outSize, inSize);
+    stage.bias = parameters.rows(outSize * inSize, parameters.n_elem - 1);
+    stage.inSize = inSize;
+    stage.outSize = outSize;
+    stage.activation = IDENTITY;
+
+    // Fuse a directly following elementwise activation into this stage.
+    if (i + 1 < model.size() && tryActivation(model[i + 1], activation) &&
+        activation != LOG_SOFTMAX)
+    {
+      stage.activation = activation;
+      ++i;
+    }
+
+    if (stages.empty())
+      inputSize = inSize;
+    width = outSize;
+    stages.push_back(std::move(stage));
+  }
+
+  std::ofstream f(path, std::ios::out | std::ios::trunc);
+  if (!f.is_open())
+  {
+    throw std::runtime_error("ExportCompiledInference(): cannot open file '" +
+        path + "' for writing!");
+  }
+
+  const char* activationNames[] =
+      { "identity", "logistic", "tanh", "rectifier", "log-softmax" };
+
+  f << "// Generated by mlpack ExportCompiledInference(); do not edit.\n";
+  f << "//\n";
+  f << "// " << functionName << "() runs one inference: input holds "
+      << inputSize << " values, output\n// receives " << width
+      << ".  Self-contained; compile with optimization.\n";
+  f << "\n";
+  f << "#include <cmath>\n";
+  f << "#include <cstddef>\n";
+  f << "\n";
+  f << "namespace {\n";
+
+  // Embed the weights as aligned static arrays.  Each Linear stage's weights
+  // are stored row-major, so that one output channel's weights are
+  // contiguous for the GEMV loop below.
+  f.precision(17);
+  for (size_t k = 0; k < stages.size(); ++k)
+  {
+    const Stage& stage = stages[k];
+    if (stage.weight.is_empty())
+      continue;
+
+    f << "\nalignas(64) const double weight" << k << "["
+        << stage.outSize * stage.inSize << "] = {";
+    for (size_t i = 0; i < stage.outSize; ++i)
+    {
+      for (size_t j = 0; j < stage.inSize; ++j)
+      {
+        f << ((i == 0 && j == 0) ? "\n  " : ((j % 4 == 0) ? ",\n  " : ", "))
+            << stage.weight(i, j);
+      }
+    }
+    f << "\n};\n";
+
+    f << "\nalignas(64) const double bias" << k << "[" << stage.outSize
+        << "] = {";
+    for (size_t i = 0; i < stage.outSize; ++i)
+      f << ((i == 0) ? "\n  " : ((i % 4 == 0) ? ",\n  " : ", "))
+          << stage.bias[i];
+    f << "\n};\n";
+  }
+
+  f << "\n} // namespace\n";
+  f << "\n";
+  f << "void " << functionName << "(const double* input, double* output)\n";
+  f << "{\n";
+
+  // Intermediate stage outputs ping-pong between two stack buffers; the last
+  // stage writes straight into the caller's output.
+  if (stages.size() > 1)
+  {
+    size_t maxWidth = 0;
+    for (size_t k = 0; k + 1 < stages.size(); ++k)
+      maxWidth = std::max(maxWidth, stages[k].outSize);
+
+    f << "  alignas(64) double scratch0[" << maxWidth << "];\n";
+    f << "  alignas(64) double scratch1[" << maxWidth << "];\n";
+  }
+
+  std::string cur = "input";
+  for (size_t k = 0; k < stages.size(); ++k)
+  {
+    const Stage& stage = stages[k];
+    const std::string out = (k + 1 == stages.size()) ? "output" :
+        ((cur == "scratch0") ? "scratch1" : "scratch0");
+
+    f << "\n  // Stage " << k << ": ";
+    if (!stage.weight.is_empty())
+      f << "linear(" << stage.inSize << " -> " << stage.outSize << "), ";
+    f << activationNames[stage.activation] << ".\n";
+    f << "  {\n";
+    f << "    const double* const in = " << cur << ";\n";
+    f << "    double* const out = " << out << ";\n";
+
+    if (!stage.weight.is_empty())
+    {
+      // Fused GEMV + activation with literal trip counts.
+      f << "    for (std::size_t i = 0; i < " << stage.outSize << "; ++i)\n";
+      f << "    {\n";
+      f << "      double sum = bias" << k << "[i];\n";
+      f << "      for (std::size_t j = 0; j < " << stage.inSize << "; ++j)\n";
+      f << "        sum += weight" << k << "[i * " << stage.inSize
+          << " + j] * in[j];\n";
+      switch (stage.activation)
+      {
+        case LOGISTIC:
+          f << "      out[i] = 1.0 / (1.0 + std::exp(-sum));\n";
+          break;
+        case TANH:
+          f << "      out[i] = std::tanh(sum);\n";
+          break;
+        case RECTIFIER:
+          f << "      out[i] = (sum > 0.0) ? sum : 0.0;\n";
+          break;
+        default:
+          f << "      out[i] = sum;\n";
+          break;
+      }
+      f << "    }\n";
+    }
+    else if (stage.activation == LOG_SOFTMAX)
+    {
+      f << "    double maxVal = in[0];\n";
+      f << "    for (std::size_t i = 1; i < " << stage.outSize << "; ++i)\n";
+      f << "      maxVal = (in[i] > maxVal) ? in[i] : maxVal;\n";
+      f << "    double sumExp = 0.0;\n";
+      f << "    for (std::size_t i = 0; i < " << stage.outSize << "; ++i)\n";
+      f << "      sumExp += std::exp(in[i] - maxVal);\n";
+      f << "    const double logSum = maxVal + std::log(sumExp);\n";
+      f << "    for (std::size_t i = 0; i < " << stage.outSize << "; ++i)\n";
+      f << "      out[i] = in[i] - logSum;\n";
+    }
+    else
+    {
+      // Standalone elementwise activation stage.
+      f << "    for (std::size_t i = 0; i < " << stage.outSize << "; ++i)\n";
+      switch (stage.activation)
+      {
+        case LOGISTIC:
+          f << "      out[i] = 1.0 / (1.0 + std::exp(-in[i]));\n";
+          break;
+        case TANH:
+          f << "      out[i] = std::tanh(in[i]);\n";
+          break;
+        case RECTIFIER:
+          f << "      out[i] = (in[i] > 0.0) ? in[i] : 0.0;\n";
+          break;
+        default:
+          f << "      out[i] = in[i];\n";
+          break;
+      }
+    }
+
+    f << "  }\n";
+    cur = out;
+  }
+
+  f << "}\n";
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,9 @@
 #define MLPACK_METHODS_ANN_FFN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/prefetching_batch_sampler.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
+#include <mlpack/core/math/workspace_arena.hpp>
 
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
@@ -124,6 +127,41 @@ class FFN
   template<typename OptimizerType = ens::RMSProp>
   double Train(arma::mat predictors, arma::mat responses);
 
+  /**
+   * Train the feedforward network on a streaming dataset that does not fit in
+   * RAM.  Each epoch takes one pass over the dataset, consuming fixed-size
+   * column batches as they are prefetched from disk, and runs the optimizer
+   * on every batch starting from the current model parameters.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param dataset Streaming dataset yielding predictor/response batches.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the dataset (default 1).
+   * @return The objective of the last trained batch (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename eT>
+  double Train(data::StreamingDataset<eT>& dataset,
+               OptimizerType& optimizer,
+               const size_t epochs = 1);
+
+  /**
+   * Train the feedforward network with shuffled mini-batches drawn by a
+   * PrefetchingBatchSampler.  Each epoch reshuffles only the sampler's index
+   * array and takes one pass over the dataset; every mini-batch is gathered
+   * into a staging buffer on a background thread while the previous one
+   * trains, so no shuffled copy of the dataset is ever materialized.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param sampler Batch sampler over the training data.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the dataset (default 1).
+   * @return The objective of the last trained batch (NaN or Inf on error).
+   */
+  template<typename OptimizerType>
+  double Train(data::PrefetchingBatchSampler<arma::mat, arma::mat>& sampler,
+               OptimizerType& optimizer,
+               const size_t epochs = 1);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -260,6 +298,14 @@ class FFN
   //! Return the number of separable functions (the number of predictor points).
   size_t NumFunctions() const { return numFunctions; }
 
+  //! Get the network modules.
+  const std::vector<LayerTypes<CustomLayers...> >& Model() const
+  {
+    return network;
+  }
+  //! Modify the network modules.
+  std::vector<LayerTypes<CustomLayers...> >& Model() { return network; }
+
   //! Return the initial point for the optimization.
   const arma::mat& Parameters() const { return parameter; }
   //! Modify the initial point for the optimization.
@@ -275,6 +321,21 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get whether mini-batches are evaluated data-parallel across threads.
+  bool ParallelTraining() const { return parallelTraining; }
+  //! Modify whether mini-batches are evaluated data-parallel across threads.
+  //! This only has an effect if mlpack was built with OpenMP support.
+  bool& ParallelTraining() { return parallelTraining; }
+
+  //! Get whether the dense gradient rewrite is skipped between evaluations.
+  bool SparseGradients() const { return sparseGradients; }
+  //! Modify whether the dense gradient rewrite is skipped between
+  //! evaluations.  Enable this for models dominated by sparse layers (e.g. a
+  //! large Lookup embedding); every weighted mlpack layer overwrites its own
+  //! slice of the gradient each pass, so the upfront full-matrix zeroing is
+  //! redundant and can dwarf the actual gradient computation.
+  bool& SparseGradients() { return sparseGradients; }
+
   /**
    * Reset the module infomration (weights/parameters).
    */
@@ -356,6 +417,75 @@ class FFN
    */
   void Gradient(arma::mat&& input);
 
+  /**
+   * Data-parallel implementation of EvaluateWithGradient().  The mini-batch
+   * is split into one slice per thread; each worker thread runs the forward
+   * and backward pass of its slice on a replica of this network, and the
+   * per-thread gradients are summed into the given gradient matrix.  The
+   * returned objective is identical (up to floating point summation order) to
+   * the serial evaluation of the whole batch.
+   *
+   * @param begin Index of the starting point of the mini-batch.
+   * @param gradient Matrix to output the summed gradient into.
+   * @param batchSize Number of points in the mini-batch.
+   */
+  template<typename GradType>
+  double EvaluateWithGradientParallel(const size_t begin,
+                                      GradType& gradient,
+                                      const size_t batchSize);
+
+  /**
+   * Compute the output layer's loss and error in one call.  This overload is
+   * selected (via expression SFINAE on the trailing int argument) when the
+   * output layer provides a fused ForwardBackward(), which produces the loss
+   * and the error in a single pass over the network output and the targets.
+   */
+  template<typename LayerType, typename InputType, typename TargetType,
+           typename ErrorType>
+  static auto OutputLossBackward(LayerType& layer,
+                                 InputType&& input,
+                                 TargetType&& target,
+                                 ErrorType&& error,
+                                 const int)
+      -> decltype(layer.ForwardBackward(std::move(input), std::move(target),
+          std::move(error)))
+  {
+    return layer.ForwardBackward(std::move(input), std::move(target),
+        std::move(error));
+  }
+
+  /**
+   * Fallback for output layers without a fused ForwardBackward(): compute the
+   * loss and the error with separate Forward() and Backward() calls.
+   */
+  template<typename LayerType, typename InputType, typename TargetType,
+           typename ErrorType>
+  static double OutputLossBackward(LayerType& layer,
+                                   InputType&& input,
+                                   TargetType&& target,
+                                   ErrorType&& error,
+                                   const long)
+  {
+    const double res = layer.Forward(std::move(input), std::move(target));
+    layer.Backward(std::move(input), std::move(target), std::move(error));
+    return res;
+  }
+
+  /**
+   * Copy the current parameters of this network into the given worker
+   * replica, re-aliasing the replica's layer weights onto its own parameter
+   * matrix.
+   */
+  void SyncReplica(FFN& replica);
+
+  /**
+   * Back every layer's output and delta matrix with the shared workspace
+   * arena, so that subsequent passes reuse one allocation instead of touching
+   * the heap per layer.  This may only be called once the shapes of those
+   * matrices are known, i.e. after a full forward/backward pass.
+   */
+  void ArmWorkspace();
+
   /**
    * Reset the module status by setting the current deterministic parameter
    * for all modules that implement the Deterministic function.
@@ -450,6 +580,23 @@ class FFN
   //! Locally-stored gradient parameter.
   arma::mat gradient;
 
+  //! Workspace arena backing the per-layer output and delta matrices.
+  math::WorkspaceArena<double> workspace;
+
+  //! Whether the layer matrices currently draw from the workspace arena.
+  bool workspaceArmed;
+
+  //! Whether mini-batches are evaluated data-parallel across threads.
+  bool parallelTraining;
+
+  //! Whether the full gradient rewrite between evaluations is skipped in
+  //! favor of per-layer (sparse) gradient writes.
+  bool sparseGradients;
+
+  //! Worker replicas used for data-parallel training, one per extra thread.
+  //! These are created lazily on the first parallel evaluation.
+  std::vector<FFN*> replicas;
+
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
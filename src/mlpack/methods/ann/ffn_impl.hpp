@@ -39,7 +39,10 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    workspaceArmed(false),
+    parallelTraining(false),
+    sparseGradients(false)
 {
   /* Nothing to do here */
 }
@@ -50,6 +53,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
+
+  for (size_t i = 0; i < replicas.size(); ++i)
+    delete replicas[i];
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -87,6 +93,67 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename eT>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::StreamingDataset<eT>& dataset,
+    OptimizerType& optimizer,
+    const size_t epochs)
+{
+  double out = 0;
+  arma::mat batchPredictors, batchResponses;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    dataset.Reset();
+    while (dataset.GetNextBatch(batchPredictors, batchResponses))
+    {
+      // Each batch continues the optimization from the current parameters.
+      ResetData(std::move(batchPredictors), std::move(batchResponses));
+
+      Timer::Start("ffn_optimization");
+      out = optimizer.Optimize(*this, parameter);
+      Timer::Stop("ffn_optimization");
+    }
+  }
+
+  Log::Info << "FFN::Train(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::PrefetchingBatchSampler<arma::mat, arma::mat>& sampler,
+    OptimizerType& optimizer,
+    const size_t epochs)
+{
+  double out = 0;
+  arma::mat batchPredictors, batchResponses;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    // Reshuffle the sampler's index array and start gathering the first
+    // batch; each subsequent batch is gathered while the previous one
+    // trains.
+    sampler.Reset();
+    while (sampler.GetNextBatch(batchPredictors, batchResponses))
+    {
+      // Each batch continues the optimization from the current parameters.
+      ResetData(std::move(batchPredictors), std::move(batchResponses));
+
+      Timer::Start("ffn_optimization");
+      out = optimizer.Optimize(*this, parameter);
+      Timer::Stop("ffn_optimization");
+    }
+  }
+
+  Log::Info << "FFN::Train(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType>
@@ -304,6 +371,17 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
                      GradType& gradient,
                      const size_t batchSize)
 {
+#ifdef HAS_OPENMP
+  // In data-parallel mode, split the mini-batch across a thread team.  The
+  // omp_in_parallel() check keeps the per-slice evaluations (which re-enter
+  // this function from inside the team) serial.
+  if (parallelTraining && batchSize > 1 && omp_get_max_threads() > 1 &&
+      !omp_in_parallel())
+  {
+    return EvaluateWithGradientParallel(begin, gradient, batchSize);
+  }
+#endif
+
   if (gradient.is_empty())
   {
     if (parameter.is_empty())
@@ -311,8 +389,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
     gradient = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
   }
-  else
+  else if (!sparseGradients)
   {
+    // With sparse gradients enabled this full rewrite is skipped: every
+    // weighted layer overwrites its own slice of the gradient below, and
+    // sparse layers such as Lookup zero only their stale columns.
     gradient.zeros();
   }
 
@@ -323,20 +404,20 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   }
 
   Forward(std::move(predictors.cols(begin, begin + batchSize - 1)));
-  double res = outputLayer.Forward(
+
+  // Compute the loss and the output layer's error in one call; output layers
+  // with a fused ForwardBackward() produce both in a single pass over the
+  // network output and the targets.
+  double res = OutputLossBackward(outputLayer,
       std::move(boost::apply_visitor(outputParameterVisitor, network.back())),
-      std::move(responses.cols(begin, begin + batchSize - 1)));
+      std::move(responses.cols(begin, begin + batchSize - 1)),
+      std::move(error), 0);
 
   for (size_t i = 0; i < network.size(); ++i)
   {
     res += boost::apply_visitor(lossVisitor, network[i]);
   }
 
-  outputLayer.Backward(
-      std::move(boost::apply_visitor(outputParameterVisitor, network.back())),
-      std::move(responses.cols(begin, begin + batchSize - 1)),
-      std::move(error));
-
   Backward();
   ResetGradients(gradient);
   Gradient(std::move(predictors.cols(begin, begin + batchSize - 1)));
@@ -355,6 +436,92 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
   this->EvaluateWithGradient(parameters, begin, gradient, batchSize);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename GradType>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateWithGradientParallel(const size_t begin,
+                             GradType& gradient,
+                             const size_t batchSize)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  const size_t threads = std::min((size_t) omp_get_max_threads(), batchSize);
+
+  // Create the worker replicas on first use.  The training data is detached
+  // before copying so the replicas do not duplicate the whole dataset; each
+  // worker only ever receives its slice of a mini-batch.
+  if (replicas.size() < threads - 1)
+  {
+    arma::mat tmpPredictors(std::move(predictors));
+    arma::mat tmpResponses(std::move(responses));
+    while (replicas.size() < threads - 1)
+      replicas.push_back(new FFN(*this));
+    predictors = std::move(tmpPredictors);
+    responses = std::move(tmpResponses);
+  }
+
+  gradient.zeros(parameter.n_rows, parameter.n_cols);
+
+  const size_t chunkSize = (batchSize + threads - 1) / threads;
+  double res = 0;
+
+  #pragma omp parallel num_threads((int) threads) reduction(+:res)
+  {
+    const size_t tid = (size_t) omp_get_thread_num();
+    const size_t chunkBegin = tid * chunkSize;
+    if (chunkBegin < batchSize)
+    {
+      const size_t chunkLen = std::min(chunkSize, batchSize - chunkBegin);
+      GradType localGradient;
+
+      if (tid == 0)
+      {
+        // The first slice is evaluated on this network itself, in place.
+        res += EvaluateWithGradient(parameter, begin + chunkBegin,
+            localGradient, chunkLen);
+      }
+      else
+      {
+        FFN& worker = *replicas[tid - 1];
+        SyncReplica(worker);
+        worker.ResetData(
+            predictors.cols(begin + chunkBegin,
+                begin + chunkBegin + chunkLen - 1),
+            responses.cols(begin + chunkBegin,
+                begin + chunkBegin + chunkLen - 1));
+        res += worker.EvaluateWithGradient(worker.parameter, 0, localGradient,
+            chunkLen);
+      }
+
+      #pragma omp critical
+      gradient += localGradient;
+    }
+  }
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+SyncReplica(FFN& replica)
+{
+  replica.parameter = parameter;
+
+  // Re-alias the replica's layer weights onto its freshly copied parameters,
+  // the same way serialization does after loading.
+  size_t offset = 0;
+  for (size_t i = 0; i < replica.network.size(); ++i)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(
+        std::move(replica.parameter), offset), replica.network[i]);
+
+    boost::apply_visitor(replica.resetVisitor, replica.network[i]);
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
@@ -471,6 +638,51 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
         std::move(boost::apply_visitor(deltaVisitor,
         network[network.size() - i]))), network[network.size() - i]);
   }
+
+  // After the first complete backward pass every layer's output and delta
+  // shape is known, so the workspace arena can take over their storage.
+  if (!workspaceArmed)
+    ArmWorkspace();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ArmWorkspace()
+{
+  workspace.Reset();
+
+  // First pass: reserve a region for every layer's output and delta matrix.
+  std::vector<size_t> outputOffsets(network.size());
+  std::vector<size_t> deltaOffsets(network.size());
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+        network[i]);
+    const arma::mat& layerDelta = boost::apply_visitor(deltaVisitor,
+        network[i]);
+
+    outputOffsets[i] = workspace.Reserve(output.n_rows, output.n_cols);
+    deltaOffsets[i] = workspace.Reserve(layerDelta.n_rows, layerDelta.n_cols);
+  }
+
+  workspace.Commit();
+
+  // Second pass: repoint the matrices into the slab.  The aliases are
+  // non-strict, so a layer that later changes shape (e.g. a smaller final
+  // mini-batch) detaches from the arena instead of corrupting it.
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+        network[i]);
+    arma::mat& layerDelta = boost::apply_visitor(deltaVisitor, network[i]);
+
+    workspace.Alias(output, outputOffsets[i], output.n_rows, output.n_cols);
+    workspace.Alias(layerDelta, deltaOffsets[i], layerDelta.n_rows,
+        layerDelta.n_cols);
+  }
+
+  workspaceArmed = true;
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -540,6 +752,7 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
 
     deterministic = true;
     ResetDeterministic();
+    workspaceArmed = false;
   }
 }
 
@@ -565,6 +778,11 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(workspace, network.workspace);
+  std::swap(workspaceArmed, network.workspaceArmed);
+  std::swap(parallelTraining, network.parallelTraining);
+  std::swap(sparseGradients, network.sparseGradients);
+  std::swap(replicas, network.replicas);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -586,7 +804,10 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    workspaceArmed(false),
+    parallelTraining(network.parallelTraining),
+    sparseGradients(network.sparseGradients)
 {
   // Build new layers according to source network
   for (size_t i = 0; i < network.network.size(); ++i)
@@ -615,9 +836,15 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    workspace(std::move(network.workspace)),
+    workspaceArmed(network.workspaceArmed),
+    parallelTraining(network.parallelTraining),
+    sparseGradients(network.sparseGradients),
+    replicas(std::move(network.replicas))
 {
   this->network = std::move(network.network);
+  network.replicas.clear();
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -0,0 +1,99 @@
+/**
+ * @file fold_batch_norm.hpp
+ *
+ * Definition of FoldBatchNorm(), an offline optimization that folds BatchNorm
+ * layers following Linear layers into the Linear weights, removing the
+ * BatchNorm layers from the network entirely.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_FOLD_BATCH_NORM_HPP
+#define MLPACK_METHODS_ANN_FOLD_BATCH_NORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer.hpp"
+#include "visitor/delete_visitor.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Fold every BatchNorm layer that directly follows a Linear layer into that
+ * Linear layer's weights and bias, and remove the BatchNorm layer from the
+ * network.  At inference time BatchNorm is the fixed per-channel transform
+ *
+ *   y = scale % x + shift,  scale = gamma / sqrt(var + eps),
+ *                           shift = beta - mean % scale,
+ *
+ * so composing it with the preceding Linear layer gives an ordinary Linear
+ * layer with weights scale % W (rowwise) and bias scale % b + shift; the
+ * folded network computes exactly the deterministic forward pass of the
+ * original with one layer fewer.
+ *
+ * This is an offline serving optimization: fold after training (or after
+ * loading a trained model), then use the network for prediction only.
+ * Folding edits the layer parameters in place and erases layers, so the
+ * folded network should not be trained further or serialized.
+ *
+ * @param network The network to fold (an FFN or compatible model exposing
+ *     Model()).
+ * @return The number of BatchNorm layers folded away.
+ */
+template<typename FFNType>
+size_t FoldBatchNorm(FFNType& network)
+{
+  auto& model = network.Model();
+
+  size_t folded = 0;
+  for (size_t i = 0; i + 1 < model.size(); ++i)
+  {
+    Linear<arma::mat, arma::mat>* const* linear =
+        boost::get<Linear<arma::mat, arma::mat>*>(&model[i]);
+    BatchNorm<arma::mat, arma::mat>* const* batchNorm =
+        boost::get<BatchNorm<arma::mat, arma::mat>*>(&model[i + 1]);
+    if (!linear || !batchNorm)
+      continue;
+
+    const size_t inSize = (*linear)->InputSize();
+    const size_t outSize = (*linear)->OutputSize();
+
+    // Sanity check: the BatchNorm layer must normalize exactly the channels
+    // the Linear layer produces.
+    if ((*batchNorm)->Parameters().n_elem != 2 * outSize)
+      continue;
+
+    // The folded per-channel scale and shift of the BatchNorm layer.
+    const arma::vec scale = (*batchNorm)->Parameters().rows(0, outSize - 1) /
+        arma::sqrt((*batchNorm)->TrainingVariance() +
+        (*batchNorm)->Epsilon());
+    const arma::vec shift =
+        (*batchNorm)->Parameters().rows(outSize, 2 * outSize - 1) -
+        (*batchNorm)->TrainingMean() % scale;
+
+    // The Linear parameter blob holds the (outSize x inSize) weight matrix
+    // followed by the bias.  Scale each weight row and fold the shift into
+    // the bias.
+    arma::mat& parameters = (*linear)->Parameters();
+    arma::mat weight(parameters.memptr(), outSize, inSize, false, false);
+    weight.each_col() %= scale;
+    parameters.rows(outSize * inSize, parameters.n_elem - 1) =
+        parameters.rows(outSize * inSize, parameters.n_elem - 1) % scale +
+        shift;
+
+    // Remove and free the now-redundant BatchNorm layer.
+    boost::apply_visitor(DeleteVisitor(), model[i + 1]);
+    model.erase(model.begin() + i + 1);
+    ++folded;
+  }
+
+  return folded;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,8 @@
 
 #include <mlpack/core.hpp>
 
+#include <future>
+
 #include <mlpack/methods/ann/ffn.hpp>
 #include <mlpack/methods/ann/gan/gan_policies.hpp>
 #include <mlpack/methods/ann/visitor/output_parameter_visitor.hpp>
@@ -303,6 +305,19 @@ class GAN
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Make the next noise batch available in `noise`.  If a prefetch task from
+   * the previous iteration is in flight its buffer is claimed by swapping;
+   * otherwise the noise is generated inline.
+   */
+  void AcquireNoise();
+
+  /**
+   * Start generating the next noise batch on a helper thread, so that it
+   * overlaps with the Discriminator's backward pass.
+   */
+  void PrefetchNoise();
+
   //! Locally stored parameter for training data + noise data.
   arma::mat predictors;
   //! Locally stored parameters of the network.
@@ -361,6 +376,10 @@ class GAN
   arma::mat normGradientDiscriminator;
   //! Locally stored noise using the noise function.
   arma::mat noise;
+  //! Noise buffer filled ahead of time by the helper thread.
+  arma::mat pendingNoise;
+  //! Handle to the in-flight noise generation task, if any.
+  std::future<void> noisePending;
   //! Locally stored gradient for Generator.
   arma::mat gradientGenerator;
   //! Locally stored output of the Generator network.
@@ -69,18 +69,22 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
   responses.set_size(1, predictors.n_cols);
   responses.ones();
 
+  // Two scratch batches are kept past the training data: one for the real
+  // batch and one for the generated batch, so that the Discriminator can
+  // score both with a single concatenated pass.
   this->discriminator.predictors.set_size(predictors.n_rows,
-      predictors.n_cols + batchSize);
+      predictors.n_cols + 2 * batchSize);
   this->discriminator.predictors.cols(0, predictors.n_cols - 1) = predictors;
 
-  this->discriminator.responses.set_size(1, predictors.n_cols + batchSize);
+  this->discriminator.responses.set_size(1, predictors.n_cols + 2 * batchSize);
   this->discriminator.responses.ones();
   this->discriminator.responses.cols(predictors.n_cols,
-      predictors.n_cols + batchSize - 1) = arma::zeros(1, batchSize);
+      predictors.n_cols + 2 * batchSize - 1) = arma::zeros(1, 2 * batchSize);
 
   numFunctions = predictors.n_cols;
 
   noise.set_size(noiseDim, batchSize);
+  pendingNoise.set_size(noiseDim, batchSize);
 
   this->generator.predictors.set_size(noiseDim, batchSize);
   this->generator.responses.set_size(predictors.n_rows, batchSize);
@@ -186,6 +190,39 @@ void GAN<Model, InitializationRuleType, Noise, PolicyType>::Reset()
   reset = true;
 }
 
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::AcquireNoise()
+{
+  if (noisePending.valid())
+  {
+    noisePending.get();
+    noise.swap(pendingNoise);
+  }
+  else
+  {
+    noise.imbue( [&]() { return noiseFunction();} );
+  }
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::PrefetchNoise()
+{
+  noisePending = std::async(std::launch::async, [this]()
+  {
+    pendingNoise.imbue( [&]() { return noiseFunction();} );
+  });
+}
+
 template<
   typename Model,
   typename InitializationRuleType,
@@ -218,30 +255,27 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
   if (!reset)
     Reset();
 
-  currentInput = arma::mat(predictors.memptr() + (i * predictors.n_rows),
-      predictors.n_rows, batchSize, false, false);
-  currentTarget = arma::mat(responses.memptr() + i, 1, batchSize, false,
-      false);
-
-  discriminator.Forward(std::move(currentInput));
-  double res = discriminator.outputLayer.Forward(
-      std::move(boost::apply_visitor(
-      outputParameterVisitor,
-      discriminator.network.back())), std::move(currentTarget));
-
   noise.imbue( [&]() { return noiseFunction();} );
   generator.Forward(std::move(noise));
 
+  // Stage the real and generated batches side by side, so that the
+  // Discriminator scores both with a single forward pass.
   discriminator.predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  discriminator.Forward(std::move(discriminator.predictors.cols(numFunctions,
-      numFunctions + batchSize - 1)));
+      predictors.cols(i, i + batchSize - 1);
+  discriminator.predictors.cols(numFunctions + batchSize,
+      numFunctions + 2 * batchSize - 1) = boost::apply_visitor(
+      outputParameterVisitor, generator.network.back());
   discriminator.responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+      arma::ones(1, batchSize);
+  discriminator.responses.cols(numFunctions + batchSize,
+      numFunctions + 2 * batchSize - 1) = arma::zeros(1, batchSize);
+
+  discriminator.Forward(std::move(discriminator.predictors.cols(numFunctions,
+      numFunctions + 2 * batchSize - 1)));
 
   currentTarget = arma::mat(discriminator.responses.memptr() + numFunctions,
-      1, batchSize, false, false);
-  res += discriminator.outputLayer.Forward(
+      1, 2 * batchSize, false, false);
+  double res = discriminator.outputLayer.Forward(
       std::move(boost::apply_visitor(
       outputParameterVisitor,
       discriminator.network.back())), std::move(currentTarget));
@@ -276,6 +310,13 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   else
     gradient.zeros();
 
+  gradientGenerator = arma::mat(gradient.memptr(),
+      generator.Parameters().n_elem, 1, false, false);
+
+  gradientDiscriminator = arma::mat(gradient.memptr() +
+      gradientGenerator.n_elem,
+      discriminator.Parameters().n_elem, 1, false, false);
+
   if (noiseGradientDiscriminator.is_empty())
   {
     noiseGradientDiscriminator = arma::zeros<arma::mat>(
@@ -286,36 +327,37 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     noiseGradientDiscriminator.zeros();
   }
 
-  gradientGenerator = arma::mat(gradient.memptr(),
-      generator.Parameters().n_elem, 1, false, false);
-
-  gradientDiscriminator = arma::mat(gradient.memptr() +
-      gradientGenerator.n_elem,
-      discriminator.Parameters().n_elem, 1, false, false);
-
-  // Get the gradients of the Discriminator.
-  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
-      i, gradientDiscriminator, batchSize);
-
-  noise.imbue( [&]() { return noiseFunction();} );
+  // Reuse the noise prefetched during the previous backward pass, if any.
+  AcquireNoise();
   generator.Forward(std::move(noise));
+
+  // Stage the real and generated batches side by side, so that one
+  // concatenated pass yields the real and fake gradients together.
   discriminator.predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
+      discriminator.predictors.cols(i, i + batchSize - 1);
+  discriminator.predictors.cols(numFunctions + batchSize,
+      numFunctions + 2 * batchSize - 1) = boost::apply_visitor(
+      outputParameterVisitor, generator.network.back());
   discriminator.responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+      arma::ones(1, batchSize);
+  discriminator.responses.cols(numFunctions + batchSize,
+      numFunctions + 2 * batchSize - 1) = arma::zeros(1, batchSize);
+
+  // Generate the next iteration's noise on a helper thread while the
+  // Discriminator runs its forward and backward passes.
+  PrefetchNoise();
 
-  // Get the gradients of the Generator.
-  res += discriminator.EvaluateWithGradient(discriminator.parameter,
-      numFunctions, noiseGradientDiscriminator, batchSize);
-  gradientDiscriminator += noiseGradientDiscriminator;
+  // Get the gradients of the Discriminator for both batches at once.
+  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
+      numFunctions, gradientDiscriminator, 2 * batchSize);
 
   if (currentBatch % generatorUpdateStep == 0 && preTrainSize == 0)
   {
     // Minimize -log(D(G(noise))).
     // Pass the error from Discriminator to Generator.
-    discriminator.responses.cols(numFunctions, numFunctions + batchSize - 1) =
-        arma::ones(1, batchSize);
-    discriminator.Gradient(discriminator.parameter, numFunctions,
+    discriminator.responses.cols(numFunctions + batchSize,
+        numFunctions + 2 * batchSize - 1) = arma::ones(1, batchSize);
+    discriminator.Gradient(discriminator.parameter, numFunctions + batchSize,
         noiseGradientDiscriminator, batchSize);
     generator.error = boost::apply_visitor(deltaVisitor,
         discriminator.network[1]);
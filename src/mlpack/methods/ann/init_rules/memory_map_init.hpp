@@ -0,0 +1,210 @@
+/**
+ * @file memory_map_init.hpp
+ *
+ * Intialization rule for the neural networks.  The weights are not generated
+ * at all: the parameter matrix is aliased over a memory-mapped weight file,
+ * so large pretrained weights (e.g. embedding tables) are loaded without
+ * copying them into fresh heap memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INIT_RULES_MEMORY_MAP_INIT_HPP
+#define MLPACK_METHODS_ANN_INIT_RULES_MEMORY_MAP_INIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "init_rules_traits.hpp"
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+#endif
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * This class is used to initialize the weight matrix from a file of
+ * pretrained weights, stored as raw elements in column-major order.  Instead
+ * of reading the file into freshly allocated memory, the file is
+ * memory-mapped copy-on-write and the weight matrix is made an alias of the
+ * mapping.  Nothing is copied at startup, the pages stay shared with the
+ * page cache (and with any other process mapping the same file) until they
+ * are written, and only the weights that are actually updated during
+ * training fault in private pages.
+ *
+ * This rule initializes the complete network parameter matrix at once (see
+ * InitTraits below), so when it is used with FFN::ResetParameters() the
+ * whole parameter block aliases the file and the layers pick up their slices
+ * of it as usual.  The mapping stays valid for the lifetime of the process.
+ *
+ * On platforms without POSIX mmap() the rule falls back to reading the file
+ * into ordinary memory.
+ */
+class MemoryMapInitialization
+{
+ public:
+  /**
+   * Create the MemoryMapInitialization object.
+   *
+   * @param filename File holding the raw weight elements.
+   * @param elementOffset Number of elements to skip at the start of the
+   *      file.
+   */
+  MemoryMapInitialization(const std::string& filename,
+                          const size_t elementOffset = 0) :
+      filename(filename), elementOffset(elementOffset)
+  { /* Nothing to do here */ }
+
+  /**
+   * Initialize the elements of the specified weight matrix as an alias of
+   * the memory-mapped weight file.
+   *
+   * @param W Weight matrix to initialize.
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   */
+  template<typename eT>
+  void Initialize(arma::Mat<eT>& W, const size_t rows, const size_t cols)
+  {
+#ifndef _WIN32
+    W = arma::Mat<eT>(Map<eT>(rows * cols), rows, cols, false, false);
+#else
+    W.set_size(rows, cols);
+    Read(W.memptr(), rows * cols * sizeof(eT), elementOffset * sizeof(eT));
+#endif
+  }
+
+  /**
+   * Initialize the elements of the specified weight (3rd order tensor) as an
+   * alias of the memory-mapped weight file.
+   *
+   * @param W Weight matrix to initialize.
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param slices Number of slices.
+   */
+  template<typename eT>
+  void Initialize(arma::Cube<eT>& W,
+                  const size_t rows,
+                  const size_t cols,
+                  const size_t slices)
+  {
+#ifndef _WIN32
+    W = arma::Cube<eT>(Map<eT>(rows * cols * slices), rows, cols, slices,
+        false, false);
+#else
+    W.set_size(rows, cols, slices);
+    Read(W.memptr(), rows * cols * slices * sizeof(eT),
+        elementOffset * sizeof(eT));
+#endif
+  }
+
+  //! Get the filename of the weight file.
+  const std::string& Filename() const { return filename; }
+  //! Modify the filename of the weight file.
+  std::string& Filename() { return filename; }
+
+  //! Get the element offset into the weight file.
+  size_t ElementOffset() const { return elementOffset; }
+  //! Modify the element offset into the weight file.
+  size_t& ElementOffset() { return elementOffset; }
+
+ private:
+#ifndef _WIN32
+  /**
+   * Map the weight file copy-on-write and return a pointer to the requested
+   * elements.  The mapping is never unmapped; it must outlive the weight
+   * matrices aliasing it, so it is kept for the lifetime of the process.
+   *
+   * @param elements Number of elements to map, past the element offset.
+   */
+  template<typename eT>
+  eT* Map(const size_t elements)
+  {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      Log::Fatal << "MemoryMapInitialization::Initialize(): cannot open "
+          << "weight file '" << filename << "'!" << std::endl;
+    }
+
+    // Map from the beginning of the file, so that the offset passed to
+    // mmap() is trivially page-aligned; the element offset is applied to the
+    // returned pointer instead.
+    const size_t bytes = (elementOffset + elements) * sizeof(eT);
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) < 0 || (size_t) fileInfo.st_size < bytes)
+    {
+      Log::Fatal << "MemoryMapInitialization::Initialize(): weight file '"
+          << filename << "' is smaller than the requested " << bytes
+          << " bytes!" << std::endl;
+    }
+
+    // MAP_PRIVATE gives copy-on-write semantics: reads are served from
+    // pages shared with the page cache, and writes fault in private copies
+    // without modifying the file.
+    void* mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+        fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      Log::Fatal << "MemoryMapInitialization::Initialize(): cannot map "
+          << "weight file '" << filename << "'!" << std::endl;
+    }
+
+    return ((eT*) mapping) + elementOffset;
+  }
+#else
+  /**
+   * Fallback for platforms without POSIX mmap(): read the requested bytes of
+   * the weight file into the given buffer.
+   *
+   * @param buffer Buffer to read into.
+   * @param bytes Number of bytes to read.
+   * @param byteOffset Offset into the file to read from.
+   */
+  void Read(void* buffer, const size_t bytes, const size_t byteOffset)
+  {
+    std::ifstream stream(filename, std::ios::binary);
+    stream.seekg(byteOffset);
+    stream.read((char*) buffer, bytes);
+    if (!stream)
+    {
+      Log::Fatal << "MemoryMapInitialization::Initialize(): cannot read "
+          << bytes << " bytes from weight file '" << filename << "'!"
+          << std::endl;
+    }
+  }
+#endif
+
+  //! File holding the raw weight elements.
+  std::string filename;
+
+  //! Number of elements to skip at the start of the file.
+  size_t elementOffset;
+}; // class MemoryMapInitialization
+
+//! Initialization traits of the memory-mapped initialization rule: the
+//! complete parameter matrix is aliased over the file at once, so the layer
+//! weights become slices of the mapping.
+template<>
+class InitTraits<MemoryMapInitialization>
+{
+ public:
+  //! The memory-mapped initialization rule is used for the complete network.
+  static const bool UseLayer = false;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
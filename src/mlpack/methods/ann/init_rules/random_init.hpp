@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_INIT_RULES_RANDOM_INIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -55,8 +56,22 @@ class RandomInitialization
   template<typename eT>
   void Initialize(arma::Mat<eT>& W, const size_t rows, const size_t cols)
   {
-    W = lowerBound + arma::randu<arma::Mat<eT>>(rows, cols) *
-        (upperBound - lowerBound);
+    W.set_size(rows, cols);
+
+    // Draw one stream identifier serially, then fill the columns in parallel
+    // from per-column sub-streams; the weights are reproducible regardless of
+    // the thread count.
+    const uint64_t streamId =
+        (uint64_t) math::RandInt(std::numeric_limits<int>::max());
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) cols; ++i)
+    {
+      math::RandomStream stream(streamId, i);
+      eT* col = W.colptr(i);
+      for (size_t j = 0; j < rows; ++j)
+        col[j] = (eT) stream.Random(lowerBound, upperBound);
+    }
   }
 
   /**
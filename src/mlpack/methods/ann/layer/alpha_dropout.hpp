@@ -107,7 +107,8 @@ class AlphaDropout
   //! Value of alphaDash.
   double AlphaDash() const {return alphaDash; }
 
-  //! Get the mask.
+  //! Get the mask.  Kept units hold the affine scale `a`, dropped units
+  //! hold zero.
   OutputDataType const& Mask() const {return mask;}
 
   //! Modify the probability of setting a value to alphaDash. As
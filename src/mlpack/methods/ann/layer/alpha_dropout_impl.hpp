@@ -19,6 +19,8 @@
 // In case it hasn't yet been included.
 #include "alpha_dropout.hpp"
 
+#include <mlpack/core/math/random.hpp>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -48,10 +50,14 @@ void AlphaDropout<InputDataType, OutputDataType>::Forward(
   {
     // Set values to alphaDash with probability ratio.  Then apply affine
     // transformation so as to keep mean and variance of outputs to their
-    // original values.
-    mask = arma::randu< arma::Mat<eT> >(input.n_rows, input.n_cols);
-    mask.transform( [&](double val) { return (val > ratio); } );
-    output = (input % mask + alphaDash * (1 - mask)) * a + b;
+    // original values.  The draw, threshold, and affine scale are fused into
+    // one pass filling the reused mask buffer: kept units carry `a` directly
+    // and dropped units are zero, so
+    // (input - alphaDash) % mask + (alphaDash * a + b) gives a * x + b for
+    // kept units and alphaDash * a + b for dropped ones.
+    mask.set_size(input.n_rows, input.n_cols);
+    mask.imbue( [&]() { return (math::Random() > ratio) * a; } );
+    output = (input - alphaDash) % mask + (alphaDash * a + b);
   }
 }
 
@@ -60,7 +66,7 @@ template<typename eT>
 void AlphaDropout<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>&& /* input */, arma::Mat<eT>&& gy, arma::Mat<eT>&& g)
 {
-  g = gy % mask * a;
+  g = gy % mask;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -138,6 +138,9 @@ class BatchNorm
   //! Get the variance over the training data.
   OutputDataType TrainingVariance() { return runningVariance / count; }
 
+  //! Get the epsilon value used to avoid division by zero.
+  double Epsilon() const { return eps; }
+
   /**
    * Serialize the layer
    */
@@ -195,6 +198,17 @@ class BatchNorm
 
   //! Locally-stored normalized input.
   OutputDataType normalized;
+
+  //! Whether the fused inference scale and shift are up to date.
+  bool inferenceReady;
+
+  //! The folded per-channel scale gamma / sqrt(runningVariance / count + eps)
+  //! used by the deterministic forward pass.
+  OutputDataType inferenceScale;
+
+  //! The folded per-channel shift beta - runningMean % inferenceScale used by
+  //! the deterministic forward pass.
+  OutputDataType inferenceShift;
 }; // class BatchNorm
 
 } // namespace ann
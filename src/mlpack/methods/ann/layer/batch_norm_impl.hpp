@@ -25,7 +25,8 @@ BatchNorm<InputDataType, OutputDataType>::BatchNorm() :
     eps(1e-8),
     loading(false),
     deterministic(false),
-    count(0)
+    count(0),
+    inferenceReady(false)
 {
   // Nothing to do here.
 }
@@ -36,7 +37,8 @@ BatchNorm<InputDataType, OutputDataType>::BatchNorm(
     eps(eps),
     loading(false),
     deterministic(false),
-    count(0)
+    count(0),
+    inferenceReady(false)
 {
   weights.set_size(size + size, 1);
   runningMean.zeros(size, 1);
@@ -57,6 +59,7 @@ void BatchNorm<InputDataType, OutputDataType>::Reset()
 
   deterministic = false;
   loading = false;
+  inferenceReady = false;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -68,13 +71,35 @@ void BatchNorm<InputDataType, OutputDataType>::Forward(
   // the forward pass when deterministic is set to true.
   if (deterministic)
   {
-    // Normalize the input and scale and shift the output.
-    output = input.each_col() - runningMean;
-    output.each_col() %= gamma / arma::sqrt(runningVariance / count + eps);
-    output.each_col() += beta;
+    // At inference time the transform is a fixed per-channel scale and shift,
+    // so fold the running statistics, gamma, and beta into those two vectors
+    // once, and apply them in a single multiply-add pass.
+    if (!inferenceReady)
+    {
+      inferenceScale = gamma / arma::sqrt(runningVariance / count + eps);
+      inferenceShift = beta - runningMean % inferenceScale;
+      inferenceReady = true;
+    }
+
+    output.set_size(input.n_rows, input.n_cols);
+    const eT* scale = inferenceScale.memptr();
+    const eT* shift = inferenceShift.memptr();
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    {
+      const eT* in = input.colptr(i);
+      eT* out = output.colptr(i);
+      for (size_t r = 0; r < input.n_rows; ++r)
+        out[r] = in[r] * scale[r] + shift[r];
+    }
   }
   else
   {
+    // Training updates the running statistics, so any folded inference
+    // transform is stale.
+    inferenceReady = false;
+
     mean = arma::mean(input, 1);
     variance = arma::var(input, 1, 1);
 
@@ -155,6 +180,7 @@ void BatchNorm<InputDataType, OutputDataType>::serialize(
   {
     weights.set_size(size + size, 1);
     loading = false;
+    inferenceReady = false;
   }
 
   ar & BOOST_SERIALIZATION_NVP(eps);
@@ -16,6 +16,8 @@
 // In case it hasn't yet been included.
 #include "dropout.hpp"
 
+#include <mlpack/core/math/random.hpp>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -44,10 +46,12 @@ void Dropout<InputDataType, OutputDataType>::Forward(
   else
   {
     // Scale with input / (1 - ratio) and set values to zero with probability
-    // 'ratio'.
-    mask = arma::randu<arma::Mat<eT> >(input.n_rows, input.n_cols);
-    mask.transform([&](double val) { return (val > ratio); });
-    output = input % mask * scale;
+    // 'ratio'.  The draw, threshold, and scale are fused into one pass that
+    // fills the reused mask buffer, so applying it is a single multiply; the
+    // mask holds 0 or `scale` directly.
+    mask.set_size(input.n_rows, input.n_cols);
+    mask.imbue( [&]() { return (math::Random() > ratio) * scale; } );
+    output = input % mask;
   }
 }
 
@@ -58,7 +62,7 @@ void Dropout<InputDataType, OutputDataType>::Backward(
     arma::Mat<eT>&& gy,
     arma::Mat<eT>&& g)
 {
-  g = gy % mask * scale;
+  g = gy % mask;
 }
 
 template<typename InputDataType, typename OutputDataType>
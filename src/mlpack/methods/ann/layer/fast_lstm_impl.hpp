@@ -123,47 +123,69 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
     ResetCell(rhoSize);
   }
 
-  gate.cols(forwardStep, forwardStep + batchStep) = input2GateWeight * input +
-      output2GateWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-  gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
-
-  FastSigmoid(std::move(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep)),
-      std::move(gateActivation.cols(forwardStep, forwardStep + batchStep)));
+  // Alias this timestep's slice of every rolling buffer as a plain matrix.
+  // The slices are contiguous in memory, so the GEMMs and elementwise updates
+  // below write straight into the preallocated storage instead of going
+  // through subview temporaries.
+  OutputDataType gateBlock(gate.memptr() + forwardStep * 4 * outSize,
+      4 * outSize, batchSize, false, false);
+  OutputDataType gateActivationBlock(gateActivation.memptr() +
+      forwardStep * 3 * outSize, 3 * outSize, batchSize, false, false);
+  OutputDataType stateActivationBlock(stateActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType cellBlock(cell.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType cellActivationBlock(cellActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType prevOutputBlock(outParameter.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType outputBlock(outParameter.memptr() +
+      (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
 
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
+  // One GEMM covers all four gate projections of the input; the recurrent
+  // projections accumulate in place with a second GEMM, so no temporary is
+  // created for the sum.
+  gateBlock = input2GateWeight * input;
+  gateBlock += output2GateWeight * prevOutputBlock;
+  gateBlock.each_col() += input2GateBias;
+
+  // Apply every gate activation in a single pass over the gate block: the
+  // first three row bands (input, output and forget gate) are squashed with
+  // the sigmoid approximation, the last band (hidden state) with tanh.
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const ElemType* gateIn = gateBlock.colptr(i);
+    ElemType* sigmoidOut = gateActivationBlock.colptr(i);
+    ElemType* tanhOut = stateActivationBlock.colptr(i);
+
+    for (size_t j = 0; j < 3 * outSize; ++j)
+      sigmoidOut[j] = FastSigmoid(gateIn[j]);
+    for (size_t j = 0; j < outSize; ++j)
+      tanhOut[j] = std::tanh(gateIn[3 * outSize + j]);
+  }
 
   // Update the cell: cmul1 + cmul2
   // where cmul1 is input gate * hidden state and
   // cmul2 is forget gate * cell (prevCell).
   if (forwardStep == 0)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
+    cellBlock = gateActivationBlock.rows(0, outSize - 1) %
+        stateActivationBlock;
   }
   else
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    OutputDataType prevCellBlock(cell.memptr() +
+        (forwardStep - batchSize) * outSize, outSize, batchSize, false, false);
+
+    cellBlock = gateActivationBlock.rows(0, outSize - 1) %
+        stateActivationBlock +
+        gateActivationBlock.rows(2 * outSize, 3 * outSize - 1) % prevCellBlock;
   }
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
+  cellActivationBlock = arma::tanh(cellBlock);
 
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
+  outputBlock = cellActivationBlock %
+      gateActivationBlock.rows(outSize, 2 * outSize - 1);
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
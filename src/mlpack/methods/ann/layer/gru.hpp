@@ -193,6 +193,26 @@ class GRU
   //! Locally-stored forget gate module.
   LayerTypes<> forgetGateModule;
 
+  //! Typed pointer to input2GateModule, so the forward and backward passes
+  //! can call into it directly instead of dispatching through
+  //! boost::apply_visitor at every timestep.
+  Linear<arma::mat, arma::mat>* input2GateLayer;
+
+  //! Typed pointer to output2GateModule.
+  LinearNoBias<arma::mat, arma::mat>* output2GateLayer;
+
+  //! Typed pointer to outputHidden2GateModule.
+  LinearNoBias<arma::mat, arma::mat>* outputHidden2GateLayer;
+
+  //! Typed pointer to inputGateModule.
+  BaseLayer<LogisticFunction, arma::mat, arma::mat>* inputGateLayer;
+
+  //! Typed pointer to forgetGateModule.
+  BaseLayer<LogisticFunction, arma::mat, arma::mat>* forgetGateLayer;
+
+  //! Typed pointer to hiddenStateModule.
+  BaseLayer<TanhFunction, arma::mat, arma::mat>* hiddenStateLayer;
+
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
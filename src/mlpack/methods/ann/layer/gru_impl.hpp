@@ -43,22 +43,32 @@ GRU<InputDataType, OutputDataType>::GRU(
     gradientStep(0),
     deterministic(false)
 {
-  // Input specific linear layers(for zt, rt, ot).
-  input2GateModule = new Linear<>(inSize, 3 * outSize);
+  // Input specific linear layers(for zt, rt, ot).  We keep typed pointers
+  // alongside the variant handles, so that the forward and backward passes
+  // can call into the modules directly instead of dispatching through
+  // boost::apply_visitor at every timestep.
+  input2GateLayer = new Linear<>(inSize, 3 * outSize);
+  input2GateModule = input2GateLayer;
 
   // Previous output gates (for zt and rt).
-  output2GateModule = new LinearNoBias<>(outSize, 2 * outSize);
+  output2GateLayer = new LinearNoBias<>(outSize, 2 * outSize);
+  output2GateModule = output2GateLayer;
 
   // Previous output gate for ot.
-  outputHidden2GateModule = new LinearNoBias<>(outSize, outSize);
+  outputHidden2GateLayer = new LinearNoBias<>(outSize, outSize);
+  outputHidden2GateModule = outputHidden2GateLayer;
 
   network.push_back(input2GateModule);
   network.push_back(output2GateModule);
   network.push_back(outputHidden2GateModule);
 
-  inputGateModule = new SigmoidLayer<>();
-  forgetGateModule = new SigmoidLayer<>();
-  hiddenStateModule = new TanHLayer<>();
+  inputGateLayer = new SigmoidLayer<>();
+  forgetGateLayer = new SigmoidLayer<>();
+  hiddenStateLayer = new TanHLayer<>();
+
+  inputGateModule = inputGateLayer;
+  forgetGateModule = forgetGateLayer;
+  hiddenStateModule = hiddenStateLayer;
 
   network.push_back(inputGateModule);
   network.push_back(hiddenStateModule);
@@ -113,57 +123,42 @@ void GRU<InputDataType, OutputDataType>::Forward(
     gradIterator = outParameter.end();
   }
 
-  // Process the input linearly(zt, rt, ot).
-  boost::apply_visitor(ForwardVisitor(std::move(input), std::move(
-      boost::apply_visitor(outputParameterVisitor, input2GateModule))),
-      input2GateModule);
-
-  // Process the output(zt, rt) linearly.
-  boost::apply_visitor(ForwardVisitor(std::move(*prevOutput), std::move(
-      boost::apply_visitor(outputParameterVisitor, output2GateModule))),
-      output2GateModule);
+  arma::mat& input2Gate = input2GateLayer->OutputParameter();
+  arma::mat& output2Gate = output2GateLayer->OutputParameter();
+  arma::mat& outputHidden2Gate = outputHidden2GateLayer->OutputParameter();
+  arma::mat& inputGate = inputGateLayer->OutputParameter();
+  arma::mat& forgetGate = forgetGateLayer->OutputParameter();
+  arma::mat& hiddenState = hiddenStateLayer->OutputParameter();
 
-  // Merge the outputs(zt and rt).
-  output = (boost::apply_visitor(outputParameterVisitor,
-      input2GateModule).submat(0, 0, 2 * outSize - 1, batchSize - 1) +
-      boost::apply_visitor(outputParameterVisitor, output2GateModule));
+  // Process the input linearly(zt, rt, ot).  All three gate projections of
+  // the input are one fused GEMM inside the inner linear layer.
+  input2GateLayer->Forward(std::move(input), std::move(input2Gate));
 
-  // Pass the first outSize through inputGate(it).
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      0, 0, 1 * outSize - 1, batchSize - 1)), std::move(boost::apply_visitor(
-      outputParameterVisitor, inputGateModule))), inputGateModule);
+  // Process the output(zt, rt) linearly, and merge the input projections of
+  // zt and rt into it in place.
+  output2GateLayer->Forward(std::move(*prevOutput), std::move(output2Gate));
+  output2Gate += input2Gate.rows(0, 2 * outSize - 1);
 
-  // Pass the second through forgetGate.
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      1 * outSize, 0, 2 * outSize - 1, batchSize - 1)), std::move(
-      boost::apply_visitor(outputParameterVisitor, forgetGateModule))),
-      forgetGateModule);
+  // Pass the first outSize through inputGate(it), and the second through
+  // forgetGate, straight from the merged pre-activation bands.
+  inputGate = 1.0 / (1.0 + arma::exp(-output2Gate.rows(0, outSize - 1)));
+  forgetGate = 1.0 / (1.0 +
+      arma::exp(-output2Gate.rows(outSize, 2 * outSize - 1)));
 
-  arma::mat modInput = (boost::apply_visitor(outputParameterVisitor,
-      forgetGateModule) % *prevOutput);
+  arma::mat modInput = forgetGate % *prevOutput;
 
   // Pass that through the outputHidden2GateModule.
-  boost::apply_visitor(ForwardVisitor(std::move(modInput), std::move(
-      boost::apply_visitor(outputParameterVisitor, outputHidden2GateModule))),
-      outputHidden2GateModule);
+  outputHidden2GateLayer->Forward(std::move(modInput),
+      std::move(outputHidden2Gate));
 
-  // Merge for ot.
-  arma::mat outputH = boost::apply_visitor(outputParameterVisitor,
-      input2GateModule).submat(2 * outSize, 0, 3 * outSize - 1, batchSize - 1) +
-      boost::apply_visitor(outputParameterVisitor, outputHidden2GateModule);
-
-  // Pass it through hiddenGate.
-  boost::apply_visitor(ForwardVisitor(std::move(outputH), std::move(
-      boost::apply_visitor(outputParameterVisitor, hiddenStateModule))),
-      hiddenStateModule);
+  // Merge for ot and pass it through hiddenGate.
+  outputHidden2Gate += input2Gate.rows(2 * outSize, 3 * outSize - 1);
+  hiddenState = arma::tanh(outputHidden2Gate);
 
   // Update the output (nextOutput): cmul1 + cmul2
   // Where cmul1 is input gate * prevOutput and
   // cmul2 is (1 - input gate) * hidden gate.
-  output = (boost::apply_visitor(outputParameterVisitor, inputGateModule)
-      % (*prevOutput - boost::apply_visitor(outputParameterVisitor,
-      hiddenStateModule))) + boost::apply_visitor(outputParameterVisitor,
-      hiddenStateModule);
+  output = inputGate % (*prevOutput - hiddenState) + hiddenState;
 
   forwardStep++;
   if (forwardStep == rho)
@@ -230,7 +225,7 @@ void GRU<InputDataType, OutputDataType>::Backward(
 
   if ((outParameter.size() - backwardStep  - 1) % rho != 0 && backwardStep != 0)
   {
-    gy += boost::apply_visitor(deltaVisitor, output2GateModule);
+    gy += output2GateLayer->Delta();
   }
 
   if (backIterator == outParameter.end())
@@ -238,82 +233,68 @@ void GRU<InputDataType, OutputDataType>::Backward(
     backIterator = --(--outParameter.end());
   }
 
+  arma::mat& inputGate = inputGateLayer->OutputParameter();
+  arma::mat& forgetGate = forgetGateLayer->OutputParameter();
+  arma::mat& hiddenState = hiddenStateLayer->OutputParameter();
+
   // Delta zt.
-  arma::mat dZt = gy % (*backIterator -
-      boost::apply_visitor(outputParameterVisitor,
-      hiddenStateModule));
+  arma::mat dZt = gy % (*backIterator - hiddenState);
 
   // Delta ot.
-  arma::mat dOt = gy % (arma::ones<arma::mat>(outSize, batchSize) -
-      boost::apply_visitor(outputParameterVisitor, inputGateModule));
+  arma::mat dOt = gy % (arma::ones<arma::mat>(outSize, batchSize) - inputGate);
 
   // Delta of input gate.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, inputGateModule)), std::move(dZt),
-      std::move(boost::apply_visitor(deltaVisitor, inputGateModule))),
-      inputGateModule);
+  inputGateLayer->Backward(std::move(inputGate), std::move(dZt),
+      std::move(inputGateLayer->Delta()));
 
   // Delta of hidden gate.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, hiddenStateModule)), std::move(dOt),
-      std::move(boost::apply_visitor(deltaVisitor, hiddenStateModule))),
-      hiddenStateModule);
+  hiddenStateLayer->Backward(std::move(hiddenState), std::move(dOt),
+      std::move(hiddenStateLayer->Delta()));
 
   // Delta of outputHidden2GateModule.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, outputHidden2GateModule)),
-      std::move(boost::apply_visitor(deltaVisitor, hiddenStateModule)),
-      std::move(boost::apply_visitor(deltaVisitor, outputHidden2GateModule))),
-      outputHidden2GateModule);
+  outputHidden2GateLayer->Backward(
+      std::move(outputHidden2GateLayer->OutputParameter()),
+      std::move(hiddenStateLayer->Delta()),
+      std::move(outputHidden2GateLayer->Delta()));
 
   // Delta rt.
-  arma::mat dRt = boost::apply_visitor(deltaVisitor, outputHidden2GateModule) %
-      *backIterator;
+  arma::mat dRt = outputHidden2GateLayer->Delta() % *backIterator;
 
   // Delta of forget gate.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, forgetGateModule)), std::move(dRt),
-      std::move(boost::apply_visitor(deltaVisitor, forgetGateModule))),
-      forgetGateModule);
+  forgetGateLayer->Backward(std::move(forgetGate), std::move(dRt),
+      std::move(forgetGateLayer->Delta()));
 
   // Put delta zt.
-  prevError.submat(0, 0, 1 * outSize - 1, batchSize - 1) = boost::apply_visitor(
-      deltaVisitor, inputGateModule);
+  prevError.submat(0, 0, 1 * outSize - 1, batchSize - 1) =
+      inputGateLayer->Delta();
 
   // Put delta rt.
   prevError.submat(1 * outSize, 0, 2 * outSize - 1, batchSize - 1) =
-      boost::apply_visitor(deltaVisitor, forgetGateModule);
+      forgetGateLayer->Delta();
 
   // Put delta ot.
   prevError.submat(2 * outSize, 0, 3 * outSize - 1, batchSize - 1) =
-      boost::apply_visitor(deltaVisitor, hiddenStateModule);
+      hiddenStateLayer->Delta();
 
   // Get delta ht - 1 for input gate and forget gate.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, input2GateModule)),
-      std::move(prevError.submat(0, 0, 2 * outSize - 1, batchSize - 1)),
-      std::move(boost::apply_visitor(deltaVisitor, output2GateModule))),
-      output2GateModule);
+  arma::mat zrError = prevError.submat(0, 0, 2 * outSize - 1, batchSize - 1);
+  output2GateLayer->Backward(std::move(output2GateLayer->OutputParameter()),
+      std::move(zrError), std::move(output2GateLayer->Delta()));
 
   // Add delta ht - 1 from hidden state.
-  boost::apply_visitor(deltaVisitor, output2GateModule) +=
-      boost::apply_visitor(deltaVisitor, outputHidden2GateModule) %
-      boost::apply_visitor(outputParameterVisitor, forgetGateModule);
+  output2GateLayer->Delta() += outputHidden2GateLayer->Delta() % forgetGate;
 
   // Add delta ht - 1 from ht.
-  boost::apply_visitor(deltaVisitor, output2GateModule) += gy %
-      boost::apply_visitor(outputParameterVisitor, inputGateModule);
+  output2GateLayer->Delta() += gy % inputGate;
 
   // Get delta input.
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, input2GateModule)), std::move(prevError),
-      std::move(boost::apply_visitor(deltaVisitor, input2GateModule))),
-      input2GateModule);
+  input2GateLayer->Backward(std::move(input2GateLayer->OutputParameter()),
+      std::move(prevError), std::move(input2GateLayer->Delta()));
 
   backwardStep++;
   backIterator--;
 
-  g = boost::apply_visitor(deltaVisitor, input2GateModule);
+  g = input2GateLayer->Delta();
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -349,19 +330,18 @@ void GRU<InputDataType, OutputDataType>::Gradient(
     gradIterator = --(--outParameter.end());
   }
 
-  boost::apply_visitor(GradientVisitor(std::move(input), std::move(prevError)),
-      input2GateModule);
+  input2GateLayer->Gradient(std::move(input), std::move(prevError),
+      std::move(input2GateLayer->Gradient()));
 
-  boost::apply_visitor(GradientVisitor(
-      std::move(*gradIterator),
-      std::move(prevError.submat(0, 0, 2 * outSize - 1, batchSize - 1))),
-      output2GateModule);
+  arma::mat zrError = prevError.submat(0, 0, 2 * outSize - 1, batchSize - 1);
+  output2GateLayer->Gradient(std::move(*gradIterator), std::move(zrError),
+      std::move(output2GateLayer->Gradient()));
 
-  boost::apply_visitor(GradientVisitor(
-      *gradIterator % boost::apply_visitor(outputParameterVisitor,
-      forgetGateModule),
-      std::move(prevError.submat(2 * outSize, 0, 3 * outSize - 1,
-      batchSize - 1))), outputHidden2GateModule);
+  arma::mat modInput = *gradIterator % forgetGateLayer->OutputParameter();
+  arma::mat otError = prevError.submat(2 * outSize, 0, 3 * outSize - 1,
+      batchSize - 1);
+  outputHidden2GateLayer->Gradient(std::move(modInput), std::move(otError),
+      std::move(outputHidden2GateLayer->Gradient()));
 
   gradIterator--;
 }
@@ -407,6 +387,23 @@ void GRU<InputDataType, OutputDataType>::serialize(
   ar & BOOST_SERIALIZATION_NVP(inputGateModule);
   ar & BOOST_SERIALIZATION_NVP(forgetGateModule);
   ar & BOOST_SERIALIZATION_NVP(hiddenStateModule);
+
+  // Refresh the typed pointers used by the forward and backward passes.
+  if (Archive::is_loading::value)
+  {
+    input2GateLayer =
+        boost::get<Linear<arma::mat, arma::mat>*>(input2GateModule);
+    output2GateLayer =
+        boost::get<LinearNoBias<arma::mat, arma::mat>*>(output2GateModule);
+    outputHidden2GateLayer = boost::get<LinearNoBias<arma::mat, arma::mat>*>(
+        outputHidden2GateModule);
+    inputGateLayer = boost::get<BaseLayer<LogisticFunction, arma::mat,
+        arma::mat>*>(inputGateModule);
+    forgetGateLayer = boost::get<BaseLayer<LogisticFunction, arma::mat,
+        arma::mat>*>(forgetGateModule);
+    hiddenStateLayer = boost::get<BaseLayer<TanhFunction, arma::mat,
+        arma::mat>*>(hiddenStateModule);
+  }
 }
 
 } // namespace ann
@@ -58,20 +58,45 @@ template<typename eT>
 void LayerNorm<InputDataType, OutputDataType>::Forward(
     const arma::Mat<eT>&& input, arma::Mat<eT>&& output)
 {
-  mean = arma::mean(input, 0);
-  variance = arma::var(input, 1, 0);
-
-  // Normalize the input.
-  output = input.each_row() - mean;
-
-  output.each_row() /= arma::sqrt(variance + eps);
-
-  // Reused in the backward and gradient step.
-  normalized = output;
-
-  // Scale and shift the output.
-  output.each_col() %= gamma;
-  output.each_col() += beta;
+  mean.set_size(1, input.n_cols);
+  variance.set_size(1, input.n_cols);
+  normalized.set_size(input.n_rows, input.n_cols);
+  output.set_size(input.n_rows, input.n_cols);
+
+  const double* gammaMem = gamma.memptr();
+  const double* betaMem = beta.memptr();
+
+  // Two fused passes per column -- one to accumulate the moments, one that
+  // writes both the normalized input (reused by the backward and gradient
+  // steps) and the scaled and shifted output -- instead of one full-tensor
+  // pass per temporary.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    const eT* in = input.colptr(i);
+
+    double sum = 0.0, squaredSum = 0.0;
+    for (size_t r = 0; r < input.n_rows; ++r)
+    {
+      sum += in[r];
+      squaredSum += in[r] * in[r];
+    }
+
+    const double colMean = sum / input.n_rows;
+    const double colVariance =
+        std::max(0.0, squaredSum / input.n_rows - colMean * colMean);
+    mean[i] = colMean;
+    variance[i] = colVariance;
+
+    const double stdInv = 1.0 / std::sqrt(colVariance + eps);
+    eT* norm = normalized.colptr(i);
+    eT* out = output.colptr(i);
+    for (size_t r = 0; r < input.n_rows; ++r)
+    {
+      norm[r] = (in[r] - colMean) * stdInv;
+      out[r] = norm[r] * gammaMem[r] + betaMem[r];
+    }
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -127,6 +127,15 @@ template<
 >
 class AtrousConvolution;
 
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+class SeparableConvolution;
+
 template<
     typename InputDataType,
     typename OutputDataType
@@ -197,6 +206,10 @@ using LayerTypes = boost::variant<
     Sequential<arma::mat, arma::mat, true>*,
     Subview<arma::mat, arma::mat>*,
     VRClassReward<arma::mat, arma::mat>*,
+    SeparableConvolution<NaiveConvolution<ValidConvolution>,
+                         NaiveConvolution<FullConvolution>,
+                         NaiveConvolution<ValidConvolution>,
+                         arma::mat, arma::mat>*,
     CustomLayers*...
 >;
 
@@ -100,6 +100,12 @@ class Lookup
   //! Modify the gradient.
   OutputDataType& Gradient() { return gradient; }
 
+  //! Get the embedding columns touched by the last gradient computation.
+  //! Together with Gradient() this yields the sparse (column index, gradient
+  //! block) pairs; all other columns of the gradient are zero, so an update
+  //! rule only needs to visit `Gradient().cols(ActiveColumns())`.
+  arma::uvec const& ActiveColumns() const { return activeColumns; }
+
   /**
    * Serialize the layer
    */
@@ -122,6 +128,9 @@ class Lookup
   //! Locally-stored gradient object.
   OutputDataType gradient;
 
+  //! Columns of the embedding matrix touched by the last gradient pass.
+  arma::uvec activeColumns;
+
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 }; // class Lookup
@@ -54,8 +54,26 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
     arma::Mat<eT>&& error,
     arma::Mat<eT>&& gradient)
 {
-  gradient = arma::zeros<arma::Mat<eT> >(weights.n_rows, weights.n_cols);
-  gradient.cols(arma::conv_to<arma::uvec>::from(input) - 1) = error;
+  const arma::uvec tokens = arma::conv_to<arma::uvec>::from(input) - 1;
+
+  if (gradient.n_rows != weights.n_rows || gradient.n_cols != weights.n_cols)
+  {
+    gradient = arma::zeros<arma::Mat<eT> >(weights.n_rows, weights.n_cols);
+  }
+  else if (!activeColumns.is_empty())
+  {
+    // Only the columns touched by the previous batch can hold stale values,
+    // so zeroing those keeps the rest of the gradient at zero without
+    // rewriting the whole embedding matrix.
+    gradient.cols(activeColumns).zeros();
+  }
+
+  activeColumns = arma::unique(tokens);
+
+  // Scatter-accumulate the error; repeated tokens in a batch add up instead
+  // of overwriting one another.
+  for (size_t i = 0; i < tokens.n_elem; ++i)
+    gradient.col(tokens[i]) += error.col(i);
 }
 
 template<typename InputDataType, typename OutputDataType>
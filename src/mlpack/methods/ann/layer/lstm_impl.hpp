@@ -173,78 +173,87 @@ void LSTM<InputDataType, OutputDataType>::Forward(
     ResetCell(rhoSize);
   }
 
-  inputGate.cols(forwardStep, forwardStep + batchStep) = input2GateInputWeight *
-      input + output2GateInputWeight * outParameter.cols(forwardStep,
-      forwardStep + batchStep);
-  inputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateInputBias;
-
-  forgetGate.cols(forwardStep, forwardStep + batchStep) = input2GateForgetWeight
-      * input + output2GateForgetWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-  forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateForgetBias;
+  // Alias this timestep's slice of every rolling buffer as a plain matrix.
+  // The slices are contiguous in memory, so the GEMMs and elementwise updates
+  // below write directly into the preallocated storage instead of going
+  // through subview temporaries.  (The four gate projections cannot be fused
+  // into one GEMM here without changing the serialized weight layout; see
+  // FastLSTM for the fully fused variant.)
+  OutputDataType inputGateBlock(inputGate.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType forgetGateBlock(forgetGate.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType hiddenLayerBlock(hiddenLayer.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType outputGateBlock(outputGate.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType inputGateActivationBlock(inputGateActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType forgetGateActivationBlock(forgetGateActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType outputGateActivationBlock(outputGateActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType hiddenLayerActivationBlock(hiddenLayerActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType cellBlock(cell.memptr() + forwardStep * outSize,
+      outSize, batchSize, false, false);
+  OutputDataType cellActivationBlock(cellActivation.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType prevOutputBlock(outParameter.memptr() +
+      forwardStep * outSize, outSize, batchSize, false, false);
+  OutputDataType outputBlock(outParameter.memptr() +
+      (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
+
+  inputGateBlock = input2GateInputWeight * input;
+  inputGateBlock += output2GateInputWeight * prevOutputBlock;
+  inputGateBlock.each_col() += input2GateInputBias;
+
+  forgetGateBlock = input2GateForgetWeight * input;
+  forgetGateBlock += output2GateForgetWeight * prevOutputBlock;
+  forgetGateBlock.each_col() += input2GateForgetBias;
 
   if (forwardStep > 0)
   {
-    inputGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    OutputDataType prevCellBlock(cell.memptr() +
+        (forwardStep - batchSize) * outSize, outSize, batchSize, false, false);
 
-    forgetGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    inputGateBlock += prevCellBlock.each_col() % cell2GateInputWeight;
+    forgetGateBlock += prevCellBlock.each_col() % cell2GateForgetWeight;
   }
 
-  inputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-inputGate.cols(forwardStep, forwardStep + batchStep)));
-
-  forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
+  inputGateActivationBlock = 1.0 / (1 + arma::exp(-inputGateBlock));
+  forgetGateActivationBlock = 1.0 / (1 + arma::exp(-forgetGateBlock));
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
-      input + output2HiddenWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
+  hiddenLayerBlock = input2HiddenWeight * input;
+  hiddenLayerBlock += output2HiddenWeight * prevOutputBlock;
+  hiddenLayerBlock.each_col() += input2HiddenBias;
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2HiddenBias;
-
-  hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
+  hiddenLayerActivationBlock = arma::tanh(hiddenLayerBlock);
 
   if (forwardStep == 0)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
+    cellBlock = inputGateActivationBlock % hiddenLayerActivationBlock;
   }
   else
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        forgetGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep)
-        + inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
-  }
+    OutputDataType prevCellBlock(cell.memptr() +
+        (forwardStep - batchSize) * outSize, outSize, batchSize, false, false);
 
-  outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
-      * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
-      forwardStep + batchStep).each_col() % cell2GateOutputWeight;
+    cellBlock = forgetGateActivationBlock % prevCellBlock +
+        inputGateActivationBlock % hiddenLayerActivationBlock;
+  }
 
-  outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateOutputBias;
+  outputGateBlock = input2GateOutputWeight * input;
+  outputGateBlock += output2GateOutputWeight * prevOutputBlock;
+  outputGateBlock += cellBlock.each_col() % cell2GateOutputWeight;
+  outputGateBlock.each_col() += input2GateOutputBias;
 
-  outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
+  outputGateActivationBlock = 1.0 /
+      (1 + arma::exp(-outputGateBlock));
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
+  cellActivationBlock = arma::tanh(cellBlock);
 
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) =
-      cellActivation.cols(forwardStep, forwardStep + batchStep) %
-      outputGateActivation.cols(forwardStep, forwardStep + batchStep);
+  outputBlock = cellActivationBlock % outputGateActivationBlock;
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
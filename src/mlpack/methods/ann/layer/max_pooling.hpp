@@ -148,24 +148,35 @@ class MaxPooling
                         arma::Mat<eT>& output,
                         arma::Mat<eT>& poolingIndices)
   {
+    const size_t rowWindow = kW - offset;
+    const size_t colWindow = kH - offset;
+
+    // Scan each window directly through column pointers: no submatrix or
+    // index-map materialization, and the argmax's position in the input is
+    // computed from the window geometry as the scan goes.
     for (size_t j = 0, colidx = 0; j < output.n_cols; ++j, colidx += dW)
     {
       for (size_t i = 0, rowidx = 0; i < output.n_rows; ++i, rowidx += dH)
       {
-        arma::mat subInput = input(arma::span(rowidx, rowidx + kW - 1 - offset),
-            arma::span(colidx, colidx + kH - 1 - offset));
-
-        const size_t idx = pooling.Pooling(subInput);
-        output(i, j) = subInput(idx);
+        eT best = input(rowidx, colidx);
+        size_t bestIndex = colidx * input.n_rows + rowidx;
 
-        if (!deterministic)
+        for (size_t c = colidx; c < colidx + colWindow; ++c)
         {
-          arma::Mat<size_t> subIndices = indices(arma::span(rowidx,
-              rowidx + kW - 1 - offset),
-              arma::span(colidx, colidx + kH - 1 - offset));
-
-          poolingIndices(i, j) = subIndices(idx);
+          const eT* col = input.colptr(c) + rowidx;
+          for (size_t r = 0; r < rowWindow; ++r)
+          {
+            if (col[r] > best)
+            {
+              best = col[r];
+              bestIndex = c * input.n_rows + rowidx + r;
+            }
+          }
         }
+
+        output(i, j) = best;
+        if (!deterministic)
+          poolingIndices(i, j) = bestIndex;
       }
     }
   }
@@ -209,9 +220,6 @@ class MaxPooling
   //! Locally-stored number of output channels.
   size_t outSize;
 
-  //! Locally-stored reset parameter used to initialize the module once.
-  bool reset;
-
   //! Locally-stored input width.
   size_t inputWidth;
 
@@ -242,9 +250,6 @@ class MaxPooling
   //! Locally-stored transformed output parameter.
   arma::cube gTemp;
 
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
-
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -254,12 +259,6 @@ class MaxPooling
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored indices matrix parameter.
-  arma::Mat<size_t> indices;
-
-  //! Locally-stored indices column parameter.
-  arma::Col<size_t> indicesCol;
-
   //! Locally-stored pooling indicies.
   std::vector<arma::cube> poolingIndices;
 }; // class MaxPooling
@@ -39,7 +39,6 @@ MaxPooling<InputDataType, OutputDataType>::MaxPooling(
     floor(floor),
     inSize(0),
     outSize(0),
-    reset(false),
     inputWidth(0),
     inputHeight(0),
     outputWidth(0),
@@ -74,26 +73,18 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
     offset = 1;
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
+  // Every output element is written by the pooling operation, so the output
+  // does not need to be zeroed first.
+  outputTemp.set_size(outputWidth, outputHeight, batchSize * inSize);
 
   if (!deterministic)
   {
     poolingIndices.push_back(outputTemp);
   }
 
-  if (!reset)
-  {
-    size_t elements = inputWidth * inputHeight;
-    indicesCol = arma::linspace<arma::Col<size_t> >(0, (elements - 1),
-        elements);
-
-    indices = arma::Mat<size_t>(indicesCol.memptr(), inputWidth, inputHeight);
-
-    reset = true;
-  }
-
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
+  // The slices are independent, so pool them in parallel.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; s++)
   {
     if (!deterministic)
     {
@@ -126,7 +117,10 @@ void MaxPooling<InputDataType, OutputDataType>::Backward(
   gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  // Each slice scatters only into its own gradient slice, so the slices can
+  // be unpooled in parallel.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; s++)
   {
     Unpooling(mappedError.slice(s), gTemp.slice(s),
         poolingIndices.back().slice(s));
@@ -125,18 +125,25 @@ class MeanPooling
   template<typename eT>
   void Pooling(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   {
-    const size_t rStep = kW;
-    const size_t cStep = kH;
+    const size_t rowWindow = kW - offset;
+    const size_t colWindow = kH - offset;
+    const eT norm = 1.0 / (rowWindow * colWindow);
 
+    // Sum each window directly through column pointers instead of
+    // materializing a submatrix per window.
     for (size_t j = 0, colidx = 0; j < output.n_cols; ++j, colidx += dH)
     {
       for (size_t i = 0, rowidx = 0; i < output.n_rows; ++i, rowidx += dW)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + rStep - 1 - offset),
-            arma::span(colidx, colidx + cStep - 1 - offset));
-
-        output(i, j) = arma::mean(arma::mean(subInput));
+        eT sum = 0;
+        for (size_t c = colidx; c < colidx + colWindow; ++c)
+        {
+          const eT* col = input.colptr(c) + rowidx;
+          for (size_t r = 0; r < rowWindow; ++r)
+            sum += col[r];
+        }
+
+        output(i, j) = sum * norm;
       }
     }
   }
@@ -155,19 +162,20 @@ class MeanPooling
     const size_t rStep = input.n_rows / error.n_rows - offset;
     const size_t cStep = input.n_cols / error.n_cols - offset;
 
-    arma::Mat<eT> unpooledError;
+    // Spread each error element evenly over its window, adding the scaled
+    // value in place instead of building a filled temporary per window.
     for (size_t j = 0; j < input.n_cols - cStep; j += cStep)
     {
       for (size_t i = 0; i < input.n_rows - rStep; i += rStep)
       {
-        const arma::Mat<eT>& inputArea = input(arma::span(i, i + rStep - 1),
-            arma::span(j, j + cStep - 1));
-
-        unpooledError = arma::Mat<eT>(inputArea.n_rows, inputArea.n_cols);
-        unpooledError.fill(error(i / rStep, j / cStep) / inputArea.n_elem);
-
-        output(arma::span(i, i + rStep - 1 - offset),
-            arma::span(j, j + cStep - 1 - offset)) += unpooledError;
+        const eT value = error(i / rStep, j / cStep) / (rStep * cStep);
+
+        for (size_t c = j; c < j + cStep - offset; ++c)
+        {
+          eT* col = output.colptr(c) + i;
+          for (size_t r = 0; r < rStep - offset; ++r)
+            col[r] += value;
+        }
       }
     }
   }
@@ -76,10 +76,13 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
     offset = 1;
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
+  // Every output element is written by the pooling operation, so the output
+  // does not need to be zeroed first.
+  outputTemp.set_size(outputWidth, outputHeight, batchSize * inSize);
 
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
+  // The slices are independent, so pool them in parallel.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; s++)
     Pooling(inputTemp.slice(s), outputTemp.slice(s));
 
   output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
@@ -103,7 +106,10 @@ void MeanPooling<InputDataType, OutputDataType>::Backward(
   gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  // Each slice scatters only into its own gradient slice, so the slices can
+  // be unpooled in parallel.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; s++)
   {
     Unpooling(inputTemp.slice(s), mappedError.slice(s), gTemp.slice(s));
   }
@@ -0,0 +1,361 @@
+/**
+ * @file separable_convolution_impl.hpp
+ *
+ * Implementation of the SeparableConvolution module class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SEPARABLE_CONVOLUTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SEPARABLE_CONVOLUTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "separable_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::SeparableConvolution()
+{
+  // Nothing to do here.
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::SeparableConvolution(
+    const size_t inSize,
+    const size_t outSize,
+    const size_t kW,
+    const size_t kH,
+    const size_t dW,
+    const size_t dH,
+    const size_t padW,
+    const size_t padH,
+    const size_t inputWidth,
+    const size_t inputHeight) :
+    inSize(inSize),
+    outSize(outSize),
+    kW(kW),
+    kH(kH),
+    dW(dW),
+    dH(dH),
+    padW(padW),
+    padH(padH),
+    inputWidth(inputWidth),
+    inputHeight(inputHeight),
+    outputWidth(0),
+    outputHeight(0)
+{
+  weights.set_size((inSize * kW * kH) + (outSize * inSize) + outSize, 1);
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+void SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::Reset()
+{
+  depthwiseWeight = arma::cube(weights.memptr(), kW, kH, inSize,
+      false, false);
+  pointwiseWeight = arma::mat(weights.memptr() + depthwiseWeight.n_elem,
+      outSize, inSize, false, false);
+  bias = arma::mat(weights.memptr() + depthwiseWeight.n_elem +
+      pointwiseWeight.n_elem, outSize, 1, false, false);
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::Forward(const arma::Mat<eT>&& input, arma::Mat<eT>&& output)
+{
+  batchSize = input.n_cols;
+  inputTemp = arma::cube(const_cast<arma::Mat<eT>&&>(input).memptr(),
+      inputWidth, inputHeight, inSize * batchSize, false, false);
+
+  if (padW != 0 || padH != 0)
+  {
+    Pad(inputTemp, padW, padH, inputPaddedTemp);
+  }
+
+  const size_t wConv = ConvOutSize(inputWidth, kW, dW, padW);
+  const size_t hConv = ConvOutSize(inputHeight, kH, dH, padH);
+
+  // Depthwise stage: each input map is filtered with its own kernel; the
+  // result is kept as a workspace that the pointwise stage and the backward
+  // pass share.
+  depthwiseTemp.set_size(wConv, hConv, inSize * batchSize);
+
+  for (size_t inMap = 0; inMap < inSize * batchSize; inMap++)
+  {
+    arma::Mat<eT> convOutput;
+    if (padW != 0 || padH != 0)
+    {
+      ForwardConvolutionRule::Convolution(inputPaddedTemp.slice(inMap),
+          depthwiseWeight.slice(inMap % inSize), convOutput, dW, dH);
+    }
+    else
+    {
+      ForwardConvolutionRule::Convolution(inputTemp.slice(inMap),
+          depthwiseWeight.slice(inMap % inSize), convOutput, dW, dH);
+    }
+
+    depthwiseTemp.slice(inMap) = convOutput;
+  }
+
+  output.set_size(wConv * hConv * outSize, batchSize);
+
+  // Fused pointwise stage: the 1 x 1 convolution is a single GEMM per batch
+  // item, with every spatial position as a row and every depthwise map as a
+  // column of the workspace.
+  for (size_t batch = 0; batch < batchSize; batch++)
+  {
+    const arma::Mat<eT> depthwiseMaps(depthwiseTemp.memptr() +
+        batch * inSize * wConv * hConv, wConv * hConv, inSize, false, false);
+    arma::Mat<eT> outputMaps(output.memptr() +
+        batch * outSize * wConv * hConv, wConv * hConv, outSize, false, false);
+
+    outputMaps = depthwiseMaps * pointwiseWeight.t();
+    outputMaps.each_row() += bias.t();
+  }
+
+  outputWidth = wConv;
+  outputHeight = hConv;
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::Backward(
+    const arma::Mat<eT>&& /* input */, arma::Mat<eT>&& gy, arma::Mat<eT>&& g)
+{
+  const size_t outputArea = outputWidth * outputHeight;
+
+  // Pointwise backward pass: one GEMM per batch item recovers the error of
+  // the depthwise stage.
+  depthwiseDeltaTemp.set_size(outputWidth, outputHeight, inSize * batchSize);
+
+  for (size_t batch = 0; batch < batchSize; batch++)
+  {
+    const arma::Mat<eT> errorMaps(gy.memptr() + batch * outSize * outputArea,
+        outputArea, outSize, false, false);
+    arma::Mat<eT> deltaMaps(depthwiseDeltaTemp.memptr() +
+        batch * inSize * outputArea, outputArea, inSize, false, false);
+
+    deltaMaps = errorMaps * pointwiseWeight;
+  }
+
+  g.set_size(inputTemp.n_rows * inputTemp.n_cols * inSize, batchSize);
+  gTemp = arma::Cube<eT>(g.memptr(), inputTemp.n_rows,
+      inputTemp.n_cols, inputTemp.n_slices, false, false);
+
+  for (size_t inMap = 0; inMap < inSize * batchSize; inMap++)
+  {
+    arma::Mat<eT> output, rotatedFilter;
+    Rotate180(depthwiseWeight.slice(inMap % inSize), rotatedFilter);
+
+    BackwardConvolutionRule::Convolution(depthwiseDeltaTemp.slice(inMap),
+        rotatedFilter, output, dW, dH);
+
+    if (padW != 0 || padH != 0)
+    {
+      gTemp.slice(inMap) = output.submat(padW, padH,
+          padW + gTemp.n_rows - 1,
+          padH + gTemp.n_cols - 1);
+    }
+    else
+    {
+      gTemp.slice(inMap) = output;
+    }
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::Gradient(
+    const arma::Mat<eT>&& /* input */,
+    arma::Mat<eT>&& error,
+    arma::Mat<eT>&& gradient)
+{
+  arma::cube mappedError(error.memptr(), outputWidth,
+      outputHeight, outSize * batchSize, false, false);
+
+  gradient.set_size(weights.n_elem, 1);
+  gradient.zeros();
+
+  arma::Cube<eT> depthwiseGradient(gradient.memptr(), kW, kH, inSize,
+      false, false);
+  arma::Mat<eT> pointwiseGradient(gradient.memptr() + depthwiseWeight.n_elem,
+      outSize, inSize, false, false);
+
+  const size_t outputArea = outputWidth * outputHeight;
+
+  // The pointwise gradient and the error of the depthwise stage come out of
+  // the same pair of GEMMs over the depthwise workspace of the forward pass.
+  depthwiseDeltaTemp.set_size(outputWidth, outputHeight, inSize * batchSize);
+
+  for (size_t batch = 0; batch < batchSize; batch++)
+  {
+    const arma::Mat<eT> errorMaps(error.memptr() +
+        batch * outSize * outputArea, outputArea, outSize, false, false);
+    const arma::Mat<eT> depthwiseMaps(depthwiseTemp.memptr() +
+        batch * inSize * outputArea, outputArea, inSize, false, false);
+    arma::Mat<eT> deltaMaps(depthwiseDeltaTemp.memptr() +
+        batch * inSize * outputArea, outputArea, inSize, false, false);
+
+    pointwiseGradient += errorMaps.t() * depthwiseMaps;
+    deltaMaps = errorMaps * pointwiseWeight;
+  }
+
+  for (size_t inMap = 0; inMap < inSize * batchSize; inMap++)
+  {
+    arma::Mat<eT> inputSlice;
+    if (padW != 0 || padH != 0)
+    {
+      inputSlice = inputPaddedTemp.slice(inMap);
+    }
+    else
+    {
+      inputSlice = inputTemp.slice(inMap);
+    }
+
+    arma::Mat<eT> deltaSlice = depthwiseDeltaTemp.slice(inMap);
+
+    arma::Mat<eT> output;
+    GradientConvolutionRule::Convolution(inputSlice, deltaSlice,
+        output, dW, dH);
+
+    if (depthwiseGradient.n_rows < output.n_rows ||
+        depthwiseGradient.n_cols < output.n_cols)
+    {
+      depthwiseGradient.slice(inMap % inSize) += output.submat(0, 0,
+          depthwiseGradient.n_rows - 1, depthwiseGradient.n_cols - 1);
+    }
+    else if (depthwiseGradient.n_rows > output.n_rows ||
+        depthwiseGradient.n_cols > output.n_cols)
+    {
+      depthwiseGradient.slice(inMap % inSize).submat(0, 0, output.n_rows - 1,
+          output.n_cols - 1) += output;
+    }
+    else
+    {
+      depthwiseGradient.slice(inMap % inSize) += output;
+    }
+  }
+
+  for (size_t outMap = 0; outMap < outSize * batchSize; outMap++)
+  {
+    gradient.submat(depthwiseWeight.n_elem + pointwiseWeight.n_elem +
+        (outMap % outSize), 0, depthwiseWeight.n_elem +
+        pointwiseWeight.n_elem + (outMap % outSize), 0) +=
+        arma::accu(mappedError.slice(outMap));
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename Archive>
+void SeparableConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(inSize);
+  ar & BOOST_SERIALIZATION_NVP(outSize);
+  ar & BOOST_SERIALIZATION_NVP(batchSize);
+  ar & BOOST_SERIALIZATION_NVP(kW);
+  ar & BOOST_SERIALIZATION_NVP(kH);
+  ar & BOOST_SERIALIZATION_NVP(dW);
+  ar & BOOST_SERIALIZATION_NVP(dH);
+  ar & BOOST_SERIALIZATION_NVP(padW);
+  ar & BOOST_SERIALIZATION_NVP(padH);
+  ar & BOOST_SERIALIZATION_NVP(inputWidth);
+  ar & BOOST_SERIALIZATION_NVP(inputHeight);
+  ar & BOOST_SERIALIZATION_NVP(outputWidth);
+  ar & BOOST_SERIALIZATION_NVP(outputHeight);
+
+  if (Archive::is_loading::value)
+    weights.set_size((inSize * kW * kH) + (outSize * inSize) + outSize, 1);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -63,6 +63,22 @@ class CrossEntropyError
                 const TargetType&& target,
                 OutputType&& output);
 
+  /**
+   * Fused forward and backward pass: computes the loss and the error in one
+   * pass over the input and target, reduced over the batch columns in
+   * parallel, instead of re-reading both tensors in separate Forward() and
+   * Backward() calls.
+   *
+   * @param input The propagated input activation.
+   * @param target The target vector.
+   * @param output The calculated error.
+   * @return The cross-entropy error of the input.
+   */
+  template<typename InputType, typename TargetType, typename OutputType>
+  double ForwardBackward(const InputType&& input,
+                         const TargetType&& target,
+                         OutputType&& output);
+
   //! Get the output parameter.
   OutputDataType& OutputParameter() const { return outputParameter; }
   //! Modify the output parameter.
@@ -44,6 +44,37 @@ void CrossEntropyError<InputDataType, OutputDataType>::Backward(
   output = (1. - target) / (1. - input + eps) - target / (input + eps);
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+double CrossEntropyError<InputDataType, OutputDataType>::ForwardBackward(
+    const InputType&& input,
+    const TargetType&& target,
+    OutputType&& output)
+{
+  typedef typename InputType::elem_type ElemType;
+
+  output.set_size(arma::size(input));
+
+  const size_t rows = input.n_rows;
+
+  double loss = 0.0;
+  #pragma omp parallel for reduction(+:loss)
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    for (size_t j = 0; j < rows; ++j)
+    {
+      const double in = input(j, i);
+      const double t = target(j, i);
+
+      loss -= t * std::log(in + eps) + (1. - t) * std::log(1. - in + eps);
+      output(j, i) = (ElemType)
+          ((1. - t) / (1. - in + eps) - t / (in + eps));
+    }
+  }
+
+  return loss;
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void CrossEntropyError<InputDataType, OutputDataType>::serialize(
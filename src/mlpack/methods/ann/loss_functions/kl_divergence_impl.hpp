@@ -59,6 +59,40 @@ void KLDivergence<InputDataType, OutputDataType>::Backward(
   }
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+double KLDivergence<InputDataType, OutputDataType>::ForwardBackward(
+    const InputType&& input,
+    const TargetType&& target,
+    OutputType&& output)
+{
+  const size_t rows = input.n_rows;
+
+  double loss = 0.0;
+  double gradient = 0.0;
+  #pragma omp parallel for reduction(+:loss,gradient)
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    for (size_t j = 0; j < rows; ++j)
+    {
+      const double logRatio = std::log(input(j, i)) -
+          std::log(target(j, i));
+
+      loss += input(j, i) * logRatio;
+      gradient += logRatio + 1;
+    }
+  }
+
+  if (takeMean)
+  {
+    loss /= input.n_elem;
+    gradient /= input.n_elem;
+  }
+
+  output = gradient;
+  return loss;
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void KLDivergence<InputDataType, OutputDataType>::serialize(
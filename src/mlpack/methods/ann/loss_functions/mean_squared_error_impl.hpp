@@ -42,6 +42,35 @@ void MeanSquaredError<InputDataType, OutputDataType>::Backward(
   output = 2 * (input - target) / target.n_cols;
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+double MeanSquaredError<InputDataType, OutputDataType>::ForwardBackward(
+    const InputType&& input,
+    const TargetType&& target,
+    OutputType&& output)
+{
+  typedef typename InputType::elem_type ElemType;
+
+  output.set_size(arma::size(input));
+
+  const size_t rows = input.n_rows;
+  const double scale = 2.0 / target.n_cols;
+
+  double loss = 0.0;
+  #pragma omp parallel for reduction(+:loss)
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    for (size_t j = 0; j < rows; ++j)
+    {
+      const double diff = input(j, i) - target(j, i);
+      loss += diff * diff;
+      output(j, i) = (ElemType) (scale * diff);
+    }
+  }
+
+  return loss / target.n_cols;
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void MeanSquaredError<InputDataType, OutputDataType>::serialize(
@@ -0,0 +1,96 @@
+/**
+ * @file softmax_cross_entropy_error.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the fused softmax cross-entropy performance function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * The SoftmaxCrossEntropyError performance function measures the network's
+ * performance according to the multi-class cross-entropy between raw logits
+ * and class-index targets.  It fuses the LogSoftMax layer and the
+ * NegativeLogLikelihood loss into one head: the loss only evaluates the
+ * log-probability of each target class (using a numerically stable
+ * max-subtraction) and the backward pass directly produces the well-known
+ * softmax-minus-one-hot gradient, so the full log-probability matrix is
+ * never materialized.  Both passes run column-by-column over the batch and
+ * are parallelized with OpenMP.
+ *
+ * The targets use the same convention as NegativeLogLikelihood: target(i) is
+ * the 1-based class index of column i.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SoftmaxCrossEntropyError
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropyError object.
+   */
+  SoftmaxCrossEntropyError();
+
+  /**
+   * Computes the softmax cross-entropy of the given logits.
+   *
+   * @param input The raw logits (one column per point).
+   * @param target The target vector of 1-based class indices.
+   */
+  template<typename InputType, typename TargetType>
+  inline double Forward(const InputType&& input,
+                        const TargetType&& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The calculated error
+   * is softmax(input) minus the one-hot target encoding.
+   *
+   * @param input The raw logits (one column per point).
+   * @param target The target vector of 1-based class indices.
+   * @param output The calculated error.
+   */
+  template<typename InputType, typename TargetType, typename OutputType>
+  inline void Backward(const InputType&& input,
+                       const TargetType&& target,
+                       OutputType&& output);
+
+  //! Get the output parameter.
+  OutputDataType& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SoftmaxCrossEntropyError
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_error_impl.hpp"
+
+#endif
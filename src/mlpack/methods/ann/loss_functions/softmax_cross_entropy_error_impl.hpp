@@ -0,0 +1,90 @@
+/**
+ * @file softmax_cross_entropy_error_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the fused softmax cross-entropy performance function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy_error.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SoftmaxCrossEntropyError<InputDataType, OutputDataType>::
+SoftmaxCrossEntropyError()
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType>
+double SoftmaxCrossEntropyError<InputDataType, OutputDataType>::Forward(
+    const InputType&& input, const TargetType&& target)
+{
+  double output = 0;
+
+  // Each column only contributes the log-sum-exp of its logits and the logit
+  // of its target class, so the log-probability matrix is never formed.
+  #pragma omp parallel for reduction(+:output)
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    const double maxInput = input.col(i).max();
+    output += maxInput +
+        std::log(arma::accu(arma::exp(input.col(i) - maxInput))) -
+        input(currentTarget, i);
+  }
+
+  return output;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+void SoftmaxCrossEntropyError<InputDataType, OutputDataType>::Backward(
+    const InputType&& input,
+    const TargetType&& target,
+    OutputType&& output)
+{
+  output.set_size(input.n_rows, input.n_cols);
+
+  // The fused gradient is softmax(input) minus the one-hot target encoding,
+  // computed with the same stable max-subtraction as the forward pass.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget >= 0 && currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    const double maxInput = input.col(i).max();
+    output.col(i) = arma::exp(input.col(i) - maxInput);
+    output.col(i) /= arma::accu(output.col(i));
+    output(currentTarget, i) -= 1;
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SoftmaxCrossEntropyError<InputDataType, OutputDataType>::serialize(
+    Archive& /* ar */,
+    const unsigned int /* version */)
+{
+  // Nothing to do here.
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file quantized_ffn.hpp
+ *
+ * Definition of the QuantizedFFN class, an int8 post-training quantized
+ * inference pipeline for trained feed forward networks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Post-training int8 quantization of a trained feed forward network, for
+ * memory-bandwidth-bound serving.  The constructor walks the layers of an
+ * FFN, converts every Linear layer's weights to int8 with symmetric
+ * per-output-channel scales, and fuses any directly following activation
+ * layer into the same stage.  Forward passes quantize the activations,
+ * accumulate the int8 products in 32-bit integers and rescale the result to
+ * floating point, so only the (4x smaller) quantized weights are streamed
+ * from memory.
+ *
+ * If calibration data is given, each stage's activation scale is fixed from
+ * the observed activation ranges on that data, so serving skips the per-batch
+ * range reduction; otherwise the activations are quantized dynamically per
+ * forward pass.
+ *
+ * Only networks built from Linear layers and elementwise activations
+ * (identity, logistic, tanh, rectifier) plus LogSoftMax are supported; the
+ * constructor throws std::invalid_argument for anything else.
+ *
+ * @code
+ * FFN<NegativeLogLikelihood<> > model;
+ * ... build and train the model ...
+ *
+ * QuantizedFFN quantized(model, calibrationData);
+ * quantized.Predict(testData, predictions);
+ * @endcode
+ */
+class QuantizedFFN
+{
+ public:
+  /**
+   * Quantize the given trained network.
+   *
+   * @param network The trained network to quantize.
+   * @param calibrationData Sample inputs used to calibrate the activation
+   *     scales; if empty, activations are quantized dynamically per batch.
+   */
+  template<typename FFNType>
+  QuantizedFFN(FFNType& network,
+               const arma::mat& calibrationData = arma::mat());
+
+  /**
+   * Predict the responses to a given set of predictors, running every stage
+   * through the quantized kernels.
+   *
+   * @param predictors Input predictors, one point per column.
+   * @param results Matrix to put output predictions of responses into.
+   */
+  void Predict(const arma::mat& predictors, arma::mat& results) const;
+
+  //! Get the total size of the quantized weights, in bytes.
+  size_t WeightBytes() const;
+
+ private:
+  //! The activation functions that can be fused into a quantized stage.
+  enum ActivationType
+  {
+    IDENTITY,
+    LOGISTIC,
+    TANH,
+    RECTIFIER,
+    LOG_SOFTMAX
+  };
+
+  /**
+   * One stage of the quantized pipeline: an (optional) int8 linear transform
+   * followed by a fused activation.  The quantized weights are stored
+   * transposed (inSize x outSize) so each output channel's weights are a
+   * contiguous column for the accumulation kernel.
+   */
+  struct QuantizedLayer
+  {
+    //! Quantized weights, transposed; empty for a pure activation stage.
+    arma::Mat<arma::s8> weight;
+    //! Per-output-channel weight scales.
+    arma::vec scale;
+    //! Bias terms, kept in floating point.
+    arma::vec bias;
+    //! Calibrated activation scale of the stage input; 0 means the scale is
+    //! computed dynamically from each batch.
+    double inputScale;
+    //! Activation applied to the stage output.
+    ActivationType activation;
+  };
+
+  /**
+   * If the given layer is a supported activation layer, set activation
+   * accordingly and return true.
+   */
+  template<typename LayerTypeVariant>
+  static bool TryActivation(LayerTypeVariant& layer,
+                            ActivationType& activation);
+
+  /**
+   * Run one stage: quantize the input, accumulate the int8 products in int32
+   * and rescale into output, then apply the stage's activation.
+   */
+  void LayerForward(const QuantizedLayer& layer,
+                    const arma::mat& input,
+                    arma::mat& output) const;
+
+  //! Apply the given activation to one output column in place.
+  static void ApplyActivation(const ActivationType activation,
+                              double* values,
+                              const size_t length);
+
+  //! The quantized stages of the network, in forward order.
+  std::vector<QuantizedLayer> layers;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_ffn_impl.hpp"
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * @file quantized_ffn_impl.hpp
+ *
+ * Implementation of the QuantizedFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantized_ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename FFNType>
+QuantizedFFN::QuantizedFFN(FFNType& network, const arma::mat& calibrationData)
+{
+  auto& model = network.Model();
+  for (size_t i = 0; i < model.size(); ++i)
+  {
+    // A supported activation without a preceding linear layer becomes a pure
+    // activation stage.
+    ActivationType activation;
+    if (TryActivation(model[i], activation))
+    {
+      QuantizedLayer stage;
+      stage.inputScale = 0;
+      stage.activation = activation;
+      layers.push_back(std::move(stage));
+      continue;
+    }
+
+    Linear<arma::mat, arma::mat>* const* linear =
+        boost::get<Linear<arma::mat, arma::mat>*>(&model[i]);
+    if (!linear)
+    {
+      throw std::invalid_argument("QuantizedFFN(): unsupported layer type; "
+          "only Linear layers and elementwise activations can be quantized!");
+    }
+
+    const size_t inSize = (*linear)->InputSize();
+    const size_t outSize = (*linear)->OutputSize();
+    const arma::mat& parameters = (*linear)->Parameters();
+
+    // The Linear parameter blob holds the (outSize x inSize) weight matrix
+    // followed by the bias.
+    arma::mat weight = parameters.rows(0, outSize * inSize - 1);
+    weight.reshape(outSize, inSize);
+
+    QuantizedLayer stage;
+    stage.bias = parameters.rows(outSize * inSize, parameters.n_elem - 1);
+    stage.scale.set_size(outSize);
+    stage.weight.set_size(inSize, outSize);
+    stage.inputScale = 0;
+    stage.activation = IDENTITY;
+
+    // Symmetric per-output-channel quantization; the transposed storage makes
+    // each channel's weights a contiguous column.
+    for (size_t r = 0; r < outSize; ++r)
+    {
+      const double maxAbs = arma::abs(weight.row(r)).max();
+      stage.scale[r] = (maxAbs > 0) ? maxAbs / 127.0 : 1.0;
+      stage.weight.col(r) = arma::conv_to<arma::Col<arma::s8> >::from(
+          arma::round(weight.row(r).t() / stage.scale[r]));
+    }
+
+    // Fuse a directly following activation layer into this stage.
+    ActivationType fused;
+    if (i + 1 < model.size() && TryActivation(model[i + 1], fused))
+    {
+      stage.activation = fused;
+      ++i;
+    }
+
+    layers.push_back(std::move(stage));
+  }
+
+  // Fix the per-stage activation scales from the observed ranges on the
+  // calibration set, so serving skips the per-batch range reduction.
+  if (!calibrationData.is_empty())
+  {
+    arma::mat activations = calibrationData;
+    arma::mat next;
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+      const double maxAbs = arma::abs(activations).max();
+      layers[i].inputScale = (maxAbs > 0) ? maxAbs / 127.0 : 1.0;
+
+      LayerForward(layers[i], activations, next);
+      activations = std::move(next);
+    }
+  }
+}
+
+template<typename LayerTypeVariant>
+bool QuantizedFFN::TryActivation(LayerTypeVariant& layer,
+                                 ActivationType& activation)
+{
+  if (boost::get<BaseLayer<LogisticFunction, arma::mat, arma::mat>*>(&layer))
+  {
+    activation = LOGISTIC;
+    return true;
+  }
+  if (boost::get<BaseLayer<IdentityFunction, arma::mat, arma::mat>*>(&layer))
+  {
+    activation = IDENTITY;
+    return true;
+  }
+  if (boost::get<BaseLayer<TanhFunction, arma::mat, arma::mat>*>(&layer))
+  {
+    activation = TANH;
+    return true;
+  }
+  if (boost::get<BaseLayer<RectifierFunction, arma::mat, arma::mat>*>(&layer))
+  {
+    activation = RECTIFIER;
+    return true;
+  }
+  if (boost::get<LogSoftMax<arma::mat, arma::mat>*>(&layer))
+  {
+    activation = LOG_SOFTMAX;
+    return true;
+  }
+
+  return false;
+}
+
+inline void QuantizedFFN::Predict(const arma::mat& predictors,
+                                  arma::mat& results) const
+{
+  arma::mat activations = predictors;
+  arma::mat next;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    LayerForward(layers[i], activations, next);
+    activations = std::move(next);
+  }
+
+  results = std::move(activations);
+}
+
+inline size_t QuantizedFFN::WeightBytes() const
+{
+  size_t bytes = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+    bytes += layers[i].weight.n_elem * sizeof(arma::s8);
+
+  return bytes;
+}
+
+inline void QuantizedFFN::LayerForward(const QuantizedLayer& layer,
+                                       const arma::mat& input,
+                                       arma::mat& output) const
+{
+  if (layer.weight.is_empty())
+  {
+    output = input;
+    for (size_t c = 0; c < output.n_cols; ++c)
+      ApplyActivation(layer.activation, output.colptr(c), output.n_rows);
+    return;
+  }
+
+  const size_t inSize = layer.weight.n_rows;
+  const size_t outSize = layer.weight.n_cols;
+
+  if (input.n_rows != inSize)
+  {
+    throw std::invalid_argument("QuantizedFFN::LayerForward(): input "
+        "dimensionality does not match the quantized layer!");
+  }
+
+  // Quantize the activations, with the calibrated scale when available and
+  // the range of this batch otherwise.
+  double inputScale = layer.inputScale;
+  if (inputScale == 0)
+  {
+    const double maxAbs = arma::abs(input).max();
+    inputScale = (maxAbs > 0) ? maxAbs / 127.0 : 1.0;
+  }
+
+  const arma::Mat<arma::s8> quantizedInput =
+      arma::conv_to<arma::Mat<arma::s8> >::from(
+      arma::clamp(arma::round(input / inputScale), -127.0, 127.0));
+
+  output.set_size(outSize, input.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) input.n_cols; ++c)
+  {
+    const arma::s8* x = quantizedInput.colptr(c);
+    double* out = output.colptr(c);
+
+    for (size_t r = 0; r < outSize; ++r)
+    {
+      const arma::s8* w = layer.weight.colptr(r);
+
+      // The int8 products are accumulated in 32 bits; this inner loop is the
+      // only place the quantized weights are read.
+      int accumulator = 0;
+      for (size_t j = 0; j < inSize; ++j)
+        accumulator += (int) w[j] * (int) x[j];
+
+      out[r] = layer.scale[r] * inputScale * accumulator + layer.bias[r];
+    }
+
+    ApplyActivation(layer.activation, out, outSize);
+  }
+}
+
+inline void QuantizedFFN::ApplyActivation(const ActivationType activation,
+                                          double* values,
+                                          const size_t length)
+{
+  switch (activation)
+  {
+    case IDENTITY:
+      break;
+    case LOGISTIC:
+      for (size_t i = 0; i < length; ++i)
+        values[i] = 1.0 / (1.0 + std::exp(-values[i]));
+      break;
+    case TANH:
+      for (size_t i = 0; i < length; ++i)
+        values[i] = std::tanh(values[i]);
+      break;
+    case RECTIFIER:
+      for (size_t i = 0; i < length; ++i)
+        values[i] = std::max(values[i], 0.0);
+      break;
+    case LOG_SOFTMAX:
+    {
+      double maxValue = values[0];
+      for (size_t i = 1; i < length; ++i)
+        maxValue = std::max(maxValue, values[i]);
+
+      double sum = 0;
+      for (size_t i = 0; i < length; ++i)
+        sum += std::exp(values[i] - maxValue);
+
+      const double logSum = maxValue + std::log(sum);
+      for (size_t i = 0; i < length; ++i)
+        values[i] -= logSum;
+      break;
+    }
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -437,6 +437,10 @@ class RBM
   arma::Mat<ElemType> positiveGradient;
   //! Locally-stored temporary output of Gibbs chain.
   arma::Mat<ElemType> gibbsTemporary;
+  //! Locally-stored uniform draws used for vectorized Bernoulli sampling.
+  arma::Mat<ElemType> uniformDraws;
+  //! Locally-stored block of negative-chain samples for the negative phase.
+  arma::Mat<ElemType> chainBlock;
   //! Locally-stored persistent CD-k boolean flag.
   bool persistence;
   //! Locally-stored reset variable.
@@ -169,10 +169,10 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleHidden(
 {
   HiddenMean(std::move(input), std::move(output));
 
-  for (size_t i = 0; i < output.n_elem; i++)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  // Draw the Bernoulli samples for the whole batch in one vectorized pass
+  // instead of one RNG call per element.
+  uniformDraws.randu(output.n_rows, output.n_cols);
+  output = arma::conv_to<arma::Mat<ElemType>>::from(uniformDraws < output);
 }
 
 template<
@@ -188,10 +188,8 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleVisible(
 {
   VisibleMean(std::move(input), std::move(output));
 
-  for (size_t i = 0; i < output.n_elem; i++)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  uniformDraws.randu(output.n_rows, output.n_cols);
+  output = arma::conv_to<arma::Mat<ElemType>>::from(uniformDraws < output);
 }
 
 template<
@@ -275,13 +273,26 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   Phase(std::move(predictors.cols(i, i + batchSize - 1)),
       std::move(positiveGradient));
 
-  for (size_t i = 0; i < negSteps; i++)
+  if (negSteps == 1)
   {
     Gibbs(std::move(predictors.cols(i, i + batchSize - 1)),
         std::move(negativeSamples));
-    Phase(std::move(negativeSamples), std::move(tempNegativeGradient));
-
-    negativeGradient += tempNegativeGradient;
+    Phase(std::move(negativeSamples), std::move(negativeGradient));
+  }
+  else
+  {
+    // Collect the fantasy particles of all negative chains into one block,
+    // so that the negative phase is a single pair of GEMMs instead of one
+    // outer product per chain.
+    chainBlock.set_size(visibleSize, negSteps * batchSize);
+    for (size_t j = 0; j < negSteps; j++)
+    {
+      Gibbs(std::move(predictors.cols(i, i + batchSize - 1)),
+          std::move(negativeSamples));
+      chainBlock.cols(j * batchSize, (j + 1) * batchSize - 1) =
+          negativeSamples;
+    }
+    Phase(std::move(chainBlock), std::move(negativeGradient));
   }
 
   gradient = ((negativeGradient / negSteps) - positiveGradient);
@@ -0,0 +1,198 @@
+/**
+ * @file static_ffn.hpp
+ *
+ * Definition of the StaticFFN class, a sequential network whose layer types
+ * are fixed at compile time so that the forward pass is fully inlined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer_traits.hpp"
+#include "visitor/reset_visitor.hpp"
+#include "visitor/deterministic_set_visitor.hpp"
+
+#include <array>
+#include <tuple>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of a feed forward network for inference only, with the layer
+ * sequence encoded in the type.  Unlike FFN, which dispatches every layer
+ * call through boost::variant visitors, StaticFFN stores the layers in a
+ * std::tuple and unrolls the forward pass with templates, so the whole
+ * pipeline can be inlined into a single function.  This makes it suitable for
+ * latency-critical serving of small networks, where the per-layer dispatch
+ * overhead of the dynamic network is measurable.
+ *
+ * The class holds no training machinery; weights are loaded from a trained
+ * FFN (or any flat parameter vector laid out the same way):
+ *
+ * @code
+ * FFN<NegativeLogLikelihood<> > model;
+ * model.Add<Linear<> >(10, 50);
+ * model.Add<SigmoidLayer<> >();
+ * model.Add<Linear<> >(50, 3);
+ * model.Add<LogSoftMax<> >();
+ * model.Train(trainData, trainLabels, opt);
+ *
+ * StaticFFN<Linear<>, SigmoidLayer<>, Linear<>, LogSoftMax<> > network(
+ *     Linear<>(10, 50), SigmoidLayer<>(), Linear<>(50, 3), LogSoftMax<>());
+ * network.Parameters(model.Parameters());
+ * network.Predict(testData, predictions);
+ * @endcode
+ *
+ * The layer objects passed to the constructor must have the same types and
+ * shapes, in the same order, as the layers of the network the weights came
+ * from.
+ *
+ * The matrix type is deduced from the layers, so a single-precision network
+ * only needs layers instantiated on arma::fmat; halving the memory traffic
+ * this way roughly doubles throughput on bandwidth-bound models:
+ *
+ * @code
+ * StaticFFN<Linear<arma::fmat, arma::fmat>,
+ *           SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>,
+ *           Linear<arma::fmat, arma::fmat> > floatNetwork(
+ *     Linear<arma::fmat, arma::fmat>(10, 50),
+ *     SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>(),
+ *     Linear<arma::fmat, arma::fmat>(50, 3));
+ * floatNetwork.Parameters(
+ *     arma::conv_to<arma::fmat>::from(model.Parameters()));
+ * @endcode
+ *
+ * @tparam LayerTypes The concrete layer types of the network, in order.
+ */
+template<typename... LayerTypes>
+class StaticFFN
+{
+ public:
+  //! Convenience typedef for the first layer of the network.
+  typedef typename std::tuple_element<0, std::tuple<LayerTypes...> >::type
+      FirstLayerType;
+
+  //! The matrix type every layer of the network operates on, deduced from the
+  //! first layer's output (e.g. arma::fmat for a single-precision network).
+  typedef typename std::remove_reference<decltype(
+      std::declval<FirstLayerType>().OutputParameter())>::type MatType;
+
+  /**
+   * Create the StaticFFN object with the given layers.  The layers are moved
+   * into the network; their weights are unset until Parameters() is called.
+   *
+   * @param layers The layers of the network, in forward order.
+   */
+  StaticFFN(LayerTypes... layers);
+
+  /**
+   * Set the weights of every layer from the given flat parameter vector,
+   * which must use the same layout as FFN::Parameters() for the same layer
+   * sequence.  All layers are also switched to deterministic (inference)
+   * mode.
+   *
+   * @param parameters The trained parameter vector to load.
+   */
+  void Parameters(const MatType& parameters);
+
+  //! Return the loaded parameters of the network.
+  const MatType& Parameters() const { return parameter; }
+
+  /**
+   * Perform the forward pass of the network on the given input, writing the
+   * output of the final layer to results.  The input may hold one point per
+   * column, in which case the whole batch is pushed through in one pass.
+   *
+   * @param inputs The input data.
+   * @param results The output activations of the final layer.
+   */
+  void Forward(const MatType& inputs, MatType& results);
+
+  /**
+   * Predict the responses to a given set of predictors.  The responses
+   * represent the output of the final layer; this is an alias for Forward()
+   * and is provided for symmetry with FFN::Predict().
+   *
+   * @param predictors Input predictors, one point per column.
+   * @param results Matrix to put output predictions of responses into.
+   */
+  void Predict(const MatType& predictors, MatType& results);
+
+  //! Get the I'th layer of the network.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<LayerTypes...> >::type& Layer()
+  {
+    return std::get<I>(network);
+  }
+
+ private:
+  /**
+   * Load the weights of layer I and every layer after it from the parameter
+   * matrix, starting at the given element offset; returns the total number of
+   * elements consumed.  The recursion is unrolled at compile time.
+   */
+  template<size_t I>
+  typename std::enable_if<I < sizeof...(LayerTypes), size_t>::type
+  SetWeights(const size_t offset);
+
+  template<size_t I>
+  typename std::enable_if<I == sizeof...(LayerTypes), size_t>::type
+  SetWeights(const size_t /* offset */) { return 0; }
+
+  /**
+   * Run the forward pass from layer I onwards, reading from the given input
+   * and writing each layer's activation into outputs[I].
+   */
+  template<size_t I>
+  typename std::enable_if<I < sizeof...(LayerTypes), void>::type
+  ForwardFrom(const MatType& input);
+
+  template<size_t I>
+  typename std::enable_if<I == sizeof...(LayerTypes), void>::type
+  ForwardFrom(const MatType& /* input */) { }
+
+  /**
+   * Point the given layer's parameters at the network parameter matrix,
+   * starting at the given element offset, and return the number of elements
+   * used.  These overloads mirror WeightSetVisitor, but work for any matrix
+   * element type; layers without parameters use none of the matrix.
+   */
+  template<typename LayerType>
+  typename std::enable_if<
+      HasParametersCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  SetLayerWeights(LayerType& layer, const size_t offset);
+
+  template<typename LayerType>
+  typename std::enable_if<
+      !HasParametersCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  SetLayerWeights(LayerType& /* layer */, const size_t /* offset */)
+  {
+    return 0;
+  }
+
+  //! The layers of the network, in forward order.
+  std::tuple<LayerTypes...> network;
+
+  //! Matrix of (trained) parameters.
+  MatType parameter;
+
+  //! The output activation of each layer.
+  std::array<MatType, sizeof...(LayerTypes)> outputs;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "static_ffn_impl.hpp"
+
+#endif
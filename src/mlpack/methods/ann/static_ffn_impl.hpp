@@ -0,0 +1,99 @@
+/**
+ * @file static_ffn_impl.hpp
+ *
+ * Implementation of the StaticFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "static_ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename... LayerTypes>
+StaticFFN<LayerTypes...>::StaticFFN(LayerTypes... layers) :
+    network(std::move(layers)...)
+{
+  static_assert(sizeof...(LayerTypes) > 0,
+      "StaticFFN requires at least one layer.");
+}
+
+template<typename... LayerTypes>
+void StaticFFN<LayerTypes...>::Parameters(const MatType& parameters)
+{
+  parameter = parameters;
+
+  const size_t used = SetWeights<0>(0);
+  if (used != parameter.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "StaticFFN::Parameters(): layer sequence uses " << used
+        << " parameters, but " << parameter.n_elem << " were given!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename... LayerTypes>
+void StaticFFN<LayerTypes...>::Forward(const MatType& inputs,
+                                       MatType& results)
+{
+  ForwardFrom<0>(inputs);
+  results = outputs[sizeof...(LayerTypes) - 1];
+}
+
+template<typename... LayerTypes>
+void StaticFFN<LayerTypes...>::Predict(const MatType& predictors,
+                                       MatType& results)
+{
+  Forward(predictors, results);
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<I < sizeof...(LayerTypes), size_t>::type
+StaticFFN<LayerTypes...>::SetWeights(const size_t offset)
+{
+  // The visitors are ordinary function objects, so they can be applied to a
+  // concrete layer pointer directly; no boost::variant is involved.
+  const size_t used = SetLayerWeights(std::get<I>(network), offset);
+  ResetVisitor()(&std::get<I>(network));
+  DeterministicSetVisitor(true)(&std::get<I>(network));
+
+  return used + SetWeights<I + 1>(offset + used);
+}
+
+template<typename... LayerTypes>
+template<typename LayerType>
+typename std::enable_if<
+    HasParametersCheck<LayerType,
+        typename StaticFFN<LayerTypes...>::MatType&(LayerType::*)()>::value,
+    size_t>::type
+StaticFFN<LayerTypes...>::SetLayerWeights(LayerType& layer,
+                                          const size_t offset)
+{
+  layer.Parameters() = MatType(parameter.memptr() + offset,
+      layer.Parameters().n_rows, layer.Parameters().n_cols, false, false);
+
+  return layer.Parameters().n_elem;
+}
+
+template<typename... LayerTypes>
+template<size_t I>
+typename std::enable_if<I < sizeof...(LayerTypes), void>::type
+StaticFFN<LayerTypes...>::ForwardFrom(const MatType& input)
+{
+  std::get<I>(network).Forward(std::move(input), std::move(outputs[I]));
+  ForwardFrom<I + 1>(outputs[I]);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -15,11 +15,9 @@
 // In case it hasn't been included yet.
 #include "drusilla_select.hpp"
 
-#include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
+#include <functional>
+#include <queue>
 
 namespace mlpack {
 namespace neighbor {
@@ -179,23 +177,65 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Squared norms of the candidate points, computed once for all queries.
+  arma::vec candidateNorms(candidateSet.n_cols);
+  for (size_t i = 0; i < candidateSet.n_cols; ++i)
+    candidateNorms[i] = arma::dot(candidateSet.col(i), candidateSet.col(i));
+
+  // Process the query set tile by tile: one matrix product evaluates every
+  // query in a tile against the whole candidate set at once, so the candidate
+  // set (all l tables) stays hot in cache across the tile.  The tiles are
+  // independent, so they are distributed across threads.
+  const size_t tileSize = 256;
+  const size_t numTiles = (querySet.n_cols + tileSize - 1) / tileSize;
+
+  // A candidate is a (squared distance, candidate set index) pair.
+  typedef std::pair<double, size_t> Candidate;
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t tile = 0; tile < (omp_size_t) numTiles; ++tile)
+  {
+    const size_t begin = tile * tileSize;
+    const size_t end = std::min(querySet.n_cols, begin + tileSize);
+
+    const MatType products = arma::trans(candidateSet) *
+        querySet.cols(begin, end - 1);
+
+    for (size_t q = begin; q < end; ++q)
+    {
+      const double queryNorm = arma::dot(querySet.col(q), querySet.col(q));
 
-  rules.GetResults(neighbors, distances);
+      // Bounded min-heap of size k holding the furthest candidates seen so
+      // far; the closest of them sits on top and is evicted first.
+      std::vector<Candidate> clist(k, std::make_pair(-1.0, size_t(-1)));
+      std::priority_queue<Candidate, std::vector<Candidate>,
+          std::greater<Candidate>> pq(std::greater<Candidate>(),
+          std::move(clist));
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+      {
+        const double squaredDist = std::max(0.0, queryNorm +
+            candidateNorms[r] - 2.0 * products(r, q - begin));
+        if (squaredDist > pq.top().first)
+        {
+          pq.pop();
+          pq.push(std::make_pair(squaredDist, r));
+        }
+      }
+
+      // Extract the results, furthest neighbor first, mapping the candidates
+      // back to their original indices in the reference set.
+      for (size_t j = 1; j <= k; ++j)
+      {
+        neighbors(k - j, q) = candidateIndices[pq.top().second];
+        distances(k - j, q) = std::sqrt(pq.top().first);
+        pq.pop();
+      }
+    }
+  }
 }
 
 //! Serialize the model.
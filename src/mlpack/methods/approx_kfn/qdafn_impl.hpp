@@ -104,8 +104,14 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  // Project every query point onto every table's line with one matrix
+  // product, instead of l separate dot products per query.
+  const MatType queryProjections = lines.t() * querySet;
+
+  // Search for each point.  The queries are independent, so they are
+  // distributed across threads.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
@@ -113,8 +119,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
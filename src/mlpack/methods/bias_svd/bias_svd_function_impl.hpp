@@ -267,10 +267,6 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
   const arma::mat data = function.Dataset();
   const size_t numUsers = function.NumUsers();
   const double lambda = function.Lambda();
@@ -278,6 +274,25 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // Bucket the ratings by user once (a counting sort), so that each thread
+  // can be handed whole users: updates to a user's vector and bias then never
+  // collide between threads, and with many items the remaining item-column
+  // collisions are rare enough that the updates can be applied Hogwild-style,
+  // without synchronization.
+  arma::Col<size_t> userOffsets(numUsers + 1, arma::fill::zeros);
+  for (size_t j = 0; j < data.n_cols; ++j)
+    userOffsets[(size_t) data(0, j) + 1]++;
+  for (size_t u = 0; u < numUsers; ++u)
+    userOffsets[u + 1] += userOffsets[u];
+  arma::Col<size_t> ratingsByUser(data.n_cols);
+  arma::Col<size_t> fillPositions(userOffsets.subvec(0, numUsers - 1));
+  for (size_t j = 0; j < data.n_cols; ++j)
+    ratingsByUser[fillPositions[(size_t) data(0, j)]++] = j;
+
+  // The order in which the users will be visited.
+  arma::Col<size_t> userOrder = arma::linspace<arma::Col<size_t>>(0,
+      numUsers - 1, numUsers);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -316,58 +331,40 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     double stepSize = decayPolicy.StepSize(i);
 
     if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+      std::shuffle(userOrder.begin(), userOrder.end(), mlpack::math::randGen);
 
-    #pragma omp parallel
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t u = 0; u < (omp_size_t) numUsers; ++u)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      const size_t user = userOrder[u];
+
+      for (size_t j = userOffsets[user]; j < userOffsets[user + 1]; ++j)
       {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
+        const size_t ratingIndex = ratingsByUser[j];
+        const size_t item = data(1, ratingIndex) + numUsers;
 
         // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
+        const double rating = data(2, ratingIndex);
         const double userBias = iterate(rank, user);
         const double itemBias = iterate(rank, item);
-        double ratingError = rating - userBias - itemBias -
-            arma::dot(iterate.col(user).subvec(0, rank - 1),
-                      iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * iterate.col(user).subvec(0, rank - 1));
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
+
+        const arma::vec userVec = iterate.col(user).subvec(0, rank - 1);
+        const arma::vec itemVec = iterate.col(item).subvec(0, rank - 1);
+
+        const double ratingError = rating - userBias - itemBias -
+            arma::dot(userVec, itemVec);
+
+        // The updates are plain vector operations: this thread owns the
+        // user's columns, and concurrent updates of an item column by two
+        // threads are accepted Hogwild-style.
+        iterate.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+            lambda * userVec - ratingError * itemVec);
+        iterate.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+            lambda * itemVec - ratingError * userVec);
+        iterate(rank, user) -= stepSize * 2 * (
+            lambda * userBias - ratingError);
+        iterate(rank, item) -= stepSize * 2 * (
+            lambda * itemBias - ratingError);
       }
     }
   }
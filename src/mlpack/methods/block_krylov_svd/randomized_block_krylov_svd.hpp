@@ -90,7 +90,9 @@ class RandomizedBlockKrylovSVD
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
-   * randomized block krylov SVD.
+   * randomized block krylov SVD.  The data matrix may be dense (arma::mat) or
+   * sparse (arma::sp_mat); a sparse matrix is used as-is, without
+   * densification.
    *
    * @param data Data matrix.
    * @param u First unitary matrix.
@@ -98,7 +100,8 @@ class RandomizedBlockKrylovSVD
    * @param s Diagonal matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::mat& data,
+  template<typename MatType>
+  void Apply(const MatType& data,
              arma::mat& u,
              arma::vec& s,
              arma::mat& v,
@@ -115,6 +118,37 @@ class RandomizedBlockKrylovSVD
   size_t& BlockSize() { return blockSize; }
 
  private:
+  /**
+   * Compute one step of the block power iteration, out = data * (data^T *
+   * block).  For a dense matrix this is a pair of GEMMs, which a multithreaded
+   * BLAS parallelizes; for a sparse matrix, where Armadillo's sparse-dense
+   * products are single-threaded, the (independent) columns of the block are
+   * computed in parallel with OpenMP.
+   *
+   * @param data Data matrix.
+   * @param out Matrix to store the result in.
+   * @param block Current orthonormal block.
+   */
+  static void KrylovStep(const arma::mat& data,
+                         arma::mat& out,
+                         const arma::mat& block);
+  static void KrylovStep(const arma::sp_mat& data,
+                         arma::mat& out,
+                         const arma::mat& block);
+
+  /**
+   * Orthonormalize the columns of the given tall-skinny matrix using Cholesky
+   * QR with one refresh pass (CholQR2).  The Gram product and the triangular
+   * inversion are cheap level-3 operations for tall-skinny blocks; if the Gram
+   * matrix is not numerically positive definite, this falls back to
+   * Householder QR.
+   *
+   * @param Q Matrix to store the orthonormal basis in.
+   * @param R Matrix to store the upper triangular factor in.
+   * @param M Matrix to orthonormalize.
+   */
+  static void BlockQR(arma::mat& Q, arma::mat& R, const arma::mat& M);
+
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
@@ -125,4 +159,7 @@ class RandomizedBlockKrylovSVD
 } // namespace svd
 } // namespace mlpack
 
+// Include implementation of the template Apply().
+#include "randomized_block_krylov_svd_impl.hpp"
+
 #endif
@@ -0,0 +1,134 @@
+/**
+ * @file randomized_block_krylov_svd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the randomized block krylov SVD method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+#define MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+
+#include "randomized_block_krylov_svd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+inline void RandomizedBlockKrylovSVD::KrylovStep(const arma::mat& data,
+                                                 arma::mat& out,
+                                                 const arma::mat& block)
+{
+  // A pair of GEMMs; a multithreaded BLAS parallelizes these, and the
+  // transpose is handled inside the BLAS call without forming a copy.
+  out = data * (data.t() * block);
+}
+
+inline void RandomizedBlockKrylovSVD::KrylovStep(const arma::sp_mat& data,
+                                                 arma::mat& out,
+                                                 const arma::mat& block)
+{
+  // Form the transpose once; evaluating data.t() inside the column loop would
+  // rebuild it for every column.
+  const arma::sp_mat dataT = data.t();
+
+  // Armadillo's sparse-dense products are single-threaded, so compute the
+  // (independent) columns of the block in parallel.
+  out.set_size(data.n_rows, block.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) block.n_cols; ++j)
+    out.col(j) = data * (dataT * block.col(j));
+}
+
+inline void RandomizedBlockKrylovSVD::BlockQR(arma::mat& Q,
+                                              arma::mat& R,
+                                              const arma::mat& M)
+{
+  // Cholesky QR: R^T R = M^T M and Q = M * R^-1.  This squares the condition
+  // number of the block, so one refresh pass is applied (CholQR2); if either
+  // Gram matrix is not numerically positive definite, fall back to Householder
+  // QR.
+  arma::mat R1;
+  if (!arma::chol(R1, M.t() * M))
+  {
+    arma::qr_econ(Q, R, M);
+    return;
+  }
+
+  // The triangular factor is only blockSize x blockSize, so inverting it is
+  // cheap compared to the Gram product.
+  Q = M * arma::inv(arma::trimatu(R1));
+
+  // Refresh pass on the computed basis.
+  arma::mat R2;
+  if (!arma::chol(R2, Q.t() * Q))
+  {
+    arma::qr_econ(Q, R, M);
+    return;
+  }
+
+  Q = Q * arma::inv(arma::trimatu(R2));
+  R = R2 * R1;
+}
+
+template<typename MatType>
+void RandomizedBlockKrylovSVD::Apply(const MatType& data,
+                                     arma::mat& u,
+                                     arma::vec& s,
+                                     arma::mat& v,
+                                     const size_t rank)
+{
+  arma::mat Q, R, block, blockIteration, product;
+
+  if (blockSize == 0)
+  {
+    blockSize = rank + 10;
+  }
+
+  // Random block initialization.
+  arma::mat G = arma::randn(data.n_cols, blockSize);
+
+  // Construct and orthonormalize Krylov subspace.
+  arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
+
+  // Create a working matrix using data from writable auxiliary memory
+  // (K matrix). Doing so avoids an uncessary copy in upcoming step.
+  block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
+  BlockQR(block, R, data * G);
+
+  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+      blockOffset += block.n_elem)
+  {
+    // Temporary working matrix to store the result in the correct place.
+    blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
+        block.n_cols, false, false);
+
+    KrylovStep(data, product, block);
+    BlockQR(blockIteration, R, product);
+
+    // Update working matrix for the next iteration.
+    block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
+        false, false);
+  }
+
+  // Orthonormalize the full Krylov basis with Householder QR; the blocks are
+  // orthonormal individually but not against each other, so the Cholesky
+  // shortcut is not reliable here.
+  arma::qr_econ(Q, R, K);
+
+  // Approximate eigenvalues and eigenvectors using Rayleigh–Ritz method.
+  arma::svd_econ(u, s, v, Q.t() * data);
+
+  // Do economical singular value decomposition and compute only the
+  // approximations of the left singular vectors by using the centered data
+  // applied to Q.
+  u = Q * u;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -216,6 +216,59 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Build the persistent recommendation index: compute and store the
+   * neighborhood of every user in latent factor space.  This pays the
+   * neighbor search structure construction exactly once per factor refresh;
+   * afterwards, GetRecommendationsFromIndex() serves recommendations for
+   * single users without performing any neighbor search.
+   *
+   * The index is invalidated by Train() and is not serialized (it is derived
+   * data), so it must be rebuilt after retraining or after loading a model.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void BuildRecommendationIndex();
+
+  //! Get whether the recommendation index is currently built.
+  bool IndexBuilt() const { return indexBuilt; }
+
+  /**
+   * Generates the given number of recommendations for the specified users
+   * using the prebuilt recommendation index.  BuildRecommendationIndex() must
+   * have been called since the last Train().
+   *
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   */
+  template<typename InterpolationPolicy = AverageInterpolation>
+  void GetRecommendationsFromIndex(const size_t numRecs,
+                                   arma::Mat<size_t>& recommendations,
+                                   const arma::Col<size_t>& users);
+
+  /**
+   * Generates the given number of recommendations for a single user using the
+   * prebuilt recommendation index.  BuildRecommendationIndex() must have been
+   * called since the last Train().
+   *
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param user User for which recommendations are to be generated.
+   * @param recommendations Vector to save recommendations into.
+   */
+  template<typename InterpolationPolicy = AverageInterpolation>
+  void GetRecommendationsFromIndex(const size_t numRecs,
+                                   const size_t user,
+                                   arma::Col<size_t>& recommendations);
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -274,6 +327,35 @@ class CFType
   //! Data normalization object.
   NormalizationType normalization;
 
+  //! Cached neighborhood of every user (numUsersForSimilarity x numUsers),
+  //! filled by BuildRecommendationIndex().
+  arma::Mat<size_t> indexedNeighborhood;
+  //! Cached similarities corresponding to indexedNeighborhood.
+  arma::mat indexedSimilarities;
+  //! Whether the recommendation index is currently valid.
+  bool indexBuilt;
+
+  /**
+   * Generate recommendations for the given users from their already computed
+   * neighborhoods.
+   *
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   * @param neighborhood Neighborhood of each queried user (one column per
+   *     user).
+   * @param similarities Similarities corresponding to the neighborhood.
+   */
+  template<typename InterpolationPolicy>
+  void GenerateRecommendations(const size_t numRecs,
+                               arma::Mat<size_t>& recommendations,
+                               const arma::Col<size_t>& users,
+                               const arma::Mat<size_t>& neighborhood,
+                               const arma::mat& similarities);
+
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
 
@@ -19,6 +19,8 @@
 // In case it hasn't been included yet.
 #include "cf.hpp"
 
+#include <mlpack/core/math/sparse_builder.hpp>
+
 namespace mlpack {
 namespace cf {
 
@@ -30,7 +32,8 @@ CFType<DecompositionPolicy,
 CFType(const size_t numUsersForSimilarity,
        const size_t rank) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    indexBuilt(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -58,7 +61,8 @@ CFType(const MatType& data,
        const double minResidue,
        const bool mit) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    indexBuilt(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -85,6 +89,10 @@ Train(const arma::mat& data,
 {
   this->decomposition = decomposition;
 
+  // The factors are about to change, so any prebuilt recommendation index is
+  // stale.
+  indexBuilt = false;
+
   // Make a copy of data before performing normalization.
   arma::mat normalizedData(data);
   normalization.Normalize(normalizedData);
@@ -126,6 +134,10 @@ Train(const arma::sp_mat& data,
 {
   this->decomposition = decomposition;
 
+  // The factors are about to change, so any prebuilt recommendation index is
+  // stale.
+  indexBuilt = false;
+
   // data is not used in the following decomposition.Apply() method, so we only
   // need to Normalize cleanedData.
   cleanedData = data;
@@ -198,6 +210,86 @@ GetRecommendations(const size_t numRecs,
   decomposition.template GetNeighborhood<NeighborSearchPolicy>(
       users, numUsersForSimilarity, neighborhood, similarities);
 
+  GenerateRecommendations<InterpolationPolicy>(numRecs, recommendations, users,
+      neighborhood, similarities);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+BuildRecommendationIndex()
+{
+  // Compute the neighborhood of every user once; afterwards, serving
+  // recommendations is a pure table lookup plus a top-N scan, with no
+  // neighbor search structure construction at all.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  Timer::Start("cf_build_index");
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, indexedNeighborhood, indexedSimilarities);
+  Timer::Stop("cf_build_index");
+
+  indexBuilt = true;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetRecommendationsFromIndex(const size_t numRecs,
+                            arma::Mat<size_t>& recommendations,
+                            const arma::Col<size_t>& users)
+{
+  if (!indexBuilt)
+  {
+    Log::Fatal << "CFType::GetRecommendationsFromIndex(): no recommendation "
+        << "index available; call BuildRecommendationIndex() after training "
+        << "or loading the model!" << std::endl;
+  }
+
+  // Look the neighborhoods of the queried users up in the prebuilt index.
+  const arma::uvec userIndices = arma::conv_to<arma::uvec>::from(users);
+  const arma::Mat<size_t> neighborhood = indexedNeighborhood.cols(userIndices);
+  const arma::mat similarities = indexedSimilarities.cols(userIndices);
+
+  GenerateRecommendations<InterpolationPolicy>(numRecs, recommendations, users,
+      neighborhood, similarities);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetRecommendationsFromIndex(const size_t numRecs,
+                            const size_t user,
+                            arma::Col<size_t>& recommendations)
+{
+  arma::Col<size_t> users(1);
+  users(0) = user;
+
+  arma::Mat<size_t> recommendationMatrix;
+  GetRecommendationsFromIndex<InterpolationPolicy>(numRecs,
+      recommendationMatrix, users);
+
+  recommendations = recommendationMatrix.col(0);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GenerateRecommendations(const size_t numRecs,
+                        arma::Mat<size_t>& recommendations,
+                        const arma::Col<size_t>& users,
+                        const arma::Mat<size_t>& neighborhood,
+                        const arma::mat& similarities)
+{
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
   recommendations.set_size(numRecs, users.n_elem);
@@ -351,37 +443,74 @@ Predict(const arma::Mat<size_t>& combinations,
   decomposition.template GetNeighborhood<NeighborSearchPolicy>(
       users, numUsersForSimilarity, neighborhood, similarities);
 
-  arma::mat weights(numUsersForSimilarity, users.n_elem);
-
-  // Calculate interpolation weights.
-  InterpolationPolicy interpolation(cleanedData);
-  for (size_t i = 0; i < users.n_elem; i++)
+  // The combinations are sorted by user, so each user's queries form one
+  // contiguous block; find the block boundaries.  (Every element of 'users'
+  // appears in the sorted combinations, since that is where it came from.)
+  arma::Col<size_t> blockStarts(users.n_elem + 1);
+  blockStarts[0] = 0;
+  size_t user = 0;
+  for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
   {
-    interpolation.GetWeights(weights.col(i), decomposition, users[i],
-        neighborhood.col(i), similarities.col(i), cleanedData);
+    while (users[user] != sortedCombinations(0, i))
+      blockStarts[++user] = i;
   }
+  blockStarts[users.n_elem] = sortedCombinations.n_cols;
 
   // Now that we have the neighborhoods we need, calculate the predictions.
+  // Each user's block of queries is independent of every other user's, so the
+  // blocks are distributed across threads; each thread carries its own
+  // interpolation object, since interpolation policies may cache internal
+  // state across GetWeights() calls.
   predictions.set_size(combinations.n_cols);
 
-  size_t user = 0; // Cumulative user count, because we are doing it in order.
-  for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
+  #pragma omp parallel
   {
-    // Could this be made faster by calculating dot products for multiple items
-    // at once?
-    double rating = 0.0;
-
-    // Map the combination's user to the user ID used for kNN.
-    while (users[user] < sortedCombinations(0, i))
-      ++user;
+    InterpolationPolicy interpolation(cleanedData);
+    arma::vec weights(numUsersForSimilarity);
+    arma::vec userRatings, neighborRatings;
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t u = 0; u < (omp_size_t) users.n_elem; ++u)
     {
-      rating += weights(j, user) * decomposition.GetRating(
-          neighborhood(j, user), sortedCombinations(1, i));
-    }
+      const size_t begin = blockStarts[u];
+      const size_t end = blockStarts[u + 1];
+
+      // Calculate this user's interpolation weights once, for all of the
+      // user's queried items.
+      interpolation.GetWeights(weights, decomposition, users[u],
+          neighborhood.col(u), similarities.col(u), cleanedData);
 
-    predictions(ordering[i]) = rating;
+      if ((end - begin) * neighborhood.n_rows >= cleanedData.n_rows)
+      {
+        // Enough items are queried for this user that it is cheaper to
+        // accumulate the weighted sum of the neighbors' full rating vectors
+        // once and then read the queried items off, than to take a dot
+        // product over the neighborhood for every single query.
+        userRatings.zeros(cleanedData.n_rows);
+        for (size_t j = 0; j < neighborhood.n_rows; ++j)
+        {
+          decomposition.GetRatingOfUser(neighborhood(j, u), neighborRatings);
+          userRatings += weights(j) * neighborRatings;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+          predictions(ordering[i]) = userRatings(sortedCombinations(1, i));
+      }
+      else
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          double rating = 0.0;
+          for (size_t j = 0; j < neighborhood.n_rows; ++j)
+          {
+            rating += weights(j) * decomposition.GetRating(
+                neighborhood(j, u), sortedCombinations(1, i));
+          }
+
+          predictions(ordering[i]) = rating;
+        }
+      }
+    }
   }
 
   // Denormalize ratings.
@@ -417,8 +546,9 @@ CleanData(const arma::mat& data, arma::sp_mat& cleanedData)
   const size_t maxItemID = (size_t) max(locations.row(0)) + 1;
   const size_t maxUserID = (size_t) max(locations.row(1)) + 1;
 
-  // Fill sparse matrix.
-  cleanedData = arma::sp_mat(locations, values, maxItemID, maxUserID);
+  // Fill sparse matrix.  The parallel builder assembles the CSC arrays
+  // directly instead of letting Armadillo sort the triplets on one thread.
+  math::BuildSparse(locations, values, maxItemID, maxUserID, cleanedData);
 }
 
 //! Serialize the model.
@@ -48,11 +48,17 @@ class RandomizedSVDPolicy
    *        (Default: rank + 2).
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
+   * @param warmStart If true, repeated calls to Apply() seed the
+   *        decomposition with the factors of the previous call (including
+   *        factors restored by deserialization), so that periodic retraining
+   *        on slightly changed data converges with fewer power iterations.
    */
   RandomizedSVDPolicy(const size_t iteratedPower = 0,
-                      const size_t maxIterations = 2) :
+                      const size_t maxIterations = 2,
+                      const bool warmStart = false) :
       iteratedPower(iteratedPower),
-      maxIterations(maxIterations)
+      maxIterations(maxIterations),
+      warmStart(warmStart)
   {
     /* Nothing to do here */
   }
@@ -81,6 +87,22 @@ class RandomizedSVDPolicy
 
     // Do singular value decomposition using the randomized SVD algorithm.
     svd::RandomizedSVD rsvd(iteratedPower, maxIterations);
+
+    // If requested, seed this solve with the factors of the previous one, so
+    // that power iteration starts from a subspace that is already close to
+    // the solution.  The basis has to live in the larger dimension of the
+    // rating matrix; any scaling left in the factors is removed by the
+    // conditioning step inside RandomizedSVD.
+    if (warmStart && w.n_elem > 0 && h.n_elem > 0)
+    {
+      if (cleanedData.n_cols >= cleanedData.n_rows &&
+          h.n_cols == cleanedData.n_cols)
+        rsvd.Basis() = h.t();
+      else if (cleanedData.n_cols < cleanedData.n_rows &&
+          w.n_rows == cleanedData.n_rows)
+        rsvd.Basis() = w;
+    }
+
     rsvd.Apply(cleanedData, w, sigma, h, rank);
 
     // Sigma matrix is multiplied to w.
@@ -167,6 +189,11 @@ class RandomizedSVDPolicy
   //! Modify the number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get whether Apply() warm starts from the previous factors.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether Apply() warm starts from the previous factors.
+  bool& WarmStart() { return warmStart; }
+
   /**
    * Serialization.
    */
@@ -182,6 +209,8 @@ class RandomizedSVDPolicy
   size_t iteratedPower;
   //! Locally stored number of iterations.
   size_t maxIterations;
+  //! Whether to seed each decomposition with the previous factors.
+  bool warmStart;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
@@ -89,31 +89,54 @@ class ItemMeanNormalization
    */
   void Normalize(arma::sp_mat& cleanedData)
   {
-    // Calculate itemMean.
+    // Work directly on the value and row-index arrays of the CSC
+    // representation.  An item's ratings are scattered through the value
+    // array, so per-item sums are accumulated in one parallel pass with
+    // per-thread partial sums, and the update is then a second in-place pass
+    // over the values.  No nonzero value becomes zero (zeros are clamped to
+    // the smallest positive double below), so the structure does not change.
+    cleanedData.sync();
+    arma::vec values(arma::access::rwp(cleanedData.values),
+        cleanedData.n_nonzero, false, true);
+    const arma::uword* rowIndices = cleanedData.row_indices;
+
     itemMean = arma::vec(cleanedData.n_rows, arma::fill::zeros);
     arma::Col<size_t> ratingNum(cleanedData.n_rows, arma::fill::zeros);
-    arma::sp_mat::iterator it = cleanedData.begin();
-    arma::sp_mat::iterator it_end = cleanedData.end();
-    for (; it != it_end; ++it)
+
+    #pragma omp parallel
     {
-      itemMean(it.row()) += *it;
-      ratingNum(it.row()) += 1;
+      arma::vec localSum(cleanedData.n_rows, arma::fill::zeros);
+      arma::Col<size_t> localNum(cleanedData.n_rows, arma::fill::zeros);
+
+      #pragma omp for nowait
+      for (omp_size_t i = 0; i < (omp_size_t) cleanedData.n_nonzero; ++i)
+      {
+        localSum(rowIndices[i]) += values[i];
+        localNum(rowIndices[i]) += 1;
+      }
+
+      #pragma omp critical
+      {
+        itemMean += localSum;
+        ratingNum += localNum;
+      }
     }
+
     for (size_t i = 0; i < itemMean.n_elem; i++)
     {
       if (ratingNum(i) != 0)
         itemMean(i) /= ratingNum(i);
     }
 
-    // Normalize the data.
-    it = cleanedData.begin();
-    for (; it != cleanedData.end(); ++it)
+    // Normalize the data in place; each nonzero is written exactly once.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) cleanedData.n_nonzero; ++i)
     {
-      *it = *it - itemMean(it.row());
+      values[i] -= itemMean(rowIndices[i]);
       // The algorithm omits rating of zero. If normalized rating equals zero,
       // it is set to the smallest positive double value.
-      if (*it == 0)
-        *it = std::numeric_limits<double>::min();
+      if (values[i] == 0)
+        values[i] = std::numeric_limits<double>::min();
     }
   }
 
@@ -70,18 +70,24 @@ class OverallMeanNormalization
     // Caculate mean of all non zero ratings.
     if (cleanedData.n_nonzero != 0)
     {
-      mean = arma::accu(cleanedData) / cleanedData.n_nonzero;
-      // Subtract mean from all non zero ratings.
-      arma::sp_mat::iterator it = cleanedData.begin();
-      arma::sp_mat::iterator it_end = cleanedData.end();
-      for (; it != it_end; ++it)
+      // Work directly on the value array of the CSC representation, avoiding
+      // the per-element iterator walk.  No nonzero value becomes zero (zeros
+      // are clamped to the smallest positive double below), so the structure
+      // does not change.
+      cleanedData.sync();
+      arma::vec values(arma::access::rwp(cleanedData.values),
+          cleanedData.n_nonzero, false, true);
+
+      mean = arma::mean(values);
+      // Subtract mean from all non zero ratings, in place.
+      values -= mean;
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive double value.
+      values.for_each([](double& x)
       {
-        *it = *it - mean;
-        // The algorithm omits rating of zero. If normalized rating equals zero,
-        // it is set to the smallest positive double value.
-        if (*it == 0)
-          *it = std::numeric_limits<double>::min();
-      }
+        if (x == 0)
+          x = std::numeric_limits<double>::min();
+      });
     }
     else
     {
@@ -89,31 +89,38 @@ class UserMeanNormalization
    */
   void Normalize(arma::sp_mat& cleanedData)
   {
-    // Calculate userMean.
+    // Work directly on the value array of the CSC representation.  Each
+    // user's ratings form one contiguous range of that array, so the mean
+    // and the update can be fused into a single parallel pass over the
+    // columns, without rebuilding the sparse matrix.  No nonzero value
+    // becomes zero (zeros are clamped to the smallest positive double
+    // below), so the structure does not change.
+    cleanedData.sync();
+    arma::vec values(arma::access::rwp(cleanedData.values),
+        cleanedData.n_nonzero, false, true);
+
     userMean = arma::vec(cleanedData.n_cols, arma::fill::zeros);
-    arma::Col<size_t> ratingNum(cleanedData.n_cols, arma::fill::zeros);
-    arma::sp_mat::iterator it = cleanedData.begin();
-    arma::sp_mat::iterator it_end = cleanedData.end();
-    for (; it != it_end; ++it)
-    {
-      userMean(it.col()) += *it;
-      ratingNum(it.col()) += 1;
-    }
-    for (size_t i = 0; i < userMean.n_elem; i++)
-    {
-      if (ratingNum(i) != 0)
-        userMean(i) /= ratingNum(i);
-    }
 
-    // Normalize the data.
-    it = cleanedData.begin();
-    for (; it != cleanedData.end(); ++it)
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t col = 0; col < (omp_size_t) cleanedData.n_cols; ++col)
     {
-      *it = *it - userMean(it.col());
+      const arma::uword begin = cleanedData.col_ptrs[col];
+      const arma::uword end = cleanedData.col_ptrs[col + 1];
+      if (end == begin)
+        continue; // The user has no ratings; the mean stays 0.
+
+      userMean(col) = arma::accu(values.subvec(begin, end - 1)) /
+          (end - begin);
+
+      // Subtract the user mean from the user's ratings, in place.
+      values.subvec(begin, end - 1) -= userMean(col);
       // The algorithm omits rating of zero. If normalized rating equals zero,
       // it is set to the smallest positive double value.
-      if (*it == 0)
-        *it = std::numeric_limits<double>::min();
+      values.subvec(begin, end - 1).for_each([](double& x)
+      {
+        if (x == 0)
+          x = std::numeric_limits<double>::min();
+      });
     }
   }
 
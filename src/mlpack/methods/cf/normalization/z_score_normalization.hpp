@@ -75,10 +75,17 @@ class ZScoreNormalization
    */
   void Normalize(arma::sp_mat& cleanedData)
   {
+    // Work directly on the value array of the CSC representation; this avoids
+    // both the temporary copy made by arma::nonzeros() and the per-element
+    // iterator walk.  No nonzero value becomes zero (zeros are clamped to the
+    // smallest positive double below), so the structure does not change.
+    cleanedData.sync();
+    arma::vec values(arma::access::rwp(cleanedData.values),
+        cleanedData.n_nonzero, false, true);
+
     // Caculate mean and stdev of all non zero ratings.
-    arma::vec ratings = arma::nonzeros(cleanedData);
-    mean = arma::mean(ratings);
-    stddev = arma::stddev(ratings);
+    mean = arma::mean(values);
+    stddev = arma::stddev(values);
 
     if (std::fabs(stddev) < 1e-14)
     {
@@ -87,17 +94,16 @@ class ZScoreNormalization
           << std::endl;
     }
 
-    // Subtract mean from existing rating and divide it by stddev.
-    arma::sp_mat::iterator it = cleanedData.begin();
-    arma::sp_mat::iterator it_end = cleanedData.end();
-    for (; it != it_end; ++it)
+    // Subtract mean from existing ratings and divide by stddev, in place.
+    values -= mean;
+    values /= stddev;
+    // The algorithm omits rating of zero. If normalized rating equals zero,
+    // it is set to the smallest positive double value.
+    values.for_each([](double& x)
     {
-      *it = (*it - mean) / stddev;
-      // The algorithm omits rating of zero. If normalized rating equals zero,
-      // it is set to the smallest positive double value.
-      if (*it == 0)
-        *it = std::numeric_limits<double>::min();
-    }
+      if (x == 0)
+        x = std::numeric_limits<double>::min();
+    });
   }
 
   /**
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_SVDWRAPPER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/block_krylov_svd/randomized_block_krylov_svd.hpp>
 
 namespace mlpack
 {
@@ -110,16 +110,57 @@ double mlpack::cf::SVDWrapper<DummyClass>::Apply(const arma::mat& V,
     Log::Info << "Setting decomposition rank to " << r << std::endl;
   }
 
-  // get svd factorization
+  const size_t minDim = std::min(V.n_rows, V.n_cols);
+  const size_t blockSize = r + 10;
+
   arma::vec sigma;
-  arma::svd(W, sigma, H, V);
+  if (5 * blockSize <= minDim)
+  {
+    // The requested rank is small relative to the matrix, so the full SVD
+    // would compute far more than we keep.  Instead, run the randomized block
+    // Krylov method (a block Lanczos-type scheme built on blocked matrix
+    // products), restarting with a deeper Krylov space until the leading
+    // singular values stabilize.
+    const double tolerance = 1e-5;
+    arma::vec prevSigma;
+    size_t iterations = 2;
+    while (true)
+    {
+      svd::RandomizedBlockKrylovSVD blockKrylov(iterations, blockSize);
+      blockKrylov.Apply(V, W, sigma, H, r);
+
+      const arma::vec leading = sigma.subvec(0, r - 1);
+      if (prevSigma.n_elem == r &&
+          arma::norm(leading - prevSigma) <= tolerance * arma::norm(leading))
+        break;
+
+      // The Krylov basis holds (iterations + 1) blocks; there is no point in
+      // growing it beyond the size of the matrix itself.
+      if (blockSize * (2 * iterations + 1) > minDim)
+        break;
+
+      prevSigma = leading;
+      iterations *= 2;
+    }
+
+    // The Krylov method returns as many singular triplets as the basis
+    // holds; keep only the requested rank.
+    W = W.cols(0, r - 1);
+    H = H.cols(0, r - 1);
+    sigma = sigma.subvec(0, r - 1);
+  }
+  else
+  {
+    // get svd factorization
+    arma::svd(W, sigma, H, V);
 
-  // remove the part of W and H depending upon the value of rank
-  W = W.submat(0, 0, W.n_rows - 1, r - 1);
-  H = H.submat(0, 0, H.n_cols - 1, r - 1);
+    // remove the part of W and H depending upon the value of rank
+    W = W.submat(0, 0, W.n_rows - 1, r - 1);
+    H = H.submat(0, 0, H.n_cols - 1, r - 1);
 
-  // take only required eigenvalues
-  sigma = sigma.subvec(0, r - 1);
+    // take only required eigenvalues
+    sigma = sigma.subvec(0, r - 1);
+  }
 
   // eigenvalue matrix is multiplied to W
   // it can either be multiplied to H matrix
@@ -0,0 +1,116 @@
+/**
+ * @file grid_range_search.hpp
+ *
+ * A cell-grid range search engine for low-dimensional data, meant as a
+ * drop-in RangeSearchType for DBSCAN.  Points are binned into cells whose
+ * side length equals the search radius, so the neighbors of a query point can
+ * only lie in the 3^d cells adjacent to its own.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/math/range.hpp>
+
+#include <map>
+#include <vector>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * A grid-based range search suitable for low-dimensional data (roughly 2-10
+ * dimensions) and a fixed search radius, such as the epsilon-neighborhood
+ * queries issued by DBSCAN.  The reference points are binned into a sparse
+ * grid of cells with side length equal to the search radius; any point within
+ * the radius of a query must then fall into one of the 3^d cells surrounding
+ * the query's cell, so only those cells are scanned.  Queries are answered in
+ * parallel, since the grid is read-only during search.
+ *
+ * The cell containment argument requires that no coordinate of two points can
+ * differ by more than their distance, which holds for all LMetric-type
+ * metrics; the grid is built for the radius of the first search and rebuilt
+ * automatically if a different radius is requested.
+ *
+ * This class implements the subset of the RangeSearch interface used by
+ * DBSCAN, so it can be used as, e.g., DBSCAN<GridRangeSearch<>>.
+ *
+ * @tparam MetricType Metric to use (must satisfy the coordinate-difference
+ *     bound above; the LMetric family does).
+ * @tparam MatType Type of data (arma::mat).
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class GridRangeSearch
+{
+ public:
+  /**
+   * Construct the GridRangeSearch object, optionally with an instantiated
+   * metric.  Call Train() before Search().
+   *
+   * @param metric Instantiated metric.
+   */
+  GridRangeSearch(MetricType metric = MetricType());
+
+  /**
+   * Set the reference set.  The grid itself is built lazily on the first
+   * Search() call, because the cell width depends on the search radius.  The
+   * given matrix must remain valid for the lifetime of any searches.
+   *
+   * @param referenceSet Reference points to search over.
+   */
+  void Train(const MatType& referenceSet);
+
+  /**
+   * Search for all reference points in the given range from each query point.
+   * Note that if the query set is the reference set, a query point will find
+   * itself as its own neighbor (at distance 0), exactly as RangeSearch
+   * behaves for separate-but-identical query sets.
+   *
+   * @tparam QueryType Type of query data (a matrix or single column).
+   * @param querySet Set of query points.
+   * @param range Range of distances for neighbors to be in.
+   * @param neighbors Vector of vectors holding neighbors of each query point.
+   * @param distances Vector of vectors holding distances to each neighbor.
+   */
+  template<typename QueryType>
+  void Search(const QueryType& querySet,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+ private:
+  //! Bin every reference point into cells of the given side length.
+  void BuildGrid(const double radius);
+
+  //! Convenience typedef for the sparse cell storage; the map is keyed on the
+  //! integer cell coordinates of each non-empty cell.
+  typedef std::map<std::vector<long>, std::vector<size_t>> GridType;
+
+  //! The instantiated metric.
+  MetricType metric;
+  //! The reference set (not owned).
+  const MatType* referenceSet;
+  //! The side length of each grid cell.
+  double cellWidth;
+  //! The radius the grid was built for; -1 if the grid has not been built.
+  double builtRadius;
+  //! The per-dimension minimum of the reference set (origin of the grid).
+  arma::vec minCorner;
+  //! The non-empty cells of the grid.
+  GridType grid;
+};
+
+} // namespace dbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
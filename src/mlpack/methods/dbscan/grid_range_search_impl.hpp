@@ -0,0 +1,139 @@
+/**
+ * @file grid_range_search_impl.hpp
+ *
+ * Implementation of the cell-grid range search engine for low-dimensional
+ * data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+namespace dbscan {
+
+template<typename MetricType, typename MatType>
+GridRangeSearch<MetricType, MatType>::GridRangeSearch(MetricType metric) :
+    metric(metric),
+    referenceSet(NULL),
+    cellWidth(0.0),
+    builtRadius(-1.0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Train(const MatType& referenceSet)
+{
+  this->referenceSet = &referenceSet;
+  // Invalidate any grid built for an earlier reference set; the grid itself
+  // is built on the first search, when the radius is known.
+  builtRadius = -1.0;
+  grid.clear();
+}
+
+template<typename MetricType, typename MatType>
+template<typename QueryType>
+void GridRangeSearch<MetricType, MatType>::Search(
+    const QueryType& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  if (referenceSet == NULL)
+    throw std::invalid_argument("GridRangeSearch::Search(): no reference set; "
+        "call Train() first!");
+  if (querySet.n_rows != referenceSet->n_rows)
+    throw std::invalid_argument("GridRangeSearch::Search(): dimensionality of "
+        "query set must match the reference set!");
+
+  // (Re)build the grid if the radius changed since the last search.
+  if (range.Hi() != builtRadius)
+    BuildGrid(range.Hi());
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  const size_t dims = referenceSet->n_rows;
+
+  // Each query point only reads the grid and writes its own result vectors,
+  // so the queries are processed in parallel.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    // The cell this query point falls into.
+    std::vector<long> cell(dims);
+    for (size_t d = 0; d < dims; ++d)
+      cell[d] = (long) std::floor((querySet(d, i) - minCorner[d]) / cellWidth);
+
+    // Walk the 3^d adjacent cells with an odometer over the offsets.
+    std::vector<long> offset(dims, -1);
+    std::vector<long> probe(dims);
+    while (true)
+    {
+      for (size_t d = 0; d < dims; ++d)
+        probe[d] = cell[d] + offset[d];
+
+      const typename GridType::const_iterator it = grid.find(probe);
+      if (it != grid.end())
+      {
+        const std::vector<size_t>& bin = it->second;
+        for (size_t j = 0; j < bin.size(); ++j)
+        {
+          const double distance = metric.Evaluate(querySet.col(i),
+              referenceSet->unsafe_col(bin[j]));
+          if (range.Contains(distance))
+          {
+            neighbors[i].push_back(bin[j]);
+            distances[i].push_back(distance);
+          }
+        }
+      }
+
+      // Advance the odometer; when it rolls over, every cell has been seen.
+      size_t d = 0;
+      while (d < dims && offset[d] == 1)
+      {
+        offset[d] = -1;
+        ++d;
+      }
+      if (d == dims)
+        break;
+      ++offset[d];
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::BuildGrid(const double radius)
+{
+  grid.clear();
+  builtRadius = radius;
+  // A degenerate radius would make every cell empty or infinitely thin; any
+  // positive width is correct (only exact matches can pass the range check).
+  cellWidth = (radius > 0.0) ? radius : 1.0;
+  minCorner = arma::vec(arma::min(*referenceSet, 1));
+
+  const size_t dims = referenceSet->n_rows;
+  std::vector<long> cell(dims);
+  for (size_t i = 0; i < referenceSet->n_cols; ++i)
+  {
+    for (size_t d = 0; d < dims; ++d)
+      cell[d] = (long) std::floor(((*referenceSet)(d, i) - minCorner[d]) /
+          cellWidth);
+    grid[cell].push_back(i);
+  }
+}
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file binned_decision_stump.hpp
+ *
+ * Definition of the binned decision stump, which finds its split over
+ * quantized features with weighted histograms.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_STUMP_BINNED_DECISION_STUMP_HPP
+#define MLPACK_METHODS_DECISION_STUMP_BINNED_DECISION_STUMP_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <memory>
+
+namespace mlpack {
+namespace decision_stump {
+
+/**
+ * This class implements a binary decision stump trained over binned features.
+ * Each dimension is quantized once into at most 256 bins; a training round
+ * then reduces a weighted class histogram per dimension and scans the bins
+ * for the entropy-minimizing threshold, instead of sorting every dimension.
+ * The quantization depends only on the data, so it is reused across repeated
+ * trainings on the same matrix with different weights - the access pattern of
+ * boosting. The weak learner constructor stores the bin codes in the
+ * prototype stump, so AdaBoost rounds after the first skip quantization
+ * entirely and cost one histogram pass per dimension.
+ *
+ * The stump splits on a single dimension and threshold; each side predicts
+ * its weighted majority class.
+ *
+ * @tparam MatType Type of matrix that is being used (sparse or dense).
+ */
+template<typename MatType = arma::mat>
+class BinnedDecisionStump
+{
+ public:
+  /**
+   * Constructor. Train on the provided data.
+   *
+   * @param data Input, training data.
+   * @param labels Labels of training data.
+   * @param numClasses Number of distinct classes in labels.
+   * @param numBins Number of quantization bins per dimension (at most 256).
+   */
+  BinnedDecisionStump(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const size_t numBins = 256);
+
+  /**
+   * Alternate constructor which copies the parameters from an already
+   * initiated binned stump and trains with the given weights. If the other
+   * stump has bin codes for this exact matrix they are reused; otherwise the
+   * data is quantized and the codes are stored in the other stump, so that
+   * subsequent boosting rounds reuse them.
+   *
+   * @param other The other initiated binned stump.
+   * @param data The data on which to train this object on.
+   * @param labels The labels of data.
+   * @param numClasses Number of distinct classes in labels.
+   * @param weights Weight vector to use while training. For boosting purposes.
+   */
+  BinnedDecisionStump(const BinnedDecisionStump& other,
+                      const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::rowvec& weights);
+
+  /**
+   * Create a binned decision stump without training. This stump will always
+   * return a class of 0 until Train() is called.
+   */
+  BinnedDecisionStump();
+
+  /**
+   * Train the binned decision stump on the given data.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param numBins Number of quantization bins per dimension (at most 256).
+   * @return The weighted entropy of the chosen split.
+   */
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numBins = 256);
+
+  /**
+   * Train the binned decision stump on the given data, with the given
+   * weights.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param weights Weights for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param numBins Number of quantization bins per dimension (at most 256).
+   * @return The weighted entropy of the chosen split.
+   */
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const arma::rowvec& weights,
+               const size_t numClasses,
+               const size_t numBins = 256);
+
+  /**
+   * Classification function. After training, classify test, and put the
+   * predicted classes in predictedLabels.
+   *
+   * @param test Testing data or data to classify.
+   * @param predictedLabels Vector to store the predicted classes after
+   *     classifying test data.
+   */
+  void Classify(const MatType& test, arma::Row<size_t>& predictedLabels) const;
+
+  //! Access the splitting dimension.
+  size_t SplitDimension() const { return splitDimension; }
+
+  //! Access the splitting threshold.
+  double SplitValue() const { return splitValue; }
+
+  //! Access the label predicted below the threshold.
+  size_t LeftLabel() const { return leftLabel; }
+
+  //! Access the label predicted at or above the threshold.
+  size_t RightLabel() const { return rightLabel; }
+
+  //! Access the number of quantization bins.
+  size_t NumBins() const { return numBins; }
+
+  //! Serialize the binned decision stump.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * The reusable quantization of a dataset: per-dimension bin codes along
+   * with the bin geometry needed to turn a bin index back into a threshold.
+   * Codes are stored point-major (one contiguous column per dimension).
+   */
+  struct BinningCache
+  {
+    //! The matrix the codes were computed for, used for reuse detection.
+    const void* dataPtr;
+    //! The number of rows of that matrix.
+    size_t rows;
+    //! The number of columns of that matrix.
+    size_t cols;
+    //! Bin codes; element (i, d) is the bin of point i in dimension d.
+    arma::Mat<unsigned char> codes;
+    //! Per-dimension minimum values.
+    arma::vec mins;
+    //! Per-dimension bin widths (zero for constant dimensions).
+    arma::vec widths;
+  };
+
+  /**
+   * Quantize the given dataset into a fresh binning cache.
+   *
+   * @param data Dataset to quantize.
+   */
+  void Quantize(const MatType& data);
+
+  /**
+   * Find the entropy-minimizing split over the binned features.
+   *
+   * @param labels Labels for each point in the dataset.
+   * @param weights Weights for each point in the dataset.
+   * @tparam UseWeights If true, the weights in the weight vector will be used
+   *      (otherwise they are ignored).
+   * @return The weighted entropy of the chosen split.
+   */
+  template<bool UseWeights>
+  double TrainInternal(const arma::Row<size_t>& labels,
+                       const arma::rowvec& weights);
+
+  //! The number of classes.
+  size_t numClasses;
+  //! The number of quantization bins per dimension.
+  size_t numBins;
+  //! The dimension on which to split.
+  size_t splitDimension;
+  //! The splitting threshold; DBL_MAX if no usable split was found.
+  double splitValue;
+  //! The label predicted below the threshold.
+  size_t leftLabel;
+  //! The label predicted at or above the threshold.
+  size_t rightLabel;
+  //! The quantization of the training data, shared across boosting rounds.
+  mutable std::shared_ptr<BinningCache> cache;
+};
+
+} // namespace decision_stump
+} // namespace mlpack
+
+#include "binned_decision_stump_impl.hpp"
+
+#endif
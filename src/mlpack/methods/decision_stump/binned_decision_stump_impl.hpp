@@ -0,0 +1,315 @@
+/**
+ * @file binned_decision_stump_impl.hpp
+ *
+ * Implementation of the binned decision stump.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_STUMP_BINNED_DECISION_STUMP_IMPL_HPP
+#define MLPACK_METHODS_DECISION_STUMP_BINNED_DECISION_STUMP_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "binned_decision_stump.hpp"
+
+namespace mlpack {
+namespace decision_stump {
+
+template<typename MatType>
+BinnedDecisionStump<MatType>::BinnedDecisionStump() :
+    numClasses(1),
+    numBins(0),
+    splitDimension(0),
+    splitValue(DBL_MAX),
+    leftLabel(0),
+    rightLabel(0)
+{ /* Nothing to do. */ }
+
+template<typename MatType>
+BinnedDecisionStump<MatType>::BinnedDecisionStump(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numBins)
+{
+  arma::rowvec weights;
+  this->numClasses = numClasses;
+  this->numBins = numBins;
+
+  Quantize(data);
+  TrainInternal<false>(labels, weights);
+}
+
+template<typename MatType>
+BinnedDecisionStump<MatType>::BinnedDecisionStump(
+    const BinnedDecisionStump& other,
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights)
+{
+  this->numClasses = numClasses;
+  this->numBins = (other.numBins == 0) ? 256 : other.numBins;
+
+  if (other.cache && other.cache->dataPtr == (const void*) &data &&
+      other.cache->rows == data.n_rows && other.cache->cols == data.n_cols)
+  {
+    // The data was already quantized in an earlier boosting round.
+    cache = other.cache;
+  }
+  else
+  {
+    Quantize(data);
+    // Store the codes in the prototype stump, so that later rounds on the
+    // same matrix skip quantization.
+    other.cache = cache;
+  }
+
+  TrainInternal<true>(labels, weights);
+}
+
+template<typename MatType>
+double BinnedDecisionStump<MatType>::Train(const MatType& data,
+                                           const arma::Row<size_t>& labels,
+                                           const size_t numClasses,
+                                           const size_t numBins)
+{
+  arma::rowvec weights;
+  this->numClasses = numClasses;
+  this->numBins = numBins;
+
+  Quantize(data);
+  return TrainInternal<false>(labels, weights);
+}
+
+template<typename MatType>
+double BinnedDecisionStump<MatType>::Train(const MatType& data,
+                                           const arma::Row<size_t>& labels,
+                                           const arma::rowvec& weights,
+                                           const size_t numClasses,
+                                           const size_t numBins)
+{
+  this->numClasses = numClasses;
+  this->numBins = numBins;
+
+  Quantize(data);
+  return TrainInternal<true>(labels, weights);
+}
+
+template<typename MatType>
+void BinnedDecisionStump<MatType>::Classify(
+    const MatType& test,
+    arma::Row<size_t>& predictedLabels) const
+{
+  predictedLabels.set_size(test.n_cols);
+  for (size_t i = 0; i < test.n_cols; ++i)
+  {
+    predictedLabels(i) = (test(splitDimension, i) < splitValue) ?
+        leftLabel : rightLabel;
+  }
+}
+
+template<typename MatType>
+void BinnedDecisionStump<MatType>::Quantize(const MatType& data)
+{
+  if (numBins < 2 || numBins > 256)
+  {
+    throw std::invalid_argument("BinnedDecisionStump::Quantize(): number of "
+        "bins must be between 2 and 256!");
+  }
+
+  cache = std::make_shared<BinningCache>();
+  cache->dataPtr = (const void*) &data;
+  cache->rows = data.n_rows;
+  cache->cols = data.n_cols;
+  cache->codes.set_size(data.n_cols, data.n_rows);
+  cache->mins.set_size(data.n_rows);
+  cache->widths.set_size(data.n_rows);
+
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    double minValue = data(d, 0);
+    double maxValue = data(d, 0);
+    for (size_t i = 1; i < data.n_cols; ++i)
+    {
+      minValue = std::min(minValue, (double) data(d, i));
+      maxValue = std::max(maxValue, (double) data(d, i));
+    }
+
+    cache->mins(d) = minValue;
+    cache->widths(d) = (maxValue - minValue) / numBins;
+
+    if (cache->widths(d) == 0.0)
+    {
+      // Constant dimension; every point lands in bin 0.
+      cache->codes.col(d).zeros();
+      continue;
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      size_t bin = (size_t) ((data(d, i) - minValue) / cache->widths(d));
+      if (bin >= numBins)
+        bin = numBins - 1;
+      cache->codes(i, d) = (unsigned char) bin;
+    }
+  }
+}
+
+template<typename MatType>
+template<bool UseWeights>
+double BinnedDecisionStump<MatType>::TrainInternal(
+    const arma::Row<size_t>& labels,
+    const arma::rowvec& weights)
+{
+  const size_t numPoints = cache->cols;
+  const size_t numDims = cache->rows;
+
+  // Total class weights, needed to seed the right-hand side of every scan.
+  arma::vec totals(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < numPoints; ++i)
+    totals(labels(i)) += UseWeights ? weights(i) : 1.0;
+  const double totalWeight = arma::accu(totals);
+
+  // The entropy of a class weight vector, scaled by its total weight.
+  auto entropy = [](const arma::vec& classWeights, const double sum) -> double
+  {
+    double e = 0.0;
+    for (size_t c = 0; c < classWeights.n_elem; ++c)
+    {
+      const double p = classWeights(c) / sum;
+      if (p > 0.0)
+        e -= p * std::log2(p);
+    }
+    return e;
+  };
+
+  double bestEntropy = DBL_MAX;
+  size_t bestDim = 0;
+  size_t bestBin = 0;
+  bool foundSplit = false;
+
+  #pragma omp parallel
+  {
+    double localBestEntropy = DBL_MAX;
+    size_t localBestDim = 0;
+    size_t localBestBin = 0;
+    bool localFound = false;
+
+    arma::mat hist(numClasses, numBins);
+    arma::vec left(numClasses);
+    arma::vec right(numClasses);
+
+    #pragma omp for nowait
+    for (omp_size_t d = 0; d < (omp_size_t) numDims; ++d)
+    {
+      if (cache->widths(d) == 0.0)
+        continue; // A constant dimension cannot be split.
+
+      // Reduce the weighted class histogram of this dimension.
+      hist.zeros();
+      const unsigned char* codes = cache->codes.colptr(d);
+      for (size_t i = 0; i < numPoints; ++i)
+        hist(labels(i), codes[i]) += UseWeights ? weights(i) : 1.0;
+
+      // Scan the bins left to right, keeping running class weights on both
+      // sides; each candidate threshold is the upper edge of a bin.
+      left.zeros();
+      right = totals;
+      double leftWeight = 0.0;
+
+      for (size_t b = 0; b + 1 < numBins; ++b)
+      {
+        const double binWeight = arma::accu(hist.col(b));
+        if (binWeight > 0.0)
+        {
+          left += hist.col(b);
+          right -= hist.col(b);
+          leftWeight += binWeight;
+        }
+
+        const double rightWeight = totalWeight - leftWeight;
+        if (leftWeight == 0.0)
+          continue;
+        if (rightWeight == 0.0)
+          break;
+
+        const double e =
+            (leftWeight / totalWeight) * entropy(left, leftWeight) +
+            (rightWeight / totalWeight) * entropy(right, rightWeight);
+
+        if (e < localBestEntropy ||
+            (e == localBestEntropy && (size_t) d < localBestDim))
+        {
+          localBestEntropy = e;
+          localBestDim = d;
+          localBestBin = b;
+          localFound = true;
+        }
+      }
+    }
+
+    #pragma omp critical (BinnedDecisionStumpMerge)
+    {
+      if (localFound && (!foundSplit || localBestEntropy < bestEntropy ||
+          (localBestEntropy == bestEntropy && localBestDim < bestDim)))
+      {
+        bestEntropy = localBestEntropy;
+        bestDim = localBestDim;
+        bestBin = localBestBin;
+        foundSplit = true;
+      }
+    }
+  }
+
+  if (!foundSplit)
+  {
+    // Every dimension is constant (or one side of every candidate split is
+    // empty); predict the majority class everywhere.
+    splitDimension = 0;
+    splitValue = DBL_MAX;
+    leftLabel = totals.index_max();
+    rightLabel = leftLabel;
+    return entropy(totals, totalWeight);
+  }
+
+  splitDimension = bestDim;
+  splitValue = cache->mins(bestDim) + cache->widths(bestDim) * (bestBin + 1);
+
+  // Recover the majority class of each side from the winning dimension.
+  arma::vec left(numClasses, arma::fill::zeros);
+  const unsigned char* codes = cache->codes.colptr(bestDim);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    if (codes[i] <= bestBin)
+      left(labels(i)) += UseWeights ? weights(i) : 1.0;
+  }
+  const arma::vec right = totals - left;
+
+  leftLabel = left.index_max();
+  rightLabel = right.index_max();
+
+  return bestEntropy;
+}
+
+template<typename MatType>
+template<typename Archive>
+void BinnedDecisionStump<MatType>::serialize(Archive& ar,
+                                             const unsigned int /* version */)
+{
+  // The binning cache is training state and is not serialized.
+  ar & BOOST_SERIALIZATION_NVP(numClasses);
+  ar & BOOST_SERIALIZATION_NVP(numBins);
+  ar & BOOST_SERIALIZATION_NVP(splitDimension);
+  ar & BOOST_SERIALIZATION_NVP(splitValue);
+  ar & BOOST_SERIALIZATION_NVP(leftLabel);
+  ar & BOOST_SERIALIZATION_NVP(rightLabel);
+}
+
+} // namespace decision_stump
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file best_binary_categorical_split.hpp
+ *
+ * A tree splitter that finds a binary partition of the categories of a
+ * categorical feature, making it usable on high-cardinality features where
+ * one child per category is infeasible.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BestBinaryCategoricalSplit is a splitting function for decision trees
+ * that splits a categorical feature into exactly two children, instead of one
+ * child per category like AllCategoricalSplit.  It accumulates a per-category
+ * class histogram in one pass over the data, orders the categories by their
+ * (weighted) mean label, and then sweeps binary partitions along that order,
+ * evaluating each candidate from the maintained class counts.
+ *
+ * For two-class problems this ordering trick finds the best of all 2^(k - 1)
+ * binary partitions of the k categories while only evaluating k - 1 of them
+ * (Breiman et al., "Classification and Regression Trees"); for more than two
+ * classes it is a heuristic.  Either way the cost is one pass over the data
+ * plus O(k log k), so it stays feasible when k is very large.
+ *
+ * @tparam FitnessFunction Fitness function to evaluate gain with.
+ */
+template<typename FitnessFunction>
+class BestBinaryCategoricalSplit
+{
+ public:
+  // No extra info needed for split.
+  template<typename ElemType>
+  class AuxiliarySplitInfo { };
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then classProbabilities
+   * and aux may be modified.  For this particular split type, aux will be
+   * empty and classProbabilities will hold one element per category: the
+   * index (0 or 1) of the child that category is sent to.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
+  /**
+   * Return the number of children in the split.  This split is always binary.
+   *
+   * @param classProbabilities Auxiliary information for the split.
+   * @param aux (Unused) auxiliary information for the split.
+   */
+  template<typename ElemType>
+  static size_t NumChildren(const arma::Col<ElemType>& /* classProbabilities */,
+                            const AuxiliarySplitInfo<ElemType>& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Calculate the direction a point should percolate to.
+   *
+   * @param classProbabilities Auxiliary information for the split.
+   * @param aux (Unused) auxiliary information for the split.
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::Col<ElemType>& classProbabilities,
+      const AuxiliarySplitInfo<ElemType>& /* aux */);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_binary_categorical_split_impl.hpp"
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file best_binary_categorical_split_impl.hpp
+ *
+ * Implementation of the BestBinaryCategoricalSplit categorical split class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double BestBinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return bestGain;
+
+  // Accumulate the class histogram of every category in one pass over the
+  // data.  classCounts(c, k) holds the number of points (or, if weighted, the
+  // total weight) of class c in category k.
+  arma::mat classCounts(numClasses, numCategories, arma::fill::zeros);
+  arma::Col<size_t> counts(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    const double weight = UseWeights ? weights[i] : 1.0;
+
+    classCounts(labels[i], category) += weight;
+    counts[category]++;
+  }
+
+  // Gather the categories that actually occur in this node, and order them by
+  // their weighted mean label.  For two classes this order contains the best
+  // of all binary partitions; see the class documentation.
+  arma::uvec present = arma::find(arma::sum(classCounts, 0) > 0.0);
+  if (present.n_elem < 2)
+    return bestGain; // Splitting one category can't do anything.
+
+  arma::vec keys(present.n_elem);
+  for (size_t j = 0; j < present.n_elem; ++j)
+  {
+    double keySum = 0.0;
+    double weightSum = 0.0;
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      keySum += c * classCounts(c, present[j]);
+      weightSum += classCounts(c, present[j]);
+    }
+    keys[j] = keySum / weightSum;
+  }
+  present = present(arma::sort_index(keys));
+
+  // Sweep binary partitions along the sorted order, moving one whole category
+  // at a time from the right child to the left child and keeping the class
+  // counts of both children up to date, so each candidate is evaluated in
+  // O(numClasses).
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts = arma::sum(classCounts, 1);
+  const double totalWeight = arma::accu(rightCounts);
+  if (totalWeight == 0.0)
+    return bestGain;
+
+  double leftWeight = 0.0;
+  double rightWeight = totalWeight;
+  size_t leftPoints = 0;
+  size_t rightPoints = data.n_elem;
+
+  double bestFoundGain = bestGain;
+  size_t bestBoundary = present.n_elem; // Invalid; means no split found.
+  for (size_t j = 0; j < present.n_elem - 1; ++j)
+  {
+    // Move category present[j] into the left child.
+    const double categoryWeight = arma::accu(classCounts.col(present[j]));
+    leftCounts += classCounts.col(present[j]);
+    rightCounts -= classCounts.col(present[j]);
+    leftWeight += categoryWeight;
+    rightWeight -= categoryWeight;
+    leftPoints += counts[present[j]];
+    rightPoints -= counts[present[j]];
+
+    // Make sure both children would be large enough.
+    if (leftPoints < minimumLeafSize || rightPoints < minimumLeafSize)
+      continue;
+
+    // Calculate the gain for the left and right child from the maintained
+    // class counts.
+    const double leftGain = FitnessFunction::EvaluateCounts(leftCounts,
+        leftWeight);
+    const double rightGain = FitnessFunction::EvaluateCounts(rightCounts,
+        rightWeight);
+
+    const double gain = (leftWeight / totalWeight) * leftGain +
+        (rightWeight / totalWeight) * rightGain;
+
+    if (gain > bestFoundGain + minimumGainSplit)
+    {
+      bestFoundGain = gain;
+      bestBoundary = j;
+    }
+  }
+
+  if (bestBoundary == present.n_elem)
+    return bestGain; // No improvement.
+
+  // Fill classProbabilities with the direction of each category: categories
+  // up to and including the boundary go left (0), the rest go right (1).
+  // Categories not present in this node go with the heavier child.
+  double bestLeftWeight = 0.0;
+  for (size_t j = 0; j <= bestBoundary; ++j)
+    bestLeftWeight += arma::accu(classCounts.col(present[j]));
+
+  classProbabilities.set_size(numCategories);
+  classProbabilities.fill(
+      (bestLeftWeight <= totalWeight - bestLeftWeight) ? 1 : 0);
+  for (size_t j = 0; j < present.n_elem; ++j)
+    classProbabilities[present[j]] = (j <= bestBoundary) ? 0 : 1;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t BestBinaryCategoricalSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  return (size_t) classProbabilities[(size_t) point];
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
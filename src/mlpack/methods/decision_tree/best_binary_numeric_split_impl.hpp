@@ -34,64 +34,68 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
 
   // Next, sort the data.
   arma::uvec sortedIndices = arma::sort_index(data);
-  arma::Row<size_t> sortedLabels(labels.n_elem);
-  arma::rowvec sortedWeights;
-  for (size_t i = 0; i < sortedLabels.n_elem; ++i)
-    sortedLabels[i] = labels[sortedIndices[i]];
 
-  // Only initialize if we are using weights.
-  if (UseWeights)
+  // Accumulate the per-class counts (or, if weighted, per-class weight sums)
+  // of the whole node.  The sweep below moves one point at a time from the
+  // right child to the left child and updates the counts incrementally, so
+  // each candidate split is evaluated in O(numClasses) instead of re-scanning
+  // the labels.
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts(numClasses, arma::fill::zeros);
+  double totalWeight = 0.0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
   {
-    sortedWeights.set_size(sortedLabels.n_elem);
-    // The weights must keep the same order as the labels.
-    for (size_t i = 0; i < sortedLabels.n_elem; ++i)
-      sortedWeights[i] = weights[sortedIndices[i]];
+    const double weight = UseWeights ? weights[sortedIndices[i]] : 1.0;
+    rightCounts[labels[sortedIndices[i]]] += weight;
+    totalWeight += weight;
   }
 
+  // Catch edge case: if there is no weight, there is nothing to split on.
+  if (totalWeight == 0.0)
+    return bestGain;
+
   // Loop through all possible split points, choosing the best one.  Also, force
   // a minimum leaf size of 1 (empty children don't make sense).
   double bestFoundGain = bestGain;
+  double leftWeight = 0.0;
+  double rightWeight = totalWeight;
   const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // Move the points before the first candidate split into the left child.
+  for (size_t i = 0; i < minimum; ++i)
+  {
+    const double weight = UseWeights ? weights[sortedIndices[i]] : 1.0;
+    leftCounts[labels[sortedIndices[i]]] += weight;
+    rightCounts[labels[sortedIndices[i]]] -= weight;
+    leftWeight += weight;
+    rightWeight -= weight;
+  }
+
   for (size_t index = minimum; index < data.n_elem - (minimum - 1); ++index)
   {
-    // Make sure that the value has changed.
+    // At this point the left child holds the sorted points [0, index - 1] and
+    // the right child holds the rest.  Make sure that the value has changed;
+    // after checking the candidate, move the point at `index` into the left
+    // child for the next iteration.
     if (data[sortedIndices[index]] == data[sortedIndices[index - 1]])
-      continue;
-
-    // Calculate the gain for the left and right child.  Only use weights if
-    // needed.
-    const double leftGain = UseWeights ?
-        FitnessFunction::template Evaluate<true>(sortedLabels.subvec(0,
-            index - 1), numClasses, sortedWeights.subvec(0, index - 1)) :
-        FitnessFunction::template Evaluate<false>(sortedLabels.subvec(0,
-            index - 1), numClasses, sortedWeights /* ignored */);
-    const double rightGain = UseWeights ?
-        FitnessFunction::template Evaluate<true>(sortedLabels.subvec(index,
-            sortedLabels.n_elem - 1), numClasses, sortedWeights.subvec(index,
-            sortedLabels.n_elem - 1)) :
-        FitnessFunction::template Evaluate<false>(sortedLabels.subvec(index,
-            sortedLabels.n_elem - 1), numClasses, sortedWeights /* ignored */);
-
-    double gain;
-    if (UseWeights)
     {
-      const double leftWeights = arma::accu(sortedWeights.subvec(0, index - 1));
-      const double rightWeights = arma::accu(sortedWeights.subvec(index,
-          sortedWeights.n_elem - 1));
-      const double fullWeight = leftWeights + rightWeights;
-
-      gain = (leftWeights / fullWeight) * leftGain +
-          (rightWeights / fullWeight) * rightGain;
+      const double weight = UseWeights ? weights[sortedIndices[index]] : 1.0;
+      leftCounts[labels[sortedIndices[index]]] += weight;
+      rightCounts[labels[sortedIndices[index]]] -= weight;
+      leftWeight += weight;
+      rightWeight -= weight;
+      continue;
     }
-    else
-    {
-      // Calculate the fraction of points in the left and right children.
-      const double leftRatio = double(index) / double(sortedLabels.n_elem);
-      const double rightRatio = 1.0 - leftRatio;
 
-      // Calculate the gain at this split point.
-      gain = leftRatio * leftGain + rightRatio * rightGain;
-    }
+    // Calculate the gain for the left and right child from the maintained
+    // class counts.
+    const double leftGain = FitnessFunction::EvaluateCounts(leftCounts,
+        leftWeight);
+    const double rightGain = FitnessFunction::EvaluateCounts(rightCounts,
+        rightWeight);
+
+    const double gain = (leftWeight / totalWeight) * leftGain +
+        (rightWeight / totalWeight) * rightGain;
 
     // Corner case: is this the best possible split?
     if (gain >= 0.0)
@@ -113,6 +117,13 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
       classProbabilities[0] = (data[sortedIndices[index - 1]] +
           data[sortedIndices[index]]) / 2.0;
     }
+
+    // Move the point at `index` into the left child for the next candidate.
+    const double weight = UseWeights ? weights[sortedIndices[index]] : 1.0;
+    leftCounts[labels[sortedIndices[index]]] += weight;
+    rightCounts[labels[sortedIndices[index]]] -= weight;
+    leftWeight += weight;
+    rightWeight -= weight;
   }
 
   return bestFoundGain;
@@ -411,6 +411,27 @@ class DecisionTree :
                                    const size_t numClasses,
                                    const WeightsRowType& weights);
 
+  /**
+   * Classify a contiguous block of points, walking the whole block through
+   * the tree level by level instead of one point at a time, so that each
+   * node's split information is only brought into cache once per block.  The
+   * results are written into the columns [begin, begin + count) of
+   * predictions (and probabilities, if it is not NULL).
+   *
+   * @param data Set of points to classify.
+   * @param begin First column of the block.
+   * @param count Number of columns in the block.
+   * @param predictions Row in which the predictions are stored.
+   * @param probabilities If not NULL, matrix in which the class probabilities
+   *      of every point are stored.
+   */
+  template<typename MatType>
+  void ClassifyBlock(const MatType& data,
+                     const size_t begin,
+                     const size_t count,
+                     arma::Row<size_t>& predictions,
+                     arma::mat* probabilities) const;
+
   /**
    * Corresponding to the public Train() method, this method is designed for
    * avoiding unnecessary copies during training.  This function is called to
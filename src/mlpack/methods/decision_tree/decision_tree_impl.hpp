@@ -908,9 +908,17 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+  // Walk the points through the tree in blocks, in parallel.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for
+  for (omp_size_t block = 0; block < numBlocks; ++block)
+  {
+    const size_t blockBegin = block * blockSize;
+    ClassifyBlock(data, blockBegin,
+        std::min(blockSize, (size_t) data.n_cols - blockBegin), predictions,
+        (arma::mat*) NULL);
+  }
 }
 
 //! Return the class probabilities for a set of points.
@@ -945,10 +953,106 @@ void DecisionTree<FitnessFunction,
     node = &node->Child(0);
   probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Walk the points through the tree in blocks, in parallel.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for
+  for (omp_size_t block = 0; block < numBlocks; ++block)
+  {
+    const size_t blockBegin = block * blockSize;
+    ClassifyBlock(data, blockBegin,
+        std::min(blockSize, (size_t) data.n_cols - blockBegin), predictions,
+        &probabilities);
+  }
+}
+
+//! Classify a block of points level by level.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::ClassifyBlock(
+    const MatType& data,
+    const size_t begin,
+    const size_t count,
+    arma::Row<size_t>& predictions,
+    arma::mat* probabilities) const
+{
+  // The points of the block that reach a given node are kept contiguous in an
+  // index buffer; each stack entry holds a node together with the [begin,
+  // end) range of the buffer that reached it.  This way every node's split
+  // information is loaded once and applied to all of its points, instead of
+  // chasing the child pointers once per point.
+  std::vector<size_t> points(count);
+  for (size_t i = 0; i < count; ++i)
+    points[i] = begin + i;
+  std::vector<size_t> scratch(count);
+
+  std::vector<std::tuple<const DecisionTree*, size_t, size_t> > stack;
+  stack.push_back(std::make_tuple(this, (size_t) 0, count));
+
+  while (!stack.empty())
   {
-    arma::vec v = probabilities.unsafe_col(i); // Alias of column.
-    Classify(data.col(i), predictions[i], v);
+    const DecisionTree* node = std::get<0>(stack.back());
+    const size_t rangeBegin = std::get<1>(stack.back());
+    const size_t rangeEnd = std::get<2>(stack.back());
+    stack.pop_back();
+
+    if (node->children.size() == 0)
+    {
+      // The node is a leaf: store its cached results for every point.
+      for (size_t i = rangeBegin; i < rangeEnd; ++i)
+      {
+        predictions[points[i]] = node->dimensionTypeOrMajorityClass;
+        if (probabilities != NULL)
+          probabilities->col(points[i]) = node->classProbabilities;
+      }
+      continue;
+    }
+
+    // Compute the direction of every point in the range.
+    const size_t numChildren = node->children.size();
+    arma::Row<size_t> directions(rangeEnd - rangeBegin);
+    arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
+    for (size_t i = rangeBegin; i < rangeEnd; ++i)
+    {
+      directions[i - rangeBegin] = node->CalculateDirection(
+          data.col(points[i]));
+      childCounts[directions[i - rangeBegin]]++;
+    }
+
+    // Counting sort the range by direction, so that each child receives a
+    // contiguous range of the index buffer.
+    arma::Row<size_t> childOffsets(numChildren);
+    size_t offset = rangeBegin;
+    for (size_t c = 0; c < numChildren; ++c)
+    {
+      childOffsets[c] = offset;
+      offset += childCounts[c];
+    }
+
+    arma::Row<size_t> childPositions(childOffsets);
+    for (size_t i = rangeBegin; i < rangeEnd; ++i)
+      scratch[childPositions[directions[i - rangeBegin]]++] = points[i];
+    for (size_t i = rangeBegin; i < rangeEnd; ++i)
+      points[i] = scratch[i];
+
+    for (size_t c = 0; c < numChildren; ++c)
+    {
+      if (childCounts[c] > 0)
+      {
+        stack.push_back(std::make_tuple(node->children[c], childOffsets[c],
+            childOffsets[c] + childCounts[c]));
+      }
+    }
   }
 }
 
@@ -0,0 +1,164 @@
+/**
+ * @file histogram_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the histogram-binned binary numeric split.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return bestGain;
+
+  // A dimension holding a single value cannot be split.
+  const double minValue = (double) data.min();
+  const double maxValue = (double) data.max();
+  if (minValue == maxValue)
+    return bestGain;
+
+  const double binWidth = (maxValue - minValue) / (double) numBins;
+
+  // Accumulate the per-bin, per-class counts (or, if weighted, weight sums)
+  // in one pass over the points.  The extreme values of each bin are also
+  // tracked, so that the chosen split point can be placed halfway between the
+  // actual values on either side of the boundary, exactly as
+  // BestBinaryNumericSplit would place it.
+  arma::mat binCounts(numClasses, numBins, arma::fill::zeros);
+  arma::Col<size_t> binSizes(numBins, arma::fill::zeros);
+  arma::Col<ElemType> binMins(numBins);
+  arma::Col<ElemType> binMaxs(numBins);
+  binMins.fill(std::numeric_limits<ElemType>::max());
+  binMaxs.fill(std::numeric_limits<ElemType>::lowest());
+  double totalWeight = 0.0;
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) (((double) data[i] - minValue) / binWidth);
+    if (bin >= numBins)
+      bin = numBins - 1; // The maximum value falls into the last bin.
+
+    const double weight = UseWeights ? weights[i] : 1.0;
+    binCounts(labels[i], bin) += weight;
+    binSizes[bin]++;
+    totalWeight += weight;
+
+    if (data[i] < binMins[bin])
+      binMins[bin] = data[i];
+    if (data[i] > binMaxs[bin])
+      binMaxs[bin] = data[i];
+  }
+
+  // Catch edge case: if there is no weight, there is nothing to split on.
+  if (totalWeight == 0.0)
+    return bestGain;
+
+  // Compute, for each bin, the smallest value held in any later bin; this
+  // gives the right-hand value of each candidate split point.
+  arma::Col<ElemType> suffixMins(numBins);
+  suffixMins[numBins - 1] = binMins[numBins - 1];
+  for (size_t bin = numBins - 1; bin > 0; --bin)
+    suffixMins[bin - 1] = std::min(binMins[bin - 1], suffixMins[bin]);
+
+  // Sweep the bin boundaries, moving one bin of points at a time from the
+  // right child to the left child and updating the class counts
+  // incrementally.  Also, force a minimum leaf size of 1 (empty children
+  // don't make sense).
+  double bestFoundGain = bestGain;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts = arma::sum(binCounts, 1);
+  double leftWeight = 0.0;
+  double rightWeight = totalWeight;
+  size_t leftSize = 0;
+  ElemType leftMax = binMaxs[0]; // Only read once leftSize > 0.
+
+  for (size_t bin = 0; bin < numBins - 1; ++bin)
+  {
+    // Move the bin into the left child.
+    const double binWeight = arma::accu(binCounts.col(bin));
+    leftCounts += binCounts.col(bin);
+    rightCounts -= binCounts.col(bin);
+    leftWeight += binWeight;
+    rightWeight -= binWeight;
+    leftSize += binSizes[bin];
+    if (binSizes[bin] > 0 && binMaxs[bin] > leftMax)
+      leftMax = binMaxs[bin];
+
+    // Enforce the minimum leaf size on both children.
+    if (leftSize < minimum)
+      continue;
+    if (data.n_elem - leftSize < minimum)
+      break;
+
+    // Calculate the gain for the left and right child from the maintained
+    // class counts.
+    const double leftGain = FitnessFunction::EvaluateCounts(leftCounts,
+        leftWeight);
+    const double rightGain = FitnessFunction::EvaluateCounts(rightCounts,
+        rightWeight);
+
+    const double gain = (leftWeight / totalWeight) * leftGain +
+        (rightWeight / totalWeight) * rightGain;
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The actual split value is halfway between the largest
+      // value of the left child and the smallest value of the right child.
+      classProbabilities.set_size(1);
+      classProbabilities[0] = (leftMax + suffixMins[bin + 1]) / 2.0;
+      return gain;
+    }
+    else if (gain > bestFoundGain + minimumGainSplit)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = (leftMax + suffixMins[bin + 1]) / 2.0;
+    }
+  }
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -172,6 +172,34 @@ class InformationGain
     return gain;
   }
 
+  /**
+   * Evaluate the information gain on a set of per-class counts (or, for
+   * weighted data, per-class weight sums).  Split strategies that sweep
+   * candidate split points maintain these counts incrementally and use this
+   * overload to evaluate each candidate in O(numClasses), instead of
+   * re-scanning the labels with Evaluate().
+   *
+   * @param counts Number of points (or total weight) of each class.
+   * @param totalCount Sum of the counts vector.
+   */
+  static double EvaluateCounts(const arma::vec& counts,
+                               const double totalCount)
+  {
+    // Corner case: if there are no elements (or no weight), the gain is zero.
+    if (totalCount == 0.0)
+      return 0.0;
+
+    double gain = 0.0;
+    for (size_t i = 0; i < counts.n_elem; ++i)
+    {
+      const double f = counts[i] / totalCount;
+      if (f > 0.0)
+        gain += f * std::log2(f);
+    }
+
+    return gain;
+  }
+
   /**
    * Return the range of the information gain for the given number of classes.
    * (That is, the difference between the maximum possible value and the minimum
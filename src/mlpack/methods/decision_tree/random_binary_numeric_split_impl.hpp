@@ -0,0 +1,126 @@
+/**
+ * @file random_binary_numeric_split_impl.hpp
+ *
+ * Implementation of the random binary numeric splitter.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double RandomBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return bestGain;
+
+  // Draw the candidate thresholds uniformly from the dimension's range.
+  const ElemType minValue = data.min();
+  const ElemType maxValue = data.max();
+  if (minValue == maxValue)
+    return bestGain; // A constant dimension cannot be split.
+
+  arma::Col<ElemType> thresholds(numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    thresholds[c] = minValue +
+        (ElemType) (math::Random() * (maxValue - minValue));
+  }
+
+  // One unsorted pass over the points accumulates, for every candidate at
+  // once, the per-class weights and sizes of its left child; the right child
+  // follows from the node totals.
+  arma::mat leftCounts(numClasses, numCandidates, arma::fill::zeros);
+  arma::vec leftWeights(numCandidates, arma::fill::zeros);
+  arma::Col<size_t> leftSizes(numCandidates, arma::fill::zeros);
+  arma::vec totalCounts(numClasses, arma::fill::zeros);
+  double totalWeight = 0.0;
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const double weight = UseWeights ? weights[i] : 1.0;
+    totalCounts[labels[i]] += weight;
+    totalWeight += weight;
+
+    for (size_t c = 0; c < numCandidates; ++c)
+    {
+      if (data[i] <= thresholds[c])
+      {
+        leftCounts(labels[i], c) += weight;
+        leftWeights[c] += weight;
+        leftSizes[c]++;
+      }
+    }
+  }
+
+  // Catch edge case: if there is no weight, there is nothing to split on.
+  if (totalWeight == 0.0)
+    return bestGain;
+
+  // Evaluate each candidate from the accumulated counts; force a minimum
+  // leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  double bestFoundGain = bestGain;
+
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    if (leftSizes[c] < minimum || (data.n_elem - leftSizes[c]) < minimum)
+      continue;
+
+    const arma::vec rightCounts = totalCounts - leftCounts.col(c);
+    const double rightWeight = totalWeight - leftWeights[c];
+
+    const double gain =
+        (leftWeights[c] / totalWeight) *
+            FitnessFunction::EvaluateCounts(leftCounts.col(c),
+            leftWeights[c]) +
+        (rightWeight / totalWeight) *
+            FitnessFunction::EvaluateCounts(rightCounts, rightWeight);
+
+    if (gain > bestFoundGain + minimumGainSplit)
+    {
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = thresholds[c];
+    }
+  }
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t RandomBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
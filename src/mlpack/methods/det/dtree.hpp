@@ -334,6 +334,26 @@ class DTree
  private:
   // Utility methods.
 
+  /**
+   * Recursive worker for Grow().  The root call to Grow() opens one OpenMP
+   * parallel region for the whole build; this method spawns tasks for
+   * sizable subtrees, which cover disjoint column ranges of the dataset and
+   * can therefore grow concurrently.
+   */
+  double GrowInternal(MatType& data,
+                      arma::Col<size_t>& oldFromNew,
+                      const bool useVolReg,
+                      const size_t maxLeafSize,
+                      const size_t minLeafSize);
+
+  /**
+   * Recursive worker for PruneAndUpdate(); subtrees are pruned in parallel
+   * tasks within the region opened by the root call.
+   */
+  double PruneAndUpdateInternal(const double oldAlpha,
+                                const size_t points,
+                                const bool useVolReg);
+
   /**
    * Find the dimension to split on.
    */
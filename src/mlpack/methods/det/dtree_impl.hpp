@@ -453,100 +453,104 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
   double minError = logNegError;
   bool splitFound = false;
 
-  // Loop through each dimension.
-#ifdef _WIN32
-  #pragma omp parallel for default(shared)
-  for (intmax_t dim = 0; dim < (intmax_t) maxVals.n_elem; ++dim)
-#else
-  #pragma omp parallel for default(shared)
+  // Loop through each dimension.  Every dimension is scanned in its own
+  // task: inside the parallel region opened by Grow() a nested 'parallel
+  // for' would serialize, but tasks join the enclosing team, so split
+  // finding stays parallel at the top of the tree where only a few subtree
+  // tasks exist yet.
   for (size_t dim = 0; dim < maxVals.n_elem; ++dim)
-#endif
   {
-    const ElemType min = minVals[dim];
-    const ElemType max = maxVals[dim];
-
-    // If there is nothing to split in this dimension, move on.
-    if (max - min == 0.0)
-      continue; // Skip to next dimension.
-
-    // Find the log volume of all the other dimensions.
-    const double volumeWithoutDim = logVolume - std::log(max - min);
-
-    // Initializing all other stuff for this dimension.
-    bool dimSplitFound = false;
-    // Take an error estimate for this dimension.
-    double minDimError = std::pow(points, 2.0) / (max - min);
-    double dimLeftError = 0.0; // For -Wuninitialized.  These variables will
-    double dimRightError = 0.0; // always be set to something else before use.
-    ElemType dimSplitValue = 0.0;
-
-    // Get the values for splitting. The old implementation:
-    //   dimVec = data.row(dim).subvec(start, end - 1);
-    //   dimVec = arma::sort(dimVec);
-    // could be quite inefficient for sparse matrices, due to
-    // copy operations (3). This one has custom implementation for dense and
-    // sparse matrices.
-
-    std::vector<SplitItem> splitVec;
-    details::ExtractSplits<ElemType>(splitVec, data, dim, start, end,
-        minLeafSize);
-
-    // Iterate on all the splits for this dimension
-    for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
-         i != splitVec.end();
-         ++i)
+    #pragma omp task default(shared) firstprivate(dim)
     {
-      const ElemType split = i->first;
-      const size_t position = i->second;
+      const ElemType min = minVals[dim];
+      const ElemType max = maxVals[dim];
 
-      // Another way of picking split is using this:
-      //   split = leftsplit;
-      if ((split - min > 0.0) && (max - split > 0.0))
+      // If there is nothing to split in this dimension, the task is done.
+      if (max - min != 0.0)
       {
-        // Ensure that the right node will have at least the minimum number of
-        // points.
-        Log::Assert((points - position) >= minLeafSize);
-
-        // Now we have to see if the error will be reduced.  Simple manipulation
-        // of the error function gives us the condition we must satisfy:
-        //   |t_l|^2 / V_l + |t_r|^2 / V_r  >= |t|^2 / (V_l + V_r)
-        // and because the volume is only dependent on the dimension we are
-        // splitting, we can assume V_l is just the range of the left and V_r is
-        // just the range of the right.
-        double negLeftError = std::pow(position, 2.0) / (split - min);
-        double negRightError = std::pow(points - position, 2.0) / (max - split);
-
-        // If this is better, take it.
-        if ((negLeftError + negRightError) >= minDimError)
+        // Find the log volume of all the other dimensions.
+        const double volumeWithoutDim = logVolume - std::log(max - min);
+
+        // Initializing all other stuff for this dimension.
+        bool dimSplitFound = false;
+        // Take an error estimate for this dimension.
+        double minDimError = std::pow(points, 2.0) / (max - min);
+        double dimLeftError = 0.0; // For -Wuninitialized.  These variables
+        double dimRightError = 0.0; // will always be set before use.
+        ElemType dimSplitValue = 0.0;
+
+        // Get the values for splitting. The old implementation:
+        //   dimVec = data.row(dim).subvec(start, end - 1);
+        //   dimVec = arma::sort(dimVec);
+        // could be quite inefficient for sparse matrices, due to
+        // copy operations (3). This one has custom implementation for dense
+        // and sparse matrices.
+
+        std::vector<SplitItem> splitVec;
+        details::ExtractSplits<ElemType>(splitVec, data, dim, start, end,
+            minLeafSize);
+
+        // Iterate on all the splits for this dimension
+        for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
+             i != splitVec.end();
+             ++i)
         {
-          minDimError = negLeftError + negRightError;
-          dimLeftError = negLeftError;
-          dimRightError = negRightError;
-          dimSplitValue = split;
-          dimSplitFound = true;
+          const ElemType split = i->first;
+          const size_t position = i->second;
+
+          // Another way of picking split is using this:
+          //   split = leftsplit;
+          if ((split - min > 0.0) && (max - split > 0.0))
+          {
+            // Ensure that the right node will have at least the minimum
+            // number of points.
+            Log::Assert((points - position) >= minLeafSize);
+
+            // Now we have to see if the error will be reduced.  Simple
+            // manipulation of the error function gives us the condition we
+            // must satisfy:
+            //   |t_l|^2 / V_l + |t_r|^2 / V_r  >= |t|^2 / (V_l + V_r)
+            // and because the volume is only dependent on the dimension we
+            // are splitting, we can assume V_l is just the range of the left
+            // and V_r is just the range of the right.
+            double negLeftError = std::pow(position, 2.0) / (split - min);
+            double negRightError = std::pow(points - position, 2.0) /
+                (max - split);
+
+            // If this is better, take it.
+            if ((negLeftError + negRightError) >= minDimError)
+            {
+              minDimError = negLeftError + negRightError;
+              dimLeftError = negLeftError;
+              dimRightError = negRightError;
+              dimSplitValue = split;
+              dimSplitFound = true;
+            }
+          }
         }
-      }
-    }
 
-    const double actualMinDimError = std::log(minDimError)
-      - 2 * std::log((double) data.n_cols)
-      - volumeWithoutDim;
+        const double actualMinDimError = std::log(minDimError)
+          - 2 * std::log((double) data.n_cols)
+          - volumeWithoutDim;
 
-#pragma omp critical(DTreeFindUpdate)
-    if ((actualMinDimError > minError) && dimSplitFound)
-    {
-      // Calculate actual error (in logspace) by adding terms back to our
-      // estimate.
-      minError = actualMinDimError;
-      splitDim = dim;
-      splitValue = dimSplitValue;
-      leftError = std::log(dimLeftError) - 2 * std::log((double) data.n_cols)
-        - volumeWithoutDim;
-      rightError = std::log(dimRightError) - 2 * std::log((double) data.n_cols)
-        - volumeWithoutDim;
-      splitFound = true;
-    } // end if better split found in this dimension.
+        #pragma omp critical(DTreeFindUpdate)
+        if ((actualMinDimError > minError) && dimSplitFound)
+        {
+          // Calculate actual error (in logspace) by adding terms back to our
+          // estimate.
+          minError = actualMinDimError;
+          splitDim = dim;
+          splitValue = dimSplitValue;
+          leftError = std::log(dimLeftError) -
+              2 * std::log((double) data.n_cols) - volumeWithoutDim;
+          rightError = std::log(dimRightError) -
+              2 * std::log((double) data.n_cols) - volumeWithoutDim;
+          splitFound = true;
+        } // end if better split found in this dimension.
+      }
+    }
   }
+  #pragma omp taskwait
 
   return splitFound;
 }
@@ -592,6 +596,25 @@ double DTree<MatType, TagType>::Grow(MatType& data,
                                      const bool useVolReg,
                                      const size_t maxLeafSize,
                                      const size_t minLeafSize)
+{
+  // Open one parallel region for the whole build; GrowInternal() spawns
+  // tasks for sizable subtrees.  If we are already inside a parallel region
+  // (e.g. the cross-validation folds in dt_utils), the nested region is
+  // inactive and this build simply runs serially on the calling thread.
+  double g = 0.0;
+  #pragma omp parallel default(shared)
+  #pragma omp single
+  g = GrowInternal(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+
+  return g;
+}
+
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowInternal(MatType& data,
+                                             arma::Col<size_t>& oldFromNew,
+                                             const bool useVolReg,
+                                             const size_t maxLeafSize,
+                                             const size_t minLeafSize)
 {
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
@@ -633,14 +656,21 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       splitValue = splitValueTmp;
       splitDim = dim;
 
-      // Recursively grow the children.
+      // Recursively grow the children.  They cover disjoint column ranges of
+      // data and oldFromNew, so the two subtrees can be grown concurrently;
+      // a task is only spawned when the left subtree is large enough to be
+      // worth the scheduling overhead, and the right subtree is grown by the
+      // current thread in the meantime.
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      #pragma omp task default(shared) \
+          if ((splitIndex - start) > 8 * maxLeafSize)
+      leftG = left->GrowInternal(data, oldFromNew, useVolReg, maxLeafSize,
+                                 minLeafSize);
+      rightG = right->GrowInternal(data, oldFromNew, useVolReg, maxLeafSize,
+                                   minLeafSize);
+      #pragma omp taskwait
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -739,6 +769,21 @@ template<typename MatType, typename TagType>
 double DTree<MatType, TagType>::PruneAndUpdate(const double oldAlpha,
                                                const size_t points,
                                                const bool useVolReg)
+{
+  // As with Grow(), open one parallel region for the whole pruning pass;
+  // PruneAndUpdateInternal() spawns tasks for sizable subtrees.
+  double alpha = 0.0;
+  #pragma omp parallel default(shared)
+  #pragma omp single
+  alpha = PruneAndUpdateInternal(oldAlpha, points, useVolReg);
+
+  return alpha;
+}
+
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::PruneAndUpdateInternal(const double oldAlpha,
+                                                       const size_t points,
+                                                       const bool useVolReg)
 {
   // Compute gT.
   if (subtreeLeaves == 1) // If we are a leaf...
@@ -756,9 +801,14 @@ double DTree<MatType, TagType>::PruneAndUpdate(const double oldAlpha,
 
     if (gT > oldAlpha)
     {
-      // Go down the tree and update accordingly.  Traverse the children.
-      double leftG = left->PruneAndUpdate(oldAlpha, points, useVolReg);
-      double rightG = right->PruneAndUpdate(oldAlpha, points, useVolReg);
+      // Go down the tree and update accordingly.  The two subtrees are
+      // disjoint, so they can be pruned concurrently; only spawn a task when
+      // the left subtree has enough leaves to be worth it.
+      double leftG = 0.0, rightG = 0.0;
+      #pragma omp task default(shared) if (left->SubtreeLeaves() > 8)
+      leftG = left->PruneAndUpdateInternal(oldAlpha, points, useVolReg);
+      rightG = right->PruneAndUpdateInternal(oldAlpha, points, useVolReg);
+      #pragma omp taskwait
 
       // Update values.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -14,9 +14,41 @@
 
 #include "dtb_rules.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace emst {
 
+//! Collect disjoint subtrees of the given tree that together cover all of its
+//! points, expanding breadth-first until at least the requested number of
+//! roots is available (or no further expansion is possible).  This is used to
+//! hand independent pieces of a dual-tree traversal to different threads.
+template<typename TreeType>
+std::vector<TreeType*> DecomposeTree(TreeType* root, const size_t targetRoots)
+{
+  std::vector<TreeType*> roots;
+  std::queue<TreeType*> queue;
+  queue.push(root);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    // Stop expanding once we have enough pieces; count what is still queued.
+    if (node->NumChildren() == 0 ||
+        (roots.size() + queue.size()) >= targetRoots)
+    {
+      roots.push_back(node);
+      queue.pop();
+      continue;
+    }
+
+    queue.pop();
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      queue.push(&node->Child(i));
+  }
+
+  return roots;
+}
+
 //! Call the tree constructor that does mapping.
 template<typename TreeType, typename MatType>
 TreeType* BuildTree(
@@ -124,21 +156,93 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   totalDist = 0; // Reset distance.
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  size_t cumulativeBaseCases = 0;
+  size_t cumulativeScores = 0;
   while (edges.size() < (data.n_cols - 1))
   {
-    if (naive)
+    // Fully compress the union-find, so that component lookups during the
+    // searches below are single reads and can safely run concurrently.
+    connections.Flatten();
+
+    bool searchDone = false;
+#ifdef HAS_OPENMP
+    if (omp_get_max_threads() > 1)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      // Search for the nearest neighbor of each component in parallel.  Each
+      // thread keeps its own candidate lists (and rule set), which are
+      // min-merged into the global per-component candidates afterwards; the
+      // union-find is only read during the search.
+      std::vector<Tree*> queryRoots;
+      if (!naive)
+        queryRoots = DecomposeTree(tree, 4 * omp_get_max_threads());
+
+      #pragma omp parallel
+      {
+        arma::vec threadDistances(data.n_cols);
+        threadDistances.fill(DBL_MAX);
+        arma::Col<size_t> threadInComponent(data.n_cols);
+        arma::Col<size_t> threadOutComponent(data.n_cols);
+        RuleType threadRules(data, connections, threadDistances,
+            threadInComponent, threadOutComponent, metric);
+
+        if (naive)
+        {
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+            for (size_t j = 0; j < data.n_cols; ++j)
+              threadRules.BaseCase(i, j);
+        }
+        else
+        {
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+          {
+            typename Tree::template DualTreeTraverser<RuleType>
+                traverser(threadRules);
+            traverser.Traverse(*queryRoots[i], *tree);
+          }
+        }
+
+        #pragma omp critical (DTBMerge)
+        {
+          for (size_t c = 0; c < data.n_cols; ++c)
+          {
+            if (threadDistances[c] < neighborsDistances[c])
+            {
+              neighborsDistances[c] = threadDistances[c];
+              neighborsInComponent[c] = threadInComponent[c];
+              neighborsOutComponent[c] = threadOutComponent[c];
+            }
+          }
+
+          cumulativeBaseCases += threadRules.BaseCases();
+          cumulativeScores += threadRules.Scores();
+        }
+      }
+
+      searchDone = true;
     }
-    else
+#endif
+
+    if (!searchDone)
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      RuleType rules(data, connections, neighborsDistances,
+          neighborsInComponent, neighborsOutComponent, metric);
+      if (naive)
+      {
+        // Full O(N^2) traversal.
+        for (size_t i = 0; i < data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            rules.BaseCase(i, j);
+      }
+      else
+      {
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*tree, *tree);
+      }
+
+      cumulativeBaseCases += rules.BaseCases();
+      cumulativeScores += rules.Scores();
     }
 
     AddAllEdges();
@@ -148,8 +252,9 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << cumulativeBaseCases << " cumulative base cases."
+          << std::endl;
+      Log::Info << cumulativeScores << " cumulative node combinations scored."
           << std::endl;
     }
   }
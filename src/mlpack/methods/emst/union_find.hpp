@@ -61,12 +61,28 @@ class UnionFind
     }
     else
     {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      // This ensures that the tree has a small depth.  Only write when the
+      // path is not already compressed, so that Find() performs no writes at
+      // all on a flattened structure (see Flatten()).
+      const size_t root = Find(parent[x]);
+      if (parent[x] != root)
+        parent[x] = root;
+      return root;
     }
   }
 
+  /**
+   * Fully compress all component trees, so that every element points directly
+   * at its root.  After this, Find() performs a single read and no writes
+   * (until the next Union()), which makes it safe to call from many threads
+   * at once.
+   */
+  void Flatten()
+  {
+    for (size_t i = 0; i < parent.n_elem; ++i)
+      parent[i] = Find(i);
+  }
+
   /**
    * Union the components containing x and y.
    *
@@ -248,6 +248,13 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the absolute slack allowed on the max-kernel bound.  A node is pruned
+  //! during tree search when it cannot improve any best candidate kernel value
+  //! by more than this; zero (the default) gives exact search.
+  double Epsilon() const { return epsilon; }
+  //! Modify the absolute slack allowed on the max-kernel bound.
+  double& Epsilon() { return epsilon; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -268,6 +275,9 @@ class FastMKS
   //! If true, naive (brute-force) search is used.
   bool naive;
 
+  //! Absolute slack on the max-kernel bound for approximate search.
+  double epsilon;
+
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
 
@@ -285,6 +295,38 @@ class FastMKS
   //! Use a priority queue to represent the list of candidate points.
   typedef std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp> CandidateList;
+
+  /**
+   * Perform brute-force search of the reference set for the given query set.
+   * The kernel values are evaluated a tile of query and reference points at a
+   * time instead of pairwise; for dense matrices each tile is computed with a
+   * single blocked Gram product, and the (independent) query tiles are
+   * distributed across OpenMP threads.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum kernels to find.
+   * @param indices Matrix to store resulting indices of max-kernel search in.
+   * @param kernels Matrix to store resulting max-kernel values in.
+   * @param sameSet If true, the query set is the reference set, and each point
+   *      is excluded from its own candidate list.
+   */
+  void SearchNaive(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet);
+
+  //! Evaluate one tile of kernel values with the blocked Gram engine, so that
+  //! tile(i, j) = K(queries.col(i), references.col(j)).
+  void KernelTile(const arma::mat& queries,
+                  const arma::mat& references,
+                  arma::mat& tile);
+
+  //! Pairwise fallback for matrix types the Gram engine does not handle.
+  template<typename OtherMatType>
+  void KernelTile(const OtherMatType& queries,
+                  const OtherMatType& references,
+                  arma::mat& tile);
 };
 
 } // namespace fastmks
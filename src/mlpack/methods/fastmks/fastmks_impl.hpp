@@ -18,6 +18,7 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/gram_matrix.hpp>
 
 namespace mlpack {
 namespace fastmks {
@@ -35,7 +36,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const bool singleMode,
     treeOwner(true),
     setOwner(true),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    epsilon(0.0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -58,7 +60,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(
     treeOwner(true),
     setOwner(false),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    epsilon(0.0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -82,6 +85,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const MatType& referenceSet,
     setOwner(false),
     singleMode(singleMode),
     naive(naive),
+    epsilon(0.0),
     metric(kernel)
 {
   Timer::Start("tree_building");
@@ -107,6 +111,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(Tree* referenceTree,
     setOwner(false),
     singleMode(singleMode),
     naive(false),
+    epsilon(0.0),
     metric(referenceTree->Metric())
 {
   // Nothing to do.
@@ -124,6 +129,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const FastMKS& other) :
     setOwner(other.referenceTree == NULL),
     singleMode(other.singleMode),
     naive(other.naive),
+    epsilon(other.epsilon),
     metric(other.metric)
 {
   // Set reference set correctly.
@@ -145,6 +151,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
     setOwner(other.setOwner),
     singleMode(other.singleMode),
     naive(other.naive),
+    epsilon(other.epsilon),
     metric(std::move(other.metric))
 {
   // Clear information from the other.
@@ -189,6 +196,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  epsilon = other.epsilon;
 }
 
 template<typename KernelType,
@@ -304,46 +312,83 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
+    SearchNaive(querySet, k, indices, kernels, false);
+
+    Timer::Stop("computing_products");
+
+    return;
+  }
+
+  // Single-tree implementation.
+  if (singleMode)
+  {
+    typedef FastMKSRules<KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+    // Process the query points in blocks: each thread traverses the tree for
+    // a whole contiguous block of queries with its own rule set, which keeps
+    // the reference nodes that a block touches hot in cache and shares no
+    // traversal state between threads (the per-node last-kernel cache lives
+    // in the rule set, not in the shared reference tree).
+    const size_t queryBlockSize = 64;
+    if (omp_get_max_threads() > 1 && querySet.n_cols >= 2 * queryBlockSize)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+          queryBlockSize;
+      size_t baseCases = 0;
+      size_t scores = 0;
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      #pragma omp parallel
       {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
+        RuleType threadRules(*referenceSet, querySet, k, metric.Kernel(),
+            epsilon);
+        std::vector<size_t> processed;
 
-        if (eval > pqueue.top().first)
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(threadRules);
+          const size_t end = std::min(querySet.n_cols,
+              (block + 1) * queryBlockSize);
+          for (size_t i = block * queryBlockSize; i < end; ++i)
+            traverser.Traverse(i, *referenceTree);
+          processed.push_back((size_t) block);
         }
-      }
 
-      for (size_t j = 1; j <= k; j++)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        arma::Mat<size_t> threadIndices;
+        arma::mat threadKernels;
+        threadRules.GetResults(threadIndices, threadKernels);
+
+        #pragma omp critical (FastMKSMerge)
+        {
+          for (const size_t block : processed)
+          {
+            const size_t end = std::min(querySet.n_cols,
+                (block + 1) * queryBlockSize);
+            for (size_t i = block * queryBlockSize; i < end; ++i)
+            {
+              indices.col(i) = threadIndices.col(i);
+              kernels.col(i) = threadKernels.col(i);
+            }
+          }
+
+          baseCases += threadRules.BaseCases();
+          scores += threadRules.Scores();
+        }
       }
-    }
 
-    Timer::Stop("computing_products");
+      Log::Info << baseCases << " base cases." << std::endl;
+      Log::Info << scores << " scores." << std::endl;
 
-    return;
-  }
+      Timer::Stop("computing_products");
+      return;
+    }
+#endif
 
-  // Single-tree implementation.
-  if (singleMode)
-  {
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
-    typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, querySet, k, metric.Kernel());
+    RuleType rules(*referenceSet, querySet, k, metric.Kernel(), epsilon);
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
@@ -401,7 +446,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
 
   Timer::Start("computing_products");
   typedef FastMKSRules<KernelType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel());
+  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel(),
+      epsilon);
 
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
@@ -433,49 +479,81 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
+    SearchNaive(*referenceSet, k, indices, kernels, true);
+
+    Timer::Stop("computing_products");
+
+    return;
+  }
+
+  // Single-tree implementation.
+  if (singleMode)
+  {
+    typedef FastMKSRules<KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+    // As in the bichromatic overload, blocks of query points are traversed by
+    // threads with their own rule sets.
+    const size_t queryBlockSize = 64;
+    if (omp_get_max_threads() > 1 &&
+        referenceSet->n_cols >= 2 * queryBlockSize)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      const size_t numBlocks = (referenceSet->n_cols + queryBlockSize - 1) /
+          queryBlockSize;
+      size_t baseCases = 0;
+      size_t scores = 0;
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      #pragma omp parallel
       {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
+        RuleType threadRules(*referenceSet, *referenceSet, k, metric.Kernel(),
+            epsilon);
+        std::vector<size_t> processed;
 
-        if (eval > pqueue.top().first)
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(threadRules);
+          const size_t end = std::min(referenceSet->n_cols,
+              (block + 1) * queryBlockSize);
+          for (size_t i = block * queryBlockSize; i < end; ++i)
+            traverser.Traverse(i, *referenceTree);
+          processed.push_back((size_t) block);
         }
-      }
 
-      for (size_t j = 1; j <= k; j++)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        arma::Mat<size_t> threadIndices;
+        arma::mat threadKernels;
+        threadRules.GetResults(threadIndices, threadKernels);
+
+        #pragma omp critical (FastMKSMerge)
+        {
+          for (const size_t block : processed)
+          {
+            const size_t end = std::min(referenceSet->n_cols,
+                (block + 1) * queryBlockSize);
+            for (size_t i = block * queryBlockSize; i < end; ++i)
+            {
+              indices.col(i) = threadIndices.col(i);
+              kernels.col(i) = threadKernels.col(i);
+            }
+          }
+
+          baseCases += threadRules.BaseCases();
+          scores += threadRules.Scores();
+        }
       }
-    }
 
-    Timer::Stop("computing_products");
+      Log::Info << baseCases << " base cases." << std::endl;
+      Log::Info << scores << " scores." << std::endl;
 
-    return;
-  }
+      Timer::Stop("computing_products");
+      return;
+    }
+#endif
 
-  // Single-tree implementation.
-  if (singleMode)
-  {
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
-    typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel());
+    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel(), epsilon);
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
@@ -502,6 +580,119 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   Search(referenceTree, k, indices, kernels);
 }
 
+//! Brute-force search, evaluated a tile of points at a time.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::SearchNaive(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  // Number of points on each side of a tile; a pair of double-precision tiles
+  // in reasonable dimensionality fits comfortably in L2 cache.
+  const size_t tileSize = 64;
+
+  // Query tiles are independent, so they are distributed across threads; each
+  // tile of kernel values is computed in one batch (a single Gram product, for
+  // dense matrices) instead of with pairwise Evaluate() calls.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t qTileStart = 0; qTileStart < (omp_size_t) querySet.n_cols;
+      qTileStart += tileSize)
+  {
+    const size_t qStart = (size_t) qTileStart;
+    const size_t qEnd = std::min(querySet.n_cols, qStart + tileSize);
+
+    // One candidate heap per query point in the tile.
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues;
+    pqueues.reserve(qEnd - qStart);
+    for (size_t q = qStart; q < qEnd; ++q)
+    {
+      std::vector<Candidate> cList(k, def);
+      pqueues.emplace_back(CandidateCmp(), std::move(cList));
+    }
+
+    const MatType qTile(querySet.cols(qStart, qEnd - 1));
+
+    arma::mat tile;
+    for (size_t rStart = 0; rStart < referenceSet->n_cols; rStart += tileSize)
+    {
+      const size_t rEnd = std::min(referenceSet->n_cols, rStart + tileSize);
+      const MatType rTile(referenceSet->cols(rStart, rEnd - 1));
+
+      KernelTile(qTile, rTile, tile);
+
+      for (size_t q = qStart; q < qEnd; ++q)
+      {
+        CandidateList& pqueue = pqueues[q - qStart];
+        for (size_t r = rStart; r < rEnd; ++r)
+        {
+          if (sameSet && q == r)
+            continue; // Don't return the point as its own candidate.
+
+          const double eval = tile(q - qStart, r - rStart);
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+      }
+    }
+
+    for (size_t q = qStart; q < qEnd; ++q)
+    {
+      CandidateList& pqueue = pqueues[q - qStart];
+      for (size_t j = 1; j <= k; j++)
+      {
+        indices(k - j, q) = pqueue.top().second;
+        kernels(k - j, q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+//! Evaluate one tile of kernel values with the blocked Gram engine.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::KernelTile(
+    const arma::mat& queries,
+    const arma::mat& references,
+    arma::mat& tile)
+{
+  kernel::GramMatrix<KernelType>::Compute(queries, references, tile,
+      metric.Kernel());
+}
+
+//! Pairwise fallback for matrix types the Gram engine does not handle.
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename OtherMatType>
+void FastMKS<KernelType, MatType, TreeType>::KernelTile(
+    const OtherMatType& queries,
+    const OtherMatType& references,
+    arma::mat& tile)
+{
+  tile.set_size(queries.n_cols, references.n_cols);
+  for (size_t j = 0; j < references.n_cols; ++j)
+    for (size_t i = 0; i < queries.n_cols; ++i)
+      tile(i, j) = metric.Kernel().Evaluate(queries.col(i),
+                                            references.col(j));
+}
+
 //! Serialize the model.
 template<typename KernelType,
          typename MatType,
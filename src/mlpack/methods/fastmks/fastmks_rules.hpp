@@ -17,6 +17,7 @@
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 #include <boost/heap/priority_queue.hpp>
+#include <unordered_map>
 
 namespace mlpack {
 namespace fastmks {
@@ -42,11 +43,15 @@ class FastMKSRules
    * @param querySet Set of query data.
    * @param k Number of candidates to search for.
    * @param kernel Kernel to run FastMKS with.
+   * @param epsilon Allowed absolute slack on the max-kernel bound: a node is
+   *      pruned when it cannot improve the best candidate kernel value by more
+   *      than epsilon.  Zero (the default) gives exact search.
    */
   FastMKSRules(const typename TreeType::Mat& referenceSet,
                const typename TreeType::Mat& querySet,
                const size_t k,
-               KernelType& kernel);
+               KernelType& kernel,
+               const double epsilon = 0.0);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -154,6 +159,9 @@ class FastMKSRules
   //! Number of points to search for.
   const size_t k;
 
+  //! Absolute slack on the max-kernel bound for approximate search.
+  const double epsilon;
+
   //! Cached query set self-kernels (|| q || for each q).
   arma::vec queryKernels;
   //! Cached reference set self-kernels (|| r || for each r).
@@ -169,6 +177,13 @@ class FastMKSRules
   //! The last kernel evaluation resulting from BaseCase().
   double lastKernel;
 
+  //! The last kernel evaluation of each reference node during single-tree
+  //! traversals.  This is per-traversal scratch, so it lives here and not in
+  //! the node statistic: the reference tree may be traversed concurrently by
+  //! several threads, each with its own rule set.  Nodes not yet visited
+  //! read as 0.0 (the same initial value the statistic used to hold).
+  std::unordered_map<const TreeType*, double> nodeLastKernels;
+
   //! Calculate the bound for a given query node.
   double CalculateBound(TreeType& queryNode) const;
 
@@ -23,10 +23,12 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
-    KernelType& kernel) :
+    KernelType& kernel,
+    const double epsilon) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
+    epsilon(epsilon),
     kernel(kernel),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
@@ -138,7 +140,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     double maxKernelBound;
     const double parentDist = referenceNode.ParentDistance();
     const double combinedDistBound = parentDist + furthestDist;
-    const double lastKernel = referenceNode.Parent()->Stat().LastKernel();
+    const double lastKernel = nodeLastKernels[referenceNode.Parent()];
     if (kernel::KernelTraits<KernelType>::IsNormalized)
     {
       const double squaredDist = std::pow(combinedDistBound, 2.0);
@@ -160,7 +162,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
           combinedDistBound * queryKernels[queryIndex];
     }
 
-    if (maxKernelBound < bestKernel)
+    if (maxKernelBound < bestKernel + epsilon)
       return DBL_MAX;
   }
 
@@ -175,7 +177,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
         referenceNode.Parent() != NULL &&
         referenceNode.Point(0) == referenceNode.Parent()->Point(0))
     {
-      kernelEval = referenceNode.Parent()->Stat().LastKernel();
+      kernelEval = nodeLastKernels[referenceNode.Parent()];
     }
     else
     {
@@ -190,7 +192,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     kernelEval = kernel.Evaluate(querySet.col(queryIndex), refCenter);
   }
 
-  referenceNode.Stat().LastKernel() = kernelEval;
+  nodeLastKernels[&referenceNode] = kernelEval;
 
   double maxKernel;
   if (kernel::KernelTraits<KernelType>::IsNormalized)
@@ -215,7 +217,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
 
   // We return the inverse of the maximum kernel so that larger kernels are
   // recursed into first.
-  return (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX;
+  return (maxKernel >= bestKernel + epsilon) ? (1.0 / maxKernel) : DBL_MAX;
 }
 
 template<typename KernelType, typename TreeType>
@@ -311,7 +313,7 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
   // Now add the dual term.
   adjustedScore += (dualQueryTerm * dualRefTerm);
 
-  if (adjustedScore < bestKernel)
+  if (adjustedScore < bestKernel + epsilon)
   {
     // It is not possible that this node combination can contain a point
     // combination with kernel value better than the minimum kernel value to
@@ -404,7 +406,7 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
 
   // We return the inverse of the maximum kernel so that larger kernels are
   // recursed into first.
-  return (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX;
+  return (maxKernel >= bestKernel + epsilon) ? (1.0 / maxKernel) : DBL_MAX;
 }
 
 template<typename KernelType, typename TreeType>
@@ -414,7 +416,7 @@ double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
 {
   const double bestKernel = candidates[queryIndex].top().first;
 
-  return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
+  return ((1.0 / oldScore) >= bestKernel + epsilon) ? oldScore : DBL_MAX;
 }
 
 template<typename KernelType, typename TreeType>
@@ -425,7 +427,7 @@ double FastMKSRules<KernelType, TreeType>::Rescore(TreeType& queryNode,
   queryNode.Stat().Bound() = CalculateBound(queryNode);
   const double bestKernel = queryNode.Stat().Bound();
 
-  return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
+  return ((1.0 / oldScore) >= bestKernel + epsilon) ? oldScore : DBL_MAX;
 }
 
 /**
@@ -30,6 +30,13 @@ class DiagonalConstraint
     covariance = arma::diagmat(arma::clamp(covariance.diag(), 1e-10, DBL_MAX));
   }
 
+  //! Constrain a diagonal covariance, given as the vector of per-dimension
+  //! variances; it is already diagonal, so only clamp the variances.
+  static void ApplyConstraint(arma::vec& diagCovariance)
+  {
+    diagCovariance = arma::clamp(diagCovariance, 1e-10, DBL_MAX);
+  }
+
   //! Serialize the constraint (which holds nothing, so, nothing to do).
   template<typename Archive>
   static void serialize(Archive& /* ar */, const unsigned int /* version */) { }
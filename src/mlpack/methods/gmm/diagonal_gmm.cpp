@@ -0,0 +1,175 @@
+/**
+ * @file diagonal_gmm.cpp
+ *
+ * Implementation of non-template DiagonalGMM methods.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "diagonal_gmm.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * Create a DiagonalGMM with the given number of Gaussians, each of which have
+ * the specified dimensionality.  The means will be set to 0 and the variances
+ * to 1.
+ *
+ * @param gaussians Number of Gaussians in this DiagonalGMM.
+ * @param dimensionality Dimensionality of each Gaussian.
+ */
+DiagonalGMM::DiagonalGMM(const size_t gaussians, const size_t dimensionality) :
+    gaussians(gaussians),
+    dimensionality(dimensionality),
+    dists(gaussians,
+        distribution::DiagonalGaussianDistribution(dimensionality)),
+    weights(gaussians)
+{
+  // Set equal weights.  Technically this model is still valid, but only
+  // barely.
+  weights.fill(1.0 / gaussians);
+}
+
+/**
+ * Return the log probability of the given observation being from this
+ * DiagonalGMM.
+ */
+double DiagonalGMM::LogProbability(const arma::vec& observation) const
+{
+  // Sum the probability for each Gaussian in our mixture (and we have to
+  // multiply by the prior for each Gaussian too).
+  arma::vec logProbs(gaussians);
+  for (size_t i = 0; i < gaussians; i++)
+    logProbs[i] = log(weights[i]) + dists[i].LogProbability(observation);
+
+  return math::AccuLog(logProbs);
+}
+
+/**
+ * Return the probability of the given observation being from this
+ * DiagonalGMM.
+ */
+double DiagonalGMM::Probability(const arma::vec& observation) const
+{
+  return exp(LogProbability(observation));
+}
+
+/**
+ * Return the log probability of the given observation being from the given
+ * component in the mixture.
+ */
+double DiagonalGMM::LogProbability(const arma::vec& observation,
+                                   const size_t component) const
+{
+  // We are only considering one Gaussian component -- so we only need to call
+  // Probability() once.  We do consider the prior probability!
+  return log(weights[component]) +
+      dists[component].LogProbability(observation);
+}
+
+/**
+ * Return the probability of the given observation being from the given
+ * component in the mixture.
+ */
+double DiagonalGMM::Probability(const arma::vec& observation,
+                                const size_t component) const
+{
+  return exp(LogProbability(observation, component));
+}
+
+/**
+ * Compute the log probability of each observation under each component,
+ * including the component's log-weight.
+ */
+void DiagonalGMM::LogProbability(const arma::mat& observations,
+                                 arma::mat& logProbs) const
+{
+  logProbs.set_size(gaussians, observations.n_cols);
+
+  // The components are independent, and each one writes only its own row of
+  // the output.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; ++i)
+  {
+    arma::vec phis;
+    dists[i].LogProbability(observations, phis);
+    logProbs.row(i) = log(weights[i]) + trans(phis);
+  }
+}
+
+/**
+ * Return a randomly generated observation according to the probability
+ * distribution defined by this object.
+ */
+arma::vec DiagonalGMM::Random() const
+{
+  // Determine which Gaussian it will be coming from.
+  double gaussRand = math::Random();
+  size_t gaussian = 0;
+
+  double sumProb = 0;
+  for (size_t g = 0; g < gaussians; g++)
+  {
+    sumProb += weights(g);
+    if (gaussRand <= sumProb)
+    {
+      gaussian = g;
+      break;
+    }
+  }
+
+  return arma::sqrt(dists[gaussian].Covariance()) %
+      arma::randn<arma::vec>(dimensionality) + dists[gaussian].Mean();
+}
+
+/**
+ * Classify the given observations as being from an individual component in
+ * this DiagonalGMM.
+ */
+void DiagonalGMM::Classify(const arma::mat& observations,
+                           arma::Row<size_t>& labels) const
+{
+  // Evaluate all components over all points in one batched call, then pick
+  // the best component for each point.
+  arma::mat logProbs;
+  LogProbability(observations, logProbs);
+
+  labels.set_size(observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    arma::uword maxComponent = 0;
+    logProbs.col(i).max(maxComponent);
+    labels[i] = (size_t) maxComponent;
+  }
+}
+
+/**
+ * Get the log-likelihood of this data's fit to the model.
+ */
+double DiagonalGMM::LogLikelihood(
+    const arma::mat& data,
+    const std::vector<distribution::DiagonalGaussianDistribution>& distsL,
+    const arma::vec& weightsL) const
+{
+  arma::mat likelihoods(gaussians, data.n_cols);
+
+  // The components are independent, and each one writes only its own row.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; i++)
+  {
+    arma::vec phis;
+    distsL[i].Probability(data, phis);
+    likelihoods.row(i) = weightsL(i) * trans(phis);
+  }
+
+  // Now sum over every point, with one vectorized log over the per-point
+  // mixture likelihoods.
+  return accu(log(arma::sum(likelihoods, 0)));
+}
+
+} // namespace gmm
+} // namespace mlpack
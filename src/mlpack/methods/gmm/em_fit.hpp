@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/dists/gaussian_distribution.hpp>
+#include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
 
 // Default clustering mechanism.
 #include <mlpack/methods/kmeans/kmeans.hpp>
@@ -37,9 +38,16 @@ namespace gmm {
  *
  * This method should create 'clusters' clusters, and return the assignment of
  * each point to a cluster.
+ *
+ * The Distribution template parameter selects the component type:
+ * distribution::GaussianDistribution (the default) fits full covariances,
+ * while distribution::DiagonalGaussianDistribution fits per-dimension
+ * variances only, with an M-step made of dense elementwise operations and no
+ * factorizations or solves.
  */
 template<typename InitialClusteringType = kmeans::KMeans<>,
-         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
+         typename Distribution = distribution::GaussianDistribution>
 class EMFit
 {
  public:
@@ -80,7 +88,7 @@ class EMFit
    *      clustering.
    */
   void Estimate(const arma::mat& observations,
-                std::vector<distribution::GaussianDistribution>& dists,
+                std::vector<Distribution>& dists,
                 arma::vec& weights,
                 const bool useInitialModel = false);
 
@@ -103,7 +111,7 @@ class EMFit
    */
   void Estimate(const arma::mat& observations,
                 const arma::vec& probabilities,
-                std::vector<distribution::GaussianDistribution>& dists,
+                std::vector<Distribution>& dists,
                 arma::vec& weights,
                 const bool useInitialModel = false);
 
@@ -143,9 +151,65 @@ class EMFit
    * @param weights Vector to store a priori weights in.
    */
   void InitialClustering(const arma::mat& observations,
-                         std::vector<distribution::GaussianDistribution>& dists,
+                         std::vector<Distribution>& dists,
                          arma::vec& weights);
 
+  /**
+   * Perform the M-step covariance update of a single full-covariance
+   * component: accumulate the weighted scatter matrix over blocks of points,
+   * apply the covariance constraint, and store the result in the component.
+   *
+   * @param observations List of observations.
+   * @param pointProbs Weight of each observation for this component.
+   * @param probSum Sum of the weights.
+   * @param dist Component to update (its mean must already be updated).
+   */
+  void UpdateCovariance(const arma::mat& observations,
+                        const arma::vec& pointProbs,
+                        const double probSum,
+                        distribution::GaussianDistribution& dist);
+
+  /**
+   * Perform the M-step covariance update of a single diagonal component: the
+   * per-dimension variances fall out of matrix-vector products over the
+   * squared centered observations, with no factorizations or solves.
+   *
+   * @param observations List of observations.
+   * @param pointProbs Weight of each observation for this component.
+   * @param probSum Sum of the weights.
+   * @param dist Component to update (its mean must already be updated).
+   */
+  void UpdateCovariance(const arma::mat& observations,
+                        const arma::vec& pointProbs,
+                        const double probSum,
+                        distribution::DiagonalGaussianDistribution& dist);
+
+  /**
+   * Store a scatter matrix accumulated by InitialClustering() into a
+   * component, applying the covariance constraint.  The diagonal overload
+   * keeps only the per-dimension variances.
+   */
+  void ApplyClusterCovariance(arma::mat&& covariance,
+                              distribution::GaussianDistribution& dist);
+  void ApplyClusterCovariance(arma::mat&& covariance,
+                              distribution::DiagonalGaussianDistribution& dist);
+
+  /**
+   * Map between the Armadillo gmm_diag covariance representation (a column of
+   * variances) and the covariance type of the distribution.
+   */
+  static arma::vec GetDiagonal(const distribution::GaussianDistribution& dist)
+  { return dist.Covariance().diag(); }
+  static const arma::vec& GetDiagonal(
+      const distribution::DiagonalGaussianDistribution& dist)
+  { return dist.Covariance(); }
+  static void SetDiagonal(const arma::vec& diagonal,
+                          distribution::GaussianDistribution& dist)
+  { dist.Covariance(arma::diagmat(diagonal)); }
+  static void SetDiagonal(const arma::vec& diagonal,
+                          distribution::DiagonalGaussianDistribution& dist)
+  { dist.Covariance(diagonal); }
+
   /**
    * Calculate the log-likelihood of a model.  Yes, this is reimplemented in the
    * GMM code.  Intuition suggests that the log-likelihood is not the best way
@@ -157,8 +221,7 @@ class EMFit
    * @param weights Vector of a priori weights.
    */
   double LogLikelihood(const arma::mat& data,
-                       const std::vector<distribution::GaussianDistribution>&
-                           dists,
+                       const std::vector<Distribution>& dists,
                        const arma::vec& weights) const;
 
   // Armadillo uses uword internally as an OpenMP index type, which crashes
@@ -176,7 +239,7 @@ class EMFit
    */
   void ArmadilloGMMWrapper(
       const arma::mat& observations,
-      std::vector<distribution::GaussianDistribution>& dists,
+      std::vector<Distribution>& dists,
       arma::vec& weights,
       const bool useInitialModel);
   #endif
@@ -21,8 +21,11 @@ namespace mlpack {
 namespace gmm {
 
 //! Constructor.
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-EMFit<InitialClusteringType, CovarianceConstraintPolicy>::EMFit(
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+EMFit(
     const size_t maxIterations,
     const double tolerance,
     InitialClusteringType clusterer,
@@ -33,10 +36,13 @@ EMFit<InitialClusteringType, CovarianceConstraintPolicy>::EMFit(
     constraint(constraint)
 { /* Nothing to do. */ }
 
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Estimate(
     const arma::mat& observations,
-    std::vector<distribution::GaussianDistribution>& dists,
+    std::vector<Distribution>& dists,
     arma::vec& weights,
     const bool useInitialModel)
 {
@@ -71,8 +77,11 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); i++)
+    // Gaussian given the observations and the present theta value.  Each
+    // component is independent, so compute them in parallel; each writes only
+    // its own column of condProb.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); i++)
     {
       // Store conditional probabilities into condProb vector for each
       // Gaussian.  First we make an alias of the condProb vector.
@@ -82,7 +91,8 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condProb.n_rows; i++)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condProb.n_rows; i++)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -94,29 +104,19 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums = trans(arma::sum(condProb, 0 /* columnwise */));
 
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); i++)
+    // Calculate the new values of the means and covariances using the updated
+    // conditional probabilities.  The components are updated in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); i++)
     {
       // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != 0)
-        dists[i].Mean() = (observations * condProb.col(i)) / probRowSums[i];
+      if (probRowSums[i] == 0.0)
+        continue;
 
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations - (dists[i].Mean() *
-          arma::ones<arma::rowvec>(observations.n_cols));
-      arma::mat tmpB = tmp % (arma::ones<arma::vec>(observations.n_rows) *
-          trans(condProb.col(i)));
+      dists[i].Mean() = (observations * condProb.col(i)) / probRowSums[i];
 
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != 0.0)
-      {
-        arma::mat covariance = (tmp * trans(tmpB)) / probRowSums[i];
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
+      UpdateCovariance(observations, condProb.col(i), probRowSums[i],
+          dists[i]);
     }
 
     // Calculate the new values for omega using the updated conditional
@@ -131,11 +131,14 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
   }
 }
 
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Estimate(
     const arma::mat& observations,
     const arma::vec& probabilities,
-    std::vector<distribution::GaussianDistribution>& dists,
+    std::vector<Distribution>& dists,
     arma::vec& weights,
     const bool useInitialModel)
 {
@@ -155,8 +158,11 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); i++)
+    // Gaussian given the observations and the present theta value.  Each
+    // component is independent, so compute them in parallel; each writes only
+    // its own column of condProb.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); i++)
     {
       // Store conditional probabilities into condProb vector for each
       // Gaussian.  First we make an alias of the condProb vector.
@@ -166,7 +172,8 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condProb.n_rows; i++)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condProb.n_rows; i++)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -179,32 +186,21 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
     // observations.
     arma::vec probRowSums(dists.size());
 
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); i++)
+    // Calculate the new values of the means and covariances using the updated
+    // conditional probabilities.  The components are updated in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); i++)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
       // multiplied by the probability of the point being from this mixture
       // model.
-      probRowSums[i] = accu(condProb.col(i) % probabilities);
-
-      dists[i].Mean() = (observations * (condProb.col(i) % probabilities)) /
-        probRowSums[i];
+      const arma::vec pointProbs = condProb.col(i) % probabilities;
+      probRowSums[i] = accu(pointProbs);
 
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations - (dists[i].Mean() *
-          arma::ones<arma::rowvec>(observations.n_cols));
-      arma::mat tmpB = tmp % (arma::ones<arma::vec>(observations.n_rows) *
-          trans(condProb.col(i) % probabilities));
+      dists[i].Mean() = (observations * pointProbs) / probRowSums[i];
 
-      arma::mat cov = (tmp * trans(tmpB)) / probRowSums[i];
-
-      // Apply covariance constraint.
-      constraint.ApplyConstraint(cov);
-
-      dists[i].Covariance(std::move(cov));
+      UpdateCovariance(observations, pointProbs, probRowSums[i], dists[i]);
     }
 
     // Calculate the new values for omega using the updated conditional
@@ -219,10 +215,12 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
   }
 }
 
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
 InitialClustering(const arma::mat& observations,
-                  std::vector<distribution::GaussianDistribution>& dists,
+                  std::vector<Distribution>& dists,
                   arma::vec& weights)
 {
   // Assignments from clustering.
@@ -239,8 +237,7 @@ InitialClustering(const arma::mat& observations,
   for (size_t i = 0; i < dists.size(); ++i)
   {
     means[i].zeros(dists[i].Mean().n_elem);
-    covs[i].zeros(dists[i].Covariance().n_rows,
-                  dists[i].Covariance().n_cols);
+    covs[i].zeros(dists[i].Mean().n_elem, dists[i].Mean().n_elem);
   }
 
   // From the assignments, generate our means, covariances, and weights.
@@ -275,48 +272,148 @@ InitialClustering(const arma::mat& observations,
   {
     covs[i] /= (weights[i] > 1) ? weights[i] : 1;
 
-    // Apply constraints to covariance matrix.
-    constraint.ApplyConstraint(covs[i]);
-
     std::swap(dists[i].Mean(), means[i]);
-    dists[i].Covariance(std::move(covs[i]));
+
+    // Apply constraints to the covariance and store it in the component; for
+    // diagonal components only the per-dimension variances are kept.
+    ApplyClusterCovariance(std::move(covs[i]), dists[i]);
   }
 
   // Finally, normalize weights.
   weights /= accu(weights);
 }
 
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-double EMFit<InitialClusteringType, CovarianceConstraintPolicy>::LogLikelihood(
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+UpdateCovariance(const arma::mat& observations,
+                 const arma::vec& pointProbs,
+                 const double probSum,
+                 distribution::GaussianDistribution& dist)
+{
+  // Accumulate the weighted scatter matrix over blocks of points so that the
+  // centered temporaries stay cache-sized no matter how many points there
+  // are.
+  const size_t blockSize = 4096;
+  arma::mat covariance(observations.n_rows, observations.n_rows,
+      arma::fill::zeros);
+  for (size_t begin = 0; begin < observations.n_cols; begin += blockSize)
+  {
+    const size_t last = std::min(begin + blockSize,
+        (size_t) observations.n_cols) - 1;
+
+    arma::mat tmp = observations.cols(begin, last);
+    tmp.each_col() -= dist.Mean();
+    arma::mat tmpB = tmp;
+    tmpB.each_row() %= trans(pointProbs.subvec(begin, last));
+
+    covariance += tmp * trans(tmpB);
+  }
+  covariance /= probSum;
+
+  // Apply covariance constraint.
+  constraint.ApplyConstraint(covariance);
+  dist.Covariance(std::move(covariance));
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+UpdateCovariance(const arma::mat& observations,
+                 const arma::vec& pointProbs,
+                 const double probSum,
+                 distribution::DiagonalGaussianDistribution& dist)
+{
+  // The per-dimension variances are just the weighted sums of the squared
+  // centered observations: one elementwise square and one matrix-vector
+  // product per block, no scatter matrix and no factorization.
+  const size_t blockSize = 4096;
+  arma::vec covariance(observations.n_rows, arma::fill::zeros);
+  for (size_t begin = 0; begin < observations.n_cols; begin += blockSize)
+  {
+    const size_t last = std::min(begin + blockSize,
+        (size_t) observations.n_cols) - 1;
+
+    arma::mat tmp = observations.cols(begin, last);
+    tmp.each_col() -= dist.Mean();
+
+    covariance += arma::square(tmp) * pointProbs.subvec(begin, last);
+  }
+  covariance /= probSum;
+
+  // Apply covariance constraint.
+  constraint.ApplyConstraint(covariance);
+  dist.Covariance(std::move(covariance));
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+ApplyClusterCovariance(arma::mat&& covariance,
+                       distribution::GaussianDistribution& dist)
+{
+  constraint.ApplyConstraint(covariance);
+  dist.Covariance(std::move(covariance));
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+ApplyClusterCovariance(arma::mat&& covariance,
+                       distribution::DiagonalGaussianDistribution& dist)
+{
+  arma::vec diagonal = covariance.diag();
+  constraint.ApplyConstraint(diagonal);
+  dist.Covariance(std::move(diagonal));
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+LogLikelihood(
     const arma::mat& observations,
-    const std::vector<distribution::GaussianDistribution>& dists,
+    const std::vector<Distribution>& dists,
     const arma::vec& weights) const
 {
   double logLikelihood = 0;
 
-  arma::vec phis;
   arma::mat likelihoods(dists.size(), observations.n_cols);
 
-  for (size_t i = 0; i < dists.size(); ++i)
+  // The likelihoods of each component are independent, so compute them in
+  // parallel; each component writes only its own row.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
+    arma::vec phis;
     dists[i].Probability(observations, phis);
     likelihoods.row(i) = weights(i) * trans(phis);
   }
+
   // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
+  const arma::rowvec pointLikelihoods = arma::sum(likelihoods, 0);
+  #pragma omp parallel for reduction(+ : logLikelihood)
+  for (omp_size_t j = 0; j < (omp_size_t) observations.n_cols; ++j)
   {
-    if (accu(likelihoods.col(j)) == 0)
+    if (pointLikelihoods(j) == 0)
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
-    logLikelihood += log(accu(likelihoods.col(j)));
+    logLikelihood += log(pointLikelihoods(j));
   }
 
   return logLikelihood;
 }
 
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
 template<typename Archive>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::serialize(
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+serialize(
     Archive& ar,
     const unsigned int /* version */)
 {
@@ -329,10 +426,12 @@ void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::serialize(
 // Armadillo uses uword internally as an OpenMP index type, which crashes Visual
 // Studio.
 #ifndef _WIN32
-template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
-void EMFit<InitialClusteringType, CovarianceConstraintPolicy>::
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
 ArmadilloGMMWrapper(const arma::mat& observations,
-                    std::vector<distribution::GaussianDistribution>& dists,
+                    std::vector<Distribution>& dists,
                     arma::vec& weights,
                     const bool useInitialModel)
 {
@@ -361,7 +460,7 @@ ArmadilloGMMWrapper(const arma::mat& observations,
     for (size_t i = 0; i < dists.size(); ++i)
     {
       means.col(i) = dists[i].Mean();
-      covs.col(i) = dists[i].Covariance().diag();
+      covs.col(i) = GetDiagonal(dists[i]);
     }
 
     g.reset(observations.n_rows, dists.size());
@@ -383,7 +482,7 @@ ArmadilloGMMWrapper(const arma::mat& observations,
   for (size_t i = 0; i < dists.size(); ++i)
   {
     dists[i].Mean() = g.means.col(i);
-    dists[i].Covariance(arma::diagmat(g.dcovs.col(i)));
+    SetDiagonal(g.dcovs.col(i), dists[i]);
   }
 }
 #endif
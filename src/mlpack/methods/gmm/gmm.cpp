@@ -58,12 +58,11 @@ double GMM::LogProbability(const arma::vec& observation) const
 {
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
-  double sum = -std::numeric_limits<double>::infinity();
+  arma::vec logProbs(gaussians);
   for (size_t i = 0; i < gaussians; i++)
-    sum = math::LogAdd(sum, log(weights[i]) +
-        dists[i].LogProbability(observation));
+    logProbs[i] = log(weights[i]) + dists[i].LogProbability(observation);
 
-  return sum;
+  return math::AccuLog(logProbs);
 }
 
 /**
@@ -96,6 +95,26 @@ double GMM::Probability(const arma::vec& observation,
   return exp(LogProbability(observation, component));
 }
 
+/**
+ * Compute the log probability of each observation under each component,
+ * including the component's log-weight.
+ */
+void GMM::LogProbability(const arma::mat& observations,
+                         arma::mat& logProbs) const
+{
+  logProbs.set_size(gaussians, observations.n_cols);
+
+  // The components are independent, and each one writes only its own row of
+  // the output.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; ++i)
+  {
+    arma::vec phis;
+    dists[i].LogProbability(observations, phis);
+    logProbs.row(i) = log(weights[i]) + trans(phis);
+  }
+}
+
 /**
  * Return a randomly generated observation according to the probability
  * distribution defined by this object.
@@ -157,20 +176,20 @@ double GMM::LogLikelihood(
     const std::vector<distribution::GaussianDistribution>& distsL,
     const arma::vec& weightsL) const
 {
-  double loglikelihood = 0;
-  arma::vec phis;
   arma::mat likelihoods(gaussians, data.n_cols);
 
-  for (size_t i = 0; i < gaussians; i++)
+  // The components are independent, and each one writes only its own row.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; i++)
   {
+    arma::vec phis;
     distsL[i].Probability(data, phis);
     likelihoods.row(i) = weightsL(i) * trans(phis);
   }
 
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; j++)
-    loglikelihood += log(accu(likelihoods.col(j)));
-  return loglikelihood;
+  // Now sum over every point, with one vectorized log over the per-point
+  // mixture likelihoods.
+  return accu(log(arma::sum(likelihoods, 0)));
 }
 
 } // namespace gmm
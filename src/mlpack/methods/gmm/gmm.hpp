@@ -191,6 +191,22 @@ class GMM
    */
   double LogProbability(const arma::vec& observation,
                         const size_t component) const;
+
+  /**
+   * Compute the log probability of each observation under each Gaussian
+   * component, including the component's log-weight.  The output matrix has
+   * one row per component and one column per observation, so normalizing each
+   * column (with, e.g., math::LogAdd()) gives the responsibilities of the
+   * components for that point.  Each component is evaluated with a single
+   * batched call over all observations.
+   *
+   * @param observations Observations to evaluate the probability of.
+   * @param logProbs Output matrix of log probabilities (gaussians rows,
+   *     one column per observation).
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::mat& logProbs) const;
+
   /**
    * Return a randomly generated observation according to the probability
    * distribution defined by this object.
@@ -53,44 +53,49 @@ double GMM::Train(const arma::mat& observations,
       weightsOrig = weights;
     }
 
-    // We need to keep temporary copies.  We'll do the first training into the
-    // actual model position, so that if it's the best we don't need to copy it.
-    fitter.Estimate(observations, dists, weights, useExistingModel);
-
-    bestLikelihood = LogLikelihood(observations, dists, weights);
+    bestLikelihood = -DBL_MAX;
 
-    Log::Info << "GMM::Train(): Log-likelihood of trial 0 is "
-        << bestLikelihood << "." << std::endl;
-
-    // Now the temporary model.
-    std::vector<distribution::GaussianDistribution> distsTrial(gaussians,
-        distribution::GaussianDistribution(dimensionality));
-    arma::vec weightsTrial(gaussians);
-
-    for (size_t trial = 1; trial < trials; ++trial)
+    // Run the random restarts concurrently.  The observations are shared
+    // read-only between the trials; each trial gets its own model workspace
+    // and its own copy of the fitter.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t trial = 0; trial < (omp_size_t) trials; ++trial)
     {
+      std::vector<distribution::GaussianDistribution> distsTrial;
+      arma::vec weightsTrial;
       if (useExistingModel)
       {
         distsTrial = distsOrig;
         weightsTrial = weightsOrig;
       }
+      else
+      {
+        distsTrial.resize(gaussians,
+            distribution::GaussianDistribution(dimensionality));
+        weightsTrial.set_size(gaussians);
+      }
 
-      fitter.Estimate(observations, distsTrial, weightsTrial, useExistingModel);
+      FittingType trialFitter(fitter);
+      trialFitter.Estimate(observations, distsTrial, weightsTrial,
+          useExistingModel);
 
       // Check to see if the log-likelihood of this one is better.
-      double newLikelihood = LogLikelihood(observations, distsTrial,
+      const double newLikelihood = LogLikelihood(observations, distsTrial,
           weightsTrial);
 
-      Log::Info << "GMM::Train(): Log-likelihood of trial " << trial << " is "
-          << newLikelihood << "." << std::endl;
-
-      if (newLikelihood > bestLikelihood)
+      #pragma omp critical
       {
-        // Save new likelihood and copy new model.
-        bestLikelihood = newLikelihood;
+        Log::Info << "GMM::Train(): Log-likelihood of trial " << trial
+            << " is " << newLikelihood << "." << std::endl;
 
-        dists = distsTrial;
-        weights = weightsTrial;
+        if (newLikelihood > bestLikelihood)
+        {
+          // Save new likelihood and move the new model into place.
+          bestLikelihood = newLikelihood;
+
+          dists = std::move(distsTrial);
+          weights = std::move(weightsTrial);
+        }
       }
     }
   }
@@ -137,46 +142,49 @@ double GMM::Train(const arma::mat& observations,
       weightsOrig = weights;
     }
 
-    // We need to keep temporary copies.  We'll do the first training into the
-    // actual model position, so that if it's the best we don't need to copy it.
-    fitter.Estimate(observations, probabilities, dists, weights,
-        useExistingModel);
-
-    bestLikelihood = LogLikelihood(observations, dists, weights);
-
-    Log::Debug << "GMM::Train(): Log-likelihood of trial 0 is "
-        << bestLikelihood << "." << std::endl;
-
-    // Now the temporary model.
-    std::vector<distribution::GaussianDistribution> distsTrial(gaussians,
-        distribution::GaussianDistribution(dimensionality));
-    arma::vec weightsTrial(gaussians);
+    bestLikelihood = -DBL_MAX;
 
-    for (size_t trial = 1; trial < trials; ++trial)
+    // Run the random restarts concurrently.  The observations are shared
+    // read-only between the trials; each trial gets its own model workspace
+    // and its own copy of the fitter.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t trial = 0; trial < (omp_size_t) trials; ++trial)
     {
+      std::vector<distribution::GaussianDistribution> distsTrial;
+      arma::vec weightsTrial;
       if (useExistingModel)
       {
         distsTrial = distsOrig;
         weightsTrial = weightsOrig;
       }
+      else
+      {
+        distsTrial.resize(gaussians,
+            distribution::GaussianDistribution(dimensionality));
+        weightsTrial.set_size(gaussians);
+      }
 
-      fitter.Estimate(observations, probabilities, distsTrial, weightsTrial,
-          useExistingModel);
+      FittingType trialFitter(fitter);
+      trialFitter.Estimate(observations, probabilities, distsTrial,
+          weightsTrial, useExistingModel);
 
       // Check to see if the log-likelihood of this one is better.
-      double newLikelihood = LogLikelihood(observations, distsTrial,
+      const double newLikelihood = LogLikelihood(observations, distsTrial,
           weightsTrial);
 
-      Log::Debug << "GMM::Train(): Log-likelihood of trial " << trial << " is "
-          << newLikelihood << "." << std::endl;
-
-      if (newLikelihood > bestLikelihood)
+      #pragma omp critical
       {
-        // Save new likelihood and copy new model.
-        bestLikelihood = newLikelihood;
+        Log::Debug << "GMM::Train(): Log-likelihood of trial " << trial
+            << " is " << newLikelihood << "." << std::endl;
+
+        if (newLikelihood > bestLikelihood)
+        {
+          // Save new likelihood and move the new model into place.
+          bestLikelihood = newLikelihood;
 
-        dists = distsTrial;
-        weights = weightsTrial;
+          dists = std::move(distsTrial);
+          weights = std::move(weightsTrial);
+        }
       }
     }
   }
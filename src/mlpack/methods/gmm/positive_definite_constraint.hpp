@@ -62,6 +62,22 @@ class PositiveDefiniteConstraint
     }
   }
 
+  /**
+   * Apply the positive definiteness constraint to a diagonal covariance,
+   * given as the vector of per-dimension variances.  The eigenvalues of a
+   * diagonal matrix are its entries, so it suffices to clamp each variance.
+   *
+   * @param diagCovariance Vector of per-dimension variances.
+   */
+  static void ApplyConstraint(arma::vec& diagCovariance)
+  {
+    for (size_t i = 0; i < diagCovariance.n_elem; ++i)
+    {
+      if (diagCovariance[i] < 1e-50)
+        diagCovariance[i] = 1e-50;
+    }
+  }
+
   //! Serialize the constraint (which stores nothing, so, nothing to do).
   template<typename Archive>
   static void serialize(Archive& /* ar */, const unsigned int /* version */) { }
@@ -169,6 +169,39 @@ class HMM
    */
   double Train(const std::vector<arma::mat>& dataSeq);
 
+  /**
+   * Train the model with mini-batch (stepwise) EM on the given unlabeled
+   * observations.  Instead of re-estimating the parameters from all sequences
+   * at once, each epoch visits the sequences in a shuffled order in shards of
+   * batchSize sequences; after the E-step of a shard, the shard's estimates of
+   * the initial and transition probabilities are blended into the current
+   * parameters with a step size that decays as pow(step + 2, -decay).  The
+   * emission distributions are refit at the end of every epoch from the
+   * per-sequence state probabilities gathered during that epoch.
+   *
+   * On collections of many short sequences this reaches a good solution in
+   * far fewer passes over the data than full-batch Train(), at the cost of a
+   * slightly noisier final estimate.  The decay exponent must be in (0.5, 1]
+   * for the usual stochastic approximation guarantees; larger values give
+   * smoother but slower-moving estimates.
+   *
+   * The model is left in a consistent, usable state after every epoch, so a
+   * caller who needs checkpointing can invoke this method once per epoch
+   * (with epochs = 1) and serialize the model in between; training continues
+   * from the current parameters, as with Train().
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param batchSize Number of sequences per mini-batch.
+   * @param epochs Number of passes over the full set of sequences.
+   * @param decay Step size decay exponent.
+   * @return Log-likelihood of the data under the model, accumulated over the
+   *     final epoch's E-steps.
+   */
+  double TrainMiniBatch(const std::vector<arma::mat>& dataSeq,
+                        const size_t batchSize,
+                        const size_t epochs,
+                        const double decay = 0.6);
+
   /**
    * Train the model using the given labeled observations; the transition and
    * emission matrices are directly estimated.  Each matrix in the vector of
@@ -271,18 +304,52 @@ class HMM
                 arma::Row<size_t>& stateSequence,
                 const size_t startState = 0) const;
 
+  /**
+   * Generate a batch of random data sequences, each of the given length.
+   * Slice i of the dataSequences cube holds sequence i (each column of the
+   * slice is one observation), and column i of stateSequences holds the
+   * corresponding hidden state sequence.  State transitions are drawn from
+   * alias tables that are built once per call, so each draw is constant time
+   * in the number of states, and the sequences are generated in parallel
+   * threads; prefer this overload when generating large amounts of synthetic
+   * data.
+   *
+   * @param length Length of each random sequence to generate.
+   * @param count Number of random sequences to generate.
+   * @param dataSequences Cube to store the sequences in; it will be set to
+   *    size dimensionality x length x count.
+   * @param stateSequences Matrix to store the state sequences in; it will be
+   *    set to size length x count.
+   * @param startState Hidden state to start each sequence in (default 0).
+   */
+  void Generate(const size_t length,
+                const size_t count,
+                arma::cube& dataSequences,
+                arma::Mat<size_t>& stateSequences,
+                const size_t startState = 0) const;
+
   /**
    * Compute the most probable hidden state sequence for the given data
    * sequence, using the Viterbi algorithm, returning the log-likelihood of the
    * most likely state sequence.
    *
+   * If beamWidth is greater than 0, beam pruning is used: at each time step,
+   * only states whose log-probability is within beamWidth of the best state
+   * are considered as predecessors for the next time step.  This can greatly
+   * accelerate prediction for models with many hidden states, at the cost of
+   * possibly returning a slightly suboptimal state sequence if the beam is
+   * too narrow.  The default of 0 performs the exact Viterbi algorithm.
+   *
    * @param dataSeq Sequence of observations.
    * @param stateSeq Vector in which the most probable state sequence will be
    *    stored.
+   * @param beamWidth Log-probability beam width for pruning (0 means no
+   *    pruning).
    * @return Log-likelihood of most probable state sequence.
    */
   double Predict(const arma::mat& dataSeq,
-                 arma::Row<size_t>& stateSeq) const;
+                 arma::Row<size_t>& stateSeq,
+                 const double beamWidth = 0.0) const;
 
   /**
    * Compute the log-likelihood of the given data sequence.
@@ -355,6 +422,20 @@ class HMM
 
  protected:
   // Helper functions.
+  /**
+   * Compute the log-probability of every observation in the given data
+   * sequence under every emission distribution.  The resulting matrix has rows
+   * equal to the number of hidden states and columns equal to the number of
+   * observations.  Both the Forward and the Backward algorithm work from this
+   * matrix, so it only needs to be computed once per sequence.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param emissionLogProb Matrix in which emission log-probabilities will be
+   *     saved.
+   */
+  void EmissionLogProbability(const arma::mat& dataSeq,
+                              arma::mat& emissionLogProb) const;
+
   /**
    * The Forward algorithm (part of the Forward-Backward algorithm).  Computes
    * forward probabilities for each state for each observation in the given data
@@ -369,6 +450,20 @@ class HMM
                arma::vec& logScales,
                arma::mat& forwardLogProb) const;
 
+  /**
+   * The Forward algorithm, given precomputed emission log-probabilities (as
+   * computed by EmissionLogProbability()).  Each time step reduces to a single
+   * matrix-vector product against the transition matrix.
+   *
+   * @param emissionLogProb Emission log-probability of each observation under
+   *     each state.
+   * @param scales Vector in which scaling factors will be saved.
+   * @param forwardProb Matrix in which forward probabilities will be saved.
+   */
+  void ForwardFromEmissions(const arma::mat& emissionLogProb,
+                            arma::vec& logScales,
+                            arma::mat& forwardLogProb) const;
+
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm).  Computes
    * backward probabilities for each state for each observation in the given
@@ -384,6 +479,20 @@ class HMM
                 const arma::vec& logScales,
                 arma::mat& backwardLogProb) const;
 
+  /**
+   * The Backward algorithm, given precomputed emission log-probabilities (as
+   * computed by EmissionLogProbability()).  Each time step reduces to a single
+   * matrix-vector product against the transposed transition matrix.
+   *
+   * @param emissionLogProb Emission log-probability of each observation under
+   *     each state.
+   * @param scales Vector of scaling factors.
+   * @param backwardProb Matrix in which backward probabilities will be saved.
+   */
+  void BackwardFromEmissions(const arma::mat& emissionLogProb,
+                             const arma::vec& logScales,
+                             arma::mat& backwardLogProb) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
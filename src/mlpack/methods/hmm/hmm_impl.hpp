@@ -16,6 +16,7 @@
 
 // Just in case...
 #include "hmm.hpp"
+#include <mlpack/core/math/alias_table.hpp>
 #include <mlpack/core/math/log_add.hpp>
 
 namespace mlpack {
@@ -110,6 +111,21 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
 
+  // Each sequence owns a fixed, disjoint block of columns in the emission
+  // list, so the sequences can be processed in any order (or concurrently).
+  // The observations themselves do not change between iterations, so the list
+  // is assembled once up front.
+  std::vector<size_t> seqOffsets(dataSeq.size());
+  size_t offset = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    seqOffsets[seq] = offset;
+    if (dataSeq[seq].n_cols > 0)
+      emissionList.cols(offset, offset + dataSeq[seq].n_cols - 1) =
+          dataSeq[seq];
+    offset += dataSeq[seq].n_cols;
+  }
+
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
   // Markov Models: Estimation and Control", pp. 36-40.
@@ -124,53 +140,94 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // Loop over each sequence.  The sequences are independent given the
+    // current parameters, so the E-step runs over them in parallel; each
+    // thread accumulates into its own log-space totals, which are merged
+    // afterwards.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      for (size_t j = 0; j < transition.n_cols; ++j)
-        newLogInitial[j] = math::LogAdd(newLogInitial[j], stateLogProb(j, 0));
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec threadLogInitial(transition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(transition.n_rows, transition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double threadLoglik = 0;
+
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+        arma::mat emissionLogProb;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.  The
+        // emission probabilities are computed once here and reused for the
+        // transition re-estimation below.
+        EmissionLogProbability(dataSeq[seq], emissionLogProb);
+        ForwardFromEmissions(emissionLogProb, logScales, forwardLog);
+        BackwardFromEmissions(emissionLogProb, logScales, backwardLog);
+        const arma::mat stateLogProb = forwardLog + backwardLog;
+        threadLoglik += accu(logScales);
+
+        // Add to estimate of initial probability for state j.
         for (size_t j = 0; j < transition.n_cols; ++j)
         {
-          if (t < dataSeq[seq].n_cols - 1)
+          threadLogInitial[j] = math::LogAdd(threadLogInitial[j],
+              stateLogProb(j, 0));
+        }
+
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t + 1 < dataSeq[seq].n_cols; ++t)
+        {
+          // Estimate of T_ij (probability of transition from state j to state
+          // i).  We postpone multiplication of the old T_ij until later.  The
+          // contribution of the next time step is the same for every source
+          // state j, so it is assembled once per time step.
+          const arma::vec nextLogProb = backwardLog.col(t + 1) +
+              emissionLogProb.col(t + 1) - logScales[t + 1];
+          for (size_t j = 0; j < transition.n_cols; ++j)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
             for (size_t i = 0; i < transition.n_rows; i++)
             {
-              newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
-                  forwardLog(j, t) + backwardLog(i, t + 1) +
-                  emission[i].LogProbability(dataSeq[seq].unsafe_col(t + 1)) -
-                  logScales[t + 1]);
+              threadLogTransition(i, j) = math::LogAdd(
+                  threadLogTransition(i, j),
+                  forwardLog(j, t) + nextLogProb[i]);
             }
           }
+        }
+
+        // Save the state probabilities, for Distribution::Train().  Each
+        // sequence writes to its own block of columns, so there is no
+        // contention between threads.
+        for (size_t j = 0; j < transition.n_cols; ++j)
+        {
+          emissionProb[j].subvec(seqOffsets[seq],
+              seqOffsets[seq] + dataSeq[seq].n_cols - 1) =
+              exp(stateLogProb.row(j).t());
+        }
+      }
 
-          // Add to list of emission observations, for Distribution::Train().
-          emissionList.col(sumTime) = dataSeq[seq].col(t);
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+      // Merge the per-thread accumulators (in log-space).
+      #pragma omp critical
+      {
+        loglik += threadLoglik;
+        for (size_t j = 0; j < transition.n_cols; ++j)
+        {
+          newLogInitial[j] = math::LogAdd(newLogInitial[j],
+              threadLogInitial[j]);
+
+          for (size_t i = 0; i < transition.n_rows; ++i)
+          {
+            newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
+                threadLogTransition(i, j));
+          }
         }
-        sumTime++;
       }
     }
 
@@ -214,6 +271,190 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   return loglik;
 }
 
+template<typename Distribution>
+double HMM<Distribution>::TrainMiniBatch(const std::vector<arma::mat>& dataSeq,
+                                         const size_t batchSize,
+                                         const size_t epochs,
+                                         const double decay)
+{
+  if (batchSize == 0)
+    Log::Fatal << "HMM::TrainMiniBatch(): batch size must be greater than 0!"
+        << std::endl;
+  if (decay <= 0.5 || decay > 1.0)
+    Log::Warn << "HMM::TrainMiniBatch(): decay exponent " << decay << " is "
+        << "outside (0.5, 1]; convergence is not guaranteed." << std::endl;
+
+  double loglik = 0;
+  double oldLoglik = 0;
+
+  // Find length of all sequences and ensure they are the correct size.
+  size_t totalLength = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    totalLength += dataSeq[seq].n_cols;
+
+    if (dataSeq[seq].n_rows != dimensionality)
+      Log::Fatal << "HMM::TrainMiniBatch(): data sequence " << seq << " has "
+          << "dimensionality " << dataSeq[seq].n_rows << " (expected "
+          << dimensionality << " dimensions)." << std::endl;
+  }
+
+  // As in Train(), the emission list is assembled once, and each sequence owns
+  // a fixed block of columns of it; the state probabilities of a block are
+  // refreshed whenever the corresponding sequence is visited in a shard.
+  std::vector<arma::vec> emissionProb(transition.n_cols,
+      arma::vec(totalLength));
+  arma::mat emissionList(dimensionality, totalLength);
+
+  std::vector<size_t> seqOffsets(dataSeq.size());
+  size_t offset = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    seqOffsets[seq] = offset;
+    if (dataSeq[seq].n_cols > 0)
+      emissionList.cols(offset, offset + dataSeq[seq].n_cols - 1) =
+          dataSeq[seq];
+    offset += dataSeq[seq].n_cols;
+  }
+
+  // Counts stepwise updates across epochs, for the step size schedule.
+  size_t step = 0;
+
+  for (size_t epoch = 0; epoch < epochs; epoch++)
+  {
+    // Visit the sequences in a different order every epoch.
+    const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        dataSeq.size() - 1, dataSeq.size()));
+
+    loglik = 0;
+
+    for (size_t shardStart = 0; shardStart < order.n_elem;
+         shardStart += batchSize)
+    {
+      const size_t shardEnd = std::min((size_t) order.n_elem,
+          shardStart + batchSize);
+
+      arma::vec shardLogInitial(transition.n_rows);
+      shardLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat shardLogTransition(transition.n_rows, transition.n_cols);
+      shardLogTransition.fill(-std::numeric_limits<double>::infinity());
+
+      // E-step over this shard only; the sequences of a shard are processed
+      // in parallel exactly as in Train().
+      #pragma omp parallel
+      {
+        arma::vec threadLogInitial(transition.n_rows);
+        threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+        arma::mat threadLogTransition(transition.n_rows, transition.n_cols);
+        threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+        double threadLoglik = 0;
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t s = (omp_size_t) shardStart;
+             s < (omp_size_t) shardEnd; s++)
+        {
+          const size_t seq = order[s];
+
+          arma::mat forwardLog;
+          arma::mat backwardLog;
+          arma::vec logScales;
+          arma::mat emissionLogProb;
+
+          EmissionLogProbability(dataSeq[seq], emissionLogProb);
+          ForwardFromEmissions(emissionLogProb, logScales, forwardLog);
+          BackwardFromEmissions(emissionLogProb, logScales, backwardLog);
+          const arma::mat stateLogProb = forwardLog + backwardLog;
+          threadLoglik += accu(logScales);
+
+          for (size_t j = 0; j < transition.n_cols; ++j)
+          {
+            threadLogInitial[j] = math::LogAdd(threadLogInitial[j],
+                stateLogProb(j, 0));
+          }
+
+          for (size_t t = 0; t + 1 < dataSeq[seq].n_cols; ++t)
+          {
+            const arma::vec nextLogProb = backwardLog.col(t + 1) +
+                emissionLogProb.col(t + 1) - logScales[t + 1];
+            for (size_t j = 0; j < transition.n_cols; ++j)
+            {
+              for (size_t i = 0; i < transition.n_rows; i++)
+              {
+                threadLogTransition(i, j) = math::LogAdd(
+                    threadLogTransition(i, j),
+                    forwardLog(j, t) + nextLogProb[i]);
+              }
+            }
+          }
+
+          // Refresh this sequence's block of the state probabilities.
+          for (size_t j = 0; j < transition.n_cols; ++j)
+          {
+            emissionProb[j].subvec(seqOffsets[seq],
+                seqOffsets[seq] + dataSeq[seq].n_cols - 1) =
+                exp(stateLogProb.row(j).t());
+          }
+        }
+
+        #pragma omp critical
+        {
+          loglik += threadLoglik;
+          for (size_t j = 0; j < transition.n_cols; ++j)
+          {
+            shardLogInitial[j] = math::LogAdd(shardLogInitial[j],
+                threadLogInitial[j]);
+
+            for (size_t i = 0; i < transition.n_rows; ++i)
+            {
+              shardLogTransition(i, j) = math::LogAdd(shardLogTransition(i, j),
+                  threadLogTransition(i, j));
+            }
+          }
+        }
+      }
+
+      // Turn the shard's accumulators into parameter estimates, the same way
+      // Train() does for the full batch.
+      arma::vec shardInitial = exp(shardLogInitial) /
+          (double) (shardEnd - shardStart);
+
+      arma::mat shardTransition = transition % exp(shardLogTransition);
+      for (size_t i = 0; i < shardTransition.n_cols; i++)
+      {
+        const double sum = accu(shardTransition.col(i));
+        if (sum > 0.0)
+          shardTransition.col(i) /= sum;
+        else
+          shardTransition.col(i).fill(1.0 / (double) shardTransition.n_rows);
+      }
+
+      // Stepwise blend (Cappe and Moulines, 2009): move the parameters toward
+      // the shard's estimate, by less and less as training proceeds.
+      const double eta = std::pow((double) step + 2.0, -decay);
+      initial = (1.0 - eta) * initial + eta * shardInitial;
+      transition = (1.0 - eta) * transition + eta * shardTransition;
+      ++step;
+    }
+
+    // The emission distributions are refit once per epoch, after every
+    // sequence's state probabilities have been refreshed.
+    for (size_t state = 0; state < transition.n_cols; state++)
+      emission[state].Train(emissionList, emissionProb[state]);
+
+    Log::Info << "HMM::TrainMiniBatch(): epoch " << epoch
+        << ": log-likelihood " << loglik << "." << std::endl;
+
+    if (epoch > 0 && std::abs(oldLoglik - loglik) < tolerance)
+    {
+      Log::Debug << "Converged after " << epoch << " epochs." << std::endl;
+      break;
+    }
+    oldLoglik = loglik;
+  }
+
+  return loglik;
+}
+
 /**
  * Train the model using the given labeled observations; the transition and
  * emission matrices are directly estimated.
@@ -320,9 +561,12 @@ double HMM<Distribution>::LogEstimate(const arma::mat& dataSeq,
                                       arma::mat& backwardLogProb,
                                       arma::vec& logScales) const
 {
-  // First run the forward-backward algorithm.
-  Forward(dataSeq, logScales, forwardLogProb);
-  Backward(dataSeq, logScales, backwardLogProb);
+  // First run the forward-backward algorithm.  The emission probabilities are
+  // computed once and shared by both passes.
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  ForwardFromEmissions(emissionLogProb, logScales, forwardLogProb);
+  BackwardFromEmissions(emissionLogProb, logScales, backwardLogProb);
 
   // Now assemble the state probability matrix based on the forward and backward
   // probabilities.
@@ -396,37 +640,71 @@ void HMM<Distribution>::Generate(const size_t length,
   stateSequence.set_size(length);
   dataSequence.set_size(dimensionality, length);
 
+  // Build an alias table for each state's outgoing transitions, so that each
+  // state draw below is constant time instead of a linear scan over the
+  // states.
+  std::vector<math::AliasTable> transitionSamplers(transition.n_cols);
+  for (size_t st = 0; st < transition.n_cols; st++)
+    transitionSamplers[st].Build(transition.col(st));
+
   // Set start state (default is 0).
   stateSequence[0] = startState;
 
-  // Choose first emission state.
-  double randValue = math::Random();
-
-  // We just have to find where our random value sits in the probability
-  // distribution of emissions for our starting state.
+  // Choose the first emission.
   dataSequence.col(0) = emission[startState].Random();
 
   // Now choose the states and emissions for the rest of the sequence.
   for (size_t t = 1; t < length; t++)
   {
-    // First choose the hidden state.
-    randValue = math::Random();
+    stateSequence[t] = transitionSamplers[stateSequence[t - 1]].Random();
+    dataSequence.col(t) = emission[stateSequence[t]].Random();
+  }
+}
 
-    // Now find where our random value sits in the probability distribution of
-    // state changes.
-    double probSum = 0;
-    for (size_t st = 0; st < transition.n_rows; st++)
+/**
+ * Generate a batch of random data sequences, each of a given length.  Slice i
+ * of dataSequences holds sequence i, and column i of stateSequences holds the
+ * corresponding state sequence.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Generate(const size_t length,
+                                 const size_t count,
+                                 arma::cube& dataSequences,
+                                 arma::Mat<size_t>& stateSequences,
+                                 const size_t startState) const
+{
+  dataSequences.set_size(dimensionality, length, count);
+  stateSequences.set_size(length, count);
+
+  // Build an alias table for each state's outgoing transitions once, so that
+  // each state draw below is constant time instead of a linear scan over the
+  // states.
+  std::vector<math::AliasTable> transitionSamplers(transition.n_cols);
+  for (size_t st = 0; st < transition.n_cols; st++)
+    transitionSamplers[st].Build(transition.col(st));
+
+  // Draw one observation from each emission distribution up front, so that
+  // any sampling structures a distribution builds lazily on its first draw
+  // (such as the alias tables of DiscreteDistribution) are initialized
+  // before the parallel region.
+  for (size_t st = 0; st < emission.size(); st++)
+    emission[st].Random();
+
+  // The random number generators are thread_local, so each sequence can be
+  // generated independently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t seq = 0; seq < (omp_size_t) count; seq++)
+  {
+    stateSequences(0, seq) = startState;
+    dataSequences.slice(seq).col(0) = emission[startState].Random();
+
+    for (size_t t = 1; t < length; t++)
     {
-      probSum += transition(st, stateSequence[t - 1]);
-      if (randValue <= probSum)
-      {
-        stateSequence[t] = st;
-        break;
-      }
+      stateSequences(t, seq) =
+          transitionSamplers[stateSequences(t - 1, seq)].Random();
+      dataSequences.slice(seq).col(t) =
+          emission[stateSequences(t, seq)].Random();
     }
-
-    // Now choose the emission.
-    dataSequence.col(t) = emission[stateSequence[t]].Random();
   }
 }
 
@@ -437,7 +715,8 @@ void HMM<Distribution>::Generate(const size_t length,
  */
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
-                                  arma::Row<size_t>& stateSeq) const
+                                  arma::Row<size_t>& stateSeq,
+                                  const double beamWidth) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
@@ -462,19 +741,66 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     stateSeqBack(state, 0) = state;
   }
 
+  // If a positive beam width was given, only states whose log-probability is
+  // within beamWidth of the best state at a time step are kept as candidate
+  // predecessors for the next time step.  The list of surviving states is
+  // kept compact so each step costs O(S * |beam|) instead of O(S^2).
+  const bool prune = (beamWidth > 0.0);
+  std::vector<size_t> activeStates;
+  if (prune)
+    activeStates.reserve(transition.n_rows);
+
   // Store the best first state.
   arma::uword index;
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
-    // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < transition.n_rows; j++)
+    if (prune)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTrans.col(j);
-      logStateProb(j, t) = prob.max(index) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-      stateSeqBack(j, t) = index;
+      // Collect the states that survive the beam at the previous time step.
+      activeStates.clear();
+      const double bestLogProb = logStateProb.col(t - 1).max();
+      for (size_t state = 0; state < transition.n_rows; state++)
+      {
+        if (logStateProb(state, t - 1) >= bestLogProb - beamWidth)
+          activeStates.push_back(state);
+      }
+
+      for (size_t j = 0; j < transition.n_rows; j++)
+      {
+        // Given that we are in state j, find the active state with the
+        // highest probability of being the previous state.
+        double bestProb = -std::numeric_limits<double>::infinity();
+        size_t bestState = j;
+        for (const size_t state : activeStates)
+        {
+          const double prob = logStateProb(state, t - 1) + logTrans(state, j);
+          if (prob > bestProb)
+          {
+            bestProb = prob;
+            bestState = state;
+          }
+        }
+
+        // States that cannot be reached from the beam do not need their
+        // emission probability evaluated.
+        logStateProb(j, t) = std::isfinite(bestProb) ?
+            bestProb + emission[j].LogProbability(dataSeq.unsafe_col(t)) :
+            bestProb;
+        stateSeqBack(j, t) = bestState;
+      }
+    }
+    else
+    {
+      // Assemble the state probability for this element.
+      // Given that we are in state j, we use state with the highest
+      // probability of being the previous state.
+      for (size_t j = 0; j < transition.n_rows; j++)
+      {
+        arma::vec prob = logStateProb.col(t - 1) + logTrans.col(j);
+        logStateProb(j, t) = prob.max(index) +
+            emission[j].LogProbability(dataSeq.unsafe_col(t));
+        stateSeqBack(j, t) = index;
+      }
     }
   }
 
@@ -553,6 +879,29 @@ void HMM<Distribution>::Smooth(const arma::mat& dataSeq,
     smoothSeq += emission[i].Mean() * exp(stateLogProb.row(i));
 }
 
+/**
+ * Compute the log-probability of every observation under every emission
+ * distribution.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionLogProbability(
+    const arma::mat& dataSeq,
+    arma::mat& emissionLogProb) const
+{
+  // Each emission distribution is evaluated against every observation exactly
+  // once; the Forward and Backward recursions then work from this matrix, so
+  // no emission probability is ever computed twice for the same sequence.
+  emissionLogProb.set_size(transition.n_rows, dataSeq.n_cols);
+  for (size_t state = 0; state < transition.n_rows; state++)
+  {
+    for (size_t t = 0; t < dataSeq.n_cols; t++)
+    {
+      emissionLogProb(state, t) =
+          emission[state].LogProbability(dataSeq.unsafe_col(t));
+    }
+  }
+}
+
 /**
  * The Forward procedure (part of the Forward-Backward algorithm).
  */
@@ -560,43 +909,55 @@ template<typename Distribution>
 void HMM<Distribution>::Forward(const arma::mat& dataSeq,
                                 arma::vec& logScales,
                                 arma::mat& forwardLogProb) const
+{
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  ForwardFromEmissions(emissionLogProb, logScales, forwardLogProb);
+}
+
+template<typename Distribution>
+void HMM<Distribution>::ForwardFromEmissions(
+    const arma::mat& emissionLogProb,
+    arma::vec& logScales,
+    arma::mat& forwardLogProb) const
 {
   // Our goal is to calculate the forward probabilities:
   //  P(X_k | o_{1:k}) for all possible states X_k, for each time point k.
-  forwardLogProb.resize(transition.n_rows, dataSeq.n_cols);
-  forwardLogProb.fill(-std::numeric_limits<double>::infinity());
-  logScales.resize(dataSeq.n_cols);
-  logScales.fill(-std::numeric_limits<double>::infinity());
-
-  arma::mat logTrans = trans(log(transition));
+  forwardLogProb.set_size(transition.n_rows, emissionLogProb.n_cols);
+  logScales.set_size(emissionLogProb.n_cols);
 
   // The first entry in the forward algorithm uses the initial state
   // probabilities.  Note that MATLAB assumes that the starting state (at
   // t = -1) is state 0; this is not our assumption here.  To force that
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
-  for (size_t state = 0; state < transition.n_rows; state++)
-  {
-    forwardLogProb(state, 0) = log(initial(state)) +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-  }
+  forwardLogProb.col(0) = log(initial) + emissionLogProb.col(0);
 
   // Then normalize the column.
   logScales[0] = math::AccuLog(forwardLogProb.col(0));
   if (std::isfinite(logScales[0]))
     forwardLogProb.col(0) -= logScales[0];
 
-  // Now compute the probabilities for each successive observation.
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  // Now compute the probabilities for each successive observation.  The
+  // log-sum over previous states is computed for all states at once: shifting
+  // by the largest previous log-probability turns it into a single
+  // matrix-vector product against the transition matrix, which the BLAS
+  // backend vectorizes.
+  for (size_t t = 1; t < emissionLogProb.n_cols; t++)
   {
-    for (size_t j = 0; j < transition.n_rows; j++)
+    // The forward probability of state j at time t is the sum over all states
+    // of the probability of the previous state transitioning to the current
+    // state and emitting the given observation.
+    const double maxLogProb = forwardLogProb.col(t - 1).max();
+    if (std::isfinite(maxLogProb))
     {
-      // The forward probability of state j at time t is the sum over all states
-      // of the probability of the previous state transitioning to the current
-      // state and emitting the given observation.
-      arma::vec tmp = forwardLogProb.col(t - 1) + logTrans.col(j);
-      forwardLogProb(j, t) = math::AccuLog(tmp) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
+      forwardLogProb.col(t) = maxLogProb +
+          log(transition * exp(forwardLogProb.col(t - 1) - maxLogProb)) +
+          emissionLogProb.col(t);
+    }
+    else
+    {
+      forwardLogProb.col(t).fill(-std::numeric_limits<double>::infinity());
     }
 
     // Normalize probability.
@@ -610,36 +971,55 @@ template<typename Distribution>
 void HMM<Distribution>::Backward(const arma::mat& dataSeq,
                                  const arma::vec& logScales,
                                  arma::mat& backwardLogProb) const
+{
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  BackwardFromEmissions(emissionLogProb, logScales, backwardLogProb);
+}
+
+template<typename Distribution>
+void HMM<Distribution>::BackwardFromEmissions(
+    const arma::mat& emissionLogProb,
+    const arma::vec& logScales,
+    arma::mat& backwardLogProb) const
 {
   // Our goal is to calculate the backward probabilities:
   //  P(X_k | o_{k + 1:T}) for all possible states X_k, for each time point k.
-  backwardLogProb.resize(transition.n_rows, dataSeq.n_cols);
-  backwardLogProb.fill(-std::numeric_limits<double>::infinity());
-  arma::mat logTrans = log(transition);
+  backwardLogProb.set_size(transition.n_rows, emissionLogProb.n_cols);
+
+  // The backward recursion sums over rows of the transition matrix, so keep a
+  // transposed copy around: that way each time step is a matrix-vector product
+  // against a contiguous matrix.
+  const arma::mat transposedTransition = trans(transition);
 
   // The last element probability is 1.
-  backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
+  backwardLogProb.col(emissionLogProb.n_cols - 1).zeros();
 
   // Now step backwards through all other observations.
-  for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
+  for (size_t t = emissionLogProb.n_cols - 2; t + 1 > 0; t--)
   {
-    for (size_t j = 0; j < transition.n_rows; j++)
+    // The backward probability of state j at time t is the sum over all states
+    // of the probability of the next state having been a transition from the
+    // current state multiplied by the probability of each of those states
+    // emitting the given observation.  As in the forward algorithm, shifting
+    // by the largest log-probability turns the log-sum over next states into
+    // a single matrix-vector product.
+    const arma::vec nextLogProb =
+        backwardLogProb.col(t + 1) + emissionLogProb.col(t + 1);
+    const double maxLogProb = nextLogProb.max();
+    if (std::isfinite(maxLogProb))
     {
-      // The backward probability of state j at time t is the sum over all state
-      // of the probability of the next state having been a transition from the
-      // current state multiplied by the probability of each of those states
-      // emitting the given observation.
-      for (size_t state = 0; state < transition.n_rows; state++)
-      {
-        backwardLogProb(j, t) = math::LogAdd(backwardLogProb(j, t),
-            logTrans(state, j) + backwardLogProb(state, t + 1)
-            + emission[state].LogProbability(dataSeq.unsafe_col(t + 1)));
-      }
-
-      // Normalize by the weights from the forward algorithm.
-      if (std::isfinite(logScales[t + 1]))
-        backwardLogProb(j, t) -= logScales[t + 1];
+      backwardLogProb.col(t) = maxLogProb +
+          log(transposedTransition * exp(nextLogProb - maxLogProb));
     }
+    else
+    {
+      backwardLogProb.col(t).fill(-std::numeric_limits<double>::infinity());
+    }
+
+    // Normalize by the weights from the forward algorithm.
+    if (std::isfinite(logScales[t + 1]))
+      backwardLogProb.col(t) -= logScales[t + 1];
   }
 }
 
@@ -158,6 +158,31 @@ class HMMRegression : public HMM<distribution::RegressionDistribution>
   void Train(const std::vector<arma::mat>& predictors,
              const std::vector<arma::vec>& responses);
 
+  /**
+   * Train the model with mini-batch (stepwise) EM on the given unlabeled
+   * predictor and response sequences.  Each epoch visits the sequences in a
+   * shuffled order in shards of batchSize sequences, blends each shard's
+   * estimates of the initial and transition probabilities into the current
+   * parameters with a decaying step size, and refits the regression emissions
+   * at the end of the epoch.  On large collections of short sequences this
+   * converges in far fewer passes than the full-batch Train().  The model is
+   * consistent after every epoch, so calling this once per epoch (with
+   * epochs = 1) allows checkpointing in between; see HMM::TrainMiniBatch()
+   * for the details of the update schedule.
+   *
+   * @param predictors Vector of predictor sequences.
+   * @param responses Vector of response sequences.
+   * @param batchSize Number of sequences per mini-batch.
+   * @param epochs Number of passes over the full set of sequences.
+   * @param decay Step size decay exponent.
+   * @return Log-likelihood accumulated over the final epoch.
+   */
+  double TrainMiniBatch(const std::vector<arma::mat>& predictors,
+                        const std::vector<arma::vec>& responses,
+                        const size_t batchSize,
+                        const size_t epochs,
+                        const double decay = 0.6);
+
   /**
    * Train the model using the given labeled observations; the transition and
    * regression emissions are directly estimated. Each matrix in the vector of
@@ -28,6 +28,17 @@ void HMMRegression::Train(const std::vector<arma::mat>& predictors,
   this->HMM::Train(dataSeq);
 }
 
+double HMMRegression::TrainMiniBatch(const std::vector<arma::mat>& predictors,
+                                     const std::vector<arma::vec>& responses,
+                                     const size_t batchSize,
+                                     const size_t epochs,
+                                     const double decay)
+{
+  std::vector<arma::mat> dataSeq;
+  StackData(predictors, responses, dataSeq);
+  return this->HMM::TrainMiniBatch(dataSeq, batchSize, epochs, decay);
+}
+
 void HMMRegression::Train(const std::vector<arma::mat>& predictors,
                           const std::vector<arma::vec>& responses,
                           const std::vector<arma::Row<size_t> >& stateSeq)
@@ -59,6 +59,11 @@ PROGRAM_INFO("Hidden Markov Model (HMM) Viterbi State Prediction",
 PARAM_MATRIX_IN_REQ("input", "Matrix containing observations,", "i");
 PARAM_MODEL_IN_REQ(HMMModel, "input_model", "Trained HMM to use.", "m");
 PARAM_UMATRIX_OUT("output", "File to save predicted state sequence to.", "o");
+PARAM_DOUBLE_IN("beam_width", "If greater than 0, prune the Viterbi search: "
+    "at each time step only states whose log-probability is within this value "
+    "of the best state are considered as predecessors.  This can greatly "
+    "accelerate prediction for models with many states, at the cost of a "
+    "possibly suboptimal state sequence if the beam is too narrow.", "b", 0.0);
 
 // Because we don't know what the type of our HMM is, we need to write a
 // function that can take arbitrary HMM types.
@@ -86,8 +91,12 @@ struct Viterbi
           << hmm.Emission()[0].Dimensionality() << ")!" << endl;
     }
 
+    // Check that the beam width is sensible.
+    RequireParamValue<double>("beam_width", [](double x) { return x >= 0.0; },
+        true, "beam width must be nonnegative");
+
     arma::Row<size_t> sequence;
-    hmm.Predict(dataSeq, sequence);
+    hmm.Predict(dataSeq, sequence, CLI::GetParam<double>("beam_width"));
 
     // Save output.
     CLI::GetParam<arma::Mat<size_t>>("output") = std::move(sequence);
@@ -73,6 +73,18 @@ class BinaryNumericSplit
    */
   void Train(ObservationType value, const size_t label);
 
+  /**
+   * Train on a batch of values at once.  The sorted-sample structure this
+   * split maintains must be updated one element at a time, so this is just a
+   * convenience loop over Train(); it exists so that callers can treat all
+   * numeric split types uniformly.
+   *
+   * @param values Values to train on, one per point in the batch.
+   * @param batchLabels Labels of the points in the batch.
+   */
+  template<typename VecType>
+  void TrainBulk(const VecType& values, const arma::Row<size_t>& batchLabels);
+
   /**
    * Given the points seen so far, evaluate the fitness function, returning the
    * best possible gain of a binary split.  Note that this takes O(n) time,
@@ -54,6 +54,17 @@ void BinaryNumericSplit<FitnessFunction, ObservationType>::Train(
   isAccurate = false;
 }
 
+template<typename FitnessFunction, typename ObservationType>
+template<typename VecType>
+void BinaryNumericSplit<FitnessFunction, ObservationType>::TrainBulk(
+    const VecType& values,
+    const arma::Row<size_t>& batchLabels)
+{
+  // The multimap must be updated element by element.
+  for (size_t i = 0; i < values.n_elem; ++i)
+    Train(values[i], batchLabels[i]);
+}
+
 template<typename FitnessFunction, typename ObservationType>
 void BinaryNumericSplit<FitnessFunction, ObservationType>::
     EvaluateFitnessFunction(double& bestFitness,
@@ -76,6 +76,16 @@ class HoeffdingCategoricalSplit
   template<typename eT>
   void Train(eT value, const size_t label);
 
+  /**
+   * Train on a batch of values at once.  This is equivalent to calling Train()
+   * on each value in order, but avoids any per-point overhead.
+   *
+   * @param values Values to train on, one per point in the batch.
+   * @param batchLabels Labels of the points in the batch.
+   */
+  template<typename VecType>
+  void TrainBulk(const VecType& values, const arma::Row<size_t>& batchLabels);
+
   /**
    * Given the points seen so far, evaluate the fitness function, returning the
    * gain for the best possible split and the second best possible split.  In
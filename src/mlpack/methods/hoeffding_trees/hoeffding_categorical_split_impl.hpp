@@ -47,6 +47,16 @@ void HoeffdingCategoricalSplit<FitnessFunction>::Train(eT value,
   sufficientStatistics(label, size_t(value))++;
 }
 
+template<typename FitnessFunction>
+template<typename VecType>
+void HoeffdingCategoricalSplit<FitnessFunction>::TrainBulk(
+    const VecType& values,
+    const arma::Row<size_t>& batchLabels)
+{
+  for (size_t i = 0; i < values.n_elem; ++i)
+    sufficientStatistics(batchLabels[i], size_t(values[i]))++;
+}
+
 template<typename FitnessFunction>
 void HoeffdingCategoricalSplit<FitnessFunction>::EvaluateFitnessFunction(
     double& bestFitness,
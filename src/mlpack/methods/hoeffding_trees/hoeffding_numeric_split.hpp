@@ -87,6 +87,19 @@ class HoeffdingNumericSplit
    */
   void Train(ObservationType value, const size_t label);
 
+  /**
+   * Train on a batch of observed values at once.  This gives the same
+   * sufficient statistics as calling Train() on each value in order, but once
+   * the bins have been determined the whole batch is binned in a single pass,
+   * which is much faster for high-rate streams.
+   *
+   * @param values Values in the dimension that this HoeffdingNumericSplit
+   *      refers to, one per point in the batch.
+   * @param batchLabels Labels of the points in the batch.
+   */
+  template<typename VecType>
+  void TrainBulk(const VecType& values, const arma::Row<size_t>& batchLabels);
+
   /**
    * Evaluate the fitness function given what has been calculated so far.  In
    * this case, if binning has not yet been performed, 0 will be returned (i.e.,
@@ -103,6 +103,33 @@ void HoeffdingNumericSplit<FitnessFunction, ObservationType>::Train(
   sufficientStatistics(label, bin)++;
 }
 
+template<typename FitnessFunction, typename ObservationType>
+template<typename VecType>
+void HoeffdingNumericSplit<FitnessFunction, ObservationType>::TrainBulk(
+    const VecType& values,
+    const arma::Row<size_t>& batchLabels)
+{
+  // Feed points one at a time until the bins have been built; Train() handles
+  // the buffering and the binning transition.
+  size_t start = 0;
+  while (samplesSeen < observationsBeforeBinning && start < values.n_elem)
+  {
+    Train(values[start], batchLabels[start]);
+    ++start;
+  }
+
+  // The rest of the batch can go straight into the sufficient statistics.
+  for (size_t i = start; i < values.n_elem; ++i)
+  {
+    // What bin does the point fall into?
+    size_t bin = 0;
+    while (bin < bins - 1 && values[i] > splitPoints[bin])
+      ++bin;
+
+    sufficientStatistics(batchLabels[i], bin)++;
+  }
+}
+
 template<typename FitnessFunction, typename ObservationType>
 void HoeffdingNumericSplit<FitnessFunction, ObservationType>::
     EvaluateFitnessFunction(double& bestFitness,
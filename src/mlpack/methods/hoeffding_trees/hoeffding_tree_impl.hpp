@@ -416,6 +416,96 @@ void HoeffdingTree<
   }
 }
 
+//! Ingest a batch of streaming points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainStreaming(const MatType& data, const arma::Row<size_t>& labels)
+{
+  // First, route every point to the leaf it currently belongs to, bucketing
+  // the point indices by leaf.  The tree does not change during routing, so
+  // the buckets exactly partition the batch.
+  std::unordered_map<HoeffdingTree*, std::vector<arma::uword>> buckets;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    HoeffdingTree* node = this;
+    while (node->splitDimension != size_t(-1))
+      node = node->children[node->CalculateDirection(data.col(i))];
+    buckets[node].push_back(i);
+  }
+
+  // Flatten the buckets so that OpenMP can iterate over them.  Each leaf owns
+  // exactly one bucket, so its statistics are only ever touched by the thread
+  // that processes that bucket---no synchronization is needed.
+  std::vector<std::pair<HoeffdingTree*, arma::uvec>> leaves;
+  leaves.reserve(buckets.size());
+  for (auto& bucket : buckets)
+    leaves.push_back(std::make_pair(bucket.first, arma::uvec(bucket.second)));
+
+  // Bucket sizes can be very uneven, so use dynamic scheduling.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) leaves.size(); ++i)
+    leaves[i].first->TrainLeaf(data, labels, leaves[i].second);
+}
+
+//! Update a leaf's statistics with its share of a batch.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainLeaf(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const arma::uvec& indices)
+{
+  // As in the batch training path, Armadillo's non-contiguous subviews can't
+  // be passed along directly, so extract the leaf's submatrix.
+  const MatType leafData = data.cols(indices);
+  const arma::Row<size_t> leafLabels = labels.cols(indices);
+
+  numSamples += indices.n_elem;
+  size_t numericIndex = 0;
+  size_t categoricalIndex = 0;
+  for (size_t i = 0; i < leafData.n_rows; ++i)
+  {
+    if (datasetInfo->Type(i) == data::Datatype::categorical)
+      categoricalSplits[categoricalIndex++].TrainBulk(leafData.row(i),
+          leafLabels);
+    else if (datasetInfo->Type(i) == data::Datatype::numeric)
+      numericSplits[numericIndex++].TrainBulk(leafData.row(i), leafLabels);
+  }
+
+  // Grab majority class from splits.
+  if (categoricalSplits.size() > 0)
+  {
+    majorityClass = categoricalSplits[0].MajorityClass();
+    majorityProbability = categoricalSplits[0].MajorityProbability();
+  }
+  else
+  {
+    majorityClass = numericSplits[0].MajorityClass();
+    majorityProbability = numericSplits[0].MajorityProbability();
+  }
+
+  // Check once for a split, on behalf of the whole bucket.
+  const size_t numChildren = SplitCheck();
+  if (numChildren > 0)
+  {
+    // We need to add a bunch of children.
+    // Delete children, if we have them.
+    children.clear();
+    CreateChildren();
+  }
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
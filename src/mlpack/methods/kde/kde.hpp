@@ -144,6 +144,28 @@ class KDE
    */
   void Evaluate(MatType querySet, arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query set for several kernel
+   * bandwidths at once, sharing a single dual-tree traversal between all the
+   * bandwidths instead of paying one full traversal per bandwidth (useful
+   * for bandwidth selection sweeps).  Estimations might not be normalized.
+   *
+   * - Dimension of each point in the query set must match the dimension of
+   *   each point in the reference set.
+   *
+   * - Use std::move if the query set is no longer needed.
+   *
+   * @pre The model has to be previously trained and mode has to be
+   *      dual-tree.
+   * @param querySet Set of query points to get the density of.
+   * @param bandwidths Kernel bandwidths to evaluate.
+   * @param estimations Matrix which will hold the densities; entry (i, j) is
+   *                    the density of query point i for bandwidth j.
+   */
+  void Evaluate(MatType querySet,
+                const arma::vec& bandwidths,
+                arma::mat& estimations);
+
   /**
    * Estimate density of each point in the query set given the data of an
    * already created query tree. The result is stored in an estimations vector.
@@ -252,6 +274,10 @@ class KDE
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Rearrange the rows of a multi-bandwidth estimations matrix if required.
+  static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
+                                   arma::mat& estimations);
 };
 
 } // namespace kde
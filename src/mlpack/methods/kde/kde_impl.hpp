@@ -13,9 +13,41 @@
 #include "kde.hpp"
 #include "kde_rules.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace kde {
 
+//! Collect disjoint subtrees of the given tree that together cover all of its
+//! points, expanding breadth-first until at least the requested number of
+//! roots is available (or no further expansion is possible).  This is used to
+//! hand independent pieces of a dual-tree traversal to different threads.
+template<typename TreeType>
+std::vector<TreeType*> DecomposeTree(TreeType* root, const size_t targetRoots)
+{
+  std::vector<TreeType*> roots;
+  std::queue<TreeType*> queue;
+  queue.push(root);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    // Stop expanding once we have enough pieces; count what is still queued.
+    if (node->NumChildren() == 0 ||
+        (roots.size() + queue.size()) >= targetRoots)
+    {
+      roots.push_back(node);
+      queue.pop();
+      continue;
+    }
+
+    queue.pop();
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      queue.push(&node->Child(i));
+  }
+
+  return roots;
+}
+
 //! Construct tree that rearranges the dataset.
 template<typename TreeType, typename MatType>
 TreeType* BuildTree(
@@ -339,6 +371,45 @@ Evaluate(MatType querySet, arma::vec& estimations)
 
     // Evaluate.
     typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+    if (omp_get_max_threads() > 1 && querySet.n_cols > 1)
+    {
+      // Each thread traverses the tree for its own query points with its own
+      // rule set, so no traversal state is shared; every query point only
+      // writes to its own density entry.
+      size_t totalScores = 0, totalBaseCases = 0;
+
+      #pragma omp parallel
+      {
+        RuleType threadRules(referenceTree->Dataset(), querySet, estimations,
+            relError, absError, metric, kernel, false);
+        SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+
+        threadRules.FlushKernelBuffer();
+
+        #pragma omp critical (KDEMerge)
+        {
+          totalScores += threadRules.Scores();
+          totalBaseCases += threadRules.BaseCases();
+        }
+      }
+
+      estimations /= referenceTree->Dataset().n_cols;
+      Timer::Stop("computing_kde");
+
+      Log::Info << totalScores << " node combinations were scored."
+                << std::endl;
+      Log::Info << totalBaseCases << " base cases were calculated."
+                << std::endl;
+      return;
+    }
+#endif
+
     RuleType rules = RuleType(referenceTree->Dataset(),
                               querySet,
                               estimations,
@@ -355,6 +426,8 @@ Evaluate(MatType querySet, arma::vec& estimations)
     for (size_t i = 0; i < querySet.n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
 
+    rules.FlushKernelBuffer();
+
     estimations /= referenceTree->Dataset().n_cols;
     Timer::Stop("computing_kde");
 
@@ -365,6 +438,139 @@ Evaluate(MatType querySet, arma::vec& estimations)
   }
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType querySet,
+         const arma::vec& bandwidths,
+         arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // The bandwidths share one dual-tree traversal.
+  if (mode != DUAL_TREE_MODE)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: multi-bandwidth "
+                                "evaluation requires dual-tree mode");
+  }
+
+  if (bandwidths.n_elem == 0)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "bandwidth is required");
+  }
+
+  // Check querySet has at least 1 element to evaluate.
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    estimations.clear();
+    return;
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  Timer::Start("building_query_tree");
+  std::vector<size_t> oldFromNewQueries;
+  Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+  Timer::Stop("building_query_tree");
+
+  // Get estimations matrix ready; one column per bandwidth.
+  estimations.zeros(queryTree->Dataset().n_cols, bandwidths.n_elem);
+
+  Timer::Start("computing_kde");
+
+  // Evaluate.
+  typedef KDEMultiRules<MetricType, KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+  // The same subtree decomposition as in the single-bandwidth case applies:
+  // the query points of different subtrees are disjoint, so each thread
+  // writes to its own rows of the estimations matrix.
+  std::vector<Tree*> queryRoots;
+  if (omp_get_max_threads() > 1)
+    queryRoots = DecomposeTree(queryTree, 4 * omp_get_max_threads());
+  if (queryRoots.size() > 1)
+  {
+    size_t totalScores = 0, totalBaseCases = 0;
+
+    #pragma omp parallel
+    {
+      RuleType threadRules(referenceTree->Dataset(), queryTree->Dataset(),
+          estimations, relError, absError, bandwidths, metric, false);
+
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+      {
+        DualTreeTraversalType<RuleType> traverser(threadRules);
+        traverser.Traverse(*queryRoots[i], *referenceTree);
+      }
+
+      #pragma omp critical (KDEMerge)
+      {
+        totalScores += threadRules.Scores();
+        totalBaseCases += threadRules.BaseCases();
+      }
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+    Timer::Stop("computing_kde");
+
+    // Rearrange if necessary.
+    RearrangeEstimations(oldFromNewQueries, estimations);
+    delete queryTree;
+
+    Log::Info << totalScores << " node combinations were scored." << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
+    return;
+  }
+#endif
+
+  RuleType rules(referenceTree->Dataset(),
+                 queryTree->Dataset(),
+                 estimations,
+                 relError,
+                 absError,
+                 bandwidths,
+                 metric,
+                 false);
+
+  // Create traverser.
+  DualTreeTraversalType<RuleType> traverser(rules);
+  traverser.Traverse(*queryTree, *referenceTree);
+  estimations /= referenceTree->Dataset().n_cols;
+  Timer::Stop("computing_kde");
+
+  // Rearrange if necessary.
+  RearrangeEstimations(oldFromNewQueries, estimations);
+  delete queryTree;
+
+  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
+  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -422,6 +628,54 @@ Evaluate(Tree* queryTree,
 
   // Evaluate.
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+  // If we have multiple threads, decompose the query tree into disjoint
+  // subtrees and run one independent subtree-vs-reference traversal per
+  // subtree.  Each thread keeps its own rule set, and the query points of
+  // different subtrees are disjoint, so the densities can be written to
+  // directly.
+  std::vector<Tree*> queryRoots;
+  if (omp_get_max_threads() > 1)
+    queryRoots = DecomposeTree(queryTree, 4 * omp_get_max_threads());
+  if (queryRoots.size() > 1)
+  {
+    size_t totalScores = 0, totalBaseCases = 0;
+
+    #pragma omp parallel
+    {
+      // One rule set per thread, reused across all of its subtrees.
+      RuleType threadRules(referenceTree->Dataset(), queryTree->Dataset(),
+          estimations, relError, absError, metric, kernel, false);
+
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+      {
+        DualTreeTraversalType<RuleType> traverser(threadRules);
+        traverser.Traverse(*queryRoots[i], *referenceTree);
+      }
+
+      threadRules.FlushKernelBuffer();
+
+      #pragma omp critical (KDEMerge)
+      {
+        totalScores += threadRules.Scores();
+        totalBaseCases += threadRules.BaseCases();
+      }
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+    Timer::Stop("computing_kde");
+
+    // Rearrange if necessary.
+    RearrangeEstimations(oldFromNewQueries, estimations);
+
+    Log::Info << totalScores << " node combinations were scored." << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
+    return;
+  }
+#endif
+
   RuleType rules = RuleType(referenceTree->Dataset(),
                             queryTree->Dataset(),
                             estimations,
@@ -434,6 +688,7 @@ Evaluate(Tree* queryTree,
   // Create traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
   traverser.Traverse(*queryTree, *referenceTree);
+  rules.FlushKernelBuffer();
   estimations /= referenceTree->Dataset().n_cols;
   Timer::Stop("computing_kde");
 
@@ -476,6 +731,77 @@ Evaluate(arma::vec& estimations)
 
   // Evaluate.
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+#ifdef HAS_OPENMP
+  if (omp_get_max_threads() > 1)
+  {
+    // The same parallel decompositions as in the bichromatic case apply here;
+    // the query side is the reference tree itself.
+    size_t totalScores = 0, totalBaseCases = 0;
+    if (mode == DUAL_TREE_MODE)
+    {
+      std::vector<Tree*> queryRoots = DecomposeTree(referenceTree,
+          4 * omp_get_max_threads());
+
+      #pragma omp parallel
+      {
+        RuleType threadRules(referenceTree->Dataset(),
+            referenceTree->Dataset(), estimations, relError, absError, metric,
+            kernel, true);
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+        {
+          DualTreeTraversalType<RuleType> traverser(threadRules);
+          traverser.Traverse(*queryRoots[i], *referenceTree);
+        }
+
+        threadRules.FlushKernelBuffer();
+
+        #pragma omp critical (KDEMerge)
+        {
+          totalScores += threadRules.Scores();
+          totalBaseCases += threadRules.BaseCases();
+        }
+      }
+    }
+    else if (mode == SINGLE_TREE_MODE)
+    {
+      #pragma omp parallel
+      {
+        RuleType threadRules(referenceTree->Dataset(),
+            referenceTree->Dataset(), estimations, relError, absError, metric,
+            kernel, true);
+        SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t i = 0;
+             i < (omp_size_t) referenceTree->Dataset().n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+
+        threadRules.FlushKernelBuffer();
+
+        #pragma omp critical (KDEMerge)
+        {
+          totalScores += threadRules.Scores();
+          totalBaseCases += threadRules.BaseCases();
+        }
+      }
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+    // Rearrange if necessary.
+    RearrangeEstimations(*oldFromNewReferences, estimations);
+    Timer::Stop("computing_kde");
+
+    Log::Info << totalScores << " node combinations were scored."
+              << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated."
+              << std::endl;
+    return;
+  }
+#endif
+
   RuleType rules = RuleType(referenceTree->Dataset(),
                             referenceTree->Dataset(),
                             estimations,
@@ -498,6 +824,7 @@ Evaluate(arma::vec& estimations)
       traverser.Traverse(i, *referenceTree);
   }
 
+  rules.FlushKernelBuffer();
   estimations /= referenceTree->Dataset().n_cols;
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
@@ -647,5 +974,35 @@ RearrangeEstimations(const std::vector<size_t>& oldFromNew,
   }
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+RearrangeEstimations(const std::vector<size_t>& oldFromNew,
+                     arma::mat& estimations)
+{
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    const size_t nQueries = oldFromNew.size();
+    arma::mat rearrangedEstimations(nQueries, estimations.n_cols);
+
+    // Remap rows; each row holds the estimations of one query point.
+    for (size_t i = 0; i < nQueries; ++i)
+      rearrangedEstimations.row(oldFromNew.at(i)) = estimations.row(i);
+
+    estimations = std::move(rearrangedEstimations);
+  }
+}
+
 } // namespace kde
 } // namespace mlpack
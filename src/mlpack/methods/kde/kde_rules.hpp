@@ -81,6 +81,15 @@ class KDERules
   //! Get the number of scores.
   size_t Scores() const { return scores; }
 
+  /**
+   * Evaluate the kernel for any buffered base cases and add the results to
+   * the densities.  Base-case kernel evaluations are accumulated into a
+   * contiguous scratch buffer so that the kernel can be applied to many
+   * distances at once; this must be called once after a traversal finishes to
+   * account for a partially filled buffer.
+   */
+  void FlushKernelBuffer();
+
  private:
   //! Evaluate kernel value of 2 points given their indexes.
   double EvaluateKernel(const size_t queryIndex,
@@ -120,6 +129,136 @@ class KDERules
   //! The last reference index.
   size_t lastReferenceIndex;
 
+  //! Number of base cases buffered before the kernel is evaluated over the
+  //! whole scratch buffer at once.
+  static const size_t scratchSize = 256;
+
+  //! Scratch buffer of base-case distances awaiting kernel evaluation.
+  arma::vec scratchDistances;
+
+  //! Query index of each buffered base case.
+  arma::Col<size_t> scratchQueries;
+
+  //! Scratch buffer for batched kernel values.
+  arma::vec scratchKernelValues;
+
+  //! Number of base cases currently buffered.
+  size_t numBuffered;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
+/**
+ * A dual-tree traversal Rules class for evaluating kernel density estimates
+ * for several bandwidths at once.  One traversal is shared by all the
+ * bandwidths: each base case computes the point-to-point distance once and
+ * updates the accumulator of every bandwidth from it, and a node combination
+ * is only pruned when the error bound of every bandwidth allows it (i.e. the
+ * prune is decided by the loosest bandwidth still needing refinement).
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiRules
+{
+ public:
+  /**
+   * Construct KDEMultiRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; entry (i, j)
+   *                  accumulates the density of query point i for bandwidth
+   *                  j.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param bandwidths Kernel bandwidths to evaluate.
+   * @param metric Instantiated metric.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiRules(const arma::mat& referenceSet,
+                const arma::mat& querySet,
+                arma::mat& densities,
+                const double relError,
+                const double absError,
+                const arma::vec& bandwidths,
+                MetricType& metric,
+                const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! DoubleTree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! DoubleTree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+ private:
+  //! Check whether a node combination at the given distance bounds can be
+  //! pruned for every bandwidth at once.
+  bool CanPrune(const double minDistance, const double maxDistance) const;
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values; one column per bandwidth.
+  arma::mat& densities;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Relatve error tolerance.
+  const double relError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! One instantiated kernel per bandwidth.
+  std::vector<KernelType> kernels;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
   //! Traversal information.
   TraversalInfoType traversalInfo;
 
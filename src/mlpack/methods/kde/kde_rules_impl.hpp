@@ -16,9 +16,48 @@
 // In case it hasn't been included yet.
 #include "kde_rules.hpp"
 
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/epanechnikov_kernel.hpp>
+
 namespace mlpack {
 namespace kde {
 
+//! Evaluate the kernel over a contiguous buffer of distances.  Generic
+//! version: one scalar evaluation per distance.
+template<typename KernelType>
+inline void BatchEvaluateKernel(KernelType& kernel,
+                                const arma::vec& distances,
+                                const size_t count,
+                                arma::vec& values)
+{
+  for (size_t i = 0; i < count; ++i)
+    values[i] = kernel.Evaluate(distances[i]);
+}
+
+//! For the Gaussian kernel the whole buffer reduces to a single vectorized
+//! exp.
+template<>
+inline void BatchEvaluateKernel(kernel::GaussianKernel& kernel,
+                                const arma::vec& distances,
+                                const size_t count,
+                                arma::vec& values)
+{
+  values.head(count) = arma::exp(kernel.Gamma() *
+      arma::square(distances.head(count)));
+}
+
+//! For the Epanechnikov kernel the whole buffer reduces to a clamped
+//! vectorized polynomial.
+template<>
+inline void BatchEvaluateKernel(kernel::EpanechnikovKernel& kernel,
+                                const arma::vec& distances,
+                                const size_t count,
+                                arma::vec& values)
+{
+  values.head(count) = arma::clamp(1.0 -
+      arma::square(distances.head(count) / kernel.Bandwidth()), 0.0, 1.0);
+}
+
 template<typename MetricType, typename KernelType, typename TreeType>
 KDERules<MetricType, KernelType, TreeType>::KDERules(
     const arma::mat& referenceSet,
@@ -39,6 +78,10 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
+    scratchDistances(scratchSize),
+    scratchQueries(scratchSize),
+    scratchKernelValues(scratchSize),
+    numBuffered(0),
     baseCases(0),
     scores(0)
 {
@@ -61,10 +104,14 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return 0.0;
 
-  // Calculations.
+  // Compute the distance now, but buffer it so that the kernel is evaluated
+  // over a whole contiguous block of distances at once.
   const double distance = metric.Evaluate(querySet.col(queryIndex),
                                           referenceSet.col(referenceIndex));
-  densities(queryIndex) += kernel.Evaluate(distance);
+  scratchDistances[numBuffered] = distance;
+  scratchQueries[numBuffered] = queryIndex;
+  if (++numBuffered == scratchSize)
+    FlushKernelBuffer();
 
   ++baseCases;
   lastQueryIndex = queryIndex;
@@ -72,6 +119,17 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   return distance;
 }
 
+//! Evaluate the kernel for all buffered base cases.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline void KDERules<MetricType, KernelType, TreeType>::FlushKernelBuffer()
+{
+  BatchEvaluateKernel(kernel, scratchDistances, numBuffered,
+      scratchKernelValues);
+  for (size_t i = 0; i < numBuffered; ++i)
+    densities(scratchQueries[i]) += scratchKernelValues[i];
+  numBuffered = 0;
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename KernelType, typename TreeType>
 inline double KDERules<MetricType, KernelType, TreeType>::
@@ -224,6 +282,193 @@ Rescore(TreeType& /*queryNode*/,
   return oldScore;
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiRules<MetricType, KernelType, TreeType>::KDEMultiRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    arma::mat& densities,
+    const double relError,
+    const double absError,
+    const arma::vec& bandwidths,
+    MetricType& metric,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    absError(absError),
+    relError(relError),
+    metric(metric),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  kernels.reserve(bandwidths.n_elem);
+  for (size_t b = 0; b < bandwidths.n_elem; ++b)
+    kernels.emplace_back(bandwidths[b]);
+}
+
+//! The multi-bandwidth base case: one distance, every accumulator.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and shared by all the bandwidths.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t b = 0; b < kernels.size(); ++b)
+    densities(queryIndex, b) += kernels[b].Evaluate(distance);
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  return distance;
+}
+
+//! Check the prune bound of every bandwidth.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline bool KDEMultiRules<MetricType, KernelType, TreeType>::CanPrune(
+    const double minDistance, const double maxDistance) const
+{
+  // The prune must hold for every bandwidth, so it is decided by the loosest
+  // one; the loop fails fast on the first bandwidth that still needs
+  // refinement.
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    const double maxKernel = kernels[b].Evaluate(minDistance);
+    const double minKernel = kernels[b].Evaluate(maxDistance);
+    if ((maxKernel - minKernel) >
+        (absError + relError * minKernel) / referenceSet.n_cols)
+      return false;
+  }
+  return true;
+}
+
+//! Multi-bandwidth single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const double minDistance = referenceNode.MinDistance(queryPoint);
+  double score;
+
+  if (CanPrune(minDistance, referenceNode.MaxDistance(queryPoint)))
+  {
+    // Compute the distance to the node centroid once, and estimate every
+    // bandwidth from it.
+    double centroidDistance;
+    if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
+    {
+      centroidDistance = metric.Evaluate(queryPoint,
+          referenceSet.unsafe_col(referenceNode.Point(0)));
+    }
+    else
+    {
+      centroidDistance = metric.Evaluate(queryPoint,
+          referenceNode.Stat().Centroid());
+    }
+
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      densities(queryIndex, b) += referenceNode.NumDescendants() *
+          kernels[b].Evaluate(centroidDistance);
+    }
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::Rescore(
+    const size_t /* queryIndex */,
+    TreeType& /* referenceNode */,
+    const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-bandwidth double-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  const double minDistance = queryNode.MinDistance(referenceNode);
+  double score;
+
+  if (CanPrune(minDistance, queryNode.MaxDistance(referenceNode)))
+  {
+    // Compute the centroid-to-centroid distance once, and estimate every
+    // bandwidth from it.
+    double centroidDistance;
+    if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
+    {
+      centroidDistance = metric.Evaluate(
+          querySet.unsafe_col(queryNode.Point(0)),
+          referenceSet.unsafe_col(referenceNode.Point(0)));
+    }
+    else
+    {
+      centroidDistance = metric.Evaluate(queryNode.Stat().Centroid(),
+          referenceNode.Stat().Centroid());
+    }
+
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      const double contribution = referenceNode.NumDescendants() *
+          kernels[b].Evaluate(centroidDistance);
+      for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+        densities(queryNode.Descendant(i), b) += contribution;
+    }
+
+    score = DBL_MAX;
+  }
+  else
+  {
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-bandwidth double-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
 template<typename MetricType, typename KernelType, typename TreeType>
 inline force_inline double KDERules<MetricType, KernelType, TreeType>::
 EvaluateKernel(const size_t queryIndex,
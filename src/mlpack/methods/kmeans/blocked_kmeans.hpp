@@ -0,0 +1,91 @@
+/**
+ * @file blocked_kmeans.hpp
+ *
+ * An implementation of a single step of the Lloyd algorithm for k-means
+ * clustering that blocks points and centroids into cache-sized tiles and
+ * computes assignments with a matrix-multiplication-based distance kernel.
+ * This is usually the fastest choice for dense data with many clusters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of Lloyd's algorithm for
+ * k-means that assigns points to centroids a block at a time.  For a block of
+ * points X and the centroid matrix C, the squared distances are computed as
+ * ||c||^2 - 2 * C^T * X (the ||x||^2 term is constant per point and does not
+ * affect the argmin), so the inner loop becomes a dense matrix multiplication
+ * instead of one metric evaluation per (point, centroid) pair.  Blocks are
+ * processed in parallel with per-thread centroid accumulators that are
+ * reduced at the end of the iteration.
+ *
+ * Because the expansion of the squared distance is specific to the Euclidean
+ * metric, this class may only be used with the L2 metric; this is enforced at
+ * compile time.  For other metrics, use NaiveKMeans instead.  The results are
+ * identical to those of NaiveKMeans.
+ *
+ * @param MetricType Type of metric used with this implementation (must be
+ *     metric::EuclideanDistance).
+ * @param MatType Matrix type (arma::mat).
+ */
+template<typename MetricType, typename MatType>
+class BlockedKMeans
+{
+ public:
+  /**
+   * Construct the BlockedKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  BlockedKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of the Lloyd algorithm, updating the given
+   * centroids into the newCentroids matrix.  If any cluster is empty (that
+   * is, if any cluster has no points assigned to it), then the centroid
+   * associated with that cluster may be filled with invalid data (it will be
+   * corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the
+   *     iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The number of points assigned per tile; chosen so that a tile of points
+  //! plus the corresponding block of the distance matrix stay cache-resident.
+  static const size_t blockSize = 256;
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_kmeans_impl.hpp"
+
+#endif
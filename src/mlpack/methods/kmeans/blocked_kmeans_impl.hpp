@@ -0,0 +1,113 @@
+/**
+ * @file blocked_kmeans_impl.hpp
+ *
+ * An implementation of a single step of the Lloyd algorithm for k-means
+ * clustering that blocks points and centroids into cache-sized tiles and
+ * computes assignments with a matrix-multiplication-based distance kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_kmeans.hpp"
+
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+BlockedKMeans<MetricType, MatType>::BlockedKMeans(const MatType& dataset,
+                                                  MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{
+  static_assert(std::is_same<MetricType, metric::EuclideanDistance>::value,
+      "BlockedKMeans may only be used with the Euclidean (L2) metric, because "
+      "its distance kernel expands the squared L2 distance; use NaiveKMeans "
+      "for other metrics.");
+}
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double BlockedKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // The squared centroid norms are shared by every tile; the per-point
+  // ||x||^2 term is dropped entirely since it does not affect the argmin.
+  const arma::vec centroidNorms = arma::sum(arma::square(centroids), 0).t();
+
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  // Tiles are assigned in parallel; each thread accumulates into its own
+  // centroid sums, which are reduced once at the end of the iteration.
+  #pragma omp parallel
+  {
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t start = block * blockSize;
+      const size_t end = std::min(start + blockSize, (size_t) dataset.n_cols);
+
+      // One GEMM scores the whole tile against every centroid:
+      // scores(j, i) = ||c_j||^2 - 2 <c_j, x_i>, which orders centroids for
+      // point i identically to the squared Euclidean distance.
+      arma::mat scores = (-2.0 * centroids.t()) * dataset.cols(start, end - 1);
+      scores.each_col() += centroidNorms;
+
+      for (size_t i = start; i < end; ++i)
+      {
+        arma::uword closestCluster;
+        scores.unsafe_col(i - start).min(closestCluster);
+
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  // Now normalize the centroid.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    if (counts(i) != 0)
+      newCentroids.col(i) /= counts(i);
+
+  distanceCalculations += centroids.n_cols * dataset.n_cols;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -136,9 +136,15 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
 
     Timer::Stop("knn");
 
+    // The maintenance pass over the point tree updates each subtree
+    // independently, so it is task-parallel; open the region here and let
+    // UpdateTree() spawn tasks for the recursion.
+    #pragma omp parallel default(shared)
+    #pragma omp single
     UpdateTree(*tree, centroids);
 
-    for (size_t i = 0; i < dataset.n_cols; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
       visited[i] = false;
   }
   else
@@ -176,10 +182,12 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
   counts.zeros(centroids.n_cols);
   ExtractCentroids(*tree, newCentroids, counts, centroids);
 
-  // Now, calculate how far the clusters moved, after normalizing them.
+  // Now, calculate how far the clusters moved, after normalizing them.  Each
+  // cluster is independent, so the movements are computed in parallel.
   double residual = 0.0;
-  clusterDistances[centroids.n_cols] = 0.0;
-  for (size_t c = 0; c < centroids.n_cols; ++c)
+  double maxMovement = 0.0;
+  #pragma omp parallel for reduction(+:residual) reduction(max:maxMovement)
+  for (omp_size_t c = 0; c < (omp_size_t) centroids.n_cols; ++c)
   {
     if (counts[c] == 0)
     {
@@ -193,10 +201,11 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
       clusterDistances[c] = movement;
       residual += std::pow(movement, 2.0);
 
-      if (movement > clusterDistances[centroids.n_cols])
-        clusterDistances[centroids.n_cols] = movement;
+      if (movement > maxMovement)
+        maxMovement = movement;
     }
   }
+  clusterDistances[centroids.n_cols] = maxMovement;
   distanceCalculations += centroids.n_cols;
 
   delete centroidTree;
@@ -328,6 +337,8 @@ visited[node.Descendant(i)] << ".\n";
                    node.MaxDistance(centroids.col(node.Stat().Owner())));
       adjustedUpperBound = node.Stat().UpperBound();
 
+      // This may run inside a task; the counter is shared.
+      #pragma omp atomic
       ++distanceCalculations;
       if (node.Stat().UpperBound() < node.Stat().LowerBound())
         node.Stat().StaticPruned() = true;
@@ -339,12 +350,21 @@ visited[node.Descendant(i)] << ".\n";
   }
 
   // Recurse into children, and if all the children (and all the points) are
-  // pruned, then we can mark this as statically pruned.
-  bool allChildrenPruned = true;
+  // pruned, then we can mark this as statically pruned.  The subtrees are
+  // disjoint, so each child update may run as a task; small subtrees are not
+  // worth the spawn overhead and run inline.
   for (size_t i = 0; i < node.NumChildren(); ++i)
   {
+    #pragma omp task default(shared) firstprivate(i) \
+        if (node.Child(i).NumDescendants() > 512)
     UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
         adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
+  }
+  #pragma omp taskwait
+
+  bool allChildrenPruned = true;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
     if (!node.Child(i).Stat().StaticPruned())
       allChildrenPruned = false;
   }
@@ -400,6 +420,7 @@ visited[node.Descendant(i)] << ".\n";
         // Attempt to tighten the bound.
         upperBounds[index] = metric.Evaluate(dataset.col(index),
                                              centroids.col(owner));
+        #pragma omp atomic
         ++distanceCalculations;
         if (upperBounds[index] < pruningLowerBound)
         {
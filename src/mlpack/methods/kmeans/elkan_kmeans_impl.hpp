@@ -60,6 +60,21 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     upperBounds.fill(DBL_MAX);
     assignments.fill(0);
   }
+  else if (lowerBounds.n_cols < dataset.n_cols)
+  {
+    // Points were appended to the dataset since the last iteration.  The
+    // bounds of the existing points are still valid, so initialize bounds for
+    // the new points only: a lower bound of 0 and an upper bound of DBL_MAX
+    // force a full recalculation for exactly those points.
+    const size_t oldPoints = lowerBounds.n_cols;
+    lowerBounds.resize(centroids.n_cols, dataset.n_cols);
+    upperBounds.resize(dataset.n_cols);
+    assignments.resize(dataset.n_cols);
+
+    lowerBounds.cols(oldPoints, dataset.n_cols - 1).zeros();
+    upperBounds.subvec(oldPoints, dataset.n_cols - 1).fill(DBL_MAX);
+    assignments.subvec(oldPoints, dataset.n_cols - 1).zeros();
+  }
 
   // Step 1: for all centers, compute between-cluster distances.  For all
   // centers, compute s(c) = 1/2 min d(c, c').
@@ -44,6 +44,21 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     assignments.zeros(dataset.n_cols);
     minClusterDistances.set_size(centroids.n_cols);
   }
+  else if (upperBounds.n_elem < dataset.n_cols)
+  {
+    // Points were appended to the dataset since the last iteration.  The
+    // bounds of the existing points are still valid, so initialize bounds for
+    // the new points only: a lower bound of 0 and an upper bound of DBL_MAX
+    // force a full recalculation for exactly those points.
+    const size_t oldPoints = upperBounds.n_elem;
+    upperBounds.resize(dataset.n_cols);
+    lowerBounds.resize(dataset.n_cols);
+    assignments.resize(dataset.n_cols);
+
+    upperBounds.subvec(oldPoints, dataset.n_cols - 1).fill(DBL_MAX);
+    lowerBounds.subvec(oldPoints, dataset.n_cols - 1).zeros();
+    assignments.subvec(oldPoints, dataset.n_cols - 1).zeros();
+  }
 
   // Reset new centroids.
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
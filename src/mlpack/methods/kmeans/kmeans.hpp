@@ -63,7 +63,7 @@ namespace kmeans /** K-Means clustering. */ {
  * @tparam LloydStepType Implementation of single Lloyd step to use.
  *
  * @see RandomPartition, SampleInitialization, RefinedStart, AllowEmptyClusters,
- *      MaxVarianceNewCluster, NaiveKMeans, ElkanKMeans
+ *      MaxVarianceNewCluster, NaiveKMeans, BlockedKMeans, ElkanKMeans
  */
 template<typename MetricType = metric::EuclideanDistance,
          typename InitialPartitionPolicy = SampleInitialization,
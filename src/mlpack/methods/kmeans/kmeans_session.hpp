@@ -0,0 +1,166 @@
+/**
+ * @file kmeans_session.hpp
+ *
+ * A resumable k-means clustering session.  Unlike KMeans::Cluster(), which
+ * constructs a fresh Lloyd step object (and therefore fresh Elkan/Hamerly
+ * bounds) on every call, a KMeansSession keeps the Lloyd step object alive
+ * between calls to Cluster().  This means that when a handful of points are
+ * appended to the dataset, the bounds of all pre-existing points are retained
+ * and only the appended points pay for a full distance recalculation, so the
+ * clustering typically reconverges in very few iterations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_SESSION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_SESSION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "sample_initialization.hpp"
+#include "max_variance_new_cluster.hpp"
+#include "elkan_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * A resumable k-means clustering session for datasets that grow over time.
+ *
+ * The session holds a reference to the dataset and owns both the centroids and
+ * the Lloyd step object.  The first call to Cluster() initializes the
+ * centroids with the InitialPartitionPolicy and iterates to convergence like
+ * KMeans::Cluster().  After that, the caller may append columns to the same
+ * dataset matrix (e.g. with insert_cols()) and call Cluster() again; the
+ * bound-based Lloyd steps (ElkanKMeans, HamerlyKMeans) will initialize bounds
+ * lazily for the appended points while keeping the valid bounds of all
+ * existing points, because the retained bounds were last updated against
+ * exactly the centroids the session resumes from.
+ *
+ * A simple example of usage:
+ *
+ * @code
+ * arma::mat data; // Dataset we want to cluster incrementally.
+ * KMeansSession<> session(data, 3); // 3 clusters; Elkan's algorithm.
+ * session.Cluster(); // Cluster from scratch.
+ *
+ * data.insert_cols(data.n_cols, newPoints); // Append today's points.
+ * session.Cluster(); // Reconverge; existing bounds are reused.
+ * @endcode
+ *
+ * Note that the session is only valid for the dataset it was constructed
+ * with: points may be appended between calls to Cluster(), but existing
+ * columns must not be modified or removed, and the centroids must not be
+ * changed externally, since the persisted bounds are only correct with
+ * respect to the session's own centroids.
+ *
+ * @tparam MetricType The distance metric to use for this session; see
+ *     metric::LMetric for an example.
+ * @tparam InitialPartitionPolicy Initial partitioning policy; see KMeans.
+ * @tparam EmptyClusterPolicy Policy for what to do on an empty cluster; see
+ *     KMeans.
+ * @tparam LloydStepType Implementation of single Lloyd step to use.  Only the
+ *     bound-based implementations (ElkanKMeans, HamerlyKMeans) benefit from
+ *     resumption, but any Lloyd step type will work.
+ *
+ * @see KMeans, ElkanKMeans, HamerlyKMeans
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename InitialPartitionPolicy = SampleInitialization,
+         typename EmptyClusterPolicy = MaxVarianceNewCluster,
+         template<class, class> class LloydStepType = ElkanKMeans,
+         typename MatType = arma::mat>
+class KMeansSession
+{
+ public:
+  /**
+   * Create a k-means session for the given dataset.  The dataset is not
+   * copied; the session holds a reference to it, so that columns appended to
+   * the matrix between calls to Cluster() are picked up automatically.
+   *
+   * @param dataset Dataset to cluster; must outlive the session.
+   * @param clusters Number of clusters to compute.
+   * @param maxIterations Maximum number of iterations allowed per call to
+   *     Cluster() (0 is valid, but the algorithm may never terminate).
+   * @param metric Optional MetricType object; for when the metric has state
+   *     it needs to store.
+   * @param partitioner Optional InitialPartitionPolicy object; for when a
+   *     specially initialized partitioning policy is required.
+   * @param emptyClusterAction Optional EmptyClusterPolicy object; for when a
+   *     specially initialized empty cluster policy is required.
+   */
+  KMeansSession(const MatType& dataset,
+                const size_t clusters,
+                const size_t maxIterations = 1000,
+                const MetricType metric = MetricType(),
+                const InitialPartitionPolicy partitioner =
+                    InitialPartitionPolicy(),
+                const EmptyClusterPolicy emptyClusterAction =
+                    EmptyClusterPolicy());
+
+  /**
+   * Run Lloyd iterations until convergence (or until the maximum number of
+   * iterations is reached).  The first call initializes the centroids with
+   * the InitialPartitionPolicy; subsequent calls resume from the centroids
+   * and bounds left by the previous call, which is cheap when only a few
+   * points have been appended to the dataset.
+   *
+   * @return The number of iterations performed by this call.
+   */
+  size_t Cluster();
+
+  /**
+   * Compute the cluster assignment of every point in the dataset against the
+   * session's current centroids.
+   *
+   * @param assignments Vector to store cluster assignments in.
+   */
+  void Assignments(arma::Row<size_t>& assignments) const;
+
+  //! Get the current centroids (empty before the first call to Cluster()).
+  const arma::mat& Centroids() const { return centroids; }
+
+  //! Get the number of clusters.
+  size_t Clusters() const { return clusters; }
+
+  //! Get the maximum number of iterations per call to Cluster().
+  size_t MaxIterations() const { return maxIterations; }
+  //! Set the maximum number of iterations per call to Cluster().
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the distance metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the distance metric.
+  MetricType& Metric() { return metric; }
+
+ private:
+  //! The dataset being clustered; columns may be appended between calls.
+  const MatType& dataset;
+  //! Number of clusters to compute.
+  size_t clusters;
+  //! Maximum number of iterations per call to Cluster().
+  size_t maxIterations;
+  //! Instantiated distance metric.
+  MetricType metric;
+  //! Instantiated initial partitioning policy.
+  InitialPartitionPolicy partitioner;
+  //! Instantiated empty cluster policy.
+  EmptyClusterPolicy emptyClusterAction;
+  //! The Lloyd step object; kept alive so its bounds persist across calls.
+  LloydStepType<MetricType, MatType> lloydStep;
+  //! The current centroids.
+  arma::mat centroids;
+  //! Whether the centroids have been initialized yet.
+  bool initialized;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_session_impl.hpp"
+
+#endif // MLPACK_METHODS_KMEANS_KMEANS_SESSION_HPP
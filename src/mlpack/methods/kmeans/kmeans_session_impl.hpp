@@ -0,0 +1,203 @@
+/**
+ * @file kmeans_session_impl.hpp
+ *
+ * Implementation of the resumable k-means clustering session.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_SESSION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_SESSION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_session.hpp"
+
+// For GetInitialAssignmentsOrCentroids().
+#include "kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+KMeansSession<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+KMeansSession(const MatType& dataset,
+              const size_t clusters,
+              const size_t maxIterations,
+              const MetricType metric,
+              const InitialPartitionPolicy partitioner,
+              const EmptyClusterPolicy emptyClusterAction) :
+    dataset(dataset),
+    clusters(clusters),
+    maxIterations(maxIterations),
+    metric(metric),
+    partitioner(partitioner),
+    emptyClusterAction(emptyClusterAction),
+    lloydStep(dataset, this->metric),
+    initialized(false)
+{
+  if (clusters == 0)
+    Log::Warn << "KMeansSession: zero clusters requested.  This probably "
+        << "isn't going to work.  Brace for crash." << std::endl;
+}
+
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+size_t KMeansSession<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::Cluster()
+{
+  if (clusters > dataset.n_cols)
+    Log::Warn << "KMeansSession::Cluster(): more clusters requested than "
+        << "points given." << std::endl;
+
+  // On the first call, use the partitioner to come up with initial centroids.
+  // Later calls resume from the centroids (and the Lloyd step's bounds) left
+  // by the previous call.
+  if (!initialized)
+  {
+    arma::Row<size_t> assignments;
+    bool gotAssignments = GetInitialAssignmentsOrCentroids(partitioner,
+        dataset, clusters, assignments, centroids);
+    if (gotAssignments)
+    {
+      // The partitioner gives assignments, so we need to calculate centroids
+      // from those assignments.
+      arma::Row<size_t> counts;
+      counts.zeros(clusters);
+      centroids.zeros(dataset.n_rows, clusters);
+      for (size_t i = 0; i < dataset.n_cols; ++i)
+      {
+        centroids.col(assignments[i]) += arma::vec(dataset.col(i));
+        counts[assignments[i]]++;
+      }
+
+      for (size_t i = 0; i < clusters; ++i)
+        if (counts[i] != 0)
+          centroids.col(i) /= counts[i];
+    }
+
+    initialized = true;
+  }
+
+  // Counts of points in each cluster.
+  arma::Col<size_t> counts(clusters);
+
+  size_t iteration = 0;
+
+  arma::mat centroidsOther;
+  double cNorm;
+
+  do
+  {
+    // We have two centroid matrices.  We don't want to copy anything, so,
+    // depending on the iteration number, we use a different centroid matrix...
+    if (iteration % 2 == 0)
+      cNorm = lloydStep.Iterate(centroids, centroidsOther, counts);
+    else
+      cNorm = lloydStep.Iterate(centroidsOther, centroids, counts);
+
+    // If we are not allowing empty clusters, then check that all of our
+    // clusters have points.
+    for (size_t i = 0; i < counts.n_elem; i++)
+    {
+      if (counts[i] == 0)
+      {
+        Log::Info << "Cluster " << i << " is empty.\n";
+        if (iteration % 2 == 0)
+          emptyClusterAction.EmptyCluster(dataset, i, centroids,
+              centroidsOther, counts, metric, iteration);
+        else
+          emptyClusterAction.EmptyCluster(dataset, i, centroidsOther,
+              centroids, counts, metric, iteration);
+      }
+    }
+
+    iteration++;
+    Log::Info << "KMeansSession::Cluster(): iteration " << iteration
+        << ", residual " << cNorm << ".\n";
+    if (std::isnan(cNorm) || std::isinf(cNorm))
+      cNorm = 1e-4; // Keep iterating.
+  } while (cNorm > 1e-5 && iteration != maxIterations);
+
+  // If we ended on an even iteration, then the centroids are in the
+  // centroidsOther matrix, and we need to steal its memory (steal_mem() avoids
+  // a copy if possible).
+  if ((iteration - 1) % 2 == 0)
+    centroids.steal_mem(centroidsOther);
+
+  if (iteration != maxIterations)
+  {
+    Log::Info << "KMeansSession::Cluster(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "KMeansSession::Cluster(): terminated after limit of "
+        << iteration << " iterations." << std::endl;
+  }
+  Log::Info << lloydStep.DistanceCalculations() << " distance calculations."
+      << std::endl;
+
+  return iteration;
+}
+
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeansSession<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::Assignments(arma::Row<size_t>& assignments) const
+{
+  // Calculate assignments in parallel over the entire dataset.
+  assignments.set_size(dataset.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+  {
+    // Find the closest centroid to this point.
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; j++)
+    {
+      const double distance = metric.Evaluate(dataset.col(i),
+          centroids.col(j));
+
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_KMEANS_KMEANS_SESSION_IMPL_HPP
@@ -15,6 +15,7 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/batch_distance.hpp>
 
 namespace mlpack {
 namespace kmeans {
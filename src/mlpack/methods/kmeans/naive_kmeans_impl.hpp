@@ -47,24 +47,18 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::vec distances(centroids.n_cols);
 
     #pragma omp for
     for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
-
-      for (size_t j = 0; j < centroids.n_cols; j++)
-      {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
-        {
-          minDistance = distance;
-          closestCluster = j;
-        }
-      }
+      // Find the closest centroid to this point.  All the distances to this
+      // point are computed in one batch, which is vectorized for the L
+      // metrics.
+      metric::BatchDistance<MetricType>::OneToMany(dataset.col(i), centroids,
+          distances, metric);
+      arma::uword closestCluster;
+      distances.min(closestCluster);
 
       Log::Assert(closestCluster != centroids.n_cols);
 
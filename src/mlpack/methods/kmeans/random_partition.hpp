@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KMEANS_RANDOM_PARTITION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -30,9 +31,9 @@ class RandomPartition
   RandomPartition() { }
 
   /**
-   * Partition the given dataset into the given number of clusters.  Assignments
-   * are random, and the number of points in each cluster should be equal (or
-   * approximately equal).
+   * Partition the given dataset into the given number of clusters.  Each
+   * point is assigned independently and uniformly at random, so the clusters
+   * are approximately equal in size.
    *
    * @tparam MatType Type of data (arma::mat or arma::sp_mat).
    * @param data Dataset to partition.
@@ -45,9 +46,16 @@ class RandomPartition
                              const size_t clusters,
                              arma::Row<size_t>& assignments)
   {
-    // Implementation is so simple we'll put it here in the header file.
-    assignments = arma::shuffle(arma::linspace<arma::Row<size_t>>(0,
-        (clusters - 1), data.n_cols));
+    assignments.set_size(data.n_cols);
+
+    // Each point's assignment is drawn from its own counter-based stream, so
+    // the partition is reproducible no matter how many threads are used.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      math::RandomStream stream(i);
+      assignments[i] = (size_t) stream.RandInt((int) clusters);
+    }
   }
 
   //! Serialize the partitioner (nothing to do).
@@ -0,0 +1,112 @@
+/**
+ * @file scalable_initialization.hpp
+ *
+ * An implementation of the k-means|| initialization strategy of Bahmani et
+ * al., which oversamples candidate centroids in a small number of passes over
+ * the data and then reclusters the weighted candidates.  This produces seeds
+ * of k-means++ quality but parallelizes over the dataset, which matters when
+ * both the dataset and the number of clusters are large.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * A scalable k-means++-style approach for choosing initial points for k-means
+ * clustering.  Instead of the k sequential passes of k-means++, this samples
+ * roughly (oversamplingFactor * clusters) candidate centroids per round for a
+ * small fixed number of rounds, with each point sampled proportionally to its
+ * squared distance from the current candidate set.  The candidates are then
+ * weighted by the number of points they attract and reclustered with a
+ * weighted k-means++ pass followed by weighted Lloyd iterations, which is
+ * cheap because the candidate set is small.  The expensive per-point distance
+ * updates are parallelized with OpenMP.  It is an implementation of the
+ * following paper:
+ *
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   year={2012}
+ * }
+ */
+class ScalableInitialization
+{
+ public:
+  /**
+   * Create the ScalableInitialization object, optionally specifying the
+   * number of sampling rounds and the oversampling factor.  Each round
+   * samples an expected (oversamplingFactor * clusters) candidates; the paper
+   * suggests that around five rounds with a factor of two are sufficient.
+   */
+  ScalableInitialization(const size_t rounds = 5,
+                         const double oversamplingFactor = 2.0) :
+      rounds(rounds), oversamplingFactor(oversamplingFactor) { }
+
+  /**
+   * Initialize the centroids matrix using the k-means|| oversampling scheme.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset to partition.
+   * @param clusters Number of clusters to split dataset into.
+   * @param centroids Matrix to store centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds that will be performed.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds that will be performed.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor (candidates per cluster per round).
+  double OversamplingFactor() const { return oversamplingFactor; }
+  //! Modify the oversampling factor.
+  double& OversamplingFactor() { return oversamplingFactor; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(rounds);
+    ar & BOOST_SERIALIZATION_NVP(oversamplingFactor);
+  }
+
+ private:
+  /**
+   * Update each point's squared distance to the candidate set, given the
+   * columns of newCandidates that were just added.  This is the dominant cost
+   * of the algorithm and runs in parallel over the points.
+   */
+  template<typename MatType>
+  static void UpdateDistances(const MatType& data,
+                              const arma::mat& newCandidates,
+                              arma::vec& sqDistances);
+
+  //! The number of sampling rounds to perform.
+  size_t rounds;
+  //! The expected number of candidates per cluster sampled in each round.
+  double oversamplingFactor;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "scalable_initialization_impl.hpp"
+
+#endif
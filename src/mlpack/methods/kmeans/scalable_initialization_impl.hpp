@@ -0,0 +1,203 @@
+/**
+ * @file scalable_initialization_impl.hpp
+ *
+ * An implementation of the k-means|| initialization strategy of Bahmani et
+ * al., which oversamples candidate centroids in a small number of passes over
+ * the data and then reclusters the weighted candidates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "scalable_initialization.hpp"
+
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+//! Choose initial centroids with the k-means|| oversampling scheme.
+template<typename MatType>
+void ScalableInitialization::Cluster(const MatType& data,
+                                     const size_t clusters,
+                                     arma::mat& centroids) const
+{
+  // Start the candidate set from one uniformly random point.
+  arma::mat candidates(data.n_rows, 1);
+  candidates.col(0) = data.col(math::RandInt(0, data.n_cols));
+
+  arma::vec sqDistances(data.n_cols);
+  sqDistances.fill(std::numeric_limits<double>::max());
+  UpdateDistances(data, candidates, sqDistances);
+
+  for (size_t round = 0; round < rounds; ++round)
+  {
+    const double potential = arma::accu(sqDistances);
+    if (potential == 0.0)
+      break; // Every point coincides with a candidate already.
+
+    // Sample each point independently with probability
+    // min(1, oversamplingFactor * clusters * d^2 / potential).  The global
+    // random number generator is not thread-safe, so this cheap O(n) pass
+    // stays serial; the distance updates below are the expensive part and
+    // run in parallel.
+    const double scale = oversamplingFactor * clusters / potential;
+    std::vector<size_t> sampled;
+    for (size_t i = 0; i < data.n_cols; ++i)
+      if (math::Random() < scale * sqDistances[i])
+        sampled.push_back(i);
+
+    if (sampled.empty())
+      continue;
+
+    arma::mat newCandidates(data.n_rows, sampled.size());
+    for (size_t i = 0; i < sampled.size(); ++i)
+      newCandidates.col(i) = data.col(sampled[i]);
+
+    UpdateDistances(data, newCandidates, sqDistances);
+    candidates = arma::join_rows(candidates, newCandidates);
+  }
+
+  // If sampling produced too few candidates (tiny datasets or degenerate
+  // parameters), top the candidate set up with random points.
+  while (candidates.n_cols < clusters)
+  {
+    arma::mat extra(data.n_rows, 1);
+    extra.col(0) = data.col(math::RandInt(0, data.n_cols));
+    UpdateDistances(data, extra, sqDistances);
+    candidates = arma::join_rows(candidates, extra);
+  }
+
+  // Weight each candidate by the number of points it attracts.  This is the
+  // other full pass over the data and uses the same per-thread accumulator
+  // scheme as NaiveKMeans.
+  arma::vec weights(candidates.n_cols, arma::fill::zeros);
+  #pragma omp parallel
+  {
+    arma::vec localWeights(candidates.n_cols, arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      double minDistance = std::numeric_limits<double>::max();
+      size_t closest = 0;
+      for (size_t j = 0; j < candidates.n_cols; ++j)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), candidates.unsafe_col(j));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          closest = j;
+        }
+      }
+
+      localWeights[closest] += 1.0;
+    }
+
+    #pragma omp critical
+    {
+      weights += localWeights;
+    }
+  }
+
+  // Now recluster the weighted candidates down to the requested number of
+  // centroids.  The candidate set is small (roughly rounds *
+  // oversamplingFactor * clusters points), so this is done serially:
+  // weighted k-means++ seeding followed by weighted Lloyd iterations.
+  centroids.set_size(data.n_rows, clusters);
+
+  // Seed the first centroid proportionally to candidate weight, the rest
+  // proportionally to weight times squared distance from the chosen set.
+  arma::vec candidateSqDist(candidates.n_cols);
+  candidateSqDist.fill(std::numeric_limits<double>::max());
+  arma::vec sampleProbs = weights;
+  for (size_t i = 0; i < clusters; ++i)
+  {
+    double target = math::Random() * arma::accu(sampleProbs);
+    size_t chosen = 0;
+    for (size_t j = 0; j < sampleProbs.n_elem; ++j)
+    {
+      target -= sampleProbs[j];
+      if (target <= 0.0)
+      {
+        chosen = j;
+        break;
+      }
+    }
+
+    centroids.col(i) = candidates.col(chosen);
+
+    // Update each candidate's squared distance to the chosen set, and with it
+    // the sampling probabilities for the next centroid.
+    for (size_t j = 0; j < candidates.n_cols; ++j)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          candidates.unsafe_col(j), candidates.unsafe_col(chosen));
+      if (distance < candidateSqDist[j])
+        candidateSqDist[j] = distance;
+    }
+    sampleProbs = weights % candidateSqDist;
+  }
+
+  // A few weighted Lloyd iterations on the candidate set tighten the seeds.
+  const size_t reclusterIterations = 10;
+  for (size_t iteration = 0; iteration < reclusterIterations; ++iteration)
+  {
+    arma::mat newCentroids(data.n_rows, clusters, arma::fill::zeros);
+    arma::vec newWeights(clusters, arma::fill::zeros);
+
+    for (size_t j = 0; j < candidates.n_cols; ++j)
+    {
+      double minDistance = std::numeric_limits<double>::max();
+      size_t closest = 0;
+      for (size_t i = 0; i < clusters; ++i)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            candidates.unsafe_col(j), centroids.unsafe_col(i));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          closest = i;
+        }
+      }
+
+      newCentroids.col(closest) += weights[j] * candidates.col(j);
+      newWeights[closest] += weights[j];
+    }
+
+    for (size_t i = 0; i < clusters; ++i)
+      if (newWeights[i] > 0.0)
+        centroids.col(i) = newCentroids.col(i) / newWeights[i];
+  }
+}
+
+//! Fold newly added candidates into each point's nearest-candidate distance.
+template<typename MatType>
+void ScalableInitialization::UpdateDistances(const MatType& data,
+                                             const arma::mat& newCandidates,
+                                             arma::vec& sqDistances)
+{
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    for (size_t j = 0; j < newCandidates.n_cols; ++j)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          data.col(i), newCandidates.unsafe_col(j));
+      if (distance < sqDistances[i])
+        sqDistances[i] = distance;
+    }
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
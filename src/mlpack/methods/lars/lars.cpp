@@ -21,6 +21,7 @@ LARS::LARS(const bool useCholesky,
            const double lambda2,
            const double tolerance) :
     matGram(&matGramInternal),
+    choleskyDim(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
@@ -35,6 +36,7 @@ LARS::LARS(const bool useCholesky,
            const double lambda2,
            const double tolerance) :
     matGram(&gramMatrix),
+    choleskyDim(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
@@ -83,6 +85,10 @@ double LARS::Train(const arma::mat& matX,
   ignoreSet.clear();
   isIgnored.clear();
   matUtriCholFactor.reset();
+  // The workspace itself keeps its capacity, so that repeated Train() calls
+  // (e.g. the sparse coding inner loop, where many solves share one Gram
+  // matrix) do not reallocate the factor.
+  choleskyDim = 0;
 
   // This matrix may end up holding the transpose -- if necessary.
   arma::mat dataTrans;
@@ -91,8 +97,9 @@ double LARS::Train(const arma::mat& matX,
   if (transposeData)
     dataTrans = trans(matX);
 
-  // Compute X' * y.
-  arma::vec vecXTy = trans(y * dataRef);
+  // Compute X' * y.  This buffer (like yHat, yHatDirection and corr below) is
+  // a member, so repeated solves on same-sized problems reuse its memory.
+  vecXTy = trans(y * dataRef);
 
   // Set up active set variables.  In the beginning, the active set has size 0
   // (all dimensions are inactive).
@@ -103,13 +110,13 @@ double LARS::Train(const arma::mat& matX,
 
   // Initialize yHat and beta.
   beta = arma::zeros(dataRef.n_cols);
-  arma::vec yHat = arma::zeros(dataRef.n_rows);
-  arma::vec yHatDirection(dataRef.n_rows);
+  yHat.zeros(dataRef.n_rows);
+  yHatDirection.set_size(dataRef.n_rows);
 
   bool lassocond = false;
 
   // Compute the initial maximum correlation among all dimensions.
-  arma::vec corr = vecXTy;
+  corr = vecXTy;
   double maxCorr = 0;
   size_t changeInd = 0;
   for (size_t i = 0; i < vecXTy.n_elem; ++i)
@@ -191,9 +198,12 @@ double LARS::Train(const arma::mat& matX,
     arma::vec betaDirection;
     if (useCholesky)
     {
+      // The live factor is the leading choleskyDim x choleskyDim block of the
+      // workspace.
+      const arma::mat& factor = matCholWorkspace;
+
       // Check for singularity.
-      const double lastUtriElement = matUtriCholFactor(
-          matUtriCholFactor.n_cols - 1, matUtriCholFactor.n_rows - 1);
+      const double lastUtriElement = factor(choleskyDim - 1, choleskyDim - 1);
       if (std::abs(lastUtriElement) > tolerance)
       {
         // Ok, no singularity.
@@ -208,8 +218,10 @@ double LARS::Train(const arma::mat& matX,
          *    = Solve(R % S, Solve(R^T, s)
          *    = s % Solve(R, Solve(R^T, s))
          */
-        unnormalizedBetaDirection = solve(trimatu(matUtriCholFactor),
-            solve(trimatl(trans(matUtriCholFactor)), s));
+        unnormalizedBetaDirection = solve(
+            trimatu(factor.submat(0, 0, choleskyDim - 1, choleskyDim - 1)),
+            solve(trimatl(trans(factor.submat(0, 0, choleskyDim - 1,
+                choleskyDim - 1))), s));
 
         normalization = 1.0 / sqrt(dot(s, unnormalizedBetaDirection));
         betaDirection = normalization * unnormalizedBetaDirection;
@@ -223,7 +235,7 @@ double LARS::Train(const arma::mat& matX,
             << std::endl;
         Deactivate(activeSet.size() - 1);
         Ignore(changeInd);
-        CholeskyDelete(matUtriCholFactor.n_rows - 1);
+        CholeskyDelete(choleskyDim - 1);
         continue;
       }
     }
@@ -360,6 +372,12 @@ double LARS::Train(const arma::mat& matX,
   // Unfortunate copy...
   beta = betaPath.back();
 
+  // Copy the final factor out of the workspace, so that MatUtriCholFactor()
+  // and serialization see an exactly-sized matrix as before.
+  if (choleskyDim > 0)
+    matUtriCholFactor = matCholWorkspace.submat(0, 0, choleskyDim - 1,
+        choleskyDim - 1);
+
   Timer::Stop("lars_regression");
   return maxCorr;
 }
@@ -429,14 +447,9 @@ void LARS::InterpolateBeta()
 
 void LARS::CholeskyInsert(const arma::vec& newX, const arma::mat& X)
 {
-  if (matUtriCholFactor.n_rows == 0)
+  if (choleskyDim == 0)
   {
-    matUtriCholFactor = arma::mat(1, 1);
-
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(dot(newX, newX) + lambda2);
-    else
-      matUtriCholFactor(0, 0) = norm(newX, 2);
+    CholeskyInsert(dot(newX, newX), arma::vec());
   }
   else
   {
@@ -447,35 +460,41 @@ void LARS::CholeskyInsert(const arma::vec& newX, const arma::mat& X)
 
 void LARS::CholeskyInsert(double sqNormNewX, const arma::vec& newGramCol)
 {
-  int n = matUtriCholFactor.n_rows;
+  const size_t n = choleskyDim;
 
-  if (n == 0)
+  // Grow the workspace geometrically if it is full; the valid factor occupies
+  // the leading n x n block, which resize() preserves.  Amortized over a
+  // solve, insertions then cost O(n^2) for the triangular solve alone instead
+  // of an additional (n + 1)^2 allocation and copy each.
+  if (matCholWorkspace.n_rows < n + 1)
   {
-    matUtriCholFactor = arma::mat(1, 1);
+    arma::uword newCapacity = std::max(arma::uword(16),
+        2 * matCholWorkspace.n_rows);
+    if (newCapacity < n + 1)
+      newCapacity = n + 1;
+    matCholWorkspace.resize(newCapacity, newCapacity);
+  }
 
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX + lambda2);
-    else
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX);
+  if (elasticNet)
+    sqNormNewX += lambda2;
+
+  if (n == 0)
+  {
+    matCholWorkspace(0, 0) = sqrt(sqNormNewX);
   }
   else
   {
-    arma::mat matNewR = arma::mat(n + 1, n + 1);
-
-    if (elasticNet)
-      sqNormNewX += lambda2;
-
-    arma::vec matUtriCholFactork = solve(trimatl(trans(matUtriCholFactor)),
-        newGramCol);
-
-    matNewR(arma::span(0, n - 1), arma::span(0, n - 1)) = matUtriCholFactor;
-    matNewR(arma::span(0, n - 1), n) = matUtriCholFactork;
-    matNewR(n, arma::span(0, n - 1)).fill(0.0);
-    matNewR(n, n) = sqrt(sqNormNewX - dot(matUtriCholFactork,
-                                          matUtriCholFactork));
-
-    matUtriCholFactor = matNewR;
+    // Solve R^T r = newGramCol against the current factor and write the new
+    // column in place.
+    arma::vec newCol = solve(trimatl(trans(matCholWorkspace.submat(0, 0,
+        n - 1, n - 1))), newGramCol);
+
+    matCholWorkspace(arma::span(0, n - 1), n) = newCol;
+    matCholWorkspace(n, arma::span(0, n - 1)).fill(0.0);
+    matCholWorkspace(n, n) = sqrt(sqNormNewX - dot(newCol, newCol));
   }
+
+  ++choleskyDim;
 }
 
 void LARS::GivensRotate(const arma::vec::fixed<2>& x,
@@ -508,33 +527,41 @@ void LARS::GivensRotate(const arma::vec::fixed<2>& x,
 
 void LARS::CholeskyDelete(const size_t colToKill)
 {
-  size_t n = matUtriCholFactor.n_rows;
+  size_t n = choleskyDim;
 
   if (colToKill == (n - 1))
   {
-    matUtriCholFactor = matUtriCholFactor(arma::span(0, n - 2),
-                                          arma::span(0, n - 2));
+    // Just shrink the active block; the stale last row and column are simply
+    // no longer referenced.
+    --choleskyDim;
   }
   else
   {
-    matUtriCholFactor.shed_col(colToKill); // remove column colToKill
+    // Shift the columns after colToKill left by one inside the workspace
+    // (instead of shed_col(), which reallocates).
+    for (size_t j = colToKill; j < n - 1; j++)
+    {
+      matCholWorkspace(arma::span(0, n - 1), j) =
+          matCholWorkspace(arma::span(0, n - 1), j + 1);
+    }
     n--;
 
     for (size_t k = colToKill; k < n; k++)
     {
       arma::mat matG;
       arma::vec::fixed<2> rotatedVec;
-      GivensRotate(matUtriCholFactor(arma::span(k, k + 1), k), rotatedVec,
+      GivensRotate(matCholWorkspace(arma::span(k, k + 1), k), rotatedVec,
           matG);
-      matUtriCholFactor(arma::span(k, k + 1), k) = rotatedVec;
+      matCholWorkspace(arma::span(k, k + 1), k) = rotatedVec;
       if (k < n - 1)
       {
-        matUtriCholFactor(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
-            matG * matUtriCholFactor(arma::span(k, k + 1),
+        matCholWorkspace(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
+            matG * matCholWorkspace(arma::span(k, k + 1),
             arma::span(k + 1, n - 1));
       }
     }
 
-    matUtriCholFactor.shed_row(n);
+    // Drop the now-unused last row of the active block.
+    choleskyDim = n;
   }
 }
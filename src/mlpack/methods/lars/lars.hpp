@@ -251,9 +251,28 @@ class LARS
   //! Pointer to the Gram matrix we will use.
   const arma::mat* matGram;
 
-  //! Upper triangular cholesky factor; initially 0x0 matrix.
+  //! Upper triangular cholesky factor; initially 0x0 matrix.  This is kept in
+  //! sync with the workspace below at the end of Train().
   arma::mat matUtriCholFactor;
 
+  //! In-place workspace for the Cholesky factor during Train(); only the
+  //! leading choleskyDim x choleskyDim block is valid.  Its capacity is grown
+  //! geometrically, so the rank-1 insertions and deletions performed as the
+  //! active set changes never reallocate, and repeated Train() calls (as in
+  //! sparse coding, where thousands of solves share one Gram matrix) reuse
+  //! the same memory.
+  arma::mat matCholWorkspace;
+  //! Active dimension of the factor inside matCholWorkspace.
+  size_t choleskyDim;
+
+  //! Reusable buffers for per-solve temporaries; these keep their memory
+  //! across Train() calls so that repeated solves on same-sized problems do
+  //! not reallocate.
+  arma::vec vecXTy;
+  arma::vec corr;
+  arma::vec yHat;
+  arma::vec yHatDirection;
+
   //! Whether or not to use Cholesky decomposition when solving linear system.
   bool useCholesky;
 
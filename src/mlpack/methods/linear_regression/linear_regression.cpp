@@ -48,6 +48,11 @@ double LinearRegression::Train(const arma::mat& predictors,
 {
   this->intercept = intercept;
 
+  // A full retraining invalidates any incrementally maintained state.
+  gram.reset();
+  xty.reset();
+  incrementalPoints = 0;
+
   /*
    * We want to calculate the a_i coefficients of:
    * \sum_{i=0}^n (a_i * x_i^i)
@@ -88,6 +93,81 @@ double LinearRegression::Train(const arma::mat& predictors,
   return ComputeError(predictors, responses);
 }
 
+void LinearRegression::AddPoints(const arma::mat& predictors,
+                                 const arma::rowvec& responses)
+{
+  if (predictors.n_cols != responses.n_elem)
+  {
+    Log::Fatal << "The number of predictor points (" << predictors.n_cols
+        << ") must match the number of responses (" << responses.n_elem
+        << ")!" << std::endl;
+  }
+
+  arma::mat p = predictors;
+  if (intercept)
+  {
+    p.insert_rows(0, arma::ones<arma::mat>(1, predictors.n_cols));
+  }
+
+  // Create the incremental state on the first call (or if the
+  // dimensionality changed, which means a different problem entirely).
+  if (gram.n_rows != p.n_rows)
+  {
+    gram.zeros(p.n_rows, p.n_rows);
+    xty.zeros(p.n_rows);
+    incrementalPoints = 0;
+  }
+
+  // Rank-1 updates of the Gram matrix and the moment vector; O(d^2) per
+  // added point.
+  gram += p * p.t();
+  xty += p * responses.t();
+  incrementalPoints += predictors.n_cols;
+
+  Refit();
+}
+
+void LinearRegression::RemovePoints(const arma::mat& predictors,
+                                    const arma::rowvec& responses)
+{
+  if (predictors.n_cols != responses.n_elem)
+  {
+    Log::Fatal << "The number of predictor points (" << predictors.n_cols
+        << ") must match the number of responses (" << responses.n_elem
+        << ")!" << std::endl;
+  }
+
+  const size_t dims = intercept ? predictors.n_rows + 1 : predictors.n_rows;
+  if (gram.n_rows != dims || incrementalPoints < predictors.n_cols)
+  {
+    Log::Fatal << "LinearRegression::RemovePoints(): cannot remove points "
+        << "that were not added with AddPoints()!" << std::endl;
+  }
+
+  arma::mat p = predictors;
+  if (intercept)
+  {
+    p.insert_rows(0, arma::ones<arma::mat>(1, predictors.n_cols));
+  }
+
+  // Rank-1 downdates; O(d^2) per removed point.
+  gram -= p * p.t();
+  xty -= p * responses.t();
+  incrementalPoints -= predictors.n_cols;
+
+  Refit();
+}
+
+void LinearRegression::Refit()
+{
+  // Solve the d x d normal equations from the maintained state.  The cost of
+  // this solve depends only on the dimensionality, not on how many points
+  // have been added.
+  arma::mat cov = gram +
+      lambda * arma::eye<arma::mat>(gram.n_rows, gram.n_rows);
+  parameters = arma::solve(cov, xty);
+}
+
 void LinearRegression::Predict(const arma::mat& points,
     arma::rowvec& predictions) const
 {
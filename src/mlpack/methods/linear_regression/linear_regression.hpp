@@ -95,6 +95,33 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Add points to the model incrementally. The model maintains the Gram
+   * matrix X X^T and the moment vector X y^T; adding a point is a rank-1
+   * update costing O(d^2), and the parameters are recovered by solving the
+   * d x d system, independently of how many points the model has seen. This
+   * is intended for refitting on streaming or sliding-window data, where
+   * Train() would recompute the normal equations from scratch.
+   *
+   * The incremental state is created on the first call (using the current
+   * intercept and lambda settings) and is discarded by any call to Train().
+   *
+   * @param predictors X, the matrix of data points to add to the model.
+   * @param responses y, the responses to the data points.
+   */
+  void AddPoints(const arma::mat& predictors, const arma::rowvec& responses);
+
+  /**
+   * Remove points from the model incrementally, via rank-1 downdates of the
+   * maintained Gram matrix; the points must have been added earlier with
+   * AddPoints(). Removing a point costs O(d^2).
+   *
+   * @param predictors X, the matrix of data points to remove from the model.
+   * @param responses y, the responses to the data points.
+   */
+  void RemovePoints(const arma::mat& predictors,
+                    const arma::rowvec& responses);
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -145,9 +172,16 @@ class LinearRegression
     ar & BOOST_SERIALIZATION_NVP(parameters);
     ar & BOOST_SERIALIZATION_NVP(lambda);
     ar & BOOST_SERIALIZATION_NVP(intercept);
+    ar & BOOST_SERIALIZATION_NVP(gram);
+    ar & BOOST_SERIALIZATION_NVP(xty);
+    ar & BOOST_SERIALIZATION_NVP(incrementalPoints);
   }
 
  private:
+  /**
+   * Re-solve the normal equations from the maintained incremental state.
+   */
+  void Refit();
   /**
    * The calculated B.
    * Initialized and filled by constructor to hold the least squares solution.
@@ -162,6 +196,16 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! The Gram matrix X X^T of the incrementally added points (empty if the
+  //! model is not in incremental mode).
+  arma::mat gram;
+
+  //! The moment vector X y^T of the incrementally added points.
+  arma::vec xty;
+
+  //! The number of points currently held in the incremental state.
+  size_t incrementalPoints = 0;
 };
 
 } // namespace regression
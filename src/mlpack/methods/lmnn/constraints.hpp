@@ -183,6 +183,24 @@ class Constraints
   //! Modify the value of precalculated.
   bool& PreCalulated() { return precalculated; }
 
+  //! Get the tolerance on the accumulated reference-point drift below which
+  //! the cached per-class search trees are reused instead of rebuilt.
+  const double& RebuildTolerance() const { return rebuildTolerance; }
+  //! Modify the tree rebuild tolerance.  With the default of zero, any drift
+  //! at all causes a rebuild, so the search results are always exact.
+  double& RebuildTolerance() { return rebuildTolerance; }
+
+  /**
+   * Record that the reference points may have moved by at most the given
+   * amount since the last Impostors() call (typically the spectral norm of
+   * the change in the transformation times the largest data point norm).
+   * Once the accumulated drift exceeds RebuildTolerance(), the next
+   * Impostors() call rebuilds the cached search trees.
+   *
+   * @param referenceDrift Bound on the movement of the reference points.
+   */
+  void AccumulateDrift(const double referenceDrift) { drift += referenceDrift; }
+
  private:
   //! Number of target neighbors & impostors to calulate.
   size_t k;
@@ -199,12 +217,31 @@ class Constraints
   //! False if nothing has ever been precalculated.
   bool precalculated;
 
+  //! Cached per-class search trees over differently labeled points, reused
+  //! across Impostors() calls while the accumulated drift stays within
+  //! tolerance.
+  std::vector<KNN> treeCache;
+
+  //! Upper bound on how far the cached trees' reference points have moved
+  //! since the trees were built.
+  double drift;
+
+  //! Tolerance on the drift before the cached trees must be rebuilt.
+  double rebuildTolerance;
+
   /**
   * Precalculate the unique labels, and indices of similar
   * and different datapoints on the basis of labels.
   */
   inline void Precalculate(const arma::Row<size_t>& labels);
 
+  /**
+  * Make sure the cached per-class trees are usable for searches against the
+  * given (transformed) dataset, rebuilding them in parallel if the
+  * accumulated drift exceeds the rebuild tolerance.
+  */
+  inline void PrepareTrees(const arma::mat& dataset);
+
   /**
   * Re-order neighbors on the basis of increasing norm in case
   * of ties among distances.
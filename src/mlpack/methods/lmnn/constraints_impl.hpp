@@ -24,7 +24,9 @@ Constraints<MetricType>::Constraints(
     const arma::Row<size_t>& labels,
     const size_t k) :
     k(k),
-    precalculated(false)
+    precalculated(false),
+    drift(0.0),
+    rebuildTolerance(0.0)
 {
   // Ensure a valid k is passed.
   size_t minCount = arma::min(arma::histc(labels, arma::unique(labels)));
@@ -161,6 +163,30 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
   }
 }
 
+// Make sure the cached per-class trees are fresh enough to search against the
+// given reference dataset.
+template<typename MetricType>
+inline void Constraints<MetricType>::PrepareTrees(const arma::mat& dataset)
+{
+  // The trees can be reused as long as the reference points have not drifted
+  // further than the tolerance since the trees were built.  (With the default
+  // tolerance of zero, any drift at all causes a rebuild, so this only skips
+  // rebuilds when the transformation has not changed---e.g. an Evaluate() and
+  // a Gradient() call at the same coordinates---and results stay exact.)
+  if (!treeCache.empty() && drift <= rebuildTolerance)
+    return;
+
+  treeCache.resize(uniqueLabels.n_cols);
+
+  // Each tree is built by exactly one thread, so no synchronization is
+  // needed.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+    treeCache[i].Train(dataset.cols(indexDiff[i]));
+
+  drift = 0.0;
+}
+
 // Calculates k differently labeled nearest neighbors.
 template<typename MetricType>
 void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
@@ -171,18 +197,20 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // Rebuild the cached trees if they have gone stale.
+  PrepareTrees(dataset);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; i++)
+  // The searches for different classes are independent and write to disjoint
+  // sets of output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; i++)
   {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(dataset.cols(indexSame[i]), k, neighbors, distances);
+    treeCache[i].Search(dataset.cols(indexSame[i]), k, neighbors, distances);
 
     // Re-order neighbors on the basis of increasing norm in case
     // of ties among distances.
@@ -209,18 +237,20 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // Rebuild the cached trees if they have gone stale.
+  PrepareTrees(dataset);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; i++)
+  // The searches for different classes are independent and write to disjoint
+  // sets of output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; i++)
   {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(dataset.cols(indexSame[i]), k, neighbors, distances);
+    treeCache[i].Search(dataset.cols(indexSame[i]), k, neighbors, distances);
 
     // Re-order neighbors on the basis of increasing norm in case
     // of ties among distances.
@@ -252,24 +282,24 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // Rebuild the cached trees if they have gone stale.
+  PrepareTrees(dataset);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; i++)
+  // The searches for different classes are independent and write to disjoint
+  // sets of output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; i++)
   {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(subDataset.cols(subIndexSame), k, neighbors, distances);
+    treeCache[i].Search(subDataset.cols(subIndexSame), k, neighbors,
+        distances);
 
     // Re-order neighbors on the basis of increasing norm in case
     // of ties among distances.
@@ -301,24 +331,24 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+  // Rebuild the cached trees if they have gone stale.
+  PrepareTrees(dataset);
 
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; i++)
+  // The searches for different classes are independent and write to disjoint
+  // sets of output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; i++)
   {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(subDataset.cols(subIndexSame), k, neighbors, distances);
+    treeCache[i].Search(subDataset.cols(subIndexSame), k, neighbors,
+        distances);
 
     // Re-order neighbors on the basis of increasing norm in case
     // of ties among distances.
@@ -348,25 +378,24 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
+  // Rebuild the cached trees if they have gone stale.
+  PrepareTrees(dataset);
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; i++)
+  // The searches for different classes are independent and write to disjoint
+  // sets of output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; i++)
   {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
+    arma::uvec subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(dataset.cols(points.elem(subIndexSame)),
+    treeCache[i].Search(dataset.cols(points.elem(subIndexSame)),
         k, neighbors, distances);
 
     // Re-order neighbors on the basis of increasing norm in case
@@ -439,6 +468,10 @@ inline void Constraints<MetricType>::Precalculate(
     indexDiff[i] = arma::find(labels != uniqueLabels[i]);
   }
 
+  // The cached trees were built over the old index partitioning, so they can
+  // no longer be used.
+  treeCache.clear();
+
   precalculated = true;
 }
 
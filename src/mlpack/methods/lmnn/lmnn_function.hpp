@@ -189,6 +189,13 @@ class LMNNFunction
   //! Modify the value of k.
   size_t& Range() { return range; }
 
+  //! Access the tolerance on accumulated reference-point drift below which
+  //! the cached impostor search trees are reused instead of rebuilt.
+  const double& RebuildTolerance() const
+  { return constraint.RebuildTolerance(); }
+  //! Modify the tree rebuild tolerance (zero keeps the searches exact).
+  double& RebuildTolerance() { return constraint.RebuildTolerance(); }
+
  private:
   //! data.  This will be an alias until Shuffle() is called.
   arma::mat dataset;
@@ -226,6 +233,8 @@ class LMNNFunction
   arma::mat maxImpNorm;
   //! Holds previous transformation matrix. Used for L-BFGS like optimizer.
   arma::mat transformationOld;
+  //! Holds the transformation for which drift was last accumulated.
+  arma::mat lastDriftTransformation;
   //! Holds previous transformation matrices.
   std::vector<arma::mat> oldTransformationMatrices;
   //! Holds number of points which are using each transformation matrix.
@@ -251,6 +260,12 @@ class LMNNFunction
                         const arma::mat& transformation,
                         const size_t begin,
                         const size_t batchSize);
+  /**
+  * Tell the constraints object how far the reference points may have drifted
+  * under the given transformation, so it knows when its cached impostor
+  * search trees go stale.
+  */
+  inline void AccumulateDrift(const arma::mat& transformation);
 };
 
 } // namespace lmnn
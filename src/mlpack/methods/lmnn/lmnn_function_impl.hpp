@@ -182,6 +182,29 @@ inline void LMNNFunction<MetricType>::UpdateCache(
   #endif
 }
 
+// Accumulate reference-point drift in the constraints object.
+template<typename MetricType>
+inline void LMNNFunction<MetricType>::AccumulateDrift(
+    const arma::mat& transformation)
+{
+  // Under a change in the transformation, a reference point x moves by at
+  // most ||L - Lold||_2 * ||x||; accumulating that bound over successive
+  // transformations bounds the total movement since the cached trees were
+  // built.  The trees built in the constructor correspond to the identity.
+  if (lastDriftTransformation.is_empty())
+  {
+    constraint.AccumulateDrift(arma::norm(transformation -
+        arma::eye<arma::mat>(transformation.n_rows, transformation.n_cols), 2) *
+        arma::max(norm));
+  }
+  else if (arma::accu(transformation != lastDriftTransformation) > 0)
+  {
+    constraint.AccumulateDrift(arma::norm(transformation -
+        lastDriftTransformation, 2) * arma::max(norm));
+  }
+  lastDriftTransformation = transformation;
+}
+
 // Calculate norm of change in transformation.
 template<typename MetricType>
 inline void LMNNFunction<MetricType>::TransDiff(
@@ -217,6 +240,9 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   double transformationDiff = 0;
   if (!transformationOld.is_empty())
   {
@@ -351,6 +377,9 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   if (impBounds && iteration++ % range == 0)
   {
     // Track number of data points to use for impostors calculatiom.
@@ -474,6 +503,9 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   double transformationDiff = 0;
   if (!transformationOld.is_empty() && iteration++ % range == 0)
   {
@@ -607,6 +639,9 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   // Calculate norm of change in transformation.
   std::map<size_t, double> transformationDiffs;
   TransDiff(transformationDiffs, transformation, begin, batchSize);
@@ -746,6 +781,9 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   double transformationDiff = 0;
   if (!transformationOld.is_empty())
   {
@@ -893,6 +931,9 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   // Apply metric over dataset.
   transformedDataset = transformation * dataset;
 
+  // Track how far the reference points may have moved.
+  AccumulateDrift(transformation);
+
   if (impBounds && iteration++ % range == 0)
   {
     // Track number of data points to use for impostors calculatiom.
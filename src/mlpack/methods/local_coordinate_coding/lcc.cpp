@@ -30,36 +30,49 @@ LocalCoordinateCoding::LocalCoordinateCoding(
 
 void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
+  // One GEMM gives every point-to-anchor squared distance at once.
   arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
       data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
       * data);
 
+  // The unweighted Gram matrix is shared by every point; each point only
+  // rescales it by its own inverse squared distances.
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; i++)
+
+  // Each point's weighted problem is independent and writes only its own
+  // column of the codes matrix, so solve the points in parallel, with each
+  // thread reusing its own workspace matrices across its points.
+  #pragma omp parallel
   {
-    // Report progress.
-    if ((i % 100) == 0)
+    arma::mat dictPrime(dictionary.n_rows, atoms);
+    arma::mat dictGramTD(atoms, atoms);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; i++)
     {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
+      // Report progress.
+      if ((i % 100) == 0)
+        Log::Debug << "Optimization at point " << i << "." << std::endl;
+
+      arma::vec invW = invSqDists.unsafe_col(i);
+
+      // Rescale the dictionary and the shared Gram matrix elementwise by the
+      // weights, instead of multiplying by diagonal matrices.
+      dictPrime = dictionary.each_row() % invW.t();
+      dictGramTD = dictGram % (invW * invW.t());
+
+      bool useCholesky = false;
+      regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
     }
-
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
-
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
-
-    bool useCholesky = false;
-    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
-
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
   }
 }
 
@@ -101,20 +101,33 @@ double LogisticRegressionFunction<MatType>::Evaluate(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
       parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
-  // does not need to be multiplied by any of the predictors.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
   // Assemble full objective function.  Often the objective function and the
   // regularization as given are divided by the number of features, but this
   // doesn't actually affect the optimization result, so we'll just ignore those
-  // terms for computational efficiency.  Note that the conversion causes some
-  // copy and slowdown, but this is so negligible compared to the rest of the
-  // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  // terms for computational efficiency.  Since the objective is a sum over
+  // points, we evaluate it in blocks of points, accumulating each thread's
+  // partial sum with an OpenMP reduction.  The intercept term is
+  // parameters(0, 0) and does not need to be multiplied by any of the
+  // predictors.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+  double result = 0.0;
+  #pragma omp parallel for reduction(+ : result)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t last = std::min(begin + blockSize,
+        (size_t) predictors.n_cols) - 1;
+
+    const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, last))));
+    const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+        responses.subvec(begin, last));
+
+    result += arma::accu(arma::log(1.0 - respD + sigmoid %
+        (2 * respD - 1.0)));
+  }
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -161,13 +174,40 @@ void LogisticRegressionFunction<MatType>::Gradient(
   arma::mat regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // The gradient is a sum over points, so process the points in blocks, with
+  // each thread accumulating into a local gradient that is merged at the end.
+  gradient.zeros(arma::size(parameters));
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::rowvec localGradient(parameters.n_elem, arma::fill::zeros);
+    #pragma omp for nowait
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t last = std::min(begin + blockSize,
+          (size_t) predictors.n_cols) - 1;
+
+      const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+          - parameters.tail_cols(parameters.n_elem - 1) *
+          predictors.cols(begin, last))));
+
+      localGradient[0] += -arma::accu(responses.subvec(begin, last) -
+          sigmoids);
+      // Compute (predictors * diffs^T)^T instead of diffs * predictors^T: the
+      // two are equivalent, but the latter would explicitly materialize the
+      // transpose of the predictors matrix, which is expensive when MatType is
+      // a sparse matrix type.
+      localGradient.tail_cols(parameters.n_elem - 1) +=
+          (predictors.cols(begin, last) *
+          (sigmoids - responses.subvec(begin, last)).t()).t();
+    }
+
+    #pragma omp critical
+    gradient += localGradient;
+  }
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -194,9 +234,12 @@ void LogisticRegressionFunction<MatType>::Gradient(
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  // This form of the product avoids transposing the (possibly sparse) batch of
+  // predictors.
+  gradient.tail_cols(parameters.n_elem - 1) =
+      (predictors.cols(begin, begin + batchSize - 1) * (sigmoids -
+      responses.subvec(begin, begin + batchSize - 1)).t()).t() +
+      regularization;
 }
 
 /**
@@ -239,19 +282,46 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
-
-  // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  // Both the objective and the gradient are sums over points, so compute them
+  // together in blocks of points: each thread accumulates a partial objective
+  // and a local gradient, and these are merged once at the end.
+  gradient.zeros(arma::size(parameters));
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+  double result = 0.0;
+  #pragma omp parallel reduction(+ : result)
+  {
+    arma::rowvec localGradient(parameters.n_elem, arma::fill::zeros);
+    #pragma omp for nowait
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t last = std::min(begin + blockSize,
+          (size_t) predictors.n_cols) - 1;
+
+      // Calculate the sigmoid function values for this block of points.
+      const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+          parameters.tail_cols(parameters.n_elem - 1) *
+          predictors.cols(begin, last))));
+
+      localGradient[0] += -arma::accu(responses.subvec(begin, last) -
+          sigmoids);
+      // Avoid forming the transpose of the predictors matrix; see Gradient().
+      localGradient.tail_cols(parameters.n_elem - 1) +=
+          (predictors.cols(begin, last) *
+          (sigmoids - responses.subvec(begin, last)).t()).t();
+
+      // Now compute the objective function using the sigmoids.
+      const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+          responses.subvec(begin, last));
+      result += arma::accu(arma::log(1.0 - respD + sigmoids %
+          (2 * respD - 1.0)));
+    }
+
+    #pragma omp critical
+    gradient += localGradient;
+  }
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -283,9 +353,11 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  // Avoid forming the transpose of the predictors batch; see Gradient().
+  gradient.tail_cols(parameters.n_elem - 1) =
+      (predictors.cols(begin, begin + batchSize - 1) * (sigmoids -
+      responses.subvec(begin, begin + batchSize - 1)).t()).t() +
+      regularization;
 
   // Now compute the objective function using the sigmoids.
   arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
@@ -188,6 +188,21 @@ class LSHSearch
              const size_t bucketSize = 500,
              const arma::cube& projection = arma::cube());
 
+  /**
+   * Insert the given points into an already-trained model without rebuilding
+   * the hash tables.  The new points are appended to the reference set and
+   * hashed with the projections, offsets, and second-level hash weights that
+   * were chosen when Train() was called, so they land in the same buckets
+   * that a full retraining would put them in.  Only the buckets the new
+   * points hash into are modified.
+   *
+   * If the model has not been trained, or if the dimensionality of the new
+   * points does not match the reference set, an exception is thrown.
+   *
+   * @param points Points to add to the reference set.
+   */
+  void InsertPoints(const arma::mat& points);
+
   /**
    * Compute the nearest neighbors of the points in the given query set and
    * store the output in the given matrices.  The matrices will be set to the
@@ -357,6 +372,32 @@ class LSHSearch
                 arma::Mat<size_t>& neighbors,
                 arma::mat& distances) const;
 
+  /**
+   * Score the candidate set of a single query point and store the best 'k'
+   * candidates.  This is the shared implementation behind both BaseCase()
+   * overloads: candidates are gathered into a contiguous scratch block and
+   * scored a block at a time with a single vectorized distance evaluation,
+   * instead of one EuclideanDistance::Evaluate() call per candidate.  For
+   * small k a flat insertion-sorted array is used instead of a binary heap.
+   *
+   * @param queryPoint The query point itself.
+   * @param queryIndex The index of the query in question.
+   * @param referenceIndices The vector of indices of candidate neighbors for
+   *    the query.
+   * @param k Number of neighbors to search for.
+   * @param skipSelf If true, a candidate whose index equals queryIndex is
+   *    ignored (monochromatic search).
+   * @param neighbors Matrix holding output neighbors.
+   * @param distances Matrix holding output distances.
+   */
+  void ScoreCandidates(const arma::vec& queryPoint,
+                       const size_t queryIndex,
+                       const arma::uvec& referenceIndices,
+                       const size_t k,
+                       const bool skipSelf,
+                       arma::Mat<size_t>& neighbors,
+                       arma::mat& distances) const;
+
   /**
    * This function implements the core idea behind Multiprobe LSH. It is called
    * by ReturnIndicesFromTables when T > 0. Given a query's code and its
@@ -386,25 +427,6 @@ class LSHSearch
   double PerturbationScore(const std::vector<bool>& A,
                            const arma::vec& scores) const;
 
-  /**
-   * Inline function used by GetAdditionalProbingBins. The vector shift
-   * operation replaces the largest element of a vector A with (largest element)
-   * + 1.  Returns true if resulting vector is valid, otherwise false.
-   *
-   * @param A perturbation set to shift.
-   */
-  bool PerturbationShift(std::vector<bool>& A) const;
-
-  /**
-   * Inline function used by GetAdditionalProbingBins. The vector expansion
-   * operation adds the element [1 + (largest_element)] to a vector A, where
-   * largest_element is the largest element of A. Returns true if resulting
-   * vector is valid, otherwise false.
-   *
-   * @param A perturbation set to expand.
-   */
-  bool PerturbationExpand(std::vector<bool>& A) const;
-
   /**
    * Return true if perturbation set A is valid. A perturbation set is invalid
    * if it contains two (or more) actions for the same dimension or dimensions
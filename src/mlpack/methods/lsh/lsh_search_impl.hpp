@@ -256,7 +256,12 @@ void LSHSearch<SortPolicy>::Train(arma::mat referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; i++)
+  // Each table is hashed independently and writes only its own row of
+  // 'secondHashVectors', so the tables can be built in parallel.
+  #pragma omp parallel for \
+      shared(secondHashVectors) \
+      schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; i++)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -347,52 +352,103 @@ void LSHSearch<SortPolicy>::Train(arma::mat referenceSet,
             << std::endl;
 }
 
-// Base case where the query set is the reference set.  (So, we can't return
-// ourselves as the nearest neighbor.)
+// Insert new points into a trained model without rebuilding the hash tables.
 template<typename SortPolicy>
-inline force_inline
-void LSHSearch<SortPolicy>::BaseCase(const size_t queryIndex,
-                                     const arma::uvec& referenceIndices,
-                                     const size_t k,
-                                     arma::Mat<size_t>& neighbors,
-                                     arma::mat& distances) const
+void LSHSearch<SortPolicy>::InsertPoints(const arma::mat& points)
 {
-  // Let's build the list of candidate neighbors for the given query point.
-  // It will be initialized with k candidates:
-  // (WorstDistance, referenceSet.n_cols)
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      referenceSet.n_cols);
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
-  {
-    const size_t referenceIndex = referenceIndices[j];
-    // If the points are the same, skip this point.
-    if (queryIndex == referenceIndex)
-      continue;
+  if (projections.n_slices == 0)
+    throw std::invalid_argument("LSHSearch::InsertPoints(): model has not "
+        "been trained; call Train() first!");
+  if (points.n_rows != referenceSet.n_rows)
+    throw std::invalid_argument("LSHSearch::InsertPoints(): dimensionality of "
+        "new points must match the reference set!");
+
+  const size_t oldSize = referenceSet.n_cols;
+  referenceSet.insert_cols(oldSize, points);
+
+  // Hash each new point into every table, reusing the projections, offsets,
+  // and second-level hash weights that were chosen when the model was trained.
+  // This is the same keying scheme as in Train(); each table writes only its
+  // own row of 'secondHashVectors', so the tables are hashed in parallel.
+  arma::Mat<size_t> secondHashVectors(numTables, points.n_cols);
 
-    const double distance = metric::EuclideanDistance::Evaluate(
-        referenceSet.unsafe_col(queryIndex),
-        referenceSet.unsafe_col(referenceIndex));
+  #pragma omp parallel for \
+      shared(secondHashVectors) \
+      schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; i++)
+  {
+    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
+                                       points.n_cols);
+    arma::mat hashMat = projections.slice(i).t() * points;
+    hashMat += offsetMat;
+    hashMat /= hashWidth;
 
-    Candidate c = std::make_pair(distance, referenceIndex);
-    // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
+    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
+    for (size_t j = 0; j < unmodVector.n_elem; ++j)
     {
-      pqueue.pop();
-      pqueue.push(c);
+      double shs = (double) secondHashSize; // Convenience cast.
+      if (unmodVector[j] >= 0.0)
+      {
+        const size_t key = size_t(fmod(unmodVector[j], shs));
+        secondHashVectors(i, j) = key;
+      }
+      else
+      {
+        const double mod = fmod(-unmodVector[j], shs);
+        const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
+        secondHashVectors(i, j) = key;
+      }
     }
   }
 
-  for (size_t j = 1; j <= k; j++)
+  // Now append each point to its bucket in each table.  Only the buckets the
+  // new points hash into are touched; the rest of the table stays in place.
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+  for (size_t i = 0; i < numTables; ++i)
   {
-    neighbors(k - j, queryIndex) = pqueue.top().second;
-    distances(k - j, queryIndex) = pqueue.top().first;
-    pqueue.pop();
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      const size_t hashInd = secondHashVectors(i, j);
+
+      // If this bucket was empty, open a new row of the hash table for it.
+      if (bucketRowInHashTable[hashInd] == secondHashSize)
+      {
+        bucketRowInHashTable[hashInd] = secondHashTable.size();
+        secondHashTable.push_back(arma::Col<size_t>());
+        bucketContentSize.resize(secondHashTable.size());
+        bucketContentSize[secondHashTable.size() - 1] = 0;
+      }
+
+      const size_t index = bucketRowInHashTable[hashInd];
+      if (bucketContentSize[index] < effectiveBucketSize)
+      {
+        // Grow the bucket's storage if it has filled up.  Train() sizes each
+        // bucket exactly, so the first insertion into an old bucket will
+        // always reallocate; after that we grow geometrically.
+        if (bucketContentSize[index] == secondHashTable[index].n_elem)
+          secondHashTable[index].resize(std::max<size_t>(
+              2 * secondHashTable[index].n_elem, 4));
+
+        secondHashTable[index](bucketContentSize[index]++) = oldSize + j;
+      }
+    }
   }
 }
 
+// Base case where the query set is the reference set.  (So, we can't return
+// ourselves as the nearest neighbor.)
+template<typename SortPolicy>
+inline force_inline
+void LSHSearch<SortPolicy>::BaseCase(const size_t queryIndex,
+                                     const arma::uvec& referenceIndices,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances) const
+{
+  ScoreCandidates(referenceSet.unsafe_col(queryIndex), queryIndex,
+      referenceIndices, k, true, neighbors, distances);
+}
+
 // Base case for bichromatic search.
 template<typename SortPolicy>
 inline force_inline
@@ -403,35 +459,119 @@ void LSHSearch<SortPolicy>::BaseCase(const size_t queryIndex,
                                      arma::Mat<size_t>& neighbors,
                                      arma::mat& distances) const
 {
-  // Let's build the list of candidate neighbors for the given query point.
-  // It will be initialized with k candidates:
-  // (WorstDistance, referenceSet.n_cols)
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      referenceSet.n_cols);
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  ScoreCandidates(querySet.unsafe_col(queryIndex), queryIndex,
+      referenceIndices, k, false, neighbors, distances);
+}
+
+// Score the candidate set of one query point, a block at a time.
+template<typename SortPolicy>
+void LSHSearch<SortPolicy>::ScoreCandidates(const arma::vec& queryPoint,
+                                            const size_t queryIndex,
+                                            const arma::uvec& referenceIndices,
+                                            const size_t k,
+                                            const bool skipSelf,
+                                            arma::Mat<size_t>& neighbors,
+                                            arma::mat& distances) const
+{
+  // Candidates are gathered into a contiguous scratch block so that one pass
+  // of the vectorized distance kernel scores a whole block, instead of one
+  // strided EuclideanDistance::Evaluate() call per candidate.
+  const size_t blockSize = 64;
+  const size_t numCandidates = referenceIndices.n_elem;
+
+  arma::mat candidateBlock(referenceSet.n_rows, blockSize);
+  arma::rowvec blockDistances(blockSize);
+
+  // For small k, a flat array kept in sorted order is faster than a binary
+  // heap: the common case is a candidate worse than the current k-th best,
+  // which costs a single comparison against the last element.
+  const bool useFlatList = (k <= 32);
+  arma::vec bestDistances;
+  arma::Col<size_t> bestIndices;
+  CandidateList pqueue;
+  if (useFlatList)
+  {
+    bestDistances.set_size(k);
+    bestDistances.fill(SortPolicy::WorstDistance());
+    bestIndices.set_size(k);
+    bestIndices.fill(referenceSet.n_cols);
+  }
+  else
+  {
+    const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+        referenceSet.n_cols);
+    std::vector<Candidate> vect(k, def);
+    pqueue = CandidateList(CandidateCmp(), std::move(vect));
+  }
+
+  for (size_t start = 0; start < numCandidates; start += blockSize)
   {
-    const size_t referenceIndex = referenceIndices[j];
-    const double distance = metric::EuclideanDistance::Evaluate(
-        querySet.unsafe_col(queryIndex),
-        referenceSet.unsafe_col(referenceIndex));
-
-    Candidate c = std::make_pair(distance, referenceIndex);
-    // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
+    const size_t len = std::min(blockSize, numCandidates - start);
+
+    // Gather this block of candidates into contiguous storage.
+    for (size_t j = 0; j < len; ++j)
+      candidateBlock.col(j) = referenceSet.unsafe_col(
+          referenceIndices[start + j]);
+
+    // Score the whole block with a single vectorized evaluation.
+    blockDistances.subvec(0, len - 1) = arma::sqrt(arma::sum(arma::square(
+        candidateBlock.cols(0, len - 1).each_col() - queryPoint), 0));
+
+    for (size_t j = 0; j < len; ++j)
     {
-      pqueue.pop();
-      pqueue.push(c);
+      const size_t referenceIndex = referenceIndices[start + j];
+      // If the points are the same, skip this point.
+      if (skipSelf && (queryIndex == referenceIndex))
+        continue;
+
+      const double distance = blockDistances[j];
+      if (useFlatList)
+      {
+        // Shift the worse candidates down to make room, if this candidate
+        // beats the current k-th best.
+        if (SortPolicy::IsBetter(distance, bestDistances[k - 1]))
+        {
+          size_t pos = k - 1;
+          while (pos > 0 && SortPolicy::IsBetter(distance,
+              bestDistances[pos - 1]))
+          {
+            bestDistances[pos] = bestDistances[pos - 1];
+            bestIndices[pos] = bestIndices[pos - 1];
+            --pos;
+          }
+          bestDistances[pos] = distance;
+          bestIndices[pos] = referenceIndex;
+        }
+      }
+      else
+      {
+        Candidate c = std::make_pair(distance, referenceIndex);
+        // If this distance is better than the worst candidate, insert it.
+        if (CandidateCmp()(c, pqueue.top()))
+        {
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
     }
   }
 
-  for (size_t j = 1; j <= k; j++)
+  if (useFlatList)
+  {
+    for (size_t j = 0; j < k; j++)
+    {
+      neighbors(j, queryIndex) = bestIndices[j];
+      distances(j, queryIndex) = bestDistances[j];
+    }
+  }
+  else
   {
-    neighbors(k - j, queryIndex) = pqueue.top().second;
-    distances(k - j, queryIndex) = pqueue.top().first;
-    pqueue.pop();
+    for (size_t j = 1; j <= k; j++)
+    {
+      neighbors(k - j, queryIndex) = pqueue.top().second;
+      distances(k - j, queryIndex) = pqueue.top().first;
+      pqueue.pop();
+    }
   }
 }
 
@@ -448,42 +588,6 @@ double LSHSearch<SortPolicy>::PerturbationScore(
   return score;
 }
 
-template<typename SortPolicy>
-inline force_inline
-bool LSHSearch<SortPolicy>::PerturbationShift(std::vector<bool>& A) const
-{
-  size_t maxPos = 0;
-  for (size_t i = 0; i < A.size(); ++i)
-    if (A[i] == 1) // Marked true.
-      maxPos = i;
-
-  if (maxPos + 1 < A.size()) // Otherwise, this is an invalid vector.
-  {
-    A[maxPos] = 0;
-    A[maxPos + 1] = 1;
-    return true; // valid
-  }
-  return false; // invalid
-}
-
-template<typename SortPolicy>
-inline force_inline
-bool LSHSearch<SortPolicy>::PerturbationExpand(std::vector<bool>& A) const
-{
-  // Find the last '1' in A.
-  size_t maxPos = 0;
-  for (size_t i = 0; i < A.size(); ++i)
-    if (A[i]) // Marked true.
-      maxPos = i;
-
-  if (maxPos + 1 < A.size()) // Otherwise, this is an invalid vector.
-  {
-    A[maxPos + 1] = 1;
-    return true;
-  }
-  return false;
-}
-
 template<typename SortPolicy>
 inline force_inline
 bool LSHSearch<SortPolicy>::PerturbationValid(
@@ -659,31 +763,46 @@ void LSHSearch<SortPolicy>::GetAdditionalProbingBins(
     do
     {
       // Get the perturbation set corresponding to the minimum score.
+      const double aiScore = minHeap.top().first;
       Ai = perturbationSets[ minHeap.top().second ];
       minHeap.pop(); // .top() returns, .pop() removes
 
-      // Shift operation on Ai (replace max with max+1).
-      std::vector<bool> As = Ai;
+      // Find the largest marked element of Ai once; the scores of the
+      // shifted and expanded sets then follow incrementally from Ai's score
+      // instead of being recomputed with a pass over the whole set.
+      size_t maxPos = 0;
+      for (size_t pos = 0; pos < Ai.size(); ++pos)
+        if (Ai[pos])
+          maxPos = pos;
 
-      // Don't add invalid sets.
-      if (PerturbationShift(As) && PerturbationValid(As))
+      if (maxPos + 1 < Ai.size()) // Otherwise, Ai cannot be perturbed.
       {
-        perturbationSets.push_back(As); // add shifted set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(As, scores),
-            perturbationSets.size() - 1));
-      }
+        // Shift operation on Ai (replace max with max+1).
+        std::vector<bool> As = Ai;
+        As[maxPos] = 0;
+        As[maxPos + 1] = 1;
 
-      // Expand operation on Ai (add max+1 to set).
-      std::vector<bool> Ae = Ai;
+        // Don't add invalid sets.
+        if (PerturbationValid(As))
+        {
+          perturbationSets.push_back(As); // add shifted set to sets
+          minHeap.push(std::make_pair(
+              aiScore - scores[maxPos] + scores[maxPos + 1],
+              perturbationSets.size() - 1));
+        }
 
-      // Don't add invalid sets.
-      if (PerturbationExpand(Ae) && PerturbationValid(Ae))
-      {
-        perturbationSets.push_back(Ae); // add expanded set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(Ae, scores),
-            perturbationSets.size() - 1));
+        // Expand operation on Ai (add max+1 to set).
+        std::vector<bool> Ae = Ai;
+        Ae[maxPos + 1] = 1;
+
+        // Don't add invalid sets.
+        if (PerturbationValid(Ae))
+        {
+          perturbationSets.push_back(Ae); // add expanded set to sets
+          minHeap.push(std::make_pair(
+              aiScore + scores[maxPos + 1],
+              perturbationSets.size() - 1));
+        }
       }
     } while (!PerturbationValid(Ai)); // Discard invalid perturbations
 
@@ -0,0 +1,185 @@
+/**
+ * @file als_matrix_completion.cpp
+ *
+ * Implementation of ALSMatrixCompletion class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include "als_matrix_completion.hpp"
+
+namespace mlpack {
+namespace matrix_completion {
+
+ALSMatrixCompletion::ALSMatrixCompletion(const size_t m,
+                                         const size_t n,
+                                         const arma::umat& indices,
+                                         const arma::vec& values,
+                                         const size_t rank,
+                                         const double lambda,
+                                         const size_t maxIterations,
+                                         const double tolerance) :
+    m(m),
+    n(n),
+    rank(rank),
+    lambda(lambda),
+    maxIterations(maxIterations),
+    tolerance(tolerance)
+{
+  if (indices.n_rows != 2)
+    Log::Fatal << "ALSMatrixCompletion: matrix of entry indices does not have "
+        << "2 rows!" << std::endl;
+  if (indices.n_cols != values.n_elem)
+    Log::Fatal << "ALSMatrixCompletion: the number of entry indices does not "
+        << "match the number of entry values!" << std::endl;
+  for (size_t i = 0; i < values.n_elem; i++)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+      Log::Fatal << "ALSMatrixCompletion: indices (" << indices(0, i) << ", "
+          << indices(1, i) << ") are out of bounds for matrix of size " << m
+          << " x " << n << "!" << std::endl;
+  }
+
+  // A small default rank; unlike the SDP solver there is no exactness
+  // guarantee to preserve, and the cost of each pass is linear in the rank
+  // squared times the number of observed entries.
+  if (this->rank == 0)
+    this->rank = std::min((size_t) 10, std::min(m, n));
+
+  BuildCompressedLayouts(indices, values);
+}
+
+void ALSMatrixCompletion::BuildCompressedLayouts(const arma::umat& indices,
+                                                 const arma::vec& values)
+{
+  const size_t p = values.n_elem;
+
+  // Counting pass, then prefix sums, then a fill pass -- for both layouts.
+  rowPtr.zeros(m + 1);
+  colPtr.zeros(n + 1);
+  for (size_t i = 0; i < p; ++i)
+  {
+    rowPtr[indices(0, i) + 1]++;
+    colPtr[indices(1, i) + 1]++;
+  }
+  for (size_t i = 1; i <= m; ++i)
+    rowPtr[i] += rowPtr[i - 1];
+  for (size_t i = 1; i <= n; ++i)
+    colPtr[i] += colPtr[i - 1];
+
+  rowIndices.set_size(p);
+  rowValues.set_size(p);
+  colIndices.set_size(p);
+  colValues.set_size(p);
+
+  // Working copies of the offsets; they are advanced during the fill pass.
+  arma::Col<size_t> rowOffset(rowPtr.subvec(0, m - 1));
+  arma::Col<size_t> colOffset(colPtr.subvec(0, n - 1));
+  for (size_t i = 0; i < p; ++i)
+  {
+    const size_t row = indices(0, i);
+    const size_t col = indices(1, i);
+
+    rowIndices[rowOffset[row]] = col;
+    rowValues[rowOffset[row]++] = values[i];
+
+    colIndices[colOffset[col]] = row;
+    colValues[colOffset[col]++] = values[i];
+  }
+}
+
+void ALSMatrixCompletion::SolveFactor(arma::mat& target,
+                                      const arma::mat& other,
+                                      const arma::Col<size_t>& ptr,
+                                      const arma::Col<size_t>& otherIndices,
+                                      const arma::vec& entryValues) const
+{
+  // One independent ridge-regularized normal-equation solve per column of
+  // 'target', using only that row's (or column's) observed entries.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) target.n_cols; ++i)
+  {
+    const size_t begin = ptr[i];
+    const size_t end = ptr[i + 1];
+    if (begin == end)
+    {
+      target.col(i).zeros();
+      continue;
+    }
+
+    arma::mat gram(rank, rank, arma::fill::zeros);
+    gram.diag() += lambda;
+    arma::vec rhs(rank, arma::fill::zeros);
+    for (size_t e = begin; e < end; ++e)
+    {
+      const arma::vec otherFactor = other.col(otherIndices[e]);
+      gram += otherFactor * otherFactor.t();
+      rhs += entryValues[e] * otherFactor;
+    }
+
+    target.col(i) = arma::solve(gram, rhs);
+  }
+}
+
+double ALSMatrixCompletion::ObservedRMSE(const arma::mat& u,
+                                         const arma::mat& v) const
+{
+  double squaredError = 0.0;
+
+  #pragma omp parallel for reduction(+:squaredError)
+  for (omp_size_t i = 0; i < (omp_size_t) m; ++i)
+  {
+    for (size_t e = rowPtr[i]; e < rowPtr[i + 1]; ++e)
+    {
+      const double residual = rowValues[e] -
+          arma::dot(u.col(i), v.col(rowIndices[e]));
+      squaredError += residual * residual;
+    }
+  }
+
+  return std::sqrt(squaredError / rowValues.n_elem);
+}
+
+double ALSMatrixCompletion::Recover(arma::mat& u, arma::mat& v)
+{
+  // Warm start: reuse the passed factors if they have the right shape,
+  // otherwise initialize randomly.
+  if (u.n_rows != rank || u.n_cols != m || v.n_rows != rank || v.n_cols != n)
+  {
+    u = arma::randu<arma::mat>(rank, m) / std::sqrt((double) rank);
+    v = arma::randu<arma::mat>(rank, n) / std::sqrt((double) rank);
+  }
+
+  double lastRMSE = DBL_MAX;
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    // Fix V, solve all rows; then fix U, solve all columns.
+    SolveFactor(u, v, rowPtr, rowIndices, rowValues);
+    SolveFactor(v, u, colPtr, colIndices, colValues);
+
+    const double rmse = ObservedRMSE(u, v);
+    Log::Info << "ALSMatrixCompletion: iteration " << iteration
+        << ", observed RMSE " << rmse << "." << std::endl;
+    if (lastRMSE - rmse < tolerance * std::max(lastRMSE, 1e-12))
+    {
+      lastRMSE = rmse;
+      break;
+    }
+    lastRMSE = rmse;
+  }
+
+  return lastRMSE;
+}
+
+void ALSMatrixCompletion::Recover(arma::mat& recovered)
+{
+  arma::mat u, v;
+  Recover(u, v);
+  recovered = u.t() * v;
+}
+
+} // namespace matrix_completion
+} // namespace mlpack
@@ -0,0 +1,164 @@
+/**
+ * @file als_matrix_completion.hpp
+ *
+ * Factorized alternating least squares matrix completion for large-scale
+ * problems, where the dense SDP machinery of MatrixCompletion is infeasible.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+/**
+ * This class solves low-rank matrix completion problems by ridge-regularized
+ * alternating least squares on an explicit factorization X = U * V^T, using
+ * only the observed entries:
+ *
+ *   min_{U, V} sum_{(i, j) observed} (M_ij - u_i^T v_j)^2
+ *                  + lambda (||U||_F^2 + ||V||_F^2)
+ *
+ * The observed entries are stored once in compressed row and column layouts,
+ * so each alternating pass walks them sequentially; the per-row (and
+ * per-column) least squares solves are independent and are distributed across
+ * OpenMP threads.  Memory and time scale with the number of observed entries
+ * and the factor rank, never with m * n, which makes this the appropriate
+ * solver when the matrix is large and sparsely observed.  For small, densely
+ * observed problems where exact recovery guarantees matter, use
+ * MatrixCompletion instead.
+ *
+ * Recover(u, v) supports warm restarts: if the passed factor matrices already
+ * have the right dimensions (for example, from a previous night's solution on
+ * slightly different observations), they are used as the starting point
+ * instead of a random initialization.
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ * arma::mat u, v;      // will contain the factors of the completed matrix
+ *
+ * ALSMatrixCompletion mc(m, n, indices, values, 10);
+ * mc.Recover(u, v);    // entry (i, j) is dot(u.col(i), v.col(j))
+ * @endcode
+ */
+class ALSMatrixCompletion
+{
+ public:
+  /**
+   * Construct a factorized matrix completion problem.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param rank Rank of the factorization (0 means a default is chosen).
+   * @param lambda Ridge regularization parameter.
+   * @param maxIterations Maximum number of alternating passes.
+   * @param tolerance Terminate when the relative decrease of the observed
+   *    RMSE between passes falls below this.
+   */
+  ALSMatrixCompletion(const size_t m,
+                      const size_t n,
+                      const arma::umat& indices,
+                      const arma::vec& values,
+                      const size_t rank = 0,
+                      const double lambda = 1e-2,
+                      const size_t maxIterations = 50,
+                      const double tolerance = 1e-5);
+
+  /**
+   * Run alternating least squares and return the factors.  If u is rank x m
+   * and v is rank x n on input, they are used as a warm start; otherwise both
+   * factors are randomly initialized.  Entry (i, j) of the completed matrix
+   * is dot(u.col(i), v.col(j)).
+   *
+   * @param u Will contain the row factors (rank x m).
+   * @param v Will contain the column factors (rank x n).
+   * @return Observed-entry RMSE of the returned factorization.
+   */
+  double Recover(arma::mat& u, arma::mat& v);
+
+  /**
+   * Run alternating least squares and assemble the dense completed matrix.
+   * Only sensible for problem sizes where an m x n dense matrix fits in
+   * memory; for truly large problems use the factorized overload.
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  //! Get the rank of the factorization.
+  size_t Rank() const { return rank; }
+  //! Get the ridge regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the ridge regularization parameter.
+  double& Lambda() { return lambda; }
+  //! Get the maximum number of alternating passes.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of alternating passes.
+  size_t& MaxIterations() { return maxIterations; }
+  //! Get the termination tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the termination tolerance.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! Rank of the factorization.
+  size_t rank;
+  //! Ridge regularization parameter.
+  double lambda;
+  //! Maximum number of alternating passes.
+  size_t maxIterations;
+  //! Termination tolerance on the relative RMSE decrease.
+  double tolerance;
+
+  //! Observed entries in compressed row layout: entries of row i are
+  //! rowValues[rowPtr[i] .. rowPtr[i + 1] - 1], in columns rowIndices[...].
+  arma::Col<size_t> rowPtr;
+  arma::Col<size_t> rowIndices;
+  arma::vec rowValues;
+
+  //! The same entries in compressed column layout.
+  arma::Col<size_t> colPtr;
+  arma::Col<size_t> colIndices;
+  arma::vec colValues;
+
+  //! Build the compressed layouts from the (indices, values) input.
+  void BuildCompressedLayouts(const arma::umat& indices,
+                              const arma::vec& values);
+
+  /**
+   * Solve the regularized least squares problems for all columns of 'target'
+   * given the other factor: one independent rank x rank solve per column,
+   * distributed across threads.
+   */
+  void SolveFactor(arma::mat& target,
+                   const arma::mat& other,
+                   const arma::Col<size_t>& ptr,
+                   const arma::Col<size_t>& otherIndices,
+                   const arma::vec& entryValues) const;
+
+  //! Observed-entry root mean squared error of the given factorization.
+  double ObservedRMSE(const arma::mat& u, const arma::mat& v) const;
+};
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+#endif
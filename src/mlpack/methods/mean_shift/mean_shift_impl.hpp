@@ -139,21 +139,30 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>& distances,
                   arma::colvec& centroid)
 {
+  // Gather the kernel weights in one pass, then compute the weighted mean
+  // with a single matrix-vector product instead of one scaled vector
+  // addition per neighbor.
+  arma::uvec validNeighbors(neighbors.size());
+  arma::vec weights(neighbors.size());
   double sumWeight = 0;
+  size_t found = 0;
   for (size_t i = 0; i < neighbors.size(); ++i)
   {
     if (distances[i] > 0)
     {
-      double dist = distances[i] / radius;
-      double weight = kernel.Gradient(dist) / dist;
+      const double dist = distances[i] / radius;
+      const double weight = kernel.Gradient(dist) / dist;
+      weights[found] = weight;
+      validNeighbors[found] = neighbors[i];
       sumWeight += weight;
-      centroid += weight * data.unsafe_col(neighbors[i]);
+      ++found;
     }
   }
 
   if (sumWeight != 0)
   {
-    centroid /= sumWeight;
+    centroid += data.cols(validNeighbors.head(found)) *
+        (weights.head(found) / sumWeight);
     return true;
   }
   return false;
@@ -169,10 +178,8 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>&, /*unused*/
                   arma::colvec& centroid)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
-    centroid += data.unsafe_col(neighbors[i]);
-
-  centroid /= neighbors.size();
+  const arma::uvec neighborIndices = arma::conv_to<arma::uvec>::from(neighbors);
+  centroid += arma::sum(data.cols(neighborIndices), 1) / neighbors.size();
   return true;
 }
 
@@ -212,53 +219,94 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  // Initial centroids are the seeds themselves.
+  allCentroids = *pSeeds;
+
+  // Every seed starts out moving, and leaves the active set once its shift
+  // has converged or it has no neighbors left.  Seeds shift independently,
+  // so each round performs a single batched range search over all of the
+  // seeds still moving---amortizing the tree traversal---and then updates
+  // the seeds in parallel.
+  arma::uvec activeSeeds(pSeeds->n_cols);
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+
+  // Marks seeds whose mean shift has converged.
+  std::vector<char> converged(pSeeds->n_cols, 0);
+
+  size_t completedIterations = 0;
+  while (activeSeeds.n_elem > 0 &&
+      (completedIterations < maxIterations || forceConvergence))
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // One batched query for all of the seeds that are still moving.
+    const arma::mat activeCentroids = allCentroids.cols(activeSeeds);
+    rangeSearcher.Search(activeCentroids, validRadius, neighbors, distances);
+
+    std::vector<char> stillMoving(activeSeeds.n_elem, 1);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t j = 0; j < (omp_size_t) activeSeeds.n_elem; ++j)
     {
+      const size_t i = activeSeeds[j];
+
+      if (neighbors[j].size() == 0) // There are no points in the cluster.
+      {
+        stillMoving[j] = 0;
+        continue;
+      }
+
       // Store new centroid in this.
       arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
-
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
         newCentroid = allCentroids.unsafe_col(i);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
           allCentroids.unsafe_col(i)) < 1e-3 * radius)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
-
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        converged[i] = 1;
+        stillMoving[j] = 0;
+        continue;
       }
 
       // Update the centroid.
       allCentroids.col(i) = newCentroid;
     }
+
+    // Shrink the active set, preserving seed order.
+    size_t remaining = 0;
+    for (size_t j = 0; j < activeSeeds.n_elem; ++j)
+      if (stillMoving[j])
+        activeSeeds[remaining++] = activeSeeds[j];
+    activeSeeds.resize(remaining);
+
+    ++completedIterations;
+  }
+
+  // Merge the converged centroids, dropping any that duplicate an earlier
+  // one.  Seeds are processed in order, so the result matches the serial
+  // algorithm.
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  {
+    if (!converged[i])
+      continue;
+
+    // Determine if the new centroid is duplicate with old ones.
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+      if (distance < radius)
+      {
+        isDuplicated = true;
+        break;
+      }
+    }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -30,11 +30,57 @@ void MVU::Unfold(const size_t newDim,
                  const size_t numNeighbors,
                  arma::mat& outputData)
 {
-  // First we have to choose the output point.  We'll take a linear projection
-  // of the data for now (this is probably not a good final solution).
-//  outputData = trans(data.rows(0, newDim - 1));
-  // Following Nick's idea.
-  outputData.randu(data.n_cols, newDim);
+  // We need the nearest neighbors up front, both for the constraints and for
+  // the warm start.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  KNN knn(data);
+  knn.Search(numNeighbors, neighbors, distances);
+
+  // Warm-start the low-rank factor from a spectral embedding of the neighbor
+  // graph: the bottom nontrivial eigenvectors of the graph Laplacian are a
+  // Laplacian-eigenmaps unfolding, which is far closer to the MVU optimum
+  // than a random point, so the augmented Lagrangian iterations start nearly
+  // feasible.  Build the symmetric adjacency sparsely via batch insertion.
+  const size_t n = data.n_cols;
+  arma::umat locations(2, 2 * numNeighbors * n);
+  arma::vec values(2 * numNeighbors * n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = 0; j < numNeighbors; ++j)
+    {
+      const size_t index = 2 * ((i * numNeighbors) + j);
+      locations(0, index) = i;
+      locations(1, index) = neighbors(j, i);
+      values(index) = 1.0;
+      locations(0, index + 1) = neighbors(j, i);
+      locations(1, index + 1) = i;
+      values(index + 1) = 1.0;
+    }
+  }
+
+  // Duplicate edges are summed; the Laplacian only needs connectivity.
+  arma::sp_mat adjacency(true, locations, values, n, n);
+  arma::sp_mat laplacian = -adjacency;
+  laplacian.diag() += arma::vec(arma::sum(adjacency, 1));
+
+  arma::vec eigval;
+  arma::mat eigvec;
+  if (arma::eigs_sym(eigval, eigvec, laplacian, newDim + 1, "sm") &&
+      eigvec.n_cols == newDim + 1)
+  {
+    // Drop the constant eigenvector and scale so that the embedding has the
+    // same total variance as the input data.
+    outputData = eigvec.cols(1, newDim);
+    outputData *= std::sqrt(arma::accu(arma::var(data, 0, 1)) * n);
+  }
+  else
+  {
+    Log::Warn << "MVU::Unfold(): spectral warm start failed; falling back to "
+        << "a random initial point." << std::endl;
+    outputData.randu(data.n_cols, newDim);
+  }
 
   // The number of constraints is the number of nearest neighbors plus one.
   LRSDP<arma::sp_mat> mvuSolver(numNeighbors * data.n_cols + 1, outputData);
@@ -54,18 +100,14 @@ void MVU::Unfold(const size_t newDim,
   mvuSolver.AModes().ones();
   mvuSolver.AModes()[0] = 0;
 
-  // Now all of the other constraints.  We first have to run KNN to get the
-  // list of nearest neighbors.
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  KNN knn(data);
-  knn.Search(numNeighbors, neighbors, distances);
-
-  // Add each of the other constraints.  They are sparse constraints:
+  // Add each of the other constraints, assembled directly from the kNN
+  // result in sparse coordinate form (no dense intermediate).  Each
+  // constraint touches its own slot of A() and B(), so the assembly
+  // parallelizes cleanly:
   //   Tr(A_ij K) = d_ij;
   //   A_ij = zeros except for 1 at (i, i), (j, j); -1 at (i, j), (j, i).
-  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) neighbors.n_cols; ++i)
   {
     for (size_t j = 0; j < numNeighbors; ++j)
     {
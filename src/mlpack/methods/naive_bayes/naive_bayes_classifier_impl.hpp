@@ -106,19 +106,59 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   if (incremental)
   {
     // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
+    // First, de-normalize probabilities to recover the per-class counts, and
+    // de-normalize the variances to recover the unnormalized second moments
+    // (M2), so that the new data reduces to a merge of sufficient statistics.
     probabilities *= trainingPoints;
-
-    for (size_t j = 0; j < data.n_cols; ++j)
+    for (size_t i = 0; i < probabilities.n_elem; ++i)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
+      if (probabilities[i] > 2)
+        variances.col(i) *= (probabilities[i] - 1);
+    }
 
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+    // Each thread runs Welford's algorithm over its own block of columns,
+    // accumulating per-class count/mean/M2 statistics; the per-thread
+    // statistics are then merged into the model with Chan et al.'s pairwise
+    // update, which is exact regardless of how the columns were split.
+    #pragma omp parallel
+    {
+      arma::Col<ElemType> blockCounts(probabilities.n_elem,
+          arma::fill::zeros);
+      ModelMatType blockMeans(data.n_rows, probabilities.n_elem,
+          arma::fill::zeros);
+      ModelMatType blockM2(data.n_rows, probabilities.n_elem,
+          arma::fill::zeros);
+
+      #pragma omp for nowait
+      for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+      {
+        const size_t label = labels[j];
+        ++blockCounts[label];
+
+        arma::Col<ElemType> delta = data.col(j) - blockMeans.col(label);
+        blockMeans.col(label) += delta / blockCounts[label];
+        blockM2.col(label) += delta % (data.col(j) - blockMeans.col(label));
+      }
+
+      #pragma omp critical
+      {
+        for (size_t i = 0; i < probabilities.n_elem; ++i)
+        {
+          if (blockCounts[i] == 0)
+            continue;
+
+          const ElemType oldCount = probabilities[i];
+          const ElemType newCount = oldCount + blockCounts[i];
+          const arma::Col<ElemType> delta = blockMeans.col(i) - means.col(i);
+          means.col(i) += (blockCounts[i] / newCount) * delta;
+          variances.col(i) += blockM2.col(i) +
+              (delta % delta) * (oldCount * blockCounts[i] / newCount);
+          probabilities[i] = newCount;
+        }
+      }
     }
 
+    // Re-normalize the second moments into variances.
     for (size_t i = 0; i < probabilities.n_elem; ++i)
     {
       if (probabilities[i] > 2)
@@ -169,8 +209,10 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     if (variances[i] == 0.0)
       variances[i] = 1e-50;
 
-  probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+  // In the incremental case the class counts cover every point seen so far,
+  // not just this batch.
+  probabilities /= (incremental ? trainingPoints : data.n_cols);
 }
 
 template<typename ModelMatType>
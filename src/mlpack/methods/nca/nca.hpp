@@ -86,6 +86,20 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Access the number of neighbors the softmax sums are truncated to (0
+  //! means no truncation; see SoftmaxErrorFunction).
+  const size_t& NumNeighbors() const { return errorFunction.NumNeighbors(); }
+  //! Modify the number of neighbors the softmax sums are truncated to.
+  size_t& NumNeighbors() { return errorFunction.NumNeighbors(); }
+
+  //! Access the number of evaluations between refreshes of the truncated
+  //! neighbor lists.
+  const size_t& RecalculationInterval() const
+  { return errorFunction.RecalculationInterval(); }
+  //! Modify the number of evaluations between neighbor list refreshes.
+  size_t& RecalculationInterval()
+  { return errorFunction.RecalculationInterval(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -38,11 +39,25 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * By default every point contributes to the softmax sums of every other point,
+ * so each objective or gradient evaluation costs O(n^2 d).  Because the
+ * contribution exp(-d(A x_i, A x_k)) decays exponentially with distance, far
+ * away points contribute negligible softmax mass; setting NumNeighbors() to a
+ * nonzero value truncates the sums to the nearest neighbors of each point,
+ * found with a tree-based search on the transformed dataset.  The neighbor
+ * lists are refreshed every RecalculationInterval() evaluations, so the
+ * effective cost drops to O(n k d) at the price of a (typically tiny)
+ * approximation error.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
 {
  public:
+  //! Convenience typedef for the neighbor search used in truncated mode.
+  typedef neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType>
+      KNN;
+
   /**
    * Initialize with the given kernel; useful when the kernel has some state to
    * store, which is set elsewhere.  If no kernel is given, an empty kernel is
@@ -129,6 +144,18 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors the softmax sums are truncated to (0 means
+  //! no truncation; every pair of points is considered).
+  const size_t& NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of neighbors the softmax sums are truncated to.
+  size_t& NumNeighbors() { return numNeighbors; }
+
+  //! Get the number of evaluations between refreshes of the truncated
+  //! neighbor lists.
+  const size_t& RecalculationInterval() const { return recalculationInterval; }
+  //! Modify the number of evaluations between neighbor list refreshes.
+  size_t& RecalculationInterval() { return recalculationInterval; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
@@ -152,6 +179,16 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! Number of neighbors to truncate the softmax sums to (0 means exact).
+  size_t numNeighbors;
+  //! Number of evaluations between refreshes of the neighbor lists.
+  size_t recalculationInterval;
+  //! Number of evaluations since the neighbor lists were last refreshed.
+  size_t updatesSinceRecalculation;
+  //! Truncated neighbor lists; column i holds the neighbors of point i.
+  //! Empty when no truncation is in effect or the lists are invalidated.
+  arma::Mat<size_t> neighbors;
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
@@ -166,6 +203,14 @@ class SoftmaxErrorFunction
    * @param coordinates Coordinates matrix to use for precalculation.
    */
   void Precalculate(const arma::mat& coordinates);
+
+  /**
+   * Refresh the truncated neighbor lists with a tree query on the current
+   * stretched dataset, if truncation is in effect and the lists are missing
+   * or have been used for RecalculationInterval() evaluations.  This is a
+   * no-op when NumNeighbors() is zero.
+   */
+  void UpdateNeighbors();
 };
 
 } // namespace nca
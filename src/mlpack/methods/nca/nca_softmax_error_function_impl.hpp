@@ -27,7 +27,10 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
-    precalculated(false)
+    precalculated(false),
+    numNeighbors(0),
+    recalculationInterval(100),
+    updatesSinceRecalculation(0)
 { /* nothing to do */ }
 
 //! Shuffle the dataset.
@@ -44,6 +47,10 @@ void SoftmaxErrorFunction<MetricType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // Any truncated neighbor lists now refer to the old point ordering.
+  neighbors.reset();
+  updatesSinceRecalculation = 0;
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -65,17 +72,24 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
                                                   const size_t batchSize)
 {
   // Unfortunately each evaluation will take O(N) time because it requires a
-  // scan over all points in the dataset.  Our objective is to compute p_i.
+  // scan over all points in the dataset (or over the truncated neighbor lists
+  // when NumNeighbors() is set).  Our objective is to compute p_i.
   double denominator = 0;
   double numerator = 0;
   double result = 0;
 
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
+  UpdateNeighbors();
+  const size_t neighborCount = (numNeighbors > 0) ? neighbors.n_rows :
+      dataset.n_cols;
   for (size_t i = begin; i < begin + batchSize; i++)
   {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    for (size_t j = 0; j < neighborCount; ++j)
     {
+      // In truncated mode the neighbor lists never contain the point itself.
+      const size_t k = (numNeighbors > 0) ? neighbors(j, i) : j;
+
       // Don't consider the case where the points are the same.
       if (k == i)
         continue;
@@ -127,25 +141,54 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+  if (numNeighbors > 0)
   {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; k++)
+    // In truncated mode the neighbor lists are directed, so we accumulate the
+    // contribution of each ordered pair (i, k) separately.
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
     {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+      {
+        const size_t k = neighbors(j, i);
 
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
+        // Calculate p_ik.
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
+        double p_ik = eval / denominators(i);
 
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+        // Subtract x_i from x_k.  We are not using stretched points here.
+        arma::vec x_ik = dataset.col(i) - dataset.col(k);
+        arma::mat secondTerm = (x_ik * trans(x_ik));
+
+        if (labels[i] == labels[k])
+          sum += (p[i] - 1) * p_ik * secondTerm;
+        else
+          sum += p[i] * p_ik * secondTerm;
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+    {
+      for (size_t k = (i + 1); k < stretchedDataset.n_cols; k++)
+      {
+        // Calculate p_ik and p_ki first.
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
+        double p_ik = 0, p_ki = 0;
+        p_ik = eval / denominators(i);
+        p_ki = eval / denominators(k);
+
+        // Subtract x_i from x_k.  We are not using stretched points here.
+        arma::vec x_ik = dataset.col(i) - dataset.col(k);
+        arma::mat secondTerm = (x_ik * trans(x_ik));
+
+        if (labels[i] == labels[k])
+          sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
+        else
+          sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      }
     }
   }
 
@@ -172,6 +215,9 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
+  UpdateNeighbors();
+  const size_t neighborCount = (numNeighbors > 0) ? neighbors.n_rows :
+      dataset.n_cols;
   for (size_t i = begin; i < begin + batchSize; i++)
   {
     numerator = 0;
@@ -180,8 +226,11 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
     secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    for (size_t j = 0; j < neighborCount; ++j)
     {
+      // In truncated mode the neighbor lists never contain the point itself.
+      const size_t k = (numNeighbors > 0) ? neighbors(j, i) : j;
+
       // Don't consider the case where the points are the same.
       if (i == k)
         continue;
@@ -254,6 +303,7 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   // Coordinates are different; save the new ones, and stretch the dataset.
   lastCoordinates = coordinates;
   stretchedDataset = coordinates * dataset;
+  UpdateNeighbors();
 
   // For each point i, we must evaluate the softmax function:
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
@@ -263,23 +313,46 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   // order of O((n * (n + 1)) / 2), which really isn't all that great.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+  if (numNeighbors > 0)
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; j++)
+    // The truncated neighbor lists are directed, so we can only accumulate
+    // the sums of point i from the neighbors of point i.
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+      {
+        const size_t k = neighbors(j, i);
 
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+        // Evaluate exp(-d(x_i, x_k)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+        denominators[i] += eval;
+        if (labels[i] == labels[k])
+          p[i] += eval;
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+    {
+      for (size_t j = (i + 1); j < stretchedDataset.n_cols; j++)
       {
-        p[i] += eval;
-        p[j] += eval;
+        // Evaluate exp(-d(x_i, x_j)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(j)));
+
+        // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
+        denominators[i] += eval;
+        denominators[j] += eval;
+
+        // If i and j are the same class, add to numerator of both.
+        if (labels[i] == labels[j])
+        {
+          p[i] += eval;
+          p[j] += eval;
+        }
       }
     }
   }
@@ -304,6 +377,31 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::UpdateNeighbors()
+{
+  if (numNeighbors == 0)
+    return; // No truncation; nothing to maintain.
+
+  // Reuse the existing lists until they have been used for
+  // recalculationInterval evaluations.
+  if (!neighbors.is_empty() &&
+      (updatesSinceRecalculation < recalculationInterval))
+  {
+    ++updatesSinceRecalculation;
+    return;
+  }
+
+  // Query the current stretched dataset; since the query set and reference
+  // set are identical, the search will not return a point as its own
+  // neighbor.
+  KNN knn(stretchedDataset);
+  arma::mat neighborDistances;
+  knn.Search(std::min(numNeighbors, (size_t) dataset.n_cols - 1), neighbors,
+      neighborDistances);
+  updatesSinceRecalculation = 0;
+}
+
 } // namespace nca
 } // namespace mlpack
 
@@ -12,6 +12,8 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/cli.hpp>
+#include <mlpack/core/data/load.hpp>
+#include <mlpack/core/data/save.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
@@ -19,6 +21,7 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "neighbor_search.hpp"
 #include "unmap.hpp"
@@ -90,6 +93,14 @@ PARAM_MODEL_OUT(KNNModel, "output_model", "If specified, the kNN model will be "
 PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
 PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 
+// Alternately, many query sets may be run against the same resident model.
+PARAM_STRING_IN("query_batch", "File containing one query job per line, in the"
+    " form '<query file> <neighbors output file> <distances output file>'; "
+    "each query set is searched against the same model, so the reference tree "
+    "is built (or loaded) only once.  If '-' is given, jobs are read from "
+    "standard input as they arrive, keeping the model resident until input is "
+    "closed.", "Q", "");
+
 // The user may specify the type of tree to use, and a few parameters for tree
 // building.
 PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
@@ -104,6 +115,11 @@ PARAM_DOUBLE_IN("tau", "Overlapping size (only valid for spill trees).", "u",
 PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
     0.7);
 
+PARAM_FLAG("auto_tune", "Before tree-building, automatically select the tree "
+    "type and leaf size by building candidate trees on a subsample of the "
+    "reference set and timing representative queries on them; overrides "
+    "--tree_type and --leaf_size.", "A");
+
 PARAM_FLAG("random_basis", "Before tree-building, project the data onto a "
     "random orthogonal basis.", "R");
 PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
@@ -113,6 +129,8 @@ PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
     "'dual_tree', 'greedy'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_INT_IN("num_threads", "Number of threads to use for dual-tree search "
+    "(0 uses the OpenMP default, e.g. OMP_NUM_THREADS).", "j", 0);
 
 static void mlpackMain()
 {
@@ -121,13 +139,29 @@ static void mlpackMain()
   else
     math::RandomSeed((size_t) std::time(NULL));
 
+  // Cap the number of threads used for the search, if requested.
+  RequireParamValue<int>("num_threads", [](int x) { return x >= 0; }, true,
+      "number of threads must be non-negative");
+#ifdef HAS_OPENMP
+  if (CLI::GetParam<int>("num_threads") > 0)
+    omp_set_num_threads(CLI::GetParam<int>("num_threads"));
+#else
+  if (CLI::GetParam<int>("num_threads") > 1)
+    Log::Warn << "--num_threads ignored; mlpack was built without OpenMP."
+        << endl;
+#endif
+
   // A user cannot specify both reference data and a model.
   RequireOnlyOnePassed({ "reference", "input_model" }, true);
 
   ReportIgnoredParam({{ "input_model", true }}, "tree_type");
+  ReportIgnoredParam({{ "input_model", true }}, "auto_tune");
   ReportIgnoredParam({{ "input_model", true }}, "random_basis");
   ReportIgnoredParam({{ "input_model", true }}, "tau");
   ReportIgnoredParam({{ "input_model", true }}, "rho");
+  ReportIgnoredParam({{ "auto_tune", true }}, "tree_type");
+  ReportIgnoredParam({{ "auto_tune", true }}, "leaf_size");
+
   if (CLI::HasParam("input_model") && CLI::HasParam("leaf_size"))
   {
     Log::Warn << PRINT_PARAM_STRING("leaf_size") << " will only be considered"
@@ -152,6 +186,14 @@ static void mlpackMain()
   ReportIgnoredParam({{ "k", false }}, "true_neighbors");
   ReportIgnoredParam({{ "k", false }}, "true_distances");
   ReportIgnoredParam({{ "k", false }}, "query");
+  ReportIgnoredParam({{ "k", false }}, "query_batch");
+
+  // A single query set and a batch of query sets cannot both be given.
+  if (CLI::HasParam("query") && CLI::HasParam("query_batch"))
+  {
+    Log::Fatal << "Only one of " << PRINT_PARAM_STRING("query") << " or "
+        << PRINT_PARAM_STRING("query_batch") << " may be specified!" << endl;
+  }
 
   // Sanity check on leaf size.
   RequireParamValue<int>("leaf_size", [](int x) { return x > 0; },
@@ -253,8 +295,22 @@ static void mlpackMain()
         << referenceSet.n_rows << " x " << referenceSet.n_cols << ")."
         << endl;
 
-    knn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
-        epsilon);
+    if (CLI::HasParam("auto_tune"))
+    {
+      // Select the tree type and leaf size on a subsample before building
+      // the full index.  If no k was given, tune for single-neighbor
+      // queries.
+      const size_t tuneK = CLI::HasParam("k") ?
+          (size_t) CLI::GetParam<int>("k") : 1;
+      knn->AutoTune(referenceSet, tuneK, searchMode, epsilon);
+      knn->BuildModel(std::move(referenceSet), knn->LeafSize(), searchMode,
+          epsilon);
+    }
+    else
+    {
+      knn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
+          epsilon);
+    }
   }
   else
   {
@@ -282,15 +338,6 @@ static void mlpackMain()
   {
     const size_t k = (size_t) CLI::GetParam<int>("k");
 
-    arma::mat queryData;
-    if (CLI::HasParam("query"))
-    {
-      queryData = std::move(CLI::GetParam<arma::mat>("query"));
-      Log::Info << "Loaded query data from '"
-          << CLI::GetPrintableParam<arma::mat>("query") << "' ("
-          << queryData.n_rows << "x" << queryData.n_cols << ")." << endl;
-    }
-
     // Sanity check on k value: must be greater than 0, must be less than or
     // equal to the number of reference points.  Since it is unsigned,
     // we only test the upper bound.
@@ -301,6 +348,69 @@ static void mlpackMain()
           << knn->Dataset().n_cols << ")." << endl;
     }
 
+    // Batch mode: run each listed query set against the resident model, so
+    // that the reference tree built (or loaded) above is reused across all of
+    // them.
+    if (CLI::HasParam("query_batch"))
+    {
+      const string batchFile = CLI::GetParam<string>("query_batch");
+
+      ifstream f;
+      istream* jobs = &cin;
+      if (batchFile != "-")
+      {
+        f.open(batchFile.c_str());
+        if (!f.is_open())
+        {
+          Log::Fatal << "Could not open '" << batchFile << "' for reading."
+              << endl;
+        }
+        jobs = &f;
+      }
+
+      string line;
+      while (getline(*jobs, line))
+      {
+        if (line.empty())
+          continue;
+
+        istringstream tokens(line);
+        string queryFile, neighborsFile, distancesFile;
+        tokens >> queryFile >> neighborsFile >> distancesFile;
+        if (distancesFile.empty())
+        {
+          Log::Fatal << "Each line of the query batch must have the form "
+              << "'<query file> <neighbors output file> <distances output "
+              << "file>'!" << endl;
+        }
+
+        arma::mat queryData;
+        data::Load(queryFile, queryData, true); // Fatal on failure.
+        Log::Info << "Loaded query data from '" << queryFile << "' ("
+            << queryData.n_rows << "x" << queryData.n_cols << ")." << endl;
+
+        arma::Mat<size_t> neighbors;
+        arma::mat distances;
+        knn->Search(std::move(queryData), k, neighbors, distances);
+
+        data::Save(neighborsFile, neighbors, true);
+        data::Save(distancesFile, distances, true);
+        Log::Info << "Completed query set '" << queryFile << "'." << endl;
+      }
+
+      CLI::GetParam<KNNModel*>("output_model") = knn;
+      return;
+    }
+
+    arma::mat queryData;
+    if (CLI::HasParam("query"))
+    {
+      queryData = std::move(CLI::GetParam<arma::mat>("query"));
+      Log::Info << "Loaded query data from '"
+          << CLI::GetPrintableParam<arma::mat>("query") << "' ("
+          << queryData.n_rows << "x" << queryData.n_cols << ")." << endl;
+    }
+
     // Sanity check on k value: must not be equal to the number of reference
     // points when query data has not been provided.
     if (!CLI::HasParam("query") && k == knn->Dataset().n_cols)
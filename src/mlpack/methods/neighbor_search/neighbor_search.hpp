@@ -196,6 +196,19 @@ class NeighborSearch
    */
   void Train(MatType referenceSet);
 
+  /**
+   * Set the reference set to the given set of reference points, converting the
+   * element type of the matrix to the element type used by the index.  This is
+   * useful for storing the reference set (and the tree built on it) at reduced
+   * precision: with MatType set to arma::fmat, a double-precision dataset can
+   * be indexed at half the memory cost.  The conversion is performed once,
+   * before the tree is built.
+   *
+   * @param referenceSet New set of reference data, at a different precision.
+   */
+  template<typename OtherMatType>
+  void Train(const OtherMatType& referenceSet);
+
   /**
    * Set the reference tree to a new reference tree.  The tree is copied by
    * default, but the copy can be avoided by using std::move() to transfer the
@@ -229,6 +242,26 @@ class NeighborSearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * For each point in the query set, compute the nearest neighbors, converting
+   * the element type of the query set to the element type used by the index.
+   * This allows double-precision queries against an index stored at reduced
+   * precision (for instance a tree built on an arma::fmat reference set).  The
+   * conversion is performed once, before the search; distances are still
+   * reported in double precision.
+   *
+   * @param querySet Set of query points, at a different precision.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  template<typename OtherMatType>
+  void Search(const OtherMatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
   /**
    * Given a pre-built query tree, search for the nearest neighbors of each
    * point in the query tree, storing the output in the given matrices.  The
@@ -322,6 +355,19 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the warm-start slack (negative if warm-starting is disabled).
+  double WarmStartSlack() const { return warmStartSlack; }
+  //! Modify the warm-start slack.  When non-negative, monochromatic dual-tree
+  //! searches loosen the bounds kept from the previous traversal by this
+  //! amount instead of resetting them to the worst case, which saves node
+  //! visits when the reference points have moved only slightly between
+  //! searches.  The slack must cover the largest distance any reference point
+  //! may have moved; otherwise results may become approximate.  The repeated
+  //! searches must use the same k (bounds computed for a smaller k are not
+  //! valid for a larger one).  Set negative (the default) to reset the bounds
+  //! fully on every search.
+  double& WarmStartSlack() { return warmStartSlack; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -346,6 +392,9 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! Slack used to warm-start bounds from the previous traversal (negative if
+  //! warm-starting is disabled).
+  double warmStartSlack;
 
   //! Instantiation of metric.
   MetricType metric;
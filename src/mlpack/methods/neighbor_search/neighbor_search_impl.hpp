@@ -17,6 +17,7 @@
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
+#include <queue>
 
 namespace mlpack {
 namespace neighbor {
@@ -45,6 +46,36 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Collect disjoint subtrees of the given tree that together cover all of its
+//! points, expanding breadth-first until at least the requested number of
+//! roots is available (or no further expansion is possible).  Used to hand
+//! independent pieces of a traversal to different threads.
+template<typename TreeType>
+std::vector<TreeType*> DecomposeTree(TreeType* root, const size_t targetRoots)
+{
+  std::vector<TreeType*> roots;
+  std::queue<TreeType*> queue;
+  queue.push(root);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    // Stop expanding once we have enough pieces; count what is still queued.
+    if (node->NumChildren() == 0 ||
+        (roots.size() + queue.size()) >= targetRoots)
+    {
+      roots.push_back(node);
+      queue.pop();
+      continue;
+    }
+
+    queue.pop();
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      queue.push(&node->Child(i));
+  }
+
+  return roots;
+}
+
 // Construct the object.
 template<typename SortPolicy,
          typename MetricType,
@@ -65,6 +96,7 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    warmStartSlack(-1.0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -92,6 +124,7 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    warmStartSlack(-1.0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -118,6 +151,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     referenceSet(new MatType()), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    warmStartSlack(-1.0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -151,6 +185,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    warmStartSlack(other.warmStartSlack),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -175,6 +210,7 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    warmStartSlack(other.warmStartSlack),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -187,6 +223,7 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.warmStartSlack = -1.0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -229,6 +266,7 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  warmStartSlack = other.warmStartSlack;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -271,6 +309,7 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  warmStartSlack = other.warmStartSlack;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -282,6 +321,7 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.warmStartSlack = -1.0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -341,6 +381,25 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
   }
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename OtherMatType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Train(
+    const OtherMatType& referenceSetIn)
+{
+  // Convert the element type once, then hand off to the usual Train().  This
+  // lets a double-precision dataset be indexed at reduced precision (e.g. with
+  // MatType set to arma::fmat).
+  Train(arma::conv_to<MatType>::from(referenceSetIn));
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -430,6 +489,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
 
+#ifdef HAS_OPENMP
+  // Number of query points each thread handles at a time in the parallel
+  // single-tree path; one block amortizes cache misses on the reference tree
+  // across its queries.
+  const size_t queryBlockSize = 64;
+#endif
+
   switch (searchMode)
   {
     case NAIVE_MODE:
@@ -449,6 +515,62 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case SINGLE_TREE_MODE:
     {
+#ifdef HAS_OPENMP
+      // Process the query points in blocks: each thread traverses the tree
+      // for a whole contiguous block of queries with its own rule set, which
+      // keeps the reference nodes that a block touches hot in cache and
+      // shares no traversal state between threads (the per-node base case
+      // cache used by self-children trees lives in the rule set, not in the
+      // shared reference tree).
+      if (omp_get_max_threads() > 1 && querySet.n_cols >= 2 * queryBlockSize)
+      {
+        const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+            queryBlockSize;
+
+        #pragma omp parallel
+        {
+          RuleType threadRules(*referenceSet, querySet, k, metric, epsilon);
+          std::vector<size_t> processed;
+
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+          {
+            SingleTreeTraversalType<RuleType> traverser(threadRules);
+            const size_t end = std::min(querySet.n_cols,
+                (block + 1) * queryBlockSize);
+            for (size_t i = block * queryBlockSize; i < end; ++i)
+              traverser.Traverse(i, *referenceTree);
+            processed.push_back((size_t) block);
+          }
+
+          arma::Mat<size_t> threadNeighbors;
+          arma::mat threadDistances;
+          threadRules.GetResults(threadNeighbors, threadDistances);
+
+          #pragma omp critical (NeighborSearchMerge)
+          {
+            for (const size_t block : processed)
+            {
+              const size_t end = std::min(querySet.n_cols,
+                  (block + 1) * queryBlockSize);
+              for (size_t i = block * queryBlockSize; i < end; ++i)
+              {
+                neighborPtr->col(i) = threadNeighbors.col(i);
+                distancePtr->col(i) = threadDistances.col(i);
+              }
+            }
+
+            scores += threadRules.Scores();
+            baseCases += threadRules.BaseCases();
+          }
+        }
+
+        Log::Info << scores << " node combinations were scored." << std::endl;
+        Log::Info << baseCases << " base cases were calculated." << std::endl;
+        break;
+      }
+#endif
+
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
 
@@ -479,6 +601,61 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Timer::Stop("tree_building");
       Timer::Start("computing_neighbors");
 
+#ifdef HAS_OPENMP
+      // If we have multiple threads, decompose the query tree into disjoint
+      // subtrees and run one independent subtree-vs-reference traversal per
+      // subtree.  Each thread keeps its own rule set, so no traversal state
+      // is shared; results are merged per query point afterwards.
+      std::vector<Tree*> queryRoots = DecomposeTree(queryTree,
+          4 * omp_get_max_threads());
+      if (queryRoots.size() > 1)
+      {
+        #pragma omp parallel
+        {
+          // One rule set per thread, reused across all of its subtrees.
+          RuleType threadRules(*referenceSet, queryTree->Dataset(), k, metric,
+              epsilon);
+          std::vector<Tree*> processed;
+
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+          {
+            DualTreeTraversalType<RuleType> traverser(threadRules);
+            traverser.Traverse(*queryRoots[i], *referenceTree);
+            processed.push_back(queryRoots[i]);
+          }
+
+          // Extract this thread's results and copy out the columns of the
+          // query points its subtrees covered.
+          arma::Mat<size_t> threadNeighbors;
+          arma::mat threadDistances;
+          threadRules.GetResults(threadNeighbors, threadDistances);
+
+          #pragma omp critical (NeighborSearchMerge)
+          {
+            for (Tree* root : processed)
+            {
+              for (size_t j = 0; j < root->NumDescendants(); ++j)
+              {
+                const size_t q = root->Descendant(j);
+                neighborPtr->col(q) = threadNeighbors.col(q);
+                distancePtr->col(q) = threadDistances.col(q);
+              }
+            }
+
+            scores += threadRules.Scores();
+            baseCases += threadRules.BaseCases();
+          }
+        }
+
+        Log::Info << scores << " node combinations were scored." << std::endl;
+        Log::Info << baseCases << " base cases were calculated." << std::endl;
+
+        delete queryTree;
+        break;
+      }
+#endif
+
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
 
@@ -502,6 +679,59 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
+#ifdef HAS_OPENMP
+      // Same blocked decomposition as the single-tree path above.
+      if (omp_get_max_threads() > 1 && querySet.n_cols >= 2 * queryBlockSize)
+      {
+        const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+            queryBlockSize;
+
+        #pragma omp parallel
+        {
+          RuleType threadRules(*referenceSet, querySet, k, metric);
+          std::vector<size_t> processed;
+
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+          {
+            tree::GreedySingleTreeTraverser<Tree, RuleType>
+                traverser(threadRules);
+            traverser.MinBaseCases() = k;
+            const size_t end = std::min(querySet.n_cols,
+                (block + 1) * queryBlockSize);
+            for (size_t i = block * queryBlockSize; i < end; ++i)
+              traverser.Traverse(i, *referenceTree);
+            processed.push_back((size_t) block);
+          }
+
+          arma::Mat<size_t> threadNeighbors;
+          arma::mat threadDistances;
+          threadRules.GetResults(threadNeighbors, threadDistances);
+
+          #pragma omp critical (NeighborSearchMerge)
+          {
+            for (const size_t block : processed)
+            {
+              const size_t end = std::min(querySet.n_cols,
+                  (block + 1) * queryBlockSize);
+              for (size_t i = block * queryBlockSize; i < end; ++i)
+              {
+                neighborPtr->col(i) = threadNeighbors.col(i);
+                distancePtr->col(i) = threadDistances.col(i);
+              }
+            }
+
+            scores += threadRules.Scores();
+            baseCases += threadRules.BaseCases();
+          }
+        }
+
+        Log::Info << scores << " node combinations were scored." << std::endl;
+        Log::Info << baseCases << " base cases were calculated." << std::endl;
+        break;
+      }
+#endif
+
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric);
 
@@ -590,6 +820,28 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 } // Search()
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename OtherMatType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const OtherMatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  // Convert the element type once, so that double-precision query points can
+  // be used against an index stored at reduced precision.
+  const MatType convertedQuerySet(arma::conv_to<MatType>::from(querySet));
+  Search(convertedQuerySet, k, neighbors, distances);
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -773,8 +1025,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           Tree* node = nodes.top();
           nodes.pop();
 
-          // Reset bounds of this node.
-          node->Stat().Reset();
+          // Reset bounds of this node, or---if warm-starting is enabled---
+          // loosen the bounds of the previous traversal by the slack so the
+          // search can tighten from there instead of from the worst case.
+          if (warmStartSlack >= 0)
+            node->Stat().WarmStart(warmStartSlack);
+          else
+            node->Stat().Reset();
 
           // Then add the children.
           for (size_t i = 0; i < node->NumChildren(); ++i)
@@ -13,9 +13,11 @@
 #ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
+#include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 
-#include <queue>
+#include <algorithm>
+#include <unordered_map>
 
 namespace mlpack {
 namespace neighbor {
@@ -175,9 +177,12 @@ class NeighborSearchRules
     };
   };
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
+  //! The list of candidate neighbors is a flat bounded max-heap (ordered by
+  //! CandidateCmp, so the worst candidate is at the front).  Flat storage
+  //! means replacing the worst candidate is a single sift-down over
+  //! contiguous memory, and the final ordering in GetResults() is one
+  //! std::sort_heap() pass per query point instead of k individual pops.
+  typedef std::vector<Candidate> CandidateList;
 
   //! Set of candidate neighbors for each point.
   std::vector<CandidateList> candidates;
@@ -201,6 +206,14 @@ class NeighborSearchRules
   //! The last base case result.
   double lastBaseCase;
 
+  //! The last base case result of each reference node during single-tree
+  //! traversals of trees with self-children.  This is per-traversal scratch,
+  //! so it lives here and not in the node statistic: the reference tree may
+  //! be traversed concurrently by several threads, each with its own rule
+  //! set.  Nodes not yet visited read as 0.0 (the same initial value the
+  //! statistic used to hold).
+  std::unordered_map<const TreeType*, double> nodeLastDistances;
+
   //! The number of base cases that have been performed.
   size_t baseCases;
   //! The number of scores that have been performed.
@@ -225,6 +238,49 @@ class NeighborSearchRules
   void InsertNeighbor(const size_t queryIndex,
                       const size_t neighbor,
                       const double distance);
+
+  /**
+   * Replace the worst candidate (the root of the heap) with the given
+   * candidate, restoring the heap property with a single sift-down.  This is
+   * half the work of the pop-then-push that a std::priority_queue would
+   * require.
+   *
+   * @param pqueue Candidate heap to update.
+   * @param c Candidate to insert.
+   */
+  static void ReplaceTop(CandidateList& pqueue, const Candidate& c);
+
+  /**
+   * Compute the distance between two points, abandoning the computation early
+   * once the accumulated partial distance crosses the given candidate bound.
+   * This overload applies to the LMetric family, whose distances accumulate
+   * monotonically over the dimensions; the dimensions are processed in chunks,
+   * checking the bound between chunks.  When the computation is abandoned, the
+   * value returned is at least as bad as the bound but is still a valid lower
+   * bound on the true distance.
+   *
+   * @param metric The instantiated metric (unused; the type selects this
+   *     overload).
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   * @param bound Distance of the worst candidate neighbor of the query point.
+   */
+  template<int Power, bool TakeRoot>
+  double EvaluateWithBound(metric::LMetric<Power, TakeRoot>& metric,
+                           const size_t queryIndex,
+                           const size_t referenceIndex,
+                           const double bound);
+
+  /**
+   * Compute the distance between two points.  Metrics that do not accumulate
+   * monotonically over the dimensions cannot be abandoned early, so this
+   * generic overload performs the full evaluation.
+   */
+  template<typename OtherMetricType>
+  double EvaluateWithBound(OtherMetricType& metric,
+                           const size_t queryIndex,
+                           const size_t referenceIndex,
+                           const double bound);
 };
 
 } // namespace neighbor
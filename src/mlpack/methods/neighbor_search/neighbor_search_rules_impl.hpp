@@ -14,6 +14,7 @@
 
 // In case it hasn't been included yet.
 #include "neighbor_search_rules.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
 namespace mlpack {
@@ -51,8 +52,9 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
       size_t() - 1);
 
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
+  // All of the initial candidates are equal, so the vector is trivially a
+  // valid heap.
+  const CandidateList pqueue(k, def);
 
   candidates.reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; i++)
@@ -70,11 +72,13 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
   for (size_t i = 0; i < querySet.n_cols; i++)
   {
     CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; j++)
+    // One heapsort pass over the contiguous storage leaves the candidates
+    // sorted with the best first.
+    std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+    for (size_t j = 0; j < k; j++)
     {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
+      neighbors(j, i) = pqueue[j].second;
+      distances(j, i) = pqueue[j].first;
     }
   }
 };
@@ -93,8 +97,23 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
+  // For nearest neighbor search on a dense dataset, the distance computation
+  // can be abandoned early once it crosses the distance of the worst candidate
+  // neighbor of the query point; see EvaluateWithBound().  (For furthest
+  // neighbor search the partial distance can only improve, so no early
+  // abandoning is possible.)
+  double distance;
+  if (std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      !arma::is_arma_sparse_type<typename TreeType::Mat>::value)
+  {
+    distance = EvaluateWithBound(metric, queryIndex, referenceIndex,
+        candidates[queryIndex].front().first);
+  }
+  else
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
   ++baseCases;
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
@@ -125,12 +144,14 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
       // base case.
       if ((referenceNode.Parent() != NULL) &&
           (referenceNode.Point(0) == referenceNode.Parent()->Point(0)))
-        baseCase = referenceNode.Parent()->Stat().LastDistance();
+        baseCase = nodeLastDistances[referenceNode.Parent()];
       else
         baseCase = BaseCase(queryIndex, referenceNode.Point(0));
 
-      // Save this evaluation.
-      referenceNode.Stat().LastDistance() = baseCase;
+      // Save this evaluation.  This cache is kept in the rule set rather
+      // than the node statistic, since the reference tree may be shared by
+      // several concurrent traversals.
+      nodeLastDistances[&referenceNode] = baseCase;
     }
 
     distance = SortPolicy::CombineBest(baseCase,
@@ -143,7 +164,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = candidates[queryIndex].front().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ?
@@ -179,7 +200,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = candidates[queryIndex].front().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
@@ -404,7 +425,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = candidates[queryNode.Point(i)].front().first;
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -502,11 +523,113 @@ InsertNeighbor(
   CandidateList& pqueue = candidates[queryIndex];
   Candidate c = std::make_pair(distance, neighbor);
 
-  if (CandidateCmp()(c, pqueue.top()))
+  if (CandidateCmp()(c, pqueue.front()))
+    ReplaceTop(pqueue, c);
+}
+
+/**
+ * Replace the worst candidate with the given one, sifting it down to restore
+ * the heap property.
+ */
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+ReplaceTop(CandidateList& pqueue, const Candidate& c)
+{
+  CandidateCmp cmp;
+  const size_t size = pqueue.size();
+  size_t i = 0;
+  while (true)
   {
-    pqueue.pop();
-    pqueue.push(c);
+    size_t child = 2 * i + 1;
+    if (child >= size)
+      break;
+    if ((child + 1 < size) && cmp(pqueue[child], pqueue[child + 1]))
+      ++child;
+    if (!cmp(c, pqueue[child]))
+      break;
+    pqueue[i] = pqueue[child];
+    i = child;
   }
+  pqueue[i] = c;
+}
+
+/**
+ * Compute an LMetric distance, abandoning the computation early once the
+ * accumulated partial distance crosses the given candidate bound.
+ */
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<int Power, bool TakeRoot>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+EvaluateWithBound(metric::LMetric<Power, TakeRoot>& /* metric */,
+                  const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double bound)
+{
+  // Compare in the power domain, so that no roots are taken while
+  // accumulating.  (For the Chebyshev distance the root is a no-op.)
+  const double cutoff = (TakeRoot && Power != INT_MAX) ?
+      std::pow(bound, (double) Power) : bound;
+
+  // The dimensions are processed in chunks, checking the bound between chunks;
+  // the partial distance can only grow, so once it crosses the cutoff, the
+  // reference point cannot be a candidate and the remaining dimensions are
+  // skipped.
+  const size_t chunkSize = 32;
+  const size_t dims = querySet.n_rows;
+  double sum = 0.0;
+  size_t d = 0;
+  while (d < dims)
+  {
+    const size_t dEnd = std::min(dims, d + chunkSize);
+    for (; d < dEnd; ++d)
+    {
+      const double diff = (double) querySet(d, queryIndex) -
+          (double) referenceSet(d, referenceIndex);
+      if (Power == 1)
+        sum += std::abs(diff);
+      else if (Power == 2)
+        sum += diff * diff;
+      else if (Power == INT_MAX)
+        sum = std::max(sum, std::abs(diff));
+      else
+        sum += std::pow(std::abs(diff), (double) Power);
+    }
+
+    if (sum > cutoff)
+      break;
+  }
+
+  double result;
+  if (!TakeRoot || Power == 1 || Power == INT_MAX)
+    result = sum;
+  else if (Power == 2)
+    result = std::sqrt(sum);
+  else
+    result = std::pow(sum, 1.0 / (double) Power);
+
+  // If the computation was abandoned, the true distance is no better than the
+  // bound, so force the result strictly past the bound: rounding in the root
+  // must not produce a value that ties with (and displaces) a real candidate.
+  // The result stays a valid lower bound on the true distance.
+  if (d < dims)
+    result = std::max(result, std::nextafter(bound, DBL_MAX));
+
+  return result;
+}
+
+/**
+ * Compute a distance with a metric that does not support early abandoning.
+ */
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename OtherMetricType>
+inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+EvaluateWithBound(OtherMetricType& metric,
+                  const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double /* bound */)
+{
+  return metric.Evaluate(querySet.col(queryIndex),
+                         referenceSet.col(referenceIndex));
 }
 
 } // namespace neighbor
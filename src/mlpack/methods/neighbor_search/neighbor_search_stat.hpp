@@ -73,6 +73,31 @@ class NeighborSearchStat
     lastDistance = 0.0;
   }
 
+  /**
+   * Loosen the bounds kept from the previous traversal instead of resetting
+   * them to the worst case, so that a repeated search can start from
+   * nearly-tight values.  The slack must cover the largest distance any
+   * reference point may have moved since the bounds were computed; if it
+   * does not, the loosened bounds may prune true neighbors and the search
+   * becomes approximate.  A negative slack falls back to a full Reset().
+   *
+   * @param slack Worst-case candidate distance change since the last
+   *     traversal.
+   */
+  void WarmStart(const double slack)
+  {
+    if (slack < 0)
+    {
+      Reset();
+      return;
+    }
+
+    firstBound = SortPolicy::CombineWorst(firstBound, slack);
+    secondBound = SortPolicy::CombineWorst(secondBound, slack);
+    auxBound = SortPolicy::CombineWorst(auxBound, slack);
+    lastDistance = 0.0;
+  }
+
   //! Get the first bound.
   double FirstBound() const { return firstBound; }
   //! Modify the first bound.
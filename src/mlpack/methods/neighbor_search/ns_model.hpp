@@ -383,6 +383,32 @@ class NSModel
   bool RandomBasis() const { return randomBasis; }
   bool& RandomBasis() { return randomBasis; }
 
+  /**
+   * Automatically select the tree type and leaf size before building the
+   * full model.  A random subsample of the reference set is taken, candidate
+   * models are built across a grid of tree types and leaf sizes, and a set
+   * of representative queries is timed on each candidate; the tree type and
+   * leaf size of this model are set to the fastest configuration, so a
+   * subsequent BuildModel() call builds the full index with it.
+   *
+   * Tree types without a leaf size parameter (cover trees) and spill trees
+   * (whose tau and rho need their own tuning) are not part of the grid.  In
+   * naive mode no tree is used, so this is a no-op.
+   *
+   * @param referenceSet Set of reference points the model will be built on.
+   * @param k Number of neighbors the timed queries search for.
+   * @param searchMode Search mode the model will be used with.
+   * @param epsilon Error bound for approximate search.
+   * @param maxSamples Maximum number of reference points to subsample.
+   * @param numQueries Number of representative queries to time.
+   */
+  void AutoTune(const arma::mat& referenceSet,
+                const size_t k,
+                const NeighborSearchMode searchMode,
+                const double epsilon = 0,
+                const size_t maxSamples = 2000,
+                const size_t numQueries = 200);
+
   //! Build the reference tree.
   void BuildModel(arma::mat&& referenceSet,
                   const size_t leafSize,
@@ -412,6 +412,93 @@ double& NSModel<SortPolicy>::Epsilon()
   return boost::apply_visitor(EpsilonVisitor(), nSearch);
 }
 
+//! Automatically select the tree type and leaf size on a subsample.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::AutoTune(const arma::mat& referenceSet,
+                                   const size_t k,
+                                   const NeighborSearchMode searchMode,
+                                   const double epsilon,
+                                   const size_t maxSamples,
+                                   const size_t numQueries)
+{
+  // In naive mode no tree is used, so there is nothing to tune.
+  if (searchMode == NAIVE_MODE)
+    return;
+
+  // We need more reference points than neighbors to time a query.
+  if (referenceSet.n_cols <= k)
+    return;
+
+  Timer::Start("auto_tuning");
+
+  // Subsample the reference set, and draw the representative queries from
+  // the same shuffled ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      referenceSet.n_cols - 1, referenceSet.n_cols));
+  const size_t samples = std::min(maxSamples, (size_t) referenceSet.n_cols);
+  const size_t queries = std::min(numQueries, samples);
+  const arma::mat sample = referenceSet.cols(ordering.head(samples));
+  const arma::mat querySample = referenceSet.cols(ordering.head(queries));
+
+  // The candidate grid.  Cover trees have no leaf size, and the tau and rho
+  // parameters of spill trees need their own tuning, so neither is part of
+  // the grid.  The candidates are timed one after another: measuring them
+  // concurrently would distort the very timings the selection is based on,
+  // and the search over each small candidate is already parallel.
+  const TreeTypes candidateTypes[] = { KD_TREE, BALL_TREE, VP_TREE, R_TREE,
+      OCTREE };
+  const size_t candidateLeafSizes[] = { 8, 16, 32, 64, 128 };
+
+  TreeTypes bestType = treeType;
+  size_t bestLeafSize = leafSize;
+  double bestTime = DBL_MAX;
+
+  for (const TreeTypes candidateType : candidateTypes)
+  {
+    for (const size_t candidateLeafSize : candidateLeafSizes)
+    {
+      NSModel<SortPolicy> candidate(candidateType, false);
+      candidate.Tau() = tau;
+      candidate.Rho() = rho;
+      candidate.BuildModel(arma::mat(sample), candidateLeafSize, searchMode,
+          epsilon);
+
+      // Time the representative queries.  The timer is cumulative over all
+      // candidates, so take the difference around the search.
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      const std::chrono::microseconds before =
+          Timer::Get("auto_tuning_candidates");
+      Timer::Start("auto_tuning_candidates");
+      candidate.Search(arma::mat(querySample), k, neighbors, distances);
+      Timer::Stop("auto_tuning_candidates");
+      const double queryTime =
+          (Timer::Get("auto_tuning_candidates") - before).count();
+
+      Log::Info << "Auto-tuning: " << candidate.TreeName() << " with leaf "
+          << "size " << candidateLeafSize << " took " << queryTime / 1e6
+          << "s." << std::endl;
+
+      if (queryTime < bestTime)
+      {
+        bestTime = queryTime;
+        bestType = candidateType;
+        bestLeafSize = candidateLeafSize;
+      }
+    }
+  }
+
+  treeType = bestType;
+  leafSize = bestLeafSize;
+
+  Timer::Stop("auto_tuning");
+
+  // The winning name is reported through this model, now that its type is
+  // set.
+  Log::Info << "Auto-tuning selected " << TreeName() << " with leaf size "
+      << leafSize << "." << std::endl;
+}
+
 //! Build the reference tree.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
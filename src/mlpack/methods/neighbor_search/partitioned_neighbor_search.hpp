@@ -0,0 +1,123 @@
+/**
+ * @file partitioned_neighbor_search.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the PartitionedNeighborSearch class, which splits the reference set
+ * into independent sub-trees searched in parallel and merges the candidates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PARTITIONED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PARTITIONED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The PartitionedNeighborSearch class splits the reference set into a fixed
+ * number of contiguous partitions, builds an independent tree on each one,
+ * and answers queries by searching every partition and merging the
+ * per-partition candidate lists into one k-best result.  The partition trees
+ * are built and searched as tasks on the process-wide util::TaskPool, so a
+ * machine with several memory domains keeps each sub-tree in the memory its
+ * building thread first touched instead of striping one large tree across
+ * all of them, and the searches of the partitions run concurrently within
+ * the shared thread budget.
+ *
+ * The results are exact: every reference point belongs to exactly one
+ * partition, so the merged k-best candidates over all partitions are the
+ * k-best over the whole reference set.  The partition boundaries depend only
+ * on the number of points and the number of partitions, not on the thread
+ * budget, so results are reproducible across machines.
+ *
+ * Compared to a single tree over the whole set, each query point is pushed
+ * through several smaller trees, so some pruning across partition boundaries
+ * is lost; the partition count is therefore best kept near the number of
+ * available threads rather than made large.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class PartitionedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the searcher of one partition.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType> NSType;
+
+  /**
+   * Initialize the PartitionedNeighborSearch object with the given reference
+   * set, splitting it into the given number of partitions and building one
+   * tree per partition in parallel.  If the number of partitions is zero
+   * (the default), the thread budget of the process-wide task pool is used;
+   * the partition count is reduced if it exceeds the number of reference
+   * points.
+   *
+   * @param referenceSet Set of reference points.
+   * @param partitions Number of partitions (0 means one per pool thread).
+   * @param mode Neighbor search mode used inside each partition.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  PartitionedNeighborSearch(MatType referenceSet,
+                            const size_t partitions = 0,
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0,
+                            const MetricType metric = MetricType());
+
+  /**
+   * For each point in the query set, compute the k best neighbors over the
+   * whole reference set, searching the partitions in parallel and merging
+   * their candidate lists.  The matrices will be set to the size of n
+   * columns by k rows, where n is the number of points in the query dataset.
+   * Neighbor indices refer to columns of the original reference set.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the number of partitions the reference set was split into.
+  size_t Partitions() const { return searchers.size(); }
+
+  //! Get the total number of points in the reference set.
+  size_t ReferencePoints() const { return referencePoints; }
+
+ private:
+  //! Column offset of each partition in the original reference set.
+  std::vector<size_t> offsets;
+
+  //! One independent searcher per partition.
+  std::vector<NSType> searchers;
+
+  //! Total number of reference points across all partitions.
+  size_t referencePoints;
+}; // class PartitionedNeighborSearch
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "partitioned_neighbor_search_impl.hpp"
+
+#endif
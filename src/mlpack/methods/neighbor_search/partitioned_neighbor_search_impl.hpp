@@ -0,0 +1,159 @@
+/**
+ * @file partitioned_neighbor_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the PartitionedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PARTITIONED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PARTITIONED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "partitioned_neighbor_search.hpp"
+
+#include <mlpack/core/util/task_pool.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+PartitionedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+PartitionedNeighborSearch(MatType referenceSet,
+                          const size_t partitions,
+                          const NeighborSearchMode mode,
+                          const double epsilon,
+                          const MetricType metric) :
+    referencePoints(referenceSet.n_cols)
+{
+  // One partition per pool thread by default; never more partitions than
+  // points.
+  size_t parts = (partitions == 0) ? util::TaskPool::Get().Threads() :
+      partitions;
+  if (parts > referencePoints)
+    parts = std::max<size_t>(referencePoints, 1);
+
+  // The partition boundaries depend only on the number of points and the
+  // number of partitions, so results are reproducible across thread budgets.
+  const size_t chunk = (referencePoints + parts - 1) / parts;
+  offsets.resize(parts + 1);
+  for (size_t p = 0; p < parts; ++p)
+    offsets[p] = std::min(p * chunk, referencePoints);
+  offsets[parts] = referencePoints;
+
+  // Create the empty searchers first, then build each partition's tree as a
+  // task; the thread that builds a tree is the first to touch its memory,
+  // which keeps each sub-tree local to one memory domain.
+  searchers.reserve(parts);
+  for (size_t p = 0; p < parts; ++p)
+    searchers.emplace_back(mode, epsilon, metric);
+
+  util::TaskGroup group;
+  for (size_t p = 0; p < parts; ++p)
+  {
+    group.Run([this, &referenceSet, p]()
+    {
+      const size_t begin = offsets[p];
+      const size_t end = offsets[p + 1];
+      searchers[p].Train((end > begin) ?
+          MatType(referenceSet.cols(begin, end - 1)) : MatType());
+    });
+  }
+  group.Wait();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void PartitionedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+Search(const MatType& querySet,
+       const size_t k,
+       arma::Mat<size_t>& neighbors,
+       arma::mat& distances)
+{
+  if (k > referencePoints)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referencePoints << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Search every partition concurrently.  A partition smaller than k can
+  // only contribute as many candidates as it has points; the indices it
+  // reports are mapped back to columns of the original reference set.
+  const size_t parts = searchers.size();
+  std::vector<arma::Mat<size_t>> partNeighbors(parts);
+  std::vector<arma::mat> partDistances(parts);
+
+  util::TaskGroup group;
+  for (size_t p = 0; p < parts; ++p)
+  {
+    group.Run([this, &querySet, &partNeighbors, &partDistances, k, p]()
+    {
+      const size_t localK = std::min(k, offsets[p + 1] - offsets[p]);
+      if (localK == 0)
+        return;
+
+      searchers[p].Search(querySet, localK, partNeighbors[p],
+          partDistances[p]);
+      partNeighbors[p] += offsets[p];
+    });
+  }
+  group.Wait();
+
+  // Merge the per-partition candidate lists.  Each list is already sorted
+  // best-first, so for every query point we repeatedly take the best head
+  // among the partitions; the partitions cover the reference set exactly, so
+  // the merged k candidates are the k best over the whole set.
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  util::ParallelFor(0, querySet.n_cols, 256,
+      [&](const size_t blockBegin, const size_t blockEnd)
+  {
+    std::vector<size_t> cursor(parts);
+    for (size_t q = blockBegin; q < blockEnd; ++q)
+    {
+      std::fill(cursor.begin(), cursor.end(), 0);
+      for (size_t slot = 0; slot < k; ++slot)
+      {
+        size_t bestPart = parts;
+        double bestDistance = SortPolicy::WorstDistance();
+        for (size_t p = 0; p < parts; ++p)
+        {
+          if (cursor[p] >= partDistances[p].n_rows)
+            continue;
+
+          const double candidate = partDistances[p](cursor[p], q);
+          if (bestPart == parts ||
+              SortPolicy::IsBetter(candidate, bestDistance))
+          {
+            bestPart = p;
+            bestDistance = candidate;
+          }
+        }
+
+        neighbors(slot, q) = partNeighbors[bestPart](cursor[bestPart], q);
+        distances(slot, q) = bestDistance;
+        ++cursor[bestPart];
+      }
+    }
+  });
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file spill_search_tuner.hpp
+ * @author Ryan Curtin
+ *
+ * A recall-targeted tuner for defeatist spill tree search.  The overlap
+ * parameter tau of a SpillTree controls the tradeoff between the speed and the
+ * recall of defeatist (greedy single-tree) search, but the right value is
+ * dataset-dependent and usually found by hand.  This class automates that: it
+ * measures the recall of defeatist search on a sample query set against exact
+ * results, binary-searches tau until a target recall is met, and then serves
+ * queries with the tuned tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+#include "typedef.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The SpillSearchTuner class automatically selects the spill tree overlap
+ * parameter tau for approximate k-nearest-neighbor search with defeatist
+ * traversal.  Given a sample of queries and a target recall, Tune() computes
+ * exact neighbors for the sample, then searches over tau -- growing an upper
+ * bound from the scale of the exact k-th neighbor distances and then binary
+ * searching -- until the smallest tau meeting the target recall is found.
+ * Recall of defeatist search is monotonically nondecreasing in tau, which is
+ * what makes the binary search valid.
+ *
+ * Each candidate tau requires rebuilding the spill tree and searching the
+ * sample, so the sample query set should be small relative to the full query
+ * load (a few hundred to a few thousand points is typically plenty).
+ *
+ * @code
+ * SpillSearchTuner tuner(referenceSet);
+ * tuner.Tune(sampleQueries, 10, 0.95);  // Target 95% recall for 10-NN.
+ * tuner.Search(querySet, 10, neighbors, distances);
+ * @endcode
+ */
+class SpillSearchTuner
+{
+ public:
+  /**
+   * Construct the tuner with the given reference set.  The reference set is
+   * moved in by default; pass a copy if you need to keep the original.
+   *
+   * @param referenceSet Set of reference points.
+   * @param leafSize Maximum number of points in each leaf of the spill tree.
+   * @param rho Balance threshold of the spill tree.
+   */
+  SpillSearchTuner(arma::mat referenceSet,
+                   const size_t leafSize = 20,
+                   const double rho = 0.7);
+
+  /**
+   * Select tau so that defeatist search achieves the target recall on the
+   * given sample queries, and build the tree to serve with.  Recall is the
+   * fraction of true k-nearest neighbors found.  The target may not be
+   * reachable within the given number of refinement steps; the achieved
+   * recall on the sample is returned, and is also available via Recall().
+   *
+   * @param sampleQueries Sample of the expected query distribution.
+   * @param k Number of neighbors to tune for.
+   * @param targetRecall Desired recall, in [0, 1].
+   * @param maxIterations Maximum number of binary search refinements.
+   * @return Recall achieved on the sample queries.
+   */
+  double Tune(const arma::mat& sampleQueries,
+              const size_t k,
+              const double targetRecall,
+              const size_t maxIterations = 10);
+
+  /**
+   * Search for the k approximate nearest neighbors of each point in the query
+   * set, using the tuned tau.  Tune() must have been called first; if it has
+   * not, an exception is thrown.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the tuned overlap parameter (only meaningful after Tune()).
+  double Tau() const { return tau; }
+  //! Get the recall achieved on the sample queries by the tuned tau.
+  double Recall() const { return recall; }
+  //! Get the leaf size used for built spill trees.
+  size_t LeafSize() const { return leafSize; }
+  //! Get the balance threshold used for built spill trees.
+  double Rho() const { return rho; }
+
+ private:
+  /**
+   * Measure the recall of defeatist search with the given tau on the sample
+   * queries, against the given exact results.  This builds a spill tree with
+   * the candidate tau.
+   */
+  double EvaluateTau(const double tau,
+                     const arma::mat& sampleQueries,
+                     const size_t k,
+                     const arma::Mat<size_t>& exactNeighbors);
+
+  //! The reference set to search.
+  arma::mat referenceSet;
+  //! Maximum number of points in each spill tree leaf.
+  size_t leafSize;
+  //! Balance threshold of the spill tree.
+  double rho;
+
+  //! The tuned overlap parameter.
+  double tau;
+  //! Recall achieved on the sample queries.
+  double recall;
+  //! Whether or not Tune() has been called.
+  bool tuned;
+
+  //! The search object holding the tuned tree, used for serving.
+  SpillKNN spillSearch;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "spill_search_tuner_impl.hpp"
+
+#endif
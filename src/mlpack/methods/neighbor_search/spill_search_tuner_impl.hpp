@@ -0,0 +1,174 @@
+/**
+ * @file spill_search_tuner_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the SpillSearchTuner class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spill_search_tuner.hpp"
+
+#include <unordered_set>
+
+namespace mlpack {
+namespace neighbor {
+
+inline SpillSearchTuner::SpillSearchTuner(arma::mat referenceSet,
+                                          const size_t leafSize,
+                                          const double rho) :
+    referenceSet(std::move(referenceSet)),
+    leafSize(leafSize),
+    rho(rho),
+    tau(0.0),
+    recall(0.0),
+    tuned(false),
+    spillSearch(GREEDY_SINGLE_TREE_MODE)
+{
+  // Nothing to do.
+}
+
+inline double SpillSearchTuner::Tune(const arma::mat& sampleQueries,
+                                     const size_t k,
+                                     const double targetRecall,
+                                     const size_t maxIterations)
+{
+  if (targetRecall < 0.0 || targetRecall > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "SpillSearchTuner::Tune(): target recall (" << targetRecall
+        << ") must be in the range [0, 1]!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Timer::Start("spill_tuning");
+
+  // First, compute exact results on the sample, to measure recall against.
+  // The spill tree does not rearrange the dataset, so indices from the exact
+  // search and from defeatist searches refer to the same points.
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  KNN exact(referenceSet);
+  exact.Search(sampleQueries, k, exactNeighbors, exactDistances);
+
+  // A tree with no overlap is the cheapest possible configuration; if it
+  // already meets the target, we are done.
+  tau = 0.0;
+  recall = EvaluateTau(0.0, sampleQueries, k, exactNeighbors);
+
+  if (recall < targetRecall)
+  {
+    // Find an upper bound for the binary search.  The mean exact k-th
+    // neighbor distance is a natural scale for tau: with tau at that scale,
+    // most true neighbors fall inside the overlap region of the splits that
+    // separate them from their queries.  Keep doubling until the target is
+    // met (or give up and use the best tau found).
+    double tauLow = 0.0;
+    double tauHigh = arma::mean(exactDistances.row(k - 1));
+    if (tauHigh == 0.0)
+      tauHigh = 1.0; // Degenerate sample (duplicate points everywhere).
+
+    double highRecall = EvaluateTau(tauHigh, sampleQueries, k, exactNeighbors);
+    size_t doublings = 0;
+    while (highRecall < targetRecall && doublings < 6)
+    {
+      tauLow = tauHigh;
+      tauHigh *= 2.0;
+      highRecall = EvaluateTau(tauHigh, sampleQueries, k, exactNeighbors);
+      ++doublings;
+    }
+
+    tau = tauHigh;
+    recall = highRecall;
+
+    // Now binary search for the smallest tau that still meets the target.
+    // Recall is monotonically nondecreasing in tau, since a larger overlap
+    // only adds points to every node visited by the defeatist traversal.
+    if (highRecall >= targetRecall)
+    {
+      for (size_t i = 0; i < maxIterations; ++i)
+      {
+        const double tauMid = (tauLow + tauHigh) / 2.0;
+        const double midRecall = EvaluateTau(tauMid, sampleQueries, k,
+            exactNeighbors);
+
+        if (midRecall >= targetRecall)
+        {
+          tauHigh = tauMid;
+          tau = tauMid;
+          recall = midRecall;
+        }
+        else
+        {
+          tauLow = tauMid;
+        }
+      }
+    }
+  }
+
+  Log::Info << "SpillSearchTuner::Tune(): tuned tau " << tau << " achieves "
+      << "recall " << recall << " on the sample queries (target "
+      << targetRecall << ")." << std::endl;
+
+  // Build the tree we will serve with.
+  spillSearch.Train(SpillKNN::Tree(referenceSet, tau, leafSize, rho));
+  tuned = true;
+
+  Timer::Stop("spill_tuning");
+
+  return recall;
+}
+
+inline void SpillSearchTuner::Search(const arma::mat& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances)
+{
+  if (!tuned)
+  {
+    throw std::runtime_error("SpillSearchTuner::Search(): Tune() must be "
+        "called before Search()!");
+  }
+
+  spillSearch.Search(querySet, k, neighbors, distances);
+}
+
+inline double SpillSearchTuner::EvaluateTau(
+    const double tau,
+    const arma::mat& sampleQueries,
+    const size_t k,
+    const arma::Mat<size_t>& exactNeighbors)
+{
+  SpillKNN::Tree tree(referenceSet, tau, leafSize, rho);
+  SpillKNN defeatist(std::move(tree), GREEDY_SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  defeatist.Search(sampleQueries, k, neighbors, distances);
+
+  // Recall is the fraction of true neighbors that the defeatist search found.
+  size_t hits = 0;
+  for (size_t q = 0; q < sampleQueries.n_cols; ++q)
+  {
+    std::unordered_set<size_t> trueNeighbors;
+    for (size_t j = 0; j < k; ++j)
+      trueNeighbors.insert(exactNeighbors(j, q));
+
+    for (size_t j = 0; j < k; ++j)
+      if (trueNeighbors.count(neighbors(j, q)) > 0)
+        ++hits;
+  }
+
+  return (double) hits / (double) (k * sampleQueries.n_cols);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -31,6 +31,16 @@ namespace neighbor {
  */
 typedef NeighborSearch<NearestNeighborSort, metric::EuclideanDistance> KNN;
 
+/**
+ * The FloatKNN class is the k-nearest-neighbors method with the reference set
+ * (and the tree built on it) stored in single precision.  This halves the
+ * memory footprint of the index relative to KNN; double-precision reference
+ * and query sets are converted once when passed to Train() or Search(), and
+ * distances are still reported in double precision.
+ */
+typedef NeighborSearch<NearestNeighborSort, metric::EuclideanDistance,
+    arma::fmat> FloatKNN;
+
 /**
  * The KFN class is the k-furthest-neighbors method.  It returns L2 distances
  * (Euclidean distances) for each of the k furthest neighbors.
@@ -0,0 +1,87 @@
+/**
+ * @file leverage_score_selection.hpp
+ *
+ * Select points for the Nystroem method by sampling proportionally to
+ * approximate leverage scores, computed from a randomized sketch of the top
+ * singular subspace of the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NYSTROEM_METHOD_LEVERAGE_SCORE_SELECTION_HPP
+#define MLPACK_METHODS_NYSTROEM_METHOD_LEVERAGE_SCORE_SELECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/block_krylov_svd/randomized_block_krylov_svd.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Leverage-score sampling for the Nystroem method.  The leverage score of a
+ * point measures how important it is to the top singular subspace of the
+ * data, so sampling proportionally to the scores concentrates the landmarks
+ * on the directions that the low-rank approximation must capture.  The
+ * scores are not computed exactly; instead, the top subspace is sketched
+ * with the randomized block Krylov method, which costs only a few blocked
+ * matrix products (parallelized by a multithreaded BLAS), and the score of
+ * a point is the squared norm of its row of the sketched right singular
+ * vectors.
+ */
+class LeverageScoreSelection
+{
+ public:
+  /**
+   * Sample the specified number of points proportionally to their
+   * approximate leverage scores (with replacement, like RandomSelection).
+   *
+   * @param data Dataset to sample from.
+   * @param m Number of points to select.
+   * @return Indices of selected points from the dataset.
+   */
+  const static arma::Col<size_t> Select(const arma::mat& data, const size_t m)
+  {
+    const size_t sketchRank = std::min(m,
+        std::min(data.n_rows, data.n_cols));
+
+    // Sketch the top singular subspace of the data.
+    arma::mat u, v;
+    arma::vec s;
+    svd::RandomizedBlockKrylovSVD sketch(2, sketchRank + 10);
+    sketch.Apply(data, u, s, v, sketchRank);
+
+    // The leverage score of point i is the squared norm of row i of the top
+    // right singular vectors.
+    arma::vec scores = arma::sum(arma::square(v.cols(0, sketchRank - 1)), 1);
+
+    const double total = arma::accu(scores);
+    arma::Col<size_t> selectedPoints(m);
+    if (total <= 0)
+    {
+      // Degenerate sketch; fall back to uniform sampling.
+      for (size_t i = 0; i < m; ++i)
+        selectedPoints(i) = math::RandInt(0, data.n_cols);
+      return selectedPoints;
+    }
+
+    // Sample from the leverage-score distribution by inverting its
+    // cumulative sum.
+    arma::vec cdf = arma::cumsum(scores);
+    for (size_t i = 0; i < m; ++i)
+    {
+      const double target = math::Random() * total;
+      const double* pos = std::lower_bound(cdf.begin(), cdf.end(), target);
+      selectedPoints(i) = std::min((size_t) (pos - cdf.begin()),
+          (size_t) (data.n_cols - 1));
+    }
+
+    return selectedPoints;
+  }
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,8 @@
 // In case it hasn't been included yet.
 #include "nystroem_method.hpp"
 
+#include <mlpack/core/kernels/gram_matrix.hpp>
+
 namespace mlpack {
 namespace kernel {
 
@@ -36,17 +38,12 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& semiKernel)
 {
   // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  GramMatrix<KernelType>::Compute(*selectedData, miniKernel, kernel);
 
   // Construct semi-kernel matrix with interactions between selected data and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
+  GramMatrix<KernelType>::Compute(data, *selectedData, semiKernel, kernel);
+
   // Clean the memory.
   delete selectedData;
 }
@@ -57,22 +54,17 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
+  // Gather the selected points into a contiguous matrix, so that both kernel
+  // matrices can be built with the blocked builder.
+  const arma::mat selectedData =
+      data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
+
   // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
+  GramMatrix<KernelType>::Compute(selectedData, miniKernel, kernel);
 
   // Construct semi-kernel matrix with interactions between selected points and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  GramMatrix<KernelType>::Compute(data, selectedData, semiKernel, kernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -0,0 +1,142 @@
+/**
+ * @file streaming_pca.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the StreamingPCA class, which performs Principal Components Analysis
+ * in a single pass over column batches of the data, so that the full (centered)
+ * data matrix never needs to be resident in RAM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_STREAMING_PCA_HPP
+#define MLPACK_METHODS_PCA_STREAMING_PCA_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * This class implements single-pass principal components analysis for data
+ * that does not fit in RAM.  Instead of centering and decomposing the full
+ * data matrix (as the PCA class does), it accumulates the running sum and the
+ * co-moment matrix (the sum of outer products) over column batches, and then
+ * eigendecomposes the resulting d x d covariance matrix.  For d dimensions the
+ * working set is O(d^2) regardless of the number of points, so a terabyte-
+ * scale dataset with a few thousand dimensions can be processed with a
+ * covariance matrix of only a few hundred megabytes.
+ *
+ * Each batch is folded in with a rank-k update of the co-moment matrix, which
+ * is a single matrix-matrix product and thus runs at the parallel speed of the
+ * underlying BLAS.
+ *
+ * A typical out-of-core use looks like:
+ *
+ * @code
+ * data::StreamingDataset<> dataset("x.bin", "", 4000, 0, 4096);
+ * StreamingPCA pca;
+ * arma::vec eigVal;
+ * arma::mat eigvec;
+ * pca.Apply(dataset, eigVal, eigvec);
+ * @endcode
+ *
+ * Alternatively, Accumulate() can be called directly on batches obtained some
+ * other way, followed by Finalize().
+ */
+class StreamingPCA
+{
+ public:
+  /**
+   * Create the StreamingPCA object, specifying if the data should be scaled in
+   * each dimension by standard deviation when PCA is performed.
+   *
+   * @param scaleData Whether or not to scale the data.
+   */
+  StreamingPCA(const bool scaleData = false);
+
+  /**
+   * Fold a batch of points (one point per column) into the running moments.
+   * Batches may have any number of columns, and may be passed in any order.
+   *
+   * @param batch Batch of points to accumulate.
+   */
+  void Accumulate(const arma::mat& batch);
+
+  /**
+   * Eigendecompose the accumulated covariance matrix, storing the eigenvalues
+   * (in descending order, matching the PCA class) and the corresponding
+   * loadings.  At least two points must have been accumulated.  The
+   * accumulated moments are left untouched, so more batches can be folded in
+   * and Finalize() called again.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Finalize(arma::vec& eigVal, arma::mat& eigvec);
+
+  /**
+   * Perform PCA in one pass over the given streaming dataset: accumulate every
+   * batch, then eigendecompose the covariance.  The dataset is rewound before
+   * the pass.
+   *
+   * @param dataset Streaming dataset to pass over.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Apply(data::StreamingDataset<>& dataset,
+             arma::vec& eigVal,
+             arma::mat& eigvec);
+
+  /**
+   * Project a batch of points onto the principal components found by the last
+   * call to Finalize() or Apply().  This can be used to transform the dataset
+   * batch-by-batch in a second pass.
+   *
+   * @param batch Batch of points to project.
+   * @param transformedData Matrix to put the projected points into.
+   */
+  void Transform(const arma::mat& batch, arma::mat& transformedData) const;
+
+  //! Get the covariance matrix implied by the accumulated moments.
+  arma::mat Covariance() const;
+
+  //! Get the number of points accumulated so far.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get whether or not this StreamingPCA object will scale (by standard
+  //! deviation) the data when PCA is performed.
+  bool ScaleData() const { return scaleData; }
+  //! Modify whether or not this StreamingPCA object will scale (by standard
+  //! deviation) the data when PCA is performed.
+  bool& ScaleData() { return scaleData; }
+
+ private:
+  //! Scaling the data is when we reduce the variance of each dimension to 1.
+  bool scaleData;
+
+  //! Number of points accumulated so far.
+  size_t numPoints;
+  //! Running sum of the points.
+  arma::vec pointSum;
+  //! Running sum of the outer products of the points.
+  arma::mat comoment;
+
+  //! Mean of the data, set by Finalize().
+  arma::vec mean;
+  //! Per-dimension standard deviation, set by Finalize() when scaling.
+  arma::vec stdDev;
+  //! Loadings found by Finalize(), kept for Transform().
+  arma::mat loadings;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_pca_impl.hpp"
+
+#endif
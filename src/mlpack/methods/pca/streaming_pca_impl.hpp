@@ -0,0 +1,121 @@
+/**
+ * @file streaming_pca_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the StreamingPCA class, which performs Principal
+ * Components Analysis in a single pass over column batches of the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_STREAMING_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_STREAMING_PCA_IMPL_HPP
+
+// In case it hasn't been included.
+#include "streaming_pca.hpp"
+
+namespace mlpack {
+namespace pca {
+
+inline StreamingPCA::StreamingPCA(const bool scaleData) :
+    scaleData(scaleData),
+    numPoints(0)
+{ }
+
+inline void StreamingPCA::Accumulate(const arma::mat& batch)
+{
+  if (numPoints == 0)
+  {
+    pointSum.zeros(batch.n_rows);
+    comoment.zeros(batch.n_rows, batch.n_rows);
+  }
+  else if (batch.n_rows != pointSum.n_elem)
+  {
+    Log::Fatal << "StreamingPCA::Accumulate(): batch dimensionality ("
+        << batch.n_rows << ") does not match previous batches ("
+        << pointSum.n_elem << ")!" << std::endl;
+  }
+
+  pointSum += arma::sum(batch, 1);
+  // This rank-k update is a single matrix-matrix product, so it runs at the
+  // parallel speed of the underlying BLAS.
+  comoment += batch * batch.t();
+  numPoints += batch.n_cols;
+}
+
+inline arma::mat StreamingPCA::Covariance() const
+{
+  if (numPoints < 2)
+    Log::Fatal << "StreamingPCA::Covariance(): at least two points must be "
+        << "accumulated!" << std::endl;
+
+  const arma::vec currentMean = pointSum / numPoints;
+  return (comoment - numPoints * (currentMean * currentMean.t())) /
+      (numPoints - 1);
+}
+
+inline void StreamingPCA::Finalize(arma::vec& eigVal, arma::mat& eigvec)
+{
+  Timer::Start("streaming_pca");
+
+  mean = pointSum / numPoints;
+  arma::mat cov = Covariance();
+
+  if (scaleData)
+  {
+    // Scaling by standard deviation turns the covariance matrix into the
+    // correlation matrix.
+    stdDev = arma::sqrt(cov.diag());
+    cov /= (stdDev * stdDev.t());
+  }
+
+  arma::eig_sym(eigVal, eigvec, cov);
+
+  // eig_sym() returns the eigenvalues in ascending order, but the PCA class
+  // convention is descending.
+  eigVal = arma::flipud(eigVal);
+  eigvec = arma::fliplr(eigvec);
+
+  // Roundoff in the co-moment subtraction can leave tiny negative
+  // eigenvalues where the true eigenvalue is zero.
+  eigVal.transform([](double val) { return (val < 0.0) ? 0.0 : val; });
+
+  loadings = eigvec;
+
+  Timer::Stop("streaming_pca");
+}
+
+inline void StreamingPCA::Apply(data::StreamingDataset<>& dataset,
+                                arma::vec& eigVal,
+                                arma::mat& eigvec)
+{
+  dataset.Reset();
+
+  arma::mat batch;
+  while (dataset.GetNextBatch(batch))
+    Accumulate(batch);
+
+  Finalize(eigVal, eigvec);
+}
+
+inline void StreamingPCA::Transform(const arma::mat& batch,
+                                    arma::mat& transformedData) const
+{
+  if (loadings.n_elem == 0)
+    Log::Fatal << "StreamingPCA::Transform(): Finalize() or Apply() must be "
+        << "called first!" << std::endl;
+
+  arma::mat centered = batch;
+  centered.each_col() -= mean;
+  if (scaleData)
+    centered.each_col() /= stdDev;
+
+  transformedData = loadings.t() * centered;
+}
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
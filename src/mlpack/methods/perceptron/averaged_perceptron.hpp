@@ -0,0 +1,170 @@
+/**
+ * @file averaged_perceptron.hpp
+ *
+ * Definition of the averaged perceptron, trained with chunk-parallel epochs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PERCEPTRON_AVERAGED_PERCEPTRON_HPP
+#define MLPACK_METHODS_PERCEPTRON_AVERAGED_PERCEPTRON_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "initialization_methods/zero_init.hpp"
+#include "initialization_methods/random_init.hpp"
+
+namespace mlpack {
+namespace perceptron {
+
+/**
+ * This class implements an averaged perceptron trained with mini-batch
+ * parallel epochs.  Within an epoch every thread sweeps a shard of the data
+ * against the weights frozen at the start of the epoch, accumulating its
+ * weight deltas locally; the shards' deltas are merged once per epoch.  This
+ * makes an epoch one parallel pass plus one merge, instead of a serial chain
+ * of point-by-point updates, and each per-point update is a dense column
+ * operation vectorized across dimensions.  The returned model uses the
+ * average of the per-epoch weights, which is considerably more stable than
+ * the final weights when the data is not separable.
+ *
+ * Because updates within an epoch are computed against frozen weights, this
+ * is a batch (rather than online) perceptron; it typically needs a few more
+ * epochs than the sequential rule but each epoch is much cheaper.
+ *
+ * The interface matches Perceptron, including the constructor used by
+ * AdaBoost for weak learners.
+ *
+ * @tparam WeightInitializationPolicy Option of ZeroInitialization and
+ *      RandomInitialization.
+ * @tparam MatType Type of matrix that is being used (sparse or dense).
+ */
+template<typename WeightInitializationPolicy = ZeroInitialization,
+         typename MatType = arma::mat>
+class AveragedPerceptron
+{
+ public:
+  /**
+   * Constructor: create the averaged perceptron with the given number of
+   * classes and initialize the weight matrix, but do not perform any
+   * training.  (Call the Train() function to perform training.)
+   *
+   * @param numClasses Number of classes in the dataset.
+   * @param dimensionality Dimensionality of the dataset.
+   * @param maxIterations Maximum number of epochs.
+   */
+  AveragedPerceptron(const size_t numClasses = 0,
+                     const size_t dimensionality = 0,
+                     const size_t maxIterations = 1000);
+
+  /**
+   * Constructor: construct the averaged perceptron by training on the given
+   * data.  The labels vector should contain values in the range
+   * [0, numClasses - 1].
+   *
+   * @param data Input, training data.
+   * @param labels Labels of dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param maxIterations Maximum number of epochs.
+   */
+  AveragedPerceptron(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const size_t numClasses,
+                     const size_t maxIterations = 1000);
+
+  /**
+   * Alternate constructor which copies parameters from an already initiated
+   * averaged perceptron.
+   *
+   * @param other The other initiated AveragedPerceptron object from which we
+   *      copy the values from.
+   * @param data The data on which to train this object on.
+   * @param labels The labels of data.
+   * @param numClasses Number of classes in the data.
+   * @param instanceWeights Weight vector to use while training. For boosting
+   *      purposes.
+   */
+  AveragedPerceptron(const AveragedPerceptron& other,
+                     const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const size_t numClasses,
+                     const arma::rowvec& instanceWeights);
+
+  /**
+   * Train the averaged perceptron on the given data for up to the maximum
+   * number of epochs (specified in the constructor or through
+   * MaxIterations()).
+   *
+   * This training does not reset the model weights, so you can call Train()
+   * on multiple datasets sequentially.
+   *
+   * @param data Dataset on which training should be performed.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the data.
+   * @param instanceWeights Cost matrix. Stores the cost of mispredicting
+   *      instances.  This is useful for boosting.
+   */
+  void Train(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses,
+             const arma::rowvec& instanceWeights = arma::rowvec());
+
+  /**
+   * Classification function. After training, use the averaged weights matrix
+   * to classify test, and put the predicted classes in predictedLabels.
+   *
+   * @param test Testing data or data to classify.
+   * @param predictedLabels Vector to store the predicted classes after
+   *     classifying test.
+   */
+  void Classify(const MatType& test, arma::Row<size_t>& predictedLabels);
+
+  /**
+   * Serialize the averaged perceptron.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+  //! Get the maximum number of epochs.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of epochs.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of classes this perceptron has been trained for.
+  size_t NumClasses() const { return weights.n_cols; }
+
+  //! Get the averaged weight matrix.
+  const arma::mat& Weights() const { return weights; }
+  //! Modify the averaged weight matrix.  You had better know what you are
+  //! doing!
+  arma::mat& Weights() { return weights; }
+
+  //! Get the averaged biases.
+  const arma::vec& Biases() const { return biases; }
+  //! Modify the averaged biases.  You had better know what you are doing!
+  arma::vec& Biases() { return biases; }
+
+ private:
+  //! The maximum number of epochs during training.
+  size_t maxIterations;
+
+  /**
+   * Stores the averaged weights for each of the input class labels.  Each
+   * column corresponds to the weights for one class label, and each row
+   * corresponds to the weights for one dimension of the input data.  The
+   * biases are held in a separate vector.
+   */
+  arma::mat weights;
+
+  //! The averaged biases for each class.
+  arma::vec biases;
+};
+
+} // namespace perceptron
+} // namespace mlpack
+
+#include "averaged_perceptron_impl.hpp"
+
+#endif
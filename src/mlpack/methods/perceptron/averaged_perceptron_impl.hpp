@@ -0,0 +1,176 @@
+/**
+ * @file averaged_perceptron_impl.hpp
+ *
+ * Implementation of the averaged perceptron.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PERCEPTRON_AVERAGED_PERCEPTRON_IMPL_HPP
+#define MLPACK_METHODS_PERCEPTRON_AVERAGED_PERCEPTRON_IMPL_HPP
+
+#include "averaged_perceptron.hpp"
+
+namespace mlpack {
+namespace perceptron {
+
+template<typename WeightInitializationPolicy, typename MatType>
+AveragedPerceptron<WeightInitializationPolicy, MatType>::AveragedPerceptron(
+    const size_t numClasses,
+    const size_t dimensionality,
+    const size_t maxIterations) :
+    maxIterations(maxIterations)
+{
+  WeightInitializationPolicy wip;
+  wip.Initialize(weights, biases, dimensionality, numClasses);
+}
+
+template<typename WeightInitializationPolicy, typename MatType>
+AveragedPerceptron<WeightInitializationPolicy, MatType>::AveragedPerceptron(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t maxIterations) :
+    maxIterations(maxIterations)
+{
+  // Start training.
+  Train(data, labels, numClasses);
+}
+
+template<typename WeightInitializationPolicy, typename MatType>
+AveragedPerceptron<WeightInitializationPolicy, MatType>::AveragedPerceptron(
+    const AveragedPerceptron& other,
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights) :
+    maxIterations(other.maxIterations)
+{
+  Train(data, labels, numClasses, instanceWeights);
+}
+
+template<typename WeightInitializationPolicy, typename MatType>
+void AveragedPerceptron<WeightInitializationPolicy, MatType>::Classify(
+    const MatType& test,
+    arma::Row<size_t>& predictedLabels)
+{
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
+
+  predictedLabels.set_size(test.n_cols);
+  arma::uword maxIndex = 0;
+  for (size_t i = 0; i < test.n_cols; i++)
+  {
+    scores.unsafe_col(i).max(maxIndex);
+    predictedLabels(i) = maxIndex;
+  }
+}
+
+template<typename WeightInitializationPolicy, typename MatType>
+void AveragedPerceptron<WeightInitializationPolicy, MatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights)
+{
+  // Do we need to resize the weights?
+  if (weights.n_cols != numClasses || weights.n_rows != data.n_rows)
+  {
+    WeightInitializationPolicy wip;
+    wip.Initialize(weights, biases, data.n_rows, numClasses);
+  }
+
+  const bool hasWeights = (instanceWeights.n_elem > 0);
+
+  // The working weights; 'weights' will hold their average over the epochs.
+  arma::mat currentWeights = weights;
+  arma::vec currentBiases = biases;
+
+  arma::mat sumWeights(arma::size(currentWeights), arma::fill::zeros);
+  arma::vec sumBiases(arma::size(currentBiases), arma::fill::zeros);
+
+  size_t epochs = 0;
+  bool converged = false;
+
+  while ((epochs < maxIterations) && (!converged))
+  {
+    converged = true;
+
+    // The epoch's deltas, merged from the per-thread shards.
+    arma::mat deltaWeights(arma::size(currentWeights), arma::fill::zeros);
+    arma::vec deltaBiases(arma::size(currentBiases), arma::fill::zeros);
+
+    // Each thread sweeps its shard against the weights frozen at the start
+    // of the epoch, so the shards are independent; the per-point update is a
+    // dense column axpy, vectorized across dimensions.
+    #pragma omp parallel
+    {
+      arma::mat localDeltaWeights(arma::size(currentWeights),
+          arma::fill::zeros);
+      arma::vec localDeltaBiases(arma::size(currentBiases), arma::fill::zeros);
+      arma::vec pointScores;
+      arma::uword maxIndex = 0;
+      bool localConverged = true;
+
+      #pragma omp for nowait
+      for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+      {
+        pointScores = currentWeights.t() * data.col(j) + currentBiases;
+        pointScores.max(maxIndex);
+        if (maxIndex == labels(j))
+          continue;
+
+        localConverged = false;
+        const double w = hasWeights ? instanceWeights(j) : 1.0;
+
+        localDeltaWeights.col(maxIndex) -= w * data.col(j);
+        localDeltaBiases(maxIndex) -= w;
+        localDeltaWeights.col(labels(j)) += w * data.col(j);
+        localDeltaBiases(labels(j)) += w;
+      }
+
+      #pragma omp critical (AveragedPerceptronMerge)
+      {
+        if (!localConverged)
+        {
+          deltaWeights += localDeltaWeights;
+          deltaBiases += localDeltaBiases;
+          converged = false;
+        }
+      }
+    }
+
+    currentWeights += deltaWeights;
+    currentBiases += deltaBiases;
+
+    sumWeights += currentWeights;
+    sumBiases += currentBiases;
+    epochs++;
+  }
+
+  // The averaged weights are what Classify() uses.
+  if (epochs > 0)
+  {
+    weights = sumWeights / epochs;
+    biases = sumBiases / epochs;
+  }
+}
+
+//! Serialize the averaged perceptron.
+template<typename WeightInitializationPolicy, typename MatType>
+template<typename Archive>
+void AveragedPerceptron<WeightInitializationPolicy, MatType>::serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(maxIterations);
+  ar & BOOST_SERIALIZATION_NVP(weights);
+  ar & BOOST_SERIALIZATION_NVP(biases);
+}
+
+} // namespace perceptron
+} // namespace mlpack
+
+#endif
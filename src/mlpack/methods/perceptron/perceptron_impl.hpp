@@ -148,13 +148,19 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
   size_t j, i = 0;
   bool converged = false;
   size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::mat tempLabelMat;
+  arma::uword maxIndex = 0;
+  arma::mat scores;
+  arma::vec pointScores;
 
   LearnPolicy LP;
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // Predictions for each sweep are computed for a block of points at once:
+  // one matrix-matrix product (which a multithreaded BLAS parallelizes) is
+  // far faster than a product per point.
+  const size_t blockSize = 4096;
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -163,30 +169,45 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     converged = true;
 
     // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; j++)
+    for (size_t start = 0; start < data.n_cols; start += blockSize)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      const size_t end = std::min((size_t) data.n_cols, start + blockSize) - 1;
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      scores = weights.t() * data.cols(start, end);
+      scores.each_col() += biases;
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      for (j = start; j <= end; j++)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
-        else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        // Check whether the weights at the start of the block correctly
+        // classify this point.
+        pointScores = scores.unsafe_col(j - start);
+        pointScores.max(maxIndex);
+        if (maxIndex == labels(0, j))
+          continue;
+
+        // The block's predictions go stale as updates are applied, so
+        // re-check the point against the current weights; an update for an
+        // earlier point in the block may already have fixed this one.
+        pointScores = weights.t() * data.col(j) + biases;
+        pointScores.max(maxIndex);
+
+        // Check whether prediction is correct.
+        if (maxIndex != labels(0, j))
+        {
+          // Due to incorrect prediction, convergence set to false.
+          converged = false;
+          tempLabel = labels(0, j);
+
+          // Send maxIndex for knowing which weight to update, send j to know
+          // the value of the vector to update it with.  Send tempLabel to know
+          // the correct class.
+          if (hasWeights)
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex, tempLabel,
+                instanceWeights(j));
+          else
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                tempLabel);
+        }
       }
     }
   }
@@ -45,7 +45,9 @@ void Radical::CopyAndPerturb(mat& xNew, const mat& x) const
 
 double Radical::Vasicek(vec& z) const
 {
-  z = sort(z);
+  // Sort in place; the caller's copy of the projection is scratch anyway, and
+  // this avoids allocating a sorted temporary for every candidate angle.
+  std::sort(z.begin(), z.end());
 
   // Apparently slower.
   /*
@@ -70,26 +72,35 @@ double Radical::DoRadical2D(const mat& matX)
 {
   CopyAndPerturb(perturbed, matX);
 
-  mat::fixed<2, 2> matJacobi;
-
   vec values(angles);
 
-  for (size_t i = 0; i < angles; i++)
+  // Each candidate angle is scored independently, so the grid search is
+  // embarrassingly parallel.  The rotated coordinates are computed directly
+  // from the two perturbed columns into per-thread scratch vectors; this
+  // avoids both the 2x2 matrix product and any shared intermediate state.
+  const uword nElems = perturbed.n_rows;
+  #pragma omp parallel
   {
-    const double theta = (i / (double) angles) * M_PI / 2.0;
-    const double cosTheta = cos(theta);
-    const double sinTheta = sin(theta);
+    vec candidateY1(nElems);
+    vec candidateY2(nElems);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) angles; i++)
+    {
+      const double theta = (i / (double) angles) * M_PI / 2.0;
+      const double cosTheta = cos(theta);
+      const double sinTheta = sin(theta);
 
-    candidate = perturbed * matJacobi;
-    vec candidateY1 = candidate.unsafe_col(0);
-    vec candidateY2 = candidate.unsafe_col(1);
+      for (uword k = 0; k < nElems; k++)
+      {
+        const double x1 = perturbed(k, 0);
+        const double x2 = perturbed(k, 1);
+        candidateY1[k] = cosTheta * x1 - sinTheta * x2;
+        candidateY2[k] = sinTheta * x1 + cosTheta * x2;
+      }
 
-    values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
+      values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
+    }
   }
 
   uword indOpt = 0;
@@ -134,8 +145,6 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
 
   mat matYSubspace(nPoints, 2);
 
-  mat matJ = eye(nDims, nDims);
-
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
@@ -155,19 +164,12 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // The Jacobi rotation only touches columns i and j, so apply it to
+        // those two columns directly instead of multiplying all of matY by an
+        // (otherwise identity) nDims x nDims rotation matrix.
+        const vec matYi = matY.col(i);
+        matY.col(i) = cosThetaOpt * matYi - sinThetaOpt * matY.col(j);
+        matY.col(j) = sinThetaOpt * matYi + cosThetaOpt * matY.col(j);
       }
     }
   }
@@ -185,9 +187,15 @@ void mlpack::radical::WhitenFeatureMajorMatrix(const mat& matX,
                                                mat& matXWhitened,
                                                mat& matWhitening)
 {
+  // Form the covariance as a centered Gram product; the symmetric matrix
+  // multiplication maps to a blocked BLAS rank-k update, which is much faster
+  // than element-wise covariance computation for tall data matrices.
+  const mat centered = matX.each_row() - mean(matX, 0);
+  const mat matCov = (trans(centered) * centered) / (matX.n_rows - 1);
+
   mat matU, matV;
   vec s;
-  arma::svd(matU, s, matV, cov(matX));
+  arma::svd(matU, s, matV, matCov);
   matWhitening = matU * diagmat(1 / sqrt(s)) * trans(matV);
   matXWhitened = matX * matWhitening;
 }
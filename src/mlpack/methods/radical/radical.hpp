@@ -75,7 +75,7 @@ class Radical
 
   /**
    * Vasicek's m-spacing estimator of entropy, with overlap modification from
-   * (Learned-Miller and Fisher, 2003).
+   * (Learned-Miller and Fisher, 2003).  The sample is sorted in place.
    *
    * @param x Empirical sample (one-dimensional) over which to estimate entropy.
    */
@@ -131,8 +131,6 @@ class Radical
 
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
-  //! Internal matrix, held as member variable to prevent memory reallocations.
-  arma::mat candidate;
 };
 
 void WhitenFeatureMajorMatrix(const arma::mat& matX,
@@ -13,11 +13,16 @@
 #ifndef MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 #define MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 
+#include <mlpack/core/math/random.hpp>
+
 namespace mlpack {
 namespace tree {
 
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ * The indices are drawn from the given counter-based stream, so concurrent
+ * bootstraps---one per tree being built in parallel---are independent and
+ * reproducible regardless of the thread count.
  */
 template<bool UseWeights,
          typename MatType,
@@ -28,7 +33,8 @@ void Bootstrap(const MatType& dataset,
                const WeightsType& weights,
                MatType& bootstrapDataset,
                LabelsType& bootstrapLabels,
-               WeightsType& bootstrapWeights)
+               WeightsType& bootstrapWeights,
+               math::RandomStream& stream)
 {
   bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
   bootstrapLabels.set_size(labels.n_elem);
@@ -36,8 +42,9 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights.set_size(weights.n_elem);
 
   // Random sampling with replacement.
-  arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
+  arma::uvec indices(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    indices[i] = (size_t) stream.RandInt((int) dataset.n_cols);
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
     bootstrapDataset.col(i) = dataset.col(indices[i]);
@@ -47,6 +54,27 @@ void Bootstrap(const MatType& dataset,
   }
 }
 
+/**
+ * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ * This overload draws its stream from the calling thread's generator.
+ */
+template<bool UseWeights,
+         typename MatType,
+         typename LabelsType,
+         typename WeightsType>
+void Bootstrap(const MatType& dataset,
+               const LabelsType& labels,
+               const WeightsType& weights,
+               MatType& bootstrapDataset,
+               LabelsType& bootstrapLabels,
+               WeightsType& bootstrapWeights)
+{
+  math::RandomStream stream(
+      (uint64_t) math::RandInt(std::numeric_limits<int>::max()));
+  Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+      bootstrapLabels, bootstrapWeights, stream);
+}
+
 } // namespace tree
 } // namespace mlpack
 
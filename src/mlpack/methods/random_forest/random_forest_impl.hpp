@@ -23,7 +23,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -31,7 +32,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -50,7 +52,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -58,7 +61,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -77,7 +81,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -85,7 +90,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -104,7 +110,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
@@ -112,7 +119,8 @@ RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -131,7 +139,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -139,7 +148,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -158,7 +168,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -166,7 +177,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -185,7 +197,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -193,7 +206,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -212,7 +226,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
@@ -220,7 +235,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -239,7 +255,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename VecType>
 size_t RandomForest<
@@ -247,7 +264,8 @@ size_t RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Classify(const VecType& point) const
 {
   // Pass off to another Classify() overload.
@@ -263,7 +281,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename VecType>
 void RandomForest<
@@ -271,7 +290,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Classify(const VecType& point,
             size_t& prediction,
             arma::vec& probabilities) const
@@ -287,13 +307,27 @@ void RandomForest<
   }
 
   probabilities.zeros(trees[0].NumClasses());
-  for (size_t i = 0; i < trees.size(); ++i)
+
+  // Accumulate the probability estimates of the trees in parallel; each
+  // thread sums its share into a local vector, merged at the end.  When this
+  // is called from the batch Classify() overloads, which already run one
+  // point per thread, the loop simply runs serially inside that thread.
+  #pragma omp parallel
   {
-    arma::vec treeProbs;
-    size_t treePrediction; // Ignored.
-    trees[i].Classify(point, treePrediction, treeProbs);
+    arma::vec localProbabilities(trees[0].NumClasses(), arma::fill::zeros);
+
+    #pragma omp for nowait
+    for (omp_size_t i = 0; i < trees.size(); ++i)
+    {
+      arma::vec treeProbs;
+      size_t treePrediction; // Ignored.
+      trees[i].Classify(point, treePrediction, treeProbs);
+
+      localProbabilities += treeProbs;
+    }
 
-    probabilities += treeProbs;
+    #pragma omp critical
+    probabilities += localProbabilities;
   }
 
   // Find maximum element after renormalizing probabilities.
@@ -310,7 +344,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 void RandomForest<
@@ -318,7 +353,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions) const
 {
@@ -333,9 +369,43 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+  // Process the points in blocks; every thread keeps one probability buffer
+  // that is reused across all trees of its block, instead of allocating a
+  // fresh matrix per tree (or per point).
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    arma::Row<size_t> treePredictions; // Ignored.
+    arma::mat treeProbabilities;
+    arma::mat blockProbabilities;
+
+    #pragma omp for
+    for (omp_size_t block = 0; block < numBlocks; ++block)
+    {
+      const size_t blockBegin = block * blockSize;
+      const size_t blockEnd = std::min(blockBegin + blockSize,
+          (size_t) data.n_cols) - 1;
+
+      blockProbabilities.zeros(trees[0].NumClasses(),
+          blockEnd - blockBegin + 1);
+      for (size_t i = 0; i < trees.size(); ++i)
+      {
+        trees[i].Classify(data.cols(blockBegin, blockEnd), treePredictions,
+            treeProbabilities);
+        blockProbabilities += treeProbabilities;
+      }
+
+      // Find the maximum element of each point's summed probabilities.
+      for (size_t i = blockBegin; i <= blockEnd; ++i)
+      {
+        arma::uword maxIndex = 0;
+        blockProbabilities.col(i - blockBegin).max(maxIndex);
+        predictions[i] = (size_t) maxIndex;
+      }
+    }
+  }
 }
 
 template<
@@ -343,7 +413,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename MatType>
 void RandomForest<
@@ -351,7 +422,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions,
             arma::mat& probabilities) const
@@ -366,13 +438,44 @@ void RandomForest<
         "trained!");
   }
 
-  probabilities.set_size(trees[0].NumClasses(), data.n_cols);
+  probabilities.zeros(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+
+  // Process the points in blocks; every thread keeps one probability buffer
+  // that is reused across all trees of its block, instead of allocating a
+  // fresh matrix per tree (or per point).  The blocks are disjoint, so the
+  // accumulation into the output matrix needs no synchronization.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    arma::Row<size_t> treePredictions; // Ignored.
+    arma::mat treeProbabilities;
+
+    #pragma omp for
+    for (omp_size_t block = 0; block < numBlocks; ++block)
+    {
+      const size_t blockBegin = block * blockSize;
+      const size_t blockEnd = std::min(blockBegin + blockSize,
+          (size_t) data.n_cols) - 1;
+
+      for (size_t i = 0; i < trees.size(); ++i)
+      {
+        trees[i].Classify(data.cols(blockBegin, blockEnd), treePredictions,
+            treeProbabilities);
+        probabilities.cols(blockBegin, blockEnd) += treeProbabilities;
+      }
+      probabilities.cols(blockBegin, blockEnd) /= trees.size();
+
+      // Find the maximum element of each point's averaged probabilities.
+      for (size_t i = blockBegin; i <= blockEnd; ++i)
+      {
+        arma::uword maxIndex = 0;
+        probabilities.unsafe_col(i).max(maxIndex);
+        predictions[i] = (size_t) maxIndex;
+      }
+    }
   }
 }
 
@@ -381,7 +484,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<typename Archive>
 void RandomForest<
@@ -389,7 +493,8 @@ void RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::serialize(Archive& ar, const unsigned int /* version */)
 {
   size_t numTrees;
@@ -412,7 +517,8 @@ template<
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType,
-    typename ElemType
+    typename ElemType,
+    bool UseBootstrap
 >
 template<bool UseWeights, bool UseDatasetInfo, typename MatType>
 double RandomForest<
@@ -420,7 +526,8 @@ double RandomForest<
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType,
-    ElemType
+    ElemType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -433,26 +540,53 @@ double RandomForest<
   trees.resize(numTrees); // This will fill the vector with untrained trees.
   double avgGain = 0.0;
 
+  // Draw one seed per tree up front, serially, from the main random stream.
+  // Each tree seeds the building thread's (thread-local) generator with its
+  // own seed before growing, so the bootstrap sample and the dimension
+  // selections of every tree form an independent, reproducible stream that
+  // does not depend on how the trees are scheduled across threads.
+  arma::Col<size_t> seeds(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+    seeds[i] = (size_t) math::RandInt(std::numeric_limits<int>::max());
+
   #pragma omp parallel for reduction( + : avgGain)
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
+    math::randGen.seed((uint32_t) seeds[i]);
+
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    if (UseBootstrap)
+    {
+      math::RandomStream stream((uint64_t) seeds[i]);
+      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+          bootstrapLabels, bootstrapWeights, stream);
+    }
+    else
+    {
+      // Extra-trees mode: every tree trains on the full sample, and the
+      // randomization comes from the split selection instead.
+      bootstrapDataset = dataset;
+      bootstrapLabels = labels;
+      if (UseWeights)
+        bootstrapWeights = weights;
+    }
 
-    // Now build the decision tree.
+    // Now build the decision tree on the bootstrap sample; the sample is not
+    // needed afterwards, so it can be moved into the tree.
     if (UseWeights)
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(dataset, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses, std::move(bootstrapWeights),
+            minimumLeafSize);
       }
       else
       {
-        avgGain += trees[i].Train(dataset, labels, numClasses, weights,
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, std::move(bootstrapWeights),
             minimumLeafSize);
       }
     }
@@ -460,12 +594,13 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(dataset, datasetInfo, labels, numClasses,
-            minimumLeafSize);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses, minimumLeafSize);
       }
       else
       {
-        avgGain += trees[i].Train(dataset, labels, numClasses, minimumLeafSize);
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, minimumLeafSize);
       }
     }
   }
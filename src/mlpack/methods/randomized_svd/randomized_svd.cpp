@@ -25,7 +25,8 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
                              const double eps) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    singlePrecision(false)
 {
   if (rank == 0)
   {
@@ -42,7 +43,8 @@ RandomizedSVD::RandomizedSVD(const size_t iteratedPower,
                              const double eps) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    singlePrecision(false)
 {
   /* Nothing to do here */
 }
@@ -60,6 +62,73 @@ void RandomizedSVD::Apply(const arma::sp_mat& data,
   Apply(data, u, s, v, rank, rowMean);
 }
 
+void RandomizedSVD::Apply(const arma::sp_mat& data,
+                          arma::mat& u,
+                          arma::vec& s,
+                          arma::mat& v,
+                          const size_t rank,
+                          const bool center)
+{
+  if (center)
+  {
+    Apply(data, u, s, v, rank);
+    return;
+  }
+
+  const size_t sketchSize = (iteratedPower == 0) ? rank + 2 : iteratedPower;
+
+  // Build the subspace basis, optionally iterating in single precision; the
+  // projection below always happens in double precision.
+  arma::mat Q;
+  if (singlePrecision)
+  {
+    // Copy the nonzero structure into a single-precision sparse matrix.
+    arma::umat locations(2, data.n_nonzero);
+    arma::fvec values(data.n_nonzero);
+    size_t index = 0;
+    for (auto it = data.begin(); it != data.end(); ++it, ++index)
+    {
+      locations(0, index) = it.row();
+      locations(1, index) = it.col();
+      values[index] = (float) (*it);
+    }
+    const arma::sp_fmat floatData(locations, values, data.n_rows, data.n_cols);
+
+    arma::fmat floatQ;
+    SparseSketch(floatData, sketchSize, floatQ);
+    Q = arma::conv_to<arma::mat>::from(floatQ);
+  }
+  else
+  {
+    SparseSketch(data, sketchSize, Q);
+  }
+
+  // Project the data onto the basis and decompose the small projected matrix.
+  arma::mat Qdata;
+  if (data.n_cols >= data.n_rows)
+  {
+    // The basis spans the row space: A ~ (A Q) Q^T.
+    SparseMultiply(data, Q, Qdata);
+    arma::svd_econ(u, s, v, Qdata);
+    v = Q * v;
+  }
+  else
+  {
+    // The basis spans the column space: A ~ Q (Q^T A).  The projection is
+    // computed as (A^T Q)^T so that the sparse product keeps the parallel
+    // column form.
+    const arma::sp_mat dataT = data.t();
+    SparseMultiply(dataT, Q, Qdata);
+
+    // Qdata = A^T Q = V * diag(s) * (Q^T U)^T, so the left factor of its SVD
+    // is v, and u comes back through the basis.
+    arma::mat smallU, smallV;
+    arma::svd_econ(smallV, s, smallU, Qdata);
+    u = Q * smallU;
+    v = smallV;
+  }
+}
+
 void RandomizedSVD::Apply(const arma::mat& data,
                           arma::mat& u,
                           arma::vec& s,
@@ -120,6 +120,29 @@ class RandomizedSVD
              arma::mat& v,
              const size_t rank);
 
+/**
+   * Apply the randomized SVD to the given sparse matrix, optionally without
+   * centering.  The uncentered path (center = false) runs the fused power
+   * iteration (A A^T)^q A Omega directly on the sparse matrix, ping-ponging
+   * between two reused buffers and computing the (independent) columns of each
+   * sparse product in parallel; the matrix is never densified.  If
+   * SinglePrecision() is set, the power iterations run in single precision and
+   * only the final projection is done in double precision.
+   *
+   * @param data Sparse data matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param center Whether to center the data before decomposing.
+   */
+  void Apply(const arma::sp_mat& data,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank,
+             const bool center);
+
 /**
    * Center the data to apply Principal Component Analysis on given matrix
    * dataset using randomized SVD.
@@ -160,8 +183,28 @@ class RandomizedSVD
 
     arma::mat R, Q, Qdata;
 
+    // The subspace basis lives in the larger dimension of the matrix.
+    const size_t basisRows = (data.n_cols >= data.n_rows) ? data.n_cols :
+        data.n_rows;
+
+    if (basis.n_rows == basisRows && basis.n_cols > 0)
+    {
+      // Warm start: seed the subspace with the basis of a previous
+      // decomposition, padded with fresh random directions up to
+      // iteratedPower.  The LU/QR conditioning below takes care of
+      // renormalizing the seed columns.
+      if (basis.n_cols >= iteratedPower)
+      {
+        Q = basis.cols(0, iteratedPower - 1);
+      }
+      else
+      {
+        Q = arma::join_rows(basis, arma::randn<arma::mat>(basisRows,
+            iteratedPower - basis.n_cols));
+      }
+    }
     // Apply the centered data matrix to a random matrix, obtaining Q.
-    if (data.n_cols >= data.n_rows)
+    else if (data.n_cols >= data.n_rows)
     {
       R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
       Q = (data.t() * R) - arma::repmat(arma::trans(R.t() * rowMean),
@@ -246,7 +289,93 @@ class RandomizedSVD
   //! Modify the value used for decomposition stability.
   double& Epsilon() { return eps; }
 
+  //! Get whether the uncentered sparse path iterates in single precision.
+  bool SinglePrecision() const { return singlePrecision; }
+  //! Modify whether the uncentered sparse path iterates in single precision.
+  //! The final projection is always computed in double precision.
+  bool& SinglePrecision() { return singlePrecision; }
+
+  //! Get the subspace basis used to warm start the next decomposition.
+  const arma::mat& Basis() const { return basis; }
+  //! Modify the subspace basis used to warm start the next decomposition.
+  //! Set this to the singular vectors in the larger dimension of the matrix
+  //! (v if n_cols >= n_rows, u otherwise) of a previous decomposition to skip
+  //! the initial random projection; leave it empty for a cold start.
+  arma::mat& Basis() { return basis; }
+
  private:
+  /**
+   * Multiply the given sparse matrix by the given dense matrix.  Armadillo's
+   * sparse-dense products are single-threaded, so the (independent) columns of
+   * the result are computed in parallel.
+   *
+   * @param a Sparse matrix.
+   * @param x Dense matrix.
+   * @param out Matrix to store the product in.
+   */
+  template<typename eT>
+  static void SparseMultiply(const arma::SpMat<eT>& a,
+                             const arma::Mat<eT>& x,
+                             arma::Mat<eT>& out)
+  {
+    out.set_size(a.n_rows, x.n_cols);
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) x.n_cols; ++j)
+      out.col(j) = a * x.col(j);
+  }
+
+  /**
+   * Build an orthonormal basis for the dominant subspace of the given
+   * (uncentered) sparse matrix by fused normalized power iterations
+   * (A A^T)^q A Omega.  The basis lives in the larger dimension of the matrix,
+   * matching the dense path, and the iterations ping-pong between two buffers
+   * that are reused for every product.
+   *
+   * @param data Sparse data matrix.
+   * @param sketchSize Number of columns of the basis.
+   * @param basisOut Matrix to store the orthonormal basis in.
+   */
+  template<typename eT>
+  void SparseSketch(const arma::SpMat<eT>& data,
+                    const size_t sketchSize,
+                    arma::Mat<eT>& basisOut)
+  {
+    // Form the transpose once; both directions of the iteration need it.
+    const arma::SpMat<eT> dataT = data.t();
+    const arma::SpMat<eT>& big = (data.n_cols >= data.n_rows) ? dataT : data;
+    const arma::SpMat<eT>& small = (data.n_cols >= data.n_rows) ? data : dataT;
+
+    const arma::Mat<eT> R = arma::randn<arma::Mat<eT>>(big.n_cols, sketchSize);
+
+    // These two buffers are reused by every product of the power iteration.
+    arma::Mat<eT>& Q = basisOut;
+    arma::Mat<eT> Y;
+
+    SparseMultiply(big, R, Q);
+
+    // As in the dense path, condition the basis with the cheaper LU between
+    // iterations, and orthonormalize with a QR decomposition at the end.
+    arma::Mat<eT> U;
+    if (maxIterations == 0)
+    {
+      arma::qr_econ(Q, U, Q);
+      return;
+    }
+    arma::lu(Q, U, Q);
+
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      SparseMultiply(small, Q, Y);
+      arma::lu(Y, U, Y);
+      SparseMultiply(big, Y, Q);
+
+      if (i < (maxIterations - 1))
+        arma::lu(Q, U, Q);
+      else
+        arma::qr_econ(Q, U, Q);
+    }
+  }
+
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
 
@@ -255,6 +384,12 @@ class RandomizedSVD
 
   //! The value used for numerical stability.
   double eps;
+
+  //! Whether the uncentered sparse path iterates in single precision.
+  bool singlePrecision;
+
+  //! Optional subspace basis used to warm start the decomposition.
+  arma::mat basis;
 };
 
 } // namespace svd
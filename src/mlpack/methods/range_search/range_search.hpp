@@ -187,6 +187,26 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, streaming each result to the given callback as it is found
+   * instead of materializing the result set.  The callback is invoked as
+   * callback(queryIndex, referenceIndex, distance), with indices in the
+   * original (pre-tree-building) order; results arrive in no particular
+   * order.  Because nothing is stored, this overload uses constant memory no
+   * matter how dense the neighborhoods are; to collect the results into a
+   * compact CSR-style structure, pass a CSRResultSink as the callback (see
+   * range_search_sinks.hpp).
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param callback Function to call for each result found.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              CallbackType&& callback);
+
   /**
    * Given a pre-built query tree, search for all reference points in the given
    * range for each point in the query set, returning the results in the
@@ -262,6 +282,20 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (which was passed to the constructor), streaming each result to the
+   * given callback as it is found instead of materializing the result set.
+   * The callback is invoked as callback(queryIndex, referenceIndex, distance),
+   * with indices in the original (pre-tree-building) order; results arrive in
+   * no particular order, and a point is never reported as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Function to call for each result found.
+   */
+  template<typename CallbackType>
+  void Search(const math::Range& range, CallbackType&& callback);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
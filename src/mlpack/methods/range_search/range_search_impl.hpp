@@ -323,6 +323,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
+  VectorResultSink sink(*neighborPtr, *distancePtr);
 
   // Reset counts.
   baseCases = 0;
@@ -330,8 +331,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -343,8 +343,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   else if (singleMode)
   {
     // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
@@ -364,8 +363,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Timer::Start("range_search/computing_neighbors");
 
     // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
@@ -485,8 +483,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
+  VectorResultSink sink(*neighborPtr, distances);
+  RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -552,8 +550,9 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+  VectorResultSink sink(*neighborPtr, *distancePtr);
+  RuleType rules(*referenceSet, *referenceSet, range, sink, metric,
+      true /* don't return the query in the results */);
 
   if (naive)
   {
@@ -618,6 +617,173 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    CallbackType&& callback)
+{
+  if (querySet.n_rows != referenceSet->n_rows)
+  {
+    std::ostringstream oss;
+    oss << "RangeSearch::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet->n_rows
+        << ") do not match!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Nothing is materialized here: each result is reported to the callback as
+  // it is found, with indices already mapped back to their original order.
+  typedef CallbackResultSink<CallbackType> SinkType;
+  typedef RangeSearchRules<MetricType, Tree, SinkType> RuleType;
+
+  // Reference indices must be mapped back if we built a tree that rearranged
+  // the dataset.
+  const std::vector<size_t>* refMap =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  // This will hold mappings for query points, if necessary.
+  std::vector<size_t> oldFromNewQueries;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  if (naive)
+  {
+    SinkType sink(callback, NULL, refMap);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    SinkType sink(callback, NULL, refMap);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    Timer::Stop("range_search/computing_neighbors");
+    Timer::Start("range_search/tree_building");
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    Timer::Stop("range_search/tree_building");
+    Timer::Start("range_search/computing_neighbors");
+
+    // Query indices must also be mapped back, since we built the query tree.
+    const std::vector<size_t>* queryMap =
+        tree::TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+
+    // Create the traverser.
+    SinkType sink(callback, queryMap, refMap);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    CallbackType&& callback)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Nothing is materialized here: each result is reported to the callback as
+  // it is found, with indices already mapped back to their original order.
+  typedef CallbackResultSink<CallbackType> SinkType;
+  typedef RangeSearchRules<MetricType, Tree, SinkType> RuleType;
+
+  // In the monochromatic case the query points are the reference points, so
+  // both sides use the same mapping if the tree rearranged the dataset.
+  const std::vector<size_t>* map =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  SinkType sink(callback, map, map);
+  RuleType rules(*referenceSet, *referenceSet, range, sink, metric,
+      true /* don't return the query in the results */);
+
+  if (naive)
+  {
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
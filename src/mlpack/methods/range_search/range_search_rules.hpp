@@ -13,18 +13,24 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "range_search_sinks.hpp"
 
 namespace mlpack {
 namespace range {
 
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
- * class when performing range searches.
+ * class when performing range searches.  Each result found is reported to the
+ * given sink object, which decides how results are stored (see
+ * range_search_sinks.hpp).
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam SinkType The sink that results are reported to.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename SinkType = VectorResultSink>
 class RangeSearchRules
 {
  public:
@@ -35,8 +41,7 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param sink Sink to report each result to.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
@@ -44,8 +49,7 @@ class RangeSearchRules
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const math::Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   SinkType& sink,
                    MetricType& metric,
                    const bool sameSet = false);
 
@@ -127,11 +131,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The sink each result is reported to.
+  SinkType& sink;
 
   //! The instantiated metric.
   MetricType& metric;
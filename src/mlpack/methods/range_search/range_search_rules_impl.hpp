@@ -18,20 +18,18 @@
 namespace mlpack {
 namespace range {
 
-template<typename MetricType, typename TreeType>
-RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
+template<typename MetricType, typename TreeType, typename SinkType>
+RangeSearchRules<MetricType, TreeType, SinkType>::RangeSearchRules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     const math::Range& range,
-    std::vector<std::vector<size_t> >& neighbors,
-    std::vector<std::vector<double> >& distances,
+    SinkType& sink,
     MetricType& metric,
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    sink(sink),
     metric(metric),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
@@ -44,9 +42,9 @@ RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename MetricType, typename TreeType>
+template<typename MetricType, typename TreeType, typename SinkType>
 inline force_inline
-double RangeSearchRules<MetricType, TreeType>::BaseCase(
+double RangeSearchRules<MetricType, TreeType, SinkType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -67,17 +65,14 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   lastReferenceIndex = referenceIndex;
 
   if (range.Contains(distance))
-  {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(distance);
-  }
+    sink.Emit(queryIndex, referenceIndex, distance);
 
   return distance;
 }
 
 //! Single-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchRules<MetricType, TreeType, SinkType>::Score(const size_t queryIndex,
                                                      TreeType& referenceNode)
 {
   // We must get the minimum and maximum distances and store them in this
@@ -136,8 +131,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
 }
 
 //! Single-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchRules<MetricType, TreeType, SinkType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -147,8 +142,8 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchRules<MetricType, TreeType, SinkType>::Score(TreeType& queryNode,
                                                      TreeType& referenceNode)
 {
   math::Range distances;
@@ -209,8 +204,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
 }
 
 //! Dual-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename SinkType>
+double RangeSearchRules<MetricType, TreeType, SinkType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -221,8 +216,8 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename MetricType, typename TreeType>
-void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
+template<typename MetricType, typename TreeType, typename SinkType>
+void RangeSearchRules<MetricType, TreeType, SinkType>::AddResult(const size_t queryIndex,
                                                        TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
@@ -236,14 +231,10 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Let the sink make room for the results.  This is a reservation and not a
+  // resizing, because we don't know if we will encounter the case where the
+  // datasets and points are the same (and we skip in that case).
+  sink.Reserve(queryIndex, referenceNode.NumDescendants() - baseCaseMod);
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -254,8 +245,7 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
         referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(distance);
+    sink.Emit(queryIndex, referenceNode.Descendant(i), distance);
   }
 }
 
@@ -0,0 +1,240 @@
+/**
+ * @file range_search_sinks.hpp
+ * @author Ryan Curtin
+ *
+ * Result sinks for range search.  The RangeSearchRules class reports every
+ * (query, reference, distance) result through a sink object, so the way
+ * results are stored is decoupled from the traversal: they may be collected
+ * into vector-of-vectors objects, streamed to a user callback as they are
+ * found, or accumulated into a compact CSR-style structure without any
+ * per-point allocation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINKS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * A sink that appends each result to vector-of-vectors output objects.  This
+ * implements the classic RangeSearch::Search() behavior.
+ */
+class VectorResultSink
+{
+ public:
+  /**
+   * Construct the sink.  The vectors are expected to already be sized to the
+   * number of query points.
+   *
+   * @param neighbors Vector to store resulting neighbors in.
+   * @param distances Vector to store resulting distances in.
+   */
+  VectorResultSink(std::vector<std::vector<size_t>>& neighbors,
+                   std::vector<std::vector<double>>& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  {
+    // Nothing to do.
+  }
+
+  //! Make room for n more results for the given query point.
+  void Reserve(const size_t queryIndex, const size_t n)
+  {
+    neighbors[queryIndex].reserve(neighbors[queryIndex].size() + n);
+    distances[queryIndex].reserve(distances[queryIndex].size() + n);
+  }
+
+  //! Store a single result.
+  void Emit(const size_t queryIndex,
+            const size_t referenceIndex,
+            const double distance)
+  {
+    neighbors[queryIndex].push_back(referenceIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! The vector the resultant neighbor indices should be stored in.
+  std::vector<std::vector<size_t>>& neighbors;
+  //! The vector the resultant neighbor distances should be stored in.
+  std::vector<std::vector<double>>& distances;
+};
+
+/**
+ * A sink that hands each result to a callback as it is found, optionally
+ * mapping the query and reference indices back to their pre-tree-building
+ * order first.  Nothing is materialized, so this is suitable for searches
+ * whose full result set would not fit in memory.
+ *
+ * @tparam CallbackType Type of the callback; it is invoked as
+ *     callback(queryIndex, referenceIndex, distance).
+ */
+template<typename CallbackType>
+class CallbackResultSink
+{
+ public:
+  /**
+   * Construct the sink.
+   *
+   * @param callback Callback to invoke for each result.
+   * @param queryMap If non-NULL, query indices are mapped through this vector
+   *      before the callback is invoked.
+   * @param referenceMap If non-NULL, reference indices are mapped through this
+   *      vector before the callback is invoked.
+   */
+  CallbackResultSink(CallbackType& callback,
+                     const std::vector<size_t>* queryMap = NULL,
+                     const std::vector<size_t>* referenceMap = NULL) :
+      callback(callback),
+      queryMap(queryMap),
+      referenceMap(referenceMap)
+  {
+    // Nothing to do.
+  }
+
+  //! Nothing to reserve; results are not stored.
+  void Reserve(const size_t /* queryIndex */, const size_t /* n */) { }
+
+  //! Report a single result to the callback.
+  void Emit(const size_t queryIndex,
+            const size_t referenceIndex,
+            const double distance)
+  {
+    callback(queryMap ? (*queryMap)[queryIndex] : queryIndex,
+             referenceMap ? (*referenceMap)[referenceIndex] : referenceIndex,
+             distance);
+  }
+
+ private:
+  //! The callback to invoke for each result.
+  CallbackType& callback;
+  //! Mapping from new query indices to old ones (may be NULL).
+  const std::vector<size_t>* queryMap;
+  //! Mapping from new reference indices to old ones (may be NULL).
+  const std::vector<size_t>* referenceMap;
+};
+
+/**
+ * A callback object that accumulates results into a CSR-style structure.
+ * Results are collected as (query, reference, distance) triplets in fixed-size
+ * chunks---so memory grows in large steps and nothing is copied when a chunk
+ * fills up---and Finalize() sorts them into per-query runs with a counting
+ * sort.  Compared to vector-of-vectors output this avoids one allocation (and
+ * the accompanying bookkeeping overhead) per query point.
+ *
+ * Pass an instance of this class as the callback to the streaming overload of
+ * RangeSearch::Search(), then call Finalize():
+ *
+ * @code
+ * CSRResultSink csr(querySet.n_cols);
+ * rs.Search(querySet, range, csr);
+ * csr.Finalize(offsets, neighbors, distances);
+ * @endcode
+ */
+class CSRResultSink
+{
+ public:
+  /**
+   * Construct the sink for the given number of query points.
+   *
+   * @param numQueries Number of query points that will be searched.
+   * @param chunkSize Number of results held by each storage chunk.
+   */
+  CSRResultSink(const size_t numQueries,
+                const size_t chunkSize = 1048576) :
+      counts(numQueries, 0),
+      chunkSize(chunkSize)
+  {
+    // Nothing to do.
+  }
+
+  //! Store a single result.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double distance)
+  {
+    if (chunks.empty() || chunks.back().queries.size() == chunkSize)
+    {
+      chunks.push_back(Chunk());
+      chunks.back().queries.reserve(chunkSize);
+      chunks.back().references.reserve(chunkSize);
+      chunks.back().distances.reserve(chunkSize);
+    }
+
+    Chunk& chunk = chunks.back();
+    chunk.queries.push_back(queryIndex);
+    chunk.references.push_back(referenceIndex);
+    chunk.distances.push_back(distance);
+    ++counts[queryIndex];
+  }
+
+  /**
+   * Sort the collected results into CSR form and release the chunk storage.
+   * After this call, the results for query point i are the entries
+   * offsets[i] ... offsets[i + 1] - 1 of the neighbors and distances vectors
+   * (in no particular order), and offsets.back() is the total number of
+   * results.
+   *
+   * @param offsets Vector to store the per-query offsets in; it will have one
+   *      more element than there are query points.
+   * @param neighbors Vector to store all neighbor indices in.
+   * @param distances Vector to store all distances in.
+   */
+  void Finalize(std::vector<size_t>& offsets,
+                std::vector<size_t>& neighbors,
+                std::vector<double>& distances)
+  {
+    // Turn the per-query counts into offsets.
+    offsets.resize(counts.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+      offsets[i + 1] = offsets[i] + counts[i];
+
+    neighbors.resize(offsets.back());
+    distances.resize(offsets.back());
+
+    // Scatter the triplets into per-query runs (counting sort), freeing each
+    // chunk as soon as it has been consumed.
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+      const Chunk& chunk = chunks[c];
+      for (size_t i = 0; i < chunk.queries.size(); ++i)
+      {
+        const size_t pos = next[chunk.queries[i]]++;
+        neighbors[pos] = chunk.references[i];
+        distances[pos] = chunk.distances[i];
+      }
+      chunks[c] = Chunk();
+    }
+    chunks.clear();
+  }
+
+ private:
+  //! A fixed-capacity block of collected results.
+  struct Chunk
+  {
+    std::vector<size_t> queries;
+    std::vector<size_t> references;
+    std::vector<double> distances;
+  };
+
+  //! All chunks of collected results.
+  std::vector<Chunk> chunks;
+  //! Number of results collected for each query point.
+  std::vector<size_t> counts;
+  //! Number of results held by each chunk.
+  const size_t chunkSize;
+};
+
+} // namespace range
+} // namespace mlpack
+
+#endif
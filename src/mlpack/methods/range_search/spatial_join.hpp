@@ -0,0 +1,166 @@
+/**
+ * @file spatial_join.hpp
+ *
+ * Defines the SpatialJoin class, a persistent dual-tree spatial join engine:
+ * both trees are built once and can be joined repeatedly with different
+ * ranges, streaming results through a callback or answering semi-join and
+ * anti-join (existence) queries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include "range_search_stat.hpp"
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The SpatialJoin class answers co-location queries of the form "for each
+ * point in the query set, find all points of the reference set within the
+ * given range" with a dual-tree traversal.  Unlike running RangeSearch once
+ * per dataset pair, both trees are built exactly once, at construction; every
+ * subsequent Join(), SemiJoin() or AntiJoin() call reuses them, so rotating
+ * ranges (or repeated joins in a pipeline) pay no tree-building cost.
+ *
+ * Join() streams each matching (query, reference, distance) triple through a
+ * callback as it is found, so no intermediate result set is materialized.
+ * The traversal is split into independent node-pair tasks (query subtrees
+ * against the reference tree) which are processed in parallel; the callback
+ * must therefore be safe to invoke concurrently when mlpack is built with
+ * OpenMP support.
+ *
+ * SemiJoin() and AntiJoin() answer the cheaper existence question---which
+ * query points have at least one match (or no match at all)---with a pruned
+ * traversal that stops working on a query point as soon as a single match is
+ * proven (see SpatialJoinRules).
+ *
+ * @code
+ * SpatialJoin<> join(std::move(setA), std::move(setB));
+ *
+ * // Stream all pairs within distance 0.5.
+ * join.Join(math::Range(0.0, 0.5),
+ *     [](size_t a, size_t b, double d) { ... });
+ *
+ * // Points of A with at least one point of B within distance 0.5.
+ * std::vector<size_t> matchedPoints;
+ * join.SemiJoin(math::Range(0.0, 0.5), matchedPoints);
+ * @endcode
+ *
+ * @tparam MetricType Metric to use for distance calculations.
+ * @tparam MatType Type of data to use.
+ * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class SpatialJoin
+{
+ public:
+  //! Convenience typedef.
+  typedef TreeType<MetricType, RangeSearchStat, MatType> Tree;
+
+  /**
+   * Build the trees on the given query and reference sets.  The matrices are
+   * moved to internal copies, which are rearranged during tree-building.
+   *
+   * @param querySet Set of query points (the "A" side of the join).
+   * @param referenceSet Set of reference points (the "B" side of the join).
+   * @param metric Instantiated distance metric.
+   */
+  SpatialJoin(MatType querySet,
+              MatType referenceSet,
+              const MetricType metric = MetricType());
+
+  //! Destroy the SpatialJoin object and the trees it built.
+  ~SpatialJoin();
+
+  /**
+   * Perform the join: for each query point, every reference point within the
+   * given range is reported to the callback as it is found, with the indices
+   * in the original (pre-tree-building) order.  The callback is invoked as
+   * callback(queryIndex, referenceIndex, distance); results arrive in no
+   * particular order, and the callback may be invoked from several threads
+   * concurrently when OpenMP is enabled.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Function to call for each matching pair.
+   */
+  template<typename CallbackType>
+  void Join(const math::Range& range, CallbackType&& callback);
+
+  /**
+   * Perform a semi-join: collect the query points that have at least one
+   * reference point within the given range.  Subtrees are pruned as soon as a
+   * match is proven, so this is much cheaper than a full join.
+   *
+   * @param range Range of distances in which to search.
+   * @param queryIndices Vector to store the indices (in the original order,
+   *      sorted ascending) of matched query points in.
+   */
+  void SemiJoin(const math::Range& range, std::vector<size_t>& queryIndices);
+
+  /**
+   * Perform an anti-join: collect the query points that have no reference
+   * point within the given range.
+   *
+   * @param range Range of distances in which to search.
+   * @param queryIndices Vector to store the indices (in the original order,
+   *      sorted ascending) of unmatched query points in.
+   */
+  void AntiJoin(const math::Range& range, std::vector<size_t>& queryIndices);
+
+  //! Return the query set (in the rearranged tree order).
+  const MatType& QuerySet() const { return queryTree->Dataset(); }
+  //! Return the reference set (in the rearranged tree order).
+  const MatType& ReferenceSet() const { return referenceTree->Dataset(); }
+
+  //! Return the query tree.
+  Tree* QueryTree() { return queryTree; }
+  //! Return the reference tree.
+  Tree* ReferenceTree() { return referenceTree; }
+
+ private:
+  /**
+   * Run the existence traversal shared by SemiJoin() and AntiJoin(), setting
+   * one flag per query point (in the original point order).
+   */
+  void Exists(const math::Range& range, std::vector<char>& matched);
+
+  /**
+   * Collect independent query subtrees to process as parallel tasks: the
+   * query tree is expanded breadth-first until at least maxTasks roots are
+   * available (or only leaves remain).
+   */
+  void CollectTasks(std::vector<Tree*>& tasks, const size_t maxTasks);
+
+  //! Mappings to old query indices.
+  std::vector<size_t> oldFromNewQueries;
+  //! Mappings to old reference indices.
+  std::vector<size_t> oldFromNewReferences;
+
+  //! Query tree.
+  Tree* queryTree;
+  //! Reference tree.
+  Tree* referenceTree;
+
+  //! Instantiated distance metric.
+  MetricType metric;
+};
+
+} // namespace range
+} // namespace mlpack
+
+// Include implementation.
+#include "spatial_join_impl.hpp"
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file spatial_join_impl.hpp
+ *
+ * Implementation of the SpatialJoin class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_IMPL_HPP
+
+// Just in case it hasn't been included.
+#include "spatial_join.hpp"
+
+// For BuildTree() and the full-join rules.
+#include "range_search.hpp"
+#include "range_search_rules.hpp"
+#include "spatial_join_rules.hpp"
+
+namespace mlpack {
+namespace range {
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+SpatialJoin<MetricType, MatType, TreeType>::SpatialJoin(
+    MatType querySet,
+    MatType referenceSet,
+    const MetricType metric) :
+    queryTree(BuildTree<Tree>(std::move(querySet), oldFromNewQueries)),
+    referenceTree(BuildTree<Tree>(std::move(referenceSet),
+        oldFromNewReferences)),
+    metric(metric)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+SpatialJoin<MetricType, MatType, TreeType>::~SpatialJoin()
+{
+  delete queryTree;
+  delete referenceTree;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void SpatialJoin<MetricType, MatType, TreeType>::Join(
+    const math::Range& range,
+    CallbackType&& callback)
+{
+  typedef typename std::remove_reference<CallbackType>::type Callback;
+  typedef RangeSearchRules<MetricType, Tree, CallbackResultSink<Callback>>
+      RuleType;
+
+  // Collect independent query subtrees; each one is joined against the whole
+  // reference tree as one task.  The reference tree is only read during the
+  // traversals, so the tasks are safe to run concurrently.
+  std::vector<Tree*> tasks;
+  CollectTasks(tasks, 64);
+
+  #pragma omp parallel
+  {
+    MetricType localMetric = metric;
+    CallbackResultSink<Callback> sink(callback,
+        oldFromNewQueries.empty() ? NULL : &oldFromNewQueries,
+        oldFromNewReferences.empty() ? NULL : &oldFromNewReferences);
+    RuleType rules(referenceTree->Dataset(), queryTree->Dataset(), range, sink,
+        localMetric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      traverser.Traverse(*tasks[i], *referenceTree);
+  }
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::SemiJoin(
+    const math::Range& range,
+    std::vector<size_t>& queryIndices)
+{
+  std::vector<char> matched;
+  Exists(range, matched);
+
+  queryIndices.clear();
+  for (size_t i = 0; i < matched.size(); ++i)
+    if (matched[i])
+      queryIndices.push_back(i);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::AntiJoin(
+    const math::Range& range,
+    std::vector<size_t>& queryIndices)
+{
+  std::vector<char> matched;
+  Exists(range, matched);
+
+  queryIndices.clear();
+  for (size_t i = 0; i < matched.size(); ++i)
+    if (!matched[i])
+      queryIndices.push_back(i);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::Exists(
+    const math::Range& range,
+    std::vector<char>& matched)
+{
+  typedef SpatialJoinRules<MetricType, Tree> RuleType;
+
+  const size_t numQueries = queryTree->Dataset().n_cols;
+  std::vector<char> matchedNew(numQueries, 0);
+
+  // Each query point gets its own single-tree traversal with early
+  // termination; the flag of a query point is only touched by the thread that
+  // owns the point.
+  #pragma omp parallel
+  {
+    MetricType localMetric = metric;
+    RuleType rules(referenceTree->Dataset(), queryTree->Dataset(), range,
+        matchedNew, localMetric);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+  }
+
+  // Map the flags back to the original point order.
+  matched.assign(numQueries, 0);
+  for (size_t i = 0; i < numQueries; ++i)
+    matched[oldFromNewQueries.empty() ? i : oldFromNewQueries[i]] =
+        matchedNew[i];
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::CollectTasks(
+    std::vector<Tree*>& tasks,
+    const size_t maxTasks)
+{
+  tasks.assign(1, queryTree);
+
+  // Replace every non-leaf task by its children, level by level, until enough
+  // tasks are available to keep the threads busy (or only leaves remain).
+  bool anyExpanded = true;
+  while (tasks.size() < maxTasks && anyExpanded)
+  {
+    anyExpanded = false;
+    std::vector<Tree*> expanded;
+    expanded.reserve(2 * tasks.size());
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      if (tasks[i]->NumChildren() == 0)
+      {
+        expanded.push_back(tasks[i]);
+      }
+      else
+      {
+        for (size_t c = 0; c < tasks[i]->NumChildren(); ++c)
+          expanded.push_back(&tasks[i]->Child(c));
+        anyExpanded = true;
+      }
+    }
+
+    tasks = std::move(expanded);
+  }
+}
+
+} // namespace range
+} // namespace mlpack
+
+#endif
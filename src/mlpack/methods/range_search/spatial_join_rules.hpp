@@ -0,0 +1,127 @@
+/**
+ * @file spatial_join_rules.hpp
+ *
+ * Rules for existence (semi-join/anti-join) queries: for each query point, we
+ * only need to prove or disprove that at least one reference point lies in
+ * the given range, so whole subtrees can be pruned as soon as a match is
+ * found.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_RULES_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_RULES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The SpatialJoinRules class implements a single-tree existence query: it
+ * determines, for a query point, whether any reference point lies within the
+ * given range, without enumerating the matches.  Three prunes make this much
+ * cheaper than a full range search:
+ *
+ *  - once a match is found for a query point, every further reference subtree
+ *    is pruned for it (the traversal for that point effectively stops);
+ *  - a reference node entirely inside the range proves a match without any
+ *    point-to-point distance evaluations;
+ *  - the usual range-overlap prune of range search.
+ *
+ * This is used by SpatialJoin for semi-join and anti-join queries.
+ *
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename MetricType, typename TreeType>
+class SpatialJoinRules
+{
+ public:
+  /**
+   * Construct the SpatialJoinRules object.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param matched Flags (one per query point) set to 1 when a match is
+   *      proven; entries already set cause the query point to be skipped.
+   * @param metric Instantiated metric.
+   */
+  SpatialJoinRules(const arma::mat& referenceSet,
+                   const arma::mat& querySet,
+                   const math::Range& range,
+                   std::vector<char>& matched,
+                   MetricType& metric);
+
+  /**
+   * Compute the base case between the given query point and reference point,
+   * marking the query point as matched if the distance is in the range.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   */
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  /**
+   * Get the score for recursion order.  A low score indicates priority for
+   * recursion, while DBL_MAX indicates that the node should not be recursed
+   * into at all (it should be pruned).  A reference node is pruned when the
+   * query point is already matched, when the node cannot overlap the range,
+   * or when it lies entirely inside the range (in which case the query point
+   * is marked as matched first).
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  /**
+   * Re-evaluate the score for recursion order.  The query point may have been
+   * matched since the score was calculated, in which case the node is pruned
+   * now.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   * @param oldScore Old score produced by Score() (or Rescore()).
+   */
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of scores (that is, calls to RangeDistance()).
+  size_t Scores() const { return scores; }
+
+ private:
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! The range of distances for which we are searching.
+  const math::Range& range;
+
+  //! Match flags, one per query point.
+  std::vector<char>& matched;
+
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! The number of base cases.
+  size_t baseCases;
+  //! The number of scores.
+  size_t scores;
+};
+
+} // namespace range
+} // namespace mlpack
+
+// Include implementation.
+#include "spatial_join_rules_impl.hpp"
+
+#endif
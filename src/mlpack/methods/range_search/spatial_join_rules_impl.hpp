@@ -0,0 +1,106 @@
+/**
+ * @file spatial_join_rules_impl.hpp
+ *
+ * Implementation of the rules for existence (semi-join/anti-join) queries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_RULES_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_SPATIAL_JOIN_RULES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spatial_join_rules.hpp"
+
+namespace mlpack {
+namespace range {
+
+template<typename MetricType, typename TreeType>
+SpatialJoinRules<MetricType, TreeType>::SpatialJoinRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    const math::Range& range,
+    std::vector<char>& matched,
+    MetricType& metric) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    range(range),
+    matched(matched),
+    metric(metric),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+//! The base case; mark the query point as matched if the distance is in the
+//! range.
+template<typename MetricType, typename TreeType>
+inline force_inline
+double SpatialJoinRules<MetricType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // Nothing left to prove for this query point.
+  if (matched[queryIndex])
+    return 0.0;
+
+  const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
+      referenceSet.unsafe_col(referenceIndex));
+  ++baseCases;
+
+  if (range.Contains(distance))
+    matched[queryIndex] = 1;
+
+  return distance;
+}
+
+//! Single-tree scoring function.
+template<typename MetricType, typename TreeType>
+double SpatialJoinRules<MetricType, TreeType>::Score(const size_t queryIndex,
+                                                     TreeType& referenceNode)
+{
+  // Once a match is proven, every remaining reference subtree is pruned.
+  if (matched[queryIndex])
+    return DBL_MAX;
+
+  const math::Range distances =
+      referenceNode.RangeDistance(querySet.unsafe_col(queryIndex));
+  ++scores;
+
+  // If the ranges do not overlap, prune this node.
+  if (!distances.Contains(range))
+    return DBL_MAX;
+
+  // If the node lies entirely inside the range, any of its descendants proves
+  // the match; there is no need to evaluate a single distance.
+  if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+  {
+    matched[queryIndex] = 1;
+    return DBL_MAX;
+  }
+
+  // Otherwise the score doesn't matter; recursion order is irrelevant here.
+  return 0.0;
+}
+
+//! Single-tree rescoring function.
+template<typename MetricType, typename TreeType>
+double SpatialJoinRules<MetricType, TreeType>::Rescore(
+    const size_t queryIndex,
+    TreeType& /* referenceNode */,
+    const double oldScore) const
+{
+  // A match may have been proven since the score was calculated.
+  if (matched[queryIndex])
+    return DBL_MAX;
+
+  return oldScore;
+}
+
+} // namespace range
+} // namespace mlpack
+
+#endif
@@ -314,29 +314,93 @@ Search(const MatType& querySet,
   }
   else if (singleMode)
   {
-    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
-        sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
-
-    // If the reference root node is a leaf, then the sampling has already been
-    // done in the RASearchRules constructor.  This happens when naive = true.
-    if (!referenceTree->IsLeaf())
+#ifdef HAS_OPENMP
+    // Process the query points in blocks: each thread traverses the reference
+    // tree for a whole contiguous block of queries with its own rule set, so
+    // no sampling state is shared between threads.  The required sample size
+    // is cached inside RAUtil, so the per-thread rule set construction is
+    // cheap.
+    const size_t queryBlockSize = 64;
+    if (!referenceTree->IsLeaf() && omp_get_max_threads() > 1 &&
+        querySet.n_cols >= 2 * queryBlockSize)
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+      const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+          queryBlockSize;
+      size_t distComputations = 0;
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      #pragma omp parallel
+      {
+        RuleType threadRules(*referenceSet, querySet, k, metric, tau, alpha,
+            naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+        std::vector<size_t> processed;
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+        {
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(threadRules);
+          const size_t end = std::min(querySet.n_cols,
+              (block + 1) * queryBlockSize);
+          for (size_t i = block * queryBlockSize; i < end; ++i)
+            traverser.Traverse(i, *referenceTree);
+          processed.push_back((size_t) block);
+        }
+
+        arma::Mat<size_t> threadNeighbors;
+        arma::mat threadDistances;
+        threadRules.GetResults(threadNeighbors, threadDistances);
+
+        #pragma omp critical (RASearchMerge)
+        {
+          for (const size_t block : processed)
+          {
+            const size_t end = std::min(querySet.n_cols,
+                (block + 1) * queryBlockSize);
+            for (size_t i = block * queryBlockSize; i < end; ++i)
+            {
+              neighborPtr->col(i) = threadNeighbors.col(i);
+              distancePtr->col(i) = threadDistances.col(i);
+            }
+          }
+
+          distComputations += threadRules.NumDistComputations();
+        }
+      }
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
-          << (rules.NumDistComputations() / querySet.n_cols) << "."
-          << std::endl;
+          << (distComputations / querySet.n_cols) << "." << std::endl;
     }
+    else
+#endif
+    {
+      RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+          sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
-    rules.GetResults(*neighborPtr, *distancePtr);
+      // If the reference root node is a leaf, then the sampling has already
+      // been done in the RASearchRules constructor.  This happens when
+      // naive = true.
+      if (!referenceTree->IsLeaf())
+      {
+        Log::Info << "Performing single-tree traversal..." << std::endl;
+
+        // Create the traverser.
+        typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+        // Now have it traverse for each point.
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+
+        Log::Info << "Single-tree traversal complete." << std::endl;
+        Log::Info << "Average number of distance calculations per query "
+            << "point: " << (rules.NumDistComputations() / querySet.n_cols)
+            << "." << std::endl;
+      }
+
+      rules.GetResults(*neighborPtr, *distancePtr);
+    }
   }
   else // Dual-tree recursion.
   {
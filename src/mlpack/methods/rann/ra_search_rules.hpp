@@ -309,6 +309,20 @@ class RASearchRules
                       const size_t neighbor,
                       const double distance);
 
+  /**
+   * Approximate a reference node by evaluating the base case against the
+   * given number of sampled distinct descendants.  The query point is loaded
+   * once for the whole batch of sampled distance evaluations, and the sample
+   * statistics are updated once at the end.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceNode Reference node to sample from.
+   * @param samplesReqd Number of distinct descendants to sample.
+   */
+  void SampleNode(const size_t queryIndex,
+                  TreeType& referenceNode,
+                  const size_t samplesReqd);
+
   /**
    * Perform actual scoring for single-tree case.
    */
@@ -140,6 +140,40 @@ double RASearchRules<SortPolicy, MetricType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void RASearchRules<SortPolicy, MetricType, TreeType>::SampleNode(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    const size_t samplesReqd)
+{
+  // Draw all of the required distinct descendants in one shot.
+  arma::uvec distinctSamples;
+  math::ObtainDistinctSamples(0, referenceNode.NumDescendants(), samplesReqd,
+      distinctSamples);
+
+  // Evaluate the sampled base cases as one batch, with the query point loaded
+  // only once, and update the sample statistics once at the end.
+  const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
+  size_t samplesMade = 0;
+  for (size_t i = 0; i < distinctSamples.n_elem; ++i)
+  {
+    const size_t referenceIndex = referenceNode.Descendant(distinctSamples[i]);
+
+    // If the datasets are the same, then this search is only using one dataset
+    // and we should not return identical points.
+    if (sameSet && (queryIndex == referenceIndex))
+      continue;
+
+    const double distance = metric.Evaluate(queryPoint,
+        referenceSet.unsafe_col(referenceIndex));
+    InsertNeighbor(queryIndex, referenceIndex, distance);
+    samplesMade++;
+  }
+
+  numSamplesMade[queryIndex] += samplesMade;
+  numDistComputations += samplesMade;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
@@ -203,13 +237,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.
           // Hence, approximate the node by sampling enough number of points.
-          arma::uvec distinctSamples;
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t i = 0; i < distinctSamples.n_elem; i++)
-            // The counting of the samples are done in the 'BaseCase' function
-            // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+          SampleNode(queryIndex, referenceNode, samplesReqd);
 
           // Node approximated, so we can prune it.
           return DBL_MAX;
@@ -219,14 +247,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           if (sampleAtLeaves) // If allowed to sample at leaves.
           {
             // Approximate node by sampling enough number of points.
-            arma::uvec distinctSamples;
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t i = 0; i < distinctSamples.n_elem; i++)
-              // The counting of the samples are done in the 'BaseCase' function
-              // so no book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[i]));
+            SampleNode(queryIndex, referenceNode, samplesReqd);
 
             // (Leaf) node approximated, so we can prune it.
             return DBL_MAX;
@@ -307,13 +328,7 @@ Rescore(const size_t queryIndex,
       {
         // Then, samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough number of points.
-        arma::uvec distinctSamples;
-        math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-            samplesReqd, distinctSamples);
-        for (size_t i = 0; i < distinctSamples.n_elem; i++)
-          // The counting of the samples are done in the 'BaseCase' function so
-          // no book-keeping is required here.
-          BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+        SampleNode(queryIndex, referenceNode, samplesReqd);
 
         // Node approximated, so we can prune it.
         return DBL_MAX;
@@ -323,13 +338,7 @@ Rescore(const size_t queryIndex,
         if (sampleAtLeaves)
         {
           // Approximate node by sampling enough points.
-          arma::uvec distinctSamples;
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t i = 0; i < distinctSamples.n_elem; i++)
-            // The counting of the samples are done in the 'BaseCase' function
-            // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+          SampleNode(queryIndex, referenceNode, samplesReqd);
 
           // (Leaf) node approximated, so we can prune it.
           return DBL_MAX;
@@ -507,18 +516,8 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.  Hence, approximate node by
           // sampling enough number of points for every query in the query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
-          {
-            const size_t queryIndex = queryNode.Descendant(i);
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t j = 0; j < distinctSamples.n_elem; j++)
-              // The counting of the samples are done in the 'BaseCase' function
-              // so no book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
-          }
+            SampleNode(queryNode.Descendant(i), referenceNode, samplesReqd);
 
           // Update the number of samples made for the queryNode and also update
           // the number of sample made for the child nodes.
@@ -537,18 +536,8 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           {
             // Approximate node by sampling enough number of points for every
             // query in the query node.
-            arma::uvec distinctSamples;
             for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
-            {
-              const size_t queryIndex = queryNode.Descendant(i);
-              math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                  samplesReqd, distinctSamples);
-              for (size_t j = 0; j < distinctSamples.n_elem; j++)
-                // The counting of the samples are done in the 'BaseCase'
-                // function so no book-keeping is required here.
-                BaseCase(queryIndex,
-                    referenceNode.Descendant(distinctSamples[j]));
-            }
+              SampleNode(queryNode.Descendant(i), referenceNode, samplesReqd);
 
             // Update the number of samples made for the queryNode and also
             // update the number of sample made for the child nodes.
@@ -712,17 +701,8 @@ Rescore(TreeType& queryNode,
       {
         // then samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough points for every query in the query node.
-        arma::uvec distinctSamples;
         for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
-        {
-          const size_t queryIndex = queryNode.Descendant(i);
-          math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
-          for (size_t j = 0; j < distinctSamples.n_elem; j++)
-            // The counting of the samples are done in the 'BaseCase'
-            // function so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[j]));
-        }
+          SampleNode(queryNode.Descendant(i), referenceNode, samplesReqd);
 
         // Update the number of samples made for the query node and also update
         // the number of samples made for the child nodes.
@@ -741,18 +721,8 @@ Rescore(TreeType& queryNode,
         {
           // Approximate node by sampling enough points for every query in the
           // query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
-          {
-            const size_t queryIndex = queryNode.Descendant(i);
-            math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
-            for (size_t j = 0; j < distinctSamples.n_elem; j++)
-              // The counting of the samples are done in BaseCase() so no
-              // book-keeping is required here.
-              BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
-          }
+            SampleNode(queryNode.Descendant(i), referenceNode, samplesReqd);
 
           // Update the number of samples made for the query node and also
           // update the number of samples made for the child nodes.
@@ -12,6 +12,9 @@
  */
 #include "ra_util.hpp"
 
+#include <map>
+#include <tuple>
+
 using namespace mlpack;
 using namespace mlpack::neighbor;
 
@@ -20,6 +23,28 @@ size_t mlpack::neighbor::RAUtil::MinimumSamplesReqd(const size_t n,
                                                     const double tau,
                                                     const double alpha)
 {
+  // The binary search below evaluates a binomial tail probability at every
+  // step, and a rule set is constructed (and thus this function called) for
+  // every search and every traversal thread.  The result only depends on
+  // (n, k, tau, alpha), so cache it per configuration.
+  typedef std::tuple<size_t, size_t, double, double> ConfigType;
+  static std::map<ConfigType, size_t> cache;
+  const ConfigType config(n, k, tau, alpha);
+
+  size_t cached = 0;
+  bool found = false;
+  #pragma omp critical (RAUtilMinimumSamplesReqd)
+  {
+    const std::map<ConfigType, size_t>::const_iterator it = cache.find(config);
+    if (it != cache.end())
+    {
+      cached = it->second;
+      found = true;
+    }
+  }
+  if (found)
+    return cached;
+
   size_t ub = n; // The upper bound on the binary search.
   size_t lb = k; // The lower bound on the binary search.
   size_t  m = lb; // The minimum number of random samples.
@@ -66,7 +91,11 @@ size_t mlpack::neighbor::RAUtil::MinimumSamplesReqd(const size_t n,
     m = (ub + lb) / 2;
   } while (true);
 
-  return (std::min(m + 1, n));
+  const size_t result = std::min(m + 1, n);
+  #pragma omp critical (RAUtilMinimumSamplesReqd)
+  cache[config] = result;
+
+  return result;
 }
 
 double mlpack::neighbor::RAUtil::SuccessProbability(const size_t n,
@@ -23,7 +23,9 @@ class RAUtil
  public:
   /**
    * Compute the minimum number of samples required to guarantee
-   * the given rank-approximation and success probability.
+   * the given rank-approximation and success probability.  The result is
+   * cached per (n, k, tau, alpha) configuration, so repeated calls with the
+   * same configuration are cheap.
    *
    * @param n Size of the set to be sampled from.
    * @param k The number of neighbors required within the rank-approximation.
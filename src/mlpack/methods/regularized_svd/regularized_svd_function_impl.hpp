@@ -227,12 +227,33 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
   const arma::mat data = function.Dataset();
 
+  const size_t numUsers = function.NumUsers();
+  const size_t numItems = function.NumItems();
+  const double lambda = function.Lambda();
+
+  // Partition the ratings into a numBlocks x numBlocks grid of cells by user
+  // block and item block.  Cells on the same (wrapped) diagonal of the grid
+  // share no users and no items, so they can be processed concurrently
+  // without locks or atomics; the parameters of a rating are only ever
+  // touched by the thread holding its cell.
+  size_t numBlocks = 1;
+  #ifdef HAS_OPENMP
+    numBlocks = omp_get_max_threads();
+  #endif
+
+  const size_t userBlockSize = (numUsers + numBlocks - 1) / numBlocks;
+  const size_t itemBlockSize = (numItems + numBlocks - 1) / numBlocks;
+
+  std::vector<std::vector<arma::uword>> cells(numBlocks * numBlocks);
+  for (size_t j = 0; j < data.n_cols; ++j)
+  {
+    const size_t userBlock = (size_t) data(0, j) / userBlockSize;
+    const size_t itemBlock = (size_t) data(1, j) / itemBlockSize;
+    cells[userBlock * numBlocks + itemBlock].push_back(j);
+  }
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -270,49 +291,42 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     // Get the stepsize for this iteration
     double stepSize = decayPolicy.StepSize(i);
 
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+    if (shuffle) // Determine order of visitation within each cell.
+    {
+      for (size_t c = 0; c < cells.size(); ++c)
+        std::shuffle(cells[c].begin(), cells[c].end(), mlpack::math::randGen);
+    }
 
-    #pragma omp parallel
+    // Process the grid one diagonal at a time; the cells of a diagonal are
+    // conflict-free, so their updates are applied in place with no atomics.
+    for (size_t diagonal = 0; diagonal < numBlocks; ++diagonal)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
       {
-        const size_t numUsers = function.NumUsers();
-
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        double ratingError = rating - arma::dot(iterate.col(user),
-            iterate.col(item));
-
-        double lambda = function.Lambda();
-
-        arma::mat userUpdate = stepSize * (lambda * iterate.col(user) -
-            ratingError * iterate.col(item));
-        arma::mat itemUpdate = stepSize * (lambda * iterate.col(item) -
-            ratingError * iterate.col(user));
+        const size_t itemBlock = (block + diagonal) % numBlocks;
+        const std::vector<arma::uword>& cell =
+            cells[block * numBlocks + itemBlock];
 
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < iterate.n_rows; ++i)
+        for (size_t j = 0; j < cell.size(); ++j)
         {
-          #pragma omp atomic
-          iterate(i, user) -= userUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemUpdate(i);
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, cell[j]);
+          const size_t item = data(1, cell[j]) + numUsers;
+
+          // Prediction error for the example.
+          const double rating = data(2, cell[j]);
+          const double ratingError = rating - arma::dot(iterate.col(user),
+              iterate.col(item));
+
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example; both columns are updated from the pre-update
+          // values.
+          const arma::vec userUpdate = stepSize *
+              (lambda * iterate.col(user) - ratingError * iterate.col(item));
+          iterate.col(item) -= stepSize * (lambda * iterate.col(item) -
+              ratingError * iterate.col(user));
+          iterate.col(user) -= userUpdate;
         }
       }
     }
@@ -95,6 +95,20 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Execute one episode in each of several independent environment instances,
+   * stepped in lockstep.  Action selection for all still-running environments
+   * is done with a single batched forward pass of the learning network, and
+   * the collected transitions are stored in the replay memory as one
+   * contiguous batch, so the per-transition bookkeeping cost is amortized
+   * over the batch.  One learning step is performed per collected transition,
+   * keeping the update-to-data ratio of the serial Episode().
+   *
+   * @param numEnvironments Number of environment instances to roll out.
+   * @return Mean return over the environment instances.
+   */
+  double VectorizedEpisode(const size_t numEnvironments);
+
   /**
    * @return Total steps from beginning.
    */
@@ -113,6 +127,13 @@ class QLearning
    */
   arma::Col<size_t> BestAction(const arma::mat& actionValues);
 
+  /**
+   * Perform one experience replay learning step: sample a batch from the
+   * replay memory, compute the update target, and apply one gradient update
+   * to the learning network.
+   */
+  void TrainStep();
+
   //! Locally-stored hyper-parameters.
   TrainingConfig config;
 
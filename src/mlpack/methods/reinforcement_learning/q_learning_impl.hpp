@@ -84,37 +84,14 @@ template <
   typename BehaviorPolicyType,
   typename ReplayType
 >
-double QLearning<
+void QLearning<
   EnvironmentType,
   NetworkType,
   UpdaterType,
   BehaviorPolicyType,
   ReplayType
->::Step()
+>::TrainStep()
 {
-  // Get the action value for each action at current state.
-  arma::colvec actionValue;
-  learningNetwork.Predict(state.Encode(), actionValue);
-
-  // Select an action according to the behavior policy.
-  ActionType action = policy.Sample(actionValue, deterministic);
-
-  // Interact with the environment to advance to next state.
-  StateType nextState;
-  double reward = environment.Sample(state, action, nextState);
-
-  // Store the transition for replay.
-  replayMethod.Store(state, action, reward,
-      nextState, environment.IsTerminal(nextState));
-
-  // Update current state.
-  state = nextState;
-
-  if (deterministic || totalSteps < config.ExplorationSteps())
-    return reward;
-
-  // Start experience replay.
-
   // Sample from previous experience.
   arma::mat sampledStates;
   arma::icolvec sampledActions;
@@ -162,6 +139,44 @@ double QLearning<
   arma::mat gradients;
   learningNetwork.Backward(target, gradients);
   updater.Update(learningNetwork.Parameters(), config.StepSize(), gradients);
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Step()
+{
+  // Get the action value for each action at current state.
+  arma::colvec actionValue;
+  learningNetwork.Predict(state.Encode(), actionValue);
+
+  // Select an action according to the behavior policy.
+  ActionType action = policy.Sample(actionValue, deterministic);
+
+  // Interact with the environment to advance to next state.
+  StateType nextState;
+  double reward = environment.Sample(state, action, nextState);
+
+  // Store the transition for replay.
+  replayMethod.Store(state, action, reward,
+      nextState, environment.IsTerminal(nextState));
+
+  // Update current state.
+  state = nextState;
+
+  // Start experience replay.
+  if (!deterministic && totalSteps >= config.ExplorationSteps())
+    TrainStep();
 
   return reward;
 }
@@ -215,6 +230,119 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::VectorizedEpisode(const size_t numEnvironments)
+{
+  // Independent copies of the task, each running its own episode.
+  std::vector<EnvironmentType> environments(numEnvironments, environment);
+  std::vector<StateType> states(numEnvironments);
+  std::vector<bool> active(numEnvironments, true);
+  arma::colvec returns(numEnvironments, arma::fill::zeros);
+
+  size_t numActive = numEnvironments;
+  for (size_t i = 0; i < numEnvironments; ++i)
+  {
+    states[i] = environments[i].InitialSample();
+    if (environments[i].IsTerminal(states[i]))
+    {
+      active[i] = false;
+      numActive--;
+    }
+  }
+
+  // Track the lockstep steps; the step limit applies to each environment.
+  size_t steps = 0;
+
+  while (numActive > 0)
+  {
+    if (config.StepLimit() && steps >= config.StepLimit())
+      break;
+
+    // Gather the encoded states of the still-running environments into one
+    // batch, so one forward pass selects the actions for all of them.
+    arma::mat encodedStates(StateType::dimension, numActive);
+    arma::uvec activeIndices(numActive);
+    size_t j = 0;
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      if (!active[i])
+        continue;
+      encodedStates.col(j) = states[i].Encode();
+      activeIndices(j++) = i;
+    }
+
+    arma::mat actionValues;
+    learningNetwork.Predict(encodedStates, actionValues);
+
+    // Advance every running environment and collect the transitions.
+    arma::mat batchNextStates(StateType::dimension, numActive);
+    arma::icolvec batchActions(numActive);
+    arma::colvec batchRewards(numActive);
+    arma::icolvec batchIsTerminal(numActive);
+    for (j = 0; j < activeIndices.n_elem; ++j)
+    {
+      const size_t i = activeIndices(j);
+      const ActionType action = policy.Sample(actionValues.col(j),
+          deterministic);
+
+      StateType nextState;
+      batchRewards(j) = environments[i].Sample(states[i], action, nextState);
+      batchActions(j) = action;
+      batchNextStates.col(j) = nextState.Encode();
+
+      const bool terminal = environments[i].IsTerminal(nextState);
+      batchIsTerminal(j) = terminal;
+      returns(i) += batchRewards(j);
+      states[i] = nextState;
+      if (terminal)
+        active[i] = false;
+    }
+
+    // Store the whole lockstep batch at once.
+    replayMethod.StoreBatch(encodedStates, batchActions, batchRewards,
+        batchNextStates, batchIsTerminal);
+
+    steps++;
+    if (!deterministic)
+    {
+      const size_t syncsBefore = totalSteps / config.TargetNetworkSyncInterval();
+      totalSteps += numActive;
+
+      if (totalSteps >= config.ExplorationSteps())
+      {
+        // One learning step per collected transition keeps the
+        // update-to-data ratio of the serial Episode().
+        for (size_t u = 0; u < numActive; ++u)
+        {
+          TrainStep();
+          policy.Anneal();
+        }
+      }
+
+      if (totalSteps / config.TargetNetworkSyncInterval() != syncsBefore)
+        targetNetwork = learningNetwork;
+    }
+
+    numActive = 0;
+    for (size_t i = 0; i < numEnvironments; ++i)
+      numActive += active[i];
+  }
+
+  return arma::accu(returns) / numEnvironments;
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -0,0 +1,286 @@
+/**
+ * @file prioritized_replay.hpp
+ * @author Shangtong Zhang
+ *
+ * This file is an implementation of prioritized experience replay.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_PRIORITIZED_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_PRIORITIZED_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "sum_tree.hpp"
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of prioritized experience replay.
+ *
+ * Instead of sampling uniformly from the memory buffer, transitions are
+ * sampled with probability proportional to their priority, typically the
+ * magnitude of their last temporal-difference error.  Surprising transitions
+ * are thus replayed more often, which improves sample efficiency.  The
+ * priorities live in an array-backed sum tree, so sampling and batched
+ * priority updates both cost O(log n) per transition regardless of the
+ * buffer size.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{schaul2015prioritized,
+ *  title   = {Prioritized experience replay},
+ *  author  = {Schaul, Tom and Quan, John and Antonoglou, Ioannis and
+ *             Silver, David},
+ *  journal = {arXiv preprint arXiv:1511.05952},
+ *  year    = {2015}
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class PrioritizedReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  /**
+   * Construct an instance of prioritized experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param alpha How much prioritization is used; 0 recovers the uniform
+   *              case.
+   * @param dimension The dimension of an encoded state.
+   */
+  PrioritizedReplay(const size_t batchSize,
+                    const size_t capacity,
+                    const double alpha = 0.6,
+                    const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      alpha(alpha),
+      maxPriority(1.0),
+      position(0),
+      priorities(capacity),
+      states(dimension, capacity),
+      actions(capacity),
+      rewards(capacity),
+      nextStates(dimension, capacity),
+      isTerminal(capacity),
+      full(false)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Store the given experience.  New experiences get the maximum priority
+   * seen so far, so every transition is replayed at least once before its
+   * priority is lowered.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   */
+  void Store(const StateType& state,
+             ActionType action,
+             double reward,
+             const StateType& nextState,
+             bool isEnd)
+  {
+    states.col(position) = state.Encode();
+    actions(position) = action;
+    rewards(position) = reward;
+    nextStates.col(position) = nextState.Encode();
+    isTerminal(position) = isEnd;
+    priorities.Set(position, std::pow(maxPriority, alpha));
+    position++;
+    if (position == capacity)
+    {
+      full = true;
+      position = 0;
+    }
+  }
+
+  /**
+   * Store a batch of transitions gathered from vectorized environment
+   * rollouts.  Column j of each argument describes the j'th transition.  The
+   * batch is written into the ring buffer in contiguous blocks (at most two
+   * per wrap-around), and the priorities of the whole batch are pushed into
+   * the sum tree with one batched update.
+   *
+   * @param batchStates Encoded states, one column per transition.
+   * @param batchActions Actions taken at those states.
+   * @param batchRewards Rewards received.
+   * @param batchNextStates Encoded next states, one column per transition.
+   * @param batchIsTerminal Whether each next state is a terminal state.
+   */
+  void StoreBatch(const arma::mat& batchStates,
+                  const arma::icolvec& batchActions,
+                  const arma::colvec& batchRewards,
+                  const arma::mat& batchNextStates,
+                  const arma::icolvec& batchIsTerminal)
+  {
+    arma::uvec storedIndices(batchStates.n_cols);
+
+    size_t stored = 0;
+    while (stored < batchStates.n_cols)
+    {
+      const size_t block = std::min(batchStates.n_cols - stored,
+          capacity - position);
+
+      states.cols(position, position + block - 1) =
+          batchStates.cols(stored, stored + block - 1);
+      actions.subvec(position, position + block - 1) =
+          batchActions.subvec(stored, stored + block - 1);
+      rewards.subvec(position, position + block - 1) =
+          batchRewards.subvec(stored, stored + block - 1);
+      nextStates.cols(position, position + block - 1) =
+          batchNextStates.cols(stored, stored + block - 1);
+      isTerminal.subvec(position, position + block - 1) =
+          batchIsTerminal.subvec(stored, stored + block - 1);
+      storedIndices.subvec(stored, stored + block - 1) =
+          arma::regspace<arma::uvec>(position, position + block - 1);
+
+      stored += block;
+      position += block;
+      if (position == capacity)
+      {
+        full = true;
+        position = 0;
+      }
+    }
+
+    arma::vec batchPriorities(batchStates.n_cols);
+    batchPriorities.fill(std::pow(maxPriority, alpha));
+    priorities.BatchSet(storedIndices, batchPriorities);
+  }
+
+  /**
+   * Sample some experiences with probability proportional to their
+   * priorities.  The indices of the sampled transitions are kept so that
+   * UpdatePriorities() can be called with the new temporal-difference errors
+   * after the learn step.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              arma::icolvec& sampledActions,
+              arma::colvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::icolvec& isTerminal)
+  {
+    // Stratified proportional sampling: one sample from each of batchSize
+    // equal slices of the total mass, so the batch covers the priority range
+    // instead of clustering on the heaviest transitions.
+    const double massPerSample = priorities.Sum() / batchSize;
+    sampledIndices.set_size(batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      const double mass = (i + math::Random()) * massPerSample;
+      sampledIndices[i] = priorities.FindPrefixSum(mass);
+    }
+
+    sampledStates = states.cols(sampledIndices);
+    sampledActions = actions.elem(sampledIndices);
+    sampledRewards = rewards.elem(sampledIndices);
+    sampledNextStates = nextStates.cols(sampledIndices);
+    isTerminal = this->isTerminal.elem(sampledIndices);
+  }
+
+  /**
+   * Update the priorities of the last sampled batch of transitions in one
+   * batched sum-tree update.
+   *
+   * @param tdErrors Absolute temporal-difference error of each transition of
+   *        the last sampled batch, in sample order.
+   */
+  void UpdatePriorities(const arma::colvec& tdErrors)
+  {
+    arma::vec newPriorities(tdErrors.n_elem);
+    for (size_t i = 0; i < tdErrors.n_elem; ++i)
+    {
+      const double priority = std::abs(tdErrors[i]) + epsilon;
+      maxPriority = std::max(maxPriority, priority);
+      newPriorities[i] = std::pow(priority, alpha);
+    }
+    priorities.BatchSet(sampledIndices, newPriorities);
+  }
+
+  //! Get the indices of the last sampled batch.
+  const arma::uvec& SampledIndices() const { return sampledIndices; }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size
+   */
+  const size_t& Size()
+  {
+    return full ? capacity : position;
+  }
+
+ private:
+  //! Small constant added to every priority so that no transition ever has
+  //! zero probability of being replayed.
+  static constexpr double epsilon = 1e-6;
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit.
+  size_t capacity;
+
+  //! How much prioritization is used.
+  double alpha;
+
+  //! Maximum priority seen so far; assigned to new transitions.
+  double maxPriority;
+
+  //! Indicate the position to store new transition.
+  size_t position;
+
+  //! Sum tree of the priorities of the stored transitions.
+  SumTree<double> priorities;
+
+  //! Indices of the last sampled batch.
+  arma::uvec sampledIndices;
+
+  //! Locally-stored encoded previous states.
+  arma::mat states;
+
+  //! Locally-stored previous actions.
+  arma::icolvec actions;
+
+  //! Locally-stored previous rewards.
+  arma::colvec rewards;
+
+  //! Locally-stored encoded previous next states.
+  arma::mat nextStates;
+
+  //! Locally-stored termination information of previous experience.
+  arma::icolvec isTerminal;
+
+  //! Locally-stored indicator that whether the memory is full or not
+  bool full;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -98,6 +98,51 @@ class RandomReplay
     }
   }
 
+  /**
+   * Store a batch of transitions gathered from vectorized environment
+   * rollouts.  Column j of each argument describes the j'th transition.  The
+   * batch is written into the ring buffer in contiguous blocks (at most two
+   * per wrap-around) instead of one scattered column copy per transition.
+   *
+   * @param batchStates Encoded states, one column per transition.
+   * @param batchActions Actions taken at those states.
+   * @param batchRewards Rewards received.
+   * @param batchNextStates Encoded next states, one column per transition.
+   * @param batchIsTerminal Whether each next state is a terminal state.
+   */
+  void StoreBatch(const arma::mat& batchStates,
+                  const arma::icolvec& batchActions,
+                  const arma::colvec& batchRewards,
+                  const arma::mat& batchNextStates,
+                  const arma::icolvec& batchIsTerminal)
+  {
+    size_t stored = 0;
+    while (stored < batchStates.n_cols)
+    {
+      const size_t block = std::min(batchStates.n_cols - stored,
+          capacity - position);
+
+      states.cols(position, position + block - 1) =
+          batchStates.cols(stored, stored + block - 1);
+      actions.subvec(position, position + block - 1) =
+          batchActions.subvec(stored, stored + block - 1);
+      rewards.subvec(position, position + block - 1) =
+          batchRewards.subvec(stored, stored + block - 1);
+      nextStates.cols(position, position + block - 1) =
+          batchNextStates.cols(stored, stored + block - 1);
+      isTerminal.subvec(position, position + block - 1) =
+          batchIsTerminal.subvec(stored, stored + block - 1);
+
+      stored += block;
+      position += block;
+      if (position == capacity)
+      {
+        full = true;
+        position = 0;
+      }
+    }
+  }
+
   /**
    * Sample some experiences.
    *
@@ -0,0 +1,143 @@
+/**
+ * @file sum_tree.hpp
+ * @author Shangtong Zhang
+ *
+ * This file is an implementation of an array-backed sum tree, used for
+ * proportional sampling in prioritized experience replay.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_SUM_TREE_HPP
+#define MLPACK_METHODS_RL_REPLAY_SUM_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of a complete binary tree of sums, stored as a flat array.
+ * The leaves hold one weight per element; every internal node holds the sum
+ * of its two children, so the root holds the total weight.  Updating a leaf
+ * and finding the leaf at a given prefix sum both cost O(log n), and the
+ * array layout keeps parent and children a shift apart with no pointer
+ * chasing.
+ *
+ * @tparam T Type of the leaf weights.
+ */
+template<typename T>
+class SumTree
+{
+ public:
+  /**
+   * Construct a sum tree with the given number of leaves.  All the weights
+   * are initially zero.
+   *
+   * @param capacity Number of leaves; rounded up to a power of two
+   *                 internally.
+   */
+  SumTree(const size_t capacity) : capacity(1)
+  {
+    // The descent logic needs a complete tree, so round the number of leaves
+    // up to a power of two; the padding leaves keep a weight of zero and can
+    // never be sampled.
+    while (this->capacity < capacity)
+      this->capacity *= 2;
+    storage.zeros(2 * this->capacity);
+  }
+
+  /**
+   * Set the weight of the given leaf and update its ancestors.
+   *
+   * @param index Leaf index.
+   * @param weight New weight of the leaf.
+   */
+  void Set(const size_t index, const T weight)
+  {
+    size_t node = index + capacity;
+    storage[node] = weight;
+    for (node /= 2; node >= 1; node /= 2)
+      storage[node] = storage[2 * node] + storage[2 * node + 1];
+  }
+
+  /**
+   * Set the weights of a batch of leaves at once.  All the leaves are
+   * written first and each affected ancestor is then recomputed exactly
+   * once, so a batch of updates costs O(batch * log n) with no repeated
+   * work on shared ancestors.
+   *
+   * @param indices Leaf indices to update.
+   * @param weights New weights, one per index.
+   */
+  void BatchSet(const arma::uvec& indices, const arma::Col<T>& weights)
+  {
+    std::vector<size_t> nodes(indices.n_elem);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      nodes[i] = indices[i] + capacity;
+      storage[nodes[i]] = weights[i];
+    }
+
+    // Walk up one level at a time; deduplication keeps shared ancestors from
+    // being recomputed more than once per level.
+    while (!(nodes.size() == 1 && nodes[0] == 1))
+    {
+      for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i] /= 2;
+      std::sort(nodes.begin(), nodes.end());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+      for (size_t i = 0; i < nodes.size(); ++i)
+        storage[nodes[i]] = storage[2 * nodes[i]] + storage[2 * nodes[i] + 1];
+    }
+  }
+
+  //! Get the weight of the given leaf.
+  T Get(const size_t index) const { return storage[index + capacity]; }
+
+  //! Get the sum of all the leaf weights.
+  T Sum() const { return storage[1]; }
+
+  /**
+   * Find the leaf at the given prefix sum, i.e. the smallest index such that
+   * the sum of the weights of leaves 0..index is greater than mass.  With
+   * mass drawn uniformly from [0, Sum()), this samples leaves with
+   * probability proportional to their weights.
+   *
+   * @param mass Prefix sum to descend to; must be smaller than Sum().
+   */
+  size_t FindPrefixSum(T mass) const
+  {
+    size_t node = 1;
+    while (node < capacity)
+    {
+      const size_t left = 2 * node;
+      if (storage[left] > mass)
+      {
+        node = left;
+      }
+      else
+      {
+        mass -= storage[left];
+        node = left + 1;
+      }
+    }
+    return node - capacity;
+  }
+
+ private:
+  //! Number of leaves of the tree (a power of two).
+  size_t capacity;
+
+  //! Flat storage of the tree; node i has children 2i and 2i + 1, and the
+  //! leaves occupy the second half of the array.
+  arma::Col<T> storage;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -23,7 +23,7 @@ SoftmaxRegression(const size_t inputSize,
     lambda(0.0001),
     fitIntercept(fitIntercept)
 {
-  SoftmaxRegressionFunction::InitializeWeights(
+  SoftmaxRegressionFunction<>::InitializeWeights(
       parameters, inputSize, numClasses, fitIntercept);
 }
 
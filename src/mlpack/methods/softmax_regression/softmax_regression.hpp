@@ -78,6 +78,7 @@ class SoftmaxRegression
    * passed, which controls the amount of L2-regularization in the objective
    * function. By default, the model takes a small value.
    *
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @tparam OptimizerType Desired optimizer type.
    * @param data Input training features. Each column associate with one sample
    * @param labels Labels associated with the feature data.
@@ -87,8 +88,9 @@ class SoftmaxRegression
    * @param lambda L2-regularization constant.
    * @param fitIntercept add intercept term or not.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename MatType = arma::mat,
+           typename OptimizerType = ens::L_BFGS>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda = 0.0001,
@@ -153,8 +155,10 @@ class SoftmaxRegression
                          const arma::Row<size_t>& labels) const;
 
   /**
-   * Train the softmax regression with the given training data.
+   * Train the softmax regression with the given training data.  The data
+   * matrix may be either dense (arma::mat) or sparse (arma::sp_mat).
    *
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @tparam OptimizerType Desired optimizer type.
    * @param data Input data with each column as one example.
    * @param labels Labels associated with the feature data.
@@ -162,8 +166,9 @@ class SoftmaxRegression
    * @param optimizer Desired optimizer.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  double Train(const arma::mat& data,
+  template<typename MatType = arma::mat,
+           typename OptimizerType = ens::L_BFGS>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer = OptimizerType());
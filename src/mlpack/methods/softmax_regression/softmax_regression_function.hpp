@@ -18,6 +18,15 @@
 namespace mlpack {
 namespace regression {
 
+/**
+ * The objective function for softmax regression.  The type of the data matrix
+ * is a template parameter, so both dense (arma::mat) and sparse (arma::sp_mat)
+ * training data can be used; the gradient computations are written so that no
+ * transposed copy of a sparse data matrix is ever materialized.
+ *
+ * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
+ */
+template<typename MatType = arma::mat>
 class SoftmaxRegressionFunction
 {
  public:
@@ -32,7 +41,7 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
+  SoftmaxRegressionFunction(const MatType& data,
                             const arma::Row<size_t>& labels,
                             const size_t numClasses,
                             const double lambda = 0.0001,
@@ -186,7 +195,7 @@ class SoftmaxRegressionFunction
 
  private:
   //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  MatType data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
   //! Initial parameter point.
@@ -202,4 +211,7 @@ class SoftmaxRegressionFunction
 } // namespace regression
 } // namespace mlpack
 
+// Include implementation.
+#include "softmax_regression_function_impl.hpp"
+
 #endif
@@ -1,5 +1,5 @@
 /**
- * @file softmax_regression_function.cpp
+ * @file softmax_regression_function_impl.hpp
  * @author Siddharth Agrawal
  *
  * Implementation of function to be optimized for softmax regression.
@@ -9,19 +9,26 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
 #include "softmax_regression_function.hpp"
+
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
 
-using namespace mlpack;
-using namespace mlpack::regression;
+namespace mlpack {
+namespace regression {
 
-SoftmaxRegressionFunction::SoftmaxRegressionFunction(
-    const arma::mat& data,
+template<typename MatType>
+SoftmaxRegressionFunction<MatType>::SoftmaxRegressionFunction(
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
     const bool fitIntercept) :
-    data(math::MakeAlias(const_cast<arma::mat&>(data), false)),
+    data(math::MakeAlias(const_cast<MatType&>(data), false)),
     numClasses(numClasses),
     lambda(lambda),
     fitIntercept(fitIntercept)
@@ -36,38 +43,28 @@ SoftmaxRegressionFunction::SoftmaxRegressionFunction(
 /**
  * Shuffle the data.
  */
-void SoftmaxRegressionFunction::Shuffle()
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      data.n_cols - 1, data.n_cols));
-
-  // Re-sort data.
-  arma::mat newData = data.cols(ordering);
+  // Recover the labels from the ground truth matrix; each column of the ground
+  // truth matrix holds a single one in the row of the point's label.
+  arma::Row<size_t> labels(data.n_cols);
+  for (arma::sp_mat::const_iterator it = groundTruth.begin();
+      it != groundTruth.end(); ++it)
+    labels[it.col()] = it.row();
+
+  // Shuffle the data and labels together; ShuffleData() handles both dense and
+  // sparse data matrices.
+  MatType newData;
+  arma::Row<size_t> newLabels;
+  math::ShuffleData(data, labels, newData, newLabels);
+
+  // If we are an alias, make sure we don't write to the original data.
   math::ClearAlias(data);
   data = std::move(newData);
 
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-      groundTruth.n_cols);
+  // Rebuild the ground truth matrix under the new ordering.
+  GetGroundTruthMatrix(newLabels, groundTruth);
 }
 
 /**
@@ -75,12 +72,14 @@ void SoftmaxRegressionFunction::Shuffle()
  * normal distribution. The weights cannot be initialized to zero, as that will
  * lead to each class output being the same.
  */
-const arma::mat SoftmaxRegressionFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunction<MatType>::InitializeWeights()
 {
   return InitializeWeights(data.n_rows, numClasses, fitIntercept);
 }
 
-const arma::mat SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunction<MatType>::InitializeWeights(
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -90,7 +89,8 @@ const arma::mat SoftmaxRegressionFunction::InitializeWeights(
     return parameters;
 }
 
-void SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::InitializeWeights(
     arma::mat &weights,
     const size_t featureSize,
     const size_t numClasses,
@@ -111,7 +111,8 @@ void SoftmaxRegressionFunction::InitializeWeights(
  * labels. The output is in the form of a matrix, which leads to simpler
  * calculations in the Evaluate() and Gradient() methods.
  */
-void SoftmaxRegressionFunction::GetGroundTruthMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels, arma::sp_mat& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
@@ -144,7 +145,8 @@ void SoftmaxRegressionFunction::GetGroundTruthMatrix(
  * Evaluate the probabilities matrix. If fitIntercept flag is true,
  * it should consider the parameters.cols(0) intercept term.
  */
-void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities,
     const size_t start,
@@ -178,7 +180,9 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
 /**
  * Evaluates the objective function given the parameters.
  */
-double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
+template<typename MatType>
+double SoftmaxRegressionFunction<MatType>::Evaluate(
+    const arma::mat& parameters) const
 {
   // The objective function is the negative log likelihood of the model
   // calculated over all the training examples. Mathematically it is as follows:
@@ -216,9 +220,11 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
 /**
  * Evaluate the objective function for the given points given the parameters.
  */
-double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
-                                           const size_t start,
-                                           const size_t batchSize) const
+template<typename MatType>
+double SoftmaxRegressionFunction<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t start,
+    const size_t batchSize) const
 {
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
@@ -236,8 +242,10 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
 /**
  * Calculates and stores the gradient values given a set of parameters.
  */
-void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                         arma::mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
 {
   // Calculate the class probabilities for each training example. The
   // probabilities for each of the classes are given by:
@@ -248,7 +256,10 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
 
-  // Calculate the parameter gradients.
+  // Calculate the parameter gradients.  The products below are computed as
+  // (data * inner^T)^T rather than inner * data^T; the two are equivalent, but
+  // this form never materializes a transposed copy of the data matrix, which
+  // is expensive when MatType is a sparse matrix type.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   if (fitIntercept)
   {
@@ -259,25 +270,28 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
       inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
       lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-      inner * data.t() / data.n_cols +
+      (data * inner.t()).t() / data.n_cols +
       lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
+    gradient = (data * (probabilities - groundTruth).t()).t() / data.n_cols +
                lambda * parameters;
   }
 }
 
-void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                         const size_t start,
-                                         arma::mat& gradient,
-                                         const size_t batchSize) const
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t start,
+    arma::mat& gradient,
+    const size_t batchSize) const
 {
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
 
-  // Calculate the parameter gradients.
+  // Calculate the parameter gradients, avoiding a transposed copy of the data
+  // batch (see the full Gradient() overload).
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   if (fitIntercept)
   {
@@ -287,20 +301,22 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
         inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        (data.cols(start, start + batchSize - 1) * inner.t()).t() / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
+    gradient = (data.cols(start, start + batchSize - 1) *
+        (probabilities - groundTruth.cols(start, start + batchSize - 1)).t())
+        .t() / batchSize + lambda * parameters;
   }
 }
 
-void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
-                                                const size_t j,
-                                                arma::sp_mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunction<MatType>::PartialGradient(
+    const arma::mat& parameters,
+    const size_t j,
+    arma::sp_mat& gradient) const
 {
   gradient.zeros(arma::size(parameters));
 
@@ -319,6 +335,7 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
     }
     else
     {
+      // Transposing a single row of the data is cheap even for sparse data.
       gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
           parameters.col(j);
     }
@@ -329,3 +346,8 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
         parameters.col(j);
   }
 }
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
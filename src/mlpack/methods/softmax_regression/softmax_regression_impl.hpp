@@ -18,9 +18,9 @@
 namespace mlpack {
 namespace regression {
 
-template<typename OptimizerType>
+template<typename MatType, typename OptimizerType>
 SoftmaxRegression::SoftmaxRegression(
-    const arma::mat& data,
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -41,14 +41,14 @@ size_t SoftmaxRegression::Classify(const VecType& point) const
   return size_t(label(0));
 }
 
-template<typename OptimizerType>
-double SoftmaxRegression::Train(const arma::mat& data,
+template<typename MatType, typename OptimizerType>
+double SoftmaxRegression::Train(const MatType& data,
                                 const arma::Row<size_t>& labels,
                                 const size_t numClasses,
                                 OptimizerType optimizer)
 {
-  SoftmaxRegressionFunction regressor(data, labels, numClasses,
-                                      lambda, fitIntercept);
+  SoftmaxRegressionFunction<MatType> regressor(data, labels, numClasses,
+                                               lambda, fitIntercept);
   if (parameters.is_empty())
     parameters = regressor.GetInitialPoint();
 
@@ -71,18 +71,10 @@ const arma::mat SparseAutoencoderFunction::InitializeWeights()
   return parameters;
 }
 
-/** Evaluates the objective function given the parameters.
+/** Runs the feedforward pass, filling the activation buffers.
   */
-double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
+void SparseAutoencoderFunction::FeedForward(const arma::mat& parameters) const
 {
-  // The objective function is the average squared reconstruction error of the
-  // network. w1 and b1 are the weights and biases associated with the hidden
-  // layer, whereas w2 and b2 are associated with the output layer.
-  // f(w1,w2,b1,b2) = sum((data - sigmoid(w2*sigmoid(w1data + b1) + b2))^2) / 2m
-  // 'm' is the number of training examples.
-  // The cost also takes into account the regularization and KL divergence terms
-  // to control the parameter weights and sparsity of the model respectively.
-
   // Compute the limits for the parameters w1, w2, b1 and b2.
   const size_t l1 = hiddenSize;
   const size_t l2 = visibleSize;
@@ -96,47 +88,100 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
   // b1 <- parameters.submat(0, l2, l1-1, l2)
   // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
 
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
-
-  // Average activations of the hidden layer.
-  rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  double wL2SquaredNorm;
+  // w2 is stored transposed inside the parameter matrix; transpose it once
+  // per call into a persistent buffer instead of once per use.
+  w2Transposed = parameters.submat(l1, 0, l3 - 1, l2 - 1).t();
+
+  const arma::vec b1 = parameters.submat(0, l2, l1 - 1, l2);
+  const arma::vec b2 = parameters.submat(l3, 0, l3, l2 - 1).t();
+
+  // Hidden layer pre-activations; the bias, the sigmoid and the accumulation
+  // of the average activations (needed for the sparsity penalty) are applied
+  // in one parallel pass over column blocks, rather than materializing a
+  // repmat of the bias and making a separate pass for the averages.
+  hiddenLayer = parameters.submat(0, 0, l1 - 1, l2 - 1) * data;
+
+  rhoCap.zeros(hiddenSize);
+  #pragma omp parallel
+  {
+    arma::vec threadRhoCap(hiddenSize, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) hiddenLayer.n_cols; ++i)
+    {
+      for (size_t j = 0; j < hiddenSize; ++j)
+      {
+        const double a = 1.0 / (1.0 + std::exp(-(hiddenLayer(j, i) + b1[j])));
+        hiddenLayer(j, i) = a;
+        threadRhoCap[j] += a;
+      }
+    }
+
+    #pragma omp critical (SparseAutoencoderRhoCap)
+    rhoCap += threadRhoCap;
+  }
+  rhoCap /= data.n_cols;
+
+  // Output layer: one GEMM, then bias and sigmoid in place.
+  outputLayer = w2Transposed * hiddenLayer;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) outputLayer.n_cols; ++i)
+  {
+    for (size_t j = 0; j < visibleSize; ++j)
+    {
+      outputLayer(j, i) =
+          1.0 / (1.0 + std::exp(-(outputLayer(j, i) + b2[j])));
+    }
+  }
+}
 
-  // Calculate squared L2-norms of w1 and w2.
-  wL2SquaredNorm = arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
-      parameters.submat(0, 0, l3 - 1, l2 - 1));
+/** Evaluates the objective function given the parameters.
+  */
+double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
+{
+  // The objective function is the average squared reconstruction error of the
+  // network. w1 and b1 are the weights and biases associated with the hidden
+  // layer, whereas w2 and b2 are associated with the output layer.
+  // f(w1,w2,b1,b2) = sum((data - sigmoid(w2*sigmoid(w1data + b1) + b2))^2) / 2m
+  // 'm' is the number of training examples.
+  // The cost also takes into account the regularization and KL divergence terms
+  // to control the parameter weights and sparsity of the model respectively.
 
-  double sumOfSquaresError, weightDecay, klDivergence, cost;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
 
-  // Calculate the reconstruction error, the regularization cost and the KL
-  // divergence cost terms. 'sumOfSquaresError' is the average squared l2-norm
-  // of the reconstructed data difference. 'weightDecay' is the squared l2-norm
-  // of the weights w1 and w2. 'klDivergence' is the cost of the hidden layer
-  // activations not being low. It is given by the following formula:
+  // Compute activations of the hidden and output layers, and the average
+  // hidden activations.
+  FeedForward(parameters);
+
+  // Calculate the reconstruction error without materializing the difference
+  // matrix; the columns are independent, so the reduction runs over blocks of
+  // them in parallel.
+  double sumOfSquaresError = 0.0;
+  #pragma omp parallel for schedule(static) reduction(+:sumOfSquaresError)
+  for (omp_size_t i = 0; i < (omp_size_t) outputLayer.n_cols; ++i)
+  {
+    for (size_t j = 0; j < visibleSize; ++j)
+    {
+      const double d = outputLayer(j, i) - data(j, i);
+      sumOfSquaresError += d * d;
+    }
+  }
+  sumOfSquaresError *= 0.5 / data.n_cols;
+
+  // Calculate the regularization and the KL divergence cost terms.
+  // 'weightDecay' is the squared l2-norm of the weights w1 and w2.
+  // 'klDivergence' is the cost of the hidden layer activations not being low.
+  // It is given by the following formula:
   // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
-  sumOfSquaresError = 0.5 * arma::accu(diff % diff) / data.n_cols;
-  weightDecay = 0.5 * lambda * wL2SquaredNorm;
-  klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) + (1 - rho) *
-      arma::log((1 - rho) / (1 - rhoCap)));
+  const double weightDecay = 0.5 * lambda *
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+                 parameters.submat(0, 0, l3 - 1, l2 - 1));
+  const double klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) +
+      (1 - rho) * arma::log((1 - rho) / (1 - rhoCap)));
 
   // The cost is the sum of the terms calculated above.
-  cost = sumOfSquaresError + weightDecay + klDivergence;
-
-  return cost;
+  return sumOfSquaresError + weightDecay + klDivergence;
 }
 
 /** Calculates and stores the gradient values given a set of parameters.
@@ -155,33 +200,9 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
-
-  // Average activations of the hidden layer.
-  rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  arma::mat klDivGrad, delOut, delHid;
+  // Compute activations of the hidden and output layers, and the average
+  // hidden activations.
+  FeedForward(parameters);
 
   // The delta vector for the output layer is given by diff * f'(z), where z is
   // the preactivation and f is the activation function. The derivative of the
@@ -189,22 +210,50 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   // in the neural network which comes before the output layer, the delta values
   // are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost function also
   // includes the KL divergence term, we adjust for that in the formula below.
-  klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
-  delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      arma::repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
+
+  // Turn the output activations into the output deltas in place: the buffer
+  // is not needed again this call, and this skips the diff and delOut
+  // temporaries.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) outputLayer.n_cols; ++i)
+  {
+    for (size_t j = 0; j < visibleSize; ++j)
+    {
+      const double o = outputLayer(j, i);
+      outputLayer(j, i) = (o - data(j, i)) * o * (1 - o);
+    }
+  }
+
+  const arma::vec klDivGrad = beta * (-(rho / rhoCap) +
+      (1 - rho) / (1 - rhoCap));
+
+  // Hidden deltas: one GEMM, then the KL divergence adjustment and the
+  // sigmoid derivative fused in a parallel pass (instead of a repmat of the
+  // KL gradient).
+  delHid = parameters.submat(l1, 0, l3 - 1, l2 - 1) * outputLayer;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) delHid.n_cols; ++i)
+  {
+    for (size_t j = 0; j < hiddenSize; ++j)
+    {
+      const double h = hiddenLayer(j, i);
+      delHid(j, i) = (delHid(j, i) + klDivGrad[j]) * h * (1 - h);
+    }
+  }
 
   gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
 
-  // Compute the gradient values using the activations and the delta values. The
-  // formula also accounts for the regularization terms in the objective.
-  // function.
+  // Compute the gradient values using the activations and the delta values.
+  // The formula also accounts for the regularization terms in the objective
+  // function.  The w2 block uses hiddenLayer * delOut', which is the
+  // transpose of delOut * hiddenLayer' and therefore needs no transposed
+  // temporaries at all.
   gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * data.t() / data.n_cols +
       lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
   gradient.submat(l1, 0, l3 - 1, l2 - 1) =
-      (delOut * hiddenLayer.t() / data.n_cols +
-      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+      hiddenLayer * outputLayer.t() / data.n_cols +
+      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1);
   gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
-  gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
+  gradient.submat(l3, 0, l3, l2 - 1) =
+      (arma::sum(outputLayer, 1) / data.n_cols).t();
 }
@@ -145,6 +145,24 @@ class SparseAutoencoderFunction
   }
 
  private:
+  /**
+   * Run the feedforward pass for the given parameters, filling the
+   * hiddenLayer, outputLayer and rhoCap buffers.  The sigmoid activation of
+   * the hidden layer and the accumulation of the average activations (for the
+   * sparsity penalty) are fused into one parallel pass over column blocks.
+   * Called by both Evaluate() and Gradient().
+   */
+  void FeedForward(const arma::mat& parameters) const;
+
+  //! Scratch buffers reused across optimizer iterations, so each call works
+  //! in storage that is already allocated.  They are mutable because
+  //! Evaluate() and Gradient() are const.
+  mutable arma::mat w2Transposed;
+  mutable arma::mat hiddenLayer;
+  mutable arma::mat outputLayer;
+  mutable arma::mat delHid;
+  mutable arma::vec rhoCap;
+
   //! The matrix of data points.
   const arma::mat& data;
   //! Initial parameter vector.
@@ -28,7 +28,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    useCD(false)
 {
   // Nothing to do.
 }
@@ -40,7 +41,11 @@ void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Each point is coded independently against the shared Gram matrix, and
+  // every solve writes only its own column of the codes matrix, so the LARS
+  // solves can run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     // Report progress.
     if ((i % 100) == 0)
@@ -239,6 +244,69 @@ double SparseCoding::OptimizeDictionary(const arma::mat& data,
   return normGradient;
 }
 
+// Block coordinate descent dictionary step.
+double SparseCoding::OptimizeDictionaryCD(const arma::mat& data,
+                                          const arma::mat& codes)
+{
+  // Sufficient statistics for the quadratic part of the objective
+  // 0.5 * || X - D Z ||_F^2, following the block coordinate descent
+  // dictionary update of Mairal et al. (2010).
+  const arma::mat codesZT = codes * trans(codes);
+  const arma::mat codesXT = data * trans(codes);
+
+  // Holds dictionary * codesZT; column j of this matrix is D * A_j, the part
+  // of the residual correlation that depends on the current atoms.  It is
+  // maintained incrementally as atoms move, so each atom update costs
+  // O(d k) instead of recomputing the product from scratch.
+  arma::mat dictionaryZT = dictionary * codesZT;
+
+  double maxShift = 0;
+  for (size_t t = 1; t != maxIterations; ++t)
+  {
+    maxShift = 0;
+    for (size_t j = 0; j < atoms; ++j)
+    {
+      if (codesZT(j, j) == 0)
+      {
+        // This atom is unused in the given coding.  Reinitialize it randomly,
+        // as the Newton step does.  Its row and column of codesZT are zero,
+        // so dictionaryZT does not change.
+        dictionary.col(j) = (data.col(math::RandInt(data.n_cols)) +
+                             data.col(math::RandInt(data.n_cols)) +
+                             data.col(math::RandInt(data.n_cols)));
+        dictionary.col(j) /= arma::norm(dictionary.col(j), 2);
+        continue;
+      }
+
+      // Closed-form minimizer over atom j with all other atoms fixed,
+      // projected back onto the unit ball.
+      arma::vec atom = dictionary.col(j) +
+          (codesXT.col(j) - dictionaryZT.col(j)) / codesZT(j, j);
+      const double atomNorm = arma::norm(atom, 2);
+      if (atomNorm > 1)
+        atom /= atomNorm;
+
+      const arma::vec shift = atom - dictionary.col(j);
+      const double shiftNorm = arma::norm(shift, 2);
+      if (shiftNorm > 0)
+      {
+        // Fold the atom's movement into the maintained product.
+        dictionaryZT += shift * codesZT.row(j);
+        dictionary.col(j) = atom;
+        maxShift = std::max(maxShift, shiftNorm);
+      }
+    }
+
+    Log::Debug << "Coordinate descent iteration " << t << ": largest atom "
+        << "movement " << std::scientific << maxShift << "." << std::endl;
+
+    if (maxShift < newtonTolerance)
+      break;
+  }
+
+  return maxShift;
+}
+
 // Project each atom of the dictionary back into the unit ball (if necessary).
 void SparseCoding::ProjectDictionary()
 {
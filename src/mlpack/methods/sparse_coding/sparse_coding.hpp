@@ -208,6 +208,22 @@ class SparseCoding
                             const arma::mat& codes,
                             const arma::uvec& adjacencies);
 
+  /**
+   * Learn dictionary via block coordinate descent over the atoms.  Each atom
+   * is updated in closed form with the others held fixed, and the product of
+   * the dictionary with the code Gram matrix is maintained incrementally as
+   * atoms change, so a full pass costs O(d k^2) instead of the O(k^3) per
+   * iteration of the Newton method on the dual.  The unit-ball constraint on
+   * the atoms is enforced directly by the update.  Used by Train() when
+   * UseCD() is set.
+   *
+   * @param data Data matrix.
+   * @param codes Matrix of codes.
+   * @return The largest movement of any atom in the final pass.
+   */
+  double OptimizeDictionaryCD(const arma::mat& data,
+                              const arma::mat& codes);
+
   /**
    * Project each atom of the dictionary back onto the unit ball, if necessary.
    */
@@ -253,6 +269,12 @@ class SparseCoding
   //! Modify the tolerance for Newton's method (dictionary optimization step).
   double& NewtonTolerance() { return newtonTolerance; }
 
+  //! Get whether the block coordinate descent dictionary step is used during
+  //! training instead of the Newton method on the dual.
+  bool UseCD() const { return useCD; }
+  //! Modify whether the block coordinate descent dictionary step is used.
+  bool& UseCD() { return useCD; }
+
   //! Serialize the sparse coding model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -275,6 +297,9 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+  //! Whether to use the block coordinate descent dictionary step.  This is a
+  //! training option, so it is not serialized with the model.
+  bool useCD;
 };
 
 } // namespace sparse_coding
@@ -34,7 +34,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    useCD(false)
 {
   Train(data, initializer);
 }
@@ -76,7 +77,10 @@ double SparseCoding::Train(
 
     // First step: optimize the dictionary.
     Log::Info << "Performing dictionary step... " << std::endl;
-    OptimizeDictionary(data, codes, adjacencies);
+    if (useCD)
+      OptimizeDictionaryCD(data, codes);
+    else
+      OptimizeDictionary(data, codes, adjacencies);
     Log::Info << "  Objective value: " << Objective(data, codes) << "."
         << std::endl;
 
@@ -0,0 +1,141 @@
+/**
+ * @file sparse_svm.hpp
+ *
+ * Definition of the SparseSVM class, a linear support vector machine trained
+ * with dual coordinate descent on sparse data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_HPP
+#define MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace svm {
+
+/**
+ * A two-class linear support vector machine trained with dual coordinate
+ * descent (the training algorithm used by liblinear).  Each coordinate update
+ * touches only the nonzero features of one example, so training cost scales
+ * with the number of nonzeros of the dataset and not with its dense size;
+ * this is the intended training path for large sparse datasets (e.g. text),
+ * as an alternative to running an ensmallen optimizer on SparseSVMFunction.
+ *
+ * The trainer maintains the primal weight vector alongside the dual
+ * variables, uses the standard shrinking heuristic to drop examples whose
+ * dual variables are at bound, and distributes blocks of examples across
+ * OpenMP threads with asynchronous (lock-free) weight updates.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{Hsieh2008,
+ *   author    = {Cho-Jui Hsieh and Kai-Wei Chang and Chih-Jen Lin and
+ *                S. Sathiya Keerthi and S. Sundararajan},
+ *   title     = {A Dual Coordinate Descent Method for Large-scale Linear
+ *                {SVM}},
+ *   booktitle = {Proceedings of the 25th International Conference on Machine
+ *                Learning (ICML '08)},
+ *   pages     = {408--415},
+ *   year      = {2008}
+ * }
+ * @endcode
+ *
+ * Labels must be -1 or +1.
+ */
+class SparseSVM
+{
+ public:
+  /**
+   * Construct the SparseSVM object without training.
+   *
+   * @param C Regularization parameter (upper bound on the dual variables).
+   * @param maxIterations Maximum number of outer iterations (full sweeps).
+   * @param tolerance Termination tolerance on the projected gradient range.
+   */
+  SparseSVM(const double C = 1.0,
+            const size_t maxIterations = 1000,
+            const double tolerance = 1e-4);
+
+  /**
+   * Construct the SparseSVM object and train on the given data.
+   *
+   * @param dataset Sparse dataset; one example per column.
+   * @param labels Labels for each example; must be -1 or +1.
+   * @param C Regularization parameter (upper bound on the dual variables).
+   * @param maxIterations Maximum number of outer iterations (full sweeps).
+   * @param tolerance Termination tolerance on the projected gradient range.
+   */
+  SparseSVM(const arma::sp_mat& dataset,
+            const arma::vec& labels,
+            const double C = 1.0,
+            const size_t maxIterations = 1000,
+            const double tolerance = 1e-4);
+
+  /**
+   * Train the SVM with dual coordinate descent.
+   *
+   * @param dataset Sparse dataset; one example per column.
+   * @param labels Labels for each example; must be -1 or +1.
+   * @return The number of outer iterations used.
+   */
+  size_t Train(const arma::sp_mat& dataset, const arma::vec& labels);
+
+  /**
+   * Classify the given points, storing -1 or +1 for each point.
+   *
+   * @param dataset Sparse dataset; one point per column.
+   * @param predictions Vector to store the predicted labels into.
+   */
+  void Classify(const arma::sp_mat& dataset, arma::vec& predictions) const;
+
+  //! Get the weight vector.
+  const arma::vec& Parameters() const { return weights; }
+  //! Modify the weight vector.
+  arma::vec& Parameters() { return weights; }
+
+  //! Get the regularization parameter.
+  double C() const { return c; }
+  //! Modify the regularization parameter.
+  double& C() { return c; }
+
+  //! Get the maximum number of outer iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of outer iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the termination tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the termination tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The primal weight vector.
+  arma::vec weights;
+
+  //! The regularization parameter.
+  double c;
+
+  //! The maximum number of outer iterations.
+  size_t maxIterations;
+
+  //! The termination tolerance.
+  double tolerance;
+};
+
+} // namespace svm
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_svm_impl.hpp"
+
+#endif // MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_HPP
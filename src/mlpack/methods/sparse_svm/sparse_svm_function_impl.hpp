@@ -61,11 +61,10 @@ void SparseSVMFunction::Gradient(const arma::mat& parameters,
   gradient = GradType(parameters.n_rows, 1);
   for (size_t i = 0; i < batchSize; ++i)
   {
+    // Only margin violations contribute; the contribution of each example
+    // touches only its nonzero features.
     if (dots[i] >= 0)
-    {
-      // Is this correct?
-      gradient += -1 * GradType(dataset.col(id) * labels(id));
-    }
+      gradient -= GradType(dataset.col(firstId + i) * labels(firstId + i));
   }
 }
 
@@ -0,0 +1,209 @@
+/**
+ * @file sparse_svm_impl.hpp
+ *
+ * Implementation of dual coordinate descent training for the SparseSVM class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_IMPL_HPP
+#define MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sparse_svm.hpp"
+
+namespace mlpack {
+namespace svm {
+
+inline SparseSVM::SparseSVM(const double C,
+                            const size_t maxIterations,
+                            const double tolerance) :
+    c(C),
+    maxIterations(maxIterations),
+    tolerance(tolerance)
+{ /* Nothing to do. */ }
+
+inline SparseSVM::SparseSVM(const arma::sp_mat& dataset,
+                            const arma::vec& labels,
+                            const double C,
+                            const size_t maxIterations,
+                            const double tolerance) :
+    c(C),
+    maxIterations(maxIterations),
+    tolerance(tolerance)
+{
+  Train(dataset, labels);
+}
+
+inline size_t SparseSVM::Train(const arma::sp_mat& dataset,
+                               const arma::vec& labels)
+{
+  if (labels.n_elem != dataset.n_cols)
+    throw std::invalid_argument("SparseSVM::Train(): number of labels must "
+        "match number of points!");
+
+  const size_t numExamples = dataset.n_cols;
+
+  weights.zeros(dataset.n_rows);
+  arma::vec alpha(numExamples, arma::fill::zeros);
+
+  // The diagonal of the dual Hessian: Q_ii = x_i^T x_i.  Computed once, over
+  // the nonzeros only.
+  arma::vec qDiag(numExamples);
+  for (size_t i = 0; i < numExamples; ++i)
+  {
+    double sum = 0.0;
+    for (arma::sp_mat::const_col_iterator it = dataset.begin_col(i);
+        it != dataset.end_col(i); ++it)
+      sum += (*it) * (*it);
+    qDiag[i] = sum;
+  }
+
+  // The active set of examples; examples whose dual variables are firmly at
+  // bound get shrunk out of it between sweeps.
+  std::vector<arma::uword> activeSet(numExamples);
+  for (size_t i = 0; i < numExamples; ++i)
+    activeSet[i] = i;
+
+  // Projected gradient bounds from the previous sweep, used both for the
+  // shrinking thresholds and for the termination check.
+  double maxPGPrev = DBL_MAX;
+  double minPGPrev = -DBL_MAX;
+
+  size_t iteration = 0;
+  while (iteration < maxIterations)
+  {
+    iteration++;
+
+    // Shuffle the active set for this sweep.
+    for (size_t i = activeSet.size() - 1; i > 0; --i)
+      std::swap(activeSet[i], activeSet[math::RandInt(i + 1)]);
+
+    const double shrinkUpper = (maxPGPrev > 0) ? maxPGPrev : DBL_MAX;
+    const double shrinkLower = (minPGPrev < 0) ? minPGPrev : -DBL_MAX;
+
+    double maxPG = -DBL_MAX;
+    double minPG = DBL_MAX;
+    // char, not bool: elements are written concurrently and std::vector<bool>
+    // packs its elements into shared words.
+    std::vector<char> shrink(activeSet.size(), 0);
+
+    // Sweep over the active set in blocks; each thread performs its
+    // coordinate updates asynchronously on the shared weight vector.  The
+    // updates are sparse and mostly disjoint, so the occasional lost update
+    // only perturbs the order of convergence, not correctness -- the standard
+    // asynchronous coordinate descent argument.
+    #pragma omp parallel for schedule(static) \
+        reduction(max:maxPG) reduction(min:minPG)
+    for (omp_size_t a = 0; a < (omp_size_t) activeSet.size(); ++a)
+    {
+      const arma::uword i = activeSet[a];
+      const double y = labels[i];
+
+      // G = y_i w^T x_i - 1, touching only the nonzeros of x_i.
+      double dot = 0.0;
+      for (arma::sp_mat::const_col_iterator it = dataset.begin_col(i);
+          it != dataset.end_col(i); ++it)
+        dot += weights[it.row()] * (*it);
+      const double g = y * dot - 1.0;
+
+      // Project the gradient onto the feasible box and apply the shrinking
+      // heuristic for variables at bound.
+      double pg = g;
+      if (alpha[i] == 0.0)
+      {
+        if (g > shrinkUpper)
+        {
+          shrink[a] = 1;
+          continue;
+        }
+        pg = std::min(g, 0.0);
+      }
+      else if (alpha[i] == c)
+      {
+        if (g < shrinkLower)
+        {
+          shrink[a] = 1;
+          continue;
+        }
+        pg = std::max(g, 0.0);
+      }
+
+      maxPG = std::max(maxPG, pg);
+      minPG = std::min(minPG, pg);
+
+      if (pg != 0.0 && qDiag[i] > 0.0)
+      {
+        const double alphaOld = alpha[i];
+        alpha[i] = std::min(std::max(alphaOld - g / qDiag[i], 0.0), c);
+        const double delta = (alpha[i] - alphaOld) * y;
+        if (delta != 0.0)
+        {
+          for (arma::sp_mat::const_col_iterator it = dataset.begin_col(i);
+              it != dataset.end_col(i); ++it)
+            weights[it.row()] += delta * (*it);
+        }
+      }
+    }
+
+    // Remove the shrunk examples from the active set.
+    size_t kept = 0;
+    for (size_t a = 0; a < activeSet.size(); ++a)
+      if (!shrink[a])
+        activeSet[kept++] = activeSet[a];
+    activeSet.resize(kept);
+
+    // Converged?  If the whole active set satisfied the tolerance but
+    // examples had been shrunk away, restore them and take one more exact
+    // sweep before terminating (the liblinear restart rule).
+    if (maxPG - minPG < tolerance || activeSet.empty())
+    {
+      if (activeSet.size() == numExamples)
+        break;
+
+      activeSet.resize(numExamples);
+      for (size_t i = 0; i < numExamples; ++i)
+        activeSet[i] = i;
+      maxPGPrev = DBL_MAX;
+      minPGPrev = -DBL_MAX;
+      continue;
+    }
+
+    maxPGPrev = maxPG;
+    minPGPrev = minPG;
+  }
+
+  return iteration;
+}
+
+inline void SparseSVM::Classify(const arma::sp_mat& dataset,
+                                arma::vec& predictions) const
+{
+  predictions.set_size(dataset.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+  {
+    double dot = 0.0;
+    for (arma::sp_mat::const_col_iterator it = dataset.begin_col(i);
+        it != dataset.end_col(i); ++it)
+      dot += weights[it.row()] * (*it);
+    predictions[i] = (dot >= 0.0) ? 1.0 : -1.0;
+  }
+}
+
+template<typename Archive>
+void SparseSVM::serialize(Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(weights);
+  ar & BOOST_SERIALIZATION_NVP(c);
+  ar & BOOST_SERIALIZATION_NVP(maxIterations);
+  ar & BOOST_SERIALIZATION_NVP(tolerance);
+}
+
+} // namespace svm
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_SPARSE_SVM_SPARSE_SVM_IMPL_HPP
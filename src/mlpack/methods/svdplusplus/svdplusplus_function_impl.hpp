@@ -402,10 +402,6 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
   const arma::mat data = function.Dataset();
   const arma::sp_mat implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
@@ -415,6 +411,25 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // Bucket the ratings by user once (a counting sort), so that each thread
+  // can be handed whole users: updates to a user's vector and bias then never
+  // collide between threads, and with many items the remaining item-column
+  // collisions are rare enough that the updates can be applied Hogwild-style,
+  // without synchronization.
+  arma::Col<size_t> userOffsets(numUsers + 1, arma::fill::zeros);
+  for (size_t j = 0; j < data.n_cols; ++j)
+    userOffsets[(size_t) data(0, j) + 1]++;
+  for (size_t u = 0; u < numUsers; ++u)
+    userOffsets[u + 1] += userOffsets[u];
+  arma::Col<size_t> ratingsByUser(data.n_cols);
+  arma::Col<size_t> fillPositions(userOffsets.subvec(0, numUsers - 1));
+  for (size_t j = 0; j < data.n_cols; ++j)
+    ratingsByUser[fillPositions[(size_t) data(0, j)]++] = j;
+
+  // The order in which the users will be visited.
+  arma::Col<size_t> userOrder = arma::linspace<arma::Col<size_t>>(0,
+      numUsers - 1, numUsers);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -453,97 +468,83 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     double stepSize = decayPolicy.StepSize(i);
 
     if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+      std::shuffle(userOrder.begin(), userOrder.end(), mlpack::math::randGen);
 
-    #pragma omp parallel
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t u = 0; u < (omp_size_t) numUsers; ++u)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      const size_t user = userOrder[u];
+
+      // Skip users with no ratings in the training data.
+      if (userOffsets[user] == userOffsets[user + 1])
+        continue;
+
+      const size_t implicitStart = numUsers + numItems;
+
+      // Running sum of the user's implicit item vectors; it is maintained
+      // incrementally as those vectors are updated below, so each rating
+      // costs one pass over them instead of two.  All ratings of this user
+      // are handled by this thread, so the user's columns are not contended.
+      arma::vec sumY(rank, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        sumY += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
+        implicitCount += 1;
+      }
+
+      for (size_t j = userOffsets[user]; j < userOffsets[user + 1]; ++j)
       {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
+        const size_t ratingIndex = ratingsByUser[j];
+        const size_t item = data(1, ratingIndex) + numUsers;
 
         // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
+        const double rating = data(2, ratingIndex);
         const double userBias = iterate(rank, user);
         const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
-        {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
+
+        arma::vec userVec = iterate.col(user).subvec(0, rank - 1);
         if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
-        userVec += iterate.col(user).subvec(0, rank - 1);
+          userVec += sumY / std::sqrt(implicitCount);
 
-        double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
+        const double ratingError = rating - userBias - itemBias -
+            arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
 
-        arma::mat userVecUpdate = stepSize * 2 * (
+        // The item vector is used by every update below, so keep the
+        // pre-update value.
+        const arma::vec itemVec = iterate.col(item).subvec(0, rank - 1);
+
+        // The updates are plain vector operations: this thread owns the
+        // user's columns, and concurrent updates of an item column by two
+        // threads are accepted Hogwild-style.
+        iterate.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
             lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
+            ratingError * itemVec);
+        iterate.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+            lambda * itemVec - ratingError * userVec);
+        iterate(rank, user) -= stepSize * 2 * (
+            lambda * userBias - ratingError);
+        iterate(rank, item) -= stepSize * 2 * (
+            lambda * itemBias - ratingError);
 
         // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
+        if (implicitCount != 0)
         {
-          for (size_t i = 0; i < rank; ++i)
+          it = implicitData.begin_col(user);
+          for (; it != it_end; ++it)
           {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
+            iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -=
+                stepSize * 2.0 * (lambda / implicitCount *
+                iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
+                ratingError / std::sqrt(implicitCount) * itemVec);
           }
+
+          // Fold the same update into the running sum, summed over all of
+          // the user's implicit items.
+          sumY -= stepSize * 2.0 * (lambda / implicitCount * sumY -
+              ratingError * std::sqrt(implicitCount) * itemVec);
         }
       }
     }
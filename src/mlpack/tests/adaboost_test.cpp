@@ -115,6 +115,56 @@ BOOST_AUTO_TEST_CASE(WeakLearnerErrorIris)
   BOOST_REQUIRE_LE(error, weakLearnerErrorRate);
 }
 
+/**
+ * Training the weak learners on weight-proportional samples of the dataset
+ * should still produce an ensemble at least as good as a single weak learner.
+ */
+BOOST_AUTO_TEST_CASE(SampledWeakLearnerIris)
+{
+  arma::mat inputData;
+
+  if (!data::Load("iris.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+
+  if (!data::Load("iris_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for iris iris_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  // Define your own weak learner, perceptron in this case.
+  // Run the perceptron for perceptronIter iterations.
+  int perceptronIter = 400;
+
+  arma::Row<size_t> perceptronPrediction(labels.n_cols);
+  Perceptron<> p(inputData, labels.row(0), numClasses, perceptronIter);
+  p.Classify(inputData, perceptronPrediction);
+
+  size_t countWeakLearnerError = 0;
+  for (size_t i = 0; i < labels.n_cols; i++)
+    if (labels(i) != perceptronPrediction(i))
+      countWeakLearnerError++;
+  double weakLearnerErrorRate = (double) countWeakLearnerError / labels.n_cols;
+
+  // Each boosting round trains on a 50% weight-proportional sample.
+  AdaBoost<> a;
+  a.SampleRatio() = 0.5;
+  a.Train(inputData, labels.row(0), numClasses, p, 100, 1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  a.Classify(inputData, predictedLabels);
+
+  size_t countError = 0;
+  for (size_t i = 0; i < labels.n_cols; i++)
+    if (labels(i) != predictedLabels(i))
+      countError++;
+  double error = (double) countError / labels.n_cols;
+
+  // Allow a little slack, since the sampled rounds are randomized.
+  BOOST_REQUIRE_LE(error, weakLearnerErrorRate + 0.02);
+}
+
 /**
  * This test case runs the AdaBoost.mh algorithm on the UCI Vertebral Column
  * dataset.  It checks whether the hamming loss breaches the upperbound, which
@@ -12,6 +12,7 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/spill_search_tuner.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include <boost/test/unit_test.hpp>
@@ -472,4 +473,62 @@ BOOST_AUTO_TEST_CASE(KNNModelMonochromaticTest)
   }
 }
 
+/**
+ * Test that SpillSearchTuner finds a tau meeting a target recall on a sample
+ * query set, and that serving with the tuned settings matches that recall on
+ * the sample itself.
+ */
+BOOST_AUTO_TEST_CASE(SpillSearchTunerTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+  arma::mat sampleQueries = arma::randu<arma::mat>(8, 100);
+
+  SpillSearchTuner tuner(arma::mat(dataset));
+  const double achievedRecall = tuner.Tune(sampleQueries, 5, 0.9);
+
+  // The doubling phase can always reach full recall on a dataset this small,
+  // so the target must have been met.
+  BOOST_REQUIRE_GE(achievedRecall, 0.9);
+  BOOST_REQUIRE_EQUAL(tuner.Recall(), achievedRecall);
+
+  // Serving the sample queries with the tuned settings must reproduce the
+  // measured recall.
+  KNN exact(dataset);
+  arma::Mat<size_t> neighborsExact;
+  arma::mat distancesExact;
+  exact.Search(sampleQueries, 5, neighborsExact, distancesExact);
+
+  arma::Mat<size_t> neighborsApprox;
+  arma::mat distancesApprox;
+  tuner.Search(sampleQueries, 5, neighborsApprox, distancesApprox);
+
+  size_t hits = 0;
+  for (size_t q = 0; q < sampleQueries.n_cols; ++q)
+  {
+    for (size_t j = 0; j < 5; ++j)
+      for (size_t i = 0; i < 5; ++i)
+        if (neighborsApprox(i, q) == neighborsExact(j, q))
+          ++hits;
+  }
+
+  const double servedRecall = (double) hits /
+      (double) (5 * sampleQueries.n_cols);
+  BOOST_REQUIRE_GE(servedRecall, 0.9);
+}
+
+/**
+ * Searching with an untuned SpillSearchTuner should throw.
+ */
+BOOST_AUTO_TEST_CASE(SpillSearchTunerUntunedTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 100);
+  SpillSearchTuner tuner(std::move(dataset));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queries = arma::randu<arma::mat>(5, 10);
+  BOOST_REQUIRE_THROW(tuner.Search(queries, 3, neighbors, distances),
+      std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1193,6 +1193,34 @@ BOOST_AUTO_TEST_CASE(SimpleLookupLayerTest)
   BOOST_REQUIRE_CLOSE(arma::accu(gradient), arma::accu(error), 1e-3);
 }
 
+/**
+ * The Lookup module should accumulate repeated tokens in a batch and clear
+ * the columns it touched on the previous gradient pass.
+ */
+BOOST_AUTO_TEST_CASE(LookupSparseGradientTest)
+{
+  arma::mat input, gradient;
+  Lookup<> module(10, 5);
+  module.Parameters().randu();
+
+  // Two occurrences of token 2 must add up instead of overwriting.
+  input = arma::mat("2; 2");
+  arma::mat error = arma::ones(5, 2);
+  module.Gradient(std::move(input), std::move(error), std::move(gradient));
+
+  BOOST_REQUIRE_CLOSE(arma::accu(gradient.col(1)), 10.0, 1e-3);
+  BOOST_REQUIRE_EQUAL(module.ActiveColumns().n_elem, 1);
+  BOOST_REQUIRE_EQUAL(module.ActiveColumns()(0), 1);
+
+  // A second pass over a different token must clear the stale column.
+  input = arma::mat("4; 4");
+  error = arma::ones(5, 2);
+  module.Gradient(std::move(input), std::move(error), std::move(gradient));
+
+  BOOST_REQUIRE_SMALL(arma::accu(arma::abs(gradient.col(1))), 1e-12);
+  BOOST_REQUIRE_CLOSE(arma::accu(gradient.col(3)), 10.0, 1e-3);
+}
+
 /**
  * Simple LogSoftMax module test.
  */
@@ -1639,6 +1667,77 @@ BOOST_AUTO_TEST_CASE(GradientAtrousConvolutionLayerTest)
   BOOST_REQUIRE_LE(CheckGradient(function), 0.2);
 }
 
+/**
+ * Simple Separable Convolution layer test.
+ */
+BOOST_AUTO_TEST_CASE(SimpleSeparableConvolutionLayerTest)
+{
+  arma::mat output, input, delta;
+
+  SeparableConvolution<> module(1, 1, 3, 3, 1, 1, 0, 0, 4, 4);
+  // With a single input and output map the layer reduces to a depthwise
+  // convolution scaled by the pointwise weight, plus the bias.
+  input = arma::ones(16, 1);
+  module.Parameters().rows(0, 8).fill(1.0);
+  module.Parameters()(9) = 2.0;
+  module.Parameters()(10) = 1.0;
+  module.Reset();
+  module.Forward(std::move(input), std::move(output));
+
+  // Each of the four valid positions sums nine ones, doubled, plus the bias.
+  BOOST_REQUIRE_EQUAL(output.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(output.n_cols, 1);
+  BOOST_REQUIRE_EQUAL(arma::accu(output), 4 * (9 * 2 + 1));
+
+  // Test the backward function: every output error element reaches all nine
+  // filter positions through the doubled pointwise weight.
+  module.Backward(std::move(input), std::move(output), std::move(delta));
+  BOOST_REQUIRE_EQUAL(delta.n_rows, 16);
+  BOOST_REQUIRE_EQUAL(delta.n_cols, 1);
+  BOOST_REQUIRE_EQUAL(arma::accu(delta), 4 * 19 * 9 * 2);
+}
+
+/**
+ * Separable Convolution layer numerical gradient test.
+ */
+BOOST_AUTO_TEST_CASE(GradientSeparableConvolutionLayerTest)
+{
+  // Add function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction()
+    {
+      input = arma::linspace<arma::colvec>(0, 35, 36);
+      target = arma::mat("1");
+
+      model = new FFN<NegativeLogLikelihood<>, RandomInitialization>();
+      model->Predictors() = input;
+      model->Responses() = target;
+      model->Add<SeparableConvolution<> >(1, 2, 3, 3, 1, 1, 0, 0, 6, 6);
+      model->Add<LogSoftMax<> >();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 1);
+      model->Gradient(model->Parameters(), 0, gradient, 1);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood<>, RandomInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  BOOST_REQUIRE_LE(CheckGradient(function), 1e-3);
+}
+
 /**
  * Tests the LayerNorm layer.
  */
@@ -53,5 +53,26 @@ BOOST_AUTO_TEST_CASE(ArmadilloSVDLowRankFactorizationTest)
   BOOST_REQUIRE_LT(result, 0.01);
 }
 
+/**
+ * Test the truncated driver, which is selected when the requested rank is
+ * small relative to the matrix dimensions.
+ */
+BOOST_AUTO_TEST_CASE(ArmadilloSVDTruncatedFactorizationTest)
+{
+  mat W_t = randu<mat>(200, 10);
+  mat H_t = randu<mat>(10, 150);
+
+  // create a low-rank matrix large enough to trigger the truncated path
+  mat test = W_t * H_t;
+
+  SVDWrapper<> svd;
+  arma::mat W, H;
+  double result = svd.Apply(test, 10, W, H);
+
+  BOOST_REQUIRE_LT(result, 0.01);
+  BOOST_REQUIRE_EQUAL(W.n_cols, 10);
+  BOOST_REQUIRE_EQUAL(H.n_rows, 10);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END();
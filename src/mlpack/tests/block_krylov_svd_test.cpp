@@ -109,4 +109,26 @@ BOOST_AUTO_TEST_CASE(RandomizedBlockKrylovSVDNoisyLowRankTest)
   BOOST_REQUIRE_SMALL(error, 1e-2);
 }
 
+/**
+ * A sparse matrix should decompose without densification, and the singular
+ * values should match those of its dense equivalent.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedBlockKrylovSVDSparseTest)
+{
+  arma::sp_mat data;
+  data.sprandu(500, 100, 0.1);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, arma::mat(data));
+
+  svd::RandomizedBlockKrylovSVD rSVD(20, 20);
+  rSVD.Apply(data, U2, s2, V2, 10);
+
+  const double error = arma::norm(s1.subvec(0, 9) - s2.subvec(0, 9)) /
+      arma::norm(s1.subvec(0, 9));
+  BOOST_REQUIRE_SMALL(error, 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
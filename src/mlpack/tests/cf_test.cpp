@@ -154,6 +154,53 @@ void GetRecommendationsQueriedUser()
   BOOST_REQUIRE_EQUAL(recommendations.n_cols, numUsers);
 }
 
+/**
+ * Make sure that serving recommendations from the prebuilt index gives the
+ * same results as a fresh neighbor search per call.
+ */
+template<typename DecompositionPolicy>
+void GetRecommendationsFromIndex()
+{
+  DecompositionPolicy decomposition;
+  // Default number of recommendations.
+  size_t numRecs = 5;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  // Create dummy query set.
+  arma::Col<size_t> users = arma::zeros<arma::Col<size_t> >(10, 1);
+  for (size_t i = 0; i < users.n_elem; i++)
+    users(i) = i;
+
+  // Reference: recommendations with a fresh neighbor search.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  // Now build the persistent index and serve the same queries from it.
+  BOOST_REQUIRE_EQUAL(c.IndexBuilt(), false);
+  c.BuildRecommendationIndex();
+  BOOST_REQUIRE_EQUAL(c.IndexBuilt(), true);
+
+  arma::Mat<size_t> indexedRecommendations;
+  c.GetRecommendationsFromIndex(numRecs, indexedRecommendations, users);
+
+  BOOST_REQUIRE_EQUAL(indexedRecommendations.n_rows, recommendations.n_rows);
+  BOOST_REQUIRE_EQUAL(indexedRecommendations.n_cols, recommendations.n_cols);
+  for (size_t i = 0; i < recommendations.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(indexedRecommendations[i], recommendations[i]);
+
+  // The single-user overload should match the corresponding column.
+  arma::Col<size_t> userRecommendations;
+  c.GetRecommendationsFromIndex(numRecs, (size_t) 3, userRecommendations);
+  BOOST_REQUIRE_EQUAL(userRecommendations.n_elem, numRecs);
+  for (size_t i = 0; i < numRecs; ++i)
+    BOOST_REQUIRE_EQUAL(userRecommendations[i], recommendations(i, 3));
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate.
  */
@@ -291,6 +338,46 @@ void BatchPredict()
   }
 }
 
+// Query every item of a few users through the batch Predict(), so the
+// per-user dense evaluation path is taken, and make sure its results still
+// match the individual Predict() calls.
+template<typename DecompositionPolicy>
+void BatchPredictDense()
+{
+  DecompositionPolicy decomposition;
+
+  // Small GroupLens dataset.
+  arma::mat dataset;
+
+  // Save the columns we've removed.
+  arma::mat savedCols;
+
+  GetDatasets(dataset, savedCols);
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  const size_t numItems = c.CleanedData().n_rows;
+  const size_t numUsers = 3;
+  arma::Mat<size_t> combinations(2, numUsers * numItems);
+  for (size_t u = 0; u < numUsers; ++u)
+  {
+    for (size_t j = 0; j < numItems; ++j)
+    {
+      combinations(0, u * numItems + j) = u;
+      combinations(1, u * numItems + j) = j;
+    }
+  }
+
+  arma::vec predictions;
+  c.Predict(combinations, predictions);
+
+  for (size_t i = 0; i < combinations.n_cols; ++i)
+  {
+    const double prediction = c.Predict(combinations(0, i), combinations(1, i));
+    BOOST_REQUIRE_CLOSE(prediction, predictions[i], 1e-8);
+  }
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay.
  */
@@ -591,6 +678,24 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsQueriedUserRandSVDTest)
   GetRecommendationsQueriedUser<RandomizedSVDPolicy>();
 }
 
+/**
+ * Make sure serving from the prebuilt recommendation index matches the
+ * per-call neighbor search, for NMF.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsFromIndexNMFTest)
+{
+  GetRecommendationsFromIndex<NMFPolicy>();
+}
+
+/**
+ * Make sure serving from the prebuilt recommendation index matches the
+ * per-call neighbor search, for batch SVD.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsFromIndexBatchSVDTest)
+{
+  GetRecommendationsFromIndex<BatchSVDPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for regularized SVD.
@@ -812,6 +917,13 @@ BOOST_AUTO_TEST_CASE(CFBatchPredictNMFTest)
   BatchPredict<NMFPolicy>();
 }
 
+// Compare batch Predict() and individual Predict() for NMF when whole users
+// are queried, so the dense per-user evaluation path is exercised.
+BOOST_AUTO_TEST_CASE(CFBatchPredictDenseNMFTest)
+{
+  BatchPredictDense<NMFPolicy>();
+}
+
 // Compare batch Predict() and individual Predict() for
 // SVD Complete Incremental method.
 BOOST_AUTO_TEST_CASE(CFBatchPredictSVDCompleteTest)
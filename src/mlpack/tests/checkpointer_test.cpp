@@ -0,0 +1,98 @@
+/**
+ * @file checkpointer_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the asynchronous model checkpointer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/checkpointer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+BOOST_AUTO_TEST_SUITE(CheckpointerTest);
+
+/**
+ * A checkpoint must be recoverable from disk once Finish() returns.
+ */
+BOOST_AUTO_TEST_CASE(CheckpointRoundTripTest)
+{
+  arma::mat parameters(50, 20, arma::fill::randu);
+
+  {
+    Checkpointer<> checkpointer("checkpointer_test.bin");
+    checkpointer.Checkpoint(parameters);
+    checkpointer.Finish();
+  }
+
+  arma::mat recovered;
+  BOOST_REQUIRE(data::Load("checkpointer_test.bin", recovered, false, false));
+  CheckMatrices(parameters, recovered);
+
+  remove("checkpointer_test.bin");
+}
+
+/**
+ * A sequence of back-to-back checkpoints must leave the last snapshot on
+ * disk; the earlier writes overlap with the later snapshots through the
+ * double buffering.
+ */
+BOOST_AUTO_TEST_CASE(CheckpointSequenceTest)
+{
+  arma::mat parameters(200, 100, arma::fill::randu);
+
+  Checkpointer<> checkpointer("checkpointer_test.bin");
+  for (size_t i = 0; i < 10; ++i)
+  {
+    parameters += 1.0;
+    checkpointer.Checkpoint(parameters);
+  }
+  checkpointer.Finish();
+
+  arma::mat recovered;
+  BOOST_REQUIRE(data::Load("checkpointer_test.bin", recovered, false, false));
+  CheckMatrices(parameters, recovered);
+
+  remove("checkpointer_test.bin");
+}
+
+/**
+ * The ensmallen epoch hook must respect the checkpoint interval.
+ */
+BOOST_AUTO_TEST_CASE(CheckpointIntervalTest)
+{
+  arma::mat parameters(10, 10, arma::fill::randu);
+
+  // No optimizer or function is needed to exercise the hook.
+  int dummyOptimizer = 0;
+  int dummyFunction = 0;
+
+  Checkpointer<> checkpointer("checkpointer_test.bin", 5);
+
+  // Epoch 3 is not a multiple of the interval, so no file may appear.
+  checkpointer.EndEpoch(dummyOptimizer, dummyFunction, parameters, 3, 0.0);
+  checkpointer.Finish();
+
+  arma::mat recovered;
+  BOOST_REQUIRE(!data::Load("checkpointer_test.bin", recovered, false,
+      false));
+
+  // Epoch 5 is.
+  checkpointer.EndEpoch(dummyOptimizer, dummyFunction, parameters, 5, 0.0);
+  checkpointer.Finish();
+
+  BOOST_REQUIRE(data::Load("checkpointer_test.bin", recovered, false, false));
+  CheckMatrices(parameters, recovered);
+
+  remove("checkpointer_test.bin");
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/bindings/cli/cli_option.hpp>
+#include <mlpack/bindings/cli/serve_binding.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -631,4 +632,41 @@ BOOST_AUTO_TEST_CASE(DeleteAllocatedMemoryModelTest)
       (const void*) NULL, (void*) NULL);
 }
 
+#ifndef _WIN32
+// Test that a --serve matrix frame written to one end of a socket pair can be
+// read back intact from the other end.
+BOOST_AUTO_TEST_CASE(ServeMatrixFrameRoundTripTest)
+{
+  int fds[2];
+  BOOST_REQUIRE_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  arma::mat matrix(7, 13, arma::fill::randu);
+  BOOST_REQUIRE(WriteMatrixFrame(fds[0], "query", matrix));
+  BOOST_REQUIRE(WriteTerminator(fds[0]));
+
+  string name;
+  bool shutdown;
+  BOOST_REQUIRE(ReadFrameName(fds[1], name, shutdown));
+  BOOST_REQUIRE(!shutdown);
+  BOOST_REQUIRE_EQUAL(name, "query");
+
+  arma::mat received;
+  BOOST_REQUIRE(ReadMatrixBody(fds[1], received));
+  BOOST_REQUIRE_EQUAL(received.n_rows, matrix.n_rows);
+  BOOST_REQUIRE_EQUAL(received.n_cols, matrix.n_cols);
+  for (size_t i = 0; i < matrix.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(received[i], matrix[i]);
+
+  // The terminator must be read back as an empty name.
+  BOOST_REQUIRE(ReadFrameName(fds[1], name, shutdown));
+  BOOST_REQUIRE(!shutdown);
+  BOOST_REQUIRE_EQUAL(name, "");
+
+  // A closed connection must be reported as a failed read, not a frame.
+  close(fds[0]);
+  BOOST_REQUIRE(!ReadFrameName(fds[1], name, shutdown));
+  close(fds[1]);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -15,7 +15,10 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_gemm_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/auto_convolution.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -149,6 +152,21 @@ BOOST_AUTO_TEST_CASE(ValidConvolution2DTest)
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and GEMM.
+  Convolution2DMethodTest<Im2ColGEMMConvolution<ValidConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution through the Winograd transform.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution through the benchmarked dispatcher; the second
+  // run hits the per-shape cache.
+  Convolution2DMethodTest<AutoConvolution<ValidConvolution> >(input, filter,
+      output);
+  Convolution2DMethodTest<AutoConvolution<ValidConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -186,6 +204,21 @@ BOOST_AUTO_TEST_CASE(FullConvolution2DTest)
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and GEMM.
+  Convolution2DMethodTest<Im2ColGEMMConvolution<FullConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution through the Winograd transform.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution through the benchmarked dispatcher; the second
+  // run hits the per-shape cache.
+  Convolution2DMethodTest<AutoConvolution<FullConvolution> >(input, filter,
+      output);
+  Convolution2DMethodTest<AutoConvolution<FullConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -231,6 +264,18 @@ BOOST_AUTO_TEST_CASE(ValidConvolution3DTest)
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and GEMM.
+  Convolution3DMethodTest<Im2ColGEMMConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution through the Winograd transform.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution through the benchmarked dispatcher.
+  Convolution3DMethodTest<AutoConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -280,6 +325,18 @@ BOOST_AUTO_TEST_CASE(FullConvolution3DTest)
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and GEMM.
+  Convolution3DMethodTest<Im2ColGEMMConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution through the Winograd transform.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution through the benchmarked dispatcher.
+  Convolution3DMethodTest<AutoConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -322,6 +379,18 @@ BOOST_AUTO_TEST_CASE(ValidConvolutionBatchTest)
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and GEMM.
+  ConvolutionMethodBatchTest<Im2ColGEMMConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution through the Winograd transform.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution through the benchmarked dispatcher.
+  ConvolutionMethodBatchTest<AutoConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -368,6 +437,18 @@ BOOST_AUTO_TEST_CASE(FullConvolutionBatchTest)
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and GEMM.
+  ConvolutionMethodBatchTest<Im2ColGEMMConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution through the Winograd transform.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution through the benchmarked dispatcher.
+  ConvolutionMethodBatchTest<AutoConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
 }
 
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/cv/metrics/classification_report.hpp>
 #include <mlpack/core/cv/metrics/f1.hpp>
 #include <mlpack/core/cv/metrics/mse.hpp>
 #include <mlpack/core/cv/metrics/precision.hpp>
@@ -123,6 +124,54 @@ BOOST_AUTO_TEST_CASE(MulticlassClassificationMetricsTest)
       macroaveragedF1, 1e-5);
 }
 
+/**
+ * Test that a ClassificationReport built from one classification pass agrees
+ * with the individually evaluated metrics.
+ */
+BOOST_AUTO_TEST_CASE(ClassificationReportTest)
+{
+  // The same setup as in the multiclass metrics test above.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 12.0, 12);
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+  size_t numClasses = 4;
+
+  NaiveBayesClassifier<> nb(data, predictedLabels, numClasses);
+
+  ClassificationReport report(nb, data, labels);
+
+  BOOST_REQUIRE_EQUAL(report.NumClasses(), numClasses);
+  BOOST_REQUIRE_CLOSE(report.Accuracy(),
+      Accuracy::Evaluate(nb, data, labels), 1e-5);
+  BOOST_REQUIRE_CLOSE(report.MacroPrecision(),
+      Precision<Macro>::Evaluate(nb, data, labels), 1e-5);
+  BOOST_REQUIRE_CLOSE(report.MacroRecall(),
+      Recall<Macro>::Evaluate(nb, data, labels), 1e-5);
+  BOOST_REQUIRE_CLOSE(report.MacroF1(),
+      F1<Macro>::Evaluate(nb, data, labels), 1e-5);
+
+  // The confusion matrix must agree with the hand-computed counts; e.g. one
+  // instance of class 1 is predicted as class 0.
+  BOOST_REQUIRE_EQUAL(report.ConfusionMatrix()(0, 0), 1);
+  BOOST_REQUIRE_EQUAL(report.ConfusionMatrix()(0, 1), 1);
+  BOOST_REQUIRE_EQUAL(report.ConfusionMatrix()(1, 0), 1);
+  BOOST_REQUIRE_EQUAL(report.ConfusionMatrix()(2, 2), 3);
+  BOOST_REQUIRE_EQUAL(report.ConfusionMatrix()(3, 3), 4);
+
+  // A report built from a caller-owned prediction buffer must agree with the
+  // one that classifies internally.
+  arma::Row<size_t> predictions;
+  nb.Classify(data, predictions);
+  ClassificationReport bufferReport(predictions, labels);
+  BOOST_REQUIRE_CLOSE(bufferReport.Accuracy(), report.Accuracy(), 1e-5);
+  BOOST_REQUIRE_CLOSE(bufferReport.MacroF1(), report.MacroF1(), 1e-5);
+
+  // Mismatched prediction and label sizes must throw.
+  arma::Row<size_t> badPredictions(11);
+  BOOST_REQUIRE_THROW(ClassificationReport(badPredictions, labels),
+      std::invalid_argument);
+}
+
 /**
  * Test the mean squared error.
  */
@@ -332,6 +381,33 @@ BOOST_AUTO_TEST_CASE(SimpleCVMSETest)
   BOOST_REQUIRE_GT(std::abs(weightedCV2.Evaluate() - expectedMSE), 1e-5);
 }
 
+/**
+ * Test the partial-budget evaluation of the simple cross-validation strategy.
+ */
+BOOST_AUTO_TEST_CASE(SimpleCVEvaluateFractionTest)
+{
+  // The responses follow y = 2 * x exactly for the first two points and then
+  // drift away from that line, so training on a prefix of the training set
+  // gives a different model than training on all of it.
+  arma::mat data("0 1 2 3 4 5 6 7 8 9");
+  arma::rowvec responses("0 2 4 6 9 12 15 18 21 24");
+
+  // The first five points are used for training and the rest for validation.
+  SimpleCV<LinearRegression, MSE> cv(0.5, data, responses);
+
+  // At full budget EvaluateFraction() should agree with Evaluate().
+  BOOST_REQUIRE_CLOSE(cv.EvaluateFraction(1.0), cv.Evaluate(), 1e-5);
+
+  // A fraction of 0.4 means training on the first two points only, which
+  // gives exactly y = 2 * x; the squared errors on the validation points are
+  // 4, 9, 16, 25 and 36.
+  double expectedMSE = (4.0 + 9.0 + 16.0 + 25.0 + 36.0) / 5.0;
+  BOOST_REQUIRE_CLOSE(cv.EvaluateFraction(0.4), expectedMSE, 1e-5);
+
+  BOOST_REQUIRE_THROW(cv.EvaluateFraction(0.0), std::invalid_argument);
+  BOOST_REQUIRE_THROW(cv.EvaluateFraction(1.5), std::invalid_argument);
+}
+
 template<typename... DTArgs>
 arma::Row<size_t> PredictLabelsWithDT(const arma::mat& data,
                                       const DTArgs&... args)
@@ -309,4 +309,82 @@ BOOST_AUTO_TEST_CASE(RandomPointSelectionTest)
   BOOST_REQUIRE_EQUAL(assignments.n_elem, points.n_cols);
 }
 
+/**
+ * The grid-based engine must produce exactly the same clustering as the
+ * default tree-based range search.
+ */
+BOOST_AUTO_TEST_CASE(GridRangeSearchTest)
+{
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    // Low-dimensional data, as the grid engine is intended for.
+    arma::mat points(3, 500, arma::fill::randu);
+    points *= 10.0;
+
+    DBSCAN<> d(1.0, 5);
+    arma::Row<size_t> assignments;
+    const size_t clusters = d.Cluster(points, assignments);
+
+    DBSCAN<GridRangeSearch<>> g(1.0, 5);
+    arma::Row<size_t> gridAssignments;
+    const size_t gridClusters = g.Cluster(points, gridAssignments);
+
+    BOOST_REQUIRE_EQUAL(clusters, gridClusters);
+
+    // Cluster numbering depends on the order of union-find merges, so the
+    // partitions are compared up to a relabeling.  Noise must match exactly.
+    std::map<size_t, size_t> labelMap;
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      if (assignments[i] == SIZE_MAX)
+      {
+        BOOST_REQUIRE_EQUAL(gridAssignments[i], SIZE_MAX);
+        continue;
+      }
+
+      BOOST_REQUIRE_NE(gridAssignments[i], SIZE_MAX);
+      if (labelMap.count(assignments[i]) == 0)
+        labelMap[assignments[i]] = gridAssignments[i];
+      BOOST_REQUIRE_EQUAL(labelMap[assignments[i]], gridAssignments[i]);
+    }
+  }
+}
+
+/**
+ * The grid engine must also work in pointwise (non-batch) mode, where one
+ * query is issued per point.
+ */
+BOOST_AUTO_TEST_CASE(GridRangeSearchPointwiseTest)
+{
+  arma::mat points(2, 300, arma::fill::randu);
+  points *= 10.0;
+
+  DBSCAN<GridRangeSearch<>> batch(1.0, 3, true);
+  arma::Row<size_t> batchAssignments;
+  const size_t batchClusters = batch.Cluster(points, batchAssignments);
+
+  DBSCAN<GridRangeSearch<>> pointwise(1.0, 3, false);
+  arma::Row<size_t> pointwiseAssignments;
+  const size_t pointwiseClusters = pointwise.Cluster(points,
+      pointwiseAssignments);
+
+  BOOST_REQUIRE_EQUAL(batchClusters, pointwiseClusters);
+
+  // As above, compare the partitions up to a relabeling.
+  std::map<size_t, size_t> labelMap;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (batchAssignments[i] == SIZE_MAX)
+    {
+      BOOST_REQUIRE_EQUAL(pointwiseAssignments[i], SIZE_MAX);
+      continue;
+    }
+
+    BOOST_REQUIRE_NE(pointwiseAssignments[i], SIZE_MAX);
+    if (labelMap.count(batchAssignments[i]) == 0)
+      labelMap[batchAssignments[i]] = pointwiseAssignments[i];
+    BOOST_REQUIRE_EQUAL(labelMap[batchAssignments[i]], pointwiseAssignments[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/decision_stump/binned_decision_stump.hpp>
 #include <mlpack/methods/decision_stump/decision_stump.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -391,4 +392,84 @@ BOOST_AUTO_TEST_CASE(IntTest)
   BOOST_CHECK_EQUAL(predictedLabels(0, 7), 2);
 }
 
+/**
+ * A binned decision stump must recover a clean one-dimensional split.
+ */
+BOOST_AUTO_TEST_CASE(BinnedStumpPerfectSplitTest)
+{
+  mat trainingData;
+  trainingData << 0 << 1 << 2 << 3 << 9 << 10 << 11 << 12;
+
+  Mat<size_t> labelsIn;
+  labelsIn << 0 << 0 << 0 << 0 << 1 << 1 << 1 << 1;
+
+  BinnedDecisionStump<> bds(trainingData, labelsIn.row(0), 2, 16);
+
+  BOOST_REQUIRE_EQUAL(bds.SplitDimension(), 0);
+  BOOST_REQUIRE_GT(bds.SplitValue(), 3.0);
+  BOOST_REQUIRE_LE(bds.SplitValue(), 9.0);
+
+  arma::Row<size_t> predictedLabels;
+  bds.Classify(trainingData, predictedLabels);
+  for (size_t i = 0; i < trainingData.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(predictedLabels(i), labelsIn(0, i));
+}
+
+/**
+ * Heavily down-weighted mislabeled points must not move the binned split.
+ */
+BOOST_AUTO_TEST_CASE(BinnedStumpWeightedTest)
+{
+  mat trainingData;
+  trainingData << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9;
+
+  // Point 0 carries the wrong label but almost no weight.
+  Mat<size_t> labelsIn;
+  labelsIn << 1 << 0 << 0 << 0 << 0 << 1 << 1 << 1 << 1 << 1;
+
+  rowvec weights("1e-8 1 1 1 1 1 1 1 1 1");
+
+  BinnedDecisionStump<> bds;
+  bds.Train(trainingData, labelsIn.row(0), weights, 2, 32);
+
+  arma::Row<size_t> predictedLabels;
+  bds.Classify(trainingData, predictedLabels);
+
+  BOOST_REQUIRE_EQUAL(predictedLabels(0), 0);
+  for (size_t i = 1; i < 5; ++i)
+    BOOST_REQUIRE_EQUAL(predictedLabels(i), 0);
+  for (size_t i = 5; i < 10; ++i)
+    BOOST_REQUIRE_EQUAL(predictedLabels(i), 1);
+}
+
+/**
+ * The weak learner constructor must reuse the prototype's bin codes on the
+ * same matrix and produce the same stump as direct weighted training.
+ */
+BOOST_AUTO_TEST_CASE(BinnedStumpCacheReuseTest)
+{
+  mat trainingData = arma::randu<mat>(4, 200);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels(i) = (trainingData(2, i) > 0.5) ? 1 : 0;
+
+  rowvec weights(200, fill::ones);
+
+  BinnedDecisionStump<> prototype(trainingData, labels, 2, 64);
+
+  // Two boosting-style rounds on the same matrix; the second must reuse the
+  // codes quantized in the first.
+  BinnedDecisionStump<> round1(prototype, trainingData, labels, 2, weights);
+  BinnedDecisionStump<> round2(prototype, trainingData, labels, 2, weights);
+
+  BOOST_REQUIRE_EQUAL(round1.SplitDimension(), round2.SplitDimension());
+  BOOST_REQUIRE_CLOSE(round1.SplitValue(), round2.SplitValue(), 1e-10);
+
+  BinnedDecisionStump<> direct;
+  direct.Train(trainingData, labels, weights, 2, 64);
+  BOOST_REQUIRE_EQUAL(round1.SplitDimension(), direct.SplitDimension());
+  BOOST_REQUIRE_CLOSE(round1.SplitValue(), direct.SplitValue(), 1e-10);
+  BOOST_REQUIRE_EQUAL(round1.SplitDimension(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,9 @@
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include <mlpack/methods/decision_tree/information_gain.hpp>
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
+#include <mlpack/methods/decision_tree/histogram_numeric_split.hpp>
+#include <mlpack/methods/decision_tree/random_binary_numeric_split.hpp>
+#include <mlpack/methods/decision_tree/best_binary_categorical_split.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 
@@ -367,6 +370,188 @@ BOOST_AUTO_TEST_CASE(BestBinaryNumericSplitNoGainTest)
   BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
 }
 
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitSimpleSplitTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  BOOST_REQUIRE_GT(gain, bestGain);
+
+  // Make sure weight works and make no different with no weighted one
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  // The class probabilities, for this split, hold the splitting point, which
+  // should be between 0.4 and 0.5.
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 1);
+  BOOST_REQUIRE_GT(classProbabilities[0], 0.4);
+  BOOST_REQUIRE_LT(classProbabilities[0], 0.5);
+}
+
+/**
+ * Check that the RandomBinaryNumericSplit will split on an obviously
+ * splittable dimension.  The labels are monotone in the values, so any
+ * threshold drawn inside the range improves the gain.
+ */
+BOOST_AUTO_TEST_CASE(RandomBinaryNumericSplitSimpleSplitTest)
+{
+  arma::vec values("-1.0 -0.9 -0.8 -0.7 -0.6 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  RandomBinaryNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 1, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made, and that the threshold lies inside the
+  // range of the dimension.
+  BOOST_REQUIRE_GT(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 1);
+  BOOST_REQUIRE_GT(classProbabilities[0], -1.0);
+  BOOST_REQUIRE_LT(classProbabilities[0], 1.0);
+}
+
+/**
+ * Check that the RandomBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+BOOST_AUTO_TEST_CASE(RandomBinaryNumericSplitMinSamplesTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  RandomBinaryNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+}
+
+/**
+ * Check that the HistogramNumericSplit won't split if not enough points are
+ * given.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitMinSamplesTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Check that the HistogramNumericSplit doesn't split a dimension that gives no
+ * gain.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitNoGainTest)
+{
+  arma::vec values(100);
+  arma::Row<size_t> labels(100);
+  arma::rowvec weights;
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    values[i] = i;
+    labels[i] = 0;
+    values[i + 1] = i;
+    labels[i + 1] = 1;
+  }
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 10, 1e-7, classProbabilities, aux);
+
+  // Make sure there was no split.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Test that a decision tree built with the histogram-binned numeric split
+ * generalizes about as well as the exhaustive split.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitGeneralizationTest)
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Build the decision tree with binned splits.
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+
+  // Load testing data.
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    BOOST_FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  // Get the predicted test labels.
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+
+  // Figure out the accuracy.
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  BOOST_REQUIRE_GT(correct, 0.75);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -465,6 +650,161 @@ BOOST_AUTO_TEST_CASE(AllCategoricalSplitNoGainTest)
   BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
 }
 
+/**
+ * Check that the BestBinaryCategoricalSplit will find a perfect binary
+ * partition of the categories when one exists.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitSimpleSplitTest)
+{
+  arma::vec values("0 0 0 1 1 1 2 2 2 3 3 3");
+  arma::Row<size_t> labels("0 0 0 1 1 1 0 0 0 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double>
+      aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 4, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, 4, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  BOOST_REQUIRE_GT(gain, bestGain);
+
+  // Since categories {0, 2} and {1, 3} can be separated perfectly, the gain
+  // should be 0.
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+
+  // The split should be binary, with one direction per category; categories
+  // of the same class must go to the same child.
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 4);
+  BOOST_REQUIRE_EQUAL(
+      (BestBinaryCategoricalSplit<GiniGain>::NumChildren(classProbabilities,
+          aux)), 2);
+
+  const size_t dir0 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      0.0, classProbabilities, aux);
+  const size_t dir1 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      1.0, classProbabilities, aux);
+  const size_t dir2 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      2.0, classProbabilities, aux);
+  const size_t dir3 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      3.0, classProbabilities, aux);
+
+  BOOST_REQUIRE_EQUAL(dir0, dir2);
+  BOOST_REQUIRE_EQUAL(dir1, dir3);
+  BOOST_REQUIRE_NE(dir0, dir1);
+}
+
+/**
+ * Make sure that BestBinaryCategoricalSplit respects the minimum number of
+ * samples required to split.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitMinSamplesTest)
+{
+  arma::vec values("0 0 0 1 1 1 2 2 2 3 3 3");
+  arma::Row<size_t> labels("0 0 0 1 1 1 0 0 0 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double>
+      aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 4, labels, 2, weights, 7, 1e-7, classProbabilities, aux);
+
+  // Make sure it's not split.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Check that BestBinaryCategoricalSplit makes no split when no binary
+ * partition of the categories gives any gain.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitNoGainTest)
+{
+  arma::vec values(300);
+  arma::Row<size_t> labels(300);
+  arma::rowvec weights = arma::ones<arma::rowvec>(300);
+
+  for (size_t i = 0; i < 300; i += 3)
+  {
+    values[i] = (i / 3) % 10;
+    labels[i] = 0;
+    values[i + 1] = (i / 3) % 10;
+    labels[i + 1] = 1;
+    values[i + 2] = (i / 3) % 10;
+    labels[i + 2] = 2;
+  }
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double>
+      aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 3, weights);
+  const double gain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, 10, labels, 3, weights, 10, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, 10, labels, 3, weights, 10, 1e-7, classProbabilities, aux);
+
+  // Make sure that there was no split.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Test that we can build a decision tree that uses binary categorical splits
+ * on a simple categorical dataset, with reasonable accuracy.
+ */
+BOOST_AUTO_TEST_CASE(BestBinaryCategoricalSplitBuildTest)
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTree<GiniGain, BestBinaryNumericSplit, BestBinaryCategoricalSplit>
+      tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Now evaluate the accuracy of the tree.
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+  size_t correct = 0;
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    if (testLabels[i] == predictions[i])
+      ++correct;
+
+  // Make sure we got at least 70% accuracy.
+  const double correctPct = double(correct) / double(testData.n_cols);
+  BOOST_REQUIRE_GT(correctPct, 0.70);
+}
+
 /**
  * A basic construction of the decision tree---ensure that we can create the
  * tree and that it split at least once.
@@ -664,6 +1004,43 @@ BOOST_AUTO_TEST_CASE(SimpleGeneralizationTest)
   BOOST_REQUIRE_GT(wdcorrect, 0.75);
 }
 
+/**
+ * Test that the batch Classify() overloads, which walk blocks of points
+ * through the tree, agree with the single-point Classify() overloads.
+ */
+BOOST_AUTO_TEST_CASE(BatchClassifyConsistencyTest)
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Build decision tree.
+  DecisionTree<> d(inputData, labels, 3, 10); // Leaf size of 10.
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  d.Classify(inputData, predictions, probabilities);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, inputData.n_cols);
+  BOOST_REQUIRE_EQUAL(probabilities.n_cols, inputData.n_cols);
+
+  for (size_t i = 0; i < inputData.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    d.Classify(inputData.col(i), prediction, pointProbabilities);
+
+    BOOST_REQUIRE_EQUAL(predictions[i], prediction);
+    BOOST_REQUIRE_EQUAL(predictions[i], d.Classify(inputData.col(i)));
+    for (size_t j = 0; j < pointProbabilities.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(probabilities(j, i), pointProbabilities[j], 1e-5);
+  }
+}
+
 /**
  * Test that we can build a decision tree on a simple categorical dataset.
  */
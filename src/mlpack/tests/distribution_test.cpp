@@ -7,6 +7,7 @@
  * Tests for the classes:
  *  * mlpack::distribution::DiscreteDistribution
  *  * mlpack::distribution::GaussianDistribution
+ *  * mlpack::distribution::DiagonalGaussianDistribution
  *  * mlpack::distribution::GammaDistribution
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
@@ -16,6 +17,7 @@
  */
 #include <mlpack/core.hpp>
 
+#include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
 #include <mlpack/core/dists/regression_distribution.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -90,6 +92,26 @@ BOOST_AUTO_TEST_CASE(DiscreteDistributionRandomTest)
   BOOST_REQUIRE_CLOSE(actualProb(2), 0.1, 8.0);
 }
 
+/**
+ * Make sure the alias tables used by Random() are rebuilt after the
+ * probabilities are modified.
+ */
+BOOST_AUTO_TEST_CASE(DiscreteDistributionRandomRebuildTest)
+{
+  DiscreteDistribution d(arma::Col<size_t>("3"));
+
+  d.Probabilities() = "0.3 0.6 0.1";
+
+  // Draw, so that the alias tables are built for the old probabilities.
+  d.Random();
+
+  // Now change the distribution so that only observation 2 is possible.
+  d.Probabilities() = "0.0 0.0 1.0";
+
+  for (size_t i = 0; i < 100; i++)
+    BOOST_REQUIRE_EQUAL((size_t) (d.Random()[0] + 0.5), 2);
+}
+
 /**
  * Make sure we can estimate from observations correctly.
  */
@@ -630,6 +652,113 @@ BOOST_AUTO_TEST_CASE(GaussianDistributionTrainWithTwoDistProbabilitiesTest)
   BOOST_REQUIRE_CLOSE(guDist.Covariance()[0], cov1[0], 5);
 }
 
+/*****************************************/
+/** Diagonal Gaussian Distribution Tests */
+/*****************************************/
+
+/**
+ * Make sure the diagonal distribution agrees with a full GaussianDistribution
+ * that has the same (diagonal) covariance, for both the single-point and
+ * batched LogProbability() overloads.
+ */
+BOOST_AUTO_TEST_CASE(DiagonalGaussianDistributionProbabilityTest)
+{
+  arma::vec mean("2 5 3 4 1");
+  arma::vec variances("3 1 5 2 2");
+
+  DiagonalGaussianDistribution d(mean, variances);
+  GaussianDistribution g(mean, arma::diagmat(variances));
+
+  arma::mat points(5, 50, arma::fill::randn);
+  points.each_col() += mean;
+
+  // Single-point evaluation.
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(d.LogProbability(points.col(i)),
+        g.LogProbability(points.col(i)), 1e-5);
+  }
+
+  // Batched evaluation.
+  arma::vec diagPhis, fullPhis;
+  d.LogProbability(points, diagPhis);
+  g.LogProbability(points, fullPhis);
+
+  BOOST_REQUIRE_EQUAL(diagPhis.n_elem, points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(diagPhis[i], fullPhis[i], 1e-5);
+}
+
+/**
+ * Make sure random observations from a diagonal distribution reflect its
+ * parameters.
+ */
+BOOST_AUTO_TEST_CASE(DiagonalGaussianDistributionRandomTest)
+{
+  arma::vec mean("1.0 2.25");
+  arma::vec variances("0.85 1.45");
+
+  DiagonalGaussianDistribution d(mean, variances);
+
+  arma::mat obs(2, 5000);
+
+  for (size_t i = 0; i < 5000; i++)
+    obs.col(i) = d.Random();
+
+  // Now make sure that reflects the actual distribution.
+  arma::vec obsMean = arma::mean(obs, 1);
+  arma::vec obsVariances = arma::var(obs, 0, 1);
+
+  // 10% tolerance because this can be noisy.
+  BOOST_REQUIRE_CLOSE(obsMean[0], mean[0], 10.0);
+  BOOST_REQUIRE_CLOSE(obsMean[1], mean[1], 10.0);
+
+  BOOST_REQUIRE_CLOSE(obsVariances[0], variances[0], 10.0);
+  BOOST_REQUIRE_CLOSE(obsVariances[1], variances[1], 10.0);
+}
+
+/**
+ * Make sure that we can properly estimate a diagonal distribution from given
+ * observations, with and without per-point probabilities.
+ */
+BOOST_AUTO_TEST_CASE(DiagonalGaussianDistributionTrainTest)
+{
+  arma::vec mean("1.0 3.0 0.0 2.5");
+  arma::vec variances("3.0 2.4 6.3 9.1");
+
+  DiagonalGaussianDistribution dist(mean, variances);
+
+  // Now generate the observations.
+  arma::mat observations(4, 10000);
+  for (size_t i = 0; i < 10000; i++)
+    observations.col(i) = dist.Random();
+
+  // Find actual mean and per-dimension variances of the data.
+  arma::vec actualMean = arma::mean(observations, 1);
+  arma::vec actualVariances = arma::var(observations, 0, 1);
+
+  DiagonalGaussianDistribution d;
+  d.Train(observations);
+
+  // Check that everything is estimated right.
+  for (size_t i = 0; i < 4; i++)
+  {
+    BOOST_REQUIRE_SMALL(d.Mean()[i] - actualMean[i], 1e-5);
+    BOOST_REQUIRE_SMALL(d.Covariance()[i] - actualVariances[i], 1e-2);
+  }
+
+  // Training with all probabilities set to 1 must give the same estimate as
+  // training without probabilities.
+  DiagonalGaussianDistribution d2;
+  d2.Train(observations, arma::ones<arma::vec>(10000));
+
+  for (size_t i = 0; i < 4; i++)
+  {
+    BOOST_REQUIRE_SMALL(d2.Mean()[i] - actualMean[i], 1e-5);
+    BOOST_REQUIRE_SMALL(d2.Covariance()[i] - actualVariances[i], 1e-2);
+  }
+}
+
 /******************************/
 /** Gamma Distribution Tests **/
 /******************************/
@@ -127,6 +127,83 @@ BOOST_AUTO_TEST_CASE(DualTreeVsSingleTree)
   }
 }
 
+/**
+ * The tiled naive search must return exactly the values a pointwise scan
+ * finds, including on sets whose sizes are not multiples of the tile size.
+ */
+BOOST_AUTO_TEST_CASE(NaiveTiledSearchTest)
+{
+  arma::mat data;
+  data.randn(6, 503);
+  arma::mat queries;
+  queries.randn(6, 230);
+  GaussianKernel gk(1.5);
+
+  FastMKS<GaussianKernel> naive(data, gk, false, true);
+
+  arma::Mat<size_t> indices;
+  arma::mat products;
+  naive.Search(queries, 3, indices, products);
+
+  for (size_t q = 0; q < queries.n_cols; ++q)
+  {
+    // Compute all kernel values for this query point directly.
+    arma::vec evals(data.n_cols);
+    for (size_t r = 0; r < data.n_cols; ++r)
+      evals[r] = gk.Evaluate(queries.col(q), data.col(r));
+    arma::vec sorted = arma::sort(evals, "descend");
+
+    for (size_t r = 0; r < 3; ++r)
+    {
+      BOOST_REQUIRE_CLOSE(products(r, q), sorted[r], 1e-10);
+      BOOST_REQUIRE_CLOSE(products(r, q), evals[indices(r, q)], 1e-10);
+    }
+  }
+}
+
+/**
+ * With a nonzero epsilon, each returned kernel value may fall short of the
+ * exact one by at most epsilon.
+ */
+BOOST_AUTO_TEST_CASE(EpsilonApproximateSearchTest)
+{
+  arma::mat data;
+  data.randu(5, 1500);
+  LinearKernel lk;
+
+  // Exact results, for reference.
+  FastMKS<LinearKernel> naive(data, lk, false, true);
+
+  arma::Mat<size_t> naiveIndices;
+  arma::mat naiveProducts;
+  naive.Search(10, naiveIndices, naiveProducts);
+
+  // Single-tree and dual-tree search with slack.
+  FastMKS<LinearKernel> single(data, lk, true);
+  single.Epsilon() = 0.1;
+  BOOST_REQUIRE_EQUAL(single.Epsilon(), 0.1);
+
+  arma::Mat<size_t> singleIndices;
+  arma::mat singleProducts;
+  single.Search(10, singleIndices, singleProducts);
+
+  FastMKS<LinearKernel> dual(data, lk);
+  dual.Epsilon() = 0.1;
+
+  arma::Mat<size_t> dualIndices;
+  arma::mat dualProducts;
+  dual.Search(10, dualIndices, dualProducts);
+
+  for (size_t q = 0; q < naiveIndices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < naiveIndices.n_rows; ++r)
+    {
+      BOOST_REQUIRE_GE(singleProducts(r, q), naiveProducts(r, q) - 0.1);
+      BOOST_REQUIRE_GE(dualProducts(r, q), naiveProducts(r, q) - 0.1);
+    }
+  }
+}
+
 /**
  * Test sparse FastMKS (how useful is this, I'm not sure).
  */
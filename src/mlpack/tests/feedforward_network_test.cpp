@@ -15,6 +15,10 @@
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/fold_batch_norm.hpp>
+#include <mlpack/methods/ann/static_ffn.hpp>
+#include <mlpack/methods/ann/quantized_ffn.hpp>
+#include <mlpack/methods/ann/export_compiled_inference.hpp>
 
 #include <ensmallen.hpp>
 
@@ -451,6 +455,307 @@ BOOST_AUTO_TEST_CASE(FFNMiscTest)
   movedModel = std::move(copiedModel);
 }
 
+/**
+ * Check that the workspace arena backing the layer matrices behaves correctly
+ * when the batch size changes between passes, and that training, moving, and
+ * predicting after a trained pass all give sane results.
+ */
+BOOST_AUTO_TEST_CASE(FFNWorkspaceTest)
+{
+  arma::mat trainData = arma::randu<arma::mat>(3, 100);
+  arma::mat trainResponses = arma::randu<arma::mat>(1, 100);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(3, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 1);
+
+  // Train with a batch size that does not divide the dataset, so the last
+  // mini-batch of each epoch has a different shape than the arena was armed
+  // for.
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 300, -1);
+  model.Train(trainData, trainResponses, opt);
+
+  // Predictions with several batch sizes must all be finite and well-shaped.
+  for (size_t cols : { 1, 17, 100 })
+  {
+    arma::mat testData = arma::randu<arma::mat>(3, cols);
+    arma::mat predictions;
+    model.Predict(testData, predictions);
+
+    BOOST_REQUIRE_EQUAL(predictions.n_rows, 1);
+    BOOST_REQUIRE_EQUAL(predictions.n_cols, cols);
+    BOOST_REQUIRE(predictions.is_finite());
+  }
+
+  // A moved model must keep its (possibly arena-backed) state working.
+  auto movedModel(std::move(model));
+  arma::mat predictions;
+  movedModel.Predict(trainData, predictions);
+  BOOST_REQUIRE_EQUAL(predictions.n_cols, 100);
+  BOOST_REQUIRE(predictions.is_finite());
+}
+
+/**
+ * Check that the data-parallel gradient evaluation gives the same objective
+ * and gradient as the serial evaluation of the same mini-batch, and that
+ * training with the mode enabled still converges to finite predictions.
+ */
+BOOST_AUTO_TEST_CASE(FFNParallelTrainingTest)
+{
+  arma::mat data = arma::randu<arma::mat>(10, 64);
+  arma::mat responses = arma::randu<arma::mat>(2, 64);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(10, 16);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(16, 2);
+
+  model.Predictors() = data;
+  model.Responses() = responses;
+
+  arma::mat serialGradient, parallelGradient;
+  const double serialObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, serialGradient, 64);
+
+  model.ParallelTraining() = true;
+  const double parallelObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, parallelGradient, 64);
+
+  BOOST_REQUIRE_CLOSE(serialObjective, parallelObjective, 1e-5);
+  CheckMatrices(serialGradient, parallelGradient);
+
+  // An odd batch size must also cover every point exactly once.
+  const double parallelOdd = model.EvaluateWithGradient(model.Parameters(), 3,
+      parallelGradient, 37);
+  // Temporarily evaluate serially for the reference value.
+  model.ParallelTraining() = false;
+  const double serialOdd = model.EvaluateWithGradient(model.Parameters(), 3,
+      serialGradient, 37);
+  model.ParallelTraining() = true;
+
+  BOOST_REQUIRE_CLOSE(serialOdd, parallelOdd, 1e-5);
+  CheckMatrices(serialGradient, parallelGradient);
+
+  // End-to-end training in parallel mode must still produce sane results.
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 200, -1);
+  model.Train(data, responses, opt);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  BOOST_REQUIRE_EQUAL(predictions.n_cols, 64);
+  BOOST_REQUIRE(predictions.is_finite());
+}
+
+/**
+ * Check that a StaticFFN loaded with the weights of a trained FFN produces
+ * the same predictions as the dynamic network it came from.
+ */
+BOOST_AUTO_TEST_CASE(StaticFFNTest)
+{
+  arma::mat trainData = arma::randu<arma::mat>(5, 200);
+  arma::mat trainResponses = arma::randu<arma::mat>(2, 200);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(5, 16);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(16, 2);
+  model.Add<SigmoidLayer<>>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 200, -1);
+  model.Train(trainData, trainResponses, opt);
+
+  StaticFFN<Linear<>, SigmoidLayer<>, Linear<>, SigmoidLayer<>> staticModel(
+      Linear<>(5, 16), SigmoidLayer<>(), Linear<>(16, 2), SigmoidLayer<>());
+  staticModel.Parameters(model.Parameters());
+
+  arma::mat testData = arma::randu<arma::mat>(5, 50);
+  arma::mat predictions, staticPredictions;
+  model.Predict(testData, predictions);
+  staticModel.Predict(testData, staticPredictions);
+
+  BOOST_REQUIRE_EQUAL(staticPredictions.n_rows, predictions.n_rows);
+  BOOST_REQUIRE_EQUAL(staticPredictions.n_cols, predictions.n_cols);
+  CheckMatrices(predictions, staticPredictions);
+
+  // Loading a parameter vector of the wrong size must be rejected.
+  BOOST_REQUIRE_THROW(staticModel.Parameters(arma::mat(3, 1)),
+      std::invalid_argument);
+}
+
+/**
+ * Check that an end-to-end single-precision network built from arma::fmat
+ * layers produces predictions close to the double-precision model whose
+ * weights it was loaded with.
+ */
+BOOST_AUTO_TEST_CASE(StaticFFNFloatTest)
+{
+  arma::mat trainData = arma::randu<arma::mat>(5, 200);
+  arma::mat trainResponses = arma::randu<arma::mat>(2, 200);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(5, 16);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(16, 2);
+  model.Add<SigmoidLayer<>>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 200, -1);
+  model.Train(trainData, trainResponses, opt);
+
+  StaticFFN<Linear<arma::fmat, arma::fmat>,
+            SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>,
+            Linear<arma::fmat, arma::fmat>,
+            SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>>
+      floatModel(
+          Linear<arma::fmat, arma::fmat>(5, 16),
+          SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>(),
+          Linear<arma::fmat, arma::fmat>(16, 2),
+          SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat>());
+  floatModel.Parameters(arma::conv_to<arma::fmat>::from(model.Parameters()));
+
+  arma::mat testData = arma::randu<arma::mat>(5, 50);
+  arma::mat predictions;
+  model.Predict(testData, predictions);
+
+  arma::fmat floatPredictions;
+  floatModel.Predict(arma::conv_to<arma::fmat>::from(testData),
+      floatPredictions);
+
+  BOOST_REQUIRE_EQUAL(floatPredictions.n_rows, predictions.n_rows);
+  BOOST_REQUIRE_EQUAL(floatPredictions.n_cols, predictions.n_cols);
+  BOOST_REQUIRE_SMALL(arma::abs(arma::conv_to<arma::mat>::from(
+      floatPredictions) - predictions).max(), 1e-3);
+}
+
+/**
+ * Check that int8 quantization of a trained network produces predictions
+ * close to the floating point model, shrinks the weights to one byte per
+ * parameter, and rejects unsupported layers.
+ */
+BOOST_AUTO_TEST_CASE(QuantizedFFNTest)
+{
+  arma::mat trainData = arma::randu<arma::mat>(8, 200);
+  arma::mat trainResponses = arma::randu<arma::mat>(4, 200);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(8, 32);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(32, 4);
+  model.Add<SigmoidLayer<>>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 200, -1);
+  model.Train(trainData, trainResponses, opt);
+
+  arma::mat testData = arma::randu<arma::mat>(8, 50);
+  arma::mat predictions;
+  model.Predict(testData, predictions);
+
+  // Calibrated quantization.
+  QuantizedFFN quantized(model, trainData);
+  arma::mat quantizedPredictions;
+  quantized.Predict(testData, quantizedPredictions);
+
+  BOOST_REQUIRE_EQUAL(quantizedPredictions.n_rows, predictions.n_rows);
+  BOOST_REQUIRE_EQUAL(quantizedPredictions.n_cols, predictions.n_cols);
+  BOOST_REQUIRE_SMALL(
+      arma::abs(quantizedPredictions - predictions).max(), 0.1);
+
+  // One byte per linear weight; biases stay in floating point.
+  BOOST_REQUIRE_EQUAL(quantized.WeightBytes(), 8 * 32 + 32 * 4);
+
+  // Dynamic quantization (no calibration data) must also stay close.
+  QuantizedFFN dynamicQuantized(model);
+  dynamicQuantized.Predict(testData, quantizedPredictions);
+  BOOST_REQUIRE_SMALL(
+      arma::abs(quantizedPredictions - predictions).max(), 0.1);
+
+  // Networks with unsupported layers cannot be quantized.
+  FFN<MeanSquaredError<>> unsupportedModel;
+  unsupportedModel.Add<Linear<>>(8, 4);
+  unsupportedModel.Add<Dropout<>>();
+  unsupportedModel.ResetParameters();
+  BOOST_REQUIRE_THROW(QuantizedFFN unsupported(unsupportedModel),
+      std::invalid_argument);
+}
+
+/**
+ * Check that ExportCompiledInference() writes a self-contained inference
+ * function with the expected structure, and rejects unsupported networks.
+ */
+BOOST_AUTO_TEST_CASE(ExportCompiledInferenceTest)
+{
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(8, 16);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(16, 4);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+
+  ExportCompiledInference(model, "compiled_inference.cpp", "tiny_predict");
+
+  // Read the generated file back and check its structure: the function
+  // signature, one weight and bias array per Linear stage, and literal trip
+  // counts in the fused loops.
+  std::ifstream f("compiled_inference.cpp");
+  BOOST_REQUIRE(f.is_open());
+  std::stringstream buffer;
+  buffer << f.rdbuf();
+  const std::string code = buffer.str();
+
+  BOOST_REQUIRE_NE(code.find(
+      "void tiny_predict(const double* input, double* output)"),
+      std::string::npos);
+  BOOST_REQUIRE_NE(code.find("const double weight0[128]"), std::string::npos);
+  BOOST_REQUIRE_NE(code.find("const double bias0[16]"), std::string::npos);
+  BOOST_REQUIRE_NE(code.find("const double weight1[64]"), std::string::npos);
+  BOOST_REQUIRE_NE(code.find("rectifier"), std::string::npos);
+  BOOST_REQUIRE_NE(code.find("log-softmax"), std::string::npos);
+
+  // Networks with unsupported layers cannot be exported.
+  FFN<MeanSquaredError<>> unsupportedModel;
+  unsupportedModel.Add<Linear<>>(8, 4);
+  unsupportedModel.Add<Dropout<>>();
+  unsupportedModel.ResetParameters();
+  BOOST_REQUIRE_THROW(
+      ExportCompiledInference(unsupportedModel, "compiled_inference.cpp"),
+      std::invalid_argument);
+
+  remove("compiled_inference.cpp");
+}
+
+/**
+ * Test that folding BatchNorm layers into the preceding Linear layers does
+ * not change the deterministic forward pass.
+ */
+BOOST_AUTO_TEST_CASE(FoldBatchNormTest)
+{
+  arma::mat trainData = arma::randu<arma::mat>(8, 200);
+  arma::mat trainResponses = arma::randu<arma::mat>(4, 200);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(8, 16);
+  model.Add<BatchNorm<>>(16);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(16, 4);
+  model.Add<SigmoidLayer<>>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 200, -1);
+  model.Train(trainData, trainResponses, opt);
+
+  arma::mat testData = arma::randu<arma::mat>(8, 50);
+  arma::mat predictions;
+  model.Predict(testData, predictions);
+
+  const size_t layersBefore = model.Model().size();
+  BOOST_REQUIRE_EQUAL(FoldBatchNorm(model), 1);
+  BOOST_REQUIRE_EQUAL(model.Model().size(), layersBefore - 1);
+
+  // The folded network must compute the same deterministic forward pass.
+  arma::mat foldedPredictions;
+  model.Predict(testData, foldedPredictions);
+  CheckMatrices(predictions, foldedPredictions, 1e-8);
+}
+
 /**
  * Test that serialization works ok.
  */
@@ -13,6 +13,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/gmm/gmm.hpp>
+#include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
 #include <mlpack/methods/gmm/no_constraint.hpp>
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
@@ -78,6 +79,34 @@ BOOST_AUTO_TEST_CASE(GMMProbabilityComponentTest)
   BOOST_REQUIRE_CLOSE(gmm.Probability("1.4 0", 1), 0.0067568972024, 1e-5);
 }
 
+/**
+ * Test the batched multi-component GMM::LogProbability() against the
+ * per-observation, per-component overload.
+ */
+BOOST_AUTO_TEST_CASE(GMMLogProbabilityMatrixTest)
+{
+  // Create a GMM (same as the last test).
+  GMM gmm(2, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("0 0", "1 0; 0 1");
+  gmm.Component(1) = distribution::GaussianDistribution("3 3", "2 1; 1 2");
+  gmm.Weights() = "0.3 0.7";
+
+  arma::mat observations = arma::randu<arma::mat>(2, 50);
+
+  arma::mat logProbs;
+  gmm.LogProbability(observations, logProbs);
+
+  BOOST_REQUIRE_EQUAL(logProbs.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(logProbs.n_cols, observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(logProbs(0, i),
+        gmm.LogProbability(observations.unsafe_col(i), 0), 1e-5);
+    BOOST_REQUIRE_CLOSE(logProbs(1, i),
+        gmm.LogProbability(observations.unsafe_col(i), 1), 1e-5);
+  }
+}
+
 /**
  * Test training a model on only one Gaussian (randomly generated) in two
  * dimensions.  We will vary the dataset size from small to large.  The EM
@@ -894,4 +923,75 @@ BOOST_AUTO_TEST_CASE(DiagonalGMMTrainTest)
   }
 }
 
+/**
+ * Make sure the DiagonalGMM class can fit the same mixture of
+ * diagonal-covariance Gaussians as the full GMM with a DiagonalConstraint.
+ */
+BOOST_AUTO_TEST_CASE(DiagonalGMMClassTrainTest)
+{
+  // The same mixture as in DiagonalGMMTrainTest, but expressed with diagonal
+  // distributions directly.
+  distribution::DiagonalGaussianDistribution d1(arma::vec("0.0 1.0 0.0"),
+      arma::vec("1.0 0.8 1.0"));
+  distribution::DiagonalGaussianDistribution d2(arma::vec("2.0 -1.0 5.0"),
+      arma::vec("3.0 1.2 1.3"));
+  distribution::DiagonalGaussianDistribution d3(arma::vec("0.0 5.0 -3.0"),
+      arma::vec("2.0 0.3 1.0"));
+
+  arma::mat points(3, 5000);
+
+  for (size_t i = 0; i < 5000; i++)
+  {
+    double randValue = math::Random();
+
+    if (randValue <= 0.20) // p(d1) = 0.20
+      points.col(i) = d1.Random();
+    else if (randValue <= 0.50) // p(d2) = 0.30
+      points.col(i) = d2.Random();
+    else // p(d3) = 0.50
+      points.col(i) = d3.Random();
+  }
+
+  // Now train the model.  3 dimensions, 3 components.
+  DiagonalGMM g(3, 3);
+  g.Train(points, 5);
+
+  // Now check the results.  We need to order by weights so that when we do the
+  // checking, things will be correct.
+  arma::uvec sortedIndices = sort_index(g.Weights());
+
+  // First Gaussian (d1).
+  BOOST_REQUIRE_SMALL(g.Weights()[sortedIndices[0]] - 0.2, 0.1);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[0]).Mean()[i]
+        - d1.Mean()[i]), 0.4);
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[0]).Covariance()[i]
+        - d1.Covariance()[i]), 0.5);
+  }
+
+  // Second Gaussian (d2).
+  BOOST_REQUIRE_SMALL(g.Weights()[sortedIndices[1]] - 0.3, 0.1);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[1]).Mean()[i]
+        - d2.Mean()[i]), 0.4);
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[1]).Covariance()[i]
+        - d2.Covariance()[i]), 0.5);
+  }
+
+  // Third Gaussian (d3).
+  BOOST_REQUIRE_SMALL(g.Weights()[sortedIndices[2]] - 0.5, 0.1);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[2]).Mean()[i]
+        - d3.Mean()[i]), 0.4);
+    BOOST_REQUIRE_SMALL((g.Component(sortedIndices[2]).Covariance()[i]
+        - d3.Covariance()[i]), 0.5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
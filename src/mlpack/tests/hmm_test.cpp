@@ -106,6 +106,33 @@ BOOST_AUTO_TEST_CASE(BorodovskyHMMTestViterbi)
   BOOST_REQUIRE_EQUAL(states[8], 2);
 }
 
+/**
+ * Beam-pruned Viterbi with a sufficiently wide beam should give the same state
+ * sequence (and log-likelihood) as the exact algorithm.
+ */
+BOOST_AUTO_TEST_CASE(BeamPrunedViterbiTest)
+{
+  // Use the same umbrella model as SimpleDiscreteHMMTestViterbi.
+  arma::vec initial("1 0");
+  arma::mat transition("0.7 0.3; 0.3 0.7");
+  std::vector<DiscreteDistribution> emission(2);
+  emission[0] = DiscreteDistribution(std::vector<arma::vec>{"0.9 0.1"});
+  emission[1] = DiscreteDistribution(std::vector<arma::vec>{"0.2 0.8"});
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  arma::mat observation = "0 0 1 0 0 1 1 0 1 0 0 0 1 1 0";
+  arma::Row<size_t> exactStates, prunedStates;
+  const double exactLogLik = hmm.Predict(observation, exactStates);
+  // A beam of 50 (in log-units) is far wider than any spread in this model,
+  // so nothing can actually be pruned.
+  const double prunedLogLik = hmm.Predict(observation, prunedStates, 50.0);
+
+  BOOST_REQUIRE_CLOSE(exactLogLik, prunedLogLik, 1e-10);
+  for (size_t t = 0; t < observation.n_cols; ++t)
+    BOOST_REQUIRE_EQUAL(exactStates[t], prunedStates[t]);
+}
+
 /**
  * Ensure that the forward-backward algorithm is correct.
  */
@@ -318,6 +345,55 @@ BOOST_AUTO_TEST_CASE(SimpleBaumWelchDiscreteHMM_2)
   BOOST_REQUIRE_CLOSE(hmm.Emission()[1].Probability("3"), 0.8, 4.0);
 }
 
+/**
+ * Mini-batch (stepwise) EM on many short sequences must find the same simple
+ * model as full-batch Baum-Welch.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchBaumWelchDiscreteHMM)
+{
+  HMM<DiscreteDistribution> hmm(2, DiscreteDistribution(4));
+
+  hmm.Transition() = arma::mat("0.1 0.4; 0.9 0.6");
+  hmm.Emission()[0].Probabilities() = "0.85 0.15 0.00 0.00";
+  hmm.Emission()[1].Probabilities() = "0.00 0.00 0.50 0.50";
+
+  // Generate many short sequences from a model where the state is chosen
+  // uniformly at every step, state 0 emits 0 or 1, and state 1 emits 2 or 3.
+  std::vector<arma::mat> observations;
+  const size_t obsNum = 800;
+  const size_t obsLen = 25;
+  for (size_t i = 0; i < obsNum; i++)
+  {
+    arma::mat observation(1, obsLen);
+    for (size_t obs = 0; obs < obsLen; obs++)
+    {
+      const size_t state = (math::Random() <= 0.5) ? 0 : 1;
+      if (state == 0)
+        observation(0, obs) = (math::Random() <= 0.4) ? 0 : 1;
+      else
+        observation(0, obs) = (math::Random() <= 0.2) ? 2 : 3;
+    }
+
+    observations.push_back(observation);
+  }
+
+  hmm.TrainMiniBatch(observations, 50 /* batchSize */, 10 /* epochs */);
+
+  BOOST_REQUIRE_CLOSE(hmm.Transition()(0, 0), 0.5, 7.5);
+  BOOST_REQUIRE_CLOSE(hmm.Transition()(1, 0), 0.5, 7.5);
+  BOOST_REQUIRE_CLOSE(hmm.Transition()(0, 1), 0.5, 7.5);
+  BOOST_REQUIRE_CLOSE(hmm.Transition()(1, 1), 0.5, 7.5);
+
+  BOOST_REQUIRE_CLOSE(hmm.Emission()[0].Probability("0"), 0.4, 7.5);
+  BOOST_REQUIRE_CLOSE(hmm.Emission()[0].Probability("1"), 0.6, 7.5);
+  BOOST_REQUIRE_SMALL(hmm.Emission()[0].Probability("2"), 0.025);
+  BOOST_REQUIRE_SMALL(hmm.Emission()[0].Probability("3"), 0.025);
+  BOOST_REQUIRE_SMALL(hmm.Emission()[1].Probability("0"), 0.025);
+  BOOST_REQUIRE_SMALL(hmm.Emission()[1].Probability("1"), 0.025);
+  BOOST_REQUIRE_CLOSE(hmm.Emission()[1].Probability("2"), 0.2, 7.5);
+  BOOST_REQUIRE_CLOSE(hmm.Emission()[1].Probability("3"), 0.8, 7.5);
+}
+
 BOOST_AUTO_TEST_CASE(DiscreteHMMLabeledTrainTest)
 {
   // Generate a random Markov model with 3 hidden states and 6 observations.
@@ -506,6 +582,63 @@ BOOST_AUTO_TEST_CASE(DiscreteHMMGenerateTest)
   }
 }
 
+/**
+ * Make sure the batched Generate() overload gives the same distribution of
+ * states and emissions as the model it was drawn from.
+ */
+BOOST_AUTO_TEST_CASE(DiscreteHMMBatchGenerateTest)
+{
+  // Very simple HMM.  4 emissions with equal probability and 2 states with
+  // equal probability.
+  HMM<DiscreteDistribution> hmm(2, DiscreteDistribution(4));
+  hmm.Initial() = arma::ones<arma::vec>(2) / 2.0;
+  hmm.Transition() = arma::ones<arma::mat>(2, 2) / 2.0;
+
+  // Generate a batch of sequences.
+  const size_t length = 1000;
+  const size_t count = 250;
+  arma::cube dataSeqs;
+  arma::Mat<size_t> stateSeqs;
+
+  hmm.Generate(length, count, dataSeqs, stateSeqs);
+
+  BOOST_REQUIRE_EQUAL(dataSeqs.n_rows, 1);
+  BOOST_REQUIRE_EQUAL(dataSeqs.n_cols, length);
+  BOOST_REQUIRE_EQUAL(dataSeqs.n_slices, count);
+  BOOST_REQUIRE_EQUAL(stateSeqs.n_rows, length);
+  BOOST_REQUIRE_EQUAL(stateSeqs.n_cols, count);
+
+  // Now find the empirical probabilities of each state and emission.
+  arma::vec emissionProb(4);
+  arma::vec stateProb(2);
+  emissionProb.zeros();
+  stateProb.zeros();
+  for (size_t seq = 0; seq < count; seq++)
+  {
+    // Each sequence must start in the requested start state.
+    BOOST_REQUIRE_EQUAL(stateSeqs(0, seq), 0);
+
+    for (size_t t = 0; t < length; t++)
+    {
+      emissionProb[(size_t) dataSeqs(0, t, seq) + 0.5]++;
+      stateProb[stateSeqs(t, seq)]++;
+    }
+  }
+
+  // Normalize so these are probabilities.
+  emissionProb /= accu(emissionProb);
+  stateProb /= accu(stateProb);
+
+  // Now check that the probabilities are right.  3% tolerance.
+  BOOST_REQUIRE_CLOSE(emissionProb[0], 0.25, 3.0);
+  BOOST_REQUIRE_CLOSE(emissionProb[1], 0.25, 3.0);
+  BOOST_REQUIRE_CLOSE(emissionProb[2], 0.25, 3.0);
+  BOOST_REQUIRE_CLOSE(emissionProb[3], 0.25, 3.0);
+
+  BOOST_REQUIRE_CLOSE(stateProb[0], 0.50, 3.0);
+  BOOST_REQUIRE_CLOSE(stateProb[1], 0.50, 3.0);
+}
+
 BOOST_AUTO_TEST_CASE(DiscreteHMMLogLikelihoodTest)
 {
   // Create a simple HMM with three states and four emissions.
@@ -863,6 +863,113 @@ BOOST_AUTO_TEST_CASE(NumericHoeffdingTreeTest)
   BOOST_REQUIRE_GT(batchCorrect, 6000);
 }
 
+/**
+ * TrainBulk() should produce exactly the same sufficient statistics as calling
+ * Train() on each value in order, even when the batch straddles the binning
+ * point.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingNumericSplitTrainBulkTest)
+{
+  // 3 classes, 10 bins, 100 samples before binning.
+  HoeffdingNumericSplit<GiniImpurity> scalarSplit(3, 10, 100);
+  HoeffdingNumericSplit<GiniImpurity> bulkSplit(3, 10, 100);
+
+  arma::rowvec values(250);
+  arma::Row<size_t> labels(250);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    labels[i] = mlpack::math::RandInt(3);
+    values[i] = mlpack::math::Random() + 0.3 * labels[i];
+  }
+
+  for (size_t i = 0; i < 250; ++i)
+    scalarSplit.Train(values[i], labels[i]);
+
+  // The first chunk ends before binning happens; the second crosses it.
+  bulkSplit.TrainBulk(values.subvec(0, 59), labels.cols(0, 59));
+  bulkSplit.TrainBulk(values.subvec(60, 249), labels.cols(60, 249));
+
+  double scalarBest, scalarSecondBest, bulkBest, bulkSecondBest;
+  scalarSplit.EvaluateFitnessFunction(scalarBest, scalarSecondBest);
+  bulkSplit.EvaluateFitnessFunction(bulkBest, bulkSecondBest);
+
+  BOOST_REQUIRE_CLOSE(scalarBest, bulkBest, 1e-10);
+  BOOST_REQUIRE_SMALL(bulkSecondBest, 1e-10);
+  BOOST_REQUIRE_EQUAL(scalarSplit.MajorityClass(), bulkSplit.MajorityClass());
+  BOOST_REQUIRE_CLOSE(scalarSplit.MajorityProbability(),
+      bulkSplit.MajorityProbability(), 1e-10);
+}
+
+/**
+ * Batched streaming ingestion should build a tree just as good as
+ * point-at-a-time streaming training on the same stream.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingTreeTrainStreamingTest)
+{
+  // Generate data, as in NumericHoeffdingTreeTest.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3); // All features are numeric.
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  // Feed the stream to one tree point by point, and to another in batches of
+  // 500 points.
+  typedef HoeffdingTree<GiniImpurity, HoeffdingDoubleNumericSplit> TreeType;
+  TreeType streamTree(info, 3);
+  for (size_t i = 0; i < 9000; ++i)
+    streamTree.Train(dataset.col(i), labels[i]);
+
+  TreeType batchedTree(info, 3);
+  for (size_t start = 0; start < 9000; start += 500)
+  {
+    const arma::mat chunk = dataset.cols(start, start + 499);
+    const arma::Row<size_t> chunkLabels = labels.cols(start, start + 499);
+    batchedTree.TrainStreaming(chunk, chunkLabels);
+  }
+
+  // Both trees should have split, on the discriminative dimension.
+  BOOST_REQUIRE_GT(streamTree.NumChildren(), 0);
+  BOOST_REQUIRE_GT(batchedTree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(streamTree.SplitDimension(), 1);
+  BOOST_REQUIRE_EQUAL(batchedTree.SplitDimension(), 1);
+
+  // Now, classify all the points in the dataset.
+  arma::Row<size_t> streamLabels(9000);
+  arma::Row<size_t> batchedLabels(9000);
+  streamTree.Classify(dataset, streamLabels);
+  batchedTree.Classify(dataset, batchedLabels);
+
+  size_t streamCorrect = 0;
+  size_t batchedCorrect = 0;
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    if (labels[i] == streamLabels[i])
+      ++streamCorrect;
+    if (labels[i] == batchedLabels[i])
+      ++batchedCorrect;
+  }
+
+  // 66% accuracy shouldn't be too much to ask...
+  BOOST_REQUIRE_GT(streamCorrect, 6000);
+  BOOST_REQUIRE_GT(batchedCorrect, 6000);
+}
+
 /**
  * The same as the previous test, but with the numeric binary split, and with a
  * categorical feature.
@@ -402,4 +402,93 @@ BOOST_AUTO_TEST_CASE(HPTGradientDescentTest)
   BOOST_REQUIRE_CLOSE(zOptimized, zMin, 1e-4);
 }
 
+/**
+ * Test OptimizeSuccessiveHalving agrees with exhaustive grid search when the
+ * first rung already uses the full training set.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingFullBudgetTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  HyperParameterTuner<LARS, MSE, SimpleCV, GridSearch>
+      hpt(validationSize, xs, ys);
+
+  // With MinBudget() set to 1 all candidates are evaluated at full budget in
+  // the first rung, so the result should be the same as for grid search.
+  hpt.MinBudget() = 1.0;
+
+  double actualLambda1, actualLambda2;
+  std::tie(actualLambda1, actualLambda2) = hpt.OptimizeSuccessiveHalving(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+}
+
+/**
+ * Test OptimizeSuccessiveHalving selects a clearly better hyper-parameter when
+ * the rungs start from a small fraction of the training data.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingTest)
+{
+  // A linearly separable dataset with interleaved classes, so that any prefix
+  // of the training set remains representative of the whole dataset.
+  arma::mat xs(1, 50);
+  arma::Row<size_t> ys(50);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    xs(0, i) = (i % 2) * 10.0 + 0.01 * i;
+    ys(i) = i % 2;
+  }
+
+  // Zero should be preferred, since a huge lambda pushes the parameters of
+  // logistic regression towards zero and destroys the separation.
+  arma::vec lambdas("0 1e12");
+
+  HyperParameterTuner<LogisticRegression<>, Accuracy, SimpleCV>
+      hpt(0.5, xs, ys);
+
+  double actualLambda;
+  std::tie(actualLambda) = hpt.OptimizeSuccessiveHalving(lambdas);
+
+  BOOST_REQUIRE_CLOSE(hpt.BestObjective(), 1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(actualLambda, 0.0, 1e-5);
+}
+
+/**
+ * Test OptimizeSuccessiveHalving throws an exception when some hyper-parameter
+ * is passed as a numeric starting value rather than a collection of values.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingNumericArgTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01");
+
+  HyperParameterTuner<LARS, MSE, SimpleCV, GridSearch>
+      hpt(validationSize, xs, ys);
+
+  BOOST_REQUIRE_THROW(hpt.OptimizeSuccessiveHalving(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, 0.5), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -183,6 +183,70 @@ BOOST_AUTO_TEST_CASE(MeanImputationTest)
   BOOST_REQUIRE_CLOSE(rowWiseInput(2, 3), 8.0, 1e-5);
 }
 
+/**
+ * The batched overloads must produce the same results as imputing the same
+ * dimensions one at a time.
+ */
+BOOST_AUTO_TEST_CASE(BatchImputationTest)
+{
+  arma::mat input("3.0 0.0 2.0 0.0;"
+                  "5.0 6.0 0.0 6.0;"
+                  "9.0 8.0 4.0 0.0;");
+  arma::mat batchInput(input);
+
+  const std::vector<size_t> dimensions = { 0, 1, 2 };
+  const std::vector<double> mappedValues = { 0.0, 0.0, 0.0 };
+
+  // Mean imputation, one dimension at a time versus all at once.
+  MeanImputation<double> meanImputer;
+  for (const size_t d : dimensions)
+    meanImputer.Impute(input, 0.0, d, true);
+  meanImputer.Impute(batchInput, mappedValues, dimensions, true);
+
+  for (size_t i = 0; i < input.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(batchInput[i], input[i], 1e-10);
+
+  // Median imputation, the same way.
+  arma::mat medianInput("3.0 0.0 2.0 0.0;"
+                        "5.0 6.0 0.0 6.0;"
+                        "9.0 8.0 4.0 0.0;");
+  arma::mat medianBatchInput(medianInput);
+
+  MedianImputation<double> medianImputer;
+  for (const size_t d : dimensions)
+    medianImputer.Impute(medianInput, 0.0, d, true);
+  medianImputer.Impute(medianBatchInput, mappedValues, dimensions, true);
+
+  for (size_t i = 0; i < medianInput.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(medianBatchInput[i], medianInput[i], 1e-10);
+
+  // Listwise deletion over several dimensions at once: any point with a
+  // missing value in any checked dimension is dropped.
+  arma::mat deletionInput("3.0 0.0 2.0 1.0;"
+                          "5.0 6.0 0.0 6.0;"
+                          "9.0 8.0 4.0 8.0;");
+
+  ListwiseDeletion<double> deletionImputer;
+  deletionImputer.Impute(deletionInput, mappedValues, dimensions, true);
+
+  BOOST_REQUIRE_EQUAL(deletionInput.n_cols, 2);
+  BOOST_REQUIRE_CLOSE(deletionInput(0, 0), 3.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(deletionInput(0, 1), 1.0, 1e-5);
+
+  // Custom imputation over several dimensions at once.
+  arma::mat customInput("3.0 0.0 2.0 0.0;"
+                        "5.0 6.0 0.0 6.0;"
+                        "9.0 8.0 4.0 8.0;");
+
+  CustomImputation<double> customImputer(99.0);
+  customImputer.Impute(customInput, mappedValues, dimensions, true);
+
+  BOOST_REQUIRE_CLOSE(customInput(0, 1), 99.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(customInput(0, 3), 99.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(customInput(1, 2), 99.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(customInput(2, 0), 9.0, 1e-5);
+}
+
 /**
  * Make sure MeanImputation method replaces data 0 to median value of each
  * dimensions.
@@ -26,6 +26,7 @@
 #include <mlpack/methods/ann/init_rules/glorot_init.hpp>
 #include <mlpack/methods/ann/init_rules/he_init.hpp>
 #include <mlpack/methods/ann/init_rules/lecun_normal_init.hpp>
+#include <mlpack/methods/ann/init_rules/memory_map_init.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -380,4 +381,46 @@ BOOST_AUTO_TEST_CASE(LecunNormalInitTest)
   BOOST_REQUIRE_EQUAL(weights3d.n_slices, slices);
 }
 
+/**
+ * Test of the MemoryMapInitialization class: write a raw weight file, alias
+ * a weight matrix over it and make sure the pretrained values come through,
+ * that writes do not modify the file, and that the element offset works.
+ */
+BOOST_AUTO_TEST_CASE(MemoryMapInitTest)
+{
+  const size_t rows = 10;
+  const size_t cols = 5;
+
+  // Write a raw weight file with known values.
+  arma::vec values = arma::linspace<arma::vec>(1, rows * cols, rows * cols);
+  std::ofstream stream("mmap_init_test.bin", std::ios::binary);
+  stream.write((const char*) values.memptr(), values.n_elem * sizeof(double));
+  stream.close();
+
+  arma::mat weights;
+  MemoryMapInitialization init("mmap_init_test.bin");
+  init.Initialize(weights, rows, cols);
+
+  BOOST_REQUIRE_EQUAL(weights.n_rows, rows);
+  BOOST_REQUIRE_EQUAL(weights.n_cols, cols);
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(weights[i], (double) (i + 1), 1e-10);
+
+  // Writes must be copy-on-write: the file itself may not change.
+  weights[0] = -1.0;
+  arma::mat weights2;
+  MemoryMapInitialization init2("mmap_init_test.bin");
+  init2.Initialize(weights2, rows, cols);
+  BOOST_REQUIRE_CLOSE(weights2[0], 1.0, 1e-10);
+
+  // An element offset skips the start of the file.
+  arma::mat offsetWeights;
+  MemoryMapInitialization offsetInit("mmap_init_test.bin", rows);
+  offsetInit.Initialize(offsetWeights, rows, cols - 1);
+  for (size_t i = 0; i < offsetWeights.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(offsetWeights[i], (double) (rows + i + 1), 1e-10);
+
+  remove("mmap_init_test.bin");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
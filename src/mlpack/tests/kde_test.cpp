@@ -167,6 +167,45 @@ BOOST_AUTO_TEST_CASE(GaussianKDEBruteForceTest)
 /**
  * Test single-tree implementation results against brute force results.
  */
+/**
+ * Test multi-bandwidth dual-tree evaluation: one shared traversal over
+ * several bandwidths must match a brute-force computation per bandwidth.
+ */
+BOOST_AUTO_TEST_CASE(GaussianKDEMultiBandwidthTest)
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 60);
+  const arma::vec bandwidths("0.1 0.3 0.5 1.0");
+  const double relError = 0.01;
+
+  // Multi-bandwidth KDE; one traversal shared by all the bandwidths.
+  metric::EuclideanDistance metric;
+  GaussianKernel kernel(1.0);
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+
+  arma::mat estimations;
+  kde.Evaluate(query, bandwidths, estimations);
+
+  BOOST_REQUIRE_EQUAL(estimations.n_rows, query.n_cols);
+  BOOST_REQUIRE_EQUAL(estimations.n_cols, bandwidths.n_elem);
+
+  // Check each bandwidth against a brute-force computation.
+  for (size_t b = 0; b < bandwidths.n_elem; ++b)
+  {
+    arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    GaussianKernel bfKernel(bandwidths[b]);
+    BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, bfKernel);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+      BOOST_REQUIRE_CLOSE(bfEstimations[i], estimations(i, b), relError*100);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(GaussianSingleKDEBruteForceTest)
 {
   arma::mat reference = arma::randu(2, 300);
@@ -20,6 +20,7 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/gram_matrix.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -209,6 +210,72 @@ BOOST_AUTO_TEST_CASE(MDFullCovarianceTest)
   BOOST_REQUIRE_CLOSE(md.Evaluate(b, a), 15.7, 1e-5);
 }
 
+/**
+ * The factorized evaluation must give the same distances as the dense
+ * quadratic form.
+ */
+BOOST_AUTO_TEST_CASE(MDFactorizedEvaluateTest)
+{
+  // Build a random symmetric positive definite covariance.
+  arma::mat x = arma::randu<arma::mat>(5, 20);
+  arma::mat cov = x * x.t() + 0.5 * arma::eye<arma::mat>(5, 5);
+
+  MahalanobisDistance<false> md(cov);
+  MahalanobisDistance<true> mdRoot(cov);
+  MahalanobisDistance<false> mdFactorized(cov);
+  MahalanobisDistance<true> mdRootFactorized(cov);
+  mdFactorized.Factorize();
+  mdRootFactorized.Factorize();
+
+  BOOST_REQUIRE(!md.Factorized());
+  BOOST_REQUIRE(mdFactorized.Factorized());
+
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    arma::vec a = arma::randn<arma::vec>(5);
+    arma::vec b = arma::randn<arma::vec>(5);
+
+    BOOST_REQUIRE_CLOSE(md.Evaluate(a, b), mdFactorized.Evaluate(a, b),
+        1e-5);
+    BOOST_REQUIRE_CLOSE(mdRoot.Evaluate(a, b),
+        mdRootFactorized.Evaluate(a, b), 1e-5);
+  }
+
+  // Modifying the covariance must invalidate the factorization.
+  mdFactorized.Covariance() = arma::eye<arma::mat>(5, 5);
+  BOOST_REQUIRE(!mdFactorized.Factorized());
+}
+
+/**
+ * Euclidean distances between transformed points must equal Mahalanobis
+ * distances between the original points.
+ */
+BOOST_AUTO_TEST_CASE(MDTransformTest)
+{
+  arma::mat x = arma::randu<arma::mat>(4, 15);
+  arma::mat cov = x * x.t() + 0.5 * arma::eye<arma::mat>(4, 4);
+
+  MahalanobisDistance<true> md(cov);
+
+  arma::mat points = arma::randn<arma::mat>(4, 30);
+  arma::mat transformed;
+  md.Transform(points, transformed);
+
+  BOOST_REQUIRE_EQUAL(transformed.n_rows, points.n_rows);
+  BOOST_REQUIRE_EQUAL(transformed.n_cols, points.n_cols);
+
+  EuclideanDistance e;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    const arma::vec a = points.col(i);
+    const arma::vec b = points.col(points.n_cols - 1 - i);
+
+    BOOST_REQUIRE_CLOSE(md.Evaluate(a, b),
+        e.Evaluate(transformed.col(i),
+                   transformed.col(points.n_cols - 1 - i)), 1e-5);
+  }
+}
+
 /**
  * Simple test case for the cosine distance.
  */
@@ -426,130 +493,130 @@ BOOST_AUTO_TEST_CASE(PSpectrumSubstringExtractionTest)
   BOOST_REQUIRE_EQUAL(p.Counts()[1].size(), 7);
 
   // herpgle: her, erp, rpg, pgl, gle
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0].size(), 5);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0]["her"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0]["erp"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0]["rpg"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0]["pgl"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][0]["gle"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[0][0].n_elem, 5);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 0, "her"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 0, "erp"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 0, "rpg"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 0, "pgl"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 0, "gle"), 1);
 
   // herpagkle: her, erp, rpa, pag, agk, gkl, kle
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1].size(), 7);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["her"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["erp"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["rpa"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["pag"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["agk"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["gkl"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][1]["kle"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[0][1].n_elem, 7);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "her"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "erp"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "rpa"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "pag"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "agk"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "gkl"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 1, "kle"), 1);
 
   // klunktor: klu, lun, unk, nkt, kto, tor
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2].size(), 6);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["klu"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["lun"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["unk"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["nkt"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["kto"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][2]["tor"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[0][2].n_elem, 6);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "klu"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "lun"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "unk"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "nkt"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "kto"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 2, "tor"), 1);
 
   // flibbynopple: fli lib ibb bby byn yno nop opp ppl ple
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3].size(), 10);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["fli"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["lib"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["ibb"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["bby"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["byn"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["yno"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["nop"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["opp"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["ppl"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[0][3]["ple"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[0][3].n_elem, 10);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "fli"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "lib"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "ibb"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "bby"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "byn"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "yno"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "nop"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "opp"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "ppl"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(0, 3, "ple"), 1);
 
   // floggy3245: flo log ogg ggy gy3 y32 324 245
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0].size(), 8);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["flo"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["log"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["ogg"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["ggy"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["gy3"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["y32"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["324"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][0]["245"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][0].n_elem, 8);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "flo"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "log"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "ogg"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "ggy"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "gy3"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "y32"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "324"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 0, "245"), 1);
 
   // flippydopflip: fli lip ipp ppy pyd ydo dop opf pfl fli lip
   // fli(2) lip(2) ipp ppy pyd ydo dop opf pfl
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1].size(), 9);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["fli"], 2);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["lip"], 2);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["ipp"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["ppy"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["pyd"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["ydo"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["dop"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["opf"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][1]["pfl"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][1].n_elem, 9);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "fli"), 2);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "lip"), 2);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "ipp"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "ppy"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "pyd"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "ydo"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "dop"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "opf"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 1, "pfl"), 1);
 
   // stupid fricking cat: stu tup upi pid fri ric ick cki kin ing cat
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2].size(), 11);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["stu"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["tup"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["upi"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["pid"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["fri"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["ric"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["ick"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["cki"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["kin"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["ing"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][2]["cat"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][2].n_elem, 11);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "stu"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "tup"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "upi"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "pid"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "fri"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "ric"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "ick"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "cki"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "kin"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "ing"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 2, "cat"), 1);
 
   // food time isn't until later: foo ood tim ime isn unt nti til lat ate ter
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3].size(), 11);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["foo"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["ood"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["tim"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["ime"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["isn"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["unt"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["nti"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["til"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["lat"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["ate"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][3]["ter"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][3].n_elem, 11);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "foo"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "ood"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "tim"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "ime"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "isn"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "unt"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "nti"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "til"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "lat"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "ate"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 3, "ter"), 1);
 
   // leave me alone until 6:00: lea eav ave alo lon one unt nti til
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4].size(), 9);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["lea"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["eav"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["ave"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["alo"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["lon"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["one"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["unt"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["nti"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][4]["til"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][4].n_elem, 9);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "lea"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "eav"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "ave"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "alo"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "lon"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "one"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "unt"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "nti"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 4, "til"), 1);
 
   // only after that do you get any food.:
   // onl nly aft fte ter tha hat you get any foo ood
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5].size(), 12);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["onl"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["nly"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["aft"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["fte"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["ter"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["tha"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["hat"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["you"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["get"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["any"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["foo"], 1);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][5]["ood"], 1);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][5].n_elem, 12);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "onl"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "nly"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "aft"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "fte"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "ter"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "tha"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "hat"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "you"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "get"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "any"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "foo"), 1);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 5, "ood"), 1);
 
   // obloblobloblobloblobloblob: obl(8) blo(8) lob(8)
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][6].size(), 3);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][6]["obl"], 8);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][6]["blo"], 8);
-  BOOST_REQUIRE_EQUAL(p.Counts()[1][6]["lob"], 8);
+  BOOST_REQUIRE_EQUAL(p.Counts()[1][6].n_elem, 3);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 6, "obl"), 8);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 6, "blo"), 8);
+  BOOST_REQUIRE_EQUAL(p.Count(1, 6, "lob"), 8);
 }
 
 BOOST_AUTO_TEST_CASE(PSpectrumStringEvaluateTest)
@@ -609,6 +676,46 @@ BOOST_AUTO_TEST_CASE(PSpectrumStringEvaluateTest)
   BOOST_REQUIRE_CLOSE(p.Evaluate(b, a), 11.0, 1e-5);
 }
 
+/**
+ * Ensure that a serialized p-spectrum kernel carries its p-gram index, so a
+ * loaded kernel can evaluate without recounting.
+ */
+BOOST_AUTO_TEST_CASE(PSpectrumStringSerializationTest)
+{
+  // Same simple dataset as the evaluation test.
+  std::vector<std::vector<std::string> > dataset;
+  dataset.push_back(std::vector<std::string>());
+  dataset[0].push_back("hello");
+  dataset[0].push_back("jello");
+  dataset[0].push_back("mellow");
+  dataset[0].push_back("mellow jello");
+
+  PSpectrumStringKernel p(dataset, 3);
+  PSpectrumStringKernel xmlP, textP, binaryP;
+
+  SerializeObjectAll(p, xmlP, textP, binaryP);
+
+  BOOST_REQUIRE_EQUAL(xmlP.P(), 3);
+  BOOST_REQUIRE_EQUAL(textP.P(), 3);
+  BOOST_REQUIRE_EQUAL(binaryP.P(), 3);
+
+  // The loaded kernels never saw the strings, but must evaluate identically.
+  for (size_t i = 0; i < 4; ++i)
+  {
+    for (size_t j = 0; j < 4; ++j)
+    {
+      arma::vec a("0 0"), b("0 0");
+      a[1] = i;
+      b[1] = j;
+
+      const double eval = p.Evaluate(a, b);
+      BOOST_REQUIRE_CLOSE(xmlP.Evaluate(a, b), eval, 1e-5);
+      BOOST_REQUIRE_CLOSE(textP.Evaluate(a, b), eval, 1e-5);
+      BOOST_REQUIRE_CLOSE(binaryP.Evaluate(a, b), eval, 1e-5);
+    }
+  }
+}
+
 /**
  * Cauchy Kernel test.
  */
@@ -622,4 +729,46 @@ BOOST_AUTO_TEST_CASE(CauchyKernelTest)
   BOOST_REQUIRE_CLOSE(ck.Evaluate(b, a), 0.92592588, 1e-5);
 }
 
+//! Compare a blocked Gram matrix against pairwise kernel evaluations.
+template<typename KernelType>
+void CheckGramMatrix(KernelType kernel)
+{
+  arma::mat a = arma::randu<arma::mat>(5, 150);
+  arma::mat b = arma::randu<arma::mat>(5, 90);
+
+  // Rectangular case.
+  arma::mat gram;
+  GramMatrix<KernelType>::Compute(a, b, gram, kernel);
+
+  BOOST_REQUIRE_EQUAL(gram.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(gram.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_CLOSE(gram(i, j), kernel.Evaluate(a.col(i), b.col(j)),
+          1e-10);
+
+  // Symmetric case.
+  GramMatrix<KernelType>::Compute(a, gram, kernel);
+
+  BOOST_REQUIRE_EQUAL(gram.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(gram.n_cols, a.n_cols);
+  for (size_t j = 0; j < a.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_CLOSE(gram(i, j), kernel.Evaluate(a.col(i), a.col(j)),
+          1e-10);
+}
+
+/**
+ * Make sure the blocked Gram matrix builder matches pairwise evaluation for
+ * the GEMM-based specializations and for a kernel that takes the generic
+ * blocked path.
+ */
+BOOST_AUTO_TEST_CASE(GramMatrixTest)
+{
+  CheckGramMatrix(LinearKernel());
+  CheckGramMatrix(PolynomialKernel(3.0, 1.5));
+  CheckGramMatrix(GaussianKernel(0.75));
+  CheckGramMatrix(LaplacianKernel(1.2));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
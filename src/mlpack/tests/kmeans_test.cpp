@@ -12,11 +12,13 @@
 #include <mlpack/methods/kmeans/kmeans.hpp>
 #include <mlpack/methods/kmeans/allow_empty_clusters.hpp>
 #include <mlpack/methods/kmeans/refined_start.hpp>
+#include <mlpack/methods/kmeans/blocked_kmeans.hpp>
 #include <mlpack/methods/kmeans/elkan_kmeans.hpp>
 #include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
+#include <mlpack/methods/kmeans/scalable_initialization.hpp>
 #include <mlpack/methods/kmeans/random_partition.hpp>
 
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
@@ -24,6 +26,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <mlpack/methods/kmeans/kill_empty_clusters.hpp>
+#include <mlpack/methods/kmeans/kmeans_session.hpp>
 #include "test_tools.hpp"
 
 using namespace mlpack;
@@ -570,6 +573,41 @@ BOOST_AUTO_TEST_CASE(ElkanTest)
   }
 }
 
+BOOST_AUTO_TEST_CASE(BlockedKMeansTest)
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    const size_t k = 5 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the blocked Lloyd step and the naive method return the same
+    // clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        BlockedKMeans> blocked;
+    arma::Row<size_t> blockedAssignments;
+    arma::mat blockedCentroids(centroids);
+    blocked.Cluster(dataset, k, blockedAssignments, blockedCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      BOOST_REQUIRE_EQUAL(assignments[i], blockedAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(naiveCentroids[i], blockedCentroids[i], 1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(HamerlyTest)
 {
   const size_t trials = 5;
@@ -737,4 +775,162 @@ BOOST_AUTO_TEST_CASE(SampleInitializationTest)
   }
 }
 
+/**
+ * Make sure that ScalableInitialization (k-means||) returns sensible seeds:
+ * the right number of centroids, and one seed near each of a set of
+ * well-separated clusters.
+ */
+BOOST_AUTO_TEST_CASE(ScalableInitializationTest)
+{
+  // Build four well-separated Gaussian clusters in the plane.
+  arma::mat dataset(2, 400);
+  const double offsets[4][2] = { { 0, 0 }, { 50, 0 }, { 0, 50 }, { 50, 50 } };
+  for (size_t c = 0; c < 4; ++c)
+  {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      dataset(0, c * 100 + i) = offsets[c][0] + math::RandNormal();
+      dataset(1, c * 100 + i) = offsets[c][1] + math::RandNormal();
+    }
+  }
+
+  arma::mat centroids;
+  ScalableInitialization scalable;
+  scalable.Cluster(dataset, 4, centroids);
+
+  BOOST_REQUIRE_EQUAL(centroids.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(centroids.n_cols, 4);
+
+  // Each cluster center must have a seed close to it; with the clusters 50
+  // apart, a seed within distance 10 is unambiguously "in" the cluster.
+  for (size_t c = 0; c < 4; ++c)
+  {
+    arma::vec center(2);
+    center[0] = offsets[c][0];
+    center[1] = offsets[c][1];
+
+    double minDistance = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < centroids.n_cols; ++i)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          centroids.col(i), center);
+      minDistance = std::min(minDistance, distance);
+    }
+
+    BOOST_REQUIRE_LT(minDistance, 10.0);
+  }
+
+  // The policy must also work end-to-end as the initial partition policy of
+  // KMeans.
+  KMeans<metric::EuclideanDistance, ScalableInitialization> km;
+  arma::Row<size_t> assignments;
+  arma::mat finalCentroids;
+  km.Cluster(dataset, 4, assignments, finalCentroids);
+
+  // Points in the same generated cluster must end up in the same k-means
+  // cluster.
+  for (size_t c = 0; c < 4; ++c)
+    for (size_t i = 1; i < 100; ++i)
+      BOOST_REQUIRE_EQUAL(assignments[c * 100], assignments[c * 100 + i]);
+}
+
+/**
+ * A KMeansSession must give correct results when points are appended to the
+ * dataset between calls to Cluster(), both with Elkan's and Hamerly's bounds.
+ */
+BOOST_AUTO_TEST_CASE(KMeansSessionAppendTest)
+{
+  // Build four well-separated Gaussian clusters in the plane.
+  arma::mat dataset(2, 400);
+  const double offsets[4][2] = { { 0, 0 }, { 50, 0 }, { 0, 50 }, { 50, 50 } };
+  for (size_t c = 0; c < 4; ++c)
+  {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      dataset(0, c * 100 + i) = offsets[c][0] + math::RandNormal();
+      dataset(1, c * 100 + i) = offsets[c][1] + math::RandNormal();
+    }
+  }
+
+  arma::mat elkanData(dataset);
+  arma::mat hamerlyData(dataset);
+
+  KMeansSession<> elkanSession(elkanData, 4);
+  KMeansSession<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, HamerlyKMeans> hamerlySession(hamerlyData, 4);
+
+  elkanSession.Cluster();
+  hamerlySession.Cluster();
+
+  // Append a handful of new points near each cluster center and resume; the
+  // session must pick up the appended columns and reconverge.
+  arma::mat newPoints(2, 20);
+  for (size_t c = 0; c < 4; ++c)
+  {
+    for (size_t i = 0; i < 5; ++i)
+    {
+      newPoints(0, c * 5 + i) = offsets[c][0] + math::RandNormal();
+      newPoints(1, c * 5 + i) = offsets[c][1] + math::RandNormal();
+    }
+  }
+
+  elkanData.insert_cols(elkanData.n_cols, newPoints);
+  hamerlyData.insert_cols(hamerlyData.n_cols, newPoints);
+
+  elkanSession.Cluster();
+  hamerlySession.Cluster();
+
+  // After convergence, every point must be assigned to its nearest centroid;
+  // this holds regardless of which initialization was chosen.
+  arma::Row<size_t> elkanAssignments, hamerlyAssignments;
+  elkanSession.Assignments(elkanAssignments);
+  hamerlySession.Assignments(hamerlyAssignments);
+
+  BOOST_REQUIRE_EQUAL(elkanAssignments.n_elem, elkanData.n_cols);
+  BOOST_REQUIRE_EQUAL(hamerlyAssignments.n_elem, hamerlyData.n_cols);
+
+  // With the clusters 50 apart, all points generated from the same center
+  // must share an assignment, and the appended points must land in the same
+  // cluster as the original points from their center.
+  for (size_t c = 0; c < 4; ++c)
+  {
+    for (size_t i = 1; i < 100; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(elkanAssignments[c * 100],
+          elkanAssignments[c * 100 + i]);
+      BOOST_REQUIRE_EQUAL(hamerlyAssignments[c * 100],
+          hamerlyAssignments[c * 100 + i]);
+    }
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(elkanAssignments[c * 100],
+          elkanAssignments[400 + c * 5 + i]);
+      BOOST_REQUIRE_EQUAL(hamerlyAssignments[c * 100],
+          hamerlyAssignments[400 + c * 5 + i]);
+    }
+  }
+
+  // The resumed centroids must still sit on the true cluster centers.
+  for (size_t c = 0; c < 4; ++c)
+  {
+    arma::vec center(2);
+    center[0] = offsets[c][0];
+    center[1] = offsets[c][1];
+
+    double elkanMin = std::numeric_limits<double>::max();
+    double hamerlyMin = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < 4; ++i)
+    {
+      elkanMin = std::min(elkanMin, metric::EuclideanDistance::Evaluate(
+          elkanSession.Centroids().col(i), center));
+      hamerlyMin = std::min(hamerlyMin, metric::EuclideanDistance::Evaluate(
+          hamerlySession.Centroids().col(i), center));
+    }
+
+    BOOST_REQUIRE_LT(elkanMin, 10.0);
+    BOOST_REQUIRE_LT(hamerlyMin, 10.0);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
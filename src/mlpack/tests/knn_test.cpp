@@ -12,6 +12,7 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/partitioned_neighbor_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include <boost/test/unit_test.hpp>
@@ -719,6 +720,47 @@ BOOST_AUTO_TEST_CASE(DualTreeVsNaive2)
   }
 }
 
+/**
+ * Test that a warm-started monochromatic search gives the same results as a
+ * cold search when the reference points have not moved: with any non-negative
+ * slack, the loosened bounds of the previous traversal are still valid.
+ */
+BOOST_AUTO_TEST_CASE(WarmStartMonochromaticTest)
+{
+  arma::mat dataset;
+
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    BOOST_FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  KNN knn(dataset);
+
+  arma::Mat<size_t> coldNeighbors;
+  arma::mat coldDistances;
+  knn.Search(15, coldNeighbors, coldDistances);
+
+  // Re-run the same search warm-started from the previous bounds.
+  knn.WarmStartSlack() = 0.05;
+  arma::Mat<size_t> warmNeighbors;
+  arma::mat warmDistances;
+  knn.Search(15, warmNeighbors, warmDistances);
+
+  for (size_t i = 0; i < coldNeighbors.n_elem; i++)
+  {
+    BOOST_REQUIRE_EQUAL(warmNeighbors[i], coldNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(warmDistances[i], coldDistances[i], 1e-5);
+  }
+
+  // Disabling warm-starting again must also give the exact results.
+  knn.WarmStartSlack() = -1.0;
+  knn.Search(15, warmNeighbors, warmDistances);
+
+  for (size_t i = 0; i < coldNeighbors.n_elem; i++)
+  {
+    BOOST_REQUIRE_EQUAL(warmNeighbors[i], coldNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(warmDistances[i], coldDistances[i], 1e-5);
+  }
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.  This
  * uses only a reference dataset.
@@ -788,6 +830,43 @@ BOOST_AUTO_TEST_CASE(SingleCoverTreeTest)
   }
 }
 
+/**
+ * Test the cover tree single-tree method with a separate query set large
+ * enough to take the parallel block path, against the naive method.  This is
+ * a regression test for the per-node base case cache: it used to live in the
+ * shared reference tree, where concurrent query blocks could overwrite each
+ * other's values and corrupt the pruning bound.
+ */
+BOOST_AUTO_TEST_CASE(SingleCoverTreeParallelTest)
+{
+  arma::mat data;
+  data.randu(10, 1000); // 10 dimensional, 1000 points.
+  arma::mat queries;
+  queries.randu(10, 500); // 10 dimensional, 500 points.
+
+  StandardCoverTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> tree(data);
+
+  NeighborSearch<NearestNeighborSort, LMetric<2>, arma::mat, StandardCoverTree>
+      coverTreeSearch(std::move(tree), SINGLE_TREE_MODE);
+
+  KNN naive(data, NAIVE_MODE);
+
+  arma::Mat<size_t> coverTreeNeighbors;
+  arma::mat coverTreeDistances;
+  coverTreeSearch.Search(queries, 5, coverTreeNeighbors, coverTreeDistances);
+
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < coverTreeNeighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(coverTreeNeighbors[i], naiveNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(coverTreeDistances[i], naiveDistances[i], 1e-5);
+  }
+}
+
 /**
  * Test the cover tree dual-tree nearest neighbors method against the naive
  * method.
@@ -1059,6 +1138,105 @@ BOOST_AUTO_TEST_CASE(SparseKNNCoverTreeTest)
 }
 */
 
+/**
+ * Test that a single-precision index (FloatKNN) trained and queried with
+ * double-precision data gives results that agree with the exact
+ * double-precision search.
+ */
+BOOST_AUTO_TEST_CASE(FloatKNNTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 500);
+  arma::mat queryData = arma::randu<arma::mat>(10, 200);
+
+  // Train() and Search() convert the double-precision data to the precision
+  // of the index.
+  FloatKNN a;
+  a.Train(referenceData);
+  KNN exact(referenceData);
+
+  arma::mat floatDistances;
+  arma::Mat<size_t> floatNeighbors;
+  a.Search(queryData, 5, floatNeighbors, floatDistances);
+
+  arma::mat exactDistances;
+  arma::Mat<size_t> exactNeighbors;
+  exact.Search(queryData, 5, exactNeighbors, exactDistances);
+
+  // Single-precision storage can flip the order of near-tied neighbors, so
+  // compare the distances only, at single-precision tolerance.
+  for (size_t i = 0; i < exactNeighbors.n_cols; ++i)
+    for (size_t j = 0; j < exactNeighbors.n_rows; ++j)
+      BOOST_REQUIRE_CLOSE(floatDistances(j, i), exactDistances(j, i), 1e-2);
+}
+
+/**
+ * Test that the early-abandoning base case used for high-dimensional data
+ * (where the distance computation is checked against the candidate bound
+ * between chunks of dimensions) returns exact results.
+ */
+BOOST_AUTO_TEST_CASE(HighDimensionalEarlyAbandonTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(100, 400);
+  arma::mat queryData = arma::randu<arma::mat>(100, 150);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 7, neighbors, distances);
+
+  // Compare against brute-force computation of each query's neighbors.
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    arma::vec trueDistances(referenceData.n_cols);
+    for (size_t j = 0; j < referenceData.n_cols; ++j)
+    {
+      trueDistances[j] = EuclideanDistance::Evaluate(queryData.col(i),
+          referenceData.col(j));
+    }
+
+    arma::uvec order = arma::sort_index(trueDistances);
+    for (size_t j = 0; j < 7; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(neighbors(j, i), order[j]);
+      BOOST_REQUIRE_CLOSE(distances(j, i), trueDistances[order[j]], 1e-5);
+    }
+  }
+}
+
+/**
+ * The candidate heap should return correctly ordered results for large k too,
+ * where many candidate replacements happen per query point.
+ */
+BOOST_AUTO_TEST_CASE(LargeKCandidateHeapTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 600);
+  arma::mat queryData = arma::randu<arma::mat>(10, 60);
+  const size_t k = 128;
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, k, neighbors, distances);
+
+  // Compare against brute-force computation of each query's neighbors.
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    arma::vec trueDistances(referenceData.n_cols);
+    for (size_t j = 0; j < referenceData.n_cols; ++j)
+    {
+      trueDistances[j] = EuclideanDistance::Evaluate(queryData.col(i),
+          referenceData.col(j));
+    }
+
+    arma::uvec order = arma::sort_index(trueDistances);
+    for (size_t j = 0; j < k; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(neighbors(j, i), order[j]);
+      BOOST_REQUIRE_CLOSE(distances(j, i), trueDistances[order[j]], 1e-5);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(KNNModelTest)
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1143,6 +1321,59 @@ BOOST_AUTO_TEST_CASE(KNNModelTest)
   }
 }
 
+BOOST_AUTO_TEST_CASE(KNNModelAutoTuneTest)
+{
+  // Ensure that AutoTune() selects a configuration from the candidate grid
+  // and that the model built afterwards still gives correct results.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(10, 500);
+
+  // Get a baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  KNNModel model;
+  model.AutoTune(referenceData, 3, DUAL_TREE_MODE, 0, 100, 25);
+
+  // The winning leaf size must come from the candidate grid.
+  const size_t ls = model.LeafSize();
+  BOOST_REQUIRE(ls == 8 || ls == 16 || ls == 32 || ls == 64 || ls == 128);
+
+  // Build the full model with the winning configuration and check the
+  // results against the baseline.
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), model.LeafSize(),
+      DUAL_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, baselineNeighbors.n_rows);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, baselineNeighbors.n_cols);
+  for (size_t k = 0; k < distances.n_elem; ++k)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[k], baselineNeighbors[k]);
+    if (std::abs(baselineDistances[k]) < 1e-5)
+      BOOST_REQUIRE_SMALL(distances[k], 1e-5);
+    else
+      BOOST_REQUIRE_CLOSE(distances[k], baselineDistances[k], 1e-5);
+  }
+
+  // In naive mode tuning is a no-op: the configuration must not change.
+  KNNModel naiveModel;
+  const size_t oldLeafSize = naiveModel.LeafSize();
+  const KNNModel::TreeTypes oldTreeType = naiveModel.TreeType();
+  naiveModel.AutoTune(referenceData, 3, NAIVE_MODE, 0, 100, 25);
+  BOOST_REQUIRE_EQUAL(naiveModel.LeafSize(), oldLeafSize);
+  BOOST_REQUIRE_EQUAL(naiveModel.TreeType(), oldTreeType);
+}
+
 BOOST_AUTO_TEST_CASE(KNNModelMonochromaticTest)
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1466,4 +1697,71 @@ BOOST_AUTO_TEST_CASE(GreedyTreeSearch)
       0);
 }
 
+/**
+ * Test that PartitionedNeighborSearch gives the same results as a single
+ * NeighborSearch over the whole reference set.
+ */
+BOOST_AUTO_TEST_CASE(PartitionedSearchTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 300);
+  arma::mat querySet = arma::randu<arma::mat>(8, 50);
+
+  KNN exhaustive(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  exhaustive.Search(querySet, 5, neighbors, distances);
+
+  // Use more partitions than the pool has threads, to exercise the merge.
+  PartitionedNeighborSearch<> partitioned(referenceSet, 7);
+  BOOST_REQUIRE_EQUAL(partitioned.Partitions(), 7);
+
+  arma::Mat<size_t> partNeighbors;
+  arma::mat partDistances;
+  partitioned.Search(querySet, 5, partNeighbors, partDistances);
+
+  BOOST_REQUIRE_EQUAL(partNeighbors.n_rows, neighbors.n_rows);
+  BOOST_REQUIRE_EQUAL(partNeighbors.n_cols, neighbors.n_cols);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(partNeighbors[i], neighbors[i]);
+    BOOST_REQUIRE_CLOSE(partDistances[i], distances[i], 1e-10);
+  }
+}
+
+/**
+ * Test that a partition smaller than k still contributes all of its points,
+ * and that the partition count is clamped to the number of points.
+ */
+BOOST_AUTO_TEST_CASE(PartitionedSearchSmallPartitionTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 10);
+  arma::mat querySet = arma::randu<arma::mat>(5, 8);
+
+  // Ten points over ten partitions: every partition holds one point, which
+  // is fewer than k.
+  PartitionedNeighborSearch<> partitioned(referenceSet, 64);
+  BOOST_REQUIRE_EQUAL(partitioned.Partitions(), 10);
+
+  KNN exhaustive(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  exhaustive.Search(querySet, 4, neighbors, distances);
+
+  arma::Mat<size_t> partNeighbors;
+  arma::mat partDistances;
+  partitioned.Search(querySet, 4, partNeighbors, partDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(partNeighbors[i], neighbors[i]);
+    BOOST_REQUIRE_CLOSE(partDistances[i], distances[i], 1e-10);
+  }
+
+  // Asking for more neighbors than there are reference points must fail,
+  // just as with NeighborSearch.
+  BOOST_REQUIRE_THROW(
+      partitioned.Search(querySet, 11, partNeighbors, partDistances),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
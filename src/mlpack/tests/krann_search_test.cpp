@@ -29,6 +29,20 @@ using namespace mlpack::bound;
 
 BOOST_AUTO_TEST_SUITE(KRANNTest);
 
+// The cached minimum-sample-size computation must return the same value on
+// repeated calls with the same configuration, and still distinguish between
+// configurations.
+BOOST_AUTO_TEST_CASE(MinimumSamplesReqdCacheTest)
+{
+  const size_t first = RAUtil::MinimumSamplesReqd(1000, 5, 5.0, 0.95);
+  BOOST_REQUIRE_EQUAL(RAUtil::MinimumSamplesReqd(1000, 5, 5.0, 0.95), first);
+
+  const size_t stricter = RAUtil::MinimumSamplesReqd(1000, 5, 1.0, 0.95);
+  BOOST_REQUIRE_GT(stricter, first);
+  BOOST_REQUIRE_EQUAL(RAUtil::MinimumSamplesReqd(1000, 5, 1.0, 0.95),
+      stricter);
+}
+
 // Test the correctness and guarantees of KRANN when in naive mode.
 BOOST_AUTO_TEST_CASE(NaiveGuaranteeTest)
 {
@@ -352,4 +352,38 @@ BOOST_AUTO_TEST_CASE(TrainingConstructorWithNonDefaultsTest)
     BOOST_REQUIRE_CLOSE(beta[i], lars2.Beta()[i], 1e-5);
 }
 
+/**
+ * Make sure that many solves against a shared precomputed Gram matrix, reusing
+ * one LARS object (the sparse coding access pattern), give the same solutions
+ * as fresh LARS objects; this exercises reuse of the Cholesky workspace and
+ * the per-solve buffers across Train() calls.
+ */
+BOOST_AUTO_TEST_CASE(SharedGramRepeatedTrainTest)
+{
+  arma::mat X = arma::randn(100, 25);
+  arma::mat gram = trans(X) * X;
+
+  LARS shared(true, gram, 0.1, 0.0);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::rowvec y = arma::randn<arma::rowvec>(100);
+
+    arma::vec sharedBeta;
+    shared.Train(X, y, sharedBeta, false);
+
+    LARS fresh(true, gram, 0.1, 0.0);
+    arma::vec freshBeta;
+    fresh.Train(X, y, freshBeta, false);
+
+    BOOST_REQUIRE_EQUAL(sharedBeta.n_elem, freshBeta.n_elem);
+    for (size_t j = 0; j < sharedBeta.n_elem; ++j)
+    {
+      if (std::abs(freshBeta[j]) < 1e-12)
+        BOOST_REQUIRE_SMALL(sharedBeta[j], 1e-12);
+      else
+        BOOST_REQUIRE_CLOSE(sharedBeta[j], freshBeta[j], 1e-8);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/math/lin_alg.hpp>
+#include <mlpack/core/math/co_moment_accumulator.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -190,6 +191,98 @@ BOOST_AUTO_TEST_CASE(TestRemoveRows)
   }
 }
 
+// Test that in-place centering agrees with the two-argument Center().
+BOOST_AUTO_TEST_CASE(TestCenterInPlace)
+{
+  mat tmp = randu<mat>(7, 23);
+
+  mat expected;
+  Center(tmp, expected);
+
+  Center(tmp);
+
+  for (size_t col = 0; col < tmp.n_cols; ++col)
+    for (size_t row = 0; row < tmp.n_rows; ++row)
+      BOOST_REQUIRE_CLOSE(tmp(row, col), expected(row, col), 1e-5);
+}
+
+// Test that in-place row removal agrees with RemoveRows().
+BOOST_AUTO_TEST_CASE(TestRemoveRowsInPlace)
+{
+  for (size_t run = 0; run < 10; ++run)
+  {
+    arma::mat input;
+    input.randu(200, 200);
+
+    // Now pick some random numbers.
+    std::vector<size_t> rowsToRemove;
+    size_t row = 0;
+    while (row < 200)
+    {
+      row += RandInt(1, (2 * (run + 1) + 1));
+      if (row < 200)
+      {
+        rowsToRemove.push_back(row);
+      }
+    }
+
+    arma::mat expected;
+    RemoveRows(input, rowsToRemove, expected);
+
+    RemoveRowsInPlace(input, rowsToRemove);
+
+    BOOST_REQUIRE_EQUAL(input.n_rows, expected.n_rows);
+    BOOST_REQUIRE_EQUAL(input.n_cols, expected.n_cols);
+    BOOST_REQUIRE_EQUAL(accu(input == expected), input.n_elem);
+  }
+}
+
+// Test the streaming co-moment accumulator against arma::cov(), both for
+// point-by-point accumulation and for merged shards.
+BOOST_AUTO_TEST_CASE(TestCoMomentAccumulator)
+{
+  arma::mat data = randu<mat>(5, 300);
+
+  // arma::cov() treats rows as points.
+  arma::mat expected = arma::cov(data.t());
+
+  CoMomentAccumulator accumulator(5);
+  accumulator.Insert(data);
+
+  BOOST_REQUIRE_CLOSE(accumulator.Count(), 300.0, 1e-10);
+
+  arma::mat actual = accumulator.Covariance();
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 5; ++j)
+      BOOST_REQUIRE_CLOSE(actual(i, j), expected(i, j), 1e-5);
+
+  // Now accumulate the same data in three unevenly sized shards and merge.
+  CoMomentAccumulator first, second, third;
+  first.Insert(arma::mat(data.cols(0, 99)));
+  second.Insert(arma::mat(data.cols(100, 110)));
+  third.Insert(arma::mat(data.cols(111, 299)));
+
+  first.Merge(second);
+  first.Merge(third);
+
+  BOOST_REQUIRE_CLOSE(first.Count(), 300.0, 1e-10);
+
+  arma::mat merged = first.Covariance();
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 5; ++j)
+      BOOST_REQUIRE_CLOSE(merged(i, j), expected(i, j), 1e-5);
+
+  // The mean should match too.
+  arma::vec expectedMean = arma::mean(data, 1);
+  for (size_t i = 0; i < 5; ++i)
+    BOOST_REQUIRE_CLOSE(first.Mean()(i), expectedMean(i), 1e-5);
+
+  // Merging a mismatched accumulator should throw.
+  CoMomentAccumulator wrongDimensionality(3);
+  wrongDimensionality.Insert(arma::vec("1 2 3"));
+  BOOST_REQUIRE_THROW(first.Merge(wrongDimensionality), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(TestSvecSmat)
 {
   arma::mat X(3, 3);
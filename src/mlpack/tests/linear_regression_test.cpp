@@ -224,4 +224,53 @@ BOOST_AUTO_TEST_CASE(LinearRegressionTest)
       binaryLr.Parameters());
 }
 
+/**
+ * Test that building a model incrementally with AddPoints() gives the same
+ * parameters as batch training on the full dataset.
+ */
+BOOST_AUTO_TEST_CASE(LinearRegressionIncrementalAddTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 600);
+  arma::rowvec responses = arma::randu<arma::rowvec>(600);
+
+  LinearRegression lr(dataset, responses, 0.1);
+
+  // Add the same data in three chunks.
+  LinearRegression incLr;
+  incLr.Lambda() = 0.1;
+  incLr.AddPoints(dataset.cols(0, 199), responses.subvec(0, 199));
+  incLr.AddPoints(dataset.cols(200, 399), responses.subvec(200, 399));
+  incLr.AddPoints(dataset.cols(400, 599), responses.subvec(400, 599));
+
+  BOOST_REQUIRE_EQUAL(lr.Parameters().n_elem, incLr.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(lr.Parameters()[i], incLr.Parameters()[i], 1e-5);
+}
+
+/**
+ * Test refitting on a sliding window: removing the oldest chunk and adding a
+ * new one must match batch training on the current window.
+ */
+BOOST_AUTO_TEST_CASE(LinearRegressionSlidingWindowTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 500);
+  arma::rowvec responses = arma::randu<arma::rowvec>(500);
+
+  // Incrementally fit the first 400 points, then slide the window forward by
+  // 100 points.
+  LinearRegression incLr;
+  incLr.Lambda() = 0.05;
+  incLr.AddPoints(dataset.cols(0, 399), responses.subvec(0, 399));
+  incLr.RemovePoints(dataset.cols(0, 99), responses.subvec(0, 99));
+  incLr.AddPoints(dataset.cols(400, 499), responses.subvec(400, 499));
+
+  // Batch model on the resulting window.
+  LinearRegression lr(dataset.cols(100, 499), responses.subvec(100, 499),
+      0.05);
+
+  BOOST_REQUIRE_EQUAL(lr.Parameters().n_elem, incLr.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(lr.Parameters()[i], incLr.Parameters()[i], 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
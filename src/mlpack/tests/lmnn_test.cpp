@@ -100,6 +100,56 @@ BOOST_AUTO_TEST_CASE(LMNNImpostorsTest)
   BOOST_REQUIRE_EQUAL(impostors(0, 5), 2);
 }
 
+/**
+ * The cached impostor search trees should give the same results whether they
+ * are reused (no drift since the last call) or rebuilt (drift past the
+ * tolerance).
+ */
+BOOST_AUTO_TEST_CASE(LMNNConstraintsTreeCacheTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 200);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = i % 2;
+
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; i++)
+    norm(i) = arma::norm(dataset.col(i));
+
+  Constraints<> constraint(dataset, labels, 3);
+
+  arma::Mat<size_t> neighbors1, neighbors2;
+  arma::mat distances1, distances2;
+  neighbors1.set_size(3, dataset.n_cols);
+  neighbors2.set_size(3, dataset.n_cols);
+  distances1.set_size(3, dataset.n_cols);
+  distances2.set_size(3, dataset.n_cols);
+
+  // A second call with no accumulated drift reuses the cached trees and must
+  // give identical results.
+  constraint.Impostors(neighbors1, distances1, dataset, labels, norm);
+  constraint.Impostors(neighbors2, distances2, dataset, labels, norm);
+
+  CheckMatrices(neighbors1, neighbors2);
+  CheckMatrices(distances1, distances2);
+
+  // After accumulating drift, the trees are rebuilt against the new dataset;
+  // the results must match those of a freshly constructed Constraints object.
+  arma::mat scaledDataset = 1.5 * dataset;
+  arma::vec scaledNorm = 1.5 * norm;
+
+  constraint.AccumulateDrift(0.5 * arma::max(norm));
+  constraint.Impostors(neighbors1, distances1, scaledDataset, labels,
+      scaledNorm);
+
+  Constraints<> freshConstraint(scaledDataset, labels, 3);
+  freshConstraint.Impostors(neighbors2, distances2, scaledDataset, labels,
+      scaledNorm);
+
+  CheckMatrices(neighbors1, neighbors2);
+  CheckMatrices(distances1, distances2);
+}
+
 //
 // Tests for the LMNNFunction
 //
@@ -12,6 +12,7 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/label_mapper.hpp>
 #include <mlpack/core/data/load_arff.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 
@@ -573,6 +574,141 @@ BOOST_AUTO_TEST_CASE(SaveArmaBinaryTest)
   remove("test_file.bin");
 }
 
+/**
+ * Make sure the columnar format round-trips, compresses, and can load a
+ * subset of dimensions.
+ */
+BOOST_AUTO_TEST_CASE(ColumnarFormatTest)
+{
+  arma::mat test(50, 100, arma::fill::randu);
+  // Make one dimension mostly zero so the RLE codec has something to do.
+  test.row(3).zeros();
+  test(3, 10) = 1.0;
+
+  for (size_t compress = 0; compress <= 1; ++compress)
+  {
+    BOOST_REQUIRE(data::SaveColumnar("test_file.mlc", test, false,
+        (bool) compress) == true);
+
+    // Full load.
+    arma::mat full;
+    BOOST_REQUIRE(data::LoadColumnar("test_file.mlc", full) == true);
+    BOOST_REQUIRE_EQUAL(full.n_rows, test.n_rows);
+    BOOST_REQUIRE_EQUAL(full.n_cols, test.n_cols);
+    for (size_t i = 0; i < test.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(full[i], test[i], 1e-8);
+
+    // Subset load: three dimensions, out of order.
+    arma::uvec dims("7 3 21");
+    arma::mat subset;
+    BOOST_REQUIRE(data::LoadColumnar("test_file.mlc", subset, dims) == true);
+    BOOST_REQUIRE_EQUAL(subset.n_rows, 3);
+    BOOST_REQUIRE_EQUAL(subset.n_cols, test.n_cols);
+    for (size_t i = 0; i < dims.n_elem; ++i)
+      for (size_t j = 0; j < test.n_cols; ++j)
+        BOOST_REQUIRE_CLOSE(subset(i, j), test(dims[i], j), 1e-8);
+  }
+
+  remove("test_file.mlc");
+}
+
+/**
+ * Make sure the frame-compressed binary format round-trips through Save() and
+ * Load(), including the transposition both of those perform.
+ */
+BOOST_AUTO_TEST_CASE(CompressedBinaryFormatTest)
+{
+  // Use enough columns for several frames, and constant rows so that the
+  // shuffle-RLE codec actually compresses something.
+  arma::mat test(10, 500, arma::fill::randu);
+  test.rows(0, 4).fill(3.0);
+
+  BOOST_REQUIRE(data::Save("test_file.cbin", test) == true);
+
+  arma::mat loaded;
+  BOOST_REQUIRE(data::Load("test_file.cbin", loaded) == true);
+
+  BOOST_REQUIRE_EQUAL(loaded.n_rows, test.n_rows);
+  BOOST_REQUIRE_EQUAL(loaded.n_cols, test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(loaded[i], test[i], 1e-8);
+
+  // The direct (untransposed) interface should round-trip too.
+  BOOST_REQUIRE(data::SaveCompressedBinary("test_file.cbin", test) == true);
+  BOOST_REQUIRE(data::LoadCompressedBinary("test_file.cbin", loaded) == true);
+
+  BOOST_REQUIRE_EQUAL(loaded.n_rows, test.n_rows);
+  BOOST_REQUIRE_EQUAL(loaded.n_cols, test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(loaded[i], test[i], 1e-8);
+
+  remove("test_file.cbin");
+}
+
+#ifndef _WIN32
+/**
+ * Make sure memory-mapped loading of arma_binary data gives the right matrix.
+ * The ASCII header misaligns the payload, so the loader copies instead of
+ * aliasing the mapping and there is nothing for UnmapMatrix() to release.
+ */
+BOOST_AUTO_TEST_CASE(MmapLoadArmaBinaryTest)
+{
+  arma::mat test = "1 5;"
+                   "2 6;"
+                   "3 7;"
+                   "4 8;";
+
+  BOOST_REQUIRE(test.quiet_save("test_file.bin", arma::arma_binary) == true);
+
+  // Map the file; no transposition happens, so we get the matrix as saved.
+  arma::mat mapped;
+  BOOST_REQUIRE(data::Load("test_file.bin", mapped,
+      data::MmapPolicy::READ_ONLY) == true);
+
+  BOOST_REQUIRE_EQUAL(mapped.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(mapped.n_cols, 2);
+
+  for (size_t i = 0; i < 8; i++)
+    BOOST_REQUIRE_CLOSE(mapped[i], test[i], 1e-5);
+
+  BOOST_REQUIRE(data::UnmapMatrix(mapped) == false);
+
+  // Remove the file.
+  remove("test_file.bin");
+}
+
+/**
+ * Make sure memory-mapped loading of a headerless raw binary file aliases
+ * the mapping (the payload starts at offset zero, so it is always aligned)
+ * and that the mapping can be released again.
+ */
+BOOST_AUTO_TEST_CASE(MmapLoadRawBinaryTest)
+{
+  arma::mat test = "1 5;"
+                   "2 6;"
+                   "3 7;"
+                   "4 8;";
+
+  BOOST_REQUIRE(test.quiet_save("test_file.bin", arma::raw_binary) == true);
+
+  arma::mat mapped;
+  BOOST_REQUIRE(data::Load("test_file.bin", mapped,
+      data::MmapPolicy::READ_ONLY, false, 4, 2) == true);
+
+  BOOST_REQUIRE_EQUAL(mapped.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(mapped.n_cols, 2);
+
+  for (size_t i = 0; i < 8; i++)
+    BOOST_REQUIRE_CLOSE(mapped[i], test[i], 1e-5);
+
+  BOOST_REQUIRE(data::UnmapMatrix(mapped) == true);
+  BOOST_REQUIRE_EQUAL(mapped.n_elem, 0);
+
+  // Remove the file.
+  remove("test_file.bin");
+}
+#endif
+
 /**
  * Make sure raw_binary is loaded correctly.
  */
@@ -766,6 +902,47 @@ BOOST_AUTO_TEST_CASE(SaveHDF5Test)
   remove("test_file.he5");
 }
 
+/**
+ * Make sure a row/column range of an HDF5 dataset loads correctly via the
+ * hyperslab overload.
+ */
+BOOST_AUTO_TEST_CASE(LoadHDF5RangeTest)
+{
+  arma::mat test(20, 30);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    test[i] = (double) i;
+
+  BOOST_REQUIRE(data::Save("test_file.h5", test) == true);
+
+  // Load a block of five dimensions and ten points.
+  arma::mat block;
+  BOOST_REQUIRE(data::Load("test_file.h5", block, arma::span(3, 7),
+      arma::span(10, 19)) == true);
+
+  BOOST_REQUIRE_EQUAL(block.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(block.n_cols, 10);
+
+  for (size_t r = 0; r < block.n_rows; ++r)
+    for (size_t c = 0; c < block.n_cols; ++c)
+      BOOST_REQUIRE_CLOSE(block(r, c), test(r + 3, c + 10), 1e-5);
+
+  // A whole-range span should give the full matrix back.
+  BOOST_REQUIRE(data::Load("test_file.h5", block, arma::span(),
+      arma::span()) == true);
+
+  BOOST_REQUIRE_EQUAL(block.n_rows, test.n_rows);
+  BOOST_REQUIRE_EQUAL(block.n_cols, test.n_cols);
+
+  for (size_t i = 0; i < test.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(block[i], test[i], 1e-5);
+
+  // An out-of-bounds range must fail.
+  BOOST_REQUIRE(data::Load("test_file.h5", block, arma::span(0, 25),
+      arma::span()) == false);
+
+  remove("test_file.h5");
+}
+
 #endif
 
 /**
@@ -822,6 +999,59 @@ BOOST_AUTO_TEST_CASE(NormalizeLabelTest)
     BOOST_REQUIRE_EQUAL(randLabels[i], revertedLabels[i]);
 }
 
+/**
+ * Test that a LabelMapper normalizes successive label vectors with one
+ * consistent mapping.
+ */
+BOOST_AUTO_TEST_CASE(LabelMapperTest)
+{
+  arma::irowvec trainLabels("7 -3 7 42 -3 7");
+  arma::irowvec testLabels("42 7 -3 100");
+
+  data::LabelMapper<arma::sword> mapper;
+
+  arma::Row<size_t> newTrainLabels;
+  mapper.Normalize(trainLabels, newTrainLabels);
+
+  // The mapping should follow the order of first appearance, like
+  // NormalizeLabels().
+  BOOST_REQUIRE_EQUAL(mapper.NumClasses(), 3);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[0], 0);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[1], 1);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[2], 0);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[3], 2);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[4], 1);
+  BOOST_REQUIRE_EQUAL(newTrainLabels[5], 0);
+
+  // Previously seen labels should keep their values; the unseen label should
+  // be appended to the mapping.
+  arma::Row<size_t> newTestLabels;
+  mapper.Normalize(testLabels, newTestLabels);
+
+  BOOST_REQUIRE_EQUAL(mapper.NumClasses(), 4);
+  BOOST_REQUIRE_EQUAL(newTestLabels[0], 2);
+  BOOST_REQUIRE_EQUAL(newTestLabels[1], 0);
+  BOOST_REQUIRE_EQUAL(newTestLabels[2], 1);
+  BOOST_REQUIRE_EQUAL(newTestLabels[3], 3);
+
+  // Reverting should recover the original labels.
+  arma::irowvec revertedLabels;
+  mapper.Revert(newTestLabels, revertedLabels);
+  for (size_t i = 0; i < testLabels.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(testLabels[i], revertedLabels[i]);
+
+  // The stored mapping should agree with the one NormalizeLabels() builds on
+  // the concatenated input.
+  arma::Row<size_t> allNewLabels;
+  arma::ivec expectedMapping;
+  data::NormalizeLabels(arma::irowvec(arma::join_rows(trainLabels,
+      testLabels)), allNewLabels, expectedMapping);
+  arma::ivec actualMapping = mapper.Mapping();
+  BOOST_REQUIRE_EQUAL(actualMapping.n_elem, expectedMapping.n_elem);
+  for (size_t i = 0; i < expectedMapping.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(actualMapping[i], expectedMapping[i]);
+}
+
 // Test structures.
 class TestInner
 {
@@ -927,6 +1157,52 @@ BOOST_AUTO_TEST_CASE(LoadTextTest)
   BOOST_REQUIRE_EQUAL(y.inb.s, x.inb.s);
 }
 
+/**
+ * '.bin' models now save in the compact native raw format by default; make
+ * sure files written as boost binary archives still load via auto-detection.
+ */
+BOOST_AUTO_TEST_CASE(LoadOldBinaryFormatTest)
+{
+  Test x(10, 12);
+
+  BOOST_REQUIRE_EQUAL(
+      data::Save("test.bin", "x", x, false, data::format::binary), true);
+
+  // Now reload with format auto-detection.
+  Test y(11, 14);
+
+  BOOST_REQUIRE_EQUAL(data::Load("test.bin", "x", y, false), true);
+
+  BOOST_REQUIRE_EQUAL(y.x, x.x);
+  BOOST_REQUIRE_EQUAL(y.y, x.y);
+  BOOST_REQUIRE_EQUAL(y.ina.c, x.ina.c);
+  BOOST_REQUIRE_EQUAL(y.ina.s, x.ina.s);
+  BOOST_REQUIRE_EQUAL(y.inb.c, x.inb.c);
+  BOOST_REQUIRE_EQUAL(y.inb.s, x.inb.s);
+}
+
+/**
+ * Make sure the raw format round-trips Armadillo objects, whose memory is
+ * written as a single blob.
+ */
+BOOST_AUTO_TEST_CASE(LoadRawMatrixTest)
+{
+  arma::mat x(37, 41, arma::fill::randu);
+
+  BOOST_REQUIRE_EQUAL(
+      data::Save("test.bin", "x", x, false, data::format::raw), true);
+
+  arma::mat y;
+
+  BOOST_REQUIRE_EQUAL(
+      data::Load("test.bin", "x", y, false, data::format::raw), true);
+
+  BOOST_REQUIRE_EQUAL(y.n_rows, x.n_rows);
+  BOOST_REQUIRE_EQUAL(y.n_cols, x.n_cols);
+  for (size_t i = 0; i < x.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(y[i], x[i], 1e-10);
+}
+
 /**
  * Test DatasetInfo by making a map for a dimension.
  */
@@ -975,6 +1251,53 @@ BOOST_AUTO_TEST_CASE(DatasetInfoTest)
   BOOST_REQUIRE_EQUAL(strThird, "test_mapping_3");
 }
 
+/**
+ * Test that a frozen DatasetInfo answers UnmapValue() from its compiled
+ * tables, and that mutation discards the frozen state.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoFreezeTest)
+{
+  DatasetInfo di(5);
+
+  // Create mappings in two dimensions.
+  std::vector<size_t> values;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    std::ostringstream oss;
+    oss << "token_" << i;
+    values.push_back(di.MapString<size_t>(oss.str(), 1));
+    di.MapString<size_t>(oss.str() + "_b", 4);
+  }
+
+  BOOST_REQUIRE(!di.Frozen());
+  di.Freeze();
+  BOOST_REQUIRE(di.Frozen());
+
+  // All mappings must resolve identically through the frozen tables.
+  for (size_t i = 0; i < 50; ++i)
+  {
+    std::ostringstream oss;
+    oss << "token_" << i;
+    BOOST_REQUIRE_EQUAL(di.UnmapValue(oss.str(), 1), values[i]);
+  }
+
+  // Unknown tokens still throw.
+  BOOST_REQUIRE_THROW(di.UnmapValue("missing_token", 1),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(di.UnmapValue("token_3", 2), std::invalid_argument);
+
+  // Mutation invalidates the frozen state, but lookups still work through
+  // the mutable maps.
+  const size_t newValue = di.MapString<size_t>("token_new", 1);
+  BOOST_REQUIRE(!di.Frozen());
+  BOOST_REQUIRE_EQUAL(di.UnmapValue("token_new", 1), newValue);
+
+  // Refreezing picks up the new mapping.
+  di.Freeze();
+  BOOST_REQUIRE_EQUAL(di.UnmapValue("token_new", 1), newValue);
+  BOOST_REQUIRE_EQUAL(di.UnmapValue("token_0_b", 4), 0);
+}
+
 /**
  * Test loading regular CSV with DatasetInfo.  Everything should be numeric.
  */
@@ -1770,6 +2093,55 @@ BOOST_AUTO_TEST_CASE(HarderARFFTest)
   remove("test.arff");
 }
 
+/**
+ * Sparse ARFF rows ("{index value, ...}") should load, with every unlisted
+ * value set to zero, and may be mixed with dense rows.
+ */
+BOOST_AUTO_TEST_CASE(SparseARFFTest)
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two NUMERIC" << endl;
+  f << "@attribute three NUMERIC" << endl;
+  f << endl;
+  f << "@data" << endl;
+  f << "{0 1, 2 3}" << endl;
+  f << "{1 4.5} % comment" << endl;
+  f << "1, 2, 3" << endl;
+  f << "{}" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  data::Load("test.arff", dataset, info);
+
+  BOOST_REQUIRE_EQUAL(info.Dimensionality(), 3);
+  BOOST_REQUIRE_EQUAL(dataset.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(dataset.n_cols, 4);
+
+  BOOST_REQUIRE_CLOSE(dataset(0, 0), 1.0, 1e-5);
+  BOOST_REQUIRE_SMALL(dataset(1, 0), 1e-10);
+  BOOST_REQUIRE_CLOSE(dataset(2, 0), 3.0, 1e-5);
+
+  BOOST_REQUIRE_SMALL(dataset(0, 1), 1e-10);
+  BOOST_REQUIRE_CLOSE(dataset(1, 1), 4.5, 1e-5);
+  BOOST_REQUIRE_SMALL(dataset(2, 1), 1e-10);
+
+  BOOST_REQUIRE_CLOSE(dataset(0, 2), 1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(dataset(1, 2), 2.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(dataset(2, 2), 3.0, 1e-5);
+
+  // The empty sparse row is a point of all zeros.
+  BOOST_REQUIRE_SMALL(dataset(0, 3), 1e-10);
+  BOOST_REQUIRE_SMALL(dataset(1, 3), 1e-10);
+  BOOST_REQUIRE_SMALL(dataset(2, 3), 1e-10);
+
+  remove("test.arff");
+}
+
 /**
  * If we pass a bad DatasetInfo, it should throw.
  */
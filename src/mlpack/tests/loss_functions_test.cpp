@@ -18,6 +18,8 @@
 #include <mlpack/methods/ann/loss_functions/earth_mover_distance.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/loss_functions/sigmoid_cross_entropy_error.hpp>
+#include <mlpack/methods/ann/loss_functions/softmax_cross_entropy_error.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
 #include <mlpack/methods/ann/loss_functions/cross_entropy_error.hpp>
 #include <mlpack/methods/ann/loss_functions/reconstruction_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/dice_loss.hpp>
@@ -171,6 +173,42 @@ BOOST_AUTO_TEST_CASE(SimpleCrossEntropyErrorTest)
   BOOST_REQUIRE_EQUAL(output.n_cols, input2.n_cols);
 }
 
+/*
+ * Test that the fused ForwardBackward() pass of the mean squared error, the
+ * cross-entropy error and the Kullback-Leibler divergence gives the same loss
+ * and error as separate Forward() and Backward() calls.
+ */
+BOOST_AUTO_TEST_CASE(FusedForwardBackwardTest)
+{
+  arma::mat input = 0.1 + 0.8 * arma::randu<arma::mat>(10, 32);
+  arma::mat target = 0.1 + 0.8 * arma::randu<arma::mat>(10, 32);
+  arma::mat output, fusedOutput;
+
+  MeanSquaredError<> mseModule;
+  double error = mseModule.Forward(std::move(input), std::move(target));
+  mseModule.Backward(std::move(input), std::move(target), std::move(output));
+  double fusedError = mseModule.ForwardBackward(std::move(input),
+      std::move(target), std::move(fusedOutput));
+  BOOST_REQUIRE_CLOSE(error, fusedError, 1e-10);
+  CheckMatrices(output, fusedOutput);
+
+  CrossEntropyError<> ceModule(1e-6);
+  error = ceModule.Forward(std::move(input), std::move(target));
+  ceModule.Backward(std::move(input), std::move(target), std::move(output));
+  fusedError = ceModule.ForwardBackward(std::move(input), std::move(target),
+      std::move(fusedOutput));
+  BOOST_REQUIRE_CLOSE(error, fusedError, 1e-10);
+  CheckMatrices(output, fusedOutput);
+
+  KLDivergence<> klModule(true);
+  error = klModule.Forward(std::move(input), std::move(target));
+  klModule.Backward(std::move(input), std::move(target), std::move(output));
+  fusedError = klModule.ForwardBackward(std::move(input), std::move(target),
+      std::move(fusedOutput));
+  BOOST_REQUIRE_CLOSE(error, fusedError, 1e-10);
+  CheckMatrices(output, fusedOutput);
+}
+
 /**
  * Simple test for the Sigmoid Cross Entropy performance function.
  */
@@ -231,6 +269,40 @@ BOOST_AUTO_TEST_CASE(SimpleSigmoidCrossEntropyErrorTest)
   BOOST_REQUIRE_EQUAL(output.n_cols, input3.n_cols);
 }
 
+/**
+ * Simple test for the fused softmax cross-entropy head.  It must agree with
+ * LogSoftMax followed by NegativeLogLikelihood.
+ */
+BOOST_AUTO_TEST_CASE(SimpleSoftmaxCrossEntropyErrorTest)
+{
+  SoftmaxCrossEntropyError<> module;
+
+  arma::mat input = arma::randn(5, 4);
+  arma::mat target("1 3 5 2");
+
+  // Reference: explicit log-softmax followed by negative log-likelihood.
+  LogSoftMax<> logSoftmax;
+  NegativeLogLikelihood<> nll;
+  arma::mat logProb;
+  logSoftmax.Forward(std::move(input), std::move(logProb));
+  const double expected = nll.Forward(std::move(logProb), std::move(target));
+
+  const double error = module.Forward(std::move(input), std::move(target));
+  BOOST_REQUIRE_CLOSE(error, expected, 0.1);
+
+  // Test the Backward function; each column must sum to zero since the
+  // gradient is softmax minus the one-hot target.
+  arma::mat output;
+  module.Backward(std::move(input), std::move(target), std::move(output));
+  BOOST_REQUIRE_EQUAL(output.n_rows, input.n_rows);
+  BOOST_REQUIRE_EQUAL(output.n_cols, input.n_cols);
+  for (size_t i = 0; i < output.n_cols; ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::accu(output.col(i)), 1e-10);
+    BOOST_REQUIRE_LT(output((size_t) target(i) - 1, i), 0.0);
+  }
+}
+
 /**
  * Simple test for the Earth Mover Distance Layer.
  */
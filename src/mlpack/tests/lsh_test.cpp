@@ -641,6 +641,44 @@ BOOST_AUTO_TEST_CASE(LSHTrainTest)
   BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
 }
 
+/**
+ * Test that InsertPoints() appends new points to a trained model and that the
+ * inserted points are discoverable by a subsequent search.
+ */
+BOOST_AUTO_TEST_CASE(LSHInsertPointsTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 100);
+  arma::mat newPoints = arma::randu<arma::mat>(5, 50);
+
+  LSHSearch<> lsh(referenceData, 4, 10, 2.0, 99901, 500);
+
+  lsh.InsertPoints(newPoints);
+  BOOST_REQUIRE_EQUAL(lsh.ReferenceSet().n_cols, 150);
+
+  // A query identical to an inserted point produces the same hash keys as the
+  // point itself, so the point must appear in the candidate set and be
+  // returned as an exact match.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(newPoints, 1, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 50);
+  for (size_t i = 0; i < newPoints.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors(0, i), 100 + i);
+    BOOST_REQUIRE_SMALL(distances(0, i), 1e-10);
+  }
+
+  // Inserting points of the wrong dimensionality must fail.
+  arma::mat badPoints = arma::randu<arma::mat>(7, 10);
+  BOOST_REQUIRE_THROW(lsh.InsertPoints(badPoints), std::invalid_argument);
+
+  // Inserting into an untrained model must fail.
+  LSHSearch<> untrained;
+  BOOST_REQUIRE_THROW(untrained.InsertPoints(newPoints),
+      std::invalid_argument);
+}
+
 /**
  * Test: this verifies ComputeRecall works correctly by providing two identical
  * vectors and requiring that Recall is equal to 1.
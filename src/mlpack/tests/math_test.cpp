@@ -10,8 +10,12 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/log_add.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
+#include <mlpack/core/math/vector_math.hpp>
+#include <mlpack/core/math/patch_extraction.hpp>
+#include <mlpack/core/math/sparse_builder.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -1009,4 +1013,298 @@ BOOST_AUTO_TEST_CASE(InplaceSparseShuffleWeightsTest)
   }
 }
 
+/**
+ * A RandomStream must be a pure function of the global seed and its
+ * identifiers: recreating it must give the same sequence, and other streams
+ * must not affect it.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamReproducibilityTest)
+{
+  math::RandomSeed(std::time(NULL));
+
+  RandomStream stream(17);
+  arma::vec draws(50);
+  for (size_t i = 0; i < draws.n_elem; ++i)
+    draws[i] = stream.Random();
+
+  // Draw from other streams in between; this must not disturb stream 17.
+  RandomStream other(18);
+  for (size_t i = 0; i < 100; ++i)
+    other.Random();
+
+  RandomStream recreated(17);
+  for (size_t i = 0; i < draws.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(recreated.Random(), draws[i]);
+
+  // Different identifiers must give different sequences.
+  RandomStream differentId(17, 1);
+  size_t differences = 0;
+  RandomStream again(17);
+  for (size_t i = 0; i < draws.n_elem; ++i)
+    if (differentId.Random() != again.Random())
+      ++differences;
+  BOOST_REQUIRE_GT(differences, 0);
+}
+
+/**
+ * RandomStream draws must lie in the requested ranges and have roughly the
+ * right moments.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamDistributionTest)
+{
+  RandomStream stream(3);
+
+  double sum = 0.0;
+  for (size_t i = 0; i < 50000; ++i)
+  {
+    const double value = stream.Random();
+    BOOST_REQUIRE_GE(value, 0.0);
+    BOOST_REQUIRE_LT(value, 1.0);
+    sum += value;
+  }
+  BOOST_REQUIRE_CLOSE(sum / 50000, 0.5, 2.0);
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const int value = stream.RandInt(3, 12);
+    BOOST_REQUIRE_GE(value, 3);
+    BOOST_REQUIRE_LT(value, 12);
+  }
+
+  double normalSum = 0.0, normalSquaredSum = 0.0;
+  for (size_t i = 0; i < 50000; ++i)
+  {
+    const double value = stream.RandNormal();
+    normalSum += value;
+    normalSquaredSum += value * value;
+  }
+  BOOST_REQUIRE_SMALL(normalSum / 50000, 0.02);
+  BOOST_REQUIRE_CLOSE(normalSquaredSum / 50000, 1.0, 3.0);
+}
+
+/**
+ * The fast transcendental approximations must agree with libm to high
+ * relative accuracy across the useful input range, and saturate correctly
+ * outside it.
+ */
+BOOST_AUTO_TEST_CASE(FastTranscendentalsTest)
+{
+  for (double x = -40.0; x <= 40.0; x += 0.37)
+  {
+    BOOST_REQUIRE_CLOSE(FastExp(x), std::exp(x), 1e-5);
+    BOOST_REQUIRE_CLOSE(FastTanh(x) + 2.0, std::tanh(x) + 2.0, 1e-5);
+    BOOST_REQUIRE_CLOSE(FastLogistic(x) + 1.0,
+        1.0 / (1.0 + std::exp(-x)) + 1.0, 1e-5);
+    BOOST_REQUIRE_CLOSE(FastSoftplus(x) + 1.0,
+        std::log1p(std::exp(x)) + 1.0, 1e-5);
+  }
+
+  BOOST_REQUIRE_EQUAL(FastExp(-1000.0), 0.0);
+  BOOST_REQUIRE_EQUAL(FastExp(1000.0),
+      std::numeric_limits<double>::infinity());
+}
+
+/**
+ * VectorizedApply() must match applying the kernel serially, including when
+ * it is applied in place.
+ */
+BOOST_AUTO_TEST_CASE(VectorizedApplyTest)
+{
+  // Large enough to take the parallel path.
+  arma::vec input(20000, arma::fill::randn);
+  arma::vec output(20000);
+
+  VectorizedApply(input.memptr(), output.memptr(), input.n_elem,
+      [](const double v) { return FastTanh(v); });
+
+  for (size_t i = 0; i < 100; ++i)
+    BOOST_REQUIRE_CLOSE(output[i] + 2.0, std::tanh(input[i]) + 2.0, 1e-5);
+
+  // In-place application must give the same result.
+  arma::vec copy = input;
+  VectorizedApply(copy.memptr(), copy.memptr(), copy.n_elem,
+      [](const double v) { return FastTanh(v); });
+  for (size_t i = 0; i < copy.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(copy[i], output[i]);
+}
+
+/**
+ * ExtractPatches() must gather the same patches as a naive per-element loop.
+ */
+BOOST_AUTO_TEST_CASE(ExtractPatchesTest)
+{
+  const size_t imageHeight = 7;
+  const size_t imageWidth = 6;
+  const size_t patchHeight = 3;
+  const size_t patchWidth = 2;
+
+  arma::mat images(imageHeight * imageWidth, 4, arma::fill::randu);
+
+  arma::mat patches;
+  ExtractPatches(images, imageHeight, imageWidth, patchHeight, patchWidth, 2,
+      1, patches);
+
+  const size_t patchRows = (imageHeight - patchHeight) / 2 + 1;
+  const size_t patchCols = (imageWidth - patchWidth) / 1 + 1;
+  BOOST_REQUIRE_EQUAL(patches.n_rows, patchHeight * patchWidth);
+  BOOST_REQUIRE_EQUAL(patches.n_cols, patchRows * patchCols * images.n_cols);
+
+  // Compare a few patches against a naive gather.
+  for (size_t image = 0; image < images.n_cols; ++image)
+  {
+    for (size_t pc = 0; pc < patchCols; ++pc)
+    {
+      for (size_t pr = 0; pr < patchRows; ++pr)
+      {
+        const size_t patch = image * patchRows * patchCols +
+            pc * patchRows + pr;
+        for (size_t c = 0; c < patchWidth; ++c)
+        {
+          for (size_t r = 0; r < patchHeight; ++r)
+          {
+            const double expected = images((pc * 1 + c) * imageHeight +
+                (pr * 2 + r), image);
+            BOOST_REQUIRE_EQUAL(patches(c * patchHeight + r, patch),
+                expected);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * ScatterPatches() must invert ExtractPatches() when the patches tile the
+ * image exactly, and must average overlaps correctly otherwise.
+ */
+BOOST_AUTO_TEST_CASE(ScatterPatchesTest)
+{
+  const size_t imageHeight = 8;
+  const size_t imageWidth = 6;
+
+  arma::mat images(imageHeight * imageWidth, 3, arma::fill::randu);
+
+  // Non-overlapping tiling: scatter is an exact inverse.
+  arma::mat patches;
+  ExtractPatches(images, imageHeight, imageWidth, 4, 3, 4, 3, patches);
+  arma::mat reassembled;
+  ScatterPatches(patches, imageHeight, imageWidth, 4, 3, 4, 3, reassembled);
+  CheckMatrices(images, reassembled);
+
+  // Overlapping patches of unmodified extractions must also reconstruct the
+  // image, since the overlap average of identical values is the value.
+  ExtractPatches(images, imageHeight, imageWidth, 4, 3, 2, 1, patches);
+  ScatterPatches(patches, imageHeight, imageWidth, 4, 3, 2, 1, reassembled);
+  CheckMatrices(images, reassembled);
+}
+
+/**
+ * BuildSparse() must produce the same matrix as dense accumulation of the
+ * triplets, with duplicate locations summed.
+ */
+BOOST_AUTO_TEST_CASE(BuildSparseTest)
+{
+  const size_t nRows = 40;
+  const size_t nCols = 25;
+  const size_t n = 500;
+
+  // Random triplets; with only 1000 cells, duplicates are all but certain.
+  arma::umat locations(2, n);
+  arma::vec values(n, arma::fill::randn);
+  for (size_t i = 0; i < n; ++i)
+  {
+    locations(0, i) = math::RandInt(nRows);
+    locations(1, i) = math::RandInt(nCols);
+  }
+
+  arma::sp_mat actual;
+  math::BuildSparse(locations, values, nRows, nCols, actual);
+
+  arma::mat expected(nRows, nCols, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+    expected(locations(0, i), locations(1, i)) += values[i];
+
+  BOOST_REQUIRE_EQUAL(actual.n_rows, nRows);
+  BOOST_REQUIRE_EQUAL(actual.n_cols, nCols);
+  // Duplicates may be summed in a different order, so compare with an
+  // absolute tolerance.
+  for (size_t c = 0; c < nCols; ++c)
+    for (size_t r = 0; r < nRows; ++r)
+      BOOST_REQUIRE_SMALL((double) actual(r, c) - expected(r, c), 1e-12);
+}
+
+/**
+ * BuildSparse() must handle an empty triplet list.
+ */
+BOOST_AUTO_TEST_CASE(BuildSparseEmptyTest)
+{
+  arma::umat locations(2, 0);
+  arma::vec values;
+
+  arma::sp_mat actual;
+  math::BuildSparse(locations, values, 10, 7, actual);
+
+  BOOST_REQUIRE_EQUAL(actual.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(actual.n_cols, 7);
+  BOOST_REQUIRE_EQUAL(actual.n_nonzero, 0);
+}
+
+/**
+ * AccuLog() and LogSumExp() must agree with the naive linear-domain
+ * computation and with each other.
+ */
+BOOST_AUTO_TEST_CASE(LogSumExpTest)
+{
+  arma::mat x = 10.0 * arma::randn(20, 35);
+
+  // Vector reduction.
+  BOOST_REQUIRE_CLOSE(std::log(arma::accu(arma::exp(x.col(0) - x.col(0).max())))
+      + x.col(0).max(), math::AccuLog(x.col(0)), 1e-10);
+
+  // Column-wise and row-wise matrix reductions.
+  arma::vec colResult, rowResult;
+  math::LogSumExp(x, colResult, 0);
+  math::LogSumExp(x, rowResult, 1);
+
+  BOOST_REQUIRE_EQUAL(colResult.n_elem, x.n_cols);
+  BOOST_REQUIRE_EQUAL(rowResult.n_elem, x.n_rows);
+  for (size_t c = 0; c < x.n_cols; ++c)
+    BOOST_REQUIRE_CLOSE(colResult[c], math::AccuLog(x.col(c)), 1e-10);
+  for (size_t r = 0; r < x.n_rows; ++r)
+    BOOST_REQUIRE_CLOSE(rowResult[r], math::AccuLog(x.row(r)), 1e-10);
+}
+
+/**
+ * AccuLog() and LogSumExp() must handle slices that are entirely -inf.
+ */
+BOOST_AUTO_TEST_CASE(LogSumExpInfTest)
+{
+  const double negInf = -std::numeric_limits<double>::infinity();
+
+  arma::mat x(4, 3, arma::fill::randn);
+  x.col(1).fill(negInf);
+  x.row(2).fill(negInf);
+
+  arma::vec empty;
+  BOOST_REQUIRE_EQUAL(math::AccuLog(empty), negInf);
+  BOOST_REQUIRE_EQUAL(math::AccuLog(x.col(1)), negInf);
+
+  arma::vec colResult, rowResult;
+  math::LogSumExp(x, colResult, 0);
+  math::LogSumExp(x, rowResult, 1);
+
+  BOOST_REQUIRE_EQUAL(colResult[1], negInf);
+  BOOST_REQUIRE_EQUAL(rowResult[2], negInf);
+  for (size_t c = 0; c < x.n_cols; ++c)
+  {
+    if (c != 1)
+      BOOST_REQUIRE_CLOSE(colResult[c], math::AccuLog(x.col(c)), 1e-10);
+  }
+  for (size_t r = 0; r < x.n_rows; ++r)
+  {
+    if (r != 2)
+      BOOST_REQUIRE_CLOSE(rowResult[r], math::AccuLog(x.row(r)), 1e-10);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/matrix_completion/als_matrix_completion.hpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -64,4 +65,87 @@ BOOST_AUTO_TEST_CASE(UniformMatrixCompletionSDP)
   }
 }
 
+/**
+ * Factorized ALS completion of a synthetic low-rank matrix: the unobserved
+ * entries must be recovered to reasonable accuracy, without any dense SDP.
+ */
+BOOST_AUTO_TEST_CASE(UniformMatrixCompletionALS)
+{
+  // Rank-3 ground truth.
+  const size_t m = 60, n = 45, r = 3;
+  const arma::mat f1 = arma::randu<arma::mat>(m, r);
+  const arma::mat f2 = arma::randu<arma::mat>(n, r);
+  const arma::mat Xorig = f1 * f2.t();
+
+  // Observe half of the entries.
+  std::vector<arma::uword> rows, cols;
+  for (size_t j = 0; j < n; ++j)
+    for (size_t i = 0; i < m; ++i)
+      if (math::Random() < 0.5)
+      {
+        rows.push_back(i);
+        cols.push_back(j);
+      }
+
+  arma::umat indices(2, rows.size());
+  arma::vec values(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i)
+  {
+    indices(0, i) = rows[i];
+    indices(1, i) = cols[i];
+    values[i] = Xorig(rows[i], cols[i]);
+  }
+
+  ALSMatrixCompletion mc(m, n, indices, values, r, 1e-6, 200, 1e-10);
+  arma::mat recovered;
+  mc.Recover(recovered);
+
+  const double err = arma::norm(Xorig - recovered, "fro") /
+      arma::norm(Xorig, "fro");
+  BOOST_REQUIRE_SMALL(err, 1e-2);
+}
+
+/**
+ * Warm restarts: handing the factors of a converged solve back in must not
+ * make the solution worse, and the factors must keep their shape.
+ */
+BOOST_AUTO_TEST_CASE(WarmStartMatrixCompletionALS)
+{
+  const size_t m = 40, n = 30, r = 2;
+  const arma::mat f1 = arma::randu<arma::mat>(m, r);
+  const arma::mat f2 = arma::randu<arma::mat>(n, r);
+  const arma::mat Xorig = f1 * f2.t();
+
+  std::vector<arma::uword> rows, cols;
+  for (size_t j = 0; j < n; ++j)
+    for (size_t i = 0; i < m; ++i)
+      if (math::Random() < 0.6)
+      {
+        rows.push_back(i);
+        cols.push_back(j);
+      }
+
+  arma::umat indices(2, rows.size());
+  arma::vec values(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i)
+  {
+    indices(0, i) = rows[i];
+    indices(1, i) = cols[i];
+    values[i] = Xorig(rows[i], cols[i]);
+  }
+
+  ALSMatrixCompletion mc(m, n, indices, values, r, 1e-6, 100, 1e-10);
+  arma::mat u, v;
+  const double coldRMSE = mc.Recover(u, v);
+
+  BOOST_REQUIRE_EQUAL(u.n_rows, r);
+  BOOST_REQUIRE_EQUAL(u.n_cols, m);
+  BOOST_REQUIRE_EQUAL(v.n_rows, r);
+  BOOST_REQUIRE_EQUAL(v.n_cols, n);
+
+  // Restarting from the converged factors must stay at least as good.
+  const double warmRMSE = mc.Recover(u, v);
+  BOOST_REQUIRE_LE(warmRMSE, coldRMSE + 1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
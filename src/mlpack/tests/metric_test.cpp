@@ -10,6 +10,8 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/batch_distance.hpp>
+#include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -87,4 +89,65 @@ BOOST_AUTO_TEST_CASE(LINFMetricTest)
                       lMetric.Evaluate(a2, b2), 1e-5);
 }
 
+/**
+ * The batched one-to-many and many-to-many variants must agree with pairwise
+ * Evaluate() for each specialized metric.
+ */
+template<typename MetricType>
+void CheckBatchDistance()
+{
+  arma::mat a = arma::randn<arma::mat>(7, 80);
+  arma::mat b = arma::randn<arma::mat>(7, 55);
+  MetricType metric;
+
+  arma::vec oneToMany;
+  BatchDistance<MetricType>::OneToMany(a.col(3), b, oneToMany, metric);
+  BOOST_REQUIRE_EQUAL(oneToMany.n_elem, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    BOOST_REQUIRE_CLOSE(oneToMany[j], metric.Evaluate(a.col(3), b.col(j)),
+        1e-6);
+  }
+
+  arma::mat manyToMany;
+  BatchDistance<MetricType>::ManyToMany(a, b, manyToMany, metric);
+  BOOST_REQUIRE_EQUAL(manyToMany.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(manyToMany.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(manyToMany(i, j),
+          metric.Evaluate(a.col(i), b.col(j)), 1e-6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BatchDistanceTest)
+{
+  CheckBatchDistance<ManhattanDistance>();
+  CheckBatchDistance<EuclideanDistance>();
+  CheckBatchDistance<SquaredEuclideanDistance>();
+  CheckBatchDistance<ChebyshevDistance>();
+
+  // The Mahalanobis distance exercises the generic pairwise fallback.
+  arma::mat a = arma::randn<arma::mat>(5, 40);
+  arma::mat b = arma::randn<arma::mat>(5, 30);
+  MahalanobisDistance<true> metric(arma::eye<arma::mat>(5, 5));
+
+  arma::vec oneToMany;
+  BatchDistance<MahalanobisDistance<true>>::OneToMany(a.col(0), b, oneToMany,
+      metric);
+  arma::mat manyToMany;
+  BatchDistance<MahalanobisDistance<true>>::ManyToMany(a, b, manyToMany,
+      metric);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    BOOST_REQUIRE_CLOSE(oneToMany[j], metric.Evaluate(a.col(0), b.col(j)),
+        1e-8);
+    BOOST_REQUIRE_CLOSE(manyToMany(0, j), metric.Evaluate(a.col(0), b.col(j)),
+        1e-8);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -260,6 +260,60 @@ BOOST_AUTO_TEST_CASE(SeparateTrainIncrementalTest)
   }
 }
 
+/**
+ * Training incrementally on two halves of the dataset should merge the
+ * sufficient statistics into the same model as training on the whole dataset
+ * at once.
+ */
+BOOST_AUTO_TEST_CASE(SeparateTrainShardedIncrementalTest)
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  data::Load(trainFilename, trainData, true);
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes, true);
+
+  const size_t half = trainData.n_cols / 2;
+  NaiveBayesClassifier<> nbcTrain(trainData.n_rows, classes);
+  nbcTrain.Train(trainData.cols(0, half - 1), labels.subvec(0, half - 1),
+      classes, true);
+  nbcTrain.Train(trainData.cols(half, trainData.n_cols - 1),
+      labels.subvec(half, trainData.n_cols - 1), classes, true);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    if (std::abs(nbc.Means()[i]) < 1e-5)
+      BOOST_REQUIRE_SMALL(nbcTrain.Means()[i], 1e-5);
+    else
+      BOOST_REQUIRE_CLOSE(nbc.Means()[i], nbcTrain.Means()[i], 1e-5);
+  }
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    if (std::abs(nbc.Variances()[i]) < 1e-5)
+      BOOST_REQUIRE_SMALL(nbcTrain.Variances()[i], 1e-5);
+    else
+      BOOST_REQUIRE_CLOSE(nbc.Variances()[i], nbcTrain.Variances()[i], 1e-5);
+  }
+
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+  {
+    if (std::abs(nbc.Probabilities()[i]) < 1e-5)
+      BOOST_REQUIRE_SMALL(nbcTrain.Probabilities()[i], 1e-5);
+    else
+      BOOST_REQUIRE_CLOSE(nbc.Probabilities()[i], nbcTrain.Probabilities()[i],
+          1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SeparateTrainIndividualIncrementalTest)
 {
   const char* trainFilename = "trainSet.csv";
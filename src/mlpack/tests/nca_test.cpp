@@ -249,6 +249,45 @@ BOOST_AUTO_TEST_CASE(SoftmaxSeparableGradient)
   BOOST_REQUIRE_CLOSE(gradient(1, 1), -2.0 * -0.1435886, 0.01);
 }
 
+/**
+ * When the softmax sums are truncated to all n - 1 other points, the truncated
+ * implementation must agree with the exact one on every code path.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxTruncatedObjectiveAndGradient)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 50);
+  arma::Row<size_t> labels(50);
+  for (size_t i = 0; i < 50; ++i)
+    labels[i] = i % 2;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> exactSef(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> truncSef(data, labels);
+  truncSef.NumNeighbors() = 49; // Covers every other point, so still exact.
+
+  arma::mat coordinates = arma::eye<arma::mat>(5, 5) +
+      0.1 * arma::randu<arma::mat>(5, 5);
+
+  // Non-separable objective and gradient.
+  BOOST_REQUIRE_CLOSE(truncSef.Evaluate(coordinates),
+      exactSef.Evaluate(coordinates), 1e-5);
+
+  arma::mat exactGradient, truncGradient;
+  exactSef.Gradient(coordinates, exactGradient);
+  truncSef.Gradient(coordinates, truncGradient);
+  CheckMatrices(exactGradient, truncGradient, 1e-5);
+
+  // Separable objective and gradient.
+  for (size_t i = 0; i < 5; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(truncSef.Evaluate(coordinates, i, 1),
+        exactSef.Evaluate(coordinates, i, 1), 1e-5);
+
+    exactSef.Gradient(coordinates, i, exactGradient, 1);
+    truncSef.Gradient(coordinates, i, truncGradient, 1);
+    CheckMatrices(exactGradient, truncGradient, 1e-5);
+  }
+}
+
 //
 // Tests for the NCA algorithm.
 //
@@ -291,6 +330,38 @@ BOOST_AUTO_TEST_CASE(NCASGDSimpleDataset)
   BOOST_REQUIRE_LT(arma::norm(finalGradient, 2), 1e-4);
 }
 
+/**
+ * Ensure that NCA with truncated softmax sums still improves the objective on
+ * the simple dataset.
+ */
+BOOST_AUTO_TEST_CASE(NCATruncatedSimpleDataset)
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat data           = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  NCA<SquaredEuclideanDistance> nca(data, labels);
+  nca.NumNeighbors() = 3;
+  nca.RecalculationInterval() = 50;
+  nca.Optimizer().StepSize() = 1.2;
+  nca.Optimizer().MaxIterations() = 300000;
+  nca.Optimizer().Tolerance() = 0;
+  nca.Optimizer().Shuffle() = true;
+
+  arma::mat outputMatrix;
+  nca.LearnDistance(outputMatrix);
+
+  // Evaluate the learned transformation with the exact objective.
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  double initObj = sef.Evaluate(arma::eye<arma::mat>(2, 2));
+  double finalObj = sef.Evaluate(outputMatrix);
+
+  // finalObj must be less than initObj.
+  BOOST_REQUIRE_LT(finalObj, initObj);
+}
+
 BOOST_AUTO_TEST_CASE(NCALBFGSSimpleDataset)
 {
   // Useful but simple dataset with six points and two classes.
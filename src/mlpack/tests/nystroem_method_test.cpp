@@ -18,6 +18,7 @@
 #include <mlpack/methods/nystroem_method/ordered_selection.hpp>
 #include <mlpack/methods/nystroem_method/random_selection.hpp>
 #include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
+#include <mlpack/methods/nystroem_method/leverage_score_selection.hpp>
 #include <mlpack/methods/nystroem_method/nystroem_method.hpp>
 
 using namespace mlpack;
@@ -202,4 +203,71 @@ BOOST_AUTO_TEST_CASE(GermanTest)
   }
 }
 
+/**
+ * Make sure leverage-score sampling produces a reasonable rank-10
+ * approximation of a matrix with a strong rank-10 structure.
+ */
+BOOST_AUTO_TEST_CASE(LeverageScoreRank10Test)
+{
+  arma::mat data;
+  data.randu(500, 500); // Just so it's square.
+
+  // Use SVD and only keep the first ten singular vectors.
+  arma::mat U;
+  arma::vec s;
+  arma::mat V;
+  arma::svd(U, s, V, data);
+
+  // Don't set completely to 0; the hope is that K is still positive definite.
+  s.subvec(0, 9) += 1.0; // Make sure the first 10 singular vectors are large.
+  s.subvec(10, s.n_elem - 1).fill(1e-6);
+  arma::mat dataMod = U * arma::diagmat(s) * V.t();
+
+  // Add some noise.
+  dataMod += 1e-5 * arma::randu<arma::mat>(dataMod.n_rows, dataMod.n_cols);
+
+  // Calculate the true kernel matrix.
+  LinearKernel lk;
+  arma::mat kernel = dataMod.t() * dataMod;
+
+  size_t successes = 0;
+  for (size_t testTrial = 0; testTrial < 5; ++testTrial)
+  {
+    double normalizedFroAverage = 0.0;
+    for (size_t trial = 0; trial < 20; ++trial)
+    {
+      while (true)
+      {
+        LinearKernel lk;
+        NystroemMethod<LinearKernel, LeverageScoreSelection> nm(dataMod, lk,
+            10);
+
+        arma::mat g;
+        nm.Apply(g);
+
+        arma::mat approximation = g * g.t();
+
+        // Check the normalized Frobenius norm.
+        const double normalizedFro = arma::norm(kernel - approximation, "fro");
+
+        // Sometimes K' is singular. Unlucky.
+        if (normalizedFro != normalizedFro)
+          continue;
+
+        normalizedFroAverage += (normalizedFro / arma::norm(kernel, "fro"));
+        break;
+      }
+    }
+
+    normalizedFroAverage /= 20;
+    if (std::abs(normalizedFroAverage) <= 1e-3)
+    {
+      ++successes;
+      break;
+    }
+  }
+
+  BOOST_REQUIRE_GE(successes, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
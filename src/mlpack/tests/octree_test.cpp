@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/tree/octree.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -18,6 +19,7 @@
 
 using namespace mlpack;
 using namespace mlpack::math;
+using namespace mlpack::neighbor;
 using namespace mlpack::tree;
 using namespace mlpack::metric;
 using namespace mlpack::bound;
@@ -247,6 +249,86 @@ BOOST_AUTO_TEST_CASE(MaxNumChildrenTest)
   }
 }
 
+/**
+ * A function to count how many times each point of the dataset appears in a
+ * leaf of the tree.
+ */
+template<typename TreeType>
+void CountPoints(TreeType& node, arma::Col<size_t>& counts)
+{
+  for (size_t i = 0; i < node.NumPoints(); ++i)
+    counts[node.Point(i)]++;
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    CountPoints(node.Child(i), counts);
+}
+
+/**
+ * Make sure Morton-code-based construction builds a valid octree: every point
+ * held in exactly one leaf, non-overlapping children, correct furthest
+ * distances, and the dataset a permutation of the input.
+ */
+BOOST_AUTO_TEST_CASE(MortonBuildTest)
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+
+  Octree<> t1(dataset, MortonBuild(), 20);
+  Octree<> t2(std::move(dataset), MortonBuild(), 20);
+
+  BOOST_REQUIRE_EQUAL(t1.NumDescendants(), 1000);
+  BOOST_REQUIRE_EQUAL(t2.NumDescendants(), 1000);
+
+  CheckOverlap(t1);
+  CheckOverlap(t2);
+  CheckFurthestDistances(t1);
+  CheckFurthestDistances(t2);
+  CheckNumChildren(t1);
+  CheckNumChildren(t2);
+
+  arma::Col<size_t> counts(1000, arma::fill::zeros);
+  CountPoints(t1, counts);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+
+  // The reordered dataset must hold the same points as the input (which t1
+  // copied and t2 took ownership of), so per-dimension sums must agree.
+  arma::vec sums1 = arma::sum(t1.Dataset(), 1);
+  arma::vec sums2 = arma::sum(t2.Dataset(), 1);
+  for (size_t d = 0; d < 3; ++d)
+    BOOST_REQUIRE_CLOSE(sums1[d], sums2[d], 1e-10);
+}
+
+/**
+ * Make sure a Morton-built octree gives the same nearest neighbor distances as
+ * a naive search.
+ */
+BOOST_AUTO_TEST_CASE(MortonBuildSearchTest)
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::mat queries(3, 200, arma::fill::randu);
+
+  typedef Octree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, MortonBuild(), 20);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, Octree>
+      knn1(std::move(tree));
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(queries, 5, neighbors1, distances1);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, Octree>
+      knn2(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(queries, 5, neighbors2, distances2);
+
+  // The tree reorders its copy of the dataset, so the neighbor indices are not
+  // comparable, but the distances must agree.
+  for (size_t i = 0; i < distances1.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(distances1[i], distances2[i], 1e-10);
+}
+
 /**
  * Test the copy constructor.
  */
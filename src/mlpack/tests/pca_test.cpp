@@ -16,6 +16,7 @@
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_block_krylov_method.hpp>
+#include <mlpack/methods/pca/streaming_pca.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -337,5 +338,67 @@ BOOST_AUTO_TEST_CASE(PCAScalingTest)
   BOOST_REQUIRE_CLOSE(accu(eigval), 3.0, 0.1); // 10% tolerance.
 }
 
+/**
+ * Test that single-pass PCA over column batches matches exact PCA on the full
+ * matrix.
+ */
+BOOST_AUTO_TEST_CASE(StreamingPCATest)
+{
+  arma::mat data = arma::randu<arma::mat>(8, 600);
+
+  // Feed the data in batches of 128 points.
+  StreamingPCA spca;
+  for (size_t start = 0; start < data.n_cols; start += 128)
+  {
+    const size_t end = std::min((size_t) data.n_cols, start + 128) - 1;
+    spca.Accumulate(data.cols(start, end));
+  }
+
+  arma::vec streamEigVal;
+  arma::mat streamEigvec;
+  spca.Finalize(streamEigVal, streamEigvec);
+
+  PCA<> exactPCA;
+  arma::mat transformed;
+  arma::vec eigVal;
+  arma::mat eigvec;
+  exactPCA.Apply(data, transformed, eigVal, eigvec);
+
+  BOOST_REQUIRE_EQUAL(streamEigVal.n_elem, eigVal.n_elem);
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(streamEigVal[i], eigVal[i], 1e-5);
+    // Eigenvectors are only defined up to sign.
+    BOOST_REQUIRE_CLOSE(
+        std::abs(arma::dot(streamEigvec.col(i), eigvec.col(i))), 1.0, 1e-5);
+  }
+
+  // Batch-wise transformation must match the exact projection up to the signs
+  // of the components.
+  arma::mat streamTransformed;
+  spca.Transform(data, streamTransformed);
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+  {
+    const double sign =
+        (arma::dot(streamEigvec.col(i), eigvec.col(i)) < 0.0) ? -1.0 : 1.0;
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      BOOST_REQUIRE_SMALL(sign * streamTransformed(i, j) - transformed(i, j),
+          1e-8);
+    }
+  }
+
+  // The scaled variant must match scaled exact PCA, too.
+  StreamingPCA scaledSPCA(true);
+  scaledSPCA.Accumulate(data);
+  arma::vec scaledStreamEigVal;
+  arma::mat scaledStreamEigvec;
+  scaledSPCA.Finalize(scaledStreamEigVal, scaledStreamEigvec);
+
+  PCA<> scaledPCA(true);
+  scaledPCA.Apply(data, transformed, eigVal, eigvec);
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(scaledStreamEigVal[i], eigVal[i], 1e-5);
+}
 
 BOOST_AUTO_TEST_SUITE_END();
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/perceptron/perceptron.hpp>
+#include <mlpack/methods/perceptron/averaged_perceptron.hpp>
 #include <mlpack/methods/perceptron/learning_policies/simple_weight_update.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -255,4 +256,63 @@ BOOST_AUTO_TEST_CASE(SecondaryConstructor)
   Perceptron<> p2(p1);
 }
 
+/**
+ * The averaged perceptron should learn a simple linearly separable problem.
+ */
+BOOST_AUTO_TEST_CASE(AveragedPerceptronSeparableDataset)
+{
+  mat trainData;
+  trainData << 0 << 1 << 1 << 4 << 5 << 4 << 1 << 2 << 5 << endr
+            << 1 << 1 << 2 << 1 << 1 << 2 << 0 << 1 << 0 << endr;
+
+  Mat<size_t> labels;
+  labels << 0 << 0 << 0 << 1 << 1 << 1 << 0 << 0 << 1;
+
+  AveragedPerceptron<> p(trainData, labels.row(0), 2, 1000);
+
+  mat testData;
+  testData << 0 << 1 << 2 << 4 << 5 << 3 << endr
+           << 0 << 2 << 1 << 2 << 1 << 0 << endr;
+  Row<size_t> predictedLabels(testData.n_cols);
+  p.Classify(testData, predictedLabels);
+
+  BOOST_CHECK_EQUAL(predictedLabels(0, 0), 0);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 1), 0);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 2), 0);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 3), 1);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 4), 1);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 5), 1);
+}
+
+/**
+ * Instance weights should be able to suppress an outlier point for the
+ * averaged perceptron, just as they do for the sequential one.
+ */
+BOOST_AUTO_TEST_CASE(AveragedPerceptronInstanceWeights)
+{
+  mat trainData;
+  trainData << -1 << -2 << -3 << -4 << 2 << 3 << 4 << 5 << -2 << endr
+            <<  1 <<  2 <<  3 <<  4 << 2 << 3 << 4 << 5 <<  2 << endr;
+
+  Mat<size_t> labels;
+  labels << 0 << 0 << 0 << 0 << 1 << 1 << 1 << 1 << 1;
+
+  // The last point carries the wrong label but a tiny weight, so it should
+  // not sway the decision boundary.
+  rowvec instanceWeights("1 1 1 1 1 1 1 1 1e-8");
+
+  AveragedPerceptron<> p;
+  p.MaxIterations() = 100;
+  p.Train(trainData, labels.row(0), 2, instanceWeights);
+
+  mat testData;
+  testData << -3 << 3 << endr
+           <<  3 << 3 << endr;
+  Row<size_t> predictedLabels(testData.n_cols);
+  p.Classify(testData, predictedLabels);
+
+  BOOST_CHECK_EQUAL(predictedLabels(0, 0), 0);
+  BOOST_CHECK_EQUAL(predictedLabels(0, 1), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,105 @@
+/**
+ * @file prefetching_batch_sampler_test.cpp
+ *
+ * Test the PrefetchingBatchSampler class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/prefetching_batch_sampler.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+BOOST_AUTO_TEST_SUITE(PrefetchingBatchSamplerTest);
+
+/**
+ * Without shuffling, the sampler must reproduce the dataset in order, with
+ * a short last batch, and restart cleanly after Reset().
+ */
+BOOST_AUTO_TEST_CASE(InOrderBatchTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 10);
+  arma::mat responses = arma::randu<arma::mat>(2, 10);
+
+  PrefetchingBatchSampler<> sampler(data, responses, 4, false);
+
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::mat batch, batchResponses;
+    size_t seen = 0;
+    while (sampler.GetNextBatch(batch, batchResponses))
+    {
+      BOOST_REQUIRE_EQUAL(batch.n_cols, std::min<size_t>(4, 10 - seen));
+      BOOST_REQUIRE_EQUAL(batchResponses.n_cols, batch.n_cols);
+
+      for (size_t i = 0; i < batch.n_cols; ++i)
+      {
+        BOOST_REQUIRE_SMALL(arma::abs(batch.col(i) -
+            data.col(seen + i)).max(), 1e-10);
+        BOOST_REQUIRE_SMALL(arma::abs(batchResponses.col(i) -
+            responses.col(seen + i)).max(), 1e-10);
+      }
+      seen += batch.n_cols;
+    }
+
+    BOOST_REQUIRE_EQUAL(seen, 10);
+    sampler.Reset();
+  }
+}
+
+/**
+ * With shuffling, one epoch must cover every point exactly once, and the
+ * responses must stay aligned with their predictors.
+ */
+BOOST_AUTO_TEST_CASE(ShuffledEpochCoverageTest)
+{
+  arma::mat data(1, 20);
+  arma::mat responses(1, 20);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    data(0, i) = (double) i;
+    responses(0, i) = 2.0 * i;
+  }
+
+  PrefetchingBatchSampler<> sampler(data, responses, 6);
+
+  arma::mat batch, batchResponses;
+  std::vector<size_t> seen;
+  while (sampler.GetNextBatch(batch, batchResponses))
+  {
+    for (size_t i = 0; i < batch.n_cols; ++i)
+    {
+      seen.push_back((size_t) batch(0, i));
+      BOOST_REQUIRE_CLOSE(batchResponses(0, i), 2.0 * batch(0, i), 1e-10);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(seen.size(), 20);
+  std::sort(seen.begin(), seen.end());
+  for (size_t i = 0; i < 20; ++i)
+    BOOST_REQUIRE_EQUAL(seen[i], i);
+}
+
+/**
+ * Mismatched predictors and responses, or a zero batch size, must throw.
+ */
+BOOST_AUTO_TEST_CASE(InvalidConstructionTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 10);
+  arma::mat badResponses = arma::randu<arma::mat>(2, 9);
+  arma::mat responses = arma::randu<arma::mat>(2, 10);
+
+  BOOST_REQUIRE_THROW(PrefetchingBatchSampler<>(data, badResponses, 4),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(PrefetchingBatchSampler<>(data, responses, 0),
+      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,140 @@
+/**
+ * @file preprocess_pipeline_test.cpp
+ *
+ * Test the PreprocessPipeline class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/preprocess_pipeline.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+BOOST_AUTO_TEST_SUITE(PreprocessPipelineTest);
+
+/**
+ * A fused min-max scale must match scaling each dimension by hand.
+ */
+BOOST_AUTO_TEST_CASE(PipelineMinMaxScaleTest)
+{
+  arma::mat data(5, 300, arma::fill::randn);
+  data.row(2) *= 40.0; // Give the dimensions different ranges.
+  arma::mat expected = data;
+
+  PreprocessPipeline<> pipeline;
+  pipeline.MinMaxScale(0.0, 1.0);
+  pipeline.Process(data);
+
+  for (size_t d = 0; d < expected.n_rows; ++d)
+  {
+    const double minimum = expected.row(d).min();
+    const double range = expected.row(d).max() - minimum;
+    for (size_t i = 0; i < expected.n_cols; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(data(d, i),
+          (expected(d, i) - minimum) / range, 1e-8);
+    }
+  }
+
+  BOOST_REQUIRE_GE(data.min(), 0.0);
+  BOOST_REQUIRE_LE(data.max(), 1.0);
+}
+
+/**
+ * Imputation must fill NaN entries with the mean of the other entries in the
+ * dimension, and a chained standardization must use that same mean.
+ */
+BOOST_AUTO_TEST_CASE(PipelineImputeStandardizeTest)
+{
+  arma::mat data(3, 200, arma::fill::randu);
+  data(1, 17) = std::numeric_limits<double>::quiet_NaN();
+  data(1, 121) = std::numeric_limits<double>::quiet_NaN();
+
+  PreprocessPipeline<> pipeline;
+  pipeline.ImputeMean().StandardScale();
+  pipeline.Process(data);
+
+  BOOST_REQUIRE_EQUAL(data.has_nan(), false);
+
+  // The imputed entries took the dimension mean, so they standardize to zero.
+  BOOST_REQUIRE_SMALL(data(1, 17), 1e-8);
+  BOOST_REQUIRE_SMALL(data(1, 121), 1e-8);
+
+  // Every dimension must now have zero mean and unit variance (the pipeline
+  // uses the population variance).
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    BOOST_REQUIRE_SMALL(arma::mean(data.row(d)), 1e-8);
+    const arma::rowvec centered = data.row(d) - arma::mean(data.row(d));
+    BOOST_REQUIRE_CLOSE(arma::mean(centered % centered), 1.0, 1e-6);
+  }
+}
+
+/**
+ * A full impute -> scale -> binarize -> split chain in one call.
+ */
+BOOST_AUTO_TEST_CASE(PipelineChainSplitTest)
+{
+  arma::mat data(4, 500, arma::fill::randn);
+  data(0, 3) = std::numeric_limits<double>::quiet_NaN();
+
+  PreprocessPipeline<> pipeline;
+  pipeline.ImputeMean().MinMaxScale(0.0, 1.0).Binarize(0.5);
+
+  arma::mat trainData, testData;
+  pipeline.Process(data, trainData, testData, 0.2);
+
+  BOOST_REQUIRE_EQUAL(trainData.n_cols, 400);
+  BOOST_REQUIRE_EQUAL(testData.n_cols, 100);
+
+  // After binarization every element is 0 or 1.
+  for (size_t i = 0; i < trainData.n_elem; ++i)
+    BOOST_REQUIRE(trainData[i] == 0.0 || trainData[i] == 1.0);
+  for (size_t i = 0; i < testData.n_elem; ++i)
+    BOOST_REQUIRE(testData[i] == 0.0 || testData[i] == 1.0);
+}
+
+/**
+ * Streaming execution must give the same result as in-memory execution.
+ */
+BOOST_AUTO_TEST_CASE(PipelineStreamingTest)
+{
+  arma::mat data(6, 350, arma::fill::randn);
+
+  // Write the raw column-major file the StreamingDataset reads.
+  std::ofstream f("pipeline_in.bin", std::ios::binary);
+  f.write((const char*) data.memptr(), data.n_elem * sizeof(double));
+  f.close();
+
+  PreprocessPipeline<> pipeline;
+  pipeline.StandardScale().Binarize(0.0);
+
+  // Batch size 64 does not divide 350, so the last batch is short.
+  StreamingDataset<> input("pipeline_in.bin", "", 6, 0, 64);
+  pipeline.Process(input, "pipeline_out.bin");
+
+  arma::mat expected = data;
+  pipeline.Process(expected);
+
+  arma::mat output(6, 350);
+  std::ifstream g("pipeline_out.bin", std::ios::binary);
+  g.read((char*) output.memptr(), output.n_elem * sizeof(double));
+  BOOST_REQUIRE_EQUAL(g.gcount(),
+      (std::streamsize) (output.n_elem * sizeof(double)));
+  g.close();
+
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(output[i] + 1.0, expected[i] + 1.0, 1e-8);
+
+  remove("pipeline_in.bin");
+  remove("pipeline_out.bin");
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/bindings/python/py_option.hpp>
+#include <mlpack/bindings/python/mlpack/cli_util.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -101,6 +102,46 @@ BOOST_AUTO_TEST_CASE(GetParamMatTest)
     BOOST_REQUIRE_EQUAL((*output)[i], 1.0);
 }
 
+/**
+ * SetParam() must not copy matrix elements: an owned matrix should have its
+ * memory stolen, and a matrix aliasing external memory (like an adopted numpy
+ * buffer) should be stored as an alias of the same memory.
+ */
+BOOST_AUTO_TEST_CASE(SetParamZeroCopyTest)
+{
+  CLI::ClearSettings();
+  programName = "test";
+  PyOption<arma::mat> po(arma::mat(), "mat", "mat2", "m", "arma::mat", false,
+      true, true);
+  CLI::RestoreSettings(programName);
+
+  // An owned matrix should be moved, not copied.
+  arma::mat owned(50, 50, arma::fill::randu);
+  const double* ownedMem = owned.memptr();
+  util::SetParam("mat", owned);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("mat").memptr(), ownedMem);
+
+  // A matrix that merely aliases memory it does not own (mem_state 1, like an
+  // adopted numpy buffer) should be stored as an alias of that same memory.
+  arma::mat buffer(50, 50, arma::fill::randu);
+  arma::mat alias(buffer.memptr(), buffer.n_rows, buffer.n_cols, false, false);
+  util::SetParam("mat", alias);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("mat").memptr(),
+      buffer.memptr());
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("mat").n_rows, 50);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("mat").n_cols, 50);
+
+  // The stored parameter must not believe it owns the aliased memory.
+  BOOST_REQUIRE_NE(CLI::GetParam<arma::mat>("mat").mem_state, 0);
+
+  for (size_t i = 0; i < buffer.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("mat")[i], buffer[i]);
+
+  // Release the parameter's alias before the buffer goes out of scope.
+  CLI::GetParam<arma::mat>("mat") = arma::mat();
+  CLI::ClearSettings();
+}
+
 /**
  * All of the other functions are implicitly tested simply by compilation.
  */
@@ -102,6 +102,105 @@ BOOST_AUTO_TEST_CASE(CartPoleWithDQN)
   BOOST_REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task with vectorized environment rollouts.
+BOOST_AUTO_TEST_CASE(CartPoleWithVectorizedDQN)
+{
+  // Set up the network.
+  FFN<MeanSquaredError<>, GaussianInitialization> model(MeanSquaredError<>(),
+      GaussianInitialization(0, 0.001));
+  model.Add<Linear<>>(4, 128);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(128, 128);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(model), AdamUpdate, decltype(policy)>
+      agent(std::move(config), std::move(model), std::move(policy),
+      std::move(replayMethod));
+
+  arma::running_stat<double> averageReturn;
+  size_t episodes = 0;
+  bool converged = true;
+  while (true)
+  {
+    // Each call rolls out four environments in lockstep; the mean return is
+    // directly comparable to the serial Episode() return.
+    double episodeReturn = agent.VectorizedEpisode(4);
+    averageReturn(episodeReturn);
+    episodes += 4;
+
+    if (episodes > 1000)
+    {
+      Log::Debug << "Cart Pole with vectorized DQN failed." << std::endl;
+      converged = false;
+      break;
+    }
+
+    Log::Debug << "Average return: " << averageReturn.mean()
+        << " Episode return: " << episodeReturn << std::endl;
+    if (averageReturn.mean() > 35)
+    {
+      agent.Deterministic() = true;
+      arma::running_stat<double> testReturn;
+      for (size_t i = 0; i < 10; ++i)
+        testReturn(agent.Episode());
+
+      Log::Debug << "Average return in deterministic test: "
+          << testReturn.mean() << std::endl;
+      break;
+    }
+  }
+  BOOST_REQUIRE(converged);
+}
+
+//! Test that batched replay storage matches repeated single stores.
+BOOST_AUTO_TEST_CASE(RandomReplayStoreBatchTest)
+{
+  // Small capacity so that the batch wraps around the ring buffer.
+  RandomReplay<CartPole> single(5, 12);
+  RandomReplay<CartPole> batched(5, 12);
+
+  const size_t batchSize = 7;
+  arma::mat batchStates = arma::randu<arma::mat>(4, batchSize);
+  arma::mat batchNextStates = arma::randu<arma::mat>(4, batchSize);
+  arma::icolvec batchActions(batchSize);
+  arma::colvec batchRewards = arma::randu<arma::colvec>(batchSize);
+  arma::icolvec batchIsTerminal(batchSize, arma::fill::zeros);
+  for (size_t i = 0; i < batchSize; ++i)
+    batchActions(i) = i % 2;
+
+  // Store the same three batches one transition at a time and as whole
+  // batches; the resulting buffers must be identical.
+  for (size_t round = 0; round < 3; ++round)
+  {
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      CartPole::State state(batchStates.col(i));
+      CartPole::State nextState(batchNextStates.col(i));
+      single.Store(state, CartPole::Action(batchActions(i)),
+          batchRewards(i), nextState, batchIsTerminal(i));
+    }
+
+    batched.StoreBatch(batchStates, batchActions, batchRewards,
+        batchNextStates, batchIsTerminal);
+
+    BOOST_REQUIRE_EQUAL(single.Size(), batched.Size());
+  }
+}
+
 //! Test Double DQN in Cart Pole task.
 BOOST_AUTO_TEST_CASE(CartPoleWithDoubleDQN)
 {
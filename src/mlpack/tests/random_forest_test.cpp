@@ -116,6 +116,39 @@ BOOST_AUTO_TEST_CASE(EmptyClassifyTest)
       pointProbabilities), std::invalid_argument);
 }
 
+/**
+ * Make sure training is reproducible: each tree is grown from its own
+ * pre-drawn seed, so two forests trained from the same random seed must be
+ * identical regardless of how the trees were scheduled across threads.
+ */
+BOOST_AUTO_TEST_CASE(ReproducibleTrainingTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  math::RandomSeed(100);
+  RandomForest<> rf1(dataset, labels, 3, 10 /* 10 trees */, 5);
+  math::RandomSeed(100);
+  RandomForest<> rf2(dataset, labels, 3, 10 /* 10 trees */, 5);
+
+  // The two forests must agree on every training point, both in the batch
+  // Classify() and the single-point overload (which accumulates over the
+  // trees in parallel).
+  arma::Row<size_t> predictions1, predictions2;
+  rf1.Classify(dataset, predictions1);
+  rf2.Classify(dataset, predictions2);
+
+  BOOST_REQUIRE_EQUAL(predictions1.n_elem, predictions2.n_elem);
+  for (size_t i = 0; i < predictions1.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(predictions1[i], predictions2[i]);
+    BOOST_REQUIRE_EQUAL(rf1.Classify(dataset.col(i)), predictions1[i]);
+  }
+}
+
 /**
  * Test unweighted numeric learning, making sure that we get better performance
  * than a single decision tree.
@@ -395,4 +428,32 @@ BOOST_AUTO_TEST_CASE(SerializationTest)
       binaryProbabilities);
 }
 
+/**
+ * Test that extra-trees learning gives reasonable accuracy on numeric data.
+ */
+BOOST_AUTO_TEST_CASE(ExtraTreesNumericLearningTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  // Build an extra-trees forest; no bootstrap, random split thresholds.
+  ExtraTrees<> et(dataset, labels, 3, 20 /* 20 trees */, 5);
+
+  // Get performance statistics on test data.
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> etPredictions;
+  et.Classify(testDataset, etPredictions);
+
+  // Calculate the number of correct points.
+  size_t etCorrect = arma::accu(etPredictions == testLabels);
+  BOOST_REQUIRE_GE(etCorrect, size_t(0.7 * testDataset.n_cols));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
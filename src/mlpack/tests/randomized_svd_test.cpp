@@ -64,4 +64,114 @@ BOOST_AUTO_TEST_CASE(RandomizedSVDReconstructionError)
   BOOST_REQUIRE_SMALL(error, 1e-5);
 }
 
+/**
+ * Warm starting from the singular vectors of a previous decomposition should
+ * give a result at least as accurate as a cold start, even with very few
+ * power iterations.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedSVDWarmStartTest)
+{
+  arma::mat U = arma::randn<arma::mat>(3, 20);
+  arma::mat V = arma::randn<arma::mat>(10, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  arma::mat data = arma::trans(U * arma::diagmat(s) * V.t());
+
+  // Center the data into a temporary matrix.
+  arma::mat centeredData;
+  math::Center(data, centeredData);
+
+  // First, a well-converged cold solve to produce the seed basis.
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.Apply(data, U1, s1, V1, 3);
+
+  // Now warm start a solve with a single power iteration from the previous
+  // basis; data.n_rows > data.n_cols, so the basis is the left singular
+  // vectors.
+  svd::RandomizedSVD warmSVD(0, 1);
+  warmSVD.Basis() = U1;
+  warmSVD.Apply(data, U2, s2, V2, 3);
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  const double error = arma::norm(centeredData - reconstruct, "frob") /
+      arma::norm(centeredData, "frob");
+  BOOST_REQUIRE_SMALL(error, 1e-5);
+}
+
+/**
+ * The uncentered sparse path should recover the factorization of a low-rank
+ * matrix in both orientations, without densifying the input.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedSVDSparseUncenteredTest)
+{
+  // An exactly rank-3 matrix with well-separated singular values.
+  arma::mat dense = arma::randn<arma::mat>(50, 3) *
+      arma::diagmat(arma::vec("10 5 1")) * arma::randn<arma::mat>(3, 80);
+  const arma::sp_mat data(dense);
+
+  arma::mat U1, V1, U2, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, dense);
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.Apply(data, U2, s2, V2, 3, false);
+
+  for (size_t i = 0; i < 3; ++i)
+    BOOST_REQUIRE_CLOSE(s2[i], s1[i], 1e-5);
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  double error = arma::norm(dense - reconstruct, "frob") /
+      arma::norm(dense, "frob");
+  BOOST_REQUIRE_SMALL(error, 1e-5);
+
+  // The other orientation exercises the column-space branch.
+  const arma::sp_mat dataT(dense.t());
+  rSVD.Apply(dataT, U2, s2, V2, 3, false);
+
+  for (size_t i = 0; i < 3; ++i)
+    BOOST_REQUIRE_CLOSE(s2[i], s1[i], 1e-5);
+
+  reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  error = arma::norm(dense.t() - reconstruct, "frob") /
+      arma::norm(dense, "frob");
+  BOOST_REQUIRE_SMALL(error, 1e-5);
+}
+
+/**
+ * Iterating in single precision with a double-precision final projection
+ * should still recover the factorization, just with a looser tolerance.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedSVDSparseSinglePrecisionTest)
+{
+  arma::mat dense = arma::randn<arma::mat>(50, 3) *
+      arma::diagmat(arma::vec("10 5 1")) * arma::randn<arma::mat>(3, 80);
+  const arma::sp_mat data(dense);
+
+  arma::mat U1, V1, U2, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, dense);
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.SinglePrecision() = true;
+  rSVD.Apply(data, U2, s2, V2, 3, false);
+
+  for (size_t i = 0; i < 3; ++i)
+    BOOST_REQUIRE_CLOSE(s2[i], s1[i], 1e-2);
+
+  const arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  const double error = arma::norm(dense - reconstruct, "frob") /
+      arma::norm(dense, "frob");
+  BOOST_REQUIRE_SMALL(error, 1e-4);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,7 @@
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/methods/range_search/rs_model.hpp>
+#include <mlpack/methods/range_search/spatial_join.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -1072,6 +1073,99 @@ BOOST_AUTO_TEST_CASE(EmptySearchTest)
       distances), std::invalid_argument);
 }
 
+/**
+ * The streaming callback overload of Search() must report exactly the results
+ * that the materializing overload returns, in every search mode (so that the
+ * index mappings for rearranged datasets are exercised).
+ */
+BOOST_AUTO_TEST_CASE(CallbackSearchTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 500);
+  arma::mat queries = arma::randu<arma::mat>(5, 150);
+  const math::Range range(0.25, 1.05);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool single = (mode == 1);
+    RangeSearch<> rs(data, naive, single);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queries, range, neighbors, distances);
+
+    // Collect the streamed results into the same shape of object.
+    vector<vector<size_t>> streamedNeighbors(queries.n_cols);
+    vector<vector<double>> streamedDistances(queries.n_cols);
+    rs.Search(queries, range,
+        [&](const size_t q, const size_t r, const double d)
+        {
+          streamedNeighbors[q].push_back(r);
+          streamedDistances[q].push_back(d);
+        });
+
+    vector<vector<pair<double, size_t>>> sorted, streamedSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(streamedNeighbors, streamedDistances, streamedSorted);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(sorted[i].size(), streamedSorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(sorted[i][j].second, streamedSorted[i][j].second);
+        BOOST_REQUIRE_CLOSE(sorted[i][j].first, streamedSorted[i][j].first,
+            1e-5);
+      }
+    }
+  }
+}
+
+/**
+ * The CSR sink must collect the same results as the materializing
+ * monochromatic Search(), grouped correctly by query point.
+ */
+BOOST_AUTO_TEST_CASE(CSRResultSinkTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 400);
+  const math::Range range(0.3, 1.1);
+
+  RangeSearch<> rs(data);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(range, neighbors, distances);
+
+  CSRResultSink csr(data.n_cols);
+  rs.Search(range, csr);
+
+  vector<size_t> offsets, csrNeighbors;
+  vector<double> csrDistances;
+  csr.Finalize(offsets, csrNeighbors, csrDistances);
+
+  BOOST_REQUIRE_EQUAL(offsets.size(), data.n_cols + 1);
+
+  // Unpack each query point's run and compare against the materialized
+  // results.
+  vector<vector<pair<double, size_t>>> sorted;
+  SortResults(neighbors, distances, sorted);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    vector<pair<double, size_t>> run;
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+      run.push_back(make_pair(csrDistances[j], csrNeighbors[j]));
+    sort(run.begin(), run.end());
+
+    BOOST_REQUIRE_EQUAL(run.size(), sorted[i].size());
+    for (size_t j = 0; j < run.size(); ++j)
+    {
+      BOOST_REQUIRE_EQUAL(run[j].second, sorted[i][j].second);
+      BOOST_REQUIRE_CLOSE(run[j].first, sorted[i][j].first, 1e-5);
+    }
+  }
+}
+
 /**
  * Make sure things work right after Train() is called.
  */
@@ -1696,4 +1790,104 @@ BOOST_AUTO_TEST_CASE(MoveOperatorNaiveTest)
   }
 }
 
+/**
+ * SpatialJoin::Join() must stream exactly the pairs that a bichromatic
+ * RangeSearch::Search() reports, and the trees must be reusable across
+ * several ranges.
+ */
+BOOST_AUTO_TEST_CASE(SpatialJoinTest)
+{
+  arma::mat queries = arma::randu<arma::mat>(5, 150);
+  arma::mat data = arma::randu<arma::mat>(5, 400);
+
+  SpatialJoin<> join(queries, data);
+
+  const math::Range ranges[2] = { math::Range(0.2, 0.9),
+                                  math::Range(0.0, 0.5) };
+  for (size_t r = 0; r < 2; ++r)
+  {
+    RangeSearch<> rs(data);
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queries, ranges[r], neighbors, distances);
+
+    // Collect the streamed results; the callback may run concurrently, so the
+    // shared vectors have to be guarded.
+    vector<vector<size_t>> joinNeighbors(queries.n_cols);
+    vector<vector<double>> joinDistances(queries.n_cols);
+    join.Join(ranges[r],
+        [&](const size_t q, const size_t ref, const double d)
+        {
+          #pragma omp critical
+          {
+            joinNeighbors[q].push_back(ref);
+            joinDistances[q].push_back(d);
+          }
+        });
+
+    vector<vector<pair<double, size_t>>> sorted, joinSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(joinNeighbors, joinDistances, joinSorted);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(sorted[i].size(), joinSorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(sorted[i][j].second, joinSorted[i][j].second);
+        BOOST_REQUIRE_CLOSE(sorted[i][j].first, joinSorted[i][j].first, 1e-5);
+      }
+    }
+  }
+}
+
+/**
+ * SemiJoin() and AntiJoin() must agree with a brute-force existence check and
+ * partition the query set between them.
+ */
+BOOST_AUTO_TEST_CASE(SpatialJoinSemiAntiJoinTest)
+{
+  arma::mat queries = arma::randu<arma::mat>(5, 120);
+  arma::mat data = arma::randu<arma::mat>(5, 300);
+  const math::Range range(0.3, 0.6);
+
+  // Brute-force existence flags, in the original point order.
+  vector<char> bruteMatched(queries.n_cols, 0);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      const double d = metric::EuclideanDistance::Evaluate(queries.col(i),
+          data.col(j));
+      if (range.Contains(d))
+      {
+        bruteMatched[i] = 1;
+        break;
+      }
+    }
+  }
+
+  SpatialJoin<> join(queries, data);
+
+  vector<size_t> matched, unmatched;
+  join.SemiJoin(range, matched);
+  join.AntiJoin(range, unmatched);
+
+  BOOST_REQUIRE_EQUAL(matched.size() + unmatched.size(), queries.n_cols);
+
+  vector<char> seen(queries.n_cols, 0);
+  for (size_t i = 0; i < matched.size(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(bruteMatched[matched[i]], 1);
+    seen[matched[i]] = 1;
+  }
+  for (size_t i = 0; i < unmatched.size(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(bruteMatched[unmatched[i]], 0);
+    // Every query point must appear in exactly one of the two result sets.
+    BOOST_REQUIRE_EQUAL(seen[unmatched[i]], 0);
+    seen[unmatched[i]] = 1;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
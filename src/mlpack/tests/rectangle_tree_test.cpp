@@ -608,6 +608,106 @@ BOOST_AUTO_TEST_CASE(XTreeTraverserTest)
   }
 }
 
+/**
+ * A function to check that every leaf of an STR bulk-loaded tree is packed
+ * full, except possibly one leaf holding the leftover points.
+ */
+template<typename TreeType>
+size_t CountUnderfullLeaves(const TreeType& tree)
+{
+  if (tree.IsLeaf())
+    return (tree.Count() < tree.MaxLeafSize()) ? 1 : 0;
+
+  size_t underfull = 0;
+  for (size_t i = 0; i < tree.NumChildren(); i++)
+    underfull += CountUnderfullLeaves(tree.Child(i));
+  return underfull;
+}
+
+// Test that STR bulk loading builds a valid tree with fully packed leaves.
+BOOST_AUTO_TEST_CASE(StrBulkLoadPackingTest)
+{
+  arma::mat dataset;
+  dataset.randu(8, 1010); // 1010 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  TreeType tree(dataset, StrBulkLoad(), 20, 6, 5, 2);
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1010);
+
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+
+  // 1010 points do not divide into leaves of 20 evenly, so exactly one leaf
+  // may hold the 10 leftover points; every other leaf must be full.
+  BOOST_REQUIRE_LE(CountUnderfullLeaves(tree), 1);
+
+  // Make sure no point was duplicated or dropped.
+  std::vector<arma::vec*> allPoints = GetAllPointsInTree(tree);
+  BOOST_REQUIRE_EQUAL(allPoints.size(), 1010);
+  for (size_t i = 0; i < allPoints.size(); i++)
+    delete allPoints[i];
+}
+
+// A test to ensure that searches in STR bulk-loaded R* and X trees give the
+// same results as a naive search.
+BOOST_AUTO_TEST_CASE(StrBulkLoadTraverserTest)
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  arma::Mat<size_t> neighbors3;
+  arma::mat distances3;
+
+  typedef RStarTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RStarTreeType;
+  RStarTreeType rTree(dataset, StrBulkLoad(), 20, 6, 5, 2);
+
+  BOOST_REQUIRE_EQUAL(rTree.NumDescendants(), 1000);
+  CheckContainment(rTree);
+  CheckExactContainment(rTree);
+  CheckHierarchy(rTree);
+  CheckNumDescendants(rTree);
+
+  typedef XTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> XTreeType;
+  XTreeType xTree(dataset, StrBulkLoad(), 20, 6, 5, 2);
+
+  BOOST_REQUIRE_EQUAL(xTree.NumDescendants(), 1000);
+  CheckContainment(xTree);
+  CheckExactContainment(xTree);
+  CheckHierarchy(xTree);
+  CheckNumDescendants(xTree);
+
+  // Nearest neighbor search with the bulk-loaded trees.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RStarTree> knn1(std::move(rTree), SINGLE_TREE_MODE);
+  knn1.Search(5, neighbors1, distances1);
+
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      XTree> knn2(std::move(xTree), SINGLE_TREE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  // Nearest neighbor search the naive way.
+  KNN knn3(dataset, NAIVE_MODE);
+  knn3.Search(5, neighbors3, distances3);
+
+  for (size_t i = 0; i < neighbors3.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors1[i], neighbors3[i]);
+    BOOST_REQUIRE_EQUAL(distances1[i], distances3[i]);
+    BOOST_REQUIRE_EQUAL(neighbors2[i], neighbors3[i]);
+    BOOST_REQUIRE_EQUAL(distances2[i], distances3[i]);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(HilbertRTreeTraverserTest)
 {
   arma::mat dataset;
@@ -0,0 +1,85 @@
+/**
+ * @file reorder_locality_test.cpp
+ *
+ * Test the ReorderLocality() dataset reordering utility.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/reorder_locality.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+BOOST_AUTO_TEST_SUITE(ReorderLocalityTest);
+
+/**
+ * The reordered dataset must be a column permutation of the original, and the
+ * mapping must translate every new index back to its old one.
+ */
+BOOST_AUTO_TEST_CASE(PermutationConsistencyTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 50) - 0.5;
+  arma::mat original = data;
+
+  std::vector<size_t> mapping;
+  ReorderLocality(data, mapping);
+
+  BOOST_REQUIRE_EQUAL(data.n_rows, original.n_rows);
+  BOOST_REQUIRE_EQUAL(data.n_cols, original.n_cols);
+  BOOST_REQUIRE_EQUAL(mapping.size(), original.n_cols);
+
+  std::vector<size_t> sortedMapping = mapping;
+  std::sort(sortedMapping.begin(), sortedMapping.end());
+  for (size_t i = 0; i < sortedMapping.size(); ++i)
+    BOOST_REQUIRE_EQUAL(sortedMapping[i], i);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::abs(data.col(i) -
+        original.col(mapping[i])).max(), 1e-10);
+  }
+}
+
+/**
+ * In one dimension the address order is the numeric order, including negative
+ * values.
+ */
+BOOST_AUTO_TEST_CASE(OneDimensionalOrderTest)
+{
+  arma::mat data("3.0 -1.5 0.0 2.25 -7.0 0.5");
+
+  std::vector<size_t> mapping;
+  ReorderLocality(data, mapping);
+
+  for (size_t i = 1; i < data.n_cols; ++i)
+    BOOST_REQUIRE_LT(data(0, i - 1), data(0, i));
+}
+
+/**
+ * The two mappings returned by the two-mapping overload must be inverses of
+ * each other.
+ */
+BOOST_AUTO_TEST_CASE(InverseMappingTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 30);
+
+  std::vector<size_t> oldFromNew, newFromOld;
+  ReorderLocality(data, oldFromNew, newFromOld);
+
+  BOOST_REQUIRE_EQUAL(oldFromNew.size(), 30);
+  BOOST_REQUIRE_EQUAL(newFromOld.size(), 30);
+  for (size_t i = 0; i < 30; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(newFromOld[oldFromNew[i]], i);
+    BOOST_REQUIRE_EQUAL(oldFromNew[newFromOld[i]], i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
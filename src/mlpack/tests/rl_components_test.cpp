@@ -19,6 +19,7 @@
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/prioritized_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -166,6 +167,93 @@ BOOST_AUTO_TEST_CASE(RandomReplayTest)
   }
 }
 
+/**
+ * Construct a sum tree and check prefix-sum lookups against the weights.
+ */
+BOOST_AUTO_TEST_CASE(SumTreeTest)
+{
+  SumTree<double> tree(5);
+  tree.Set(0, 1.0);
+  tree.Set(1, 3.0);
+  tree.Set(2, 0.0);
+  tree.Set(3, 2.0);
+  tree.Set(4, 4.0);
+
+  BOOST_REQUIRE_CLOSE(10.0, tree.Sum(), 1e-5);
+  BOOST_REQUIRE_CLOSE(3.0, tree.Get(1), 1e-5);
+
+  //! Leaf 2 has zero weight, so mass 4.0 must fall in leaf 3.
+  BOOST_REQUIRE_EQUAL(0, tree.FindPrefixSum(0.5));
+  BOOST_REQUIRE_EQUAL(1, tree.FindPrefixSum(1.0));
+  BOOST_REQUIRE_EQUAL(1, tree.FindPrefixSum(3.5));
+  BOOST_REQUIRE_EQUAL(3, tree.FindPrefixSum(4.0));
+  BOOST_REQUIRE_EQUAL(4, tree.FindPrefixSum(9.9));
+
+  //! A batched update must leave the tree identical to individual updates.
+  arma::uvec indices("0 2 4");
+  arma::vec weights("5.0 1.0 0.5");
+  tree.BatchSet(indices, weights);
+
+  BOOST_REQUIRE_CLOSE(11.5, tree.Sum(), 1e-5);
+  BOOST_REQUIRE_CLOSE(5.0, tree.Get(0), 1e-5);
+  BOOST_REQUIRE_CLOSE(1.0, tree.Get(2), 1e-5);
+  BOOST_REQUIRE_CLOSE(0.5, tree.Get(4), 1e-5);
+  BOOST_REQUIRE_EQUAL(0, tree.FindPrefixSum(4.9));
+  BOOST_REQUIRE_EQUAL(4, tree.FindPrefixSum(11.2));
+}
+
+/**
+ * Construct a prioritized replay instance and check if it works as
+ * it should be.
+ */
+BOOST_AUTO_TEST_CASE(PrioritizedReplayTest)
+{
+  PrioritizedReplay<MountainCar> replay(1, 3);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action = MountainCar::Action::forward;
+  MountainCar::State nextState;
+  double reward = env.Sample(state, action, nextState);
+  replay.Store(state, action, reward, nextState, env.IsTerminal(nextState));
+  arma::mat sampledState;
+  arma::icolvec sampledAction;
+  arma::colvec sampledReward;
+  arma::mat sampledNextState;
+  arma::icolvec sampledTerminal;
+
+  //! So far there should be only one record in the memory
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+
+  CheckMatrices(state.Encode(), sampledState);
+  BOOST_REQUIRE_EQUAL(action, arma::as_scalar(sampledAction));
+  BOOST_REQUIRE_CLOSE(reward, arma::as_scalar(sampledReward), 1e-5);
+  CheckMatrices(nextState.Encode(), sampledNextState);
+  BOOST_REQUIRE_EQUAL(1, replay.Size());
+  BOOST_REQUIRE_EQUAL(0, replay.SampledIndices()[0]);
+
+  //! Store two more records and push the priority of the first two down to
+  //! (nearly) zero; only the third record should then be sampled.
+  replay.Store(state, action, reward, nextState, false);
+  replay.Store(nextState, action, reward, state, true);
+
+  for (size_t i = 0; i < 30; ++i)
+  {
+    replay.Sample(sampledState, sampledAction, sampledReward,
+        sampledNextState, sampledTerminal);
+    if (replay.SampledIndices()[0] != 2)
+      replay.UpdatePriorities(arma::colvec("0.0"));
+  }
+
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+
+  BOOST_REQUIRE_EQUAL(2, replay.SampledIndices()[0]);
+  CheckMatrices(nextState.Encode(), sampledState);
+  CheckMatrices(state.Encode(), sampledNextState);
+  BOOST_REQUIRE_EQUAL(true, arma::as_scalar(sampledTerminal));
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
@@ -38,7 +38,7 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionEvaluate)
     labels(i) = math::RandInt(0, numClasses);
 
   // Create a SoftmaxRegressionFunction. Regularization term ignored.
-  SoftmaxRegressionFunction srf(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; i++)
@@ -83,9 +83,9 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionRegularizationEvaluate)
     labels(i) = math::RandInt(0, numClasses);
 
   // 3 objects for comparing regularization costs.
-  SoftmaxRegressionFunction srfNoReg(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srfSmallReg(data, labels, numClasses, 1);
-  SoftmaxRegressionFunction srfBigReg(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srfNoReg(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srfSmallReg(data, labels, numClasses, 1);
+  SoftmaxRegressionFunction<> srfBigReg(data, labels, numClasses, 20);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; i++)
@@ -125,8 +125,8 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionGradient)
 
   // 2 objects for 2 terms in the cost function. Each term contributes towards
   // the gradient and thus need to be checked independently.
-  SoftmaxRegressionFunction srf1(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srf2(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srf1(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf2(data, labels, numClasses, 20);
 
   // Create a random set of parameters.
   arma::mat parameters;
@@ -410,6 +410,38 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionOptimizerTrainTest)
   }
 }
 
+/**
+ * Test sparse and dense softmax regression and make sure they both work the
+ * same using the L-BFGS optimizer.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxRegressionSparseTrainTest)
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 800, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = math::RandInt(0, 2);
+
+  SoftmaxRegression sr(dataset.n_rows, 2);
+  SoftmaxRegression srSparse(dataset.n_rows, 2);
+  srSparse.Parameters() = sr.Parameters();
+
+  sr.Train(denseDataset, labels, 2);
+  srSparse.Train(dataset, labels, 2);
+
+  // Ensure that the parameters are the same.
+  BOOST_REQUIRE_EQUAL(sr.Parameters().n_elem, srSparse.Parameters().n_elem);
+  for (size_t i = 0; i < sr.Parameters().n_elem; ++i)
+  {
+    if (std::abs(sr.Parameters()[i]) < 1e-5)
+      BOOST_REQUIRE_SMALL(srSparse.Parameters()[i], 1e-4);
+    else
+      BOOST_REQUIRE_CLOSE(sr.Parameters()[i], srSparse.Parameters()[i], 5e-4);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SoftmaxRegressionClassifySinglePointTest)
 {
   const size_t points = 5000;
@@ -138,6 +138,36 @@ BOOST_AUTO_TEST_CASE(SparseCodingTestDictionaryStep)
   BOOST_REQUIRE_SMALL(normGradient, tol);
 }
 
+BOOST_AUTO_TEST_CASE(SparseCodingTestDictionaryCDStep)
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, 0.0, 30, 0.01, 1e-6);
+  mat Z;
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+  sc.Encode(X, Z);
+
+  const double objBefore = sc.Objective(X, Z);
+  sc.OptimizeDictionaryCD(X, Z);
+  const double objAfter = sc.Objective(X, Z);
+
+  // Every atom update minimizes the objective over that atom exactly, so the
+  // coordinate descent step cannot increase the objective; the updated atoms
+  // must also respect the unit-ball constraint.
+  BOOST_REQUIRE_LE(objAfter, objBefore + 1e-10);
+  for (uword j = 0; j < nAtoms; ++j)
+    BOOST_REQUIRE_LE(norm(sc.Dictionary().col(j), 2), 1.0 + 1e-10);
+}
+
 BOOST_AUTO_TEST_CASE(SerializationTest)
 {
   mat X = randu<mat>(100, 100);
@@ -0,0 +1,80 @@
+/**
+ * @file sparse_svm_test.cpp
+ *
+ * Test the dual coordinate descent sparse SVM trainer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/sparse_svm/sparse_svm.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::svm;
+
+BOOST_AUTO_TEST_SUITE(SparseSVMTest);
+
+/**
+ * Train on a linearly separable sparse problem; the trained model must
+ * classify the training set perfectly.
+ */
+BOOST_AUTO_TEST_CASE(SparseSVMSeparableTest)
+{
+  // Two well-separated Gaussian clouds, sparsified by zeroing small entries.
+  const size_t points = 500;
+  arma::mat dense(50, points, arma::fill::zeros);
+  arma::vec labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = (i % 2 == 0) ? 1.0 : -1.0;
+    // A handful of active features per point, shifted by the class.
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const size_t dim = math::RandInt(50);
+      dense(dim, i) = math::Random() + 3.0 * labels[i];
+    }
+  }
+  const arma::sp_mat dataset(dense);
+
+  SparseSVM svm(dataset, labels, 1.0, 200);
+
+  arma::vec predictions;
+  svm.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < points; ++i)
+    if (predictions[i] == labels[i])
+      correct++;
+
+  BOOST_REQUIRE_GT((double) correct / points, 0.99);
+}
+
+/**
+ * The dual coordinate descent trainer should terminate well before the
+ * iteration limit on an easy problem, and the weight vector must have the
+ * dataset's dimensionality.
+ */
+BOOST_AUTO_TEST_CASE(SparseSVMConvergenceTest)
+{
+  arma::mat dense(10, 100, arma::fill::zeros);
+  arma::vec labels(100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    labels[i] = (i < 50) ? 1.0 : -1.0;
+    dense(i % 10, i) = labels[i] * (1.0 + math::Random());
+  }
+  const arma::sp_mat dataset(dense);
+
+  SparseSVM svm(1.0, 500, 1e-4);
+  const size_t iterations = svm.Train(dataset, labels);
+
+  BOOST_REQUIRE_LT(iterations, 500);
+  BOOST_REQUIRE_EQUAL(svm.Parameters().n_elem, 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -13,6 +13,8 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/core/tree/spill_tree.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
+#include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
 #include <boost/test/unit_test.hpp>
 #include <stack>
 
@@ -308,4 +310,48 @@ BOOST_AUTO_TEST_CASE(SpillTreeMoveDatasetTest)
   BOOST_REQUIRE_EQUAL(tree.Dataset().n_cols, 1000);
 }
 
+/**
+ * The two-phase traverser (greedy descent, leaf scan, bounded backtracking)
+ * must return exact nearest neighbors, since the refinement phase revisits
+ * every sibling the candidate bound cannot prune.
+ */
+BOOST_AUTO_TEST_CASE(SpillTreeTwoPhaseTraverserTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 300);
+  arma::mat querySet = arma::randu<arma::mat>(3, 50);
+
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(referenceSet, 0.1);
+
+  typedef neighbor::NeighborSearchRules<neighbor::NearestNeighborSort,
+      EuclideanDistance, TreeType> RuleType;
+
+  EuclideanDistance metric;
+  const size_t k = 3;
+  RuleType rules(referenceSet, querySet, k, metric);
+
+  TreeType::TwoPhaseSingleTreeTraverser<RuleType> traverser(rules);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    traverser.Traverse(i, tree);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  rules.GetResults(neighbors, distances);
+
+  // Compare against brute-force nearest neighbors.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    arma::vec trueDistances(referenceSet.n_cols);
+    for (size_t j = 0; j < referenceSet.n_cols; ++j)
+    {
+      trueDistances(j) = metric.Evaluate(querySet.col(i),
+          referenceSet.col(j));
+    }
+    trueDistances = arma::sort(trueDistances);
+
+    for (size_t n = 0; n < k; ++n)
+      BOOST_REQUIRE_CLOSE(distances(n, i), trueDistances(n), 1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -170,4 +170,58 @@ BOOST_AUTO_TEST_CASE(SplitLabeledDataLargerTest)
   CheckDuplication(std::get<2>(value), std::get<3>(value));
 }
 
+/**
+ * SplitIndices() must produce a disjoint partition of all the indices without
+ * touching any data.
+ */
+BOOST_AUTO_TEST_CASE(SplitIndicesTest)
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(497, 0.3, trainIndices, testIndices);
+
+  BOOST_REQUIRE_EQUAL(trainIndices.n_elem, 497 - size_t(0.3 * 497));
+  BOOST_REQUIRE_EQUAL(testIndices.n_elem, size_t(0.3 * 497));
+
+  // Every index must be used exactly once.
+  arma::Col<size_t> counts(497, arma::fill::zeros);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    counts[trainIndices[i]]++;
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    counts[testIndices[i]]++;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
+
+/**
+ * StratifiedSplit() must keep each label's train/test proportions, even for
+ * rare labels.
+ */
+BOOST_AUTO_TEST_CASE(StratifiedSplitTest)
+{
+  // 400 points of label 0, 80 of label 1, and 20 of label 2.
+  mat input(3, 500);
+  input.randu();
+  Row<size_t> labels(500);
+  labels.cols(0, 399).fill(0);
+  labels.cols(400, 479).fill(1);
+  labels.cols(480, 499).fill(2);
+
+  mat trainData, testData;
+  Row<size_t> trainLabels, testLabels;
+  StratifiedSplit(input, labels, trainData, testData, trainLabels, testLabels,
+      0.25);
+
+  BOOST_REQUIRE_EQUAL(trainData.n_cols, trainLabels.n_elem);
+  BOOST_REQUIRE_EQUAL(testData.n_cols, testLabels.n_elem);
+  BOOST_REQUIRE_EQUAL(trainLabels.n_elem + testLabels.n_elem, 500);
+
+  // Each label must contribute exactly 25% of its points to the test set.
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 0), 100);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 1), 20);
+  BOOST_REQUIRE_EQUAL(arma::accu(testLabels == 2), 5);
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels == 0), 300);
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels == 1), 60);
+  BOOST_REQUIRE_EQUAL(arma::accu(trainLabels == 2), 15);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
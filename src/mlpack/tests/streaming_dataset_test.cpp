@@ -0,0 +1,174 @@
+/**
+ * @file streaming_dataset_test.cpp
+ *
+ * Test the StreamingDataset class and the FFN training overload that
+ * consumes it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
+
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+
+#include <ensmallen.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::data;
+
+BOOST_AUTO_TEST_SUITE(StreamingDatasetTest);
+
+//! Write a matrix to disk in the raw column-major layout the dataset reads.
+static void WriteRawBinary(const std::string& filename, const arma::mat& data)
+{
+  std::ofstream f(filename, std::ios::binary);
+  f.write((const char*) data.memptr(), data.n_elem * sizeof(double));
+  f.close();
+}
+
+/**
+ * The dataset must reproduce the files in order, batch by batch, with a
+ * short last batch, and restart cleanly after Reset().
+ */
+BOOST_AUTO_TEST_CASE(RoundTripBatchTest)
+{
+  arma::mat data = arma::randu<arma::mat>(4, 23);
+  arma::mat responses = arma::randu<arma::mat>(2, 23);
+
+  WriteRawBinary("streaming_x.bin", data);
+  WriteRawBinary("streaming_y.bin", responses);
+
+  // Batch size 5 does not divide 23, so the last batch holds 3 points.
+  StreamingDataset<> dataset("streaming_x.bin", "streaming_y.bin", 4, 2, 5);
+  BOOST_REQUIRE_EQUAL(dataset.NumPoints(), 23);
+
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::mat batch, batchResponses;
+    size_t seen = 0;
+    while (dataset.GetNextBatch(batch, batchResponses))
+    {
+      BOOST_REQUIRE_EQUAL(batch.n_rows, 4);
+      BOOST_REQUIRE_EQUAL(batch.n_cols, std::min<size_t>(5, 23 - seen));
+      BOOST_REQUIRE_EQUAL(batchResponses.n_rows, 2);
+      BOOST_REQUIRE_EQUAL(batchResponses.n_cols, batch.n_cols);
+
+      for (size_t i = 0; i < batch.n_cols; ++i)
+      {
+        BOOST_REQUIRE_SMALL(arma::abs(batch.col(i) -
+            data.col(seen + i)).max(), 1e-10);
+        BOOST_REQUIRE_SMALL(arma::abs(batchResponses.col(i) -
+            responses.col(seen + i)).max(), 1e-10);
+      }
+      seen += batch.n_cols;
+    }
+
+    BOOST_REQUIRE_EQUAL(seen, 23);
+
+    // Once the epoch is exhausted, further calls keep returning false and
+    // leave the outputs empty.
+    BOOST_REQUIRE(!dataset.GetNextBatch(batch, batchResponses));
+    BOOST_REQUIRE_EQUAL(batch.n_elem, 0);
+
+    dataset.Reset();
+  }
+
+  remove("streaming_x.bin");
+  remove("streaming_y.bin");
+}
+
+/**
+ * The unlabeled overload must yield the predictors alone.
+ */
+BOOST_AUTO_TEST_CASE(UnlabeledBatchTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 10);
+  WriteRawBinary("streaming_x.bin", data);
+
+  StreamingDataset<> dataset("streaming_x.bin", "", 3, 0, 4);
+
+  arma::mat batch;
+  size_t seen = 0;
+  while (dataset.GetNextBatch(batch))
+  {
+    for (size_t i = 0; i < batch.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(arma::abs(batch.col(i) -
+          data.col(seen + i)).max(), 1e-10);
+    seen += batch.n_cols;
+  }
+  BOOST_REQUIRE_EQUAL(seen, 10);
+
+  remove("streaming_x.bin");
+}
+
+/**
+ * A missing file, a predictors file whose size is not a multiple of the
+ * point size, and a responses file holding a different number of points must
+ * all throw.
+ */
+BOOST_AUTO_TEST_CASE(InvalidConstructionTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 10);
+  arma::mat shortResponses = arma::randu<arma::mat>(2, 9);
+
+  WriteRawBinary("streaming_x.bin", data);
+  WriteRawBinary("streaming_y.bin", shortResponses);
+
+  BOOST_REQUIRE_THROW(StreamingDataset<>("streaming_nonexistent.bin", "", 3,
+      0, 4), std::runtime_error);
+
+  // 30 doubles are not a multiple of a 4-row point.
+  BOOST_REQUIRE_THROW(StreamingDataset<>("streaming_x.bin", "", 4, 0, 4),
+      std::runtime_error);
+
+  // The responses file holds 9 points, the predictors file 10.
+  BOOST_REQUIRE_THROW(StreamingDataset<>("streaming_x.bin",
+      "streaming_y.bin", 3, 2, 4), std::runtime_error);
+
+  remove("streaming_x.bin");
+  remove("streaming_y.bin");
+}
+
+/**
+ * FFN::Train() must run multiple epochs over a streaming dataset, including
+ * a short final batch, and leave a usable model behind.
+ */
+BOOST_AUTO_TEST_CASE(FFNTrainStreamingTest)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 50);
+  arma::mat responses = arma::randu<arma::mat>(1, 50);
+
+  WriteRawBinary("streaming_x.bin", data);
+  WriteRawBinary("streaming_y.bin", responses);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(3, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 1);
+
+  // Batch size 16 does not divide 50, so each epoch ends with a short batch.
+  StreamingDataset<> dataset("streaming_x.bin", "streaming_y.bin", 3, 1, 16);
+  ens::RMSProp opt(0.01, 16, 0.88, 1e-8, 100, -1);
+  const double objective = model.Train(dataset, opt, 2);
+  BOOST_REQUIRE(std::isfinite(objective));
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  BOOST_REQUIRE_EQUAL(predictions.n_rows, 1);
+  BOOST_REQUIRE_EQUAL(predictions.n_cols, 50);
+  BOOST_REQUIRE(predictions.is_finite());
+
+  remove("streaming_x.bin");
+  remove("streaming_y.bin");
+}
+
+BOOST_AUTO_TEST_SUITE_END();
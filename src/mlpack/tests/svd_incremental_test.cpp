@@ -52,6 +52,28 @@ BOOST_AUTO_TEST_CASE(SVDIncompleteIncrementalConvergenceTest)
                    amf.TerminationPolicy().MaxIterations());
 }
 
+/**
+ * Test for convergence of lock-free parallel SGD learning on sparse input.
+ */
+BOOST_AUTO_TEST_CASE(SVDParallelSGDConvergenceTest)
+{
+  sp_mat data;
+  data.sprandn(100, 100, 0.2);
+
+  SVDParallelSGDLearning svd(0.01);
+  SimpleToleranceTermination<sp_mat> tt;
+
+  AMF<SimpleToleranceTermination<sp_mat>,
+      RandomInitialization,
+      SVDParallelSGDLearning> amf(tt, RandomInitialization(), svd);
+
+  mat m1, m2;
+  amf.Apply(data, 2, m1, m2);
+
+  BOOST_REQUIRE_NE(amf.TerminationPolicy().Iteration(),
+                   amf.TerminationPolicy().MaxIterations());
+}
+
 /**
  * Test for convergence of complete incremenal learning
  */
@@ -0,0 +1,148 @@
+/**
+ * @file task_pool_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the process-wide work-stealing task pool.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/task_pool.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+BOOST_AUTO_TEST_SUITE(TaskPoolTest);
+
+/**
+ * Every task submitted to a group runs exactly once, and Wait() does not
+ * return before all of them have finished.
+ */
+BOOST_AUTO_TEST_CASE(TaskGroupBasicTest)
+{
+  const size_t tasks = 200;
+  std::vector<size_t> runs(tasks, 0);
+
+  TaskGroup group;
+  for (size_t i = 0; i < tasks; ++i)
+    group.Run([&runs, i]() { ++runs[i]; });
+  group.Wait();
+
+  for (size_t i = 0; i < tasks; ++i)
+    BOOST_REQUIRE_EQUAL(runs[i], 1);
+}
+
+/**
+ * A task may create its own group and wait on it; the nested groups share
+ * the fixed set of pool threads instead of deadlocking or spawning more.
+ */
+BOOST_AUTO_TEST_CASE(NestedTaskGroupTest)
+{
+  const size_t outer = 8;
+  const size_t inner = 16;
+  std::atomic<size_t> count(0);
+
+  TaskGroup group;
+  for (size_t i = 0; i < outer; ++i)
+  {
+    group.Run([&count, inner]()
+    {
+      TaskGroup nested;
+      for (size_t j = 0; j < inner; ++j)
+        nested.Run([&count]() { ++count; });
+      nested.Wait();
+    });
+  }
+  group.Wait();
+
+  BOOST_REQUIRE_EQUAL(count.load(), outer * inner);
+}
+
+/**
+ * ParallelFor() always splits the range at multiples of the grain size,
+ * independent of the thread budget, and covers every index exactly once.
+ */
+BOOST_AUTO_TEST_CASE(ParallelForPartitionTest)
+{
+  const size_t begin = 3;
+  const size_t end = 103;
+  const size_t grain = 8;
+
+  std::mutex blockMutex;
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::vector<size_t> visits(end, 0);
+
+  ParallelFor(begin, end, grain,
+      [&](const size_t blockBegin, const size_t blockEnd)
+      {
+        for (size_t i = blockBegin; i < blockEnd; ++i)
+          ++visits[i];
+        std::lock_guard<std::mutex> lock(blockMutex);
+        blocks.push_back(std::make_pair(blockBegin, blockEnd));
+      });
+
+  // The block boundaries are fully determined by begin, end and grain.
+  std::sort(blocks.begin(), blocks.end());
+  BOOST_REQUIRE_EQUAL(blocks.size(), (end - begin + grain - 1) / grain);
+  for (size_t b = 0; b < blocks.size(); ++b)
+  {
+    BOOST_REQUIRE_EQUAL(blocks[b].first, begin + b * grain);
+    BOOST_REQUIRE_EQUAL(blocks[b].second,
+        std::min(end, begin + (b + 1) * grain));
+  }
+
+  for (size_t i = 0; i < begin; ++i)
+    BOOST_REQUIRE_EQUAL(visits[i], 0);
+  for (size_t i = begin; i < end; ++i)
+    BOOST_REQUIRE_EQUAL(visits[i], 1);
+}
+
+/**
+ * A reduction combined in block order gives bitwise identical results on
+ * every run, since the partition does not depend on scheduling.
+ */
+BOOST_AUTO_TEST_CASE(ParallelForDeterministicSumTest)
+{
+  const size_t n = 1000;
+  const size_t grain = 32;
+  arma::vec values(n, arma::fill::randu);
+
+  double reference = 0.0;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    std::vector<double> partials((n + grain - 1) / grain, 0.0);
+    ParallelFor(0, n, grain,
+        [&](const size_t blockBegin, const size_t blockEnd)
+        {
+          double sum = 0.0;
+          for (size_t i = blockBegin; i < blockEnd; ++i)
+            sum += values[i];
+          partials[blockBegin / grain] = sum;
+        });
+
+    double total = 0.0;
+    for (size_t b = 0; b < partials.size(); ++b)
+      total += partials[b];
+
+    if (trial == 0)
+      reference = total;
+    else
+      BOOST_REQUIRE_EQUAL(total, reference);
+  }
+}
+
+/**
+ * The pool always reports a thread budget of at least one.
+ */
+BOOST_AUTO_TEST_CASE(ThreadBudgetTest)
+{
+  BOOST_REQUIRE_GE(TaskPool::Get().Threads(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -147,4 +147,102 @@ BOOST_AUTO_TEST_CASE(DisabledTimingTest)
   BOOST_REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
 
+/**
+ * A scoped Profile zone should show up in the timer report after aggregation.
+ */
+BOOST_AUTO_TEST_CASE(ProfileZoneTest)
+{
+  Timer::EnableTiming();
+
+  {
+    Profile zone("profile_test_zone");
+
+    #ifdef _WIN32
+    Sleep(10);
+    #else
+    usleep(10000);
+    #endif
+  }
+
+  // Nothing should be visible until the totals are aggregated.
+  Profile::Aggregate();
+
+  BOOST_REQUIRE_GE(Timer::Get("profile_test_zone").count(), 10000);
+
+  Timer::DisableTiming();
+}
+
+/**
+ * Profile zones recorded on several threads should sum in the aggregate, and
+ * hoisted zone IDs should be usable from any thread.
+ */
+BOOST_AUTO_TEST_CASE(MultithreadProfileZoneTest)
+{
+  Timer::EnableTiming();
+
+  const size_t zone = Profile::RegisterZone("profile_thread_zone");
+
+  std::thread threads[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    threads[i] = std::thread([zone]()
+        {
+          Profile p(zone);
+
+          #ifdef _WIN32
+          Sleep(20);
+          #else
+          int restarts = 0;
+          // Catch occasional EINTR failures.
+          while (usleep(20000) != 0 && restarts < 3)
+            ++restarts;
+          #endif
+        });
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    threads[i].join();
+
+  Profile::Aggregate();
+
+  // Three threads slept 20ms each; the inclusive total must cover all of them.
+  BOOST_REQUIRE(Timer::Get("profile_thread_zone") >
+      std::chrono::microseconds(50000));
+
+  Timer::DisableTiming();
+}
+
+/**
+ * Allocations recorded while a Profile zone is open should be attributed to
+ * that zone; allocations made with tracking disabled should not be recorded.
+ * The tracked allocation functions are called directly here, since the
+ * Armadillo hooks are only installed when building with
+ * -DMLPACK_TRACK_ALLOCATIONS.
+ */
+BOOST_AUTO_TEST_CASE(AllocTrackerZoneTest)
+{
+  AllocTracker::Reset();
+  AllocTracker::Enable();
+
+  {
+    Profile zone("alloc_test_zone");
+    void* mem = util::TrackedMemoryAlloc(1024);
+    util::TrackedMemoryFree(mem);
+  }
+
+  AllocTracker::Disable();
+
+  // This allocation must not be recorded.
+  void* untracked = util::TrackedMemoryAlloc(4096);
+  util::TrackedMemoryFree(untracked);
+
+  const std::vector<AllocTracker::ZoneStats> zones = AllocTracker::TopZones();
+  BOOST_REQUIRE_EQUAL(zones.size(), 1);
+  BOOST_REQUIRE_EQUAL(zones[0].name, "alloc_test_zone");
+  BOOST_REQUIRE_EQUAL(zones[0].count, 1);
+  BOOST_REQUIRE_EQUAL(zones[0].bytes, 1024);
+
+  AllocTracker::Reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END();
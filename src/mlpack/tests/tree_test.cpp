@@ -15,6 +15,7 @@
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/refit_tree.hpp>
 
 #include <queue>
 #include <stack>
@@ -216,6 +217,32 @@ BOOST_AUTO_TEST_CASE(HRectBoundMinDistancePoint)
   BOOST_REQUIRE_SMALL(b.MinDistance(point), 1e-5);
 }
 
+/**
+ * Ensure the batched bound-to-points MinDistance() agrees with the
+ * point-at-a-time overload.
+ */
+BOOST_AUTO_TEST_CASE(HRectBoundMinDistanceBatch)
+{
+  HRectBound<EuclideanDistance> b(5);
+
+  b[0] = Range(0.0, 2.0);
+  b[1] = Range(1.0, 5.0);
+  b[2] = Range(-2.0, 2.0);
+  b[3] = Range(-5.0, -2.0);
+  b[4] = Range(1.0, 2.0);
+
+  arma::mat points(5, 100, arma::fill::randn);
+  points *= 4.0;
+
+  arma::vec distances;
+  b.MinDistance(points, distances);
+
+  BOOST_REQUIRE_EQUAL(distances.n_elem, points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(distances[i] + 1.0,
+        b.MinDistance(arma::vec(points.col(i))) + 1.0, 1e-5);
+}
+
 /**
  * Ensure that we calculate the correct minimum distance between a bound and
  * another bound.
@@ -1069,6 +1096,38 @@ BOOST_AUTO_TEST_CASE(TreeCountMismatch)
   BOOST_REQUIRE(rootNode.Right()->Right()->Count() == 1);
 }
 
+/**
+ * Test that RefitTree() repairs bounds after points move in place, and that
+ * the drift report reacts to the size of the movement.
+ */
+BOOST_AUTO_TEST_CASE(RefitTreeTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(5, 300, arma::fill::randu);
+  TreeType tree(dataset, 20);
+
+  // A tiny nudge should be absorbed without recommending a rebuild.
+  std::vector<size_t> changed;
+  for (size_t i = 0; i < 300; i += 30)
+  {
+    tree.Dataset().col(i) += 1e-6;
+    changed.push_back(i);
+  }
+
+  BOOST_REQUIRE_EQUAL(RefitTree(tree, changed), false);
+  for (size_t i = 0; i < changed.size(); ++i)
+    BOOST_REQUIRE(tree.Bound().Contains(tree.Dataset().col(changed[i])));
+
+  // Throwing a point far outside the unit cube must trigger the rebuild
+  // recommendation, and the refitted bounds must still contain it.
+  tree.Dataset().col(42) += 10.0;
+  std::vector<size_t> single(1, 42);
+
+  BOOST_REQUIRE_EQUAL(RefitTree(tree, single), true);
+  BOOST_REQUIRE(tree.Bound().Contains(tree.Dataset().col(42)));
+}
+
 BOOST_AUTO_TEST_CASE(CheckParents)
 {
   arma::mat dataset = "2.0 5.0 9.0 4.0 8.0 7.0;"
@@ -1360,6 +1419,114 @@ BOOST_AUTO_TEST_CASE(KdTreeTest)
   TreeType root(dataset);
 }
 
+/**
+ * Make sure Compact() preserves the structure of a kd-tree while relocating
+ * the nodes into contiguous storage.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeCompactTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(8, 5000, arma::fill::randu);
+
+  TreeType reference(dataset);
+  TreeType compacted(dataset);
+  compacted.Compact();
+  // A second call is a no-op.
+  compacted.Compact();
+
+  // Walk both trees in lockstep and make sure nothing changed.
+  std::stack<std::pair<TreeType*, TreeType*>> stack;
+  stack.push(std::make_pair(&reference, &compacted));
+  while (!stack.empty())
+  {
+    TreeType* a = stack.top().first;
+    TreeType* b = stack.top().second;
+    stack.pop();
+
+    BOOST_REQUIRE_EQUAL(a->Begin(), b->Begin());
+    BOOST_REQUIRE_EQUAL(a->Count(), b->Count());
+    BOOST_REQUIRE_EQUAL(a->IsLeaf(), b->IsLeaf());
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      BOOST_REQUIRE_CLOSE(a->Bound()[d].Lo(), b->Bound()[d].Lo(), 1e-10);
+      BOOST_REQUIRE_CLOSE(a->Bound()[d].Hi(), b->Bound()[d].Hi(), 1e-10);
+    }
+
+    if (a->Left() != NULL)
+    {
+      BOOST_REQUIRE(b->Left() != NULL);
+      BOOST_REQUIRE(b->Left()->Parent() == b);
+      stack.push(std::make_pair(a->Left(), b->Left()));
+    }
+    if (a->Right() != NULL)
+    {
+      BOOST_REQUIRE(b->Right() != NULL);
+      BOOST_REQUIRE(b->Right()->Parent() == b);
+      stack.push(std::make_pair(a->Right(), b->Right()));
+    }
+  }
+}
+
+/**
+ * Make sure a flat snapshot of a kd-tree round-trips through disk.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeSnapshotTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(6, 3000, arma::fill::randu);
+
+  TreeType tree(dataset);
+  BOOST_REQUIRE(tree.SaveSnapshot("tree_snapshot.bin"));
+
+  TreeType* loaded = TreeType::LoadSnapshot("tree_snapshot.bin");
+  BOOST_REQUIRE(loaded != NULL);
+
+  // Check the dataset and the structure of the loaded tree.
+  BOOST_REQUIRE_EQUAL(loaded->Dataset().n_rows, tree.Dataset().n_rows);
+  BOOST_REQUIRE_EQUAL(loaded->Dataset().n_cols, tree.Dataset().n_cols);
+  for (size_t i = 0; i < tree.Dataset().n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(loaded->Dataset()[i], tree.Dataset()[i], 1e-10);
+
+  std::stack<std::pair<TreeType*, TreeType*>> stack;
+  stack.push(std::make_pair(&tree, loaded));
+  while (!stack.empty())
+  {
+    TreeType* a = stack.top().first;
+    TreeType* b = stack.top().second;
+    stack.pop();
+
+    BOOST_REQUIRE_EQUAL(a->Begin(), b->Begin());
+    BOOST_REQUIRE_EQUAL(a->Count(), b->Count());
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      BOOST_REQUIRE_CLOSE(a->Bound()[d].Lo(), b->Bound()[d].Lo(), 1e-10);
+      BOOST_REQUIRE_CLOSE(a->Bound()[d].Hi(), b->Bound()[d].Hi(), 1e-10);
+    }
+
+    if (a->Left() != NULL)
+    {
+      BOOST_REQUIRE(b->Left() != NULL);
+      BOOST_REQUIRE(b->Left()->Parent() == b);
+      stack.push(std::make_pair(a->Left(), b->Left()));
+    }
+    else
+      BOOST_REQUIRE(b->Left() == NULL);
+    if (a->Right() != NULL)
+    {
+      BOOST_REQUIRE(b->Right() != NULL);
+      BOOST_REQUIRE(b->Right()->Parent() == b);
+      stack.push(std::make_pair(a->Right(), b->Right()));
+    }
+    else
+      BOOST_REQUIRE(b->Right() == NULL);
+  }
+
+  delete loaded;
+  remove("tree_snapshot.bin");
+}
+
 BOOST_AUTO_TEST_CASE(MaxRPTreeTest)
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -1951,6 +2118,39 @@ BOOST_AUTO_TEST_CASE(CoverTreeConstructionTest)
   // implementation.
 }
 
+/**
+ * Create a cover tree on exponentially spaced points, which forces a tree
+ * whose depth is linear in the number of points.  The worklist-based
+ * construction must handle this without deep recursion, and the tree must
+ * still be valid.
+ */
+BOOST_AUTO_TEST_CASE(DeepCoverTreeConstructionTest)
+{
+  // One-dimensional points at 2^0, 2^-1, ..., 2^-899; each scale level of the
+  // tree can separate only one point from the rest.
+  arma::mat dataset(1, 900);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset[i] = std::pow(2.0, -((double) i));
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  // Ensure each leaf is only created once.
+  arma::vec counts;
+  counts.zeros(900);
+  RecurseTreeCountLeaves(tree, counts);
+
+  for (size_t i = 0; i < 900; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+
+  // Each non-leaf should have a self-child.
+  CheckSelfChild<TreeType>(tree);
+
+  // Each node must satisfy the covering principle.
+  CheckCovering<TreeType, LMetric<2, true>>(tree);
+}
+
 /**
  * Create a cover tree on sparse data and make sure it's accurate.
  */
@@ -132,6 +132,50 @@ BOOST_AUTO_TEST_CASE(HollowBallBoundTest)
   BOOST_REQUIRE_CLOSE(b1.OuterRadius(), 5.0, 1e-5);
 }
 
+/**
+ * The blocked point-to-bound scoring must agree with the scalar MinDistance()
+ * and MaxDistance() for every bound, including empty bounds.
+ */
+BOOST_AUTO_TEST_CASE(HollowBallBoundRangeDistancesTest)
+{
+  typedef HollowBallBound<EuclideanDistance> BoundType;
+
+  std::vector<BoundType> bounds;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    const double outerRadius = 0.5 + 4.0 * math::Random();
+    const double innerRadius = outerRadius * math::Random();
+    BoundType b(innerRadius, outerRadius, arma::vec(5, arma::fill::randu));
+    b.HollowCenter() += 0.1 * arma::vec(5, arma::fill::randn);
+    bounds.push_back(b);
+  }
+  // An empty bound must score as infinitely far away.
+  bounds.push_back(BoundType());
+
+  std::vector<const BoundType*> boundPtrs;
+  for (size_t i = 0; i < bounds.size(); ++i)
+    boundPtrs.push_back(&bounds[i]);
+
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    const arma::vec point = 3.0 * arma::vec(5, arma::fill::randn);
+
+    arma::vec minDistances, maxDistances;
+    BoundType::RangeDistances(point, boundPtrs, minDistances, maxDistances);
+
+    BOOST_REQUIRE_EQUAL(minDistances.n_elem, bounds.size());
+    BOOST_REQUIRE_EQUAL(maxDistances.n_elem, bounds.size());
+
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+      BOOST_REQUIRE_SMALL(minDistances[i] - bounds[i].MinDistance(point),
+          1e-10);
+      BOOST_REQUIRE_SMALL(maxDistances[i] - bounds[i].MaxDistance(point),
+          1e-10);
+    }
+  }
+}
+
 template<typename TreeType>
 void CheckBound(TreeType& tree)
 {